@@ -0,0 +1,75 @@
+#ifndef ENGINE_BITSET_H
+#define ENGINE_BITSET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// =============================================================================
+// Bitset
+//
+// Growable set of small integers packed 64 per word. Used for per-entity
+// membership flags over large index ranges (e.g. "ship is inside POI i"),
+// where a bool per index would be 8x the memory and much slower to scan.
+// Bits past bit_count read as clear, so callers can size lazily.
+//
+// Usage:
+//   Bitset set;
+//   bitset_init(&set, poi_count);
+//   bitset_set(&set, 42);
+//   for (uint32_t i = bitset_next(&set, 0); i != BITSET_NONE; i = bitset_next(&set, i + 1)) { ... }
+//   bitset_shutdown(&set);
+// =============================================================================
+
+#define BITSET_NONE 0xFFFFFFFFu
+
+typedef struct Bitset {
+    uint64_t* words;
+    uint32_t bit_count;         // Addressable bits
+    uint32_t word_count;        // Allocated words (bit_count rounded up)
+} Bitset;
+
+// Initialize with room for bit_count bits, all clear. Returns false on failure.
+bool bitset_init(Bitset* set, uint32_t bit_count);
+
+// Free memory
+void bitset_shutdown(Bitset* set);
+
+// Change the number of addressable bits; existing bits are kept, new ones clear
+bool bitset_resize(Bitset* set, uint32_t bit_count);
+
+// Clear every bit (keeps allocated memory)
+void bitset_clear_all(Bitset* set);
+
+// Number of set bits
+uint32_t bitset_count(const Bitset* set);
+
+// Number of bits set in both a and b
+uint32_t bitset_count_and(const Bitset* a, const Bitset* b);
+
+// Index of the first set bit >= from, or BITSET_NONE
+uint32_t bitset_next(const Bitset* set, uint32_t from);
+
+static inline bool bitset_test(const Bitset* set, uint32_t bit) {
+    if (bit >= set->bit_count) return false;
+    return (set->words[bit >> 6] >> (bit & 63)) & 1u;
+}
+
+static inline void bitset_set(Bitset* set, uint32_t bit) {
+    if (bit >= set->bit_count) return;
+    set->words[bit >> 6] |= (uint64_t)1 << (bit & 63);
+}
+
+static inline void bitset_reset(Bitset* set, uint32_t bit) {
+    if (bit >= set->bit_count) return;
+    set->words[bit >> 6] &= ~((uint64_t)1 << (bit & 63));
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_BITSET_H
@@ -76,6 +76,10 @@ void camera_begin(const CameraState* camera);
 // End camera rendering mode
 void camera_end(void);
 
+// World rectangle the camera shows on a screen of the given size (the
+// bounding box of the view when the camera is rotated)
+Rectangle camera_get_view_rect(const CameraState* camera, int screen_width, int screen_height);
+
 // Check if a world rectangle is visible on screen
 bool camera_is_rect_visible(const CameraState* camera, Rectangle world_rect, int screen_width, int screen_height);
 
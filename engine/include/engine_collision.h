@@ -0,0 +1,169 @@
+#ifndef ENGINE_COLLISION_H
+#define ENGINE_COLLISION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_ecs.h"
+#include "engine_event_ring.h"
+#include "engine_jobs.h"
+#include "engine_spatial_grid.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// =============================================================================
+// Collision
+//
+// Contact detection and response between bodies with oriented triangle
+// hulls: apex `bow` ahead of the body's origin, base `stern` astern spanning
+// `half_beam` to each side (the triangle ships are drawn with). Rotation is
+// in degrees with 0 = north, so forward is (sin r, -cos r).
+//
+// Broadphase: each hull is bounded by the smallest circle centred on its
+// axis (midway between apex and base). Active bodies are binned by that
+// centre into a SpatialGrid whose cells are at least one bounding diameter
+// wide and copied out in cell order, so neighbours sit next to each other in
+// memory. Each body tests the cells its circle reaches (at most 3x3) against
+// later bodies only, so every pair is tested once.
+// Narrowphase: bounding circles, then the separating axis test on the two
+// triangles (six edge normals). The axis of least overlap gives the contact
+// normal and depth.
+// Response: the overlap is pushed apart by inverse mass, and bodies closing
+// along the normal get an impulse with the world's restitution. speed (if
+// given) is the velocity along the heading, for bodies such as ships whose
+// velocity is rebuilt from speed every step.
+//
+// Works over SoA columns (CollisionBodies) like the ship physics kernels, so
+// it runs on the ECS arrays or on any other batch of bodies. Detection splits
+// into ranges of bodies across the job system; each range collects its own
+// contacts and the lists are joined in range order, so the contacts (and the
+// response) do not depend on the thread count.
+//
+// Usage:
+//   CollisionWorld collision;
+//   collision_world_init(&collision, COLLISION_DEFAULT_EVENT_CAPACITY);
+//   each fixed step, after movement:
+//     collision_system_update(&collision, &ecs_world, jobs);
+//   EventRingReader reader;  // CollisionContact events
+//   collision_world_shutdown(&collision);
+// =============================================================================
+
+#define COLLISION_DEFAULT_EVENT_CAPACITY 256
+#define COLLISION_MAX_JOBS 32
+#define COLLISION_MIN_BODIES_PER_JOB 256
+
+#define COLLISION_DEFAULT_RESTITUTION 0.2f
+#define COLLISION_DEFAULT_CORRECTION 0.8f   // Fraction of the overlap removed per step
+#define COLLISION_DEFAULT_SLOP 0.5f         // Overlap left alone (world units)
+
+typedef struct CollisionBodies {
+    // Motion (positions and velocities are changed by the response)
+    float* pos_x;
+    float* pos_y;
+    const float* rotation;          // degrees
+    float* vel_x;
+    float* vel_y;
+    float* speed;                   // Signed speed along the heading (NULL = none)
+    
+    // Shape and filtering
+    const float* hull_bow;
+    const float* hull_stern;
+    const float* hull_half_beam;
+    const float* inv_mass;          // 0 = immovable
+    const uint8_t* layer;
+    const uint8_t* mask;
+    
+    // Body i collides only if (masks[i] & required) == required (NULL = all)
+    const ComponentMask* masks;
+    ComponentMask required;
+    uint32_t count;
+} CollisionBodies;
+
+// One touching pair. Pushed to the world's event ring as well.
+typedef struct CollisionContact {
+    uint32_t a;                     // Body (entity) indices, a < b
+    uint32_t b;
+    float normal_x;                 // Unit normal from a to b
+    float normal_y;
+    float depth;                    // Overlap along the normal
+    float point_x;                  // Approximate contact point
+    float point_y;
+    float impulse;                  // Normal impulse applied (0 if separating)
+} CollisionContact;
+
+// Contacts found by one job
+typedef struct CollisionContactList {
+    CollisionContact* contacts;
+    uint32_t count;
+    uint32_t capacity;
+    uint64_t pairs_tested;
+    bool overflow;                  // Growing failed; some contacts were lost
+} CollisionContactList;
+
+typedef struct CollisionWorld {
+    // Active bodies in grid order (rebuilt every update; grows, never shrinks)
+    SpatialGrid grid;
+    uint32_t* body;                 // Original body index
+    float* x;                       // Bounding circle centre
+    float* y;
+    float* radius;
+    float* heading_sin;
+    float* heading_cos;
+    float* hull_x;                  // 3 vertices per body
+    float* hull_y;
+    float* axis_x;                  // 3 unit edge normals per body
+    float* axis_y;
+    float* axis_min;                // The hull's own extent along each normal
+    float* axis_max;
+    uint8_t* layer;
+    uint8_t* mask;
+    uint32_t active_count;
+    uint32_t capacity;
+    float max_radius;
+    
+    // Contacts of the last update, joined in order
+    CollisionContact* contacts;
+    uint32_t contact_count;
+    uint32_t contact_capacity;
+    CollisionContactList lists[COLLISION_MAX_JOBS];
+    
+    EventRing events;               // CollisionContact per contact
+    
+    float restitution;
+    float correction;
+    float slop;
+    
+    // Stats of the last update
+    uint64_t pairs_tested;          // Broadphase candidate pairs
+} CollisionWorld;
+
+// Initialize with defaults and an event ring of event_capacity contacts
+bool collision_world_init(CollisionWorld* world, uint32_t event_capacity);
+
+// Free memory
+void collision_world_shutdown(CollisionWorld* world);
+
+// Columns over the ECS arrays (colliders need transform, velocity and collider)
+CollisionBodies collision_bodies_from_ecs(ECSWorld* ecs_world);
+
+// Give an entity a triangle hull collider (radius is set to the distance of
+// the farthest hull corner from the entity's origin)
+void collision_set_hull(ECSWorld* ecs_world, Entity e, float bow, float stern, float half_beam,
+                        float inv_mass, uint8_t layer, uint8_t mask);
+
+// Find all touching pairs into world->contacts. jobs may be NULL (inline).
+// Returns the contact count.
+uint32_t collision_detect(CollisionWorld* world, const CollisionBodies* bodies, JobSystem* jobs);
+
+// Separate and bounce the pairs found by collision_detect, and push them as events
+void collision_resolve(CollisionWorld* world, const CollisionBodies* bodies);
+
+// Detect and resolve over the ECS colliders. Returns the contact count.
+uint32_t collision_system_update(CollisionWorld* world, ECSWorld* ecs_world, JobSystem* jobs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_COLLISION_H
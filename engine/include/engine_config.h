@@ -81,6 +81,15 @@ typedef struct AudioConfig {
     float sfx_volume;
 } AudioConfig;
 
+// =============================================================================
+// Simulation Configuration
+// =============================================================================
+
+typedef struct SimulationConfig {
+    int tick_rate;              // Fixed simulation steps per second
+    int max_steps_per_frame;    // Steps one frame may run before time is dropped
+} SimulationConfig;
+
 // =============================================================================
 // Core Config Functions
 // =============================================================================
@@ -142,12 +151,18 @@ WindowConfig config_get_window(const ConfigFile* config);
 // Get audio config with defaults
 AudioConfig config_get_audio(const ConfigFile* config);
 
+// Get simulation timestep config with defaults
+SimulationConfig config_get_simulation(const ConfigFile* config);
+
 // Get default window config
 WindowConfig config_get_default_window(void);
 
 // Get default audio config
 AudioConfig config_get_default_audio(void);
 
+// Get default simulation config
+SimulationConfig config_get_default_simulation(void);
+
 #ifdef __cplusplus
 }
 #endif
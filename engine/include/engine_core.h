@@ -13,7 +13,8 @@ typedef struct {
     const char* window_title;
     int window_width;
     int window_height;
-    int target_fps;
+    int target_fps;              // 0 = uncapped
+    bool vsync;
 } EngineConfig;
 
 // Timing state
@@ -22,6 +23,14 @@ typedef struct {
     double total_time;           // Total time since engine start (seconds)
     double fixed_delta_time;     // Fixed timestep for physics (seconds)
     double fixed_accumulator;    // Accumulator for fixed timestep
+    uint32_t max_fixed_steps;    // Fixed steps per frame before time is dropped
+    uint32_t fixed_steps;        // Fixed steps taken this frame
+    uint64_t fixed_step_count;   // Total fixed steps
+    double dropped_time;         // Seconds discarded by the step cap or budget
+    double time_scale;           // Simulated seconds per real second (1 = real time)
+    double step_budget;          // Wall seconds of fixed steps per frame (0 = no limit)
+    double frame_start;          // Wall clock at the start of this frame
+    uint32_t last_step_size;     // Fixed steps taken by the last call (for alpha)
     uint64_t frame_count;        // Total frames rendered
     float fps;                   // Current frames per second
     float fps_smoothed;          // Smoothed FPS (rolling average)
@@ -48,11 +57,45 @@ double engine_get_delta_time(void);
 double engine_get_total_time(void);
 float engine_get_fps(void);
 uint64_t engine_get_frame_count(void);
+void engine_set_target_fps(int fps);     // 0 = uncapped
+void engine_reset_target_fps(void);      // Back to the configured rate
 
 // Fixed timestep support (for physics)
+//
+// Each frame adds its real duration to an accumulator; the game then runs
+// whole fixed steps while the accumulator holds one, and renders between the
+// last two step states by the leftover fraction:
+//
+//   while (engine_should_update_fixed()) simulate(engine_get_fixed_delta_time());
+//   render(engine_get_fixed_alpha());
+//
+// At most max_fixed_steps run per frame. When a frame falls further behind
+// than that (a breakpoint, a slow load), the backlog is dropped instead of
+// being caught up, which would make the next frame slower still.
+//
+// Time warp: with a time scale above 1 each frame adds scale times its
+// duration, the step cap grows with the scale, and a step budget (wall
+// seconds per frame) decides how much of that actually runs; the rest is
+// dropped, so the frame rate settles near 1 / budget. A game may take
+// several fixed steps as one coarse step with engine_should_update_fixed_steps.
+#define ENGINE_DEFAULT_MAX_FIXED_STEPS 5
+
 void engine_set_fixed_timestep(double fixed_dt);
+void engine_set_max_fixed_steps(uint32_t max_steps);
 bool engine_should_update_fixed(void);  // Call in loop until returns false
+bool engine_should_update_fixed_steps(uint32_t steps);  // Take steps at once
 double engine_get_fixed_delta_time(void);
+double engine_get_fixed_alpha(void);    // Leftover fraction of a step, [0, 1)
+void engine_set_time_scale(double scale);
+double engine_get_time_scale(void);
+void engine_set_fixed_step_budget(double seconds);  // 0 = no limit
+
+// Fixed timestep on any TimingState (the functions above use the engine's).
+// elapsed is the wall time already spent stepping this frame.
+void engine_timing_accumulate(TimingState* timing, double frame_dt);
+bool engine_timing_step_fixed(TimingState* timing);
+bool engine_timing_take_steps(TimingState* timing, uint32_t steps, double elapsed);
+double engine_timing_alpha(const TimingState* timing);
 
 // Window functions
 int engine_get_window_width(void);
@@ -64,6 +64,15 @@ typedef struct TransformComponents {
     float scale_y[MAX_ENTITIES];
 } TransformComponents;
 
+// Transforms as they were before the last fixed step. Rendering blends
+// from these to the current transforms, so motion stays smooth when the
+// frame rate and the simulation rate differ.
+typedef struct PreviousTransforms {
+    float pos_x[MAX_ENTITIES];
+    float pos_y[MAX_ENTITIES];
+    float rotation[MAX_ENTITIES];    // degrees
+} PreviousTransforms;
+
 // Velocity component data (movement)
 typedef struct VelocityComponents {
     float vel_x[MAX_ENTITIES];
@@ -83,13 +92,17 @@ typedef struct RenderableComponents {
     bool visible[MAX_ENTITIES];
 } RenderableComponents;
 
-// Collider component data (physics collision)
+// Collider component data (physics collision, see engine_collision.h)
 typedef struct ColliderComponents {
-    float radius[MAX_ENTITIES];        // Collision radius
+    float radius[MAX_ENTITIES];        // Bounding radius (broadphase)
     float width[MAX_ENTITIES];         // For box colliders
     float height[MAX_ENTITIES];
-    uint8_t collision_layer[MAX_ENTITIES];
-    uint8_t collision_mask[MAX_ENTITIES];
+    float hull_bow[MAX_ENTITIES];      // Triangle hull: apex this far ahead,
+    float hull_stern[MAX_ENTITIES];    // base this far astern,
+    float hull_half_beam[MAX_ENTITIES];// spanning this far to each side
+    float inv_mass[MAX_ENTITIES];      // 0 = immovable
+    uint8_t collision_layer[MAX_ENTITIES];  // Layer bits this collider is on
+    uint8_t collision_mask[MAX_ENTITIES];   // Layer bits it collides with
 } ColliderComponents;
 
 // =============================================================================
@@ -105,6 +118,7 @@ typedef struct ECSWorld {
     
     // Engine core component arrays (SoA)
     TransformComponents transforms;
+    PreviousTransforms previous;     // Interpolation source (see ecs_store_previous_transforms)
     VelocityComponents velocities;
     RenderableComponents renderables;
     ColliderComponents colliders;
@@ -200,6 +214,51 @@ uint32_t ecs_count_with(const ECSWorld* world, ComponentMask required_mask);
 // Entities need COMPONENT_TRANSFORM | COMPONENT_VELOCITY
 void ecs_system_movement(ECSWorld* world, float delta_time);
 
+// =============================================================================
+// Render Interpolation
+// =============================================================================
+
+// Remember every transform; call before each fixed simulation step
+void ecs_store_previous_transforms(ECSWorld* world);
+
+// Make one entity's previous transform equal its current one, so a
+// teleport is not drawn as a fast move across the screen
+void ecs_snap_previous_transform(ECSWorld* world, Entity entity);
+
+// Transform blended between the previous and the current step
+// (alpha 0 = previous, 1 = current). Rotation takes the shorter way round.
+void ecs_get_interpolated_transform(const ECSWorld* world, Entity entity, float alpha,
+                                    float* x, float* y, float* rotation);
+
+// =============================================================================
+// Render List
+//
+// The renderable entities of one frame, in draw order: visible entities with
+// COMPONENT_RENDERABLE | COMPONENT_TRANSFORM whose interpolated position is
+// inside the view, counting-sorted by RenderableComponents.layer (entity order
+// within a layer). Layer l is list entries [layer_start[l], layer_start[l + 1]),
+// so a renderer can draw each layer as a run and batch by kind within it.
+// =============================================================================
+
+#define ECS_RENDER_LAYER_COUNT 256
+
+typedef struct EcsRenderList {
+    Entity entity[MAX_ENTITIES];
+    float x[MAX_ENTITIES];           // Interpolated pose
+    float y[MAX_ENTITIES];
+    float rotation[MAX_ENTITIES];
+    uint32_t layer_start[ECS_RENDER_LAYER_COUNT + 1];
+    uint32_t count;
+    uint32_t culled;                 // Renderables left out as off view
+} EcsRenderList;
+
+// Build the list for the view (min_x, min_y)-(max_x, max_y). An entity is
+// kept while within margin * max(scale_x, scale_y) of the view, so margin
+// should be the largest drawn extent at scale 1.
+void ecs_build_render_list(const ECSWorld* world, float alpha,
+                           float min_x, float min_y, float max_x, float max_y,
+                           float margin, EcsRenderList* out_list);
+
 // Note: Game-specific systems (ship physics, AI) are implemented in
 // game_ship_ecs.c and game_ai_ecs.c, not in the engine.
 
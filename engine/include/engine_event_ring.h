@@ -0,0 +1,68 @@
+#ifndef ENGINE_EVENT_RING_H
+#define ENGINE_EVENT_RING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// =============================================================================
+// Event Ring
+//
+// Fixed-size ring of fixed-size event records with one producer and any
+// number of independent readers. The producer never blocks: when the ring is
+// full the oldest event is overwritten. Each reader keeps its own sequence
+// number, so systems consume the same events at their own pace without
+// callbacks or copies; a reader that falls more than `capacity` events
+// behind skips ahead and counts what it missed in `dropped`.
+//
+// Usage:
+//   EventRing ring;
+//   event_ring_init(&ring, sizeof(MyEvent), 256);
+//   EventRingReader reader;
+//   event_ring_reader_init(&ring, &reader);
+//   event_ring_push(&ring, &event);
+//   const MyEvent* e;
+//   while ((e = (const MyEvent*)event_ring_next(&ring, &reader)) != NULL) { ... }
+//   event_ring_shutdown(&ring);
+// =============================================================================
+
+typedef struct EventRing {
+    uint8_t* data;
+    uint32_t element_size;
+    uint32_t capacity;          // Power of 2
+    uint32_t mask;              // capacity - 1
+    uint64_t write_seq;         // Events pushed since init (never wraps in practice)
+} EventRing;
+
+typedef struct EventRingReader {
+    uint64_t seq;               // Next event to read
+    uint64_t dropped;           // Events overwritten before this reader saw them
+} EventRingReader;
+
+// Initialize with room for at least `capacity` events (rounded up to a power of 2)
+bool event_ring_init(EventRing* ring, uint32_t element_size, uint32_t capacity);
+
+// Free memory
+void event_ring_shutdown(EventRing* ring);
+
+// Append a copy of event, overwriting the oldest one when full
+void event_ring_push(EventRing* ring, const void* event);
+
+// Start a reader at the current end of the ring (sees only newer events)
+void event_ring_reader_init(const EventRing* ring, EventRingReader* reader);
+
+// Next unread event, or NULL when the reader is caught up. The pointer is
+// valid until the producer pushes `capacity` more events.
+const void* event_ring_next(const EventRing* ring, EventRingReader* reader);
+
+// Events available to a reader (at most capacity)
+uint32_t event_ring_pending(const EventRing* ring, const EventRingReader* reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_EVENT_RING_H
@@ -0,0 +1,56 @@
+#ifndef ENGINE_FILE_MAP_H
+#define ENGINE_FILE_MAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// =============================================================================
+// File Mapping
+//
+// Maps a whole file into memory so cooked data can be used in place without
+// a read/parse pass. Mappings are private copy-on-write: callers may write to
+// the pages (e.g. runtime state columns), changes are never flushed to disk
+// and only touched pages are copied.
+//
+// Usage:
+//   FileMap map;
+//   if (file_map_open(&map, "assets/data/pois.bin")) {
+//       const Header* h = (const Header*)map.data;
+//       ...
+//       file_map_close(&map);
+//   }
+// =============================================================================
+
+typedef struct FileMap {
+    void* data;             // Page-aligned base address (NULL when closed)
+    size_t size;            // Mapped bytes (file size)
+#ifdef _WIN32
+    void* file_handle;
+    void* mapping_handle;
+#endif
+} FileMap;
+
+// Map an entire file copy-on-write; returns false if missing, empty or on error
+bool file_map_open(FileMap* map, const char* filepath);
+
+// Unmap and close (safe on a closed or zeroed map)
+void file_map_close(FileMap* map);
+
+// Check if a map is open
+static inline bool file_map_is_open(const FileMap* map) {
+    return map && map->data != NULL;
+}
+
+// Get a file's modification time (seconds since epoch); false if missing
+bool file_get_modified_time(const char* filepath, int64_t* out_time);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_FILE_MAP_H
@@ -0,0 +1,67 @@
+#ifndef ENGINE_JOBS_H
+#define ENGINE_JOBS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// =============================================================================
+// Job System
+//
+// Fixed pool of worker threads for data-parallel work. jobs_parallel_for
+// runs func(data, i) for every i in [0, count) across the workers and the
+// calling thread, and returns when all calls have finished, so callers need
+// no synchronisation beyond keeping each index's output separate. Indices are
+// handed out one at a time, which suits a few dozen coarse jobs (searches,
+// chunks of a large array) better than millions of tiny ones.
+//
+// One batch runs at a time; jobs_parallel_for must be called from a single
+// thread and not from inside a job. With zero workers everything runs inline.
+//
+// Usage:
+//   JobSystem jobs;
+//   jobs_init(&jobs, 0);                    // 0 = one worker per extra core
+//   jobs_parallel_for(&jobs, 16, run_search, &searches);
+//   jobs_shutdown(&jobs);
+// =============================================================================
+
+#define JOBS_MAX_WORKERS 32
+
+typedef void (*JobFunc)(void* data, uint32_t index);
+
+typedef struct JobSystemImpl JobSystemImpl;
+
+typedef struct JobSystem {
+    JobSystemImpl* impl;        // Threads and batch state (NULL = inline only)
+    uint32_t worker_count;      // Threads besides the caller
+} JobSystem;
+
+// Start worker threads (worker_count 0 = hardware threads - 1, capped at
+// JOBS_MAX_WORKERS). Returns false if threads could not be created; the
+// system then still works, inline on the calling thread.
+bool jobs_init(JobSystem* jobs, uint32_t worker_count);
+
+// Stop and join all workers
+void jobs_shutdown(JobSystem* jobs);
+
+// Run func(data, i) for i in [0, count) and wait for all of them.
+// jobs may be NULL to run inline.
+void jobs_parallel_for(JobSystem* jobs, uint32_t count, JobFunc func, void* data);
+
+// Threads that run jobs, including the caller
+uint32_t jobs_thread_count(const JobSystem* jobs);
+
+// Number of hardware threads (at least 1)
+uint32_t jobs_hardware_threads(void);
+
+// Monotonic clock in seconds, for job deadlines
+double jobs_time_seconds(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_JOBS_H
@@ -0,0 +1,118 @@
+#ifndef ENGINE_JSON_STREAM_H
+#define ENGINE_JSON_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// =============================================================================
+// JSON Stream
+//
+// Incremental (SAX-style) JSON tokenizer. Input is pushed in chunks of any
+// size - a token may straddle chunk boundaries - and every token is reported
+// to a callback as soon as it is complete, so no document tree is built and
+// memory use does not depend on the file size. The only allocation is a
+// scratch buffer for the current string/number, which grows to the longest
+// token seen and is reused.
+//
+// Usage:
+//   JsonStream stream;
+//   json_stream_init(&stream, on_token, &my_state);
+//   while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+//       if (json_stream_feed(&stream, chunk, n) != JSON_STREAM_OK) break;
+//   }
+//   JsonStreamResult result = json_stream_finish(&stream);
+//   json_stream_shutdown(&stream);
+// =============================================================================
+
+#define JSON_STREAM_MAX_DEPTH 64
+
+typedef enum JsonTokenType {
+    JSON_TOKEN_OBJECT_BEGIN = 0,
+    JSON_TOKEN_OBJECT_END,
+    JSON_TOKEN_ARRAY_BEGIN,
+    JSON_TOKEN_ARRAY_END,
+    JSON_TOKEN_KEY,
+    JSON_TOKEN_STRING,
+    JSON_TOKEN_NUMBER,
+    JSON_TOKEN_TRUE,
+    JSON_TOKEN_FALSE,
+    JSON_TOKEN_NULL
+} JsonTokenType;
+
+typedef struct JsonToken {
+    JsonTokenType type;
+    uint32_t depth;             // Containers enclosing the token (root value = 0;
+                                // BEGIN/END report the container's own depth)
+    const char* str;            // KEY/STRING: unescaped UTF-8, NUL-terminated,
+                                // valid only during the callback
+    uint32_t len;               // Length of str in bytes
+    double number;              // NUMBER value
+} JsonToken;
+
+// Called for every token; return false to stop parsing (JSON_STREAM_ABORTED)
+typedef bool (*JsonTokenCallback)(const JsonToken* token, void* user_data);
+
+typedef enum JsonStreamResult {
+    JSON_STREAM_OK = 0,
+    JSON_STREAM_SYNTAX_ERROR,
+    JSON_STREAM_TOO_DEEP,       // Nesting beyond JSON_STREAM_MAX_DEPTH
+    JSON_STREAM_INCOMPLETE,     // finish() before the root value was complete
+    JSON_STREAM_ABORTED,        // Callback returned false
+    JSON_STREAM_OUT_OF_MEMORY
+} JsonStreamResult;
+
+typedef struct JsonStream {
+    JsonTokenCallback callback;
+    void* user_data;
+
+    // Current string/number being assembled (always NUL-terminated on emit)
+    char* scratch;
+    uint32_t scratch_size;
+    uint32_t scratch_capacity;
+
+    // Container stack: bit d set = object at depth d, clear = array
+    uint64_t object_bits;
+    uint32_t depth;
+
+    // Parser state
+    uint8_t expect;             // What the grammar allows next
+    uint8_t lex;                // Token being scanned (string, number, ...)
+    bool string_is_key;
+    uint8_t literal_pos;        // Matched characters of true/false/null
+    const char* literal;
+    JsonTokenType literal_type;
+    uint32_t unicode_value;     // \uXXXX being decoded
+    uint8_t unicode_digits;
+    uint32_t high_surrogate;    // Pending UTF-16 high surrogate (0 = none)
+    uint8_t bom_pos;            // Byte order mark bytes skipped (3 = past the start)
+
+    JsonStreamResult status;    // First error (sticky)
+    uint32_t line;              // 1-based line of the last byte consumed
+} JsonStream;
+
+// Initialize a stream; returns false if the scratch buffer cannot be allocated
+bool json_stream_init(JsonStream* stream, JsonTokenCallback callback, void* user_data);
+
+// Free the scratch buffer
+void json_stream_shutdown(JsonStream* stream);
+
+// Push the next chunk of input. Returns the stream status; after an error
+// further input is ignored and the error is returned again.
+JsonStreamResult json_stream_feed(JsonStream* stream, const char* data, size_t size);
+
+// Signal end of input; returns JSON_STREAM_INCOMPLETE if the document is cut off
+JsonStreamResult json_stream_finish(JsonStream* stream);
+
+// Get human-readable name for a result
+const char* json_stream_result_to_string(JsonStreamResult result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_JSON_STREAM_H
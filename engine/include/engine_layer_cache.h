@@ -0,0 +1,113 @@
+#ifndef ENGINE_LAYER_CACHE_H
+#define ENGINE_LAYER_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_render_queue.h"
+#include "engine_spatial_hash.h"
+#include <raylib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// =============================================================================
+// Layer Cache
+//
+// Keeps world content that rarely changes (water, islands, map markers) in
+// render texture tiles, so a frame that changes nothing draws a few
+// textured quads instead of the content itself.
+//
+// Tiles are LAYER_CACHE_TILE_PIXELS square and aligned to a world grid at
+// the scale (texels per world unit) they were drawn at: the camera zoom
+// rounded to the nearest power of two. Zooming within a level just
+// stretches the cached tiles (by at most a factor of sqrt(2) either way);
+// only crossing into another level redraws everything. Each update draws
+// only the tiles that are newly in view or were invalidated, so panning
+// redraws just the row or column of tiles coming into view. Tiles that
+// leave the view stay cached until their slot is needed.
+//
+// The content is drawn by a callback given the world rectangle of one tile,
+// with a camera already set up that maps the rectangle onto the tile.
+//
+// Usage:
+//   LayerCache cache;
+//   layer_cache_init(&cache, water_color, draw_static, state);
+//   layer_cache_invalidate_rect(&cache, x0, y0, x1, y1);  // Content changed
+//   if (layer_cache_update(&cache, view, zoom)) {          // Outside camera mode
+//       layer_cache_queue(&cache, stream, LAYER_STATIC);   // Tiles as sprites
+//   } else {
+//       ...draw the content directly...
+//   }
+//   layer_cache_shutdown(&cache);
+// =============================================================================
+
+#define LAYER_CACHE_TILE_PIXELS 512
+#define LAYER_CACHE_MAX_TILES 64            // Views needing more are drawn directly
+
+typedef void (*LayerCacheDrawFunc)(Rectangle world_rect, void* user_data);
+
+typedef struct LayerCacheTile {
+    RenderTexture2D target;         // id 0 until first drawn
+    int32_t tile_x;
+    int32_t tile_y;
+    uint32_t last_frame;            // Update that last had it in view
+    bool assigned;                  // Holds the tile at tile_x, tile_y
+    bool dirty;                     // Content must be drawn again
+} LayerCacheTile;
+
+typedef struct LayerCache {
+    LayerCacheTile tiles[LAYER_CACHE_MAX_TILES];
+    SpatialHashMap slots;           // (tile_x, tile_y) -> index into tiles
+    float scale;                    // Texels per world unit of the cached tiles, a power of two (0 = none)
+    float tile_world_size;          // World units per tile at that scale
+    uint32_t frame;
+
+    // View of the last update, as an inclusive tile range
+    int32_t view_min_x;
+    int32_t view_min_y;
+    int32_t view_max_x;
+    int32_t view_max_y;
+
+    Color clear_color;              // Tiles start from this (opaque) colour
+    LayerCacheDrawFunc draw;
+    void* user_data;
+
+    uint32_t tiles_drawn;           // Tiles redrawn by the last update
+    bool unavailable;               // No render textures (no window, or creation failed)
+} LayerCache;
+
+// Initialize an empty cache whose tiles draw with draw(rect, user_data)
+bool layer_cache_init(LayerCache* cache, Color clear_color, LayerCacheDrawFunc draw, void* user_data);
+
+// Free tiles and memory
+void layer_cache_shutdown(LayerCache* cache);
+
+// Mark every tile overlapping a world rectangle for redrawing
+void layer_cache_invalidate_rect(LayerCache* cache, float min_x, float min_y, float max_x, float max_y);
+
+// Mark every tile for redrawing
+void layer_cache_invalidate_all(LayerCache* cache);
+
+// Power-of-two scale the tiles for a camera zoom are drawn at
+float layer_cache_level(float zoom);
+
+// Assign a tile to every grid cell of view at zoom's level, reusing tiles
+// still cached and taking the longest unseen slots for new ones (which are
+// left dirty). Returns false if the view needs more than LAYER_CACHE_MAX_TILES.
+// Used by layer_cache_update; exposed for tests and tools.
+bool layer_cache_plan(LayerCache* cache, Rectangle view, float zoom);
+
+// Plan view, then draw every dirty tile in it. Call outside camera and
+// texture modes. Returns false when the view cannot be served from tiles;
+// the caller draws the content directly that frame.
+bool layer_cache_update(LayerCache* cache, Rectangle view, float zoom);
+
+// Queue the tiles of the last update as sprites on layer
+void layer_cache_queue(const LayerCache* cache, RenderStream* stream, uint8_t layer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_LAYER_CACHE_H
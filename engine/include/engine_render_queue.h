@@ -0,0 +1,173 @@
+#ifndef ENGINE_RENDER_QUEUE_H
+#define ENGINE_RENDER_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_renderer.h"
+#include <raylib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// =============================================================================
+// Render Queue
+//
+// Deferred drawing for one pass (e.g. the world under the camera). Systems
+// submit compact commands - shapes, text, sprites, ranges of a prebuilt
+// TriangleBatch, or a callback for drawing the queue does not know - each
+// tagged with a 64-bit sort key:
+//
+//   bits 56-63  layer      draw order between passes of the frame
+//   bits 40-55  material   derived from the command: shapes share one,
+//                          text another, sprites one per texture
+//   bits  8-39  depth      caller's order within a layer and material
+//
+// render_queue_submit radix-sorts the keys once (stable, so equal keys
+// keep submission order) and draws the commands, so all shapes of a layer
+// go out as one triangle stream and each texture is bound once per layer.
+//
+// Commands are written into streams. A stream belongs to one thread at a
+// time, so jobs can fill streams in parallel without locks; streams are
+// read in index order, which keeps ties deterministic.
+//
+// Usage:
+//   RenderQueue queue;
+//   render_queue_init(&queue);
+//   render_queue_begin(&queue);                       // Each frame
+//   RenderStream* s = render_queue_stream(&queue, 0);
+//   render_queue_quad(s, LAYER_FOG, 0.0f, x, y, w, h, color);
+//   render_queue_submit(&queue);
+//   render_queue_shutdown(&queue);
+// =============================================================================
+
+#define RENDER_QUEUE_MAX_STREAMS 16
+#define RENDER_QUEUE_MIN_COMMANDS 256      // Commands a stream allocates on first use
+
+#define RENDER_MATERIAL_SHAPES 0
+#define RENDER_MATERIAL_TEXT 0xFFFE
+#define RENDER_MATERIAL_CALLBACK 0xFFFF
+
+typedef enum RenderCommandType {
+    RENDER_CMD_TRIANGLE,
+    RENDER_CMD_QUAD,
+    RENDER_CMD_LINE,
+    RENDER_CMD_CIRCLE,
+    RENDER_CMD_RING,
+    RENDER_CMD_TRIANGLES,           // Range of a caller's TriangleBatch
+    RENDER_CMD_TEXT,
+    RENDER_CMD_SPRITE,
+    RENDER_CMD_CALLBACK
+} RenderCommandType;
+
+typedef void (*RenderCallback)(void* user_data);
+
+typedef struct RenderCommand {
+    uint8_t type;                   // RenderCommandType
+    Color color;
+    union {
+        struct { float x[3]; float y[3]; } triangle;
+        struct { float x, y, width, height; } quad;
+        struct { float x0, y0, x1, y1, thickness; } line;
+        struct { float x, y, radius, thickness; int segments; } circle;    // Circle and ring
+        struct { const TriangleBatch* batch; uint32_t first, count; } triangles;
+        struct { float x, y; int font_size; uint32_t offset; } text;        // offset into the stream's text
+        struct { Texture2D texture; Rectangle source; Rectangle dest; } sprite;
+        struct { RenderCallback func; void* user_data; } callback;
+    };
+} RenderCommand;
+
+typedef struct RenderStream {
+    RenderCommand* commands;
+    uint64_t* keys;
+    uint32_t count;
+    uint32_t capacity;
+    char* text;                     // Text of this stream's text commands
+    uint32_t text_size;
+    uint32_t text_capacity;
+} RenderStream;
+
+typedef struct RenderQueueStats {
+    uint32_t commands;              // Submitted last frame
+    uint32_t runs;                  // Layer and material runs drawn
+    uint32_t sort_passes;           // Radix passes that were not skipped
+} RenderQueueStats;
+
+typedef struct RenderQueue {
+    RenderStream streams[RENDER_QUEUE_MAX_STREAMS];
+
+    // Sort scratch: key and (stream << 24 | index) per command, two buffers
+    uint64_t* sort_keys[2];
+    uint32_t* sort_refs[2];
+    uint32_t sort_capacity;
+
+    TriangleBatch shapes;           // Shape commands of the current run
+    RenderQueueStats stats;
+} RenderQueue;
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+// Initialize an empty queue (no allocation)
+void render_queue_init(RenderQueue* queue);
+
+// Free memory
+void render_queue_shutdown(RenderQueue* queue);
+
+// Empty every stream for a new frame (memory is kept)
+void render_queue_begin(RenderQueue* queue);
+
+// Stream index (< RENDER_QUEUE_MAX_STREAMS), or NULL if out of range
+RenderStream* render_queue_stream(RenderQueue* queue, uint32_t index);
+
+// Sort everything submitted since render_queue_begin and draw it
+void render_queue_submit(RenderQueue* queue);
+
+// =============================================================================
+// Keys
+// =============================================================================
+
+// Sort key for a layer, material and depth (smaller depth draws first)
+uint64_t render_key_make(uint8_t layer, uint16_t material, float depth);
+
+// Sort the commands of every stream and write the draw order as
+// (stream << 24 | index) into out_refs (count = total commands). Used by
+// render_queue_submit; exposed for tests and tools.
+uint32_t render_queue_sort(RenderQueue* queue, const uint32_t** out_refs);
+
+// =============================================================================
+// Commands (depth orders commands within a layer and material)
+// =============================================================================
+
+void render_queue_triangle(RenderStream* stream, uint8_t layer, float depth,
+                           Vector2 a, Vector2 b, Vector2 c, Color color);
+void render_queue_quad(RenderStream* stream, uint8_t layer, float depth,
+                       float x, float y, float width, float height, Color color);
+void render_queue_line(RenderStream* stream, uint8_t layer, float depth,
+                       Vector2 from, Vector2 to, float thickness, Color color);
+void render_queue_circle(RenderStream* stream, uint8_t layer, float depth,
+                         float x, float y, float radius, int segments, Color color);
+void render_queue_ring(RenderStream* stream, uint8_t layer, float depth,
+                       float x, float y, float radius, float thickness, int segments, Color color);
+
+// Vertices [first, first + count) of batch; it must stay unchanged until submit
+void render_queue_triangles(RenderStream* stream, uint8_t layer, float depth,
+                            const TriangleBatch* batch, uint32_t first, uint32_t count);
+
+// Text in the default font (copied into the stream)
+void render_queue_text(RenderStream* stream, uint8_t layer, float depth,
+                       const char* text, float x, float y, int font_size, Color color);
+
+// Texture region drawn into dest (as DrawTexturePro with no rotation)
+void render_queue_sprite(RenderStream* stream, uint8_t layer, float depth, Texture2D texture,
+                         Rectangle source, Rectangle dest, Color tint);
+
+// Call func(user_data) at this point of the draw order (last in its layer)
+void render_queue_callback(RenderStream* stream, uint8_t layer, RenderCallback func, void* user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_RENDER_QUEUE_H
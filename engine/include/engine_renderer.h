@@ -7,6 +7,7 @@ extern "C" {
 
 #include <raylib.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 // =============================================================================
 // Basic Renderer Functions
@@ -21,26 +22,55 @@ void renderer_draw_text(const char* text, int x, int y, int font_size, Color col
 // =============================================================================
 // Batched Rectangle Rendering
 // 
-// For rendering many same-colored rectangles efficiently (e.g., fog cells).
-// Collects rectangles and renders them in a single batch to reduce draw calls.
+// For rendering many rectangles efficiently (fog cells, debug overlays).
+// Rectangles are collected with float coordinates and a colour each, then
+// drawn as indexed quads from vertex buffers the batch keeps on the GPU.
+// Each draw (at most RECT_BATCH_GPU_QUADS quads) writes positions and
+// colours into the next of RECT_BATCH_GPU_BUFFERS buffer sets, so the
+// driver never has to wait for a draw still reading the previous set. The
+// index buffer is built once and shared by every set.
+// Where vertex arrays are unavailable, flush falls back to rlgl's
+// immediate mode. GPU buffers are created on the first flush, so a batch
+// can be filled and measured without a window.
 // =============================================================================
 
-#define RECT_BATCH_MAX_RECTS 2048
+#define RECT_BATCH_DEFAULT_CAPACITY 8192
+#define RECT_BATCH_GPU_QUADS 16384          // 16-bit indices: 4 vertices per quad
+#define RECT_BATCH_GPU_BUFFERS 3            // Vertex buffer sets cycled between draws
 
 typedef struct RectBatch {
-    int16_t x[RECT_BATCH_MAX_RECTS];
-    int16_t y[RECT_BATCH_MAX_RECTS];
-    int16_t w[RECT_BATCH_MAX_RECTS];
-    int16_t h[RECT_BATCH_MAX_RECTS];
+    float* x;
+    float* y;
+    float* w;
+    float* h;
+    Color* colors;
     uint32_t count;
-    Color color;
+    uint32_t capacity;
+    Color color;                    // Colour of renderer_rect_batch_add
+
+    // GPU side (0 = not created yet or unavailable)
+    unsigned int vao[RECT_BATCH_GPU_BUFFERS];
+    unsigned int vbo_positions[RECT_BATCH_GPU_BUFFERS];
+    unsigned int vbo_colors[RECT_BATCH_GPU_BUFFERS];
+    unsigned int ibo;
+    uint32_t next_buffer;           // Set the next draw writes
+    uint32_t gpu_quads;             // Quads each set holds
+    float* staging_positions;       // 8 floats per quad
+    Color* staging_colors;          // 4 per quad
+    uint32_t draw_calls;            // Draws issued by the last flush
 } RectBatch;
 
-// Initialize a rectangle batch with a color
-void renderer_rect_batch_init(RectBatch* batch, Color color);
+// Initialize a batch of up to capacity rectangles (0 = default) drawn in color
+bool renderer_rect_batch_init(RectBatch* batch, uint32_t capacity, Color color);
+
+// Free CPU and GPU memory
+void renderer_rect_batch_shutdown(RectBatch* batch);
 
-// Add a rectangle to the batch (returns false if batch is full)
-bool renderer_rect_batch_add(RectBatch* batch, int x, int y, int w, int h);
+// Add a rectangle in the batch colour (returns false if batch is full)
+bool renderer_rect_batch_add(RectBatch* batch, float x, float y, float w, float h);
+
+// Add a rectangle in its own colour (returns false if batch is full)
+bool renderer_rect_batch_add_colored(RectBatch* batch, float x, float y, float w, float h, Color color);
 
 // Flush all rectangles in the batch (draws them efficiently)
 void renderer_rect_batch_flush(RectBatch* batch);
@@ -48,6 +78,111 @@ void renderer_rect_batch_flush(RectBatch* batch);
 // Clear the batch without drawing
 void renderer_rect_batch_clear(RectBatch* batch);
 
+// =============================================================================
+// Batched Triangle Rendering
+//
+// A stream of coloured triangles built on the CPU, then drawn as one rlgl
+// RL_TRIANGLES batch, so many small shapes of different colours (hulls,
+// wakes, markers) cost a draw call between them rather than one each.
+// Shapes helpers append quads for thick lines and fans for circles.
+// Triangles may be given in either winding. The stream grows as needed and
+// keeps its memory across frames; a zeroed TriangleBatch is empty and valid.
+// =============================================================================
+
+#define TRIANGLE_BATCH_MIN_CAPACITY 3072    // Vertices allocated on first use
+#define TRIANGLE_BATCH_FLUSH_CHUNK 3072     // Vertices checked against rlgl's buffer at a time
+
+typedef struct TriangleBatch {
+    float* x;                       // 3 vertices per triangle
+    float* y;
+    Color* color;
+    uint32_t count;                 // Vertices
+    uint32_t capacity;
+} TriangleBatch;
+
+// Initialize an empty batch (no allocation)
+void renderer_triangle_batch_init(TriangleBatch* batch);
+
+// Free memory
+void renderer_triangle_batch_shutdown(TriangleBatch* batch);
+
+// Make room for vertex_count more vertices (false on allocation failure)
+bool renderer_triangle_batch_reserve(TriangleBatch* batch, uint32_t vertex_count);
+
+// Append a triangle
+void renderer_triangle_batch_add(TriangleBatch* batch, Vector2 a, Vector2 b, Vector2 c, Color color);
+
+// Append a line from a to b as a quad of the given thickness
+void renderer_triangle_batch_add_line(TriangleBatch* batch, Vector2 a, Vector2 b,
+                                      float thickness, Color color);
+
+// Append a circle as a fan of segments triangles
+void renderer_triangle_batch_add_circle(TriangleBatch* batch, float center_x, float center_y,
+                                        float radius, int segments, Color color);
+
+// Append a circle outline of the given thickness (segments quads)
+void renderer_triangle_batch_add_ring(TriangleBatch* batch, float center_x, float center_y,
+                                      float radius, float thickness, int segments, Color color);
+
+// Draw vertices [first, first + count) without emptying the batch
+void renderer_triangle_batch_draw_range(const TriangleBatch* batch, uint32_t first, uint32_t count);
+
+// Draw everything in the batch and empty it
+void renderer_triangle_batch_flush(TriangleBatch* batch);
+
+// Empty the batch without drawing
+void renderer_triangle_batch_clear(TriangleBatch* batch);
+
+// =============================================================================
+// Batched Glyph Rendering
+//
+// Text laid out once into glyph quads (relative to the text's top-left,
+// with normalized coordinates in the font atlas), then drawn any number of
+// times as translated copies from one batch: all labels of a pass share a
+// texture bind and an rlgl batch instead of taking a DrawText call each and
+// a quad call per glyph. Layout and width match DrawTextEx / MeasureTextEx.
+// =============================================================================
+
+#define GLYPH_BATCH_MIN_CAPACITY 1024       // Quads allocated on first use
+#define GLYPH_BATCH_FLUSH_CHUNK 1024        // Quads checked against rlgl's buffer at a time
+#define RENDERER_TEXT_LINE_SPACING 2        // As raylib's default line spacing
+
+typedef struct GlyphQuad {
+    float x0, y0, x1, y1;           // Corners
+    float u0, v0, u1, v1;           // Atlas coordinates
+} GlyphQuad;
+
+typedef struct GlyphBatch {
+    GlyphQuad* quads;
+    Color* colors;
+    uint32_t count;
+    uint32_t capacity;
+    Texture2D atlas;                // Font texture every quad samples
+} GlyphBatch;
+
+// Lay out text in font as DrawTextEx would draw it at (0, 0). Writes up to
+// max_quads quads (blanks take none) and returns how many the text needs;
+// its MeasureTextEx width goes to out_width when non-NULL. A font without an
+// atlas (no window) lays out nothing with width 0.
+uint32_t renderer_text_layout(Font font, const char* text, float font_size, float spacing,
+                              GlyphQuad* out_quads, uint32_t max_quads, float* out_width);
+
+// Initialize an empty batch drawing from atlas (no allocation)
+void renderer_glyph_batch_init(GlyphBatch* batch, Texture2D atlas);
+
+// Free memory
+void renderer_glyph_batch_shutdown(GlyphBatch* batch);
+
+// Append laid-out text moved to (x, y) in one colour (false on allocation failure)
+bool renderer_glyph_batch_add(GlyphBatch* batch, const GlyphQuad* quads, uint32_t count,
+                              float x, float y, Color color);
+
+// Draw everything in the batch and empty it
+void renderer_glyph_batch_flush(GlyphBatch* batch);
+
+// Empty the batch without drawing
+void renderer_glyph_batch_clear(GlyphBatch* batch);
+
 #ifdef __cplusplus
 }
 #endif
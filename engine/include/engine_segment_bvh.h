@@ -0,0 +1,133 @@
+#ifndef ENGINE_SEGMENT_BVH_H
+#define ENGINE_SEGMENT_BVH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// =============================================================================
+// Segment BVH
+//
+// Static bounding volume hierarchy over 2D line segments (coastlines, walls).
+// Built once when the geometry loads: nodes split at the median centroid of
+// their longer side down to SEGMENT_BVH_LEAF_SIZE segments, and the segments
+// are stored in leaf order so a leaf is one contiguous run of each column.
+// Children of a node sit next to each other in the node array.
+//
+// Queries never allocate: traversal uses a fixed stack, and the median split
+// keeps the depth within it for any segment count. The batch forms run one
+// query per element of SoA input columns, so a system can gather all its
+// ships once per tick and query them in one tight loop.
+//
+//   raycast     nearest segment hit along o + t * d, t in [0, max_t]
+//   crossings   segments crossed by a segment (stops counting at a limit)
+//   circle      nearest segment point within a radius
+//   point       inside closed rings (even-odd rule)
+//   fan         crossings from one eye to many targets, sharing one walk
+//               of the tree (line of sight for fog and sensors)
+//
+// Usage:
+//   SegmentBvh bvh;
+//   segment_bvh_init(&bvh);
+//   segment_bvh_build(&bvh, x0, y0, x1, y1, tags, count);
+//   SegmentBvhHit hit;
+//   if (segment_bvh_raycast(&bvh, ox, oy, dx, dy, 1.0f, &hit)) { ... }
+//   segment_bvh_shutdown(&bvh);
+// =============================================================================
+
+#define SEGMENT_BVH_LEAF_SIZE 4
+#define SEGMENT_BVH_STACK_SIZE 64
+#define SEGMENT_BVH_FAN_SEGMENTS 256        // Segments a fan gathers before walking per target
+#define SEGMENT_BVH_NO_HIT UINT32_MAX
+
+typedef struct SegmentBvhNode {
+    float min_x;
+    float min_y;
+    float max_x;
+    float max_y;
+    uint32_t first;                 // Leaf: first segment; inner: left child (right = first + 1)
+    uint32_t count;                 // Segments in a leaf (0 = inner node)
+} SegmentBvhNode;
+
+typedef struct SegmentBvh {
+    SegmentBvhNode* nodes;
+    uint32_t node_count;
+
+    // Segments in leaf order
+    float* x0;
+    float* y0;
+    float* x1;
+    float* y1;
+    uint32_t* tag;                  // Caller's id per segment (e.g. island index)
+    uint32_t segment_count;
+    uint32_t depth;                 // Levels below the root
+} SegmentBvh;
+
+typedef struct SegmentBvhHit {
+    uint32_t segment;               // Leaf-order index (SEGMENT_BVH_NO_HIT = none)
+    uint32_t tag;
+    float t;                        // Ray: parameter along d; circle: distance
+    float x;                        // Hit point (ray) or nearest point (circle)
+    float y;
+    float normal_x;                 // Unit segment normal facing the query origin
+    float normal_y;
+} SegmentBvhHit;
+
+// Initialize an empty BVH (no allocation)
+void segment_bvh_init(SegmentBvh* bvh);
+
+// Shutdown and free memory
+void segment_bvh_shutdown(SegmentBvh* bvh);
+
+// Build over count segments (x0, y0)-(x1, y1), replacing any previous
+// contents. tags may be NULL (tag = input index). Returns false on
+// allocation failure (the BVH is left empty).
+bool segment_bvh_build(SegmentBvh* bvh, const float* x0, const float* y0,
+                       const float* x1, const float* y1, const uint32_t* tags, uint32_t count);
+
+// =============================================================================
+// Single Queries
+// =============================================================================
+
+// Nearest hit along (ox, oy) + t * (dx, dy) for t in [0, max_t]
+bool segment_bvh_raycast(const SegmentBvh* bvh, float ox, float oy, float dx, float dy,
+                         float max_t, SegmentBvhHit* out_hit);
+
+// Segments crossed by (x0, y0)-(x1, y1), counting up to max_crossings
+uint32_t segment_bvh_crossings(const SegmentBvh* bvh, float x0, float y0, float x1, float y1,
+                               uint32_t max_crossings);
+
+// Nearest segment point within radius of (cx, cy)
+bool segment_bvh_circle(const SegmentBvh* bvh, float cx, float cy, float radius,
+                        SegmentBvhHit* out_hit);
+
+// Whether (x, y) is inside the closed rings the segments form (even-odd)
+bool segment_bvh_point_inside(const SegmentBvh* bvh, float x, float y);
+
+// =============================================================================
+// Batch Queries (one per element of the input columns)
+// =============================================================================
+
+// Rays; out_hits[i].segment is SEGMENT_BVH_NO_HIT on a miss. Returns hits.
+uint32_t segment_bvh_raycast_batch(const SegmentBvh* bvh, const float* ox, const float* oy,
+                                   const float* dx, const float* dy, float max_t,
+                                   uint32_t count, SegmentBvhHit* out_hits);
+
+// Circles with per-element radii; misses as above. Returns hits.
+uint32_t segment_bvh_circle_batch(const SegmentBvh* bvh, const float* cx, const float* cy,
+                                  const float* radius, uint32_t count, SegmentBvhHit* out_hits);
+
+// Crossings from (eye_x, eye_y) to each target, counting up to max_crossings
+// (at most 255). Segments near the eye are gathered once and shared.
+void segment_bvh_fan_crossings(const SegmentBvh* bvh, float eye_x, float eye_y,
+                               const float* target_x, const float* target_y, uint32_t count,
+                               uint32_t max_crossings, uint8_t* out_crossings);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_SEGMENT_BVH_H
@@ -0,0 +1,469 @@
+#ifndef ENGINE_SIMD_MATH_H
+#define ENGINE_SIMD_MATH_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENGINE_SIMD_SSE2 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// SIMD Math
+//
+// Wide float types for batch kernels over SoA columns, and the transcendental
+// functions those kernels need so hot loops do not call libm per element.
+//
+//   simd4f / simd4i   4 lanes: one SSE2 register, or a plain array the
+//                     compiler may vectorize on its own
+//   simd8f / simd8i   8 lanes as two 4-lane halves; the halves are
+//                     independent, so the CPU overlaps their latencies
+//
+// Comparisons return masks (all bits set or clear per lane) for
+// simd4_select/simd4_and; kernels compute every branch and blend, so there
+// are no data-dependent jumps. simd4_mask_bits / simd8_mask_bits pack a
+// mask into an int for tests over a whole group (e.g. no lane is live).
+// Loads and stores are unaligned.
+//
+// Max error against libm in double precision, over the whole range given
+// (SimdMathTests sweeps each one):
+//   sincos        2 ULP     |x| <= 8192 radians, or |x| <= 1e6 degrees with
+//                           sincos_deg; absolute error < 1e-7 near the zeros
+//   exp2          1.5 ULP   x in [-126, 127]; 0 below -126, +inf above 128
+//   log2          1.5 ULP   x > 0, subnormals included (0 -> -inf, < 0 -> NaN)
+//   pow           1 + 1.5 * |y * log2(x)| ULP for x > 0 (log2's rounding is
+//                           scaled by y, so keep exponents moderate)
+//   atan2         3.5 ULP   finite inputs; atan2(0, 0) = 0
+//   sqrt          0.5 ULP   (correctly rounded)
+//   rsqrt         4 ULP     x > 0 (0 -> +inf)
+//   distance_sq   2 ULP
+//
+// Usage:
+//   simd4f s, c;
+//   simd4_sincos_deg(simd4_load(&rotation[i]), &s, &c);
+//   simd4_store(&vel_x[i], simd4_mul(s, simd4_load(&speed[i])));
+//
+// Whole arrays: simd_sincos_batch(angles, out_sin, out_cos, count) and
+// friends (engine_simd_math.c).
+// =============================================================================
+
+// =============================================================================
+// 4-Lane Operations
+// =============================================================================
+
+#ifdef ENGINE_SIMD_SSE2
+
+typedef __m128 simd4f;
+typedef __m128i simd4i;
+
+static inline simd4f simd4_load(const float* p)             { return _mm_loadu_ps(p); }
+static inline void simd4_store(float* p, simd4f v)          { _mm_storeu_ps(p, v); }
+static inline simd4f simd4_set(float x)                     { return _mm_set1_ps(x); }
+static inline simd4f simd4_add(simd4f a, simd4f b)          { return _mm_add_ps(a, b); }
+static inline simd4f simd4_sub(simd4f a, simd4f b)          { return _mm_sub_ps(a, b); }
+static inline simd4f simd4_mul(simd4f a, simd4f b)          { return _mm_mul_ps(a, b); }
+static inline simd4f simd4_div(simd4f a, simd4f b)          { return _mm_div_ps(a, b); }
+static inline simd4f simd4_min(simd4f a, simd4f b)          { return _mm_min_ps(a, b); }
+static inline simd4f simd4_max(simd4f a, simd4f b)          { return _mm_max_ps(a, b); }
+static inline simd4f simd4_sqrt(simd4f a)                   { return _mm_sqrt_ps(a); }
+static inline simd4f simd4_rsqrt_estimate(simd4f a)         { return _mm_rsqrt_ps(a); }
+static inline simd4f simd4_abs(simd4f a)                    { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+static inline simd4f simd4_lt(simd4f a, simd4f b)           { return _mm_cmplt_ps(a, b); }
+static inline simd4f simd4_gt(simd4f a, simd4f b)           { return _mm_cmpgt_ps(a, b); }
+static inline simd4f simd4_eq(simd4f a, simd4f b)           { return _mm_cmpeq_ps(a, b); }
+static inline simd4f simd4_and(simd4f a, simd4f b)          { return _mm_and_ps(a, b); }
+static inline simd4f simd4_or(simd4f a, simd4f b)           { return _mm_or_ps(a, b); }
+static inline simd4f simd4_xor(simd4f a, simd4f b)          { return _mm_xor_ps(a, b); }
+static inline simd4f simd4_select(simd4f mask, simd4f a, simd4f b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+static inline simd4i simd4_round_int(simd4f a)              { return _mm_cvtps_epi32(a); }
+static inline simd4i simd4_as_int(simd4f a)                 { return _mm_castps_si128(a); }
+static inline int simd4_mask_bits(simd4f mask)              { return _mm_movemask_ps(mask); }
+
+static inline simd4i simd4i_load(const uint32_t* p)         { return _mm_loadu_si128((const __m128i*)p); }
+static inline simd4i simd4i_set(int32_t x)                  { return _mm_set1_epi32(x); }
+static inline simd4i simd4i_add(simd4i a, simd4i b)         { return _mm_add_epi32(a, b); }
+static inline simd4i simd4i_sub(simd4i a, simd4i b)         { return _mm_sub_epi32(a, b); }
+static inline simd4i simd4i_and(simd4i a, simd4i b)         { return _mm_and_si128(a, b); }
+static inline simd4i simd4i_or(simd4i a, simd4i b)          { return _mm_or_si128(a, b); }
+static inline simd4i simd4i_eq(simd4i a, simd4i b)          { return _mm_cmpeq_epi32(a, b); }
+static inline simd4f simd4i_to_float(simd4i a)              { return _mm_cvtepi32_ps(a); }
+static inline simd4f simd4i_as_float(simd4i a)              { return _mm_castsi128_ps(a); }
+// Shift counts must be compile-time constants
+#define simd4i_shl(a, n) _mm_slli_epi32((a), (n))
+#define simd4i_shr(a, n) _mm_srli_epi32((a), (n))
+#define simd4i_sra(a, n) _mm_srai_epi32((a), (n))
+
+#else
+
+typedef struct simd4f { float v[4]; } simd4f;
+typedef struct simd4i { uint32_t v[4]; } simd4i;
+
+#define SIMD4_LANEWISE(type, name, expr) \
+    static inline type name(type a, type b) { type r; for (int l = 0; l < 4; l++) { expr; } return r; }
+
+static inline simd4f simd4_load(const float* p)             { simd4f r; memcpy(r.v, p, sizeof(r.v)); return r; }
+static inline void simd4_store(float* p, simd4f v)          { memcpy(p, v.v, sizeof(v.v)); }
+static inline simd4f simd4_set(float x)                     { simd4f r = {{x, x, x, x}}; return r; }
+SIMD4_LANEWISE(simd4f, simd4_add, r.v[l] = a.v[l] + b.v[l])
+SIMD4_LANEWISE(simd4f, simd4_sub, r.v[l] = a.v[l] - b.v[l])
+SIMD4_LANEWISE(simd4f, simd4_mul, r.v[l] = a.v[l] * b.v[l])
+SIMD4_LANEWISE(simd4f, simd4_div, r.v[l] = a.v[l] / b.v[l])
+SIMD4_LANEWISE(simd4f, simd4_min, r.v[l] = a.v[l] < b.v[l] ? a.v[l] : b.v[l])
+SIMD4_LANEWISE(simd4f, simd4_max, r.v[l] = a.v[l] > b.v[l] ? a.v[l] : b.v[l])
+SIMD4_LANEWISE(simd4i, simd4i_add, r.v[l] = a.v[l] + b.v[l])
+SIMD4_LANEWISE(simd4i, simd4i_sub, r.v[l] = a.v[l] - b.v[l])
+SIMD4_LANEWISE(simd4i, simd4i_and, r.v[l] = a.v[l] & b.v[l])
+SIMD4_LANEWISE(simd4i, simd4i_or, r.v[l] = a.v[l] | b.v[l])
+SIMD4_LANEWISE(simd4i, simd4i_eq, r.v[l] = a.v[l] == b.v[l] ? 0xFFFFFFFFu : 0u)
+
+#undef SIMD4_LANEWISE
+
+static inline simd4i simd4_as_int(simd4f a)                 { simd4i r; memcpy(r.v, a.v, sizeof(r.v)); return r; }
+static inline simd4f simd4i_as_float(simd4i a)              { simd4f r; memcpy(r.v, a.v, sizeof(r.v)); return r; }
+static inline simd4f simd4_and(simd4f a, simd4f b)          { return simd4i_as_float(simd4i_and(simd4_as_int(a), simd4_as_int(b))); }
+static inline simd4f simd4_or(simd4f a, simd4f b)           { return simd4i_as_float(simd4i_or(simd4_as_int(a), simd4_as_int(b))); }
+static inline simd4f simd4_xor(simd4f a, simd4f b) {
+    simd4i x = simd4_as_int(a), y = simd4_as_int(b);
+    for (int l = 0; l < 4; l++) x.v[l] ^= y.v[l];
+    return simd4i_as_float(x);
+}
+static inline simd4f simd4_sqrt(simd4f a)                   { for (int l = 0; l < 4; l++) a.v[l] = sqrtf(a.v[l]); return a; }
+static inline simd4f simd4_rsqrt_estimate(simd4f a)         { for (int l = 0; l < 4; l++) a.v[l] = 1.0f / sqrtf(a.v[l]); return a; }
+static inline simd4f simd4_abs(simd4f a)                    { for (int l = 0; l < 4; l++) a.v[l] = fabsf(a.v[l]); return a; }
+static inline simd4f simd4_lt(simd4f a, simd4f b) {
+    simd4i r;
+    for (int l = 0; l < 4; l++) r.v[l] = a.v[l] < b.v[l] ? 0xFFFFFFFFu : 0u;
+    return simd4i_as_float(r);
+}
+static inline simd4f simd4_gt(simd4f a, simd4f b)           { return simd4_lt(b, a); }
+static inline simd4f simd4_eq(simd4f a, simd4f b) {
+    simd4i r;
+    for (int l = 0; l < 4; l++) r.v[l] = a.v[l] == b.v[l] ? 0xFFFFFFFFu : 0u;
+    return simd4i_as_float(r);
+}
+static inline simd4f simd4_select(simd4f mask, simd4f a, simd4f b) {
+    simd4i m = simd4_as_int(mask), x = simd4_as_int(a), y = simd4_as_int(b), r;
+    for (int l = 0; l < 4; l++) r.v[l] = (m.v[l] & x.v[l]) | (~m.v[l] & y.v[l]);
+    return simd4i_as_float(r);
+}
+static inline int simd4_mask_bits(simd4f mask) {
+    simd4i m = simd4_as_int(mask);
+    int bits = 0;
+    for (int l = 0; l < 4; l++) bits |= (int)(m.v[l] >> 31) << l;
+    return bits;
+}
+static inline simd4i simd4_round_int(simd4f a) {
+    simd4i r;
+    for (int l = 0; l < 4; l++) r.v[l] = (uint32_t)(int32_t)lrintf(a.v[l]);
+    return r;
+}
+
+static inline simd4i simd4i_load(const uint32_t* p)         { simd4i r; memcpy(r.v, p, sizeof(r.v)); return r; }
+static inline simd4i simd4i_set(int32_t x)                  { simd4i r = {{(uint32_t)x, (uint32_t)x, (uint32_t)x, (uint32_t)x}}; return r; }
+static inline simd4f simd4i_to_float(simd4i a) {
+    simd4f r;
+    for (int l = 0; l < 4; l++) r.v[l] = (float)(int32_t)a.v[l];
+    return r;
+}
+static inline simd4i simd4i_shl(simd4i a, int n)            { for (int l = 0; l < 4; l++) a.v[l] <<= n; return a; }
+static inline simd4i simd4i_shr(simd4i a, int n)            { for (int l = 0; l < 4; l++) a.v[l] >>= n; return a; }
+static inline simd4i simd4i_sra(simd4i a, int n) {
+    for (int l = 0; l < 4; l++) a.v[l] = (uint32_t)((int32_t)a.v[l] >> n);
+    return a;
+}
+
+#endif
+
+// a * b + c (two roundings; there is no FMA in the baseline instruction set)
+static inline simd4f simd4_madd(simd4f a, simd4f b, simd4f c) {
+    return simd4_add(simd4_mul(a, b), c);
+}
+
+static inline simd4f simd4_neg(simd4f a) {
+    return simd4_xor(a, simd4_set(-0.0f));
+}
+
+// a with the sign bit of b
+static inline simd4f simd4_copysign(simd4f a, simd4f b) {
+    simd4f sign = simd4_set(-0.0f);
+    return simd4_or(simd4_abs(a), simd4_and(b, sign));
+}
+
+// =============================================================================
+// 4-Lane Functions
+// =============================================================================
+
+// Shared core of sincos: r in [-pi/4, pi/4] and the quarter turn it was
+// reduced by. sin(r) and cos(r) by minimax polynomials, then rotated.
+static inline void simd4_sincos_reduced(simd4f r, simd4i quadrant, simd4f* out_sin, simd4f* out_cos) {
+    simd4f z = simd4_mul(r, r);
+
+    simd4f s = simd4_madd(simd4_set(-1.9515295891e-4f), z, simd4_set(8.3321608736e-3f));
+    s = simd4_madd(s, z, simd4_set(-1.6666654611e-1f));
+    s = simd4_madd(simd4_mul(s, z), r, r);
+
+    simd4f c = simd4_madd(simd4_set(2.443315711809948e-5f), z, simd4_set(-1.388731625493765e-3f));
+    c = simd4_madd(c, z, simd4_set(4.166664568298827e-2f));
+    c = simd4_madd(simd4_mul(c, z), z, simd4_madd(simd4_set(-0.5f), z, simd4_set(1.0f)));
+
+    // Quadrant q: sin = (s, c, -s, -c)[q & 3], cos = (c, -s, -c, s)[q & 3]
+    simd4f swap = simd4i_as_float(simd4i_eq(simd4i_and(quadrant, simd4i_set(1)), simd4i_set(1)));
+    simd4f sin_sign = simd4i_as_float(simd4i_shl(simd4i_and(quadrant, simd4i_set(2)), 30));
+    simd4f cos_sign = simd4i_as_float(simd4i_shl(simd4i_and(simd4i_add(quadrant, simd4i_set(1)), simd4i_set(2)), 30));
+    *out_sin = simd4_xor(simd4_select(swap, c, s), sin_sign);
+    *out_cos = simd4_xor(simd4_select(swap, s, c), cos_sign);
+}
+
+// sin and cos of an angle in radians. The quarter turn is subtracted in
+// three parts (Cody-Waite) so the reduction stays exact for |x| <= 8192.
+static inline void simd4_sincos(simd4f x, simd4f* out_sin, simd4f* out_cos) {
+    simd4i quadrant = simd4_round_int(simd4_mul(x, simd4_set(0.63661977236758134f)));
+    simd4f q = simd4i_to_float(quadrant);
+    simd4f r = simd4_sub(x, simd4_mul(q, simd4_set(1.5703125f)));
+    r = simd4_sub(r, simd4_mul(q, simd4_set(4.837512969970703125e-4f)));
+    r = simd4_sub(r, simd4_mul(q, simd4_set(7.54978995489188216e-8f)));
+    simd4_sincos_reduced(r, quadrant, out_sin, out_cos);
+}
+
+// sin and cos of an angle in degrees (ship headings). Quarter turns are
+// exact in degrees, so only the final [-45, 45] remainder is rounded.
+static inline void simd4_sincos_deg(simd4f degrees, simd4f* out_sin, simd4f* out_cos) {
+    simd4i quadrant = simd4_round_int(simd4_mul(degrees, simd4_set(1.0f / 90.0f)));
+    simd4f r = simd4_sub(degrees, simd4_mul(simd4i_to_float(quadrant), simd4_set(90.0f)));
+    simd4_sincos_reduced(simd4_mul(r, simd4_set(0.017453292519943295f)), quadrant, out_sin, out_cos);
+}
+
+// 2^x: integer part into the exponent bits, 2^f for f in [-0.5, 0.5] by a
+// minimax polynomial
+static inline simd4f simd4_exp2(simd4f x) {
+    simd4f clamped = simd4_max(simd4_min(x, simd4_set(127.0f)), simd4_set(-126.0f));
+    simd4i n = simd4_round_int(clamped);
+    simd4f f = simd4_sub(clamped, simd4i_to_float(n));
+
+    simd4f p = simd4_madd(simd4_set(1.535336188319500e-4f), f, simd4_set(1.339887440266574e-3f));
+    p = simd4_madd(p, f, simd4_set(9.618437357674640e-3f));
+    p = simd4_madd(p, f, simd4_set(5.550332471162809e-2f));
+    p = simd4_madd(p, f, simd4_set(2.402264791363012e-1f));
+    p = simd4_madd(p, f, simd4_set(6.931472028550421e-1f));
+    p = simd4_madd(p, f, simd4_set(1.0f));
+
+    simd4f result = simd4_mul(p, simd4i_as_float(simd4i_shl(simd4i_add(n, simd4i_set(127)), 23)));
+    result = simd4_select(simd4_lt(x, simd4_set(-126.0f)), simd4_set(0.0f), result);
+    result = simd4_select(simd4_gt(x, simd4_set(128.0f)), simd4_set(INFINITY), result);
+    return simd4_select(simd4_eq(x, x), result, x);  // NaN passes through
+}
+
+// log2(x): exponent from the bits, mantissa m in [sqrt(1/2), sqrt(2)) by a
+// minimax polynomial in m - 1. Subnormal inputs are scaled up first.
+static inline simd4f simd4_log2(simd4f x) {
+    simd4f subnormal = simd4_lt(x, simd4_set(1.17549435e-38f));
+    simd4f scaled = simd4_select(subnormal, simd4_mul(x, simd4_set(8388608.0f)), x);
+    simd4f bias = simd4_and(subnormal, simd4_set(23.0f));
+
+    simd4i offset = simd4i_sub(simd4_as_int(scaled), simd4i_set(0x3F3504F3));
+    simd4f e = simd4_sub(simd4i_to_float(simd4i_sra(offset, 23)), bias);
+    simd4f m = simd4i_as_float(simd4i_add(simd4i_and(offset, simd4i_set(0x007FFFFF)), simd4i_set(0x3F3504F3)));
+    simd4f t = simd4_sub(m, simd4_set(1.0f));
+    simd4f z = simd4_mul(t, t);
+
+    simd4f p = simd4_madd(simd4_set(7.0376836292e-2f), t, simd4_set(-1.1514610310e-1f));
+    p = simd4_madd(p, t, simd4_set(1.1676998740e-1f));
+    p = simd4_madd(p, t, simd4_set(-1.2420140846e-1f));
+    p = simd4_madd(p, t, simd4_set(1.4249322787e-1f));
+    p = simd4_madd(p, t, simd4_set(-1.6668057665e-1f));
+    p = simd4_madd(p, t, simd4_set(2.0000714765e-1f));
+    p = simd4_madd(p, t, simd4_set(-2.4999993993e-1f));
+    p = simd4_madd(p, t, simd4_set(3.3333331174e-1f));
+    simd4f y = simd4_madd(simd4_mul(p, t), z, simd4_mul(z, simd4_set(-0.5f)));
+
+    // (y + t) * log2(e), with log2(e) - 1 kept separate for precision
+    const simd4f log2e_minus_one = simd4_set(0.44269504088896340736f);
+    simd4f result = simd4_mul(y, log2e_minus_one);
+    result = simd4_madd(t, log2e_minus_one, result);
+    result = simd4_add(result, y);
+    result = simd4_add(result, t);
+    result = simd4_add(result, e);
+
+    simd4f zero = simd4_set(0.0f);
+    result = simd4_select(simd4_eq(x, simd4_set(INFINITY)), x, result);
+    result = simd4_select(simd4_eq(x, zero), simd4_set(-INFINITY), result);
+    result = simd4_select(simd4_lt(x, zero), simd4_set(NAN), result);
+    return simd4_select(simd4_eq(x, x), result, x);  // NaN passes through
+}
+
+// x^y = 2^(y * log2(x)) for x > 0 (0^y = 0 for y > 0)
+static inline simd4f simd4_pow(simd4f x, simd4f y) {
+    return simd4_exp2(simd4_mul(y, simd4_log2(x)));
+}
+
+// atan2(y, x): atan of min/max(|x|, |y|) in [0, 1], reduced around tan(pi/8),
+// then unfolded into the octant of (x, y)
+static inline simd4f simd4_atan2(simd4f y, simd4f x) {
+    simd4f ax = simd4_abs(x);
+    simd4f ay = simd4_abs(y);
+    simd4f hi = simd4_max(ax, ay);
+    simd4f lo = simd4_min(ax, ay);
+    simd4f a = simd4_div(lo, hi);
+    a = simd4_select(simd4_eq(hi, simd4_set(0.0f)), simd4_set(0.0f), a);
+
+    simd4f one = simd4_set(1.0f);
+    simd4f upper = simd4_gt(a, simd4_set(0.41421356237309505f));
+    simd4f t = simd4_select(upper, simd4_div(simd4_sub(a, one), simd4_add(a, one)), a);
+    simd4f z = simd4_mul(t, t);
+
+    simd4f p = simd4_madd(simd4_set(8.05374449538e-2f), z, simd4_set(-1.38776856032e-1f));
+    p = simd4_madd(p, z, simd4_set(1.99777106478e-1f));
+    p = simd4_madd(p, z, simd4_set(-3.33329491539e-1f));
+    simd4f r = simd4_madd(simd4_mul(p, z), t, t);
+    r = simd4_add(r, simd4_and(upper, simd4_set(0.78539816339744831f)));
+
+    r = simd4_select(simd4_gt(ay, ax), simd4_sub(simd4_set(1.57079632679489662f), r), r);
+    simd4f x_negative = simd4i_as_float(simd4i_sra(simd4_as_int(x), 31));
+    r = simd4_select(x_negative, simd4_sub(simd4_set(3.14159265358979324f), r), r);
+    return simd4_copysign(r, y);
+}
+
+// 1/sqrt(x): hardware estimate refined by one Newton step
+static inline simd4f simd4_rsqrt(simd4f x) {
+    simd4f estimate = simd4_rsqrt_estimate(x);
+#ifdef ENGINE_SIMD_SSE2
+    simd4f half_x = simd4_mul(x, simd4_set(0.5f));
+    simd4f refined = simd4_mul(estimate, simd4_sub(simd4_set(1.5f),
+                                                   simd4_mul(half_x, simd4_mul(estimate, estimate))));
+    return simd4_select(simd4_eq(x, simd4_set(0.0f)), estimate, refined);
+#else
+    return estimate;
+#endif
+}
+
+// Squared distance between (x1, y1) and (x2, y2) per lane
+static inline simd4f simd4_distance_sq(simd4f x1, simd4f y1, simd4f x2, simd4f y2) {
+    simd4f dx = simd4_sub(x2, x1);
+    simd4f dy = simd4_sub(y2, y1);
+    return simd4_madd(dx, dx, simd4_mul(dy, dy));
+}
+
+// =============================================================================
+// 8-Lane Operations
+// =============================================================================
+
+typedef struct simd8f { simd4f lo, hi; } simd8f;
+typedef struct simd8i { simd4i lo, hi; } simd8i;
+
+#define SIMD8_UNARY(type, name, op) \
+    static inline type name(type a) { type r; r.lo = op(a.lo); r.hi = op(a.hi); return r; }
+#define SIMD8_BINARY(type, name, op) \
+    static inline type name(type a, type b) { type r; r.lo = op(a.lo, b.lo); r.hi = op(a.hi, b.hi); return r; }
+
+static inline simd8f simd8_load(const float* p)             { simd8f r; r.lo = simd4_load(p); r.hi = simd4_load(p + 4); return r; }
+static inline void simd8_store(float* p, simd8f v)          { simd4_store(p, v.lo); simd4_store(p + 4, v.hi); }
+static inline simd8f simd8_set(float x)                     { simd8f r; r.lo = simd4_set(x); r.hi = r.lo; return r; }
+SIMD8_BINARY(simd8f, simd8_add, simd4_add)
+SIMD8_BINARY(simd8f, simd8_sub, simd4_sub)
+SIMD8_BINARY(simd8f, simd8_mul, simd4_mul)
+SIMD8_BINARY(simd8f, simd8_div, simd4_div)
+SIMD8_BINARY(simd8f, simd8_min, simd4_min)
+SIMD8_BINARY(simd8f, simd8_max, simd4_max)
+SIMD8_BINARY(simd8f, simd8_lt, simd4_lt)
+SIMD8_BINARY(simd8f, simd8_gt, simd4_gt)
+SIMD8_BINARY(simd8f, simd8_eq, simd4_eq)
+SIMD8_BINARY(simd8f, simd8_and, simd4_and)
+SIMD8_BINARY(simd8f, simd8_or, simd4_or)
+SIMD8_BINARY(simd8f, simd8_xor, simd4_xor)
+SIMD8_BINARY(simd8f, simd8_copysign, simd4_copysign)
+SIMD8_BINARY(simd8f, simd8_pow, simd4_pow)
+SIMD8_BINARY(simd8f, simd8_atan2, simd4_atan2)
+SIMD8_UNARY(simd8f, simd8_abs, simd4_abs)
+SIMD8_UNARY(simd8f, simd8_neg, simd4_neg)
+SIMD8_UNARY(simd8f, simd8_sqrt, simd4_sqrt)
+SIMD8_UNARY(simd8f, simd8_rsqrt, simd4_rsqrt)
+SIMD8_UNARY(simd8f, simd8_exp2, simd4_exp2)
+SIMD8_UNARY(simd8f, simd8_log2, simd4_log2)
+
+static inline simd8i simd8i_load(const uint32_t* p)         { simd8i r; r.lo = simd4i_load(p); r.hi = simd4i_load(p + 4); return r; }
+static inline simd8i simd8i_set(int32_t x)                  { simd8i r; r.lo = simd4i_set(x); r.hi = r.lo; return r; }
+SIMD8_BINARY(simd8i, simd8i_add, simd4i_add)
+SIMD8_BINARY(simd8i, simd8i_sub, simd4i_sub)
+SIMD8_BINARY(simd8i, simd8i_and, simd4i_and)
+SIMD8_BINARY(simd8i, simd8i_or, simd4i_or)
+SIMD8_BINARY(simd8i, simd8i_eq, simd4i_eq)
+
+#undef SIMD8_UNARY
+#undef SIMD8_BINARY
+
+static inline simd8f simd8_madd(simd8f a, simd8f b, simd8f c) {
+    simd8f r;
+    r.lo = simd4_madd(a.lo, b.lo, c.lo);
+    r.hi = simd4_madd(a.hi, b.hi, c.hi);
+    return r;
+}
+
+static inline simd8f simd8_select(simd8f mask, simd8f a, simd8f b) {
+    simd8f r;
+    r.lo = simd4_select(mask.lo, a.lo, b.lo);
+    r.hi = simd4_select(mask.hi, a.hi, b.hi);
+    return r;
+}
+
+// Bit l set when lane l of a mask is set (for skipping whole groups)
+static inline int simd8_mask_bits(simd8f mask) {
+    return simd4_mask_bits(mask.lo) | (simd4_mask_bits(mask.hi) << 4);
+}
+
+static inline simd8f simd8i_as_float(simd8i a) {
+    simd8f r;
+    r.lo = simd4i_as_float(a.lo);
+    r.hi = simd4i_as_float(a.hi);
+    return r;
+}
+
+static inline void simd8_sincos(simd8f x, simd8f* out_sin, simd8f* out_cos) {
+    simd4_sincos(x.lo, &out_sin->lo, &out_cos->lo);
+    simd4_sincos(x.hi, &out_sin->hi, &out_cos->hi);
+}
+
+static inline void simd8_sincos_deg(simd8f degrees, simd8f* out_sin, simd8f* out_cos) {
+    simd4_sincos_deg(degrees.lo, &out_sin->lo, &out_cos->lo);
+    simd4_sincos_deg(degrees.hi, &out_sin->hi, &out_cos->hi);
+}
+
+static inline simd8f simd8_distance_sq(simd8f x1, simd8f y1, simd8f x2, simd8f y2) {
+    simd8f r;
+    r.lo = simd4_distance_sq(x1.lo, y1.lo, x2.lo, y2.lo);
+    r.hi = simd4_distance_sq(x1.hi, y1.hi, x2.hi, y2.hi);
+    return r;
+}
+
+// =============================================================================
+// Batch Kernels
+//
+// Apply a function to whole arrays, 8 elements per step with a padded tail.
+// Outputs may alias inputs.
+// =============================================================================
+
+void simd_sincos_batch(const float* radians, float* out_sin, float* out_cos, uint32_t count);
+void simd_sincos_deg_batch(const float* degrees, float* out_sin, float* out_cos, uint32_t count);
+void simd_exp2_batch(const float* x, float* out, uint32_t count);
+void simd_log2_batch(const float* x, float* out, uint32_t count);
+void simd_pow_batch(const float* x, const float* y, float* out, uint32_t count);
+void simd_atan2_batch(const float* y, const float* x, float* out, uint32_t count);
+void simd_sqrt_batch(const float* x, float* out, uint32_t count);
+void simd_rsqrt_batch(const float* x, float* out, uint32_t count);
+
+// Squared distance from (px, py) to each (xs[i], ys[i])
+void simd_distance_sq_batch(const float* xs, const float* ys, float px, float py,
+                            float* out, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_SIMD_MATH_H
@@ -0,0 +1,101 @@
+#ifndef ENGINE_SPATIAL_GRID_H
+#define ENGINE_SPATIAL_GRID_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// =============================================================================
+// Spatial Grid
+//
+// Static uniform grid over 2D points, packed in CSR form: items are sorted by
+// cell and each cell is a contiguous [start, end) range in one index array.
+// Built in O(N) with a counting sort and rebuilt wholesale when the point set
+// changes, which suits data that is loaded once and queried every tick
+// (POIs, static markers). Queries touch only the cells overlapping the query
+// rectangle, so a proximity test costs O(k) rather than O(N).
+//
+// Usage:
+//   SpatialGrid grid;
+//   spatial_grid_init(&grid);
+//   spatial_grid_build(&grid, xs, ys, count, 100.0f);
+//   uint32_t n = spatial_grid_query_rect(&grid, x0, y0, x1, y1, out, max_out);
+//   spatial_grid_shutdown(&grid);
+// =============================================================================
+
+// Upper bound on cells per item; the cell size grows when sparse data would
+// exceed it, keeping memory proportional to the item count
+#define SPATIAL_GRID_MAX_CELLS_PER_ITEM 4
+#define SPATIAL_GRID_MIN_CELLS 64
+
+typedef struct SpatialGrid {
+    uint32_t* cell_start;   // cell_count + 1 offsets into items
+    uint32_t* items;        // Item indices grouped by cell (ascending within a cell)
+    float origin_x;         // World position of cell (0, 0)
+    float origin_y;
+    float cell_size;
+    float inv_cell_size;
+    int32_t cols;
+    int32_t rows;
+    uint32_t cell_count;
+    uint32_t item_count;
+    uint32_t cell_capacity; // Allocated entries in cell_start (excluding sentinel)
+    uint32_t item_capacity;
+} SpatialGrid;
+
+// Inclusive range of cells overlapping a query rectangle
+typedef struct SpatialGridSpan {
+    int32_t min_cx;
+    int32_t min_cy;
+    int32_t max_cx;
+    int32_t max_cy;
+} SpatialGridSpan;
+
+// Initialize an empty grid (no allocation)
+void spatial_grid_init(SpatialGrid* grid);
+
+// Shutdown and free memory
+void spatial_grid_shutdown(SpatialGrid* grid);
+
+// Remove all items (keeps allocated memory)
+void spatial_grid_clear(SpatialGrid* grid);
+
+// Rebuild the grid from point arrays. cell_size is a lower bound; it is
+// enlarged if the bounds would need too many cells. Returns false on
+// allocation failure (grid is left empty).
+bool spatial_grid_build(SpatialGrid* grid, const float* xs, const float* ys,
+                        uint32_t count, float cell_size);
+
+// Get the cells overlapping a world-space rectangle, clamped to the grid.
+// Returns false if the rectangle misses the grid entirely.
+bool spatial_grid_get_span(const SpatialGrid* grid, float min_x, float min_y,
+                           float max_x, float max_y, SpatialGridSpan* out_span);
+
+// Collect item indices in cells overlapping a rectangle (candidates only;
+// callers do the exact distance test). Writes up to max_out indices and
+// returns the total number of candidates, which may exceed max_out.
+uint32_t spatial_grid_query_rect(const SpatialGrid* grid, float min_x, float min_y,
+                                 float max_x, float max_y, uint32_t* out, uint32_t max_out);
+
+// Get the items stored in one cell (allocation-free iteration)
+static inline const uint32_t* spatial_grid_cell_items(const SpatialGrid* grid, int32_t cx,
+                                                      int32_t cy, uint32_t* out_count) {
+    uint32_t cell = (uint32_t)(cy * grid->cols + cx);
+    uint32_t start = grid->cell_start[cell];
+    *out_count = grid->cell_start[cell + 1] - start;
+    return grid->items + start;
+}
+
+// Get current item count
+static inline uint32_t spatial_grid_count(const SpatialGrid* grid) {
+    return grid ? grid->item_count : 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_SPATIAL_GRID_H
@@ -0,0 +1,83 @@
+#ifndef ENGINE_STRING_ARENA_H
+#define ENGINE_STRING_ARENA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// =============================================================================
+// String Arena
+//
+// Append-only storage for NUL-terminated strings, referenced by 32-bit byte
+// offsets instead of pointers (offsets stay valid when the buffer grows).
+// Identical strings are interned: adding the same text twice returns the
+// same offset. Offset 0 is always the empty string, so zero-initialized
+// offset arrays read back as "".
+//
+// Usage:
+//   StringArena arena;
+//   string_arena_init(&arena, 4096);
+//   uint32_t off = string_arena_intern(&arena, "Vinga Lighthouse");
+//   const char* s = string_arena_get(&arena, off);
+//   string_arena_shutdown(&arena);
+// =============================================================================
+
+#define STRING_ARENA_EMPTY 0u
+#define STRING_ARENA_INVALID 0xFFFFFFFFu
+
+typedef struct StringArenaSlot {
+    uint32_t hash;
+    uint32_t offset;            // STRING_ARENA_INVALID = empty slot
+} StringArenaSlot;
+
+typedef struct StringArena {
+    char* data;
+    uint32_t size;              // Bytes used, including terminators
+    uint32_t capacity;          // Bytes allocated
+    StringArenaSlot* slots;     // Intern table (open addressing, linear probing)
+    uint32_t slot_capacity;     // Power of 2
+    uint32_t string_count;      // Distinct strings (excluding the empty string)
+    bool owns_data;             // false while wrapping external memory
+    bool slots_stale;           // Intern table must be rebuilt before interning
+} StringArena;
+
+// Initialize arena with an initial byte capacity
+bool string_arena_init(StringArena* arena, uint32_t initial_capacity);
+
+// Wrap existing arena contents (data[0] must be '\0', strings NUL-terminated,
+// no duplicates). Nothing is copied; data must outlive the arena or the
+// first append. The intern table is built lazily on the first intern call.
+bool string_arena_init_external(StringArena* arena, char* data, uint32_t size);
+
+// Shutdown and free memory
+void string_arena_shutdown(StringArena* arena);
+
+// Drop all strings (keeps allocated memory); offset 0 stays the empty string
+void string_arena_clear(StringArena* arena);
+
+// Intern a string, returns its offset or STRING_ARENA_INVALID on failure.
+// NULL and "" return STRING_ARENA_EMPTY.
+uint32_t string_arena_intern(StringArena* arena, const char* str);
+
+// Intern the first len bytes of str (need not be NUL-terminated)
+uint32_t string_arena_intern_n(StringArena* arena, const char* str, uint32_t len);
+
+// Resolve an offset; out-of-range offsets resolve to ""
+static inline const char* string_arena_get(const StringArena* arena, uint32_t offset) {
+    if (!arena || !arena->data || offset >= arena->size) return "";
+    return arena->data + offset;
+}
+
+// Get bytes used
+static inline uint32_t string_arena_size(const StringArena* arena) {
+    return arena ? arena->size : 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_STRING_ARENA_H
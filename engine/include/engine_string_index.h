@@ -0,0 +1,76 @@
+#ifndef ENGINE_STRING_INDEX_H
+#define ENGINE_STRING_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "engine_string_arena.h"
+
+// =============================================================================
+// String Index
+//
+// O(1) lookup from a string key to a 32-bit value. Keys are not copied: each
+// entry stores the key's offset in a StringArena plus its hash, so the index
+// is just a flat table of 12-byte entries. Keys are compared ASCII
+// case-insensitively ("Vinga" == "VINGA"). Uses open addressing with linear
+// probing; removal uses backward-shift deletion so probe chains stay intact.
+//
+// Usage:
+//   StringIndex index;
+//   string_index_init(&index, 256);
+//   string_index_insert(&index, &arena, name_offset, poi_index);
+//   uint32_t idx = string_index_find(&index, &arena, "vinga lighthouse");
+//   string_index_shutdown(&index);
+// =============================================================================
+
+#define STRING_INDEX_NOT_FOUND 0xFFFFFFFFu
+
+typedef struct StringIndexEntry {
+    uint32_t hash;              // Case-folded FNV-1a hash of the key
+    uint32_t key_offset;        // Key in the arena; STRING_ARENA_INVALID = empty slot
+    uint32_t value;
+} StringIndexEntry;
+
+typedef struct StringIndex {
+    StringIndexEntry* entries;
+    uint32_t capacity;          // Power of 2
+    uint32_t count;
+    uint32_t mask;              // capacity - 1
+} StringIndex;
+
+// Initialize with capacity for roughly `expected` keys (grows on demand)
+bool string_index_init(StringIndex* index, uint32_t expected);
+
+// Shutdown and free memory
+void string_index_shutdown(StringIndex* index);
+
+// Remove all entries (keeps allocated memory)
+void string_index_clear(StringIndex* index);
+
+// Insert key (an offset into arena) if not present.
+// Returns false if an equal key already exists or allocation failed.
+bool string_index_insert(StringIndex* index, const StringArena* arena,
+                         uint32_t key_offset, uint32_t value);
+
+// Overwrite the value of an existing key, returns false if not present
+bool string_index_set(StringIndex* index, const StringArena* arena, const char* key, uint32_t value);
+
+// Find value for key, returns STRING_INDEX_NOT_FOUND if missing
+uint32_t string_index_find(const StringIndex* index, const StringArena* arena, const char* key);
+
+// Remove key, returns true if found and removed
+bool string_index_remove(StringIndex* index, const StringArena* arena, const char* key);
+
+// Get current entry count
+static inline uint32_t string_index_count(const StringIndex* index) {
+    return index ? index->count : 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_STRING_INDEX_H
@@ -0,0 +1,123 @@
+#include "engine_bitset.h"
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static inline uint32_t words_for(uint32_t bit_count) {
+    return (bit_count + 63) >> 6;
+}
+
+static inline uint32_t popcount64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_popcountll(word);
+#else
+    uint32_t count = 0;
+    while (word) {
+        word &= word - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+static inline uint32_t lowest_bit64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctzll(word);
+#else
+    uint32_t bit = 0;
+    while (!(word & 1u)) {
+        word >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+bool bitset_init(Bitset* set, uint32_t bit_count) {
+    if (!set) return false;
+    memset(set, 0, sizeof(Bitset));
+    return bitset_resize(set, bit_count);
+}
+
+void bitset_shutdown(Bitset* set) {
+    if (!set) return;
+    free(set->words);
+    memset(set, 0, sizeof(Bitset));
+}
+
+bool bitset_resize(Bitset* set, uint32_t bit_count) {
+    if (!set) return false;
+
+    uint32_t word_count = words_for(bit_count);
+    if (word_count > set->word_count) {
+        uint64_t* words = (uint64_t*)realloc(set->words, word_count * sizeof(uint64_t));
+        if (!words) return false;
+        memset(words + set->word_count, 0, (word_count - set->word_count) * sizeof(uint64_t));
+        set->words = words;
+        set->word_count = word_count;
+    }
+
+    // Drop bits past the new end so a later grow sees them clear
+    if (bit_count < set->bit_count) {
+        uint32_t first_word = words_for(bit_count);
+        if (bit_count & 63) {
+            set->words[bit_count >> 6] &= ((uint64_t)1 << (bit_count & 63)) - 1;
+        }
+        memset(set->words + first_word, 0, (set->word_count - first_word) * sizeof(uint64_t));
+    }
+    set->bit_count = bit_count;
+    return true;
+}
+
+void bitset_clear_all(Bitset* set) {
+    if (!set || !set->words) return;
+    memset(set->words, 0, set->word_count * sizeof(uint64_t));
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+uint32_t bitset_count(const Bitset* set) {
+    if (!set) return 0;
+
+    uint32_t count = 0;
+    for (uint32_t w = 0; w < set->word_count; w++) {
+        count += popcount64(set->words[w]);
+    }
+    return count;
+}
+
+uint32_t bitset_count_and(const Bitset* a, const Bitset* b) {
+    if (!a || !b) return 0;
+
+    uint32_t words = a->word_count < b->word_count ? a->word_count : b->word_count;
+    uint32_t count = 0;
+    for (uint32_t w = 0; w < words; w++) {
+        count += popcount64(a->words[w] & b->words[w]);
+    }
+    return count;
+}
+
+uint32_t bitset_next(const Bitset* set, uint32_t from) {
+    if (!set || from >= set->bit_count) return BITSET_NONE;
+
+    uint32_t w = from >> 6;
+    uint64_t word = set->words[w] & (~(uint64_t)0 << (from & 63));
+    uint32_t last_word = words_for(set->bit_count);
+    for (;;) {
+        if (word) {
+            uint32_t bit = (w << 6) + lowest_bit64(word);
+            return bit < set->bit_count ? bit : BITSET_NONE;
+        }
+        if (++w >= last_word) return BITSET_NONE;
+        word = set->words[w];
+    }
+}
@@ -1,6 +1,7 @@
 #include "engine_camera.h"
 #include "engine_math.h"
 #include <raylib.h>
+#include <math.h>
 
 CameraConfig camera_get_default_config(void) {
     CameraConfig config = {
@@ -114,31 +115,43 @@ void camera_end(void) {
     EndMode2D();
 }
 
-bool camera_is_rect_visible(const CameraState* camera, Rectangle world_rect, int screen_width, int screen_height) {
-    if (!camera) return false;
+Rectangle camera_get_view_rect(const CameraState* camera, int screen_width, int screen_height) {
+    if (!camera) return (Rectangle){0.0f, 0.0f, 0.0f, 0.0f};
     
-    // Calculate visible world area
     float half_width = (screen_width / 2.0f) / camera->zoom;
     float half_height = (screen_height / 2.0f) / camera->zoom;
     
-    Rectangle view_rect = {
+    // A rotated view covers the box around its corners
+    if (camera->rotation != 0.0f) {
+        float angle = camera->rotation * DEG2RAD;
+        float c = fabsf(cosf(angle));
+        float s = fabsf(sinf(angle));
+        float rotated_width = half_width * c + half_height * s;
+        half_height = half_width * s + half_height * c;
+        half_width = rotated_width;
+    }
+    
+    return (Rectangle){
         camera->position.x - half_width,
         camera->position.y - half_height,
         half_width * 2.0f,
         half_height * 2.0f
     };
+}
+
+bool camera_is_rect_visible(const CameraState* camera, Rectangle world_rect, int screen_width, int screen_height) {
+    if (!camera) return false;
     
+    Rectangle view_rect = camera_get_view_rect(camera, screen_width, screen_height);
     return CheckCollisionRecs(view_rect, world_rect);
 }
 
 bool camera_is_point_visible(const CameraState* camera, Vector2 world_pos, int screen_width, int screen_height) {
     if (!camera) return false;
     
-    float half_width = (screen_width / 2.0f) / camera->zoom;
-    float half_height = (screen_height / 2.0f) / camera->zoom;
-    
-    return (world_pos.x >= camera->position.x - half_width &&
-            world_pos.x <= camera->position.x + half_width &&
-            world_pos.y >= camera->position.y - half_height &&
-            world_pos.y <= camera->position.y + half_height);
+    Rectangle view_rect = camera_get_view_rect(camera, screen_width, screen_height);
+    return (world_pos.x >= view_rect.x &&
+            world_pos.x <= view_rect.x + view_rect.width &&
+            world_pos.y >= view_rect.y &&
+            world_pos.y <= view_rect.y + view_rect.height);
 }
@@ -0,0 +1,532 @@
+#include "engine_collision.h"
+#include "engine_math.h"
+#include "engine_simd_math.h"
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static inline bool body_active(const CollisionBodies* b, uint32_t i) {
+    return !b->masks || (b->masks[i] & b->required) == b->required;
+}
+
+static bool grow_array(void** data, uint32_t capacity, size_t element_size) {
+    void* grown = realloc(*data, (size_t)capacity * element_size);
+    if (!grown) return false;
+    *data = grown;
+    return true;
+}
+
+// Room for count active bodies in the grid-ordered arrays
+static bool ensure_body_capacity(CollisionWorld* w, uint32_t count) {
+    if (count <= w->capacity) return true;
+    uint32_t capacity = w->capacity ? w->capacity : 256;
+    while (capacity < count) capacity *= 2;
+
+    bool ok = grow_array((void**)&w->body, capacity, sizeof(uint32_t)) &&
+              grow_array((void**)&w->x, capacity, sizeof(float)) &&
+              grow_array((void**)&w->y, capacity, sizeof(float)) &&
+              grow_array((void**)&w->radius, capacity, sizeof(float)) &&
+              grow_array((void**)&w->heading_sin, capacity, sizeof(float)) &&
+              grow_array((void**)&w->heading_cos, capacity, sizeof(float)) &&
+              grow_array((void**)&w->hull_x, capacity * 3, sizeof(float)) &&
+              grow_array((void**)&w->hull_y, capacity * 3, sizeof(float)) &&
+              grow_array((void**)&w->axis_x, capacity * 3, sizeof(float)) &&
+              grow_array((void**)&w->axis_y, capacity * 3, sizeof(float)) &&
+              grow_array((void**)&w->axis_min, capacity * 3, sizeof(float)) &&
+              grow_array((void**)&w->axis_max, capacity * 3, sizeof(float)) &&
+              grow_array((void**)&w->layer, capacity, sizeof(uint8_t)) &&
+              grow_array((void**)&w->mask, capacity, sizeof(uint8_t));
+    if (ok) w->capacity = capacity;
+    return ok;
+}
+
+static bool push_contact(CollisionContactList* list, const CollisionContact* contact) {
+    if (list->count == list->capacity) {
+        uint32_t capacity = list->capacity ? list->capacity * 2 : 64;
+        if (!grow_array((void**)&list->contacts, capacity, sizeof(CollisionContact))) {
+            list->overflow = true;
+            return false;
+        }
+        list->capacity = capacity;
+    }
+    list->contacts[list->count++] = *contact;
+    return true;
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+bool collision_world_init(CollisionWorld* world, uint32_t event_capacity) {
+    if (!world) return false;
+    memset(world, 0, sizeof(CollisionWorld));
+
+    spatial_grid_init(&world->grid);
+    world->restitution = COLLISION_DEFAULT_RESTITUTION;
+    world->correction = COLLISION_DEFAULT_CORRECTION;
+    world->slop = COLLISION_DEFAULT_SLOP;
+
+    if (event_capacity == 0) event_capacity = COLLISION_DEFAULT_EVENT_CAPACITY;
+    if (!event_ring_init(&world->events, sizeof(CollisionContact), event_capacity)) {
+        printf("Collision: Failed to allocate event ring\n");
+        return false;
+    }
+    return true;
+}
+
+void collision_world_shutdown(CollisionWorld* world) {
+    if (!world) return;
+
+    spatial_grid_shutdown(&world->grid);
+    free(world->body);
+    free(world->x);
+    free(world->y);
+    free(world->radius);
+    free(world->heading_sin);
+    free(world->heading_cos);
+    free(world->hull_x);
+    free(world->hull_y);
+    free(world->axis_x);
+    free(world->axis_y);
+    free(world->axis_min);
+    free(world->axis_max);
+    free(world->layer);
+    free(world->mask);
+    free(world->contacts);
+    for (uint32_t i = 0; i < COLLISION_MAX_JOBS; i++) {
+        free(world->lists[i].contacts);
+    }
+    event_ring_shutdown(&world->events);
+    memset(world, 0, sizeof(CollisionWorld));
+}
+
+// =============================================================================
+// ECS Columns
+// =============================================================================
+
+CollisionBodies collision_bodies_from_ecs(ECSWorld* ecs_world) {
+    CollisionBodies b;
+    b.pos_x = ecs_world->transforms.pos_x;
+    b.pos_y = ecs_world->transforms.pos_y;
+    b.rotation = ecs_world->transforms.rotation;
+    b.vel_x = ecs_world->velocities.vel_x;
+    b.vel_y = ecs_world->velocities.vel_y;
+    b.speed = ecs_world->velocities.speed;
+    b.hull_bow = ecs_world->colliders.hull_bow;
+    b.hull_stern = ecs_world->colliders.hull_stern;
+    b.hull_half_beam = ecs_world->colliders.hull_half_beam;
+    b.inv_mass = ecs_world->colliders.inv_mass;
+    b.layer = ecs_world->colliders.collision_layer;
+    b.mask = ecs_world->colliders.collision_mask;
+    b.masks = ecs_world->entity_masks;
+    b.required = COMPONENT_TRANSFORM | COMPONENT_VELOCITY | COMPONENT_COLLIDER;
+    b.count = MAX_ENTITIES;
+    return b;
+}
+
+void collision_set_hull(ECSWorld* ecs_world, Entity e, float bow, float stern, float half_beam,
+                        float inv_mass, uint8_t layer, uint8_t mask) {
+    if (!ecs_world || e == INVALID_ENTITY || e >= MAX_ENTITIES) return;
+    ColliderComponents* c = &ecs_world->colliders;
+
+    c->hull_bow[e] = bow;
+    c->hull_stern[e] = stern;
+    c->hull_half_beam[e] = half_beam;
+    c->radius[e] = math_max(bow, sqrtf(stern * stern + half_beam * half_beam));
+    c->width[e] = half_beam * 2.0f;
+    c->height[e] = bow + stern;
+    c->inv_mass[e] = inv_mass;
+    c->collision_layer[e] = layer;
+    c->collision_mask[e] = mask;
+    ecs_add_component(ecs_world, e, COMPONENT_COLLIDER);
+}
+
+// =============================================================================
+// Broadphase Setup
+// =============================================================================
+
+static inline void project(const float* hx, const float* hy, float ax, float ay,
+                           float* out_min, float* out_max) {
+    float p0 = hx[0] * ax + hy[0] * ay;
+    float p1 = hx[1] * ax + hy[1] * ay;
+    float p2 = hx[2] * ax + hy[2] * ay;
+    *out_min = math_min(p0, math_min(p1, p2));
+    *out_max = math_max(p0, math_max(p1, p2));
+}
+
+// Bounding circle of a hull: centred midway between apex and base
+static inline void hull_circle(float bow, float stern, float half_beam,
+                               float* out_offset, float* out_radius) {
+    float half_length = (bow + stern) * 0.5f;
+    *out_offset = (bow - stern) * 0.5f;
+    *out_radius = sqrtf(half_length * half_length + half_beam * half_beam);
+}
+
+// Gather active bodies, bin them into the grid and copy them out in cell
+// order with their world-space hulls
+static bool prepare_bodies(CollisionWorld* w, const CollisionBodies* b) {
+    w->active_count = 0;
+    w->max_radius = 0.0f;
+
+    uint32_t active = 0;
+    for (uint32_t i = 0; i < b->count; i++) {
+        if (body_active(b, i)) active++;
+    }
+    if (!ensure_body_capacity(w, active)) return false;
+
+    // Headings first (one batch sincos), then circle centres for the grid;
+    // body/x/y/radius hold the unsorted gather until the grid is built
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < b->count; i++) {
+        if (!body_active(b, i)) continue;
+        w->body[n] = i;
+        w->hull_y[n] = b->rotation[i];
+        n++;
+    }
+    if (n == 0) return true;
+    simd_sincos_deg_batch(w->hull_y, w->heading_sin, w->heading_cos, n);
+
+    for (uint32_t k = 0; k < n; k++) {
+        uint32_t i = w->body[k];
+        float offset, radius;
+        hull_circle(b->hull_bow[i], b->hull_stern[i], b->hull_half_beam[i], &offset, &radius);
+        // Forward is (sin r, -cos r)
+        w->x[k] = b->pos_x[i] + w->heading_sin[k] * offset;
+        w->y[k] = b->pos_y[i] - w->heading_cos[k] * offset;
+        w->radius[k] = radius;
+        if (radius > w->max_radius) w->max_radius = radius;
+    }
+
+    if (!spatial_grid_build(&w->grid, w->x, w->y, n, math_max(w->max_radius * 2.0f, 1.0f))) {
+        return false;
+    }
+
+    // Cell order: slot s takes the body the grid put s-th. The gathered
+    // columns move to hull_x/hull_y/axis_x/axis_y (3 floats per body) first.
+    uint32_t* gathered = (uint32_t*)w->axis_x;
+    float* gathered_x = w->hull_x;
+    float* gathered_y = w->hull_x + n;
+    float* gathered_r = w->hull_x + 2 * n;
+    float* gathered_sin = w->hull_y;
+    float* gathered_cos = w->hull_y + n;
+    memcpy(gathered, w->body, n * sizeof(uint32_t));
+    memcpy(gathered_x, w->x, n * sizeof(float));
+    memcpy(gathered_y, w->y, n * sizeof(float));
+    memcpy(gathered_r, w->radius, n * sizeof(float));
+    memcpy(gathered_sin, w->heading_sin, n * sizeof(float));
+    memcpy(gathered_cos, w->heading_cos, n * sizeof(float));
+    for (uint32_t s = 0; s < n; s++) {
+        uint32_t k = w->grid.items[s];
+        w->body[s] = gathered[k];
+        w->x[s] = gathered_x[k];
+        w->y[s] = gathered_y[k];
+        w->radius[s] = gathered_r[k];
+        w->heading_sin[s] = gathered_sin[k];
+        w->heading_cos[s] = gathered_cos[k];
+    }
+
+    for (uint32_t s = 0; s < n; s++) {
+        uint32_t i = w->body[s];
+        float px = b->pos_x[i];
+        float py = b->pos_y[i];
+        float fx = w->heading_sin[s], fy = -w->heading_cos[s];  // forward
+        float sx = -fy, sy = fx;                                 // starboard
+        float bow = b->hull_bow[i];
+        float stern = b->hull_stern[i];
+        float beam = b->hull_half_beam[i];
+
+        w->layer[s] = b->layer ? b->layer[i] : 0xFF;
+        w->mask[s] = b->mask ? b->mask[i] : 0xFF;
+
+        // Apex, port and starboard stern corners
+        float* hx = &w->hull_x[s * 3];
+        float* hy = &w->hull_y[s * 3];
+        hx[0] = px + fx * bow;
+        hy[0] = py + fy * bow;
+        hx[1] = px - fx * stern - sx * beam;
+        hy[1] = py - fy * stern - sy * beam;
+        hx[2] = px - fx * stern + sx * beam;
+        hy[2] = py - fy * stern + sy * beam;
+
+        // Unit edge normals, rotated from the hull's own frame: the two
+        // sides lean by beam : length, the base faces astern
+        float length = bow + stern;
+        float side = sqrtf(length * length + beam * beam);
+        float inv = side > 0.0f ? 1.0f / side : 0.0f;
+        float a = beam * inv, c = length * inv;
+        float* ax = &w->axis_x[s * 3];
+        float* ay = &w->axis_y[s * 3];
+        ax[0] = fx * a - sx * c;
+        ay[0] = fy * a - sy * c;
+        ax[1] = -fx;
+        ay[1] = -fy;
+        ax[2] = fx * a + sx * c;
+        ay[2] = fy * a + sy * c;
+
+        for (int k = 0; k < 3; k++) {
+            project(hx, hy, ax[k], ay[k], &w->axis_min[s * 3 + k], &w->axis_max[s * 3 + k]);
+        }
+    }
+
+    w->active_count = n;
+    return true;
+}
+
+// =============================================================================
+// Narrowphase
+// =============================================================================
+
+// Separating axis test between the hulls in slots i and j. On overlap fills
+// the normal (from i to j), depth and contact point.
+static bool hulls_touch(const CollisionWorld* w, uint32_t i, uint32_t j, CollisionContact* out) {
+    const float* hx_i = &w->hull_x[i * 3];
+    const float* hy_i = &w->hull_y[i * 3];
+    const float* hx_j = &w->hull_x[j * 3];
+    const float* hy_j = &w->hull_y[j * 3];
+
+    // Each hull's extent along its own normals was found in prepare_bodies,
+    // so only the other hull is projected. All six axes are measured before
+    // deciding: touching and near-miss pairs are about equally common, and a
+    // straight run is cheaper than the mispredicted early outs.
+    float overlap[6];
+    for (int k = 0; k < 3; k++) {
+        uint32_t axis = i * 3 + (uint32_t)k;
+        float other_min, other_max;
+        project(hx_j, hy_j, w->axis_x[axis], w->axis_y[axis], &other_min, &other_max);
+        overlap[k] = math_min(w->axis_max[axis], other_max) - math_max(w->axis_min[axis], other_min);
+    }
+    for (int k = 0; k < 3; k++) {
+        uint32_t axis = j * 3 + (uint32_t)k;
+        float other_min, other_max;
+        project(hx_i, hy_i, w->axis_x[axis], w->axis_y[axis], &other_min, &other_max);
+        overlap[3 + k] = math_min(w->axis_max[axis], other_max) - math_max(w->axis_min[axis], other_min);
+    }
+
+    int least = 0;
+    for (int k = 1; k < 6; k++) {
+        if (overlap[k] < overlap[least]) least = k;
+    }
+    float best = overlap[least];
+    if (best <= 0.0f) return false;
+    uint32_t least_axis = (least < 3 ? i : j) * 3 + (uint32_t)(least % 3);
+    float nx = w->axis_x[least_axis];
+    float ny = w->axis_y[least_axis];
+
+    // Point the normal from i's hull towards j's
+    float cx = (hx_j[0] + hx_j[1] + hx_j[2] - hx_i[0] - hx_i[1] - hx_i[2]) * (1.0f / 3.0f);
+    float cy = (hy_j[0] + hy_j[1] + hy_j[2] - hy_i[0] - hy_i[1] - hy_i[2]) * (1.0f / 3.0f);
+    if (nx * cx + ny * cy < 0.0f) {
+        nx = -nx;
+        ny = -ny;
+    }
+
+    // j's deepest corner, moved halfway out
+    int deepest = 0;
+    float deepest_proj = hx_j[0] * nx + hy_j[0] * ny;
+    for (int k = 1; k < 3; k++) {
+        float p = hx_j[k] * nx + hy_j[k] * ny;
+        if (p < deepest_proj) {
+            deepest_proj = p;
+            deepest = k;
+        }
+    }
+
+    out->normal_x = nx;
+    out->normal_y = ny;
+    out->depth = best;
+    out->point_x = hx_j[deepest] + nx * best * 0.5f;
+    out->point_y = hy_j[deepest] + ny * best * 0.5f;
+    out->impulse = 0.0f;
+    return true;
+}
+
+// =============================================================================
+// Detection
+// =============================================================================
+
+typedef struct DetectJob {
+    CollisionWorld* world;
+    uint32_t bodies_per_job;
+} DetectJob;
+
+// Test slots [begin, end) against every later slot they can reach
+static void detect_range(CollisionWorld* w, uint32_t begin, uint32_t end, CollisionContactList* list) {
+    const SpatialGrid* grid = &w->grid;
+
+    for (uint32_t i = begin; i < end; i++) {
+        float xi = w->x[i];
+        float yi = w->y[i];
+        float reach = w->radius[i] + w->max_radius;
+
+        SpatialGridSpan span;
+        if (!spatial_grid_get_span(grid, xi - reach, yi - reach, xi + reach, yi + reach, &span)) continue;
+
+        // Items are in cell order, so each row of the span is one run of slots
+        for (int32_t cy = span.min_cy; cy <= span.max_cy; cy++) {
+            uint32_t row = (uint32_t)(cy * grid->cols);
+            uint32_t start = grid->cell_start[row + (uint32_t)span.min_cx];
+            uint32_t stop = grid->cell_start[row + (uint32_t)span.max_cx + 1];
+            if (stop <= i + 1) continue;
+            if (start <= i) start = i + 1;
+            list->pairs_tested += stop - start;
+
+            for (uint32_t j = start; j < stop; j++) {
+                if (!(w->layer[i] & w->mask[j]) || !(w->layer[j] & w->mask[i])) continue;
+
+                float dx = w->x[j] - xi;
+                float dy = w->y[j] - yi;
+                float rr = w->radius[i] + w->radius[j];
+                if (dx * dx + dy * dy >= rr * rr) continue;
+
+                CollisionContact contact;
+                if (!hulls_touch(w, i, j, &contact)) continue;
+
+                // Report pairs by body index, lower first
+                contact.a = w->body[i];
+                contact.b = w->body[j];
+                if (contact.a > contact.b) {
+                    contact.a = w->body[j];
+                    contact.b = w->body[i];
+                    contact.normal_x = -contact.normal_x;
+                    contact.normal_y = -contact.normal_y;
+                }
+                push_contact(list, &contact);
+            }
+        }
+    }
+}
+
+static void detect_job(void* data, uint32_t index) {
+    DetectJob* job = (DetectJob*)data;
+    CollisionWorld* w = job->world;
+
+    uint32_t begin = index * job->bodies_per_job;
+    uint32_t end = begin + job->bodies_per_job;
+    if (end > w->active_count) end = w->active_count;
+
+    CollisionContactList* list = &w->lists[index];
+    list->count = 0;
+    list->pairs_tested = 0;
+    list->overflow = false;
+    if (begin < end) detect_range(w, begin, end, list);
+}
+
+uint32_t collision_detect(CollisionWorld* world, const CollisionBodies* bodies, JobSystem* jobs) {
+    if (!world || !bodies) return 0;
+    world->contact_count = 0;
+    world->pairs_tested = 0;
+
+    if (!prepare_bodies(world, bodies)) {
+        printf("Collision: Failed to allocate body arrays\n");
+        return 0;
+    }
+    if (world->active_count < 2) return 0;
+
+    // A few ranges per thread so uneven crowding still balances
+    uint32_t threads = jobs_thread_count(jobs);
+    uint32_t job_count = threads > 1 ? threads * 4 : 1;
+    uint32_t max_jobs = (world->active_count + COLLISION_MIN_BODIES_PER_JOB - 1) / COLLISION_MIN_BODIES_PER_JOB;
+    if (job_count > max_jobs) job_count = max_jobs;
+    if (job_count > COLLISION_MAX_JOBS) job_count = COLLISION_MAX_JOBS;
+    if (job_count == 0) job_count = 1;
+
+    DetectJob job;
+    job.world = world;
+    job.bodies_per_job = (world->active_count + job_count - 1) / job_count;
+    if (job_count == 1) {
+        detect_job(&job, 0);
+    } else {
+        jobs_parallel_for(jobs, job_count, detect_job, &job);
+    }
+
+    // Join the lists in range order
+    uint32_t total = 0;
+    for (uint32_t k = 0; k < job_count; k++) {
+        total += world->lists[k].count;
+        world->pairs_tested += world->lists[k].pairs_tested;
+        if (world->lists[k].overflow) printf("Collision: Contact list overflow, contacts lost\n");
+    }
+    if (total > world->contact_capacity) {
+        uint32_t capacity = world->contact_capacity ? world->contact_capacity : 64;
+        while (capacity < total) capacity *= 2;
+        if (!grow_array((void**)&world->contacts, capacity, sizeof(CollisionContact))) {
+            printf("Collision: Failed to allocate %u contacts\n", total);
+            return 0;
+        }
+        world->contact_capacity = capacity;
+    }
+    for (uint32_t k = 0; k < job_count; k++) {
+        const CollisionContactList* list = &world->lists[k];
+        if (list->count == 0) continue;
+        memcpy(world->contacts + world->contact_count, list->contacts, list->count * sizeof(CollisionContact));
+        world->contact_count += list->count;
+    }
+    return world->contact_count;
+}
+
+// =============================================================================
+// Response
+// =============================================================================
+
+void collision_resolve(CollisionWorld* world, const CollisionBodies* bodies) {
+    if (!world || !bodies) return;
+
+    for (uint32_t c = 0; c < world->contact_count; c++) {
+        CollisionContact* contact = &world->contacts[c];
+        uint32_t a = contact->a;
+        uint32_t b = contact->b;
+        float inv_a = bodies->inv_mass ? bodies->inv_mass[a] : 1.0f;
+        float inv_b = bodies->inv_mass ? bodies->inv_mass[b] : 1.0f;
+        float inv_sum = inv_a + inv_b;
+        if (inv_sum <= 0.0f) {
+            event_ring_push(&world->events, contact);
+            continue;
+        }
+        float nx = contact->normal_x;
+        float ny = contact->normal_y;
+
+        // Push the hulls apart (most of the way, leaving the slop)
+        float push = math_max(contact->depth - world->slop, 0.0f) * world->correction / inv_sum;
+        bodies->pos_x[a] -= nx * push * inv_a;
+        bodies->pos_y[a] -= ny * push * inv_a;
+        bodies->pos_x[b] += nx * push * inv_b;
+        bodies->pos_y[b] += ny * push * inv_b;
+
+        // Bounce if closing
+        float closing = (bodies->vel_x[b] - bodies->vel_x[a]) * nx +
+                        (bodies->vel_y[b] - bodies->vel_y[a]) * ny;
+        if (closing < 0.0f) {
+            float impulse = -(1.0f + world->restitution) * closing / inv_sum;
+            bodies->vel_x[a] -= nx * impulse * inv_a;
+            bodies->vel_y[a] -= ny * impulse * inv_a;
+            bodies->vel_x[b] += nx * impulse * inv_b;
+            bodies->vel_y[b] += ny * impulse * inv_b;
+            contact->impulse = impulse;
+
+            // Keep the speed along the heading in step with the velocity
+            if (bodies->speed) {
+                float ra = math_deg_to_rad(bodies->rotation[a]);
+                float rb = math_deg_to_rad(bodies->rotation[b]);
+                bodies->speed[a] = bodies->vel_x[a] * sinf(ra) - bodies->vel_y[a] * cosf(ra);
+                bodies->speed[b] = bodies->vel_x[b] * sinf(rb) - bodies->vel_y[b] * cosf(rb);
+            }
+        }
+
+        event_ring_push(&world->events, contact);
+    }
+}
+
+uint32_t collision_system_update(CollisionWorld* world, ECSWorld* ecs_world, JobSystem* jobs) {
+    if (!world || !ecs_world) return 0;
+
+    CollisionBodies bodies = collision_bodies_from_ecs(ecs_world);
+    uint32_t contacts = collision_detect(world, &bodies, jobs);
+    collision_resolve(world, &bodies);
+    return contacts;
+}
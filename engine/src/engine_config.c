@@ -405,6 +405,13 @@ AudioConfig config_get_default_audio(void) {
     return ac;
 }
 
+SimulationConfig config_get_default_simulation(void) {
+    SimulationConfig sc;
+    sc.tick_rate = 60;
+    sc.max_steps_per_frame = 5;
+    return sc;
+}
+
 WindowConfig config_get_window(const ConfigFile* config) {
     WindowConfig wc = config_get_default_window();
     
@@ -438,3 +445,19 @@ AudioConfig config_get_audio(const ConfigFile* config) {
     
     return ac;
 }
+
+SimulationConfig config_get_simulation(const ConfigFile* config) {
+    SimulationConfig sc = config_get_default_simulation();
+    
+    if (!config || !config->loaded) return sc;
+    
+    sc.tick_rate = config_get_int(config, "Simulation", "tick_rate", sc.tick_rate);
+    sc.max_steps_per_frame = config_get_int(config, "Simulation", "max_steps_per_frame", sc.max_steps_per_frame);
+    
+    // Keep the step between 1 ms and 1 s
+    if (sc.tick_rate < 1) sc.tick_rate = 1;
+    if (sc.tick_rate > 1000) sc.tick_rate = 1000;
+    if (sc.max_steps_per_frame < 1) sc.max_steps_per_frame = 1;
+    
+    return sc;
+}
@@ -2,6 +2,7 @@
 #include <raylib.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 
 // Global engine state
 static EngineState g_engine_state = {0};
@@ -20,6 +21,9 @@ bool engine_init(const EngineConfig* config) {
     g_engine_config = *config;
 
     // Initialize raylib window
+    if (config->vsync) {
+        SetConfigFlags(FLAG_VSYNC_HINT);
+    }
     InitWindow(config->window_width, config->window_height, config->window_title);
     SetTargetFPS(config->target_fps);
 
@@ -33,15 +37,24 @@ bool engine_init(const EngineConfig* config) {
     g_engine_state.timing.total_time = 0.0;
     g_engine_state.timing.fixed_delta_time = 1.0 / 60.0; // Default 60Hz fixed update
     g_engine_state.timing.fixed_accumulator = 0.0;
+    g_engine_state.timing.max_fixed_steps = ENGINE_DEFAULT_MAX_FIXED_STEPS;
+    g_engine_state.timing.fixed_steps = 0;
+    g_engine_state.timing.fixed_step_count = 0;
+    g_engine_state.timing.dropped_time = 0.0;
+    g_engine_state.timing.time_scale = 1.0;
+    g_engine_state.timing.step_budget = 0.0;
+    g_engine_state.timing.frame_start = GetTime();
+    g_engine_state.timing.last_step_size = 1;
     g_engine_state.timing.frame_count = 0;
     g_engine_state.timing.fps = (float)config->target_fps;
     g_engine_state.timing.fps_smoothed = (float)config->target_fps;
 
-    printf("Engine initialized: %s [%dx%d @ %d FPS]\n",
+    printf("Engine initialized: %s [%dx%d @ %d FPS%s]\n",
            config->window_title,
            config->window_width,
            config->window_height,
-           config->target_fps);
+           config->target_fps,
+           config->vsync ? ", vsync" : "");
 
     return true;
 }
@@ -72,7 +85,8 @@ void engine_begin_frame(void) {
         (1.0f - FPS_SMOOTH_FACTOR) * g_engine_state.timing.fps;
     
     // Accumulate time for fixed timestep
-    g_engine_state.timing.fixed_accumulator += dt;
+    g_engine_state.timing.frame_start = GetTime();
+    engine_timing_accumulate(&g_engine_state.timing, dt);
     
     // Track window size changes
     g_engine_state.window_width = GetScreenWidth();
@@ -107,6 +121,14 @@ uint64_t engine_get_frame_count(void) {
     return g_engine_state.timing.frame_count;
 }
 
+void engine_set_target_fps(int fps) {
+    SetTargetFPS(fps > 0 ? fps : 0);
+}
+
+void engine_reset_target_fps(void) {
+    SetTargetFPS(g_engine_config.target_fps);
+}
+
 // Fixed timestep support
 void engine_set_fixed_timestep(double fixed_dt) {
     if (fixed_dt > 0.0) {
@@ -114,18 +136,88 @@ void engine_set_fixed_timestep(double fixed_dt) {
     }
 }
 
+void engine_set_max_fixed_steps(uint32_t max_steps) {
+    g_engine_state.timing.max_fixed_steps = max_steps > 0 ? max_steps : ENGINE_DEFAULT_MAX_FIXED_STEPS;
+}
+
 bool engine_should_update_fixed(void) {
-    if (g_engine_state.timing.fixed_accumulator >= g_engine_state.timing.fixed_delta_time) {
-        g_engine_state.timing.fixed_accumulator -= g_engine_state.timing.fixed_delta_time;
-        return true;
-    }
-    return false;
+    return engine_should_update_fixed_steps(1);
+}
+
+bool engine_should_update_fixed_steps(uint32_t steps) {
+    double elapsed = GetTime() - g_engine_state.timing.frame_start;
+    return engine_timing_take_steps(&g_engine_state.timing, steps, elapsed);
 }
 
 double engine_get_fixed_delta_time(void) {
     return g_engine_state.timing.fixed_delta_time;
 }
 
+double engine_get_fixed_alpha(void) {
+    return engine_timing_alpha(&g_engine_state.timing);
+}
+
+void engine_set_time_scale(double scale) {
+    g_engine_state.timing.time_scale = scale > 0.0 ? scale : 1.0;
+}
+
+double engine_get_time_scale(void) {
+    return g_engine_state.timing.time_scale;
+}
+
+void engine_set_fixed_step_budget(double seconds) {
+    g_engine_state.timing.step_budget = seconds > 0.0 ? seconds : 0.0;
+}
+
+void engine_timing_accumulate(TimingState* timing, double frame_dt) {
+    if (!timing) return;
+    
+    if (frame_dt > 0.0) {
+        double scale = timing->time_scale > 0.0 ? timing->time_scale : 1.0;
+        timing->fixed_accumulator += frame_dt * scale;
+    }
+    timing->fixed_steps = 0;
+}
+
+bool engine_timing_step_fixed(TimingState* timing) {
+    return engine_timing_take_steps(timing, 1, 0.0);
+}
+
+bool engine_timing_take_steps(TimingState* timing, uint32_t steps, double elapsed) {
+    if (!timing || timing->fixed_delta_time <= 0.0) return false;
+    if (steps == 0) steps = 1;
+    double step_time = timing->fixed_delta_time * steps;
+    if (timing->fixed_accumulator < step_time) return false;
+    
+    // Spiral-of-death guard: past the cap (scaled with time warp) or the
+    // frame's step budget, drop whole steps and keep the fraction
+    double scale = timing->time_scale > 1.0 ? ceil(timing->time_scale) : 1.0;
+    bool capped = timing->max_fixed_steps > 0 &&
+                  timing->fixed_steps + steps > (uint32_t)(timing->max_fixed_steps * scale);
+    bool over_budget = timing->step_budget > 0.0 && timing->fixed_steps > 0 &&
+                       elapsed >= timing->step_budget;
+    if (capped || over_budget) {
+        double kept = fmod(timing->fixed_accumulator, step_time);
+        timing->dropped_time += timing->fixed_accumulator - kept;
+        timing->fixed_accumulator = kept;
+        return false;
+    }
+    
+    timing->fixed_accumulator -= step_time;
+    timing->fixed_steps += steps;
+    timing->fixed_step_count += steps;
+    timing->last_step_size = steps;
+    return true;
+}
+
+double engine_timing_alpha(const TimingState* timing) {
+    if (!timing || timing->fixed_delta_time <= 0.0) return 1.0;
+    
+    uint32_t steps = timing->last_step_size > 0 ? timing->last_step_size : 1;
+    double alpha = timing->fixed_accumulator / (timing->fixed_delta_time * steps);
+    return alpha < 0.0 ? 0.0 : (alpha > 1.0 ? 1.0 : alpha);
+}
+
 // Window functions
 int engine_get_window_width(void) {
     return g_engine_state.window_width;
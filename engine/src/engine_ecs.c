@@ -1,6 +1,7 @@
 #include "engine_ecs.h"
 #include "engine_math.h"
 #include <string.h>
+#include <math.h>
 #include <stdio.h>
 
 // =============================================================================
@@ -179,6 +180,110 @@ void ecs_system_movement(ECSWorld* world, float delta_time) {
     }
 }
 
+// =============================================================================
+// Render Interpolation
+// =============================================================================
+
+void ecs_store_previous_transforms(ECSWorld* world) {
+    if (!world) return;
+    
+    memcpy(world->previous.pos_x, world->transforms.pos_x, sizeof(world->previous.pos_x));
+    memcpy(world->previous.pos_y, world->transforms.pos_y, sizeof(world->previous.pos_y));
+    memcpy(world->previous.rotation, world->transforms.rotation, sizeof(world->previous.rotation));
+}
+
+void ecs_snap_previous_transform(ECSWorld* world, Entity entity) {
+    if (!world || entity == INVALID_ENTITY || entity >= MAX_ENTITIES) return;
+    
+    world->previous.pos_x[entity] = world->transforms.pos_x[entity];
+    world->previous.pos_y[entity] = world->transforms.pos_y[entity];
+    world->previous.rotation[entity] = world->transforms.rotation[entity];
+}
+
+void ecs_get_interpolated_transform(const ECSWorld* world, Entity entity, float alpha,
+                                    float* x, float* y, float* rotation) {
+    if (!world || entity == INVALID_ENTITY || entity >= MAX_ENTITIES) return;
+    
+    alpha = math_clamp(alpha, 0.0f, 1.0f);
+    const TransformComponents* current = &world->transforms;
+    const PreviousTransforms* previous = &world->previous;
+    
+    if (x) *x = math_lerp(previous->pos_x[entity], current->pos_x[entity], alpha);
+    if (y) *y = math_lerp(previous->pos_y[entity], current->pos_y[entity], alpha);
+    if (rotation) {
+        float from = previous->rotation[entity];
+        *rotation = math_wrap_angle_360(from + math_angle_diff(from, current->rotation[entity]) * alpha);
+    }
+}
+
+// =============================================================================
+// Render List
+// =============================================================================
+
+void ecs_build_render_list(const ECSWorld* world, float alpha,
+                           float min_x, float min_y, float max_x, float max_y,
+                           float margin, EcsRenderList* out_list) {
+    if (!out_list) return;
+    
+    memset(out_list->layer_start, 0, sizeof(out_list->layer_start));
+    out_list->count = 0;
+    out_list->culled = 0;
+    if (!world) return;
+    
+    const ComponentMask required = COMPONENT_RENDERABLE | COMPONENT_TRANSFORM;
+    const TransformComponents* current = &world->transforms;
+    const PreviousTransforms* previous = &world->previous;
+    const RenderableComponents* renderables = &world->renderables;
+    alpha = math_clamp(alpha, 0.0f, 1.0f);
+    
+    // Gather and cull, counting entities per layer
+    Entity kept[MAX_ENTITIES];
+    float kept_x[MAX_ENTITIES];
+    float kept_y[MAX_ENTITIES];
+    uint32_t kept_count = 0;
+    uint32_t* layer_count = out_list->layer_start + 1;
+    
+    for (Entity e = 1; e < MAX_ENTITIES; e++) {
+        if ((world->entity_masks[e] & required) != required) continue;
+        if (!renderables->visible[e]) continue;
+        
+        float x = math_lerp(previous->pos_x[e], current->pos_x[e], alpha);
+        float y = math_lerp(previous->pos_y[e], current->pos_y[e], alpha);
+        float reach = margin * fmaxf(fabsf(current->scale_x[e]), fabsf(current->scale_y[e]));
+        if (x < min_x - reach || x > max_x + reach || y < min_y - reach || y > max_y + reach) {
+            out_list->culled++;
+            continue;
+        }
+        
+        kept[kept_count] = e;
+        kept_x[kept_count] = x;
+        kept_y[kept_count] = y;
+        kept_count++;
+        layer_count[renderables->layer[e]]++;
+    }
+    
+    // Layer counts to start offsets
+    for (uint32_t l = 0; l < ECS_RENDER_LAYER_COUNT; l++) {
+        out_list->layer_start[l + 1] += out_list->layer_start[l];
+    }
+    
+    // Scatter in entity order (stable within a layer)
+    uint32_t cursor[ECS_RENDER_LAYER_COUNT];
+    memcpy(cursor, out_list->layer_start, sizeof(cursor));
+    
+    for (uint32_t i = 0; i < kept_count; i++) {
+        Entity e = kept[i];
+        uint32_t slot = cursor[renderables->layer[e]]++;
+        float from = previous->rotation[e];
+        
+        out_list->entity[slot] = e;
+        out_list->x[slot] = kept_x[i];
+        out_list->y[slot] = kept_y[i];
+        out_list->rotation[slot] = math_wrap_angle_360(from + math_angle_diff(from, current->rotation[e]) * alpha);
+    }
+    out_list->count = kept_count;
+}
+
 // Note: Ship physics and AI systems are now in game layer:
 // - ship_ecs_system_physics() in game/src/game_ship_ecs.c
 // - ai_ecs_system_update() in game/src/game_ai_ecs.c
@@ -0,0 +1,74 @@
+#include "engine_event_ring.h"
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+bool event_ring_init(EventRing* ring, uint32_t element_size, uint32_t capacity) {
+    if (!ring) return false;
+    memset(ring, 0, sizeof(EventRing));
+    if (element_size == 0 || capacity == 0 || capacity > 0x80000000u) return false;
+
+    uint32_t rounded = 1;
+    while (rounded < capacity) rounded <<= 1;
+
+    ring->data = (uint8_t*)malloc((size_t)rounded * element_size);
+    if (!ring->data) return false;
+    ring->element_size = element_size;
+    ring->capacity = rounded;
+    ring->mask = rounded - 1;
+    return true;
+}
+
+void event_ring_shutdown(EventRing* ring) {
+    if (!ring) return;
+    free(ring->data);
+    memset(ring, 0, sizeof(EventRing));
+}
+
+// =============================================================================
+// Producer
+// =============================================================================
+
+void event_ring_push(EventRing* ring, const void* event) {
+    if (!ring || !ring->data || !event) return;
+
+    uint32_t slot = (uint32_t)(ring->write_seq & ring->mask);
+    memcpy(ring->data + (size_t)slot * ring->element_size, event, ring->element_size);
+    ring->write_seq++;
+}
+
+// =============================================================================
+// Readers
+// =============================================================================
+
+void event_ring_reader_init(const EventRing* ring, EventRingReader* reader) {
+    if (!reader) return;
+    reader->seq = ring ? ring->write_seq : 0;
+    reader->dropped = 0;
+}
+
+const void* event_ring_next(const EventRing* ring, EventRingReader* reader) {
+    if (!ring || !ring->data || !reader) return NULL;
+    if (reader->seq >= ring->write_seq) return NULL;
+
+    // Skip events that have already been overwritten
+    uint64_t oldest = ring->write_seq > ring->capacity ? ring->write_seq - ring->capacity : 0;
+    if (reader->seq < oldest) {
+        reader->dropped += oldest - reader->seq;
+        reader->seq = oldest;
+    }
+
+    uint32_t slot = (uint32_t)(reader->seq & ring->mask);
+    reader->seq++;
+    return ring->data + (size_t)slot * ring->element_size;
+}
+
+uint32_t event_ring_pending(const EventRing* ring, const EventRingReader* reader) {
+    if (!ring || !reader || reader->seq >= ring->write_seq) return 0;
+
+    uint64_t pending = ring->write_seq - reader->seq;
+    return pending > ring->capacity ? ring->capacity : (uint32_t)pending;
+}
@@ -0,0 +1,107 @@
+#include "engine_file_map.h"
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+// =============================================================================
+// Mapping
+// =============================================================================
+
+#ifdef _WIN32
+
+bool file_map_open(FileMap* map, const char* filepath) {
+    if (!map || !filepath) return false;
+    memset(map, 0, sizeof(FileMap));
+
+    HANDLE file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    // PAGE_WRITECOPY + FILE_MAP_COPY gives private copy-on-write pages
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    map->data = data;
+    map->size = (size_t)size.QuadPart;
+    map->file_handle = file;
+    map->mapping_handle = mapping;
+    return true;
+}
+
+void file_map_close(FileMap* map) {
+    if (!map) return;
+    if (map->data) UnmapViewOfFile(map->data);
+    if (map->mapping_handle) CloseHandle((HANDLE)map->mapping_handle);
+    if (map->file_handle) CloseHandle((HANDLE)map->file_handle);
+    memset(map, 0, sizeof(FileMap));
+}
+
+#else
+
+bool file_map_open(FileMap* map, const char* filepath) {
+    if (!map || !filepath) return false;
+    memset(map, 0, sizeof(FileMap));
+
+    int fd = open(filepath, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps its own reference
+    if (data == MAP_FAILED) return false;
+
+    map->data = data;
+    map->size = (size_t)st.st_size;
+    return true;
+}
+
+void file_map_close(FileMap* map) {
+    if (!map) return;
+    if (map->data) munmap(map->data, map->size);
+    memset(map, 0, sizeof(FileMap));
+}
+
+#endif
+
+// =============================================================================
+// File Info
+// =============================================================================
+
+bool file_get_modified_time(const char* filepath, int64_t* out_time) {
+    if (!filepath) return false;
+
+    struct stat st;
+    if (stat(filepath, &st) != 0) return false;
+    if (out_time) *out_time = (int64_t)st.st_mtime;
+    return true;
+}
@@ -0,0 +1,244 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "engine_jobs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+// =============================================================================
+// Platform Threads
+// =============================================================================
+
+#ifdef _WIN32
+
+typedef HANDLE job_thread_t;
+typedef CRITICAL_SECTION job_mutex_t;
+typedef CONDITION_VARIABLE job_cond_t;
+
+static void mutex_init(job_mutex_t* m)      { InitializeCriticalSection(m); }
+static void mutex_destroy(job_mutex_t* m)   { DeleteCriticalSection(m); }
+static void mutex_lock(job_mutex_t* m)      { EnterCriticalSection(m); }
+static void mutex_unlock(job_mutex_t* m)    { LeaveCriticalSection(m); }
+static void cond_init(job_cond_t* c)        { InitializeConditionVariable(c); }
+static void cond_destroy(job_cond_t* c)     { (void)c; }
+static void cond_wait(job_cond_t* c, job_mutex_t* m) { SleepConditionVariableCS(c, m, INFINITE); }
+static void cond_signal(job_cond_t* c)      { WakeConditionVariable(c); }
+static void cond_broadcast(job_cond_t* c)   { WakeAllConditionVariable(c); }
+
+#else
+
+typedef pthread_t job_thread_t;
+typedef pthread_mutex_t job_mutex_t;
+typedef pthread_cond_t job_cond_t;
+
+static void mutex_init(job_mutex_t* m)      { pthread_mutex_init(m, NULL); }
+static void mutex_destroy(job_mutex_t* m)   { pthread_mutex_destroy(m); }
+static void mutex_lock(job_mutex_t* m)      { pthread_mutex_lock(m); }
+static void mutex_unlock(job_mutex_t* m)    { pthread_mutex_unlock(m); }
+static void cond_init(job_cond_t* c)        { pthread_cond_init(c, NULL); }
+static void cond_destroy(job_cond_t* c)     { pthread_cond_destroy(c); }
+static void cond_wait(job_cond_t* c, job_mutex_t* m) { pthread_cond_wait(c, m); }
+static void cond_signal(job_cond_t* c)      { pthread_cond_signal(c); }
+static void cond_broadcast(job_cond_t* c)   { pthread_cond_broadcast(c); }
+
+#endif
+
+struct JobSystemImpl {
+    job_mutex_t lock;
+    job_cond_t work_ready;      // Workers wait here for a batch
+    job_cond_t work_done;       // Caller waits here for the batch to finish
+    job_thread_t threads[JOBS_MAX_WORKERS];
+    uint32_t thread_count;
+
+    // Current batch (func == NULL when idle)
+    JobFunc func;
+    void* data;
+    uint32_t count;
+    uint32_t next;              // Next index to hand out
+    uint32_t remaining;         // Indices not yet finished
+    bool quit;
+};
+
+// =============================================================================
+// Workers
+// =============================================================================
+
+// Take and run indices of the current batch until none are left.
+// Called with the lock held; returns with it held.
+static void run_batch_locked(JobSystemImpl* impl) {
+    while (impl->func && impl->next < impl->count) {
+        uint32_t index = impl->next++;
+        JobFunc func = impl->func;
+        void* data = impl->data;
+
+        mutex_unlock(&impl->lock);
+        func(data, index);
+        mutex_lock(&impl->lock);
+
+        if (--impl->remaining == 0) {
+            cond_signal(&impl->work_done);
+        }
+    }
+}
+
+static void worker_loop(JobSystemImpl* impl) {
+    mutex_lock(&impl->lock);
+    while (!impl->quit) {
+        if (impl->func && impl->next < impl->count) {
+            run_batch_locked(impl);
+        } else {
+            cond_wait(&impl->work_ready, &impl->lock);
+        }
+    }
+    mutex_unlock(&impl->lock);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI worker_main(LPVOID arg) {
+    worker_loop((JobSystemImpl*)arg);
+    return 0;
+}
+#else
+static void* worker_main(void* arg) {
+    worker_loop((JobSystemImpl*)arg);
+    return NULL;
+}
+#endif
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+bool jobs_init(JobSystem* jobs, uint32_t worker_count) {
+    if (!jobs) return false;
+    memset(jobs, 0, sizeof(JobSystem));
+
+    if (worker_count == 0) worker_count = jobs_hardware_threads() - 1;
+    if (worker_count > JOBS_MAX_WORKERS) worker_count = JOBS_MAX_WORKERS;
+    if (worker_count == 0) return true;  // Single core: run inline
+
+    JobSystemImpl* impl = (JobSystemImpl*)calloc(1, sizeof(JobSystemImpl));
+    if (!impl) return false;
+    mutex_init(&impl->lock);
+    cond_init(&impl->work_ready);
+    cond_init(&impl->work_done);
+
+    for (uint32_t i = 0; i < worker_count; i++) {
+#ifdef _WIN32
+        HANDLE thread = CreateThread(NULL, 0, worker_main, impl, 0, NULL);
+        if (!thread) break;
+        impl->threads[i] = thread;
+#else
+        if (pthread_create(&impl->threads[i], NULL, worker_main, impl) != 0) break;
+#endif
+        impl->thread_count++;
+    }
+
+    jobs->impl = impl;
+    jobs->worker_count = impl->thread_count;
+    if (impl->thread_count < worker_count) {
+        printf("Jobs: Started %u of %u worker threads\n", impl->thread_count, worker_count);
+        return false;
+    }
+    return true;
+}
+
+void jobs_shutdown(JobSystem* jobs) {
+    if (!jobs || !jobs->impl) return;
+    JobSystemImpl* impl = jobs->impl;
+
+    mutex_lock(&impl->lock);
+    impl->quit = true;
+    cond_broadcast(&impl->work_ready);
+    mutex_unlock(&impl->lock);
+
+    for (uint32_t i = 0; i < impl->thread_count; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(impl->threads[i], INFINITE);
+        CloseHandle(impl->threads[i]);
+#else
+        pthread_join(impl->threads[i], NULL);
+#endif
+    }
+
+    cond_destroy(&impl->work_done);
+    cond_destroy(&impl->work_ready);
+    mutex_destroy(&impl->lock);
+    free(impl);
+    memset(jobs, 0, sizeof(JobSystem));
+}
+
+// =============================================================================
+// Dispatch
+// =============================================================================
+
+void jobs_parallel_for(JobSystem* jobs, uint32_t count, JobFunc func, void* data) {
+    if (!func || count == 0) return;
+
+    if (!jobs || !jobs->impl || jobs->impl->thread_count == 0 || count == 1) {
+        for (uint32_t i = 0; i < count; i++) func(data, i);
+        return;
+    }
+
+    JobSystemImpl* impl = jobs->impl;
+    mutex_lock(&impl->lock);
+    impl->func = func;
+    impl->data = data;
+    impl->count = count;
+    impl->next = 0;
+    impl->remaining = count;
+    cond_broadcast(&impl->work_ready);
+
+    // The caller works too, then waits for stragglers
+    run_batch_locked(impl);
+    while (impl->remaining > 0) {
+        cond_wait(&impl->work_done, &impl->lock);
+    }
+    impl->func = NULL;
+    impl->data = NULL;
+    mutex_unlock(&impl->lock);
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+uint32_t jobs_thread_count(const JobSystem* jobs) {
+    return 1 + (jobs ? jobs->worker_count : 0);
+}
+
+uint32_t jobs_hardware_threads(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (uint32_t)info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (uint32_t)n : 1;
+#endif
+}
+
+double jobs_time_seconds(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
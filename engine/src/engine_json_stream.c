@@ -0,0 +1,438 @@
+#include "engine_json_stream.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define JSON_STREAM_MIN_SCRATCH 256
+
+// What the grammar accepts next
+enum {
+    EXPECT_VALUE = 0,           // Root, after ':' or after ',' in an array
+    EXPECT_VALUE_OR_END,        // After '['
+    EXPECT_KEY_OR_END,          // After '{'
+    EXPECT_KEY,                 // After ',' in an object
+    EXPECT_COLON,
+    EXPECT_COMMA_OR_END,
+    EXPECT_DONE                 // Root value complete; only whitespace allowed
+};
+
+// Token being scanned across bytes (and chunks)
+enum {
+    LEX_NONE = 0,
+    LEX_STRING,
+    LEX_ESCAPE,
+    LEX_UNICODE,
+    LEX_NUMBER,
+    LEX_LITERAL
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static JsonStreamResult fail(JsonStream* stream, JsonStreamResult result) {
+    stream->status = result;
+    return result;
+}
+
+// Append bytes to scratch, keeping room for a terminator
+static bool scratch_append(JsonStream* stream, const char* bytes, size_t count) {
+    if (count == 0) return true;
+    uint64_t needed = (uint64_t)stream->scratch_size + count + 1;
+    if (needed > stream->scratch_capacity) {
+        uint64_t capacity = stream->scratch_capacity;
+        while (capacity < needed) capacity *= 2;
+        if (capacity > 0xFFFFFFFFu) return false;
+        char* scratch = (char*)realloc(stream->scratch, (size_t)capacity);
+        if (!scratch) return false;
+        stream->scratch = scratch;
+        stream->scratch_capacity = (uint32_t)capacity;
+    }
+    memcpy(stream->scratch + stream->scratch_size, bytes, count);
+    stream->scratch_size += (uint32_t)count;
+    return true;
+}
+
+static bool append_utf8(JsonStream* stream, uint32_t cp) {
+    char out[4];
+    size_t n;
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        n = 1;
+    } else if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        n = 2;
+    } else if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        n = 3;
+    } else {
+        out[0] = (char)(0xF0 | (cp >> 18));
+        out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = (char)(0x80 | (cp & 0x3F));
+        n = 4;
+    }
+    return scratch_append(stream, out, n);
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static inline bool is_number_char(char c) {
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+static bool emit(JsonStream* stream, JsonTokenType type, const char* str, uint32_t len, double number) {
+    JsonToken token;
+    token.type = type;
+    token.depth = stream->depth;
+    token.str = str;
+    token.len = len;
+    token.number = number;
+    if (stream->callback && !stream->callback(&token, stream->user_data)) {
+        stream->status = JSON_STREAM_ABORTED;
+        return false;
+    }
+    return true;
+}
+
+// A value just completed at the current depth
+static void value_done(JsonStream* stream) {
+    stream->expect = stream->depth == 0 ? EXPECT_DONE : EXPECT_COMMA_OR_END;
+}
+
+static bool finish_string(JsonStream* stream) {
+    stream->scratch[stream->scratch_size] = '\0';
+    if (stream->string_is_key) {
+        if (!emit(stream, JSON_TOKEN_KEY, stream->scratch, stream->scratch_size, 0.0)) return false;
+        stream->expect = EXPECT_COLON;
+    } else {
+        if (!emit(stream, JSON_TOKEN_STRING, stream->scratch, stream->scratch_size, 0.0)) return false;
+        value_done(stream);
+    }
+    return true;
+}
+
+static bool finish_number(JsonStream* stream) {
+    stream->scratch[stream->scratch_size] = '\0';
+    char* end = NULL;
+    double value = strtod(stream->scratch, &end);
+    if (end != stream->scratch + stream->scratch_size) {
+        stream->status = JSON_STREAM_SYNTAX_ERROR;
+        return false;
+    }
+    if (!emit(stream, JSON_TOKEN_NUMBER, NULL, 0, value)) return false;
+    value_done(stream);
+    return true;
+}
+
+static bool finish_codepoint(JsonStream* stream) {
+    uint32_t cp = stream->unicode_value;
+    if (stream->high_surrogate) {
+        if (cp < 0xDC00 || cp > 0xDFFF) {
+            stream->status = JSON_STREAM_SYNTAX_ERROR;
+            return false;
+        }
+        cp = 0x10000 + ((stream->high_surrogate - 0xD800) << 10) + (cp - 0xDC00);
+        stream->high_surrogate = 0;
+    } else if (cp >= 0xD800 && cp <= 0xDBFF) {
+        stream->high_surrogate = cp;  // The low half must be the next escape
+        return true;
+    } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+        stream->status = JSON_STREAM_SYNTAX_ERROR;
+        return false;
+    }
+    if (!append_utf8(stream, cp)) {
+        stream->status = JSON_STREAM_OUT_OF_MEMORY;
+        return false;
+    }
+    return true;
+}
+
+static bool push_container(JsonStream* stream, bool is_object) {
+    if (stream->depth >= JSON_STREAM_MAX_DEPTH) {
+        stream->status = JSON_STREAM_TOO_DEEP;
+        return false;
+    }
+    if (!emit(stream, is_object ? JSON_TOKEN_OBJECT_BEGIN : JSON_TOKEN_ARRAY_BEGIN, NULL, 0, 0.0)) return false;
+    if (is_object) {
+        stream->object_bits |= (uint64_t)1 << stream->depth;
+    } else {
+        stream->object_bits &= ~((uint64_t)1 << stream->depth);
+    }
+    stream->depth++;
+    stream->expect = is_object ? EXPECT_KEY_OR_END : EXPECT_VALUE_OR_END;
+    return true;
+}
+
+static inline bool top_is_object(const JsonStream* stream) {
+    return stream->depth > 0 && (stream->object_bits >> (stream->depth - 1)) & 1u;
+}
+
+static bool pop_container(JsonStream* stream, bool is_object) {
+    if (stream->depth == 0 || top_is_object(stream) != is_object) {
+        stream->status = JSON_STREAM_SYNTAX_ERROR;
+        return false;
+    }
+    stream->depth--;
+    if (!emit(stream, is_object ? JSON_TOKEN_OBJECT_END : JSON_TOKEN_ARRAY_END, NULL, 0, 0.0)) return false;
+    value_done(stream);
+    return true;
+}
+
+// Start a value at c; false on syntax error or abort
+static bool begin_value(JsonStream* stream, char c) {
+    switch (c) {
+        case '{': return push_container(stream, true);
+        case '[': return push_container(stream, false);
+        case '"':
+            stream->lex = LEX_STRING;
+            stream->string_is_key = false;
+            stream->scratch_size = 0;
+            return true;
+        case 't':
+        case 'f':
+        case 'n':
+            stream->lex = LEX_LITERAL;
+            stream->literal = c == 't' ? "true" : (c == 'f' ? "false" : "null");
+            stream->literal_type = c == 't' ? JSON_TOKEN_TRUE : (c == 'f' ? JSON_TOKEN_FALSE : JSON_TOKEN_NULL);
+            stream->literal_pos = 1;
+            return true;
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                stream->lex = LEX_NUMBER;
+                stream->scratch_size = 0;
+                if (!scratch_append(stream, &c, 1)) {
+                    stream->status = JSON_STREAM_OUT_OF_MEMORY;
+                    return false;
+                }
+                return true;
+            }
+            stream->status = JSON_STREAM_SYNTAX_ERROR;
+            return false;
+    }
+}
+
+// Structural character outside any token
+static bool handle_structural(JsonStream* stream, char c) {
+    switch (stream->expect) {
+        case EXPECT_VALUE:
+            return begin_value(stream, c);
+
+        case EXPECT_VALUE_OR_END:
+            if (c == ']') return pop_container(stream, false);
+            return begin_value(stream, c);
+
+        case EXPECT_KEY_OR_END:
+            if (c == '}') return pop_container(stream, true);
+            // Fall through
+        case EXPECT_KEY:
+            if (c != '"') break;
+            stream->lex = LEX_STRING;
+            stream->string_is_key = true;
+            stream->scratch_size = 0;
+            return true;
+
+        case EXPECT_COLON:
+            if (c != ':') break;
+            stream->expect = EXPECT_VALUE;
+            return true;
+
+        case EXPECT_COMMA_OR_END:
+            if (c == ',') {
+                stream->expect = top_is_object(stream) ? EXPECT_KEY : EXPECT_VALUE;
+                return true;
+            }
+            if (c == '}') return pop_container(stream, true);
+            if (c == ']') return pop_container(stream, false);
+            break;
+
+        default:
+            break;
+    }
+    stream->status = JSON_STREAM_SYNTAX_ERROR;
+    return false;
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+bool json_stream_init(JsonStream* stream, JsonTokenCallback callback, void* user_data) {
+    if (!stream) return false;
+    memset(stream, 0, sizeof(JsonStream));
+
+    stream->scratch = (char*)malloc(JSON_STREAM_MIN_SCRATCH);
+    if (!stream->scratch) return false;
+    stream->scratch_capacity = JSON_STREAM_MIN_SCRATCH;
+    stream->callback = callback;
+    stream->user_data = user_data;
+    stream->expect = EXPECT_VALUE;
+    stream->lex = LEX_NONE;
+    stream->status = JSON_STREAM_OK;
+    stream->line = 1;
+    return true;
+}
+
+void json_stream_shutdown(JsonStream* stream) {
+    if (!stream) return;
+    free(stream->scratch);
+    memset(stream, 0, sizeof(JsonStream));
+}
+
+// =============================================================================
+// Parsing
+// =============================================================================
+
+JsonStreamResult json_stream_feed(JsonStream* stream, const char* data, size_t size) {
+    if (!stream || !stream->scratch) return JSON_STREAM_OUT_OF_MEMORY;
+    if (stream->status != JSON_STREAM_OK) return stream->status;
+    if (!data) return stream->status;
+
+    const char* p = data;
+    const char* end = data + size;
+
+    while (p < end) {
+        // Skip a UTF-8 byte order mark at the very start
+        if (stream->bom_pos < 3) {
+            static const uint8_t bom[3] = {0xEF, 0xBB, 0xBF};
+            if ((uint8_t)*p == bom[stream->bom_pos]) {
+                p++;
+                stream->bom_pos++;
+                continue;
+            }
+            if (stream->bom_pos > 0) return fail(stream, JSON_STREAM_SYNTAX_ERROR);
+            stream->bom_pos = 3;
+        }
+
+        switch (stream->lex) {
+            case LEX_STRING: {
+                // Copy plain runs in bulk; stop at quote, escape or control byte
+                const char* run = p;
+                while (p < end && *p != '"' && *p != '\\' && (uint8_t)*p >= 0x20) p++;
+                if (p > run && stream->high_surrogate) return fail(stream, JSON_STREAM_SYNTAX_ERROR);
+                if (!scratch_append(stream, run, (size_t)(p - run))) {
+                    return fail(stream, JSON_STREAM_OUT_OF_MEMORY);
+                }
+                if (p == end) break;
+                char c = *p++;
+                if (c == '\\') {
+                    stream->lex = LEX_ESCAPE;
+                } else if (c == '"' && !stream->high_surrogate) {
+                    stream->lex = LEX_NONE;
+                    if (!finish_string(stream)) return stream->status;
+                } else {
+                    return fail(stream, JSON_STREAM_SYNTAX_ERROR);
+                }
+                break;
+            }
+
+            case LEX_ESCAPE: {
+                char c = *p++;
+                char out;
+                if (stream->high_surrogate && c != 'u') return fail(stream, JSON_STREAM_SYNTAX_ERROR);
+                switch (c) {
+                    case '"':  out = '"';  break;
+                    case '\\': out = '\\'; break;
+                    case '/':  out = '/';  break;
+                    case 'b':  out = '\b'; break;
+                    case 'f':  out = '\f'; break;
+                    case 'n':  out = '\n'; break;
+                    case 'r':  out = '\r'; break;
+                    case 't':  out = '\t'; break;
+                    case 'u':
+                        stream->lex = LEX_UNICODE;
+                        stream->unicode_value = 0;
+                        stream->unicode_digits = 0;
+                        continue;
+                    default:
+                        return fail(stream, JSON_STREAM_SYNTAX_ERROR);
+                }
+                if (!scratch_append(stream, &out, 1)) return fail(stream, JSON_STREAM_OUT_OF_MEMORY);
+                stream->lex = LEX_STRING;
+                break;
+            }
+
+            case LEX_UNICODE: {
+                int digit = hex_value(*p++);
+                if (digit < 0) return fail(stream, JSON_STREAM_SYNTAX_ERROR);
+                stream->unicode_value = (stream->unicode_value << 4) | (uint32_t)digit;
+                if (++stream->unicode_digits == 4) {
+                    if (!finish_codepoint(stream)) return stream->status;
+                    stream->lex = LEX_STRING;
+                }
+                break;
+            }
+
+            case LEX_NUMBER: {
+                const char* run = p;
+                while (p < end && is_number_char(*p)) p++;
+                if (!scratch_append(stream, run, (size_t)(p - run))) {
+                    return fail(stream, JSON_STREAM_OUT_OF_MEMORY);
+                }
+                if (p == end) break;
+                // The terminating byte is handled as structural below
+                stream->lex = LEX_NONE;
+                if (!finish_number(stream)) return stream->status;
+                break;
+            }
+
+            case LEX_LITERAL: {
+                if (*p++ != stream->literal[stream->literal_pos]) return fail(stream, JSON_STREAM_SYNTAX_ERROR);
+                if (stream->literal[++stream->literal_pos] == '\0') {
+                    stream->lex = LEX_NONE;
+                    if (!emit(stream, stream->literal_type, NULL, 0, 0.0)) return stream->status;
+                    value_done(stream);
+                }
+                break;
+            }
+
+            default: {
+                char c = *p++;
+                if (c == ' ' || c == '\t' || c == '\r') break;
+                if (c == '\n') {
+                    stream->line++;
+                    break;
+                }
+                if (!handle_structural(stream, c)) return stream->status;
+                break;
+            }
+        }
+    }
+
+    return stream->status;
+}
+
+JsonStreamResult json_stream_finish(JsonStream* stream) {
+    if (!stream || !stream->scratch) return JSON_STREAM_OUT_OF_MEMORY;
+    if (stream->status != JSON_STREAM_OK) return stream->status;
+
+    // A root-level number has no terminator
+    if (stream->lex == LEX_NUMBER) {
+        stream->lex = LEX_NONE;
+        if (!finish_number(stream)) return stream->status;
+    }
+
+    if (stream->lex != LEX_NONE || stream->expect != EXPECT_DONE) {
+        return fail(stream, JSON_STREAM_INCOMPLETE);
+    }
+    return JSON_STREAM_OK;
+}
+
+const char* json_stream_result_to_string(JsonStreamResult result) {
+    switch (result) {
+        case JSON_STREAM_OK:            return "OK";
+        case JSON_STREAM_SYNTAX_ERROR:  return "Syntax error";
+        case JSON_STREAM_TOO_DEEP:      return "Nesting too deep";
+        case JSON_STREAM_INCOMPLETE:    return "Unexpected end of input";
+        case JSON_STREAM_ABORTED:       return "Aborted";
+        case JSON_STREAM_OUT_OF_MEMORY: return "Out of memory";
+        default:                        return "Unknown error";
+    }
+}
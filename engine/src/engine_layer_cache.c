@@ -0,0 +1,212 @@
+#include "engine_layer_cache.h"
+#include <rlgl.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+bool layer_cache_init(LayerCache* cache, Color clear_color, LayerCacheDrawFunc draw, void* user_data) {
+    if (!cache) return false;
+
+    memset(cache, 0, sizeof(LayerCache));
+    cache->clear_color = clear_color;
+    cache->draw = draw;
+    cache->user_data = user_data;
+    return spatial_hash_init(&cache->slots, LAYER_CACHE_MAX_TILES * 2);
+}
+
+void layer_cache_shutdown(LayerCache* cache) {
+    if (!cache) return;
+
+    for (uint32_t i = 0; i < LAYER_CACHE_MAX_TILES; i++) {
+        if (cache->tiles[i].target.id != 0) UnloadRenderTexture(cache->tiles[i].target);
+    }
+    spatial_hash_shutdown(&cache->slots);
+    memset(cache, 0, sizeof(LayerCache));
+}
+
+// =============================================================================
+// Invalidation
+// =============================================================================
+
+void layer_cache_invalidate_rect(LayerCache* cache, float min_x, float min_y, float max_x, float max_y) {
+    if (!cache || cache->scale <= 0.0f) return;
+
+    float size = cache->tile_world_size;
+    for (uint32_t i = 0; i < LAYER_CACHE_MAX_TILES; i++) {
+        LayerCacheTile* tile = &cache->tiles[i];
+        if (!tile->assigned) continue;
+
+        float x0 = tile->tile_x * size;
+        float y0 = tile->tile_y * size;
+        if (max_x < x0 || min_x > x0 + size || max_y < y0 || min_y > y0 + size) continue;
+        tile->dirty = true;
+    }
+}
+
+void layer_cache_invalidate_all(LayerCache* cache) {
+    if (!cache) return;
+    for (uint32_t i = 0; i < LAYER_CACHE_MAX_TILES; i++) {
+        cache->tiles[i].dirty = true;
+    }
+}
+
+// =============================================================================
+// Planning
+// =============================================================================
+
+// A free slot, else the one out of view the longest
+static uint32_t layer_cache_take_slot(LayerCache* cache) {
+    uint32_t best = LAYER_CACHE_MAX_TILES;
+    for (uint32_t i = 0; i < LAYER_CACHE_MAX_TILES; i++) {
+        const LayerCacheTile* tile = &cache->tiles[i];
+        if (!tile->assigned) return i;
+        if (tile->last_frame == cache->frame) continue;
+        if (best == LAYER_CACHE_MAX_TILES || tile->last_frame < cache->tiles[best].last_frame) best = i;
+    }
+    return best;
+}
+
+float layer_cache_level(float zoom) {
+    if (zoom <= 0.0f) return 0.0f;
+    return exp2f(roundf(log2f(zoom)));
+}
+
+bool layer_cache_plan(LayerCache* cache, Rectangle view, float zoom) {
+    if (!cache || zoom <= 0.0f) return false;
+    cache->frame++;
+
+    // Tiles hold another level: keep their textures, drop their contents
+    float scale = layer_cache_level(zoom);
+    if (scale != cache->scale) {
+        spatial_hash_clear(&cache->slots);
+        for (uint32_t i = 0; i < LAYER_CACHE_MAX_TILES; i++) {
+            cache->tiles[i].assigned = false;
+            cache->tiles[i].dirty = true;
+        }
+        cache->scale = scale;
+        cache->tile_world_size = (float)LAYER_CACHE_TILE_PIXELS / scale;
+    }
+
+    float inv_size = 1.0f / cache->tile_world_size;
+    float min_x = floorf(view.x * inv_size);
+    float min_y = floorf(view.y * inv_size);
+    float max_x = floorf((view.x + view.width) * inv_size);
+    float max_y = floorf((view.y + view.height) * inv_size);
+    if ((max_x - min_x + 1.0f) * (max_y - min_y + 1.0f) > (float)LAYER_CACHE_MAX_TILES) return false;
+
+    cache->view_min_x = (int32_t)min_x;
+    cache->view_min_y = (int32_t)min_y;
+    cache->view_max_x = (int32_t)max_x;
+    cache->view_max_y = (int32_t)max_y;
+
+    // Tiles still cached are claimed first, so new ones never take their slots
+    for (int32_t ty = cache->view_min_y; ty <= cache->view_max_y; ty++) {
+        for (int32_t tx = cache->view_min_x; tx <= cache->view_max_x; tx++) {
+            uint16_t slot = spatial_hash_find(&cache->slots, tx, ty);
+            if (slot != SPATIAL_HASH_NOT_FOUND) cache->tiles[slot].last_frame = cache->frame;
+        }
+    }
+
+    // Newly exposed tiles take free or stale slots and start dirty
+    for (int32_t ty = cache->view_min_y; ty <= cache->view_max_y; ty++) {
+        for (int32_t tx = cache->view_min_x; tx <= cache->view_max_x; tx++) {
+            if (spatial_hash_contains(&cache->slots, tx, ty)) continue;
+
+            uint32_t slot = layer_cache_take_slot(cache);
+            LayerCacheTile* tile = &cache->tiles[slot];
+            if (tile->assigned) spatial_hash_remove(&cache->slots, tile->tile_x, tile->tile_y);
+            tile->tile_x = tx;
+            tile->tile_y = ty;
+            tile->last_frame = cache->frame;
+            tile->assigned = true;
+            tile->dirty = true;
+            spatial_hash_insert(&cache->slots, tx, ty, (uint16_t)slot);
+        }
+    }
+    return true;
+}
+
+// =============================================================================
+// Drawing
+// =============================================================================
+
+static void layer_cache_draw_tile(LayerCache* cache, LayerCacheTile* tile) {
+    float size = cache->tile_world_size;
+    Rectangle rect = {tile->tile_x * size, tile->tile_y * size, size, size};
+    Camera2D camera = {
+        .offset = {0.0f, 0.0f},
+        .target = {rect.x, rect.y},
+        .rotation = 0.0f,
+        .zoom = cache->scale
+    };
+
+    // Colour blends as usual, but alpha adds up towards opaque instead of
+    // being blended too, so the tile keeps its clear colour's alpha and is
+    // blended only once, when it is drawn
+    BeginTextureMode(tile->target);
+    ClearBackground(cache->clear_color);
+    BeginMode2D(camera);
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                              RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    if (cache->draw) cache->draw(rect, cache->user_data);
+    EndBlendMode();
+    EndMode2D();
+    EndTextureMode();
+}
+
+bool layer_cache_update(LayerCache* cache, Rectangle view, float zoom) {
+    if (!cache || cache->unavailable) return false;
+    cache->tiles_drawn = 0;
+
+    // Render textures need a GL context
+    if (!IsWindowReady()) return false;
+    if (!layer_cache_plan(cache, view, zoom)) return false;
+
+    for (int32_t ty = cache->view_min_y; ty <= cache->view_max_y; ty++) {
+        for (int32_t tx = cache->view_min_x; tx <= cache->view_max_x; tx++) {
+            LayerCacheTile* tile = &cache->tiles[spatial_hash_find(&cache->slots, tx, ty)];
+            if (!tile->dirty) continue;
+
+            if (tile->target.id == 0) {
+                tile->target = LoadRenderTexture(LAYER_CACHE_TILE_PIXELS, LAYER_CACHE_TILE_PIXELS);
+                if (tile->target.id == 0) {
+                    printf("Layer Cache: Render textures unavailable, layers are drawn directly\n");
+                    cache->unavailable = true;
+                    return false;
+                }
+            }
+            layer_cache_draw_tile(cache, tile);
+            tile->dirty = false;
+            cache->tiles_drawn++;
+        }
+    }
+    return true;
+}
+
+void layer_cache_queue(const LayerCache* cache, RenderStream* stream, uint8_t layer) {
+    if (!cache || !stream || cache->scale <= 0.0f) return;
+
+    // Render textures are stored bottom-up
+    Rectangle source = {0.0f, 0.0f, (float)LAYER_CACHE_TILE_PIXELS, -(float)LAYER_CACHE_TILE_PIXELS};
+    float size = cache->tile_world_size;
+
+    for (int32_t ty = cache->view_min_y; ty <= cache->view_max_y; ty++) {
+        for (int32_t tx = cache->view_min_x; tx <= cache->view_max_x; tx++) {
+            uint16_t slot = spatial_hash_find(&cache->slots, tx, ty);
+            if (slot == SPATIAL_HASH_NOT_FOUND) continue;
+            const LayerCacheTile* tile = &cache->tiles[slot];
+            if (tile->target.id == 0 || tile->dirty) continue;
+
+            // Edges from the grid so neighbours meet exactly
+            float x0 = tx * size;
+            float y0 = ty * size;
+            Rectangle dest = {x0, y0, (tx + 1) * size - x0, (ty + 1) * size - y0};
+            render_queue_sprite(stream, layer, 0.0f, tile->target.texture, source, dest, WHITE);
+        }
+    }
+}
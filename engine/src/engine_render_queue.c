@@ -0,0 +1,380 @@
+#include "engine_render_queue.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define RENDER_KEY_LAYER_SHIFT 56
+#define RENDER_KEY_MATERIAL_SHIFT 40
+#define RENDER_KEY_DEPTH_SHIFT 8
+#define RENDER_REF_STREAM_SHIFT 24
+#define RENDER_REF_INDEX_MASK 0xFFFFFFu
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+void render_queue_init(RenderQueue* queue) {
+    if (!queue) return;
+    memset(queue, 0, sizeof(RenderQueue));
+    renderer_triangle_batch_init(&queue->shapes);
+}
+
+void render_queue_shutdown(RenderQueue* queue) {
+    if (!queue) return;
+
+    for (uint32_t s = 0; s < RENDER_QUEUE_MAX_STREAMS; s++) {
+        free(queue->streams[s].commands);
+        free(queue->streams[s].keys);
+        free(queue->streams[s].text);
+    }
+    for (int b = 0; b < 2; b++) {
+        free(queue->sort_keys[b]);
+        free(queue->sort_refs[b]);
+    }
+    renderer_triangle_batch_shutdown(&queue->shapes);
+    render_queue_init(queue);
+}
+
+void render_queue_begin(RenderQueue* queue) {
+    if (!queue) return;
+
+    for (uint32_t s = 0; s < RENDER_QUEUE_MAX_STREAMS; s++) {
+        queue->streams[s].count = 0;
+        queue->streams[s].text_size = 0;
+    }
+    renderer_triangle_batch_clear(&queue->shapes);
+}
+
+RenderStream* render_queue_stream(RenderQueue* queue, uint32_t index) {
+    if (!queue || index >= RENDER_QUEUE_MAX_STREAMS) return NULL;
+    return &queue->streams[index];
+}
+
+// =============================================================================
+// Keys
+// =============================================================================
+
+// Float bits that sort as unsigned integers in the float's order
+static uint32_t depth_bits(float depth) {
+    uint32_t bits;
+    memcpy(&bits, &depth, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+uint64_t render_key_make(uint8_t layer, uint16_t material, float depth) {
+    return ((uint64_t)layer << RENDER_KEY_LAYER_SHIFT) |
+           ((uint64_t)material << RENDER_KEY_MATERIAL_SHIFT) |
+           ((uint64_t)depth_bits(depth) << RENDER_KEY_DEPTH_SHIFT);
+}
+
+// =============================================================================
+// Commands
+// =============================================================================
+
+// Next command slot of a stream, keyed; NULL when full and growing fails
+static RenderCommand* stream_push(RenderStream* stream, uint64_t key, RenderCommandType type, Color color) {
+    if (!stream) return NULL;
+
+    if (stream->count == stream->capacity) {
+        uint32_t capacity = stream->capacity ? stream->capacity * 2 : RENDER_QUEUE_MIN_COMMANDS;
+        if (capacity > RENDER_REF_INDEX_MASK + 1) return NULL;
+
+        RenderCommand* commands = (RenderCommand*)realloc(stream->commands, capacity * sizeof(RenderCommand));
+        if (commands) stream->commands = commands;
+        uint64_t* keys = (uint64_t*)realloc(stream->keys, capacity * sizeof(uint64_t));
+        if (keys) stream->keys = keys;
+        if (!commands || !keys) {
+            fprintf(stderr, "Render Queue: Out of memory growing a stream to %u commands\n", capacity);
+            return NULL;
+        }
+        stream->capacity = capacity;
+    }
+
+    uint32_t i = stream->count++;
+    stream->keys[i] = key;
+    RenderCommand* cmd = &stream->commands[i];
+    cmd->type = (uint8_t)type;
+    cmd->color = color;
+    return cmd;
+}
+
+void render_queue_triangle(RenderStream* stream, uint8_t layer, float depth,
+                           Vector2 a, Vector2 b, Vector2 c, Color color) {
+    RenderCommand* cmd = stream_push(stream, render_key_make(layer, RENDER_MATERIAL_SHAPES, depth),
+                                     RENDER_CMD_TRIANGLE, color);
+    if (!cmd) return;
+    cmd->triangle.x[0] = a.x; cmd->triangle.y[0] = a.y;
+    cmd->triangle.x[1] = b.x; cmd->triangle.y[1] = b.y;
+    cmd->triangle.x[2] = c.x; cmd->triangle.y[2] = c.y;
+}
+
+void render_queue_quad(RenderStream* stream, uint8_t layer, float depth,
+                       float x, float y, float width, float height, Color color) {
+    RenderCommand* cmd = stream_push(stream, render_key_make(layer, RENDER_MATERIAL_SHAPES, depth),
+                                     RENDER_CMD_QUAD, color);
+    if (!cmd) return;
+    cmd->quad.x = x;
+    cmd->quad.y = y;
+    cmd->quad.width = width;
+    cmd->quad.height = height;
+}
+
+void render_queue_line(RenderStream* stream, uint8_t layer, float depth,
+                       Vector2 from, Vector2 to, float thickness, Color color) {
+    RenderCommand* cmd = stream_push(stream, render_key_make(layer, RENDER_MATERIAL_SHAPES, depth),
+                                     RENDER_CMD_LINE, color);
+    if (!cmd) return;
+    cmd->line.x0 = from.x;
+    cmd->line.y0 = from.y;
+    cmd->line.x1 = to.x;
+    cmd->line.y1 = to.y;
+    cmd->line.thickness = thickness;
+}
+
+void render_queue_circle(RenderStream* stream, uint8_t layer, float depth,
+                         float x, float y, float radius, int segments, Color color) {
+    RenderCommand* cmd = stream_push(stream, render_key_make(layer, RENDER_MATERIAL_SHAPES, depth),
+                                     RENDER_CMD_CIRCLE, color);
+    if (!cmd) return;
+    cmd->circle.x = x;
+    cmd->circle.y = y;
+    cmd->circle.radius = radius;
+    cmd->circle.thickness = 0.0f;
+    cmd->circle.segments = segments;
+}
+
+void render_queue_ring(RenderStream* stream, uint8_t layer, float depth,
+                       float x, float y, float radius, float thickness, int segments, Color color) {
+    RenderCommand* cmd = stream_push(stream, render_key_make(layer, RENDER_MATERIAL_SHAPES, depth),
+                                     RENDER_CMD_RING, color);
+    if (!cmd) return;
+    cmd->circle.x = x;
+    cmd->circle.y = y;
+    cmd->circle.radius = radius;
+    cmd->circle.thickness = thickness;
+    cmd->circle.segments = segments;
+}
+
+void render_queue_triangles(RenderStream* stream, uint8_t layer, float depth,
+                            const TriangleBatch* batch, uint32_t first, uint32_t count) {
+    if (!batch || count == 0) return;
+    RenderCommand* cmd = stream_push(stream, render_key_make(layer, RENDER_MATERIAL_SHAPES, depth),
+                                     RENDER_CMD_TRIANGLES, BLANK);
+    if (!cmd) return;
+    cmd->triangles.batch = batch;
+    cmd->triangles.first = first;
+    cmd->triangles.count = count;
+}
+
+void render_queue_text(RenderStream* stream, uint8_t layer, float depth,
+                       const char* text, float x, float y, int font_size, Color color) {
+    if (!stream || !text) return;
+
+    uint32_t length = (uint32_t)strlen(text) + 1;
+    if (stream->text_size + length > stream->text_capacity) {
+        uint32_t capacity = stream->text_capacity ? stream->text_capacity : 1024;
+        while (capacity < stream->text_size + length) capacity *= 2;
+        char* grown = (char*)realloc(stream->text, capacity);
+        if (!grown) return;
+        stream->text = grown;
+        stream->text_capacity = capacity;
+    }
+
+    RenderCommand* cmd = stream_push(stream, render_key_make(layer, RENDER_MATERIAL_TEXT, depth),
+                                     RENDER_CMD_TEXT, color);
+    if (!cmd) return;
+    memcpy(stream->text + stream->text_size, text, length);
+    cmd->text.x = x;
+    cmd->text.y = y;
+    cmd->text.font_size = font_size;
+    cmd->text.offset = stream->text_size;
+    stream->text_size += length;
+}
+
+void render_queue_sprite(RenderStream* stream, uint8_t layer, float depth, Texture2D texture,
+                         Rectangle source, Rectangle dest, Color tint) {
+    // One material per texture, between shapes and text
+    uint16_t material = (uint16_t)(texture.id % (RENDER_MATERIAL_TEXT - 1) + 1);
+    RenderCommand* cmd = stream_push(stream, render_key_make(layer, material, depth),
+                                     RENDER_CMD_SPRITE, tint);
+    if (!cmd) return;
+    cmd->sprite.texture = texture;
+    cmd->sprite.source = source;
+    cmd->sprite.dest = dest;
+}
+
+void render_queue_callback(RenderStream* stream, uint8_t layer, RenderCallback func, void* user_data) {
+    if (!func) return;
+    RenderCommand* cmd = stream_push(stream, render_key_make(layer, RENDER_MATERIAL_CALLBACK, 0.0f),
+                                     RENDER_CMD_CALLBACK, BLANK);
+    if (!cmd) return;
+    cmd->callback.func = func;
+    cmd->callback.user_data = user_data;
+}
+
+// =============================================================================
+// Sorting
+// =============================================================================
+
+static bool ensure_sort_capacity(RenderQueue* queue, uint32_t count) {
+    if (count <= queue->sort_capacity) return true;
+
+    uint32_t capacity = queue->sort_capacity ? queue->sort_capacity : RENDER_QUEUE_MIN_COMMANDS;
+    while (capacity < count) capacity *= 2;
+    for (int b = 0; b < 2; b++) {
+        uint64_t* keys = (uint64_t*)realloc(queue->sort_keys[b], capacity * sizeof(uint64_t));
+        if (keys) queue->sort_keys[b] = keys;
+        uint32_t* refs = (uint32_t*)realloc(queue->sort_refs[b], capacity * sizeof(uint32_t));
+        if (refs) queue->sort_refs[b] = refs;
+        if (!keys || !refs) {
+            fprintf(stderr, "Render Queue: Out of memory sorting %u commands\n", count);
+            return false;
+        }
+    }
+    queue->sort_capacity = capacity;
+    return true;
+}
+
+uint32_t render_queue_sort(RenderQueue* queue, const uint32_t** out_refs) {
+    if (out_refs) *out_refs = NULL;
+    if (!queue) return 0;
+    queue->stats.sort_passes = 0;
+
+    uint32_t count = 0;
+    for (uint32_t s = 0; s < RENDER_QUEUE_MAX_STREAMS; s++) count += queue->streams[s].count;
+    if (count == 0 || !ensure_sort_capacity(queue, count)) return 0;
+
+    // Gather in stream order; the least significant digit sort keeps it for ties
+    uint64_t* keys = queue->sort_keys[0];
+    uint32_t* refs = queue->sort_refs[0];
+    uint32_t n = 0;
+    for (uint32_t s = 0; s < RENDER_QUEUE_MAX_STREAMS; s++) {
+        const RenderStream* stream = &queue->streams[s];
+        if (stream->count == 0) continue;
+        memcpy(keys + n, stream->keys, stream->count * sizeof(uint64_t));
+        for (uint32_t i = 0; i < stream->count; i++) {
+            refs[n + i] = (s << RENDER_REF_STREAM_SHIFT) | i;
+        }
+        n += stream->count;
+    }
+
+    // One pass per key byte, skipping bytes every key shares
+    uint64_t* keys_out = queue->sort_keys[1];
+    uint32_t* refs_out = queue->sort_refs[1];
+    for (uint32_t shift = 0; shift < 64; shift += 8) {
+        uint32_t histogram[256] = {0};
+        for (uint32_t i = 0; i < count; i++) histogram[(keys[i] >> shift) & 0xFF]++;
+        if (histogram[(keys[0] >> shift) & 0xFF] == count) continue;
+
+        uint32_t offset = 0;
+        for (uint32_t b = 0; b < 256; b++) {
+            uint32_t c = histogram[b];
+            histogram[b] = offset;
+            offset += c;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t slot = histogram[(keys[i] >> shift) & 0xFF]++;
+            keys_out[slot] = keys[i];
+            refs_out[slot] = refs[i];
+        }
+
+        uint64_t* swap_keys = keys; keys = keys_out; keys_out = swap_keys;
+        uint32_t* swap_refs = refs; refs = refs_out; refs_out = swap_refs;
+        queue->stats.sort_passes++;
+    }
+
+    if (out_refs) *out_refs = refs;
+    return count;
+}
+
+// =============================================================================
+// Submission
+// =============================================================================
+
+// Draw the shapes gathered so far
+static void flush_shapes(RenderQueue* queue) {
+    renderer_triangle_batch_flush(&queue->shapes);
+}
+
+static void add_shape(TriangleBatch* shapes, const RenderCommand* cmd) {
+    switch ((RenderCommandType)cmd->type) {
+        case RENDER_CMD_TRIANGLE:
+            renderer_triangle_batch_add(shapes,
+                                        (Vector2){cmd->triangle.x[0], cmd->triangle.y[0]},
+                                        (Vector2){cmd->triangle.x[1], cmd->triangle.y[1]},
+                                        (Vector2){cmd->triangle.x[2], cmd->triangle.y[2]}, cmd->color);
+            break;
+        case RENDER_CMD_QUAD: {
+            float x0 = cmd->quad.x, y0 = cmd->quad.y;
+            float x1 = x0 + cmd->quad.width, y1 = y0 + cmd->quad.height;
+            renderer_triangle_batch_add(shapes, (Vector2){x0, y0}, (Vector2){x0, y1}, (Vector2){x1, y1}, cmd->color);
+            renderer_triangle_batch_add(shapes, (Vector2){x0, y0}, (Vector2){x1, y1}, (Vector2){x1, y0}, cmd->color);
+            break;
+        }
+        case RENDER_CMD_LINE:
+            renderer_triangle_batch_add_line(shapes, (Vector2){cmd->line.x0, cmd->line.y0},
+                                             (Vector2){cmd->line.x1, cmd->line.y1},
+                                             cmd->line.thickness, cmd->color);
+            break;
+        case RENDER_CMD_CIRCLE:
+            renderer_triangle_batch_add_circle(shapes, cmd->circle.x, cmd->circle.y, cmd->circle.radius,
+                                               cmd->circle.segments, cmd->color);
+            break;
+        case RENDER_CMD_RING:
+            renderer_triangle_batch_add_ring(shapes, cmd->circle.x, cmd->circle.y, cmd->circle.radius,
+                                             cmd->circle.thickness, cmd->circle.segments, cmd->color);
+            break;
+        default:
+            break;
+    }
+}
+
+void render_queue_submit(RenderQueue* queue) {
+    if (!queue) return;
+
+    const uint32_t* order;
+    uint32_t count = render_queue_sort(queue, &order);
+    queue->stats.commands = count;
+    queue->stats.runs = 0;
+
+    uint64_t run_key = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const RenderStream* stream = &queue->streams[order[i] >> RENDER_REF_STREAM_SHIFT];
+        uint32_t index = order[i] & RENDER_REF_INDEX_MASK;
+        const RenderCommand* cmd = &stream->commands[index];
+
+        // A new layer or material starts a run
+        uint64_t key = stream->keys[index] >> RENDER_KEY_MATERIAL_SHIFT;
+        if (i == 0 || key != run_key) {
+            queue->stats.runs++;
+            run_key = key;
+        }
+
+        switch ((RenderCommandType)cmd->type) {
+            case RENDER_CMD_TRIANGLES:
+                // Drawn in place; rlgl merges it with the shapes around it
+                flush_shapes(queue);
+                renderer_triangle_batch_draw_range(cmd->triangles.batch, cmd->triangles.first,
+                                                   cmd->triangles.count);
+                break;
+            case RENDER_CMD_TEXT:
+                flush_shapes(queue);
+                DrawText(stream->text + cmd->text.offset, (int)cmd->text.x, (int)cmd->text.y,
+                         cmd->text.font_size, cmd->color);
+                break;
+            case RENDER_CMD_SPRITE:
+                flush_shapes(queue);
+                DrawTexturePro(cmd->sprite.texture, cmd->sprite.source, cmd->sprite.dest,
+                               (Vector2){0.0f, 0.0f}, 0.0f, cmd->color);
+                break;
+            case RENDER_CMD_CALLBACK:
+                flush_shapes(queue);
+                cmd->callback.func(cmd->callback.user_data);
+                break;
+            default:
+                add_shape(&queue->shapes, cmd);
+                break;
+        }
+    }
+    flush_shapes(queue);
+}
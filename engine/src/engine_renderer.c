@@ -1,6 +1,11 @@
 #include "engine_renderer.h"
 #include <raylib.h>
 #include <rlgl.h>
+#include <raymath.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
 
 void renderer_init(void) {
     // Renderer initialization (if needed beyond window init)
@@ -26,39 +31,148 @@ void renderer_draw_text(const char* text, int x, int y, int font_size, Color col
 // Batched Rectangle Rendering
 // =============================================================================
 
-void renderer_rect_batch_init(RectBatch* batch, Color color) {
-    if (!batch) return;
-    batch->count = 0;
+bool renderer_rect_batch_init(RectBatch* batch, uint32_t capacity, Color color) {
+    if (!batch) return false;
+    
+    memset(batch, 0, sizeof(RectBatch));
     batch->color = color;
+    if (capacity == 0) capacity = RECT_BATCH_DEFAULT_CAPACITY;
+    
+    batch->x = (float*)malloc(capacity * sizeof(float));
+    batch->y = (float*)malloc(capacity * sizeof(float));
+    batch->w = (float*)malloc(capacity * sizeof(float));
+    batch->h = (float*)malloc(capacity * sizeof(float));
+    batch->colors = (Color*)malloc(capacity * sizeof(Color));
+    if (!batch->x || !batch->y || !batch->w || !batch->h || !batch->colors) {
+        fprintf(stderr, "Renderer: Failed to allocate a rectangle batch of %u\n", capacity);
+        renderer_rect_batch_shutdown(batch);
+        return false;
+    }
+    
+    batch->capacity = capacity;
+    return true;
 }
 
-bool renderer_rect_batch_add(RectBatch* batch, int x, int y, int w, int h) {
-    if (!batch || batch->count >= RECT_BATCH_MAX_RECTS) return false;
+// Release whichever GPU buffers were created
+static void rect_batch_unload_gpu(RectBatch* batch) {
+    for (uint32_t k = 0; k < RECT_BATCH_GPU_BUFFERS; k++) {
+        if (batch->vao[k]) rlUnloadVertexArray(batch->vao[k]);
+        if (batch->vbo_positions[k]) rlUnloadVertexBuffer(batch->vbo_positions[k]);
+        if (batch->vbo_colors[k]) rlUnloadVertexBuffer(batch->vbo_colors[k]);
+        batch->vao[k] = 0;
+        batch->vbo_positions[k] = 0;
+        batch->vbo_colors[k] = 0;
+    }
+    if (batch->ibo) rlUnloadVertexBuffer(batch->ibo);
+    batch->ibo = 0;
+}
+
+void renderer_rect_batch_shutdown(RectBatch* batch) {
+    if (!batch) return;
+    
+    rect_batch_unload_gpu(batch);
+    free(batch->x);
+    free(batch->y);
+    free(batch->w);
+    free(batch->h);
+    free(batch->colors);
+    free(batch->staging_positions);
+    free(batch->staging_colors);
+    memset(batch, 0, sizeof(RectBatch));
+}
+
+bool renderer_rect_batch_add(RectBatch* batch, float x, float y, float w, float h) {
+    if (!batch) return false;
+    return renderer_rect_batch_add_colored(batch, x, y, w, h, batch->color);
+}
+
+bool renderer_rect_batch_add_colored(RectBatch* batch, float x, float y, float w, float h, Color color) {
+    if (!batch || batch->count >= batch->capacity) return false;
     
     uint32_t i = batch->count++;
-    batch->x[i] = (int16_t)x;
-    batch->y[i] = (int16_t)y;
-    batch->w[i] = (int16_t)w;
-    batch->h[i] = (int16_t)h;
+    batch->x[i] = x;
+    batch->y[i] = y;
+    batch->w[i] = w;
+    batch->h[i] = h;
+    batch->colors[i] = color;
     return true;
 }
 
-void renderer_rect_batch_flush(RectBatch* batch) {
-    if (!batch || batch->count == 0) return;
+// Create the vertex arrays on first use; false where vertex arrays are
+// unavailable (immediate mode is used instead)
+static bool rect_batch_create_gpu(RectBatch* batch) {
+    if (batch->vao[0]) return true;
+    if (batch->gpu_quads) return false;     // Tried before and failed
+    
+    uint32_t quads = batch->capacity < RECT_BATCH_GPU_QUADS ? batch->capacity : RECT_BATCH_GPU_QUADS;
+    batch->gpu_quads = quads;
     
-    // Use rlgl for efficient batched quad rendering
+    batch->staging_positions = (float*)malloc((size_t)quads * 8 * sizeof(float));
+    batch->staging_colors = (Color*)malloc((size_t)quads * 4 * sizeof(Color));
+    unsigned short* indices = (unsigned short*)malloc((size_t)quads * 6 * sizeof(unsigned short));
+    if (!batch->staging_positions || !batch->staging_colors || !indices) {
+        free(indices);
+        return false;
+    }
+    
+    // Two triangles per quad over vertices top-left, bottom-left, bottom-right, top-right
+    for (uint32_t q = 0; q < quads; q++) {
+        unsigned short v = (unsigned short)(q * 4);
+        unsigned short* idx = &indices[q * 6];
+        idx[0] = v;     idx[1] = v + 1; idx[2] = v + 2;
+        idx[3] = v;     idx[4] = v + 2; idx[5] = v + 3;
+    }
+    
+    // One vertex array per buffer set; the first creates the index buffer
+    // and the others bind it too
+    bool created = true;
+    for (uint32_t k = 0; k < RECT_BATCH_GPU_BUFFERS && created; k++) {
+        batch->vao[k] = rlLoadVertexArray();
+        if (!batch->vao[k] || !rlEnableVertexArray(batch->vao[k])) {
+            created = false;
+            break;
+        }
+        batch->vbo_positions[k] = rlLoadVertexBuffer(NULL, (int)(quads * 8 * sizeof(float)), true);
+        rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION, 2, RL_FLOAT, false, 0, 0);
+        rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION);
+        
+        batch->vbo_colors[k] = rlLoadVertexBuffer(NULL, (int)(quads * 4 * sizeof(Color)), true);
+        rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR, 4, RL_UNSIGNED_BYTE, true, 0, 0);
+        rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR);
+        
+        if (k == 0) {
+            batch->ibo = rlLoadVertexBufferElement(indices, (int)(quads * 6 * sizeof(unsigned short)), false);
+        } else {
+            rlEnableVertexBufferElement(batch->ibo);
+        }
+        rlDisableVertexArray();
+        created = batch->vbo_positions[k] && batch->vbo_colors[k] && batch->ibo;
+    }
+    free(indices);
+    
+    if (!created) {
+        rect_batch_unload_gpu(batch);
+        printf("Renderer: Vertex arrays unavailable, rectangle batches use immediate mode\n");
+        return false;
+    }
+    batch->next_buffer = 0;
+    return true;
+}
+
+// Immediate-mode fallback
+static void rect_batch_draw_immediate(RectBatch* batch) {
     rlSetTexture(rlGetTextureIdDefault());
     rlBegin(RL_QUADS);
     
-    rlColor4ub(batch->color.r, batch->color.g, batch->color.b, batch->color.a);
-    
     for (uint32_t i = 0; i < batch->count; i++) {
-        float x = (float)batch->x[i];
-        float y = (float)batch->y[i];
-        float w = (float)batch->w[i];
-        float h = (float)batch->h[i];
+        float x = batch->x[i];
+        float y = batch->y[i];
+        float w = batch->w[i];
+        float h = batch->h[i];
+        Color c = batch->colors[i];
         
-        // Two triangles forming a quad (CCW winding)
+        // Counter-clockwise on screen, as raylib draws quads
+        rlColor4ub(c.r, c.g, c.b, c.a);
         rlVertex2f(x, y);
         rlVertex2f(x, y + h);
         rlVertex2f(x + w, y + h);
@@ -67,7 +181,61 @@ void renderer_rect_batch_flush(RectBatch* batch) {
     
     rlEnd();
     rlSetTexture(0);
+    batch->draw_calls = 1;
+}
+
+void renderer_rect_batch_flush(RectBatch* batch) {
+    if (!batch || batch->count == 0) return;
+    batch->draw_calls = 0;
+    
+    if (!rect_batch_create_gpu(batch)) {
+        rect_batch_draw_immediate(batch);
+        batch->count = 0;
+        return;
+    }
+    
+    // Whatever rlgl has batched so far goes first, then draw with its
+    // default shader under the current (camera) transform
+    rlDrawRenderBatchActive();
+    rlEnableShader(rlGetShaderIdDefault());
+    int* locs = rlGetShaderLocsDefault();
+    rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MVP], MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+    const float white[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    rlSetUniform(locs[SHADER_LOC_COLOR_DIFFUSE], white, SHADER_UNIFORM_VEC4, 1);
+    rlActiveTextureSlot(0);
+    rlEnableTexture(rlGetTextureIdDefault());
+    
+    for (uint32_t start = 0; start < batch->count; start += batch->gpu_quads) {
+        uint32_t quads = batch->count - start;
+        if (quads > batch->gpu_quads) quads = batch->gpu_quads;
+        
+        float* p = batch->staging_positions;
+        Color* c = batch->staging_colors;
+        for (uint32_t i = start; i < start + quads; i++) {
+            float x0 = batch->x[i], y0 = batch->y[i];
+            float x1 = x0 + batch->w[i], y1 = y0 + batch->h[i];
+            p[0] = x0; p[1] = y0;
+            p[2] = x0; p[3] = y1;
+            p[4] = x1; p[5] = y1;
+            p[6] = x1; p[7] = y0;
+            c[0] = c[1] = c[2] = c[3] = batch->colors[i];
+            p += 8;
+            c += 4;
+        }
+        
+        // Write the set least recently drawn from
+        uint32_t k = batch->next_buffer;
+        batch->next_buffer = (k + 1) % RECT_BATCH_GPU_BUFFERS;
+        rlEnableVertexArray(batch->vao[k]);
+        rlUpdateVertexBuffer(batch->vbo_positions[k], batch->staging_positions, (int)(quads * 8 * sizeof(float)), 0);
+        rlUpdateVertexBuffer(batch->vbo_colors[k], batch->staging_colors, (int)(quads * 4 * sizeof(Color)), 0);
+        rlDrawVertexArrayElements(0, (int)(quads * 6), 0);
+        batch->draw_calls++;
+    }
     
+    rlDisableVertexArray();
+    rlDisableTexture();
+    rlDisableShader();
     batch->count = 0;
 }
 
@@ -75,3 +243,321 @@ void renderer_rect_batch_clear(RectBatch* batch) {
     if (!batch) return;
     batch->count = 0;
 }
+
+// =============================================================================
+// Batched Triangle Rendering
+// =============================================================================
+
+void renderer_triangle_batch_init(TriangleBatch* batch) {
+    if (!batch) return;
+    batch->x = NULL;
+    batch->y = NULL;
+    batch->color = NULL;
+    batch->count = 0;
+    batch->capacity = 0;
+}
+
+void renderer_triangle_batch_shutdown(TriangleBatch* batch) {
+    if (!batch) return;
+    free(batch->x);
+    free(batch->y);
+    free(batch->color);
+    renderer_triangle_batch_init(batch);
+}
+
+bool renderer_triangle_batch_reserve(TriangleBatch* batch, uint32_t vertex_count) {
+    if (!batch) return false;
+    if (batch->count + vertex_count <= batch->capacity) return true;
+    
+    uint32_t capacity = batch->capacity ? batch->capacity : TRIANGLE_BATCH_MIN_CAPACITY;
+    while (capacity < batch->count + vertex_count) capacity *= 2;
+    
+    float* x = (float*)realloc(batch->x, capacity * sizeof(float));
+    if (x) batch->x = x;
+    float* y = (float*)realloc(batch->y, capacity * sizeof(float));
+    if (y) batch->y = y;
+    Color* color = (Color*)realloc(batch->color, capacity * sizeof(Color));
+    if (color) batch->color = color;
+    if (!x || !y || !color) return false;
+    
+    batch->capacity = capacity;
+    return true;
+}
+
+// Store one triangle in the winding rlgl draws (as DrawTriangle takes it);
+// the caller has reserved room
+static void triangle_batch_push(TriangleBatch* batch, float ax, float ay, float bx, float by,
+                                float cx, float cy, Color color) {
+    float cross = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+    if (cross > 0.0f) {
+        float tx = bx, ty = by;
+        bx = cx; by = cy;
+        cx = tx; cy = ty;
+    }
+    
+    uint32_t i = batch->count;
+    batch->x[i] = ax;     batch->y[i] = ay;
+    batch->x[i + 1] = bx; batch->y[i + 1] = by;
+    batch->x[i + 2] = cx; batch->y[i + 2] = cy;
+    batch->color[i] = color;
+    batch->color[i + 1] = color;
+    batch->color[i + 2] = color;
+    batch->count = i + 3;
+}
+
+void renderer_triangle_batch_add(TriangleBatch* batch, Vector2 a, Vector2 b, Vector2 c, Color color) {
+    if (!renderer_triangle_batch_reserve(batch, 3)) return;
+    triangle_batch_push(batch, a.x, a.y, b.x, b.y, c.x, c.y, color);
+}
+
+void renderer_triangle_batch_add_line(TriangleBatch* batch, Vector2 a, Vector2 b,
+                                      float thickness, Color color) {
+    float dx = b.x - a.x;
+    float dy = b.y - a.y;
+    float length = sqrtf(dx * dx + dy * dy);
+    if (length <= 0.0f) return;
+    if (!renderer_triangle_batch_reserve(batch, 6)) return;
+    
+    // Half the thickness either side of the line
+    float nx = -dy / length * thickness * 0.5f;
+    float ny = dx / length * thickness * 0.5f;
+    triangle_batch_push(batch, a.x + nx, a.y + ny, a.x - nx, a.y - ny, b.x - nx, b.y - ny, color);
+    triangle_batch_push(batch, a.x + nx, a.y + ny, b.x - nx, b.y - ny, b.x + nx, b.y + ny, color);
+}
+
+void renderer_triangle_batch_add_circle(TriangleBatch* batch, float center_x, float center_y,
+                                        float radius, int segments, Color color) {
+    if (segments < 3 || radius <= 0.0f) return;
+    if (!renderer_triangle_batch_reserve(batch, (uint32_t)segments * 3)) return;
+    
+    // Step round the rim by rotating, one sincos per circle
+    float step = 2.0f * PI / (float)segments;
+    float step_cos = cosf(step);
+    float step_sin = sinf(step);
+    float rx = radius, ry = 0.0f;
+    for (int i = 0; i < segments; i++) {
+        float nx = rx * step_cos - ry * step_sin;
+        float ny = rx * step_sin + ry * step_cos;
+        triangle_batch_push(batch, center_x, center_y, center_x + nx, center_y + ny,
+                            center_x + rx, center_y + ry, color);
+        rx = nx;
+        ry = ny;
+    }
+}
+
+void renderer_triangle_batch_add_ring(TriangleBatch* batch, float center_x, float center_y,
+                                      float radius, float thickness, int segments, Color color) {
+    if (segments < 3 || radius <= 0.0f || thickness <= 0.0f) return;
+    if (!renderer_triangle_batch_reserve(batch, (uint32_t)segments * 6)) return;
+    
+    // Quads between the inner and outer rim, centred on radius
+    float inner = fmaxf(radius - thickness * 0.5f, 0.0f) / radius;
+    float outer = (radius + thickness * 0.5f) / radius;
+    float step = 2.0f * PI / (float)segments;
+    float step_cos = cosf(step);
+    float step_sin = sinf(step);
+    float rx = radius, ry = 0.0f;
+    for (int i = 0; i < segments; i++) {
+        float nx = rx * step_cos - ry * step_sin;
+        float ny = rx * step_sin + ry * step_cos;
+        float ax = center_x + rx * inner, ay = center_y + ry * inner;
+        float bx = center_x + rx * outer, by = center_y + ry * outer;
+        float cx = center_x + nx * outer, cy = center_y + ny * outer;
+        float dx = center_x + nx * inner, dy = center_y + ny * inner;
+        triangle_batch_push(batch, ax, ay, bx, by, cx, cy, color);
+        triangle_batch_push(batch, ax, ay, cx, cy, dx, dy, color);
+        rx = nx;
+        ry = ny;
+    }
+}
+
+void renderer_triangle_batch_draw_range(const TriangleBatch* batch, uint32_t first, uint32_t count) {
+    if (!batch || first >= batch->count) return;
+    if (count > batch->count - first) count = batch->count - first;
+    count -= count % 3;
+    
+    // Consecutive RL_TRIANGLES runs merge into one draw; rlgl only splits
+    // them when its vertex buffer fills, which is checked a chunk at a time
+    uint32_t last = first + count;
+    for (uint32_t start = first; start < last; start += TRIANGLE_BATCH_FLUSH_CHUNK) {
+        uint32_t end = start + TRIANGLE_BATCH_FLUSH_CHUNK;
+        if (end > last) end = last;
+        
+        rlCheckRenderBatchLimit((int)(end - start));
+        rlBegin(RL_TRIANGLES);
+        
+        Color current = batch->color[start];
+        rlColor4ub(current.r, current.g, current.b, current.a);
+        for (uint32_t i = start; i < end; i++) {
+            Color c = batch->color[i];
+            if (c.r != current.r || c.g != current.g || c.b != current.b || c.a != current.a) {
+                rlColor4ub(c.r, c.g, c.b, c.a);
+                current = c;
+            }
+            rlVertex2f(batch->x[i], batch->y[i]);
+        }
+        
+        rlEnd();
+    }
+}
+
+void renderer_triangle_batch_flush(TriangleBatch* batch) {
+    if (!batch || batch->count == 0) return;
+    renderer_triangle_batch_draw_range(batch, 0, batch->count);
+    batch->count = 0;
+}
+
+void renderer_triangle_batch_clear(TriangleBatch* batch) {
+    if (!batch) return;
+    batch->count = 0;
+}
+
+// =============================================================================
+// Batched Glyph Rendering
+// =============================================================================
+
+uint32_t renderer_text_layout(Font font, const char* text, float font_size, float spacing,
+                              GlyphQuad* out_quads, uint32_t max_quads, float* out_width) {
+    if (out_width) *out_width = 0.0f;
+    if (!text || font.texture.id == 0 || !font.glyphs || !font.recs || font.baseSize <= 0) return 0;
+    
+    float scale = font_size / (float)font.baseSize;
+    float padding = (float)font.glyphPadding;
+    float inv_w = 1.0f / (float)font.texture.width;
+    float inv_h = 1.0f / (float)font.texture.height;
+    
+    uint32_t count = 0;
+    float pen_x = 0.0f;
+    float pen_y = 0.0f;
+    
+    // MeasureTextEx: widest line of unscaled advances, plus spacing per character
+    float line_width = 0.0f;
+    float widest = 0.0f;
+    int line_chars = 0;
+    int widest_chars = 0;
+    
+    for (int i = 0; text[i] != '\0';) {
+        int bytes = 0;
+        int codepoint = GetCodepointNext(&text[i], &bytes);
+        int index = GetGlyphIndex(font, codepoint);
+        i += bytes;
+        
+        if (codepoint == '\n') {
+            pen_x = 0.0f;
+            pen_y += font_size + RENDERER_TEXT_LINE_SPACING;
+            if (line_width > widest) widest = line_width;
+            line_width = 0.0f;
+            line_chars = 0;
+            continue;
+        }
+        
+        const GlyphInfo* glyph = &font.glyphs[index];
+        Rectangle rec = font.recs[index];
+        line_chars++;
+        if (line_chars > widest_chars) widest_chars = line_chars;
+        line_width += glyph->advanceX != 0 ? (float)glyph->advanceX : rec.width + (float)glyph->offsetX;
+        
+        // As DrawTextCodepoint: the padded atlas rectangle at the glyph offset
+        if (codepoint != ' ' && codepoint != '\t') {
+            if (count < max_quads && out_quads) {
+                GlyphQuad* q = &out_quads[count];
+                q->x0 = pen_x + ((float)glyph->offsetX - padding) * scale;
+                q->y0 = pen_y + ((float)glyph->offsetY - padding) * scale;
+                q->x1 = q->x0 + (rec.width + 2.0f * padding) * scale;
+                q->y1 = q->y0 + (rec.height + 2.0f * padding) * scale;
+                q->u0 = (rec.x - padding) * inv_w;
+                q->v0 = (rec.y - padding) * inv_h;
+                q->u1 = (rec.x + rec.width + padding) * inv_w;
+                q->v1 = (rec.y + rec.height + padding) * inv_h;
+            }
+            count++;
+        }
+        
+        pen_x += (glyph->advanceX != 0 ? (float)glyph->advanceX : rec.width) * scale + spacing;
+    }
+    
+    if (line_width > widest) widest = line_width;
+    if (out_width && widest_chars > 0) *out_width = widest * scale + (float)(widest_chars - 1) * spacing;
+    return count;
+}
+
+void renderer_glyph_batch_init(GlyphBatch* batch, Texture2D atlas) {
+    if (!batch) return;
+    memset(batch, 0, sizeof(GlyphBatch));
+    batch->atlas = atlas;
+}
+
+void renderer_glyph_batch_shutdown(GlyphBatch* batch) {
+    if (!batch) return;
+    free(batch->quads);
+    free(batch->colors);
+    memset(batch, 0, sizeof(GlyphBatch));
+}
+
+bool renderer_glyph_batch_add(GlyphBatch* batch, const GlyphQuad* quads, uint32_t count,
+                              float x, float y, Color color) {
+    if (!batch || !quads || count == 0) return false;
+    
+    if (batch->count + count > batch->capacity) {
+        uint32_t capacity = batch->capacity ? batch->capacity : GLYPH_BATCH_MIN_CAPACITY;
+        while (capacity < batch->count + count) capacity *= 2;
+        
+        GlyphQuad* grown = (GlyphQuad*)realloc(batch->quads, capacity * sizeof(GlyphQuad));
+        if (grown) batch->quads = grown;
+        Color* colors = (Color*)realloc(batch->colors, capacity * sizeof(Color));
+        if (colors) batch->colors = colors;
+        if (!grown || !colors) return false;
+        batch->capacity = capacity;
+    }
+    
+    GlyphQuad* out = &batch->quads[batch->count];
+    for (uint32_t i = 0; i < count; i++) {
+        out[i] = quads[i];
+        out[i].x0 += x;
+        out[i].x1 += x;
+        out[i].y0 += y;
+        out[i].y1 += y;
+        batch->colors[batch->count + i] = color;
+    }
+    batch->count += count;
+    return true;
+}
+
+void renderer_glyph_batch_flush(GlyphBatch* batch) {
+    if (!batch || batch->count == 0) return;
+    
+    // One texture for every quad; rlgl only splits when its buffer fills
+    rlSetTexture(batch->atlas.id);
+    for (uint32_t start = 0; start < batch->count; start += GLYPH_BATCH_FLUSH_CHUNK) {
+        uint32_t end = start + GLYPH_BATCH_FLUSH_CHUNK;
+        if (end > batch->count) end = batch->count;
+        
+        rlCheckRenderBatchLimit((int)(end - start) * 4);
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (uint32_t i = start; i < end; i++) {
+            const GlyphQuad* q = &batch->quads[i];
+            Color c = batch->colors[i];
+            rlColor4ub(c.r, c.g, c.b, c.a);
+            
+            // As DrawTexturePro: top-left, bottom-left, bottom-right, top-right
+            rlTexCoord2f(q->u0, q->v0);
+            rlVertex2f(q->x0, q->y0);
+            rlTexCoord2f(q->u0, q->v1);
+            rlVertex2f(q->x0, q->y1);
+            rlTexCoord2f(q->u1, q->v1);
+            rlVertex2f(q->x1, q->y1);
+            rlTexCoord2f(q->u1, q->v0);
+            rlVertex2f(q->x1, q->y0);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+    
+    batch->count = 0;
+}
+
+void renderer_glyph_batch_clear(GlyphBatch* batch) {
+    if (!batch) return;
+    batch->count = 0;
+}
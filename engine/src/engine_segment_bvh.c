@@ -0,0 +1,531 @@
+#include "engine_segment_bvh.h"
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static inline float min_f(float a, float b) { return a < b ? a : b; }
+static inline float max_f(float a, float b) { return a > b ? a : b; }
+
+// Reciprocal for slab tests; an axis-parallel ray gets a huge finite value so
+// no 0 * inf NaN can appear
+static inline float slab_inverse(float d) {
+    return d != 0.0f ? 1.0f / d : 1e30f;
+}
+
+// Parameter where a ray enters a node's box (FLT_MAX = never)
+static inline float ray_box_entry(const SegmentBvhNode* n, float ox, float oy,
+                                  float inv_dx, float inv_dy) {
+    float tx0 = (n->min_x - ox) * inv_dx;
+    float tx1 = (n->max_x - ox) * inv_dx;
+    float ty0 = (n->min_y - oy) * inv_dy;
+    float ty1 = (n->max_y - oy) * inv_dy;
+    float entry = max_f(max_f(min_f(tx0, tx1), min_f(ty0, ty1)), 0.0f);
+    float exit = min_f(max_f(tx0, tx1), max_f(ty0, ty1));
+    return entry <= exit ? entry : FLT_MAX;
+}
+
+// Squared distance from a point to a node's box
+static inline float point_box_distance_sq(const SegmentBvhNode* n, float x, float y) {
+    float dx = max_f(max_f(n->min_x - x, x - n->max_x), 0.0f);
+    float dy = max_f(max_f(n->min_y - y, y - n->max_y), 0.0f);
+    return dx * dx + dy * dy;
+}
+
+static inline bool box_overlaps(const SegmentBvhNode* n, float min_x, float min_y,
+                                float max_x, float max_y) {
+    return n->min_x <= max_x && n->max_x >= min_x && n->min_y <= max_y && n->max_y >= min_y;
+}
+
+// Parameters where o + t * d meets segment s (t along d, u along the segment).
+// Returns false for parallel segments.
+static inline bool intersect_segment(const SegmentBvh* bvh, uint32_t s, float ox, float oy,
+                                     float dx, float dy, float* out_t, float* out_u) {
+    float ex = bvh->x1[s] - bvh->x0[s];
+    float ey = bvh->y1[s] - bvh->y0[s];
+    float denom = dx * ey - dy * ex;
+    if (denom == 0.0f) return false;
+    float wx = bvh->x0[s] - ox;
+    float wy = bvh->y0[s] - oy;
+    float inv = 1.0f / denom;
+    *out_t = (wx * ey - wy * ex) * inv;
+    *out_u = (wx * dy - wy * dx) * inv;
+    return true;
+}
+
+static inline bool crosses(const SegmentBvh* bvh, uint32_t s, float ox, float oy, float dx, float dy) {
+    float t, u;
+    return intersect_segment(bvh, s, ox, oy, dx, dy, &t, &u) &&
+           t >= 0.0f && t <= 1.0f && u >= 0.0f && u <= 1.0f;
+}
+
+// Unit normal of segment s facing against (dx, dy)
+static inline void facing_normal(const SegmentBvh* bvh, uint32_t s, float dx, float dy,
+                                 float* out_x, float* out_y) {
+    float nx = -(bvh->y1[s] - bvh->y0[s]);
+    float ny = bvh->x1[s] - bvh->x0[s];
+    float len = sqrtf(nx * nx + ny * ny);
+    if (len > 0.0f) {
+        nx /= len;
+        ny /= len;
+    }
+    if (nx * dx + ny * dy > 0.0f) {
+        nx = -nx;
+        ny = -ny;
+    }
+    *out_x = nx;
+    *out_y = ny;
+}
+
+static inline void clear_hit(SegmentBvhHit* hit) {
+    memset(hit, 0, sizeof(SegmentBvhHit));
+    hit->segment = SEGMENT_BVH_NO_HIT;
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+void segment_bvh_init(SegmentBvh* bvh) {
+    if (!bvh) return;
+    memset(bvh, 0, sizeof(SegmentBvh));
+}
+
+void segment_bvh_shutdown(SegmentBvh* bvh) {
+    if (!bvh) return;
+    free(bvh->nodes);
+    free(bvh->x0);
+    free(bvh->y0);
+    free(bvh->x1);
+    free(bvh->y1);
+    free(bvh->tag);
+    memset(bvh, 0, sizeof(SegmentBvh));
+}
+
+// =============================================================================
+// Build
+// =============================================================================
+
+typedef struct BvhBuild {
+    SegmentBvh* bvh;
+    const float* x0;
+    const float* y0;
+    const float* x1;
+    const float* y1;
+    uint32_t* order;                // Input indices, partitioned in place
+    float* centroid;                // x, y per input segment
+} BvhBuild;
+
+// Reorder order[begin, end) so the element at mid has the median key on axis
+static void select_median(const BvhBuild* b, int axis, int32_t begin, int32_t end, int32_t mid) {
+    uint32_t* order = b->order;
+    const float* c = b->centroid;
+    while (end - begin > 1) {
+        float pivot = c[order[begin + (end - begin) / 2] * 2 + axis];
+        int32_t i = begin;
+        int32_t j = end - 1;
+        while (i <= j) {
+            while (c[order[i] * 2 + axis] < pivot) i++;
+            while (c[order[j] * 2 + axis] > pivot) j--;
+            if (i <= j) {
+                uint32_t swap = order[i];
+                order[i] = order[j];
+                order[j] = swap;
+                i++;
+                j--;
+            }
+        }
+        // [begin, j] <= pivot <= [i, end)
+        if (mid <= j) end = j + 1;
+        else if (mid >= i) begin = i;
+        else return;
+    }
+}
+
+static void build_node(BvhBuild* b, uint32_t node_index, uint32_t begin, uint32_t end, uint32_t depth) {
+    SegmentBvh* bvh = b->bvh;
+    SegmentBvhNode* node = &bvh->nodes[node_index];
+    if (depth > bvh->depth) bvh->depth = depth;
+
+    node->min_x = FLT_MAX;
+    node->min_y = FLT_MAX;
+    node->max_x = -FLT_MAX;
+    node->max_y = -FLT_MAX;
+    float cmin_x = FLT_MAX, cmin_y = FLT_MAX, cmax_x = -FLT_MAX, cmax_y = -FLT_MAX;
+    for (uint32_t k = begin; k < end; k++) {
+        uint32_t s = b->order[k];
+        node->min_x = min_f(node->min_x, min_f(b->x0[s], b->x1[s]));
+        node->min_y = min_f(node->min_y, min_f(b->y0[s], b->y1[s]));
+        node->max_x = max_f(node->max_x, max_f(b->x0[s], b->x1[s]));
+        node->max_y = max_f(node->max_y, max_f(b->y0[s], b->y1[s]));
+        cmin_x = min_f(cmin_x, b->centroid[s * 2]);
+        cmin_y = min_f(cmin_y, b->centroid[s * 2 + 1]);
+        cmax_x = max_f(cmax_x, b->centroid[s * 2]);
+        cmax_y = max_f(cmax_y, b->centroid[s * 2 + 1]);
+    }
+
+    if (end - begin <= SEGMENT_BVH_LEAF_SIZE) {
+        node->first = begin;
+        node->count = end - begin;
+        return;
+    }
+
+    // Median split on the longer side of the centroid bounds halves the
+    // segments every level, which bounds the depth
+    int axis = (cmax_y - cmin_y) > (cmax_x - cmin_x) ? 1 : 0;
+    uint32_t mid = begin + (end - begin) / 2;
+    select_median(b, axis, (int32_t)begin, (int32_t)end, (int32_t)mid);
+
+    uint32_t children = bvh->node_count;
+    bvh->node_count += 2;
+    node->first = children;
+    node->count = 0;
+    build_node(b, children, begin, mid, depth + 1);
+    build_node(b, children + 1, mid, end, depth + 1);
+}
+
+bool segment_bvh_build(SegmentBvh* bvh, const float* x0, const float* y0,
+                       const float* x1, const float* y1, const uint32_t* tags, uint32_t count) {
+    if (!bvh) return false;
+    segment_bvh_shutdown(bvh);
+    if (count == 0 || !x0 || !y0 || !x1 || !y1) return true;
+
+    // A binary tree with leaves of at least one segment has under 2n nodes
+    bvh->nodes = (SegmentBvhNode*)malloc((size_t)count * 2 * sizeof(SegmentBvhNode));
+    bvh->x0 = (float*)malloc(count * sizeof(float));
+    bvh->y0 = (float*)malloc(count * sizeof(float));
+    bvh->x1 = (float*)malloc(count * sizeof(float));
+    bvh->y1 = (float*)malloc(count * sizeof(float));
+    bvh->tag = (uint32_t*)malloc(count * sizeof(uint32_t));
+    uint32_t* order = (uint32_t*)malloc(count * sizeof(uint32_t));
+    float* centroid = (float*)malloc((size_t)count * 2 * sizeof(float));
+    if (!bvh->nodes || !bvh->x0 || !bvh->y0 || !bvh->x1 || !bvh->y1 || !bvh->tag || !order || !centroid) {
+        free(order);
+        free(centroid);
+        segment_bvh_shutdown(bvh);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        order[i] = i;
+        centroid[i * 2] = (x0[i] + x1[i]) * 0.5f;
+        centroid[i * 2 + 1] = (y0[i] + y1[i]) * 0.5f;
+    }
+
+    BvhBuild b = { bvh, x0, y0, x1, y1, order, centroid };
+    bvh->node_count = 1;
+    build_node(&b, 0, 0, count, 0);
+
+    // Copy segments out in leaf order
+    for (uint32_t k = 0; k < count; k++) {
+        uint32_t s = order[k];
+        bvh->x0[k] = x0[s];
+        bvh->y0[k] = y0[s];
+        bvh->x1[k] = x1[s];
+        bvh->y1[k] = y1[s];
+        bvh->tag[k] = tags ? tags[s] : s;
+    }
+    bvh->segment_count = count;
+
+    free(order);
+    free(centroid);
+    return true;
+}
+
+// =============================================================================
+// Single Queries
+// =============================================================================
+
+static bool raycast(const SegmentBvh* bvh, float ox, float oy, float dx, float dy,
+                    float max_t, SegmentBvhHit* out_hit) {
+    clear_hit(out_hit);
+    if (bvh->node_count == 0) return false;
+
+    float inv_dx = slab_inverse(dx);
+    float inv_dy = slab_inverse(dy);
+    float best = max_t;
+    uint32_t best_segment = SEGMENT_BVH_NO_HIT;
+
+    // Nearer child first; entries are re-checked against the closest hit
+    uint32_t stack[SEGMENT_BVH_STACK_SIZE];
+    float stack_entry[SEGMENT_BVH_STACK_SIZE];
+    uint32_t top = 0;
+    float root_entry = ray_box_entry(&bvh->nodes[0], ox, oy, inv_dx, inv_dy);
+    if (root_entry > max_t) return false;
+    stack[top] = 0;
+    stack_entry[top++] = root_entry;
+
+    while (top > 0) {
+        top--;
+        if (stack_entry[top] > best) continue;
+        const SegmentBvhNode* node = &bvh->nodes[stack[top]];
+
+        if (node->count > 0) {
+            for (uint32_t s = node->first; s < node->first + node->count; s++) {
+                float t, u;
+                if (!intersect_segment(bvh, s, ox, oy, dx, dy, &t, &u)) continue;
+                if (t < 0.0f || t > best || u < 0.0f || u > 1.0f) continue;
+                best = t;
+                best_segment = s;
+            }
+            continue;
+        }
+
+        uint32_t first = node->first, second = node->first + 1;
+        float first_entry = ray_box_entry(&bvh->nodes[first], ox, oy, inv_dx, inv_dy);
+        float second_entry = ray_box_entry(&bvh->nodes[second], ox, oy, inv_dx, inv_dy);
+        if (second_entry < first_entry) {
+            uint32_t swap = first;
+            first = second;
+            second = swap;
+            float swap_entry = first_entry;
+            first_entry = second_entry;
+            second_entry = swap_entry;
+        }
+        if (second_entry <= best) {
+            stack[top] = second;
+            stack_entry[top++] = second_entry;
+        }
+        if (first_entry <= best) {
+            stack[top] = first;
+            stack_entry[top++] = first_entry;
+        }
+    }
+
+    if (best_segment == SEGMENT_BVH_NO_HIT) return false;
+    out_hit->segment = best_segment;
+    out_hit->tag = bvh->tag[best_segment];
+    out_hit->t = best;
+    out_hit->x = ox + dx * best;
+    out_hit->y = oy + dy * best;
+    facing_normal(bvh, best_segment, dx, dy, &out_hit->normal_x, &out_hit->normal_y);
+    return true;
+}
+
+bool segment_bvh_raycast(const SegmentBvh* bvh, float ox, float oy, float dx, float dy,
+                         float max_t, SegmentBvhHit* out_hit) {
+    if (!bvh || !out_hit) return false;
+    return raycast(bvh, ox, oy, dx, dy, max_t, out_hit);
+}
+
+static uint32_t crossings(const SegmentBvh* bvh, float x0, float y0, float x1, float y1,
+                          uint32_t max_crossings) {
+    if (bvh->node_count == 0 || max_crossings == 0) return 0;
+
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float min_x = min_f(x0, x1), max_x = max_f(x0, x1);
+    float min_y = min_f(y0, y1), max_y = max_f(y0, y1);
+    uint32_t found = 0;
+
+    uint32_t stack[SEGMENT_BVH_STACK_SIZE];
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const SegmentBvhNode* node = &bvh->nodes[stack[--top]];
+        if (!box_overlaps(node, min_x, min_y, max_x, max_y)) continue;
+
+        if (node->count > 0) {
+            for (uint32_t s = node->first; s < node->first + node->count; s++) {
+                if (!crosses(bvh, s, x0, y0, dx, dy)) continue;
+                if (++found >= max_crossings) return found;
+            }
+            continue;
+        }
+        stack[top++] = node->first;
+        stack[top++] = node->first + 1;
+    }
+    return found;
+}
+
+uint32_t segment_bvh_crossings(const SegmentBvh* bvh, float x0, float y0, float x1, float y1,
+                               uint32_t max_crossings) {
+    if (!bvh) return 0;
+    return crossings(bvh, x0, y0, x1, y1, max_crossings);
+}
+
+static bool circle(const SegmentBvh* bvh, float cx, float cy, float radius, SegmentBvhHit* out_hit) {
+    clear_hit(out_hit);
+    if (bvh->node_count == 0 || radius <= 0.0f) return false;
+
+    float best_sq = radius * radius;
+    uint32_t best_segment = SEGMENT_BVH_NO_HIT;
+    float best_x = 0.0f, best_y = 0.0f;
+
+    uint32_t stack[SEGMENT_BVH_STACK_SIZE];
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const SegmentBvhNode* node = &bvh->nodes[stack[--top]];
+        if (point_box_distance_sq(node, cx, cy) > best_sq) continue;
+
+        if (node->count > 0) {
+            for (uint32_t s = node->first; s < node->first + node->count; s++) {
+                float ex = bvh->x1[s] - bvh->x0[s];
+                float ey = bvh->y1[s] - bvh->y0[s];
+                float len_sq = ex * ex + ey * ey;
+                float u = len_sq > 0.0f ? ((cx - bvh->x0[s]) * ex + (cy - bvh->y0[s]) * ey) / len_sq : 0.0f;
+                u = min_f(max_f(u, 0.0f), 1.0f);
+                float px = bvh->x0[s] + ex * u;
+                float py = bvh->y0[s] + ey * u;
+                float dist_sq = (cx - px) * (cx - px) + (cy - py) * (cy - py);
+                if (dist_sq < best_sq) {
+                    best_sq = dist_sq;
+                    best_segment = s;
+                    best_x = px;
+                    best_y = py;
+                }
+            }
+            continue;
+        }
+
+        // Nearer child on top
+        uint32_t first = node->first, second = node->first + 1;
+        if (point_box_distance_sq(&bvh->nodes[second], cx, cy) < point_box_distance_sq(&bvh->nodes[first], cx, cy)) {
+            first = second;
+            second = node->first;
+        }
+        stack[top++] = second;
+        stack[top++] = first;
+    }
+
+    if (best_segment == SEGMENT_BVH_NO_HIT) return false;
+    float dist = sqrtf(best_sq);
+    out_hit->segment = best_segment;
+    out_hit->tag = bvh->tag[best_segment];
+    out_hit->t = dist;
+    out_hit->x = best_x;
+    out_hit->y = best_y;
+    if (dist > 0.0f) {
+        out_hit->normal_x = (cx - best_x) / dist;
+        out_hit->normal_y = (cy - best_y) / dist;
+    } else {
+        facing_normal(bvh, best_segment, 0.0f, 0.0f, &out_hit->normal_x, &out_hit->normal_y);
+    }
+    return true;
+}
+
+bool segment_bvh_circle(const SegmentBvh* bvh, float cx, float cy, float radius,
+                        SegmentBvhHit* out_hit) {
+    if (!bvh || !out_hit) return false;
+    return circle(bvh, cx, cy, radius, out_hit);
+}
+
+bool segment_bvh_point_inside(const SegmentBvh* bvh, float x, float y) {
+    if (!bvh || bvh->node_count == 0) return false;
+
+    // Count edges crossing the ray towards +x (half-open in y so a ray
+    // through a vertex counts once)
+    bool inside = false;
+    uint32_t stack[SEGMENT_BVH_STACK_SIZE];
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const SegmentBvhNode* node = &bvh->nodes[stack[--top]];
+        if (node->max_x < x || y < node->min_y || y > node->max_y) continue;
+
+        if (node->count > 0) {
+            for (uint32_t s = node->first; s < node->first + node->count; s++) {
+                float ya = bvh->y0[s], yb = bvh->y1[s];
+                if ((ya > y) == (yb > y)) continue;
+                float xi = bvh->x0[s] + (y - ya) * (bvh->x1[s] - bvh->x0[s]) / (yb - ya);
+                if (xi > x) inside = !inside;
+            }
+            continue;
+        }
+        stack[top++] = node->first;
+        stack[top++] = node->first + 1;
+    }
+    return inside;
+}
+
+// =============================================================================
+// Batch Queries
+// =============================================================================
+
+uint32_t segment_bvh_raycast_batch(const SegmentBvh* bvh, const float* ox, const float* oy,
+                                   const float* dx, const float* dy, float max_t,
+                                   uint32_t count, SegmentBvhHit* out_hits) {
+    if (!bvh || !out_hits) return 0;
+    uint32_t hits = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (raycast(bvh, ox[i], oy[i], dx[i], dy[i], max_t, &out_hits[i])) hits++;
+    }
+    return hits;
+}
+
+uint32_t segment_bvh_circle_batch(const SegmentBvh* bvh, const float* cx, const float* cy,
+                                  const float* radius, uint32_t count, SegmentBvhHit* out_hits) {
+    if (!bvh || !out_hits) return 0;
+    uint32_t hits = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (circle(bvh, cx[i], cy[i], radius[i], &out_hits[i])) hits++;
+    }
+    return hits;
+}
+
+void segment_bvh_fan_crossings(const SegmentBvh* bvh, float eye_x, float eye_y,
+                               const float* target_x, const float* target_y, uint32_t count,
+                               uint32_t max_crossings, uint8_t* out_crossings) {
+    if (!out_crossings) return;
+    memset(out_crossings, 0, count);
+    if (!bvh || bvh->node_count == 0 || count == 0 || max_crossings == 0) return;
+    if (max_crossings > 255) max_crossings = 255;
+
+    // Box around the eye and every target
+    float min_x = eye_x, max_x = eye_x, min_y = eye_y, max_y = eye_y;
+    for (uint32_t i = 0; i < count; i++) {
+        min_x = min_f(min_x, target_x[i]);
+        max_x = max_f(max_x, target_x[i]);
+        min_y = min_f(min_y, target_y[i]);
+        max_y = max_f(max_y, target_y[i]);
+    }
+
+    // Gather the segments in it with one walk
+    uint32_t gathered[SEGMENT_BVH_FAN_SEGMENTS];
+    uint32_t gathered_count = 0;
+    bool overflow = false;
+    uint32_t stack[SEGMENT_BVH_STACK_SIZE];
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while (top > 0 && !overflow) {
+        const SegmentBvhNode* node = &bvh->nodes[stack[--top]];
+        if (!box_overlaps(node, min_x, min_y, max_x, max_y)) continue;
+
+        if (node->count > 0) {
+            if (gathered_count + node->count > SEGMENT_BVH_FAN_SEGMENTS) {
+                overflow = true;
+                break;
+            }
+            for (uint32_t s = node->first; s < node->first + node->count; s++) {
+                gathered[gathered_count++] = s;
+            }
+            continue;
+        }
+        stack[top++] = node->first;
+        stack[top++] = node->first + 1;
+    }
+
+    // Too much geometry nearby to share: walk the tree per target
+    if (overflow) {
+        for (uint32_t i = 0; i < count; i++) {
+            out_crossings[i] = (uint8_t)crossings(bvh, eye_x, eye_y, target_x[i], target_y[i], max_crossings);
+        }
+        return;
+    }
+    if (gathered_count == 0) return;
+
+    for (uint32_t i = 0; i < count; i++) {
+        float dx = target_x[i] - eye_x;
+        float dy = target_y[i] - eye_y;
+        uint32_t found = 0;
+        for (uint32_t k = 0; k < gathered_count && found < max_crossings; k++) {
+            if (crosses(bvh, gathered[k], eye_x, eye_y, dx, dy)) found++;
+        }
+        out_crossings[i] = (uint8_t)found;
+    }
+}
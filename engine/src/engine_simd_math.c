@@ -0,0 +1,134 @@
+#include "engine_simd_math.h"
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+#define SIMD_BATCH 8
+
+// Copy the last count % 8 inputs into a full block, padded with a value
+// every function accepts (1.0)
+static inline uint32_t load_tail(float* block, const float* src, uint32_t begin, uint32_t count) {
+    uint32_t n = count - begin;
+    for (uint32_t l = 0; l < SIMD_BATCH; l++) {
+        block[l] = l < n ? src[begin + l] : 1.0f;
+    }
+    return n;
+}
+
+static inline void store_tail(float* dst, const float* block, uint32_t begin, uint32_t n) {
+    for (uint32_t l = 0; l < n; l++) {
+        dst[begin + l] = block[l];
+    }
+}
+
+// =============================================================================
+// Unary Batches
+// =============================================================================
+
+#define SIMD_UNARY_BATCH(name, op) \
+    void name(const float* x, float* out, uint32_t count) { \
+        if (!x || !out) return; \
+        uint32_t i = 0; \
+        for (; i + SIMD_BATCH <= count; i += SIMD_BATCH) { \
+            simd8_store(&out[i], op(simd8_load(&x[i]))); \
+        } \
+        if (i < count) { \
+            float block[SIMD_BATCH]; \
+            uint32_t n = load_tail(block, x, i, count); \
+            simd8_store(block, op(simd8_load(block))); \
+            store_tail(out, block, i, n); \
+        } \
+    }
+
+SIMD_UNARY_BATCH(simd_exp2_batch, simd8_exp2)
+SIMD_UNARY_BATCH(simd_log2_batch, simd8_log2)
+SIMD_UNARY_BATCH(simd_sqrt_batch, simd8_sqrt)
+SIMD_UNARY_BATCH(simd_rsqrt_batch, simd8_rsqrt)
+
+#undef SIMD_UNARY_BATCH
+
+// =============================================================================
+// Sin/Cos Batches
+// =============================================================================
+
+#define SIMD_SINCOS_BATCH(name, op) \
+    void name(const float* angles, float* out_sin, float* out_cos, uint32_t count) { \
+        if (!angles || !out_sin || !out_cos) return; \
+        simd8f s, c; \
+        uint32_t i = 0; \
+        for (; i + SIMD_BATCH <= count; i += SIMD_BATCH) { \
+            op(simd8_load(&angles[i]), &s, &c); \
+            simd8_store(&out_sin[i], s); \
+            simd8_store(&out_cos[i], c); \
+        } \
+        if (i < count) { \
+            float block[SIMD_BATCH]; \
+            uint32_t n = load_tail(block, angles, i, count); \
+            op(simd8_load(block), &s, &c); \
+            simd8_store(block, s); \
+            store_tail(out_sin, block, i, n); \
+            simd8_store(block, c); \
+            store_tail(out_cos, block, i, n); \
+        } \
+    }
+
+SIMD_SINCOS_BATCH(simd_sincos_batch, simd8_sincos)
+SIMD_SINCOS_BATCH(simd_sincos_deg_batch, simd8_sincos_deg)
+
+#undef SIMD_SINCOS_BATCH
+
+// =============================================================================
+// Binary Batches
+// =============================================================================
+
+void simd_pow_batch(const float* x, const float* y, float* out, uint32_t count) {
+    if (!x || !y || !out) return;
+
+    uint32_t i = 0;
+    for (; i + SIMD_BATCH <= count; i += SIMD_BATCH) {
+        simd8_store(&out[i], simd8_pow(simd8_load(&x[i]), simd8_load(&y[i])));
+    }
+    if (i < count) {
+        float bx[SIMD_BATCH], by[SIMD_BATCH];
+        uint32_t n = load_tail(bx, x, i, count);
+        load_tail(by, y, i, count);
+        simd8_store(bx, simd8_pow(simd8_load(bx), simd8_load(by)));
+        store_tail(out, bx, i, n);
+    }
+}
+
+void simd_atan2_batch(const float* y, const float* x, float* out, uint32_t count) {
+    if (!y || !x || !out) return;
+
+    uint32_t i = 0;
+    for (; i + SIMD_BATCH <= count; i += SIMD_BATCH) {
+        simd8_store(&out[i], simd8_atan2(simd8_load(&y[i]), simd8_load(&x[i])));
+    }
+    if (i < count) {
+        float by[SIMD_BATCH], bx[SIMD_BATCH];
+        uint32_t n = load_tail(by, y, i, count);
+        load_tail(bx, x, i, count);
+        simd8_store(by, simd8_atan2(simd8_load(by), simd8_load(bx)));
+        store_tail(out, by, i, n);
+    }
+}
+
+void simd_distance_sq_batch(const float* xs, const float* ys, float px, float py,
+                            float* out, uint32_t count) {
+    if (!xs || !ys || !out) return;
+
+    simd8f x0 = simd8_set(px);
+    simd8f y0 = simd8_set(py);
+    uint32_t i = 0;
+    for (; i + SIMD_BATCH <= count; i += SIMD_BATCH) {
+        simd8_store(&out[i], simd8_distance_sq(x0, y0, simd8_load(&xs[i]), simd8_load(&ys[i])));
+    }
+    if (i < count) {
+        float bx[SIMD_BATCH], by[SIMD_BATCH];
+        uint32_t n = load_tail(bx, xs, i, count);
+        load_tail(by, ys, i, count);
+        simd8_store(bx, simd8_distance_sq(x0, y0, simd8_load(bx), simd8_load(by)));
+        store_tail(out, bx, i, n);
+    }
+}
@@ -0,0 +1,168 @@
+#include "engine_spatial_grid.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static inline int32_t clamp_cell(int32_t c, int32_t max_c) {
+    if (c < 0) return 0;
+    if (c > max_c) return max_c;
+    return c;
+}
+
+static bool ensure_capacity(SpatialGrid* grid, uint32_t cells, uint32_t items) {
+    if (cells > grid->cell_capacity) {
+        uint32_t* cell_start = (uint32_t*)realloc(grid->cell_start, (cells + 1) * sizeof(uint32_t));
+        if (!cell_start) return false;
+        grid->cell_start = cell_start;
+        grid->cell_capacity = cells;
+    }
+    if (items > grid->item_capacity) {
+        uint32_t* new_items = (uint32_t*)realloc(grid->items, items * sizeof(uint32_t));
+        if (!new_items) return false;
+        grid->items = new_items;
+        grid->item_capacity = items;
+    }
+    return true;
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+void spatial_grid_init(SpatialGrid* grid) {
+    if (!grid) return;
+    memset(grid, 0, sizeof(SpatialGrid));
+}
+
+void spatial_grid_shutdown(SpatialGrid* grid) {
+    if (!grid) return;
+    free(grid->cell_start);
+    free(grid->items);
+    memset(grid, 0, sizeof(SpatialGrid));
+}
+
+void spatial_grid_clear(SpatialGrid* grid) {
+    if (!grid) return;
+    grid->cols = 0;
+    grid->rows = 0;
+    grid->cell_count = 0;
+    grid->item_count = 0;
+}
+
+// =============================================================================
+// Build
+// =============================================================================
+
+bool spatial_grid_build(SpatialGrid* grid, const float* xs, const float* ys,
+                        uint32_t count, float cell_size) {
+    if (!grid) return false;
+    spatial_grid_clear(grid);
+    if (count == 0 || !xs || !ys) return true;
+    if (cell_size <= 0.0f) cell_size = 1.0f;
+
+    // Bounds of all points
+    float min_x = xs[0], max_x = xs[0];
+    float min_y = ys[0], max_y = ys[0];
+    for (uint32_t i = 1; i < count; i++) {
+        if (xs[i] < min_x) min_x = xs[i];
+        if (xs[i] > max_x) max_x = xs[i];
+        if (ys[i] < min_y) min_y = ys[i];
+        if (ys[i] > max_y) max_y = ys[i];
+    }
+
+    // Grow cell size until the cell budget fits (sparse, wide datasets)
+    uint32_t max_cells = count * SPATIAL_GRID_MAX_CELLS_PER_ITEM;
+    if (max_cells < SPATIAL_GRID_MIN_CELLS) max_cells = SPATIAL_GRID_MIN_CELLS;
+    while ((floorf((max_x - min_x) / cell_size) + 1.0f) *
+           (floorf((max_y - min_y) / cell_size) + 1.0f) > (float)max_cells) {
+        cell_size *= 2.0f;
+    }
+    int32_t cols = (int32_t)((max_x - min_x) / cell_size) + 1;
+    int32_t rows = (int32_t)((max_y - min_y) / cell_size) + 1;
+
+    uint32_t cell_count = (uint32_t)(cols * rows);
+    if (!ensure_capacity(grid, cell_count, count)) return false;
+
+    grid->origin_x = min_x;
+    grid->origin_y = min_y;
+    grid->cell_size = cell_size;
+    grid->inv_cell_size = 1.0f / cell_size;
+    grid->cols = cols;
+    grid->rows = rows;
+    grid->cell_count = cell_count;
+    grid->item_count = count;
+
+    // Counting sort: histogram, exclusive prefix sum, scatter
+    uint32_t* cell_start = grid->cell_start;
+    memset(cell_start, 0, (cell_count + 1) * sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t cx = clamp_cell((int32_t)((xs[i] - min_x) * grid->inv_cell_size), cols - 1);
+        int32_t cy = clamp_cell((int32_t)((ys[i] - min_y) * grid->inv_cell_size), rows - 1);
+        cell_start[cy * cols + cx + 1]++;
+    }
+    for (uint32_t c = 0; c < cell_count; c++) {
+        cell_start[c + 1] += cell_start[c];
+    }
+
+    // Scatter in index order so each cell stays sorted; cell_start[c] is used
+    // as the write cursor and restored afterwards by shifting
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t cx = clamp_cell((int32_t)((xs[i] - min_x) * grid->inv_cell_size), cols - 1);
+        int32_t cy = clamp_cell((int32_t)((ys[i] - min_y) * grid->inv_cell_size), rows - 1);
+        grid->items[cell_start[cy * cols + cx]++] = i;
+    }
+    for (uint32_t c = cell_count; c > 0; c--) {
+        cell_start[c] = cell_start[c - 1];
+    }
+    cell_start[0] = 0;
+
+    return true;
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+bool spatial_grid_get_span(const SpatialGrid* grid, float min_x, float min_y,
+                           float max_x, float max_y, SpatialGridSpan* out_span) {
+    if (!grid || !out_span || grid->item_count == 0) return false;
+
+    // Truncation only ever sees non-negative values below, where it floors
+    float fx0 = (min_x - grid->origin_x) * grid->inv_cell_size;
+    float fy0 = (min_y - grid->origin_y) * grid->inv_cell_size;
+    float fx1 = (max_x - grid->origin_x) * grid->inv_cell_size;
+    float fy1 = (max_y - grid->origin_y) * grid->inv_cell_size;
+
+    // Reject before converting to int so huge ranges cannot overflow
+    if (fx1 < 0.0f || fy1 < 0.0f) return false;
+    if (fx0 >= (float)grid->cols || fy0 >= (float)grid->rows) return false;
+
+    out_span->min_cx = fx0 < 0.0f ? 0 : (int32_t)fx0;
+    out_span->min_cy = fy0 < 0.0f ? 0 : (int32_t)fy0;
+    out_span->max_cx = fx1 >= (float)grid->cols ? grid->cols - 1 : (int32_t)fx1;
+    out_span->max_cy = fy1 >= (float)grid->rows ? grid->rows - 1 : (int32_t)fy1;
+    return true;
+}
+
+uint32_t spatial_grid_query_rect(const SpatialGrid* grid, float min_x, float min_y,
+                                 float max_x, float max_y, uint32_t* out, uint32_t max_out) {
+    SpatialGridSpan span;
+    if (!spatial_grid_get_span(grid, min_x, min_y, max_x, max_y, &span)) return 0;
+
+    uint32_t total = 0;
+    for (int32_t cy = span.min_cy; cy <= span.max_cy; cy++) {
+        for (int32_t cx = span.min_cx; cx <= span.max_cx; cx++) {
+            uint32_t n;
+            const uint32_t* items = spatial_grid_cell_items(grid, cx, cy, &n);
+            for (uint32_t i = 0; i < n; i++) {
+                if (out && total < max_out) out[total] = items[i];
+                total++;
+            }
+        }
+    }
+    return total;
+}
@@ -0,0 +1,201 @@
+#include "engine_string_arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define STRING_ARENA_MIN_CAPACITY 256
+#define STRING_ARENA_MIN_SLOTS 64
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+// FNV-1a over bytes
+static inline uint32_t hash_bytes(const char* str, uint32_t len) {
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < len; i++) {
+        hash ^= (uint8_t)str[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void reset_slots(StringArenaSlot* slots, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        slots[i].hash = 0;
+        slots[i].offset = STRING_ARENA_INVALID;
+    }
+}
+
+static bool grow_data(StringArena* arena, uint32_t needed) {
+    if (arena->owns_data && arena->size + needed <= arena->capacity) return true;
+
+    uint64_t new_capacity = arena->capacity ? arena->capacity : STRING_ARENA_MIN_CAPACITY;
+    while (new_capacity < (uint64_t)arena->size + needed) new_capacity *= 2;
+    if (new_capacity > 0xFFFFFFFEu) return false;  // Offsets must fit in 32 bits
+
+    char* data;
+    if (arena->owns_data) {
+        data = (char*)realloc(arena->data, (size_t)new_capacity);
+        if (!data) return false;
+    } else {
+        // Leave external memory untouched; continue in an owned copy
+        data = (char*)malloc((size_t)new_capacity);
+        if (!data) return false;
+        memcpy(data, arena->data, arena->size);
+        arena->owns_data = true;
+    }
+    arena->data = data;
+    arena->capacity = (uint32_t)new_capacity;
+    return true;
+}
+
+// Keep the intern table at most half full
+static bool grow_slots(StringArena* arena) {
+    if ((arena->string_count + 1) * 2 <= arena->slot_capacity) return true;
+
+    uint32_t new_capacity = arena->slot_capacity ? arena->slot_capacity * 2 : STRING_ARENA_MIN_SLOTS;
+    StringArenaSlot* slots = (StringArenaSlot*)malloc(new_capacity * sizeof(StringArenaSlot));
+    if (!slots) return false;
+    reset_slots(slots, new_capacity);
+
+    uint32_t mask = new_capacity - 1;
+    for (uint32_t i = 0; i < arena->slot_capacity; i++) {
+        if (arena->slots[i].offset == STRING_ARENA_INVALID) continue;
+        uint32_t idx = arena->slots[i].hash & mask;
+        while (slots[idx].offset != STRING_ARENA_INVALID) idx = (idx + 1) & mask;
+        slots[idx] = arena->slots[i];
+    }
+
+    free(arena->slots);
+    arena->slots = slots;
+    arena->slot_capacity = new_capacity;
+    return true;
+}
+
+// Re-create the intern table from the strings already in the buffer
+static bool rebuild_slots(StringArena* arena) {
+    free(arena->slots);
+    arena->slots = NULL;
+    arena->slot_capacity = 0;
+    arena->string_count = 0;
+
+    uint32_t offset = 1;
+    while (offset < arena->size) {
+        uint32_t len = (uint32_t)strlen(arena->data + offset);
+        if (!grow_slots(arena)) return false;
+
+        uint32_t hash = hash_bytes(arena->data + offset, len);
+        uint32_t mask = arena->slot_capacity - 1;
+        uint32_t idx = hash & mask;
+        while (arena->slots[idx].offset != STRING_ARENA_INVALID) idx = (idx + 1) & mask;
+        arena->slots[idx].hash = hash;
+        arena->slots[idx].offset = offset;
+        arena->string_count++;
+
+        offset += len + 1;
+    }
+    arena->slots_stale = false;
+    return true;
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+bool string_arena_init(StringArena* arena, uint32_t initial_capacity) {
+    if (!arena) return false;
+    memset(arena, 0, sizeof(StringArena));
+
+    if (initial_capacity < STRING_ARENA_MIN_CAPACITY) initial_capacity = STRING_ARENA_MIN_CAPACITY;
+    arena->data = (char*)malloc(initial_capacity);
+    if (!arena->data) return false;
+    arena->capacity = initial_capacity;
+
+    // Offset 0 is the shared empty string
+    arena->data[0] = '\0';
+    arena->size = 1;
+    arena->owns_data = true;
+    return true;
+}
+
+bool string_arena_init_external(StringArena* arena, char* data, uint32_t size) {
+    if (!arena) return false;
+    memset(arena, 0, sizeof(StringArena));
+    if (!data || size == 0 || data[0] != '\0' || data[size - 1] != '\0') return false;
+
+    arena->data = data;
+    arena->size = size;
+    arena->capacity = size;
+    arena->owns_data = false;
+    arena->slots_stale = true;
+    return true;
+}
+
+void string_arena_shutdown(StringArena* arena) {
+    if (!arena) return;
+    if (arena->owns_data) free(arena->data);
+    free(arena->slots);
+    memset(arena, 0, sizeof(StringArena));
+}
+
+void string_arena_clear(StringArena* arena) {
+    if (!arena || !arena->data) return;
+    if (!arena->owns_data) {
+        // Drop the external buffer and start over in owned memory
+        free(arena->slots);
+        string_arena_init(arena, STRING_ARENA_MIN_CAPACITY);
+        return;
+    }
+    arena->size = 1;
+    arena->string_count = 0;
+    if (arena->slots) reset_slots(arena->slots, arena->slot_capacity);
+}
+
+// =============================================================================
+// Interning
+// =============================================================================
+
+uint32_t string_arena_intern_n(StringArena* arena, const char* str, uint32_t len) {
+    if (!arena || !arena->data) return STRING_ARENA_INVALID;
+    if (!str || len == 0) return STRING_ARENA_EMPTY;
+    if (arena->slots_stale && !rebuild_slots(arena)) return STRING_ARENA_INVALID;
+
+    uint32_t hash = hash_bytes(str, len);
+
+    // Existing copy?
+    if (arena->slot_capacity > 0) {
+        uint32_t mask = arena->slot_capacity - 1;
+        uint32_t idx = hash & mask;
+        while (arena->slots[idx].offset != STRING_ARENA_INVALID) {
+            const StringArenaSlot* slot = &arena->slots[idx];
+            if (slot->hash == hash) {
+                const char* existing = arena->data + slot->offset;
+                if (memcmp(existing, str, len) == 0 && existing[len] == '\0') {
+                    return slot->offset;
+                }
+            }
+            idx = (idx + 1) & mask;
+        }
+    }
+
+    if (!grow_slots(arena) || !grow_data(arena, len + 1)) return STRING_ARENA_INVALID;
+
+    uint32_t offset = arena->size;
+    memcpy(arena->data + offset, str, len);
+    arena->data[offset + len] = '\0';
+    arena->size += len + 1;
+
+    uint32_t mask = arena->slot_capacity - 1;
+    uint32_t idx = hash & mask;
+    while (arena->slots[idx].offset != STRING_ARENA_INVALID) idx = (idx + 1) & mask;
+    arena->slots[idx].hash = hash;
+    arena->slots[idx].offset = offset;
+    arena->string_count++;
+
+    return offset;
+}
+
+uint32_t string_arena_intern(StringArena* arena, const char* str) {
+    if (!str) return arena && arena->data ? STRING_ARENA_EMPTY : STRING_ARENA_INVALID;
+    return string_arena_intern_n(arena, str, (uint32_t)strlen(str));
+}
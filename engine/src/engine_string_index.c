@@ -0,0 +1,187 @@
+#include "engine_string_index.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define STRING_INDEX_MIN_CAPACITY 16
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static inline uint8_t fold_ascii(uint8_t c) {
+    return (c >= 'A' && c <= 'Z') ? (uint8_t)(c + ('a' - 'A')) : c;
+}
+
+// FNV-1a over ASCII-lowercased bytes
+static uint32_t hash_folded(const char* str) {
+    uint32_t hash = 2166136261u;
+    for (const uint8_t* p = (const uint8_t*)str; *p; p++) {
+        hash ^= fold_ascii(*p);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool equals_folded(const char* a, const char* b) {
+    const uint8_t* pa = (const uint8_t*)a;
+    const uint8_t* pb = (const uint8_t*)b;
+    while (*pa && fold_ascii(*pa) == fold_ascii(*pb)) {
+        pa++;
+        pb++;
+    }
+    return fold_ascii(*pa) == fold_ascii(*pb);
+}
+
+static uint32_t next_power_of_2(uint32_t v) {
+    v--;
+    v |= v >> 1;
+    v |= v >> 2;
+    v |= v >> 4;
+    v |= v >> 8;
+    v |= v >> 16;
+    v++;
+    return v;
+}
+
+static void reset_entries(StringIndexEntry* entries, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        entries[i].key_offset = STRING_ARENA_INVALID;
+    }
+}
+
+// Locate the slot holding key, or UINT32_MAX
+static uint32_t find_slot(const StringIndex* index, const StringArena* arena,
+                          const char* key, uint32_t hash) {
+    uint32_t idx = hash & index->mask;
+    for (uint32_t i = 0; i < index->capacity; i++) {
+        const StringIndexEntry* entry = &index->entries[idx];
+        if (entry->key_offset == STRING_ARENA_INVALID) return UINT32_MAX;
+        if (entry->hash == hash && equals_folded(string_arena_get(arena, entry->key_offset), key)) {
+            return idx;
+        }
+        idx = (idx + 1) & index->mask;
+    }
+    return UINT32_MAX;
+}
+
+// Double capacity once the load factor passes 70%
+static bool grow(StringIndex* index) {
+    if ((index->count + 1) * 10 <= index->capacity * 7) return true;
+
+    uint32_t new_capacity = index->capacity * 2;
+    StringIndexEntry* entries = (StringIndexEntry*)malloc(new_capacity * sizeof(StringIndexEntry));
+    if (!entries) return false;
+    reset_entries(entries, new_capacity);
+
+    uint32_t mask = new_capacity - 1;
+    for (uint32_t i = 0; i < index->capacity; i++) {
+        if (index->entries[i].key_offset == STRING_ARENA_INVALID) continue;
+        uint32_t idx = index->entries[i].hash & mask;
+        while (entries[idx].key_offset != STRING_ARENA_INVALID) idx = (idx + 1) & mask;
+        entries[idx] = index->entries[i];
+    }
+
+    free(index->entries);
+    index->entries = entries;
+    index->capacity = new_capacity;
+    index->mask = mask;
+    return true;
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+bool string_index_init(StringIndex* index, uint32_t expected) {
+    if (!index) return false;
+    memset(index, 0, sizeof(StringIndex));
+
+    // Room for `expected` keys at the 70% load limit
+    uint32_t capacity = next_power_of_2(expected + expected / 2 + 1);
+    if (capacity < STRING_INDEX_MIN_CAPACITY) capacity = STRING_INDEX_MIN_CAPACITY;
+
+    index->entries = (StringIndexEntry*)malloc(capacity * sizeof(StringIndexEntry));
+    if (!index->entries) return false;
+    reset_entries(index->entries, capacity);
+
+    index->capacity = capacity;
+    index->mask = capacity - 1;
+    return true;
+}
+
+void string_index_shutdown(StringIndex* index) {
+    if (!index) return;
+    free(index->entries);
+    memset(index, 0, sizeof(StringIndex));
+}
+
+void string_index_clear(StringIndex* index) {
+    if (!index || !index->entries) return;
+    reset_entries(index->entries, index->capacity);
+    index->count = 0;
+}
+
+// =============================================================================
+// Operations
+// =============================================================================
+
+bool string_index_insert(StringIndex* index, const StringArena* arena,
+                         uint32_t key_offset, uint32_t value) {
+    if (!index || !index->entries || !arena) return false;
+
+    const char* key = string_arena_get(arena, key_offset);
+    uint32_t hash = hash_folded(key);
+    if (find_slot(index, arena, key, hash) != UINT32_MAX) return false;
+    if (!grow(index)) return false;
+
+    uint32_t idx = hash & index->mask;
+    while (index->entries[idx].key_offset != STRING_ARENA_INVALID) {
+        idx = (idx + 1) & index->mask;
+    }
+    index->entries[idx].hash = hash;
+    index->entries[idx].key_offset = key_offset;
+    index->entries[idx].value = value;
+    index->count++;
+    return true;
+}
+
+bool string_index_set(StringIndex* index, const StringArena* arena, const char* key, uint32_t value) {
+    if (!index || !index->entries || !arena || !key) return false;
+
+    uint32_t slot = find_slot(index, arena, key, hash_folded(key));
+    if (slot == UINT32_MAX) return false;
+    index->entries[slot].value = value;
+    return true;
+}
+
+uint32_t string_index_find(const StringIndex* index, const StringArena* arena, const char* key) {
+    if (!index || !index->entries || !arena || !key) return STRING_INDEX_NOT_FOUND;
+
+    uint32_t slot = find_slot(index, arena, key, hash_folded(key));
+    return slot == UINT32_MAX ? STRING_INDEX_NOT_FOUND : index->entries[slot].value;
+}
+
+bool string_index_remove(StringIndex* index, const StringArena* arena, const char* key) {
+    if (!index || !index->entries || !arena || !key) return false;
+
+    uint32_t slot = find_slot(index, arena, key, hash_folded(key));
+    if (slot == UINT32_MAX) return false;
+
+    // Backward-shift deletion: pull later entries of the chain into the hole
+    // when their home slot does not lie cyclically between hole and entry
+    uint32_t hole = slot;
+    uint32_t idx = (slot + 1) & index->mask;
+    while (index->entries[idx].key_offset != STRING_ARENA_INVALID) {
+        uint32_t home = index->entries[idx].hash & index->mask;
+        uint32_t dist_entry = (idx - home) & index->mask;
+        uint32_t dist_hole = (idx - hole) & index->mask;
+        if (dist_entry >= dist_hole) {
+            index->entries[hole] = index->entries[idx];
+            hole = idx;
+        }
+        idx = (idx + 1) & index->mask;
+    }
+    index->entries[hole].key_offset = STRING_ARENA_INVALID;
+    index->count--;
+    return true;
+}
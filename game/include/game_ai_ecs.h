@@ -2,6 +2,8 @@
 #define GAME_AI_ECS_H
 
 #include "engine_ecs.h"
+#include "game_coastline.h"
+#include "game_ship_ecs.h"
 #include <stdbool.h>
 
 // =============================================================================
@@ -14,6 +16,12 @@
 // AI component flag (uses game-reserved bit from engine)
 #define COMPONENT_AI COMPONENT_GAME_1
 
+// Coastline lookahead: rays reach this far ahead in time, plus the bow and a
+// margin; land inside half the ray also cuts the throttle
+#define AI_LOOKAHEAD_SECONDS 8.0f
+#define AI_LOOKAHEAD_MARGIN 40.0f
+#define AI_LOOKAHEAD_SLOW_THROTTLE 0.25f
+
 // =============================================================================
 // AI State Enum
 // =============================================================================
@@ -35,6 +43,7 @@ typedef struct AIComponents {
     uint32_t waypoint_index[MAX_ENTITIES];
     float wait_timer[MAX_ENTITIES];
     uint8_t ai_state[MAX_ENTITIES];
+    uint8_t avoiding[MAX_ENTITIES];     // Steering away from land (lookahead)
 } AIComponents;
 
 // Global AI component storage
@@ -83,4 +92,11 @@ void ai_ecs_set_waypoint(AIEcsWorld* ai_world, Entity e, uint32_t waypoint);
 // This handles route following, state transitions, etc.
 void ai_ecs_system_update(ECSWorld* ecs_world, AIEcsWorld* ai_world, float delta_time);
 
+// Cast one ray ahead of every AI ship in a single batch query. Ships with land
+// ahead put the rudder over away from the shore (and slow down when it is
+// close); once clear they centre the rudder again. Runs after
+// ai_ecs_system_update so it overrides route steering.
+void ai_ecs_system_lookahead(ECSWorld* ecs_world, AIEcsWorld* ai_world,
+                             ShipEcsWorld* ship_world, CoastlineState* coast);
+
 #endif // GAME_AI_ECS_H
@@ -0,0 +1,120 @@
+#ifndef GAME_COASTLINE_H
+#define GAME_COASTLINE_H
+
+#include "engine_ecs.h"
+#include "engine_segment_bvh.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// =============================================================================
+// Coastline
+//
+// Islands of the archipelago as closed polygons, loaded from JSON. Their
+// edges go into a static SegmentBvh that ship grounding, AI lookahead and fog
+// line of sight query every tick; the polygons are also triangulated once
+// for drawing.
+//
+// Per-tick queries are batched: a system gathers every ship it cares about
+// into the coastline's CoastQueryBatch columns and runs one batch query, so
+// nothing is allocated after loading.
+//
+// JSON schema:
+// {
+//   "version": "1.0",
+//   "islands": [
+//     { "name": "Styrsö", "points": [[1250.0, 880.0], [1390.0, 860.0], ...] }
+//   ]
+// }
+// Points go round the island in either direction; the last joins the first.
+// =============================================================================
+
+#define COAST_DEFAULT_FILEPATH "assets/data/coastline.json"
+#define COAST_MIN_ISLAND_POINTS 3
+
+// Gathered ships for one batch query
+typedef struct CoastQueryBatch {
+    Entity entity[MAX_ENTITIES];
+    float x[MAX_ENTITIES];
+    float y[MAX_ENTITIES];
+    float dx[MAX_ENTITIES];
+    float dy[MAX_ENTITIES];
+    float radius[MAX_ENTITIES];
+    SegmentBvhHit hits[MAX_ENTITIES];
+    uint32_t count;
+} CoastQueryBatch;
+
+typedef struct CoastlineState {
+    // Island outlines: island i is points [island_start[i], island_start[i + 1])
+    float* point_x;
+    float* point_y;
+    uint32_t point_count;
+    uint32_t point_capacity;
+    uint32_t* island_start;         // island_count + 1 offsets
+    float* island_bounds;           // min_x, min_y, max_x, max_y per island
+    uint32_t island_count;
+    uint32_t island_capacity;
+
+    // Fill: triangles of island i are [triangle_start[i], triangle_start[i + 1])
+    uint32_t* triangles;            // 3 point indices per triangle, screen winding
+    uint32_t* triangle_start;
+    uint32_t triangle_count;
+
+    SegmentBvh bvh;                 // Every island edge, tagged with its island
+    uint32_t generation;            // New value on every init, add and build; never
+                                    // shared by two coastlines (caches key on it)
+    CoastQueryBatch batch;          // Scratch for per-tick batch queries
+    uint32_t grounded_count;        // Ships held off by the last grounding update
+} CoastlineState;
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+// Initialize empty (open water)
+void coastline_init(CoastlineState* coast);
+
+// Free memory
+void coastline_shutdown(CoastlineState* coast);
+
+// Remove every island
+void coastline_clear(CoastlineState* coast);
+
+// =============================================================================
+// Building
+// =============================================================================
+
+// Append an island outline (at least COAST_MIN_ISLAND_POINTS points).
+// Takes effect at the next coastline_build.
+bool coastline_add_island(CoastlineState* coast, const float* xs, const float* ys, uint32_t count);
+
+// Build the BVH and triangulate the islands added so far
+bool coastline_build(CoastlineState* coast);
+
+// Replace the islands with those in a JSON string / file (NULL = default
+// file) and build. On failure the coastline is left empty.
+bool coastline_load_from_string(CoastlineState* coast, const char* json_string);
+bool coastline_load_from_file(CoastlineState* coast, const char* filepath);
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+// Whether a point is on land
+bool coastline_is_land(const CoastlineState* coast, float x, float y);
+
+// Whether a circle touches land (edge within radius, or centre inland)
+bool coastline_circle_touches_land(const CoastlineState* coast, float x, float y, float radius);
+
+// =============================================================================
+// Systems
+// =============================================================================
+
+// Hold off ships whose hull has run onto land while heading further in: the
+// part of their last move (velocity * delta_time) into the coast is undone
+// and that velocity removed, so they stop head-on and scrape along the shore
+// at an angle. Ships backing off are left alone. Runs after movement;
+// returns the number of ships held off.
+uint32_t coastline_system_grounding(CoastlineState* coast, ECSWorld* ecs_world,
+                                    ComponentMask ship_mask, float delta_time);
+
+#endif // GAME_COASTLINE_H
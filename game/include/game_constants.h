@@ -25,6 +25,19 @@
 #define SHIP_STERN_WIDTH_MULT  0.6f
 #define SHIP_STERN_ANGLE       150.0f
 
+// Draw order and hull colours of ship entities (RenderableComponents)
+#define SHIP_RENDER_LAYER      1
+#define SHIP_AI_SCALE          0.8f    // AI ships are drawn smaller
+#define SHIP_PLAYER_COLOR_R    230
+#define SHIP_PLAYER_COLOR_G    41
+#define SHIP_PLAYER_COLOR_B    55
+#define SHIP_AI_COLOR_R        0
+#define SHIP_AI_COLOR_G        121
+#define SHIP_AI_COLOR_B        241
+
+// Furthest a ship's wake reaches from its centre at scale 1 (view culling)
+#define SHIP_RENDER_REACH      (SHIP_LENGTH * 0.5f + 30.0f + 16.0f)
+
 // =============================================================================
 // UI LAYOUT CONSTANTS (sizes only - positions use engine_ui.h)
 // =============================================================================
@@ -54,6 +67,34 @@
 #define WATER_COLOR_B          225
 #define WATER_COLOR_A          255
 
+#define LAND_COLOR_R           196
+#define LAND_COLOR_G           178
+#define LAND_COLOR_B           140
+#define LAND_COLOR_A           255
+
+#define SHORE_COLOR_R          120
+#define SHORE_COLOR_G          104
+#define SHORE_COLOR_B          80
+#define SHORE_COLOR_A          255
+#define SHORE_LINE_WIDTH       2.0f
+
+// =============================================================================
+// WORLD RENDER LAYERS (render queue sort key; drawn low to high)
+// =============================================================================
+
+#define RENDER_LAYER_STATIC    5       // Cached tiles of water, land and POIs
+#define RENDER_LAYER_LAND      10
+#define RENDER_LAYER_SHORE     11
+#define RENDER_LAYER_POI_AREA  20
+#define RENDER_LAYER_POIS      21      // Icons, then labels (text sorts after shapes)
+#define RENDER_LAYER_FOG       30
+#define RENDER_LAYER_ROUTE     40      // Suggested route stays visible through fog
+#define RENDER_LAYER_SHIPS     50      // Plus the entity's RenderableComponents.layer
+
+// Fan segments of queued circles
+#define RENDER_CIRCLE_SEGMENTS       36    // As DrawCircle
+#define RENDER_SMALL_CIRCLE_SEGMENTS 12    // Markers a few pixels across
+
 // =============================================================================
 // PHYSICS CONSTANTS
 // =============================================================================
@@ -1,14 +1,19 @@
 #ifndef GAME_ECS_H
 #define GAME_ECS_H
 
+#include "engine_collision.h"
 #include "engine_ecs.h"
+#include "engine_jobs.h"
 #include "game_ship_ecs.h"
 #include "game_ai_ecs.h"
+#include "game_coastline.h"
 #include "game_poi_ecs.h"
 #include "game_fog_of_war.h"
 #include "game_satisfaction.h"
 #include "ship_physics.h"
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 // =============================================================================
 // Game ECS Layer
@@ -28,9 +33,16 @@ typedef struct GameEcsState {
     AIEcsWorld ai_world;        // Game-layer AI components
     POIEcsWorld poi_world;      // Game-layer POI components
     FogOfWarState fog;          // Fog of war visibility
-    TourSatisfaction tour;      // Current tour satisfaction tracking
+    TourEcsWorld tour_world;    // Per-ship tour satisfaction (COMPONENT_TOUR)
+    EventRingReader poi_events; // Satisfaction's reader of poi_world.events
+    CollisionWorld collision;   // Ship-to-ship contacts (hull triangles)
+    CoastlineState coast;       // Islands: grounding, AI lookahead, fog sight lines
+    JobSystem* jobs;            // Workers for collision detection (NULL = inline)
 } GameEcsState;
 
+// Collision layer bits (ColliderComponents.collision_layer / collision_mask)
+#define COLLISION_LAYER_SHIPS 0x01
+
 // =============================================================================
 // Game ECS Lifecycle
 // =============================================================================
@@ -94,9 +106,42 @@ float game_ecs_get_ship_angular_velocity(const GameEcsState* state, Entity ship)
 // Systems
 // =============================================================================
 
-// Run all game ECS systems (ship physics, AI, then movement)
+// Run all game ECS systems (AI and coastline lookahead, ship physics,
+// movement, collision, grounding, POIs, satisfaction, fog)
 void game_ecs_update(GameEcsState* state, float delta_time);
 
+// Adaptive update for time warp: advances steps * base_dt at once. AI, POIs,
+// satisfaction, fog and grounding run once for the whole span; ships holding course and
+// speed take one coarse physics step, the rest (turning, accelerating,
+// docking) take steps base steps. steps <= 1 is game_ecs_update(base_dt).
+void game_ecs_update_adaptive(GameEcsState* state, float base_dt, uint32_t steps);
+
+// How many base steps one adaptive update may cover, up to max_steps: as
+// many as keep every ship within game_ecs_max_step_travel over the span. A
+// ship's speed is bounded by its current speed plus what it can gain in
+// max_steps base steps, capped at its max speed.
+uint32_t game_ecs_adaptive_steps(const GameEcsState* state, float base_dt, uint32_t max_steps);
+
+// Farthest a ship may travel between the POI checks of one adaptive update:
+// a fraction of the smallest visit radius, so enter/exit checks still catch
+// every visit, and never more than GAME_ECS_MAX_STEP_TRAVEL
+float game_ecs_max_step_travel(const GameEcsState* state);
+
+// Travel limit with no POIs loaded (half a hull length, for contacts and grounding)
+#define GAME_ECS_MAX_STEP_TRAVEL 40.0f
+
+// Fraction of the smallest POI visit radius a ship may cross per adaptive update
+#define GAME_ECS_STEP_TRAVEL_RADIUS_SCALE 0.5f
+
+// Hash of the simulated state (live entities' masks, transforms, velocities,
+// ship controls and tours), for checking that two runs stayed identical
+uint64_t game_ecs_hash(const GameEcsState* state);
+
+// Fold words into a running world hash (FNV-1a over 32-bit words)
+uint64_t game_hash_words(uint64_t hash, const void* data, size_t word_count);
+
+#define GAME_HASH_SEED 14695981039346656037ull
+
 // =============================================================================
 // Compatibility Bridge (for gradual migration)
 // =============================================================================
@@ -114,6 +159,9 @@ void game_ecs_from_ship_state(GameEcsState* state, Entity ship, const ShipState*
 // Load POIs from file (call after init)
 bool game_ecs_load_pois(GameEcsState* state, const char* filepath);
 
+// Load coastline islands from file (NULL = default); open water on failure
+bool game_ecs_load_coastline(GameEcsState* state, const char* filepath);
+
 // Get POI world for queries
 POIEcsWorld* game_ecs_get_poi_world(GameEcsState* state);
 const POIEcsWorld* game_ecs_get_poi_world_const(const GameEcsState* state);
@@ -122,8 +170,8 @@ const POIEcsWorld* game_ecs_get_poi_world_const(const GameEcsState* state);
 FogOfWarState* game_ecs_get_fog(GameEcsState* state);
 const FogOfWarState* game_ecs_get_fog_const(const GameEcsState* state);
 
-// Get tour satisfaction
-TourSatisfaction* game_ecs_get_tour(GameEcsState* state);
-const TourSatisfaction* game_ecs_get_tour_const(const GameEcsState* state);
+// Get per-ship tour satisfaction
+TourEcsWorld* game_ecs_get_tour_world(GameEcsState* state);
+const TourEcsWorld* game_ecs_get_tour_world_const(const GameEcsState* state);
 
 #endif // GAME_ECS_H
@@ -3,6 +3,7 @@
 
 #include "engine_ecs.h"
 #include "engine_spatial_hash.h"
+#include "engine_segment_bvh.h"
 #include "game_poi_ecs.h"
 #include <stdbool.h>
 
@@ -70,9 +71,11 @@ typedef struct FogChunk {
 // =============================================================================
 
 typedef struct FogOfWarState {
-    // Per-POI visibility tracking
-    VisibilityState poi_visibility[MAX_POIS];
-    float poi_fog_alpha[MAX_POIS];  // 0.0 = clear, 1.0 = fully fogged
+    // Per-POI visibility tracking, indexed like POIEcsWorld and grown to
+    // match its capacity (one allocation for both arrays)
+    uint8_t* poi_visibility;        // VisibilityState
+    float* poi_fog_alpha;           // 0.0 = clear, 1.0 = fully fogged
+    uint32_t poi_capacity;
     
     // Chunk-based revealed area tracking (dynamically allocated)
     FogChunk chunks[FOG_MAX_CHUNKS];
@@ -86,6 +89,9 @@ typedef struct FogOfWarState {
     float last_reveal_y[FOG_MAX_TRACKED_SHIPS];
     int tracked_ship_count;
     
+    // Line-of-sight blockers (coastline edges); NULL = nothing blocks sight
+    const SegmentBvh* occluders;
+    
     // Global settings
     float reveal_radius;
     float discovery_radius;
@@ -110,6 +116,10 @@ void fog_shutdown(FogOfWarState* fog);
 // Reset fog (re-hide everything)
 void fog_reset(FogOfWarState* fog);
 
+// Ensure per-POI arrays cover at least `capacity` POIs (new entries start
+// hidden). Called automatically by fog_system_update from the POI world.
+bool fog_reserve_pois(FogOfWarState* fog, uint32_t capacity);
+
 // =============================================================================
 // Configuration
 // =============================================================================
@@ -126,6 +136,10 @@ void fog_set_discovery_radius(FogOfWarState* fog, float radius);
 // Enable prototype mode (all POIs visible)
 void fog_set_prototype_mode(FogOfWarState* fog, bool enabled);
 
+// Set the segments that block line of sight when revealing (NULL = none).
+// The BVH must outlive the fog state.
+void fog_set_occluders(FogOfWarState* fog, const SegmentBvh* occluders);
+
 // =============================================================================
 // Visibility Queries
 // =============================================================================
@@ -147,7 +161,8 @@ bool fog_is_position_revealed(const FogOfWarState* fog, float x, float y);
 // Visibility Modification
 // =============================================================================
 
-// Reveal area around a position (marks grid cells as revealed)
+// Reveal area around a position (marks grid cells as revealed). With
+// occluders set, cells behind an island stay fogged; its near shore shows.
 void fog_reveal_area(FogOfWarState* fog, float x, float y, float radius);
 
 // Manually reveal a POI (for story events, etc.)
@@ -0,0 +1,59 @@
+#ifndef GAME_POI_COOKED_H
+#define GAME_POI_COOKED_H
+
+#include "game_poi_ecs.h"
+#include "game_poi_loader.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// =============================================================================
+// Cooked POI Data
+//
+// Binary form of the POI data produced offline by the poi_cooker tool. The
+// file holds the POI columns exactly as POIEcsWorld lays them out in memory
+// (poi_ecs_layout_columns with capacity = count), followed by the string
+// arena, so loading is a file mapping plus a header check - no parsing, no
+// per-POI work and no copies. The JSON loader stays as the fallback.
+//
+// File layout (all offsets from file start, native endianness):
+//   POICookedHeader
+//   padding to POI_COLUMN_ALIGNMENT
+//   columns        (columns_size bytes)
+//   string arena   (string_bytes bytes, offset 0 is "")
+//
+// Bump POI_COOKED_VERSION whenever POIComponents or the arena format
+// changes; files with another version are rejected and re-cooked.
+// =============================================================================
+
+#define POI_COOKED_MAGIC 0x4B4F4350u        // "PCOK" (little-endian)
+#define POI_COOKED_VERSION 1u
+#define POI_COOKED_EXTENSION ".bin"
+
+typedef struct POICookedHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t header_size;           // sizeof(POICookedHeader)
+    uint32_t column_alignment;      // POI_COLUMN_ALIGNMENT at cook time
+    uint32_t poi_count;
+    uint32_t string_bytes;
+    uint64_t columns_offset;
+    uint64_t columns_size;
+    uint64_t strings_offset;
+    uint64_t file_size;
+} POICookedHeader;
+
+// Write all POIs of a world to a cooked file. Returns false on I/O error.
+bool poi_cooked_write(const POIEcsWorld* poi_world, const char* filepath);
+
+// Map a cooked file and use it in place as the world's POI storage.
+// Returns POI_LOAD_VERSION_MISMATCH for files from another build layout.
+POILoadResult poi_load_cooked(POIEcsWorld* poi_world, const char* filepath);
+
+// Derive the cooked path for a JSON path ("pois.json" -> "pois.bin")
+bool poi_cooked_path_for(const char* json_path, char* out_path, size_t out_size);
+
+// Check if a cooked file exists and is not older than its JSON source
+// (a missing JSON source counts as up to date)
+bool poi_cooked_is_current(const char* cooked_path, const char* json_path);
+
+#endif // GAME_POI_COOKED_H
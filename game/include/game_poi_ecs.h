@@ -1,7 +1,13 @@
 #ifndef GAME_POI_ECS_H
 #define GAME_POI_ECS_H
 
+#include "engine_bitset.h"
 #include "engine_ecs.h"
+#include "engine_event_ring.h"
+#include "engine_file_map.h"
+#include "engine_spatial_grid.h"
+#include "engine_string_arena.h"
+#include "engine_string_index.h"
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -45,9 +51,14 @@ typedef enum POITier {
 // POI Constants
 // =============================================================================
 
-#define POI_NAME_MAX_LENGTH 64
-#define POI_DESCRIPTION_MAX_LENGTH 256
-#define MAX_POIS 256
+// POI storage grows on demand (doubling); this is the first allocation
+#define POI_INITIAL_CAPACITY 256
+
+// Alignment of each column inside the storage block (cache line)
+#define POI_COLUMN_ALIGNMENT 64
+
+// Initial string arena size (bytes); grows on demand
+#define POI_STRING_ARENA_INITIAL_SIZE 8192
 
 // Default satisfaction bonuses by tier
 #define POI_SATISFACTION_GENERAL 5
@@ -56,33 +67,76 @@ typedef enum POITier {
 // Default visit radius (world units)
 #define POI_DEFAULT_RADIUS 50.0f
 
+// Minimum spatial index cell size (world units). Cells are at least twice the
+// largest visit radius so a point query touches at most 2x2 cells.
+#define POI_INDEX_MIN_CELL_SIZE 100.0f
+
+// Hysteresis: a ship enters a POI at radius and only exits beyond
+// radius * POI_EXIT_RADIUS_SCALE, so hovering on the edge does not flicker
+#define POI_EXIT_RADIUS_SCALE 1.2f
+
+// Enter/exit events kept for readers (power of 2; older events are overwritten)
+#define POI_EVENT_CAPACITY 256
+
 // =============================================================================
 // POI Components (SoA Layout)
 // =============================================================================
 
+// Each column points into one storage block owned by POIEcsWorld and holds
+// `capacity` entries (~36 bytes per POI, strings excluded).
 typedef struct POIComponents {
-    // Identity
-    char name[MAX_POIS][POI_NAME_MAX_LENGTH];
-    char description[MAX_POIS][POI_DESCRIPTION_MAX_LENGTH];
+    // Hot: read every tick by proximity checks
+    float* pos_x;                   // World position (separate from Transform for static POIs)
+    float* pos_y;
+    float* radius;                  // Visit detection radius
     
     // Classification
-    uint8_t type[MAX_POIS];         // POIType
-    uint8_t tier[MAX_POIS];         // POITier
-    
-    // World position (separate from Transform for static POIs)
-    float pos_x[MAX_POIS];
-    float pos_y[MAX_POIS];
-    
-    // Interaction
-    float radius[MAX_POIS];         // Visit detection radius
-    int satisfaction_bonus[MAX_POIS];
+    uint8_t* type;                  // POIType
+    uint8_t* tier;                  // POITier
+    int32_t* satisfaction_bonus;
     
     // State
-    bool visited[MAX_POIS];         // Has player visited this POI?
-    bool discovered[MAX_POIS];      // Is POI visible through fog of war?
-    uint32_t visit_count[MAX_POIS]; // Total visits (for statistics)
+    bool* visited;                  // Has player visited this POI?
+    bool* discovered;               // Is POI visible through fog of war?
+    uint32_t* visit_count;          // Total visits (for statistics)
+    
+    // Cold: offsets into POIEcsWorld.strings
+    uint32_t* id_offset;            // Stable data id ("" if none)
+    uint32_t* name_offset;
+    uint32_t* description_offset;
 } POIComponents;
 
+// =============================================================================
+// POI Events
+// =============================================================================
+
+typedef enum POIEventType {
+    POI_EVENT_ENTER = 0,            // Ship came within the POI's radius
+    POI_EVENT_EXIT = 1,             // Ship left radius * POI_EXIT_RADIUS_SCALE
+    POI_EVENT_DESTROY = 2           // POI was destroyed; the last POI took its index
+} POIEventType;
+
+// One enter/exit transition or POI removal, pushed to POIEcsWorld.events
+// (12 bytes). Readers keeping per-POI state follow a DESTROY the way
+// poi_ecs_destroy does: drop poi_index, then move moved_from into it.
+typedef struct POIEvent {
+    uint32_t poi_index;
+    union {
+        Entity ship;                // ENTER / EXIT
+        uint32_t moved_from;        // DESTROY: old index of the POI now at poi_index
+                                    // (poi_index itself when the last POI was destroyed)
+    };
+    uint8_t type;                   // POIEventType
+    bool first_visit;               // ENTER only: POI had never been visited
+} POIEvent;
+
+// Per-ship set of POIs the ship is currently inside
+typedef struct POIShipPresence {
+    Entity ship;
+    uint32_t inside_count;          // Set bits in inside
+    Bitset inside;                  // Bit i = inside POI i (sized lazily to poi_count)
+} POIShipPresence;
+
 // =============================================================================
 // POI ECS World
 // =============================================================================
@@ -90,6 +144,37 @@ typedef struct POIComponents {
 typedef struct POIEcsWorld {
     POIComponents pois;
     uint32_t poi_count;             // Active POIs
+    uint32_t capacity;              // Allocated entries per column
+    void* storage;                  // Single allocation backing all columns
+                                    // (NULL while columns live in mapped_file)
+    
+    // Cooked data file used in place (see game_poi_cooked.h); closed on clear
+    FileMap mapped_file;
+    
+    // Interned ids, names and descriptions (no length limit)
+    StringArena strings;
+    
+    // Case-insensitive lookup: name -> index, id -> index (kept current on create/destroy)
+    StringIndex name_index;
+    StringIndex id_index;
+    
+    // Spatial index over pos_x/pos_y, rebuilt after create/destroy/load
+    SpatialGrid spatial_index;
+    float max_radius;               // Largest visit radius (query padding)
+    float min_radius;               // Smallest visit radius (0 = no POIs)
+    uint32_t generation;            // New value on every init, create, destroy, clear and load
+    bool index_dirty;               // Index is stale; queries fall back to a scan
+    
+    // Enter/exit tracking (see poi_ecs_system_update). Presence entries are
+    // dense; released entries keep their bitset memory for reuse.
+    POIShipPresence* presence;
+    uint32_t presence_count;
+    uint32_t presence_capacity;
+    uint16_t presence_slot[MAX_ENTITIES];   // Entity -> presence index + 1 (0 = none)
+    
+    // Enter/exit events for satisfaction, audio and UI readers
+    EventRing events;
+    
     bool initialized;
 } POIEcsWorld;
 
@@ -103,15 +188,35 @@ void poi_ecs_init(POIEcsWorld* poi_world);
 // Shutdown POI ECS world
 void poi_ecs_shutdown(POIEcsWorld* poi_world);
 
-// Clear all POIs (for reloading)
+// Clear all POIs (for reloading, keeps allocated storage)
 void poi_ecs_clear(POIEcsWorld* poi_world);
 
+// Ensure storage for at least `capacity` POIs (loaders call this with the
+// dataset size so a load does a single allocation). Returns false on failure.
+bool poi_ecs_reserve(POIEcsWorld* poi_world, uint32_t capacity);
+
+// Get allocated capacity (per-POI arrays elsewhere, e.g. fog, size from this)
+uint32_t poi_ecs_get_capacity(const POIEcsWorld* poi_world);
+
+// Point `pois` columns into base (NULL to size only) for `capacity` entries,
+// each column POI_COLUMN_ALIGNMENT-aligned. Returns the block size in bytes.
+// This is the storage layout, shared with the cooked file format.
+size_t poi_ecs_layout_columns(POIComponents* pois, uint8_t* base, uint32_t capacity);
+
+// Replace all POIs with cooked data used in place: `columns` holds `count`
+// entries laid out by poi_ecs_layout_columns(count), `strings` holds the
+// string arena bytes. Takes ownership of map (which must contain both); the
+// first create past `count` moves the columns to the heap. Rebuilds lookups.
+bool poi_ecs_adopt_storage(POIEcsWorld* poi_world, FileMap* map, uint8_t* columns,
+                           uint32_t count, char* strings, uint32_t string_bytes);
+
 // =============================================================================
 // POI Creation
 // =============================================================================
 
 // POI creation parameters
 typedef struct POICreateParams {
+    const char* id;                 // Stable unique id (optional, e.g. "poi_vinga")
     const char* name;
     const char* description;
     POIType type;
@@ -123,12 +228,17 @@ typedef struct POICreateParams {
 } POICreateParams;
 
 // Create a new POI
-// Returns POI index (0 to MAX_POIS-1), or -1 on failure
+// Returns POI index (0 to count-1), or -1 on failure (including duplicate id)
 int poi_ecs_create(POIEcsWorld* poi_world, const POICreateParams* params);
 
-// Destroy a POI by index
+// Destroy a POI by index. The last POI moves into its index; a
+// POI_EVENT_DESTROY tells event readers so.
 void poi_ecs_destroy(POIEcsWorld* poi_world, int poi_index);
 
+// Rebuild the spatial index after a batch of creates/destroys.
+// Loaders call this once at the end; poi_ecs_system_update calls it lazily.
+void poi_ecs_rebuild_index(POIEcsWorld* poi_world);
+
 // =============================================================================
 // POI Accessors
 // =============================================================================
@@ -136,12 +246,23 @@ void poi_ecs_destroy(POIEcsWorld* poi_world, int poi_index);
 // Get POI count
 uint32_t poi_ecs_get_count(const POIEcsWorld* poi_world);
 
+// Generation of the POI set: changes whenever POIs are added, removed or
+// reloaded, and is never shared by two worlds, so a cache keyed on it knows
+// when to rebuild (0 = no world)
+uint32_t poi_ecs_get_generation(const POIEcsWorld* poi_world);
+
 // Check if POI index is valid
 bool poi_ecs_is_valid(const POIEcsWorld* poi_world, int poi_index);
 
+// Get POI id ("" if none)
+const char* poi_ecs_get_id(const POIEcsWorld* poi_world, int poi_index);
+
 // Get POI name
 const char* poi_ecs_get_name(const POIEcsWorld* poi_world, int poi_index);
 
+// Get POI description ("" if none)
+const char* poi_ecs_get_description(const POIEcsWorld* poi_world, int poi_index);
+
 // Get POI type
 POIType poi_ecs_get_type(const POIEcsWorld* poi_world, int poi_index);
 
@@ -185,13 +306,23 @@ void poi_ecs_increment_visits(POIEcsWorld* poi_world, int poi_index);
 int poi_ecs_find_at_position(const POIEcsWorld* poi_world, float x, float y);
 
 // Find all POIs within range of a position
-// Fills out_indices array (up to max_results), returns count found
+// Fills out_indices array (up to max_results, in spatial index order), returns count found
 int poi_ecs_find_in_range(const POIEcsWorld* poi_world, float x, float y, float range,
                           int* out_indices, int max_results);
 
-// Find POI by name (case-insensitive)
+// Find all POIs positioned inside a world rectangle (edges included)
+// Fills out_indices array (up to max_results, in spatial index order), returns count found
+int poi_ecs_find_in_rect(const POIEcsWorld* poi_world, float min_x, float min_y, float max_x, float max_y,
+                         int* out_indices, int max_results);
+
+// Find POI by name (case-insensitive, O(1)). Names need not be unique; with
+// duplicates any one of the matching POIs is returned.
 int poi_ecs_find_by_name(const POIEcsWorld* poi_world, const char* name);
 
+// Find POI by id (case-insensitive, O(1)). Ids come from the data files, so
+// they stay valid across reloads while indices may not.
+int poi_ecs_find_by_id(const POIEcsWorld* poi_world, const char* id);
+
 // Check if a position is within a POI's visit radius
 bool poi_ecs_check_visit(const POIEcsWorld* poi_world, int poi_index, float x, float y);
 
@@ -199,19 +330,25 @@ bool poi_ecs_check_visit(const POIEcsWorld* poi_world, int poi_index, float x, f
 // POI System Update
 // =============================================================================
 
-// Callback for POI visit events
-typedef void (*POIVisitCallback)(int poi_index, Entity visitor, void* user_data);
+// Update POI system - tracks which POIs each ship (entity with ship_mask and
+// a Transform) is inside and pushes POI_EVENT_ENTER / POI_EVENT_EXIT to
+// poi_world->events. Only POIs near each ship are tested. An enter also marks
+// the POI visited and bumps its visit count. Ships that lose ship_mask exit
+// everything they were inside.
+void poi_ecs_system_update(POIEcsWorld* poi_world, const ECSWorld* ecs_world,
+                           ComponentMask ship_mask);
 
-// Context for POI system update
-typedef struct POISystemContext {
-    POIVisitCallback on_visit;      // Called when a ship visits a POI
-    void* user_data;                // User data for callback
-} POISystemContext;
+// Start a reader at the end of the event ring (sees events pushed from now on)
+void poi_ecs_events_reader_init(const POIEcsWorld* poi_world, EventRingReader* reader);
 
-// Update POI system - checks for ship visits to POIs
-// Requires ECSWorld for ship positions
-void poi_ecs_system_update(POIEcsWorld* poi_world, const ECSWorld* ecs_world,
-                           ComponentMask ship_mask, const POISystemContext* context);
+// Next unread enter/exit/destroy event, or NULL when the reader is caught up
+const POIEvent* poi_ecs_events_next(const POIEcsWorld* poi_world, EventRingReader* reader);
+
+// Check if a ship is currently inside a POI (as of the last system update)
+bool poi_ecs_ship_is_inside(const POIEcsWorld* poi_world, Entity ship, int poi_index);
+
+// Number of POIs a ship is currently inside
+uint32_t poi_ecs_ship_inside_count(const POIEcsWorld* poi_world, Entity ship);
 
 // =============================================================================
 // POI Statistics
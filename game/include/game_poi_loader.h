@@ -2,12 +2,21 @@
 #define GAME_POI_LOADER_H
 
 #include "game_poi_ecs.h"
+#include "engine_json_stream.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 // =============================================================================
 // POI Data Loader
 // 
-// Loads POI data from JSON files for moddability.
+// Loads POI data from JSON files for moddability. poi_load_from_file prefers
+// an up-to-date cooked sibling file (pois.json -> pois.bin, see
+// game_poi_cooked.h) and falls back to parsing the JSON.
+//
+// JSON is parsed in a single streaming pass (engine_json_stream.h): files are
+// read in POI_LOAD_CHUNK_SIZE chunks and each POI is created as soon as its
+// object closes, so there is no file size limit and memory use does not
+// grow with the file.
 // JSON schema:
 // {
 //   "version": "1.0",
@@ -36,23 +45,78 @@ typedef enum POILoadResult {
     POI_LOAD_PARSE_ERROR,
     POI_LOAD_INVALID_SCHEMA,
     POI_LOAD_WORLD_NOT_INITIALIZED,
-    POI_LOAD_OUT_OF_MEMORY
+    POI_LOAD_OUT_OF_MEMORY,
+    POI_LOAD_VERSION_MISMATCH       // Cooked data from another format version
 } POILoadResult;
 
 // Get human-readable error message for load result
 const char* poi_load_result_to_string(POILoadResult result);
 
+// =============================================================================
+// Streaming Loader
+// =============================================================================
+
+// Bytes read per chunk when streaming a file
+#define POI_LOAD_CHUNK_SIZE (64 * 1024)
+
+// Incremental loader: feed JSON in chunks of any size, e.g. from a network
+// stream or archive. Always call poi_stream_finish to release buffers.
+typedef struct POIStreamLoader {
+    JsonStream json;
+    POIEcsWorld* poi_world;         // NULL = validate only
+    
+    // POI being assembled
+    POICreateParams params;
+    char* strings;                  // id, name, description of the current POI
+    uint32_t strings_size;
+    uint32_t strings_capacity;
+    uint32_t id_at;                 // Offsets into strings (UINT32_MAX = absent)
+    uint32_t name_at;
+    uint32_t description_at;
+    uint32_t fields_found;          // Bit per required field seen
+    uint8_t field;                  // Field the next value belongs to
+    bool in_poi;
+    bool in_position;
+    
+    // Document state
+    bool root_key_is_pois;
+    bool in_pois;
+    bool found_pois;
+    bool schema_error;
+    bool out_of_memory;
+    int loaded;
+} POIStreamLoader;
+
+// Begin loading into poi_world (existing POIs are cleared when the "pois"
+// array starts)
+POILoadResult poi_stream_begin(POIStreamLoader* loader, POIEcsWorld* poi_world);
+
+// Feed the next chunk; returns POI_LOAD_SUCCESS while the input is valid so far
+POILoadResult poi_stream_feed(POIStreamLoader* loader, const char* data, size_t size);
+
+// Finish loading and free buffers. On failure the world is left empty.
+POILoadResult poi_stream_finish(POIStreamLoader* loader);
+
 // =============================================================================
 // Loading Functions
 // =============================================================================
 
-// Load POIs from JSON file into POI world
+// Load POIs for a JSON data file into POI world. Uses the cooked sibling file
+// when it is valid and not older than the JSON, otherwise parses the JSON.
 // Returns POI_LOAD_SUCCESS on success, error code otherwise
 POILoadResult poi_load_from_file(POIEcsWorld* poi_world, const char* filepath);
 
+// Load POIs from a JSON file, ignoring any cooked data (used by the cooker)
+POILoadResult poi_load_from_json_file(POIEcsWorld* poi_world, const char* filepath);
+
 // Load POIs from JSON string (for testing or embedded data)
 POILoadResult poi_load_from_string(POIEcsWorld* poi_world, const char* json_string);
 
+// Load POIs from a JSON string via a full cJSON document tree. Reference
+// implementation kept for parity tests and benchmarks; prefer
+// poi_load_from_string.
+POILoadResult poi_load_from_string_dom(POIEcsWorld* poi_world, const char* json_string);
+
 // =============================================================================
 // Validation
 // =============================================================================
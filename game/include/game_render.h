@@ -11,13 +11,16 @@
 // Render all game visuals
 void game_render(const GameState* state);
 
-// Render world elements (water, islands, etc.)
+// Free the world render queue
+void game_render_shutdown(void);
+
+// Clear to water and queue the islands
 void game_render_world(const GameState* state);
 
-// Render all ships
+// Queue all ships in view
 void game_render_ships(const GameState* state);
 
-// Render Points of Interest
+// Queue Points of Interest
 void game_render_pois(const GameState* state);
 
 // Render UI elements
@@ -0,0 +1,125 @@
+#ifndef GAME_ROUTE_PLANNER_H
+#define GAME_ROUTE_PLANNER_H
+
+#include "engine_jobs.h"
+#include "game_poi_ecs.h"
+#include "game_satisfaction.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// =============================================================================
+// Tour Route Planner
+//
+// Suggests the order of POIs to visit from a harbour so the tour earns the
+// most satisfaction within a distance or time budget (an orienteering
+// problem). Each thread of the job system runs its own seeded search:
+//   1. Greedy insertion by bonus per extra distance
+//   2. 2-opt to shorten the route, then refill the freed budget
+//   3. Destroy/repair rounds (random, segment and worst-stop removal, with
+//      adaptive operator weights) until the time limit
+// and the best route over all searches wins.
+//
+// Routes are ranked by raw bonus (POI bonuses + variety bonus) and then by
+// length, since the clamped 0-100 score saturates after a few stops.
+// Distances between candidates are cached in a matrix that is reused while
+// the candidate set stays the same, so re-planning from a new position only
+// recomputes the start row.
+//
+// Usage:
+//   RoutePlanner planner;
+//   route_planner_init(&planner, &jobs, &satisfaction_config);
+//   RoutePlanRequest request = route_plan_request_default(x, y);
+//   request.time_budget = 300.0f;
+//   request.cruise_speed = 150.0f;
+//   RoutePlan plan;
+//   route_planner_plan(&planner, &poi_world, &request, &plan);
+//   route_planner_shutdown(&planner);
+// =============================================================================
+
+#define ROUTE_MAX_STOPS 64              // POIs in one planned route
+#define ROUTE_MAX_CANDIDATES 1024       // POIs considered per plan
+#define ROUTE_DEFAULT_TIME_LIMIT 0.040f // Search seconds per plan
+
+typedef struct RoutePlanRequest {
+    float start_x;                  // Harbour (route start) position
+    float start_y;
+    float distance_budget;          // Max route length, world units (0 = none)
+    float time_budget;              // Max sailing time, seconds (0 = none)
+    float cruise_speed;             // Ship speed for time_budget, units/second
+    bool return_to_start;           // Route ends back at the harbour
+
+    const int* candidates;          // POIs to choose from (NULL = all in reach)
+    uint32_t candidate_count;
+
+    uint32_t max_stops;             // 0 = ROUTE_MAX_STOPS
+    float time_limit;               // Search seconds (0 = ROUTE_DEFAULT_TIME_LIMIT)
+    uint32_t max_iterations;        // Destroy/repair rounds per search (0 = until
+                                    // time limit; else the limit is ignored so
+                                    // results are reproducible)
+    uint32_t seed;
+} RoutePlanRequest;
+
+typedef struct RoutePlan {
+    float start_x;                  // Where the route starts (and ends, if returning)
+    float start_y;
+    bool return_to_start;
+    int stops[ROUTE_MAX_STOPS];     // POI indices in visiting order
+    uint32_t stop_count;
+    float length;                   // Sailing distance, including the return leg
+    int bonus;                      // POI bonuses + variety bonus
+    int satisfaction;               // Expected tour score (0-100)
+    uint32_t iterations;            // Destroy/repair rounds over all searches
+    uint32_t candidate_count;       // POIs considered
+    bool valid;
+} RoutePlan;
+
+typedef struct RouteSearch RouteSearch;
+
+typedef struct RoutePlanner {
+    JobSystem* jobs;                // Not owned (NULL = single-threaded)
+    SatisfactionConfig config;
+
+    // Candidate POIs, sorted (node i + 1 = candidates[i], node 0 = start)
+    int* candidates;
+    uint32_t candidate_count;
+
+    // Per-node tables
+    float* node_x;
+    float* node_y;
+    int32_t* bonus;                 // Satisfaction bonus (0 for the start)
+    uint8_t* type;                  // POIType
+    uint32_t node_count;
+    uint32_t node_capacity;
+
+    // Distance matrix over all nodes, row-major (node_count x node_count)
+    float* dist;
+    bool dist_valid;
+    uint32_t matrix_builds;         // Full rebuilds (cache misses)
+
+    // One search per thread
+    RouteSearch* searches;
+    uint32_t search_count;
+
+    bool initialized;
+} RoutePlanner;
+
+// Request with no budget and default search settings
+RoutePlanRequest route_plan_request_default(float start_x, float start_y);
+
+// Initialize (config NULL = defaults); jobs may be NULL
+bool route_planner_init(RoutePlanner* planner, JobSystem* jobs, const SatisfactionConfig* config);
+
+// Free the distance cache and search memory
+void route_planner_shutdown(RoutePlanner* planner);
+
+// Replace the satisfaction config used to value POIs
+void route_planner_set_config(RoutePlanner* planner, const SatisfactionConfig* config);
+
+// Drop the distance cache (call after POIs move or are reloaded)
+void route_planner_invalidate(RoutePlanner* planner);
+
+// Plan a route. Returns false (and an empty plan) if nothing is reachable.
+bool route_planner_plan(RoutePlanner* planner, const POIEcsWorld* poi_world,
+                        const RoutePlanRequest* request, RoutePlan* out_plan);
+
+#endif // GAME_ROUTE_PLANNER_H
@@ -1,6 +1,9 @@
 #ifndef GAME_SATISFACTION_H
 #define GAME_SATISFACTION_H
 
+#include "engine_bitset.h"
+#include "engine_config.h"
+#include "engine_ecs.h"
 #include "game_poi_ecs.h"
 #include <stdbool.h>
 #include <stdint.h>
@@ -18,7 +21,6 @@
 // Constants
 // =============================================================================
 
-#define MAX_TOUR_POIS 32            // Maximum POIs in a single tour
 #define BASE_SATISFACTION 50        // Starting satisfaction for a tour
 #define VARIETY_BONUS_THRESHOLD 3   // Number of different types for variety bonus
 
@@ -44,9 +46,12 @@ typedef enum SatisfactionRating {
 // Tour Tracking
 // =============================================================================
 
+// Visit state is a bitset over POI indices (1 bit per POI, no cap on tour
+// length) plus counters updated on each new visit, so membership tests and
+// statistics never rescan. A zeroed struct is a valid, inactive tour.
 typedef struct TourSatisfaction {
-    // POIs visited during this tour
-    int visited_poi_indices[MAX_TOUR_POIS];
+    // POIs visited during this tour (bit i = POI i; sized lazily)
+    Bitset visited;
     uint32_t visited_count;
     
     // Running totals
@@ -54,12 +59,9 @@ typedef struct TourSatisfaction {
     int variety_bonus;              // Bonus for visiting different types
     int special_bonus;              // Bonus for special tier POIs
     
-    // Type tracking for variety bonus
-    bool has_nature;
-    bool has_historical;
-    bool has_military;
-    
-    // Tier tracking
+    // Visits per type (variety bonus) and tier
+    uint32_t type_counts[POI_TYPE_COUNT];
+    uint32_t types_visited;         // Types with at least one visit
     uint32_t general_count;
     uint32_t special_count;
     
@@ -74,7 +76,14 @@ typedef struct TourSatisfaction {
 // Tour Lifecycle
 // =============================================================================
 
-// Start a new tour (resets tracking)
+// Initialize tour tracking (inactive, nothing allocated yet)
+void satisfaction_tour_init(TourSatisfaction* tour);
+
+// Free tour tracking memory
+void satisfaction_tour_shutdown(TourSatisfaction* tour);
+
+// Start a new tour (resets tracking, keeps allocated memory)
+// The tour must have been initialized (or zeroed) first.
 void satisfaction_tour_start(TourSatisfaction* tour);
 
 // End current tour (calculates final score)
@@ -92,9 +101,12 @@ bool satisfaction_tour_is_active(const TourSatisfaction* tour);
 int satisfaction_record_poi_visit(TourSatisfaction* tour, const POIEcsWorld* poi_world,
                                   int poi_index);
 
-// Check if a POI was already visited this tour
+// Check if a POI was already visited this tour (O(1))
 bool satisfaction_was_poi_visited(const TourSatisfaction* tour, int poi_index);
 
+// Count POIs of a set (e.g. a route's stops) visited this tour (popcount, O(N/64))
+uint32_t satisfaction_count_visited_in(const TourSatisfaction* tour, const Bitset* pois);
+
 // =============================================================================
 // Score Calculation
 // =============================================================================
@@ -129,6 +141,9 @@ typedef struct SatisfactionConfig {
 // Get default configuration
 SatisfactionConfig satisfaction_get_default_config(void);
 
+// Read the [Satisfaction] section of a loaded config (defaults for missing keys)
+SatisfactionConfig satisfaction_get_config(const ConfigFile* config);
+
 // Calculate bonus for a specific POI with config
 int satisfaction_calculate_poi_bonus(const POIEcsWorld* poi_world, int poi_index,
                                      const SatisfactionConfig* config);
@@ -153,6 +168,78 @@ typedef struct TourStats {
 // Get tour statistics
 TourStats satisfaction_get_tour_stats(const TourSatisfaction* tour);
 
+// =============================================================================
+// Fleet Tours (ECS)
+//
+// A tour component on every passenger ship (player and AI ferries), stored
+// SoA by entity like the ship and AI worlds. Per-POI bonuses are computed
+// once from the world's SatisfactionConfig into flat tables, so recording a
+// visit is a table lookup, and scoring every ship is one branchless loop over
+// the tour columns.
+// =============================================================================
+
+// Tour component flag (uses game-reserved bit from engine)
+#define COMPONENT_TOUR COMPONENT_GAME_3
+
+typedef struct TourComponents {
+    int32_t poi_bonus_total[MAX_ENTITIES];
+    int32_t score[MAX_ENTITIES];                    // Written by satisfaction_system_update
+    uint32_t visited_count[MAX_ENTITIES];
+    uint32_t type_count[POI_TYPE_COUNT][MAX_ENTITIES];
+    uint32_t special_count[MAX_ENTITIES];
+    uint8_t type_mask[MAX_ENTITIES];                // Bit t = POIType t visited
+    uint8_t active[MAX_ENTITIES];                   // 1 while a tour is running
+    Bitset visited[MAX_ENTITIES];                   // POIs visited this tour
+} TourComponents;
+
+typedef struct TourEcsWorld {
+    TourComponents tours;
+    SatisfactionConfig config;
+    
+    // Per-POI values derived from config (rebuilt when POIs or config change)
+    int32_t* poi_bonus;
+    uint8_t* poi_type_bit;          // 1 << POIType
+    uint8_t* poi_special;           // 1 = special tier
+    uint32_t table_count;           // POIs covered by the tables
+    uint32_t table_capacity;
+    bool table_dirty;
+    
+    bool initialized;
+} TourEcsWorld;
+
+// Initialize with a config (NULL = defaults)
+void tour_ecs_init(TourEcsWorld* tour_world, const SatisfactionConfig* config);
+
+// Shutdown and free per-ship bitsets and POI tables
+void tour_ecs_shutdown(TourEcsWorld* tour_world);
+
+// Replace the config; POI tables are rebuilt on the next update
+void tour_ecs_set_config(TourEcsWorld* tour_world, const SatisfactionConfig* config);
+
+// Recompute per-POI tables (call after loading POIs; the system also
+// rebuilds when the POI count changes)
+bool tour_ecs_rebuild_tables(TourEcsWorld* tour_world, const POIEcsWorld* poi_world);
+
+// Start (or restart) a ship's tour; the entity needs COMPONENT_TOUR
+void tour_ecs_start(TourEcsWorld* tour_world, Entity ship);
+
+// End a ship's tour; its score stays readable
+void tour_ecs_end(TourEcsWorld* tour_world, Entity ship);
+
+// Check if a ship's tour is running
+bool tour_ecs_is_active(const TourEcsWorld* tour_world, Entity ship);
+
+// Current score of a ship's tour (as of the last system update)
+int tour_ecs_get_score(const TourEcsWorld* tour_world, Entity ship);
+
+// Tour statistics for one ship
+TourStats tour_ecs_get_stats(const TourEcsWorld* tour_world, Entity ship);
+
+// Apply every POI enter event pending on reader to the tours of ships with
+// COMPONENT_TOUR, then rescore all tours. Returns the number of new visits.
+uint32_t satisfaction_system_update(TourEcsWorld* tour_world, const ECSWorld* ecs_world,
+                                    const POIEcsWorld* poi_world, EventRingReader* reader);
+
 // =============================================================================
 // Debug
 // =============================================================================
@@ -61,10 +61,40 @@ typedef struct ShipComponents {
     uint8_t telegraph_order[MAX_ENTITIES];  // -3 to +3
 } ShipComponents;
 
+// Ships gathered for adaptive sub-stepping (see below), packed from index 0
+typedef struct ShipSubstepBatch {
+    uint32_t count;
+    Entity entity[MAX_ENTITIES];
+    
+    float throttle[MAX_ENTITIES];
+    float target_throttle[MAX_ENTITIES];
+    float rudder[MAX_ENTITIES];
+    float target_rudder[MAX_ENTITIES];
+    float max_speed[MAX_ENTITIES];
+    float acceleration[MAX_ENTITIES];
+    float turn_rate[MAX_ENTITIES];
+    float throttle_response[MAX_ENTITIES];
+    float steering_response[MAX_ENTITIES];
+    float coast_friction[MAX_ENTITIES];
+    float drift_factor[MAX_ENTITIES];
+    float reverse_speed_mult[MAX_ENTITIES];
+    float reverse_accel_mult[MAX_ENTITIES];
+    float speed_turn_factor[MAX_ENTITIES];
+    
+    float pos_x[MAX_ENTITIES];
+    float pos_y[MAX_ENTITIES];
+    float rotation[MAX_ENTITIES];
+    float speed[MAX_ENTITIES];
+    float angular_vel[MAX_ENTITIES];
+    float vel_x[MAX_ENTITIES];
+    float vel_y[MAX_ENTITIES];
+} ShipSubstepBatch;
+
 // Global ship component storage
 // (Parallel to ECSWorld's entity arrays)
 typedef struct ShipEcsWorld {
     ShipComponents ships;
+    ShipSubstepBatch substeps;      // Scratch for adaptive sub-stepping
     bool initialized;
 } ShipEcsWorld;
 
@@ -97,6 +127,68 @@ float ship_ecs_get_throttle(const ShipEcsWorld* ship_world, Entity e);
 // Get ship rudder (current, not target)
 float ship_ecs_get_rudder(const ShipEcsWorld* ship_world, Entity e);
 
+// =============================================================================
+// Ship Physics Kernels
+//
+// One physics step as a function over SoA columns, so it runs on the ECS
+// arrays or on any other batch of ships (benchmarks, replays).
+//
+// The wide kernel steps SHIP_PHYSICS_LANES ships per iteration with the
+// engine_simd_math types and no data-dependent branches: coast and
+// accelerate, forward and reverse, drift and no drift are all computed for
+// every lane and blended with select masks. Heading trig and the per-frame
+// decay powers come from engine_simd_math (one sincos per ship). Groups
+// with no live ship are skipped, and the coast decay is computed once for
+// groups whose ships all share the first ship's friction.
+//
+// The scalar kernel is the reference (libm) implementation. Both agree to
+// float rounding (~1e-5 relative per step).
+// =============================================================================
+
+#define SHIP_PHYSICS_LANES 8
+
+typedef struct ShipPhysicsColumns {
+    // Controls (smoothed in place) and targets
+    float* throttle;
+    const float* target_throttle;
+    float* rudder;
+    const float* target_rudder;
+    
+    // Per-ship tuning
+    const float* max_speed;
+    const float* acceleration;
+    const float* turn_rate;
+    const float* throttle_response;
+    const float* steering_response;
+    const float* coast_friction;
+    const float* drift_factor;
+    const float* reverse_speed_mult;
+    const float* reverse_accel_mult;
+    const float* speed_turn_factor;
+    
+    // Motion
+    const float* rotation;          // degrees (read only; movement integrates it)
+    float* speed;
+    float* angular_vel;
+    float* vel_x;
+    float* vel_y;
+    
+    // Ship i is stepped only if (masks[i] & required) == required (NULL = all)
+    const ComponentMask* masks;
+    ComponentMask required;
+} ShipPhysicsColumns;
+
+// Columns over the ECS and ship world arrays (ships need transform, velocity and ship)
+ShipPhysicsColumns ship_physics_columns_from_ecs(ECSWorld* ecs_world, ShipEcsWorld* ship_world);
+
+// Step ships [begin, end) with the scalar reference implementation
+void ship_physics_kernel_scalar(const ShipPhysicsColumns* cols, uint32_t begin, uint32_t end,
+                                float delta_time);
+
+// Step ships [begin, end), SHIP_PHYSICS_LANES at a time (any remainder runs scalar)
+void ship_physics_kernel_wide(const ShipPhysicsColumns* cols, uint32_t begin, uint32_t end,
+                              float delta_time);
+
 // =============================================================================
 // Ship Physics System
 // =============================================================================
@@ -105,4 +197,39 @@ float ship_ecs_get_rudder(const ShipEcsWorld* ship_world, Entity e);
 // This handles throttle/rudder smoothing, acceleration, turning, drift
 void ship_ecs_system_physics(ECSWorld* ecs_world, ShipEcsWorld* ship_world, float delta_time);
 
+// Same update through the scalar reference kernel (for parity checks)
+void ship_ecs_system_physics_reference(ECSWorld* ecs_world, ShipEcsWorld* ship_world, float delta_time);
+
+// =============================================================================
+// Adaptive Sub-stepping
+//
+// Time warp advances the fleet by steps * base_dt per update. A ship that is
+// holding course and speed (rudder centred, not turning, throttle and speed
+// settled) integrates exactly in one coarse step of that length; everything
+// else needs the base step to turn and accelerate correctly.
+//
+// Usage, around one coarse physics + movement update:
+//   ship_ecs_substep_begin(ecs, ships, fine, fine_count);  // gather fine ships
+//   ship_ecs_system_physics(ecs, ships, steps * base_dt);  // whole fleet, coarse
+//   ecs_system_movement(ecs, steps * base_dt);
+//   ship_ecs_substep_end(ecs, ships, base_dt, steps);      // redo the fine ones
+//
+// The fine ships are stepped from the state gathered before the coarse
+// update, as a packed batch, so their extra steps cost in proportion to how
+// many there are; the results then replace the coarse ones. A batch of base
+// steps gives the same result as stepping the ECS arrays directly.
+// =============================================================================
+
+// True if the ship holds course and speed, so a longer step changes nothing
+// but its position
+bool ship_ecs_is_steady(const ECSWorld* ecs_world, const ShipEcsWorld* ship_world, Entity e);
+
+// Copy the fine ships' physics and transform state into the substep batch
+void ship_ecs_substep_begin(const ECSWorld* ecs_world, ShipEcsWorld* ship_world,
+                            const Entity* fine, uint32_t fine_count);
+
+// Step the batch steps times (physics and movement) and write it back
+void ship_ecs_substep_end(ECSWorld* ecs_world, ShipEcsWorld* ship_world,
+                          float base_dt, uint32_t steps);
+
 #endif // GAME_SHIP_ECS_H
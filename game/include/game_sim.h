@@ -0,0 +1,134 @@
+#ifndef GAME_SIM_H
+#define GAME_SIM_H
+
+#include "engine_config.h"
+#include "engine_ecs.h"
+#include "game_ecs.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// =============================================================================
+// Headless Simulation
+//
+// Runs the game ECS pipeline (AI, ship physics, movement, POIs, satisfaction,
+// fog) at a fixed tick rate with no window, renderer or audio, so large
+// fleets can be simulated on servers and in CI. A scenario file sets up the
+// fleet; ships are steered by a seeded random helm, so a scenario and a tick
+// count always give the same world.
+//
+// Scenario file (INI, every key optional):
+//   [Scenario]
+//   name = Harbour rush
+//   poi_file = assets/data/pois.json   # empty = the game's POI file
+//   coast_file = assets/data/coastline.json  # empty = the game's islands
+//   ships = 256                        # fleet size (up to MAX_ENTITIES - 1)
+//   ticks = 36000                      # run length when none is given
+//   seed = 1
+//   spawn_x = 1000                     # fleet spawns in this circle
+//   spawn_y = 400
+//   spawn_radius = 2000                # spawn points on land are redrawn
+//   throttle_min = 0.25                # helm orders are drawn from these
+//   throttle_max = 1.0
+//   rudder_max = 0.5
+//   helm_interval = 20                 # seconds between orders (0 = hold)
+//   fog = true
+//   max_substeps = 1                   # >1: time warp, one update covers up to
+//                                      # this many ticks (game_ecs_update_adaptive)
+//   [Simulation]
+//   tick_rate = 60
+//   [Satisfaction]                     # same keys as config.ini
+//
+// Usage:
+//   SimScenario scenario;
+//   game_sim_load_scenario("assets/scenarios/harbour_rush.ini", &scenario);
+//   static GameSim sim;
+//   game_sim_init(&sim, &scenario);
+//   SimStats stats = game_sim_run(&sim, scenario.ticks);
+//   game_sim_print_stats(&sim, &stats);
+//   game_sim_shutdown(&sim);
+// =============================================================================
+
+#define SIM_DEFAULT_SHIPS 64
+#define SIM_DEFAULT_TICKS 3600
+
+typedef struct SimScenario {
+    char name[CONFIG_MAX_VALUE_LEN];
+    char poi_file[CONFIG_MAX_VALUE_LEN];    // "" = the game's POI file
+    char coast_file[CONFIG_MAX_VALUE_LEN];  // "" = the game's coastline file
+    uint32_t ship_count;
+    uint32_t ticks;
+    uint32_t seed;
+    int tick_rate;                          // Fixed steps per second
+
+    float spawn_x;
+    float spawn_y;
+    float spawn_radius;
+
+    float throttle_min;
+    float throttle_max;
+    float rudder_max;
+    float helm_interval;                    // Seconds between helm orders (0 = hold)
+    bool fog_enabled;
+    uint32_t max_substeps;                  // Ticks per adaptive update (1 = every tick in full)
+
+    SatisfactionConfig satisfaction;
+} SimScenario;
+
+typedef struct SimStats {
+    uint64_t ticks;
+    uint64_t updates;                       // ECS updates (fewer than ticks when sub-stepping)
+    double sim_seconds;                     // Simulated time
+    double wall_seconds;                    // Time spent stepping
+    double ticks_per_second;
+    double ship_ticks_per_second;
+    double realtime_factor;                 // sim_seconds / wall_seconds
+    double worst_tick_ms;                   // Slowest update
+    uint32_t ship_count;
+    uint32_t poi_count;
+    uint64_t poi_visits;                    // POIs visited over all tours
+    uint64_t groundings;                    // Ship-updates stopped by the coast
+    float mean_satisfaction;
+    int min_satisfaction;
+    int max_satisfaction;
+    uint64_t world_hash;                    // game_ecs_hash after the run
+} SimStats;
+
+typedef struct GameSim {
+    ECSWorld ecs_world;
+    GameEcsState game_ecs;
+    SimScenario scenario;
+
+    Entity ships[MAX_ENTITIES];
+    uint32_t ship_count;
+
+    float dt;                               // 1 / tick_rate
+    uint32_t helm_ticks;                    // Ticks between helm orders (0 = hold)
+    uint64_t tick;                          // Fixed ticks simulated
+    uint32_t rng;
+    bool initialized;
+} GameSim;
+
+// Scenario with the game's POIs, SIM_DEFAULT_SHIPS ships and 60 Hz
+SimScenario game_sim_default_scenario(void);
+
+// Load a scenario file over the defaults. Returns false (and the defaults)
+// if the file can't be read.
+bool game_sim_load_scenario(const char* filepath, SimScenario* out_scenario);
+
+// Build the world and spawn the fleet. No window or audio device is needed.
+bool game_sim_init(GameSim* sim, const SimScenario* scenario);
+
+// Free the world
+void game_sim_shutdown(GameSim* sim);
+
+// Advance one update: one fixed tick, or with max_substeps > 1 as many as
+// game_ecs_adaptive_steps allows. Returns the ticks advanced.
+uint32_t game_sim_step(GameSim* sim);
+
+// Advance ticks fixed ticks and measure throughput
+SimStats game_sim_run(GameSim* sim, uint32_t ticks);
+
+// Print a throughput and tour summary
+void game_sim_print_stats(const GameSim* sim, const SimStats* stats);
+
+#endif // GAME_SIM_H
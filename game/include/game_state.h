@@ -8,7 +8,10 @@
 #include "engine_camera.h"
 #include "engine_config.h"
 #include "engine_ecs.h"
+#include "engine_jobs.h"
 #include "game_ecs.h"
+#include "game_route_planner.h"
+#include "input_record.h"
 #include <stdbool.h>
 
 // =============================================================================
@@ -23,6 +26,23 @@ typedef struct GameSounds {
     SoundHandle water_ambient;
 } GameSounds;
 
+// Seconds the "arrived at POI" banner is shown
+#define POI_BANNER_DURATION 3.0f
+
+// Sailing time (seconds at max speed) of the suggested tour route (F8)
+#define ROUTE_SUGGEST_TIME_BUDGET 300.0f
+
+// Time warp (simulated seconds per real second). The level is simulation
+// state, changed by tick actions, so warped sessions record and replay.
+// From TIME_WARP_ADAPTIVE_MIN up, one fixed step of the game covers several
+// engine steps (game_ecs_update_adaptive), and frames spend about
+// TIME_WARP_STEP_BUDGET simulating, with rendering held at TIME_WARP_RENDER_FPS.
+#define TIME_WARP_LEVEL_COUNT 8
+#define TIME_WARP_ADAPTIVE_MIN 10.0f
+#define TIME_WARP_MAX_SUBSTEPS 32
+#define TIME_WARP_STEP_BUDGET 0.040
+#define TIME_WARP_RENDER_FPS 20
+
 // Main game state
 typedef struct GameState {
     // ECS World (new data-oriented approach)
@@ -31,8 +51,12 @@ typedef struct GameState {
     Entity player_entity;       // Player ship entity in ECS
     bool use_ecs;               // Toggle between legacy and ECS physics
     
+    EcsRenderList render_list;  // Entities in view this frame, by layer (game_update_render_list)
+    
     // Legacy player ship (kept for compatibility during migration)
     ShipState player_ship;
+    ShipState previous_ship;    // player_ship before the last fixed step
+    ShipState render_ship;      // Player as drawn this frame (camera, HUD, debug panel)
     ShipTelegraph telegraph;
     ShipPhysicsConfig physics_config;
     
@@ -45,9 +69,31 @@ typedef struct GameState {
     AudioConfig audio_config;
     GameSounds sounds;
     
+    // POI enter/exit event readers (satisfaction reads in GameEcsState)
+    EventRingReader poi_audio_events;
+    EventRingReader poi_ui_events;
+    int poi_banner_index;       // POI named in the arrival banner (-1 = none)
+    float poi_banner_timer;     // Seconds the banner stays up
+    
+    // Worker threads and the suggested tour route (planned from the ship on F8)
+    JobSystem jobs;
+    RoutePlanner route_planner;
+    RoutePlan suggested_route;
+    
     // Debug
     DebugState debug;
     
+    // Simulation input: actions latched this frame are applied on the next
+    // fixed step, which is what recording and replay capture
+    float spawn_x;              // Where the ship starts, resets and teleports to
+    float spawn_y;
+    uint64_t tick;              // Fixed steps since init
+    uint8_t pending_actions;    // TickAction bits for the next step
+    uint8_t time_warp;          // Time warp level (0 = real time)
+    InputLog input_log;         // Session being recorded, or the one replayed
+    InputReplay replay;
+    const char* record_path;    // Saved on shutdown (NULL = not recording)
+    
     // Config
     const char* config_path;
     
@@ -71,4 +117,29 @@ GameState* game_get_state(void);
 // Toggle between legacy physics and ECS physics
 void game_state_toggle_ecs(GameState* state);
 
+// Forget the previous step after a teleport or reset, so the ship is drawn
+// where it is instead of sliding there from where it was
+void game_state_snap_interpolation(GameState* state);
+
+// Record every fixed step from now on; saved to filepath on shutdown
+void game_state_start_recording(GameState* state, const char* filepath, uint32_t tick_rate);
+
+// Replay a recorded session from the start (call right after init).
+// The engine's fixed step should be set to the log's tick rate.
+bool game_state_start_replay(GameState* state, const char* filepath);
+
+// Simulated seconds per real second at a time warp level (1x to 1000x)
+float game_time_warp_scale(uint8_t level);
+
+// Change the time warp level and the engine's frame pacing to match
+void game_state_set_time_warp(GameState* state, uint8_t level);
+
+// Engine steps of fixed_dt that the next game step covers (1 below
+// TIME_WARP_ADAPTIVE_MIN). Depends only on simulation state, so a replay
+// takes the same steps as the recording.
+uint32_t game_state_steps_per_tick(const GameState* state, float fixed_dt);
+
+// Hash of everything the fixed step simulates
+uint64_t game_state_hash(const GameState* state);
+
 #endif // GAME_STATE_H
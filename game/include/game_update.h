@@ -5,21 +5,67 @@
 
 // =============================================================================
 // Game Update
-// Handles all game logic updates per frame
+//
+// The simulation (ship physics, AI, POIs, satisfaction) advances in fixed
+// steps so its results do not depend on the frame rate; input, audio, UI and
+// the camera run once per rendered frame:
+//
+//   game_update_frame_begin(state);
+//   while (engine_should_update_fixed_steps(game_state_steps_per_tick(state, fixed_dt)))
+//       game_update_fixed(state, fixed_dt);
+//   game_update_frame_end(state, frame_dt, engine_get_fixed_alpha());
+//
+// Under time warp one game step may cover several engine steps (see
+// TIME_WARP_ADAPTIVE_MIN); it is still one TickInput.
+//
+// Input that changes the simulation is gathered per frame and applied on
+// the next fixed step as one TickInput, so sessions can be recorded and
+// replayed step for step (see input_record.h).
 // =============================================================================
 
-// Update all game systems for one frame
+// Update all game systems for one frame with a single variable step
 void game_update(GameState* state, float delta_time);
 
-// Update input handling
+// Per-frame input and debug keys (before the fixed steps)
+void game_update_frame_begin(GameState* state);
+
+// Advance the simulation by one fixed step (game_state_steps_per_tick
+// engine steps of fixed_dt)
+void game_update_fixed(GameState* state, float fixed_dt);
+
+// Per-frame audio, UI, camera and render list (after the fixed steps);
+// alpha is how far the frame lies between the last two steps
+void game_update_frame_end(GameState* state, float frame_dt, float alpha);
+
+// The player as drawn this frame into render_ship: in ECS mode the player
+// entity's latest step at its interpolated pose, otherwise the legacy ship
+// blended between the last two steps
+void game_update_interpolation(GameState* state, float alpha);
+
+// Gather the entities in the camera's view into render_list (after the camera update)
+void game_update_render_list(GameState* state, float alpha);
+
+// Update input handling (latches telegraph presses for the next step)
 void game_update_input(GameState* state);
 
-// Update ship physics and controls
-void game_update_ship(GameState* state, float delta_time);
+// Apply one step's TickAction bits (telegraph, teleport, reset, ECS toggle)
+void game_update_apply_actions(GameState* state, uint8_t actions);
+
+// Update ship physics and controls over steps steps of delta_time
+void game_update_ship(GameState* state, float delta_time, uint32_t steps, float steering_input);
+
+// Report the replay result and hand control back to the player
+void game_update_finish_replay(GameState* state);
 
 // Update audio systems
 void game_update_audio(GameState* state);
 
+// Update UI state driven by game events (POI arrival banner)
+void game_update_ui(GameState* state, float delta_time);
+
+// Plan a suggested tour route from the player's position
+void game_update_route_suggestion(GameState* state);
+
 // Update camera following ship
 void game_update_camera(GameState* state, float delta_time);
 
@@ -0,0 +1,68 @@
+#ifndef GAME_VISIBILITY_H
+#define GAME_VISIBILITY_H
+
+#include "engine_ecs.h"
+#include "game_coastline.h"
+#include "game_fog_of_war.h"
+#include "game_poi_ecs.h"
+#include <raylib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// =============================================================================
+// Visibility
+//
+// What the camera shows this frame, worked out once at the start of the
+// render from the spatial indices (the POI grid, the coastline's island
+// bounds, the fog chunk hash) so every world layer draws from a short list
+// instead of testing the whole world against the view. Each list is padded
+// by how far its drawing reaches beyond the item's position.
+//
+// Entities come from the frame's EcsRenderList, which game_update_render_list
+// gathers against the same view rectangle (it needs the interpolation alpha,
+// so it is built at the end of the update).
+// =============================================================================
+
+#define VISIBILITY_POI_MARGIN 100.0f        // Icon and label reach around a POI
+
+typedef struct GameVisibility {
+    Rectangle view;                 // World rectangle the camera shows
+
+    // POIs whose icon, label or visit radius may reach the view
+    int* pois;
+    uint32_t poi_count;
+    uint32_t poi_capacity;
+
+    // Islands whose outline and shoreline overlap the view
+    uint32_t* islands;
+    uint32_t island_count;
+    uint32_t island_capacity;
+
+    // Fog chunks overlapping the fog area: chunk coordinates and index into
+    // FogOfWarState.chunks (SPATIAL_HASH_NOT_FOUND = never explored)
+    int32_t* chunk_x;
+    int32_t* chunk_y;
+    uint16_t* chunk_index;
+    uint32_t chunk_count;
+    uint32_t chunk_capacity;
+    float fog_min_x;                // View plus a fog cell on each side
+    float fog_min_y;
+    float fog_max_x;
+    float fog_max_y;
+
+    const EcsRenderList* entities;  // Entities in view, by layer
+} GameVisibility;
+
+// Initialize empty (no allocation)
+void game_visibility_init(GameVisibility* vis);
+
+// Free memory
+void game_visibility_shutdown(GameVisibility* vis);
+
+// Gather what overlaps view. Any source may be NULL (its list is left
+// empty); fog chunks are only gathered while fog is enabled.
+void game_visibility_build(GameVisibility* vis, Rectangle view, const POIEcsWorld* poi_world,
+                           const CoastlineState* coast, const FogOfWarState* fog,
+                           const EcsRenderList* entities);
+
+#endif // GAME_VISIBILITY_H
@@ -0,0 +1,133 @@
+#ifndef INPUT_RECORD_H
+#define INPUT_RECORD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// =============================================================================
+// Input Recording and Replay
+//
+// Everything the player does that changes the simulation is gathered into
+// one TickInput per fixed step, so a session can be captured and fed back
+// through the same steps. Identical inputs from the same start give an
+// identical world, which a per-tick world hash confirms; the first tick
+// whose hash differs is reported as the divergence point.
+//
+// The log keeps inputs run-length encoded (a held key or an idle ship costs
+// one run), plus one world hash every hash_interval ticks.
+//
+// File layout (native endianness):
+//   InputLogHeader
+//   InputRun[run_count]
+//   uint64_t hashes[hash_count]   (hash after tick k * hash_interval, k >= 1)
+//
+// Usage:
+//   InputLog log;
+//   input_log_init(&log, tick_rate, spawn_x, spawn_y, INPUT_LOG_DEFAULT_HASH_INTERVAL);
+//   each tick: input_log_record(&log, input, world_hash_after_tick);
+//   input_log_save(&log, "session.msir");
+//
+//   input_log_load(&log, "session.msir");
+//   InputReplay replay;
+//   input_replay_start(&replay, &log);
+//   each tick: input_replay_next(&replay, &input); step; input_replay_check(&replay, hash);
+// =============================================================================
+
+#define INPUT_LOG_MAGIC 0x5249534Du             // "MSIR" (little-endian)
+#define INPUT_LOG_VERSION 1u
+#define INPUT_LOG_DEFAULT_HASH_INTERVAL 1u      // Hash every tick
+
+// Actions that change the simulation (bits of TickInput.actions)
+typedef enum TickAction {
+    TICK_ACTION_RING_UP = 1 << 0,       // Telegraph one order up
+    TICK_ACTION_RING_DOWN = 1 << 1,     // Telegraph one order down
+    TICK_ACTION_TELEPORT = 1 << 2,      // Debug: ship back to the spawn point (F4)
+    TICK_ACTION_RESET = 1 << 3,         // Debug: reset the ship (F5)
+    TICK_ACTION_TOGGLE_ECS = 1 << 4,    // Debug: switch physics path (F7)
+    TICK_ACTION_WARP_UP = 1 << 5,       // Time warp one level faster
+    TICK_ACTION_WARP_DOWN = 1 << 6,     // Time warp one level slower
+} TickAction;
+
+typedef struct TickInput {
+    uint8_t actions;                    // TickAction bits
+    int8_t steering;                    // Steering axis * 127
+    uint16_t zoom;                      // Camera zoom * 1000 (replayed so frames
+                                        // draw the same view)
+} TickInput;
+
+typedef struct InputRun {
+    TickInput input;
+    uint32_t ticks;                     // Consecutive ticks with this input
+} InputRun;
+
+typedef struct InputLogHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t header_size;               // sizeof(InputLogHeader)
+    uint32_t tick_rate;                 // Fixed steps per second when recorded
+    uint32_t tick_count;
+    uint32_t run_count;
+    uint32_t hash_interval;
+    uint32_t hash_count;
+    float spawn_x;                      // Player start position
+    float spawn_y;
+} InputLogHeader;
+
+typedef struct InputLog {
+    InputLogHeader header;
+    InputRun* runs;
+    uint32_t run_capacity;
+    uint64_t* hashes;
+    uint32_t hash_capacity;
+} InputLog;
+
+typedef struct InputReplay {
+    const InputLog* log;
+    uint32_t tick;                      // Ticks played
+    uint32_t run;                       // Current run
+    uint32_t run_tick;                  // Ticks played of the current run
+    uint32_t hashes_checked;
+    uint32_t diverged_tick;             // First tick whose hash differed (if diverged)
+    bool diverged;
+    bool active;
+} InputReplay;
+
+// Pack an axis (-1 to 1) and zoom into a TickInput
+TickInput tick_input_make(uint8_t actions, float steering, float zoom);
+
+// Unpack the steering axis (-1 to 1)
+float tick_input_steering(const TickInput* input);
+
+// Unpack the camera zoom
+float tick_input_zoom(const TickInput* input);
+
+// Start an empty log (hash_interval 0 = no hashes)
+void input_log_init(InputLog* log, uint32_t tick_rate, float spawn_x, float spawn_y,
+                    uint32_t hash_interval);
+
+// Free the log's runs and hashes
+void input_log_free(InputLog* log);
+
+// Append the input of the tick just stepped and the world hash after it
+bool input_log_record(InputLog* log, TickInput input, uint64_t world_hash);
+
+// Write the log. Returns false on I/O error.
+bool input_log_save(const InputLog* log, const char* filepath);
+
+// Read a log written by input_log_save (replaces the log's contents)
+bool input_log_load(InputLog* log, const char* filepath);
+
+// Play a log from its first tick
+void input_replay_start(InputReplay* replay, const InputLog* log);
+
+// Input for the next tick; false (and no input) once the log is used up
+bool input_replay_next(InputReplay* replay, TickInput* out_input);
+
+// Compare the world hash after the tick just played with the recording.
+// Returns false if it differs; the first such tick is kept in diverged_tick.
+bool input_replay_check(InputReplay* replay, uint64_t world_hash);
+
+// True once every recorded tick has been played
+bool input_replay_finished(const InputReplay* replay);
+
+#endif // INPUT_RECORD_H
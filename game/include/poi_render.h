@@ -0,0 +1,53 @@
+#ifndef POI_RENDER_H
+#define POI_RENDER_H
+
+#include "game_poi_ecs.h"
+#include "game_fog_of_war.h"
+#include "engine_renderer.h"
+#include "engine_render_queue.h"
+#include <raylib.h>
+
+// =============================================================================
+// POI Rendering
+//
+// Markers and labels of Points of Interest, drawn from data prepared ahead
+// of time. The icon of each type and tier, the special-tier ring, the
+// visited check and a unit visit-radius circle are tessellated once, and
+// each POI's label is laid out into glyph quads, with its width, whenever
+// the POI set changes. Drawing a POI copies those into shared batches with its
+// position and fog colour, so a pass's markers are two triangle ranges and
+// its labels one glyph batch however many POIs it shows.
+// =============================================================================
+
+#define POI_LABEL_FONT_SIZE 10
+#define POI_LABEL_OFFSET_Y 20.0f            // Label top below the POI
+
+// Lay out every POI's label in font and cache the widths. The layout is
+// kept until the POI set's generation changes (a create, destroy or reload;
+// see poi_ecs_get_generation), when poi_render_batch_labels lays it out
+// again in the default font.
+bool poi_render_prepare_labels(const POIEcsWorld* poi_world, Font font);
+
+// Cached label width of a POI (0 before preparing, or without a font)
+float poi_render_label_width(int poi_index);
+
+// Append the markers of a list of POIs to a triangle batch: every visit
+// radius area first, then icons with their rings and visited checks.
+// POIs the fog hides are left out. Returns the vertex the icons start at.
+uint32_t poi_render_batch_markers(TriangleBatch* batch, const POIEcsWorld* poi_world,
+                                  const FogOfWarState* fog, const int* pois, uint32_t count);
+
+// Append the labels of a list of POIs (those clear enough of fog) to a
+// glyph batch drawing from the label font. Returns the labels added.
+uint32_t poi_render_batch_labels(GlyphBatch* batch, const POIEcsWorld* poi_world,
+                                 const FogOfWarState* fog, const int* pois, uint32_t count);
+
+// Queue a list of POIs on a render queue stream: areas on area_layer, then
+// icons and labels on layer, from batches that stay valid until the next call
+void poi_render_queue(RenderStream* stream, uint8_t area_layer, uint8_t layer, const POIEcsWorld* poi_world,
+                      const FogOfWarState* fog, const int* pois, uint32_t count);
+
+// Free the meshes, labels and batches
+void poi_render_shutdown(void);
+
+#endif // POI_RENDER_H
@@ -2,6 +2,9 @@
 #define SHIP_RENDER_H
 
 #include "ship_physics.h"
+#include "engine_ecs.h"
+#include "engine_renderer.h"
+#include "engine_render_queue.h"
 #include <raylib.h>
 
 // =============================================================================
@@ -39,4 +42,20 @@ void ship_render_draw_at(float x, float y, float heading, const ShipVisualStyle*
 // Draw ship wake effect (trail behind ship)
 void ship_render_draw_wake(const ShipState* ship, float intensity);
 
+// Append the ship entities (ship_mask) of one render-list layer to a
+// triangle batch: all wakes, then hulls, outlines and centres. Hull colour
+// comes from the entity's RenderableComponents and size from its transform
+// scale. skip is left out (INVALID_ENTITY = none). Returns the ships added.
+uint32_t ship_render_batch_layer(TriangleBatch* batch, const EcsRenderList* list, const ECSWorld* world,
+                                 ComponentMask ship_mask, Entity skip, uint32_t layer);
+
+// Queue the ship entities of a render list on a render queue stream, each
+// entity layer at base_layer + layer as one range of a vertex stream that
+// stays valid until the next call
+void ship_render_queue_list(RenderStream* stream, uint8_t base_layer, const EcsRenderList* list,
+                            const ECSWorld* world, ComponentMask ship_mask, Entity skip);
+
+// Free the vertex stream ship_render_queue_list keeps between frames
+void ship_render_shutdown(void);
+
 #endif // SHIP_RENDER_H
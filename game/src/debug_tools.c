@@ -208,6 +208,8 @@ void debug_tools_draw_help(const DebugState* state) {
     DrawText("A / Left Arrow   - Turn Left (hold)", start_x + 20, y, 20, LIGHTGRAY);
     y += line_height;
     DrawText("D / Right Arrow  - Turn Right (hold)", start_x + 20, y, 20, LIGHTGRAY);
+    y += line_height;
+    DrawText("[ / ]            - Time Warp Slower / Faster (1x to 1000x)", start_x + 20, y, 20, LIGHTGRAY);
     y += line_height + 10;
     
     DrawText("=== Debug Tools ===", start_x, y, 24, WHITE);
@@ -223,6 +225,8 @@ void debug_tools_draw_help(const DebugState* state) {
     DrawText("F5 - Reset Ship State", start_x + 20, y, 20, LIGHTGRAY);
     y += line_height;
     DrawText("F6 - Hot-Reload config.ini", start_x + 20, y, 20, LIGHTGRAY);
+    y += line_height;
+    DrawText("F8 - Suggest Tour Route from Ship", start_x + 20, y, 20, LIGHTGRAY);
     y += line_height + 10;
     
     DrawText("=== Info ===", start_x, y, 24, WHITE);
@@ -1,4 +1,7 @@
 #include "game_ai_ecs.h"
+#include "engine_simd_math.h"
+#include "engine_math.h"
+#include <math.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -33,6 +36,7 @@ void ai_ecs_setup(AIEcsWorld* ai_world, Entity e, uint32_t route_id) {
     ai_world->ai.waypoint_index[e] = 0;
     ai_world->ai.wait_timer[e] = 0.0f;
     ai_world->ai.ai_state[e] = AI_STATE_IDLE;
+    ai_world->ai.avoiding[e] = 0;
 }
 
 AIState ai_ecs_get_state(const AIEcsWorld* ai_world, Entity e) {
@@ -109,3 +113,65 @@ void ai_ecs_system_update(ECSWorld* ecs_world, AIEcsWorld* ai_world, float delta
         }
     }
 }
+
+void ai_ecs_system_lookahead(ECSWorld* ecs_world, AIEcsWorld* ai_world,
+                             ShipEcsWorld* ship_world, CoastlineState* coast) {
+    if (!ecs_world || !ai_world || !ship_world || !coast) return;
+    if (coast->bvh.segment_count == 0) return;
+
+    ComponentMask required = COMPONENT_TRANSFORM | COMPONENT_VELOCITY | COMPONENT_AI;
+    TransformComponents* t = &ecs_world->transforms;
+    CoastQueryBatch* b = &coast->batch;
+
+    // Gather AI ships; radius holds headings until the sincos pass
+    b->count = 0;
+    for (Entity e = 1; e < MAX_ENTITIES; e++) {
+        if ((ecs_world->entity_masks[e] & required) != required) continue;
+        b->entity[b->count] = e;
+        b->x[b->count] = t->pos_x[e];
+        b->y[b->count] = t->pos_y[e];
+        b->radius[b->count] = t->rotation[e];
+        b->count++;
+    }
+    if (b->count == 0) return;
+    simd_sincos_deg_batch(b->radius, b->dx, b->dy, b->count);
+
+    // Rays along the heading, long enough for the stopping distance
+    for (uint32_t i = 0; i < b->count; i++) {
+        Entity e = b->entity[i];
+        float length = math_max(ecs_world->velocities.speed[e], 0.0f) * AI_LOOKAHEAD_SECONDS +
+                       ecs_world->colliders.hull_bow[e] + AI_LOOKAHEAD_MARGIN;
+        float fx = b->dx[i], fy = -b->dy[i];
+        b->dx[i] = fx * length;
+        b->dy[i] = fy * length;
+    }
+
+    segment_bvh_raycast_batch(&coast->bvh, b->x, b->y, b->dx, b->dy, 1.0f, b->count, b->hits);
+
+    for (uint32_t i = 0; i < b->count; i++) {
+        Entity e = b->entity[i];
+        const SegmentBvhHit* hit = &b->hits[i];
+        float* throttle = &ship_world->ships.target_throttle[e];
+        if (hit->segment == SEGMENT_BVH_NO_HIT) {
+            if (ai_world->ai.avoiding[e]) {
+                ship_ecs_set_rudder(ship_world, e, 0.0f);
+                if (*throttle < 0.0f) ship_ecs_set_throttle(ship_world, e, AI_LOOKAHEAD_SLOW_THROTTLE);
+                ai_world->ai.avoiding[e] = 0;
+            }
+            continue;
+        }
+
+        // Turn the way the shore faces: starboard is (-fy, fx) in ray terms.
+        // Slow down when the shore is close; with the bow on it, back off
+        // (ships barely turn without way on)
+        float starboard_dot = -b->dy[i] * hit->normal_x + b->dx[i] * hit->normal_y;
+        ship_ecs_set_rudder(ship_world, e, starboard_dot >= 0.0f ? 1.0f : -1.0f);
+        float length = sqrtf(b->dx[i] * b->dx[i] + b->dy[i] * b->dy[i]);
+        if (hit->t * length < ecs_world->colliders.hull_bow[e] + AI_LOOKAHEAD_MARGIN * 0.5f) {
+            ship_ecs_set_throttle(ship_world, e, -AI_LOOKAHEAD_SLOW_THROTTLE);
+        } else if (hit->t < 0.5f && *throttle > AI_LOOKAHEAD_SLOW_THROTTLE) {
+            ship_ecs_set_throttle(ship_world, e, AI_LOOKAHEAD_SLOW_THROTTLE);
+        }
+        ai_world->ai.avoiding[e] = 1;
+    }
+}
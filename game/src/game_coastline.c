@@ -0,0 +1,402 @@
+#include "game_coastline.h"
+#include "engine_file_map.h"
+#include "engine_math.h"
+#include "engine_simd_math.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Include cJSON
+#include "cJSON.h"
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+// Generations come from one counter, so no two coastlines share a value
+static uint32_t g_coast_generation;
+
+static void coastline_touch(CoastlineState* coast) {
+    coast->generation = ++g_coast_generation;
+    if (coast->generation == 0) coast->generation = ++g_coast_generation;
+}
+
+void coastline_init(CoastlineState* coast) {
+    if (!coast) return;
+    memset(coast, 0, sizeof(CoastlineState));
+    segment_bvh_init(&coast->bvh);
+    coastline_touch(coast);
+}
+
+void coastline_shutdown(CoastlineState* coast) {
+    if (!coast) return;
+    free(coast->point_x);
+    free(coast->point_y);
+    free(coast->island_start);
+    free(coast->island_bounds);
+    free(coast->triangles);
+    free(coast->triangle_start);
+    segment_bvh_shutdown(&coast->bvh);
+    memset(coast, 0, sizeof(CoastlineState));
+}
+
+void coastline_clear(CoastlineState* coast) {
+    if (!coast) return;
+    coastline_shutdown(coast);
+    coastline_init(coast);
+}
+
+// =============================================================================
+// Building
+// =============================================================================
+
+static bool grow(void** data, uint32_t* capacity, uint32_t needed, size_t element_size) {
+    if (needed <= *capacity) return true;
+    uint32_t new_capacity = *capacity ? *capacity * 2 : 16;
+    while (new_capacity < needed) new_capacity *= 2;
+    void* grown = realloc(*data, (size_t)new_capacity * element_size);
+    if (!grown) return false;
+    *data = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+bool coastline_add_island(CoastlineState* coast, const float* xs, const float* ys, uint32_t count) {
+    if (!coast || !xs || !ys || count < COAST_MIN_ISLAND_POINTS) return false;
+
+    // point_x and point_y share point_capacity, so grow a copy of it for each
+    uint32_t x_capacity = coast->point_capacity;
+    uint32_t y_capacity = coast->point_capacity;
+    uint32_t island_capacity = coast->island_capacity;
+    if (!grow((void**)&coast->point_x, &x_capacity, coast->point_count + count, sizeof(float)) ||
+        !grow((void**)&coast->point_y, &y_capacity, coast->point_count + count, sizeof(float)) ||
+        !grow((void**)&coast->island_start, &island_capacity, coast->island_count + 2, sizeof(uint32_t))) {
+        printf("Coastline: Failed to allocate island %u\n", coast->island_count);
+        return false;
+    }
+    coast->point_capacity = x_capacity;
+    coast->island_capacity = island_capacity;
+
+    memcpy(coast->point_x + coast->point_count, xs, count * sizeof(float));
+    memcpy(coast->point_y + coast->point_count, ys, count * sizeof(float));
+    coast->island_start[coast->island_count] = coast->point_count;
+    coast->point_count += count;
+    coast->island_count++;
+    coast->island_start[coast->island_count] = coast->point_count;
+    coastline_touch(coast);
+    return true;
+}
+
+// Append triangle a, b, c in the winding raylib draws (clockwise in y-up
+// terms, counter-clockwise on screen)
+static void emit_triangle(CoastlineState* coast, uint32_t a, uint32_t b, uint32_t c) {
+    const float* x = coast->point_x;
+    const float* y = coast->point_y;
+    float cross = (x[b] - x[a]) * (y[c] - y[a]) - (y[b] - y[a]) * (x[c] - x[a]);
+    uint32_t* out = &coast->triangles[coast->triangle_count * 3];
+    out[0] = a;
+    out[1] = cross < 0.0f ? b : c;
+    out[2] = cross < 0.0f ? c : b;
+    coast->triangle_count++;
+}
+
+static bool point_in_triangle(const float* x, const float* y, uint32_t p,
+                              uint32_t a, uint32_t b, uint32_t c, float orientation) {
+    float d0 = ((x[b] - x[a]) * (y[p] - y[a]) - (y[b] - y[a]) * (x[p] - x[a])) * orientation;
+    float d1 = ((x[c] - x[b]) * (y[p] - y[b]) - (y[c] - y[b]) * (x[p] - x[b])) * orientation;
+    float d2 = ((x[a] - x[c]) * (y[p] - y[c]) - (y[a] - y[c]) * (x[p] - x[c])) * orientation;
+    return d0 >= 0.0f && d1 >= 0.0f && d2 >= 0.0f;
+}
+
+// Ear clipping over island points [start, start + n); ring holds n indices
+// of scratch. Self-intersecting outlines still produce n - 2 triangles.
+static void triangulate_island(CoastlineState* coast, uint32_t start, uint32_t n, uint32_t* ring) {
+    const float* x = coast->point_x;
+    const float* y = coast->point_y;
+
+    float area = 0.0f;
+    for (uint32_t k = 0; k < n; k++) {
+        uint32_t a = start + k, b = start + (k + 1) % n;
+        area += x[a] * y[b] - x[b] * y[a];
+        ring[k] = a;
+    }
+    float orientation = area >= 0.0f ? 1.0f : -1.0f;
+
+    uint32_t remaining = n;
+    uint32_t i = 0;
+    uint32_t misses = 0;
+    while (remaining > 3) {
+        uint32_t prev = ring[(i + remaining - 1) % remaining];
+        uint32_t cur = ring[i];
+        uint32_t next = ring[(i + 1) % remaining];
+
+        float turn = ((x[cur] - x[prev]) * (y[next] - y[cur]) - (y[cur] - y[prev]) * (x[next] - x[cur])) * orientation;
+        bool ear = turn > 0.0f;
+        for (uint32_t k = 0; ear && k < remaining; k++) {
+            uint32_t p = ring[k];
+            if (p == prev || p == cur || p == next) continue;
+            if (point_in_triangle(x, y, p, prev, cur, next, orientation)) ear = false;
+        }
+
+        // A full lap without an ear means a degenerate outline: clip anyway
+        if (ear || misses > remaining) {
+            emit_triangle(coast, prev, cur, next);
+            memmove(&ring[i], &ring[i + 1], (remaining - i - 1) * sizeof(uint32_t));
+            remaining--;
+            if (i >= remaining) i = 0;
+            misses = 0;
+        } else {
+            i = (i + 1) % remaining;
+            misses++;
+        }
+    }
+    emit_triangle(coast, ring[0], ring[1], ring[2]);
+}
+
+bool coastline_build(CoastlineState* coast) {
+    if (!coast) return false;
+    coastline_touch(coast);
+    uint32_t islands = coast->island_count;
+    uint32_t points = coast->point_count;
+
+    free(coast->island_bounds);
+    free(coast->triangles);
+    free(coast->triangle_start);
+    coast->island_bounds = NULL;
+    coast->triangles = NULL;
+    coast->triangle_start = NULL;
+    coast->triangle_count = 0;
+    if (islands == 0) return segment_bvh_build(&coast->bvh, NULL, NULL, NULL, NULL, NULL, 0);
+
+    // One edge per point; n - 2 triangles per island
+    float* edges = (float*)malloc((size_t)points * 4 * sizeof(float));
+    uint32_t* tags = (uint32_t*)malloc(points * sizeof(uint32_t));
+    uint32_t* ring = (uint32_t*)malloc(points * sizeof(uint32_t));
+    coast->island_bounds = (float*)malloc((size_t)islands * 4 * sizeof(float));
+    coast->triangles = (uint32_t*)malloc((size_t)(points - 2 * islands) * 3 * sizeof(uint32_t));
+    coast->triangle_start = (uint32_t*)malloc((islands + 1) * sizeof(uint32_t));
+    if (!edges || !tags || !ring || !coast->island_bounds || !coast->triangles || !coast->triangle_start) {
+        free(edges);
+        free(tags);
+        free(ring);
+        printf("Coastline: Failed to allocate %u islands\n", islands);
+        coastline_clear(coast);
+        return false;
+    }
+    float* x0 = edges;
+    float* y0 = edges + points;
+    float* x1 = edges + points * 2;
+    float* y1 = edges + points * 3;
+
+    for (uint32_t island = 0; island < islands; island++) {
+        uint32_t start = coast->island_start[island];
+        uint32_t n = coast->island_start[island + 1] - start;
+        float* bounds = &coast->island_bounds[island * 4];
+        bounds[0] = bounds[2] = coast->point_x[start];
+        bounds[1] = bounds[3] = coast->point_y[start];
+
+        for (uint32_t k = 0; k < n; k++) {
+            uint32_t a = start + k, b = start + (k + 1) % n;
+            x0[a] = coast->point_x[a];
+            y0[a] = coast->point_y[a];
+            x1[a] = coast->point_x[b];
+            y1[a] = coast->point_y[b];
+            tags[a] = island;
+            bounds[0] = math_min(bounds[0], x0[a]);
+            bounds[1] = math_min(bounds[1], y0[a]);
+            bounds[2] = math_max(bounds[2], x0[a]);
+            bounds[3] = math_max(bounds[3], y0[a]);
+        }
+
+        coast->triangle_start[island] = coast->triangle_count;
+        triangulate_island(coast, start, n, ring);
+    }
+    coast->triangle_start[islands] = coast->triangle_count;
+
+    bool built = segment_bvh_build(&coast->bvh, x0, y0, x1, y1, tags, points);
+    free(edges);
+    free(tags);
+    free(ring);
+    if (!built) {
+        printf("Coastline: Failed to build BVH over %u edges\n", points);
+        coastline_clear(coast);
+        return false;
+    }
+    return true;
+}
+
+// =============================================================================
+// Loading
+// =============================================================================
+
+// Add the islands of a parsed document; false on a schema error
+static bool add_islands_from_json(CoastlineState* coast, const cJSON* root) {
+    const cJSON* islands = cJSON_GetObjectItem(root, "islands");
+    if (!cJSON_IsArray(islands)) return false;
+
+    const cJSON* island = NULL;
+    cJSON_ArrayForEach(island, islands) {
+        const cJSON* points = cJSON_GetObjectItem(island, "points");
+        int count = cJSON_GetArraySize(points);
+        if (!cJSON_IsArray(points) || count < COAST_MIN_ISLAND_POINTS) return false;
+
+        float* xy = (float*)malloc((size_t)count * 2 * sizeof(float));
+        if (!xy) return false;
+        int n = 0;
+        const cJSON* point = NULL;
+        cJSON_ArrayForEach(point, points) {
+            const cJSON* px = cJSON_GetArrayItem(point, 0);
+            const cJSON* py = cJSON_GetArrayItem(point, 1);
+            if (!cJSON_IsNumber(px) || !cJSON_IsNumber(py)) break;
+            xy[n] = (float)px->valuedouble;
+            xy[count + n] = (float)py->valuedouble;
+            n++;
+        }
+        bool added = n == count && coastline_add_island(coast, xy, xy + count, (uint32_t)count);
+        free(xy);
+        if (!added) return false;
+    }
+    return true;
+}
+
+static bool load_from_json(CoastlineState* coast, const char* json, size_t length, const char* source) {
+    coastline_clear(coast);
+
+    cJSON* root = cJSON_ParseWithLength(json, length);
+    if (!root) {
+        printf("Coastline: JSON error in %s\n", source);
+        coastline_build(coast);
+        return false;
+    }
+    bool added = add_islands_from_json(coast, root);
+    cJSON_Delete(root);
+    if (!added) {
+        printf("Coastline: Invalid island data in %s\n", source);
+        coastline_clear(coast);
+        coastline_build(coast);
+        return false;
+    }
+    if (!coastline_build(coast)) return false;
+
+    printf("Coastline: Loaded %u islands (%u edges, BVH depth %u) from %s\n",
+           coast->island_count, coast->bvh.segment_count, coast->bvh.depth, source);
+    return true;
+}
+
+bool coastline_load_from_string(CoastlineState* coast, const char* json_string) {
+    if (!coast || !json_string) return false;
+    return load_from_json(coast, json_string, strlen(json_string), "string");
+}
+
+bool coastline_load_from_file(CoastlineState* coast, const char* filepath) {
+    if (!coast) return false;
+    if (!filepath) filepath = COAST_DEFAULT_FILEPATH;
+
+    FileMap map;
+    if (!file_map_open(&map, filepath)) {
+        printf("Coastline: Failed to read file: %s (open water)\n", filepath);
+        coastline_clear(coast);
+        coastline_build(coast);
+        return false;
+    }
+    bool loaded = load_from_json(coast, (const char*)map.data, map.size, filepath);
+    file_map_close(&map);
+    return loaded;
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+bool coastline_is_land(const CoastlineState* coast, float x, float y) {
+    if (!coast) return false;
+    return segment_bvh_point_inside(&coast->bvh, x, y);
+}
+
+bool coastline_circle_touches_land(const CoastlineState* coast, float x, float y, float radius) {
+    if (!coast) return false;
+    SegmentBvhHit hit;
+    return segment_bvh_circle(&coast->bvh, x, y, radius, &hit) ||
+           segment_bvh_point_inside(&coast->bvh, x, y);
+}
+
+// =============================================================================
+// Systems
+// =============================================================================
+
+// Exact test for a hull triangle whose bounding circle touched the coast:
+// an edge crosses the shore, or the whole hull is inland
+static bool hull_on_land(const SegmentBvh* bvh, float px, float py, float fx, float fy,
+                         float bow, float stern, float beam) {
+    float sx = -fy, sy = fx;
+    float ax = px + fx * bow, ay = py + fy * bow;
+    float bx = px - fx * stern - sx * beam, by = py - fy * stern - sy * beam;
+    float cx = px - fx * stern + sx * beam, cy = py - fy * stern + sy * beam;
+    return segment_bvh_crossings(bvh, ax, ay, bx, by, 1) ||
+           segment_bvh_crossings(bvh, bx, by, cx, cy, 1) ||
+           segment_bvh_crossings(bvh, cx, cy, ax, ay, 1) ||
+           segment_bvh_point_inside(bvh, ax, ay);
+}
+
+uint32_t coastline_system_grounding(CoastlineState* coast, ECSWorld* ecs_world,
+                                    ComponentMask ship_mask, float delta_time) {
+    if (!coast || !ecs_world) return 0;
+    coast->grounded_count = 0;
+    if (coast->bvh.segment_count == 0) return 0;
+
+    TransformComponents* t = &ecs_world->transforms;
+    VelocityComponents* v = &ecs_world->velocities;
+    ColliderComponents* c = &ecs_world->colliders;
+    CoastQueryBatch* b = &coast->batch;
+    ComponentMask required = COMPONENT_TRANSFORM | COMPONENT_VELOCITY | COMPONENT_COLLIDER | ship_mask;
+
+    // Gather ships; radius holds headings until the sincos pass
+    b->count = 0;
+    for (Entity e = 1; e < MAX_ENTITIES; e++) {
+        if ((ecs_world->entity_masks[e] & required) != required) continue;
+        b->entity[b->count] = e;
+        b->radius[b->count] = t->rotation[e];
+        b->count++;
+    }
+    if (b->count == 0) return 0;
+    simd_sincos_deg_batch(b->radius, b->dx, b->dy, b->count);
+
+    // Hull bounding circles: centred midway between bow and stern
+    for (uint32_t i = 0; i < b->count; i++) {
+        Entity e = b->entity[i];
+        float half_length = (c->hull_bow[e] + c->hull_stern[e]) * 0.5f;
+        float offset = (c->hull_bow[e] - c->hull_stern[e]) * 0.5f;
+        float fx = b->dx[i], fy = -b->dy[i];
+        b->dx[i] = fx;
+        b->dy[i] = fy;
+        b->x[i] = t->pos_x[e] + fx * offset;
+        b->y[i] = t->pos_y[e] + fy * offset;
+        b->radius[i] = sqrtf(half_length * half_length + c->hull_half_beam[e] * c->hull_half_beam[e]);
+    }
+
+    if (segment_bvh_circle_batch(&coast->bvh, b->x, b->y, b->radius, b->count, b->hits) == 0) return 0;
+
+    for (uint32_t i = 0; i < b->count; i++) {
+        const SegmentBvhHit* hit = &b->hits[i];
+        if (hit->segment == SEGMENT_BVH_NO_HIT) continue;
+        Entity e = b->entity[i];
+        if (!hull_on_land(&coast->bvh, t->pos_x[e], t->pos_y[e], b->dx[i], b->dy[i],
+                          c->hull_bow[e], c->hull_stern[e], c->hull_half_beam[e])) continue;
+
+        // The normal faces the ship, so heading into the coast is v . n < 0
+        float nx = hit->normal_x, ny = hit->normal_y;
+        float into = v->vel_x[e] * nx + v->vel_y[e] * ny;
+        if (into >= 0.0f) continue;
+
+        // Undo the last move into the coast and keep the slide along it;
+        // speed becomes what is left along the heading
+        t->pos_x[e] -= into * nx * delta_time;
+        t->pos_y[e] -= into * ny * delta_time;
+        v->vel_x[e] -= into * nx;
+        v->vel_y[e] -= into * ny;
+        v->speed[e] = v->vel_x[e] * b->dx[i] + v->vel_y[e] * b->dy[i];
+        coast->grounded_count++;
+    }
+    return coast->grounded_count;
+}
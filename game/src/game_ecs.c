@@ -1,28 +1,11 @@
 #include "game_ecs.h"
 #include "game_poi_loader.h"
+#include "game_constants.h"
+#include "engine_math.h"
+#include <math.h>
 #include <string.h>
 #include <stdio.h>
 
-// =============================================================================
-// POI Visit Callback
-// =============================================================================
-
-static void on_poi_visit(int poi_index, Entity visitor, void* user_data) {
-    GameEcsState* state = (GameEcsState*)user_data;
-    if (!state) return;
-    
-    const char* name = poi_ecs_get_name(&state->poi_world, poi_index);
-    printf("POI Visit: Ship %u visited '%s'\n", visitor, name);
-    
-    // Record for tour satisfaction
-    if (satisfaction_tour_is_active(&state->tour)) {
-        int bonus = satisfaction_record_poi_visit(&state->tour, &state->poi_world, poi_index);
-        if (bonus > 0) {
-            printf("  Satisfaction bonus: +%d\n", bonus);
-        }
-    }
-}
-
 // =============================================================================
 // Game ECS Lifecycle
 // =============================================================================
@@ -35,10 +18,15 @@ void game_ecs_init(GameEcsState* state, ECSWorld* ecs_world) {
     ship_ecs_init(&state->ship_world);
     ai_ecs_init(&state->ai_world);
     poi_ecs_init(&state->poi_world);
+    poi_ecs_events_reader_init(&state->poi_world, &state->poi_events);
     fog_init(&state->fog);
+    collision_world_init(&state->collision, COLLISION_DEFAULT_EVENT_CAPACITY);
+    coastline_init(&state->coast);
+    fog_set_occluders(&state->fog, &state->coast.bvh);
+    state->jobs = NULL;
     
-    // Initialize tour (not active until explicitly started)
-    memset(&state->tour, 0, sizeof(TourSatisfaction));
+    // Tours start per ship in the factories; config may be replaced after load
+    tour_ecs_init(&state->tour_world, NULL);
     
     printf("Game ECS: Initialized with ship, AI, and POI sub-worlds\n");
 }
@@ -46,6 +34,9 @@ void game_ecs_init(GameEcsState* state, ECSWorld* ecs_world) {
 void game_ecs_shutdown(GameEcsState* state) {
     if (!state) return;
     
+    tour_ecs_shutdown(&state->tour_world);
+    coastline_shutdown(&state->coast);
+    collision_world_shutdown(&state->collision);
     fog_shutdown(&state->fog);
     poi_ecs_shutdown(&state->poi_world);
     ai_ecs_shutdown(&state->ai_world);
@@ -62,6 +53,18 @@ void game_ecs_shutdown(GameEcsState* state) {
 // Ship Entity Factory
 // =============================================================================
 
+// Collide with the triangle ship_render_draw_at draws at this scale
+static void set_ship_hull(ECSWorld* world, Entity ship, float scale) {
+    float length = SHIP_LENGTH * scale;
+    float width = SHIP_WIDTH * scale;
+    float stern_angle = math_deg_to_rad(SHIP_STERN_ANGLE);
+    collision_set_hull(world, ship,
+                       length * SHIP_BOW_LENGTH_MULT,
+                       -cosf(stern_angle) * width * SHIP_STERN_WIDTH_MULT,
+                       sinf(stern_angle) * width * SHIP_STERN_WIDTH_MULT,
+                       1.0f, COLLISION_LAYER_SHIPS, COLLISION_LAYER_SHIPS);
+}
+
 Entity game_create_player_ship(GameEcsState* state, float x, float y, float heading) {
     if (!state || !state->ecs_world) return INVALID_ENTITY;
     
@@ -76,6 +79,8 @@ Entity game_create_player_ship(GameEcsState* state, float x, float y, float head
     ecs_add_component(state->ecs_world, ship, COMPONENT_VELOCITY);
     ecs_add_component(state->ecs_world, ship, COMPONENT_SHIP);  // COMPONENT_GAME_0
     ecs_add_component(state->ecs_world, ship, COMPONENT_RENDERABLE);
+    ecs_add_component(state->ecs_world, ship, COMPONENT_TOUR);  // COMPONENT_GAME_3
+    set_ship_hull(state->ecs_world, ship, 1.0f);
     
     // Initialize transform
     ecs_set_position(state->ecs_world, ship, x, y);
@@ -99,12 +104,15 @@ Entity game_create_player_ship(GameEcsState* state, float x, float y, float head
     state->ship_world.ships.target_rudder[ship] = 0.0f;
     state->ship_world.ships.telegraph_order[ship] = 0;
     
+    // Every passenger ship runs its own tour
+    tour_ecs_start(&state->tour_world, ship);
+    
     // Initialize renderable
     state->ecs_world->renderables.visible[ship] = true;
-    state->ecs_world->renderables.layer[ship] = 1;  // Ships on layer 1
-    state->ecs_world->renderables.color_r[ship] = 200;
-    state->ecs_world->renderables.color_g[ship] = 200;
-    state->ecs_world->renderables.color_b[ship] = 200;
+    state->ecs_world->renderables.layer[ship] = SHIP_RENDER_LAYER;
+    state->ecs_world->renderables.color_r[ship] = SHIP_PLAYER_COLOR_R;
+    state->ecs_world->renderables.color_g[ship] = SHIP_PLAYER_COLOR_G;
+    state->ecs_world->renderables.color_b[ship] = SHIP_PLAYER_COLOR_B;
     state->ecs_world->renderables.color_a[ship] = 255;
     
     printf("Game ECS: Created player ship entity %u at (%.1f, %.1f)\n", ship, x, y);
@@ -118,8 +126,14 @@ Entity game_create_ai_ship(GameEcsState* state, float x, float y, float heading,
     Entity ship = game_create_player_ship(state, x, y, heading);
     if (ship == INVALID_ENTITY) return INVALID_ENTITY;
     
-    // Add AI component flag
+    // Add AI component flag (AI ships are drawn smaller)
     ecs_add_component(state->ecs_world, ship, COMPONENT_AI);  // COMPONENT_GAME_1
+    set_ship_hull(state->ecs_world, ship, SHIP_AI_SCALE);
+    state->ecs_world->transforms.scale_x[ship] = SHIP_AI_SCALE;
+    state->ecs_world->transforms.scale_y[ship] = SHIP_AI_SCALE;
+    state->ecs_world->renderables.color_r[ship] = SHIP_AI_COLOR_R;
+    state->ecs_world->renderables.color_g[ship] = SHIP_AI_COLOR_G;
+    state->ecs_world->renderables.color_b[ship] = SHIP_AI_COLOR_B;
     
     // Initialize AI in game-layer AI world
     ai_ecs_setup(&state->ai_world, ship, route_id);
@@ -216,27 +230,147 @@ float game_ecs_get_ship_angular_velocity(const GameEcsState* state, Entity ship)
 void game_ecs_update(GameEcsState* state, float delta_time) {
     if (!state || !state->ecs_world) return;
     
-    // 1. Update AI (sets throttle/rudder targets for AI ships)
+    // 1. Update AI (sets throttle/rudder targets for AI ships), steering
+    //    away from land ahead
     ai_ecs_system_update(state->ecs_world, &state->ai_world, delta_time);
+    ai_ecs_system_lookahead(state->ecs_world, &state->ai_world, &state->ship_world, &state->coast);
     
     // 2. Update ship physics (converts throttle/rudder to velocity)
     ship_ecs_system_physics(state->ecs_world, &state->ship_world, delta_time);
     
-    // 3. Update movement (applies velocity to transform)
+    // 3. Update movement (applies velocity to transform), push apart
+    //    ships whose hulls overlap and stop ships running aground
     ecs_system_movement(state->ecs_world, delta_time);
+    collision_system_update(&state->collision, state->ecs_world, state->jobs);
+    coastline_system_grounding(&state->coast, state->ecs_world, COMPONENT_SHIP, delta_time);
+    
+    // 4. Update POI enter/exit events
+    poi_ecs_system_update(&state->poi_world, state->ecs_world, COMPONENT_SHIP);
     
-    // 4. Update POI visits
-    POISystemContext poi_ctx = {
-        .on_visit = on_poi_visit,
-        .user_data = state
-    };
-    poi_ecs_system_update(&state->poi_world, state->ecs_world, COMPONENT_SHIP, &poi_ctx);
+    // 5. Apply visits to every ship's tour and rescore the fleet
+    satisfaction_system_update(&state->tour_world, state->ecs_world,
+                               &state->poi_world, &state->poi_events);
     
-    // 5. Update fog of war
+    // 6. Update fog of war
     fog_system_update(&state->fog, &state->poi_world, state->ecs_world, 
                       COMPONENT_SHIP, delta_time);
 }
 
+void game_ecs_update_adaptive(GameEcsState* state, float base_dt, uint32_t steps) {
+    if (!state || !state->ecs_world) return;
+    if (steps <= 1) {
+        game_ecs_update(state, base_dt);
+        return;
+    }
+    
+    ECSWorld* world = state->ecs_world;
+    float delta_time = base_dt * (float)steps;
+    
+    // 1. AI and lookahead once for the whole span
+    ai_ecs_system_update(world, &state->ai_world, delta_time);
+    ai_ecs_system_lookahead(world, &state->ai_world, &state->ship_world, &state->coast);
+    
+    // 2. Ships that are turning, changing speed or berthing need base steps
+    Entity fine[MAX_ENTITIES];
+    uint32_t fine_count = 0;
+    ComponentMask ship_mask = COMPONENT_TRANSFORM | COMPONENT_VELOCITY | COMPONENT_SHIP;
+    for (Entity e = 1; e < MAX_ENTITIES; e++) {
+        if ((world->entity_masks[e] & ship_mask) != ship_mask) continue;
+        
+        bool berthing = ecs_has_component(world, e, COMPONENT_AI) &&
+                        (state->ai_world.ai.ai_state[e] == AI_STATE_DOCKING ||
+                         state->ai_world.ai.ai_state[e] == AI_STATE_UNDOCKING);
+        if (berthing || !ship_ecs_is_steady(world, &state->ship_world, e)) {
+            fine[fine_count++] = e;
+        }
+    }
+    
+    // 3. Coarse physics and movement for everyone, then the fine ships redone
+    ship_ecs_substep_begin(world, &state->ship_world, fine, fine_count);
+    ship_ecs_system_physics(world, &state->ship_world, delta_time);
+    ecs_system_movement(world, delta_time);
+    ship_ecs_substep_end(world, &state->ship_world, base_dt, steps);
+    collision_system_update(&state->collision, world, state->jobs);
+    coastline_system_grounding(&state->coast, world, COMPONENT_SHIP, delta_time);
+    
+    // 4-6. POIs, satisfaction and fog once for the whole span
+    poi_ecs_system_update(&state->poi_world, world, COMPONENT_SHIP);
+    satisfaction_system_update(&state->tour_world, world,
+                               &state->poi_world, &state->poi_events);
+    fog_system_update(&state->fog, &state->poi_world, world, COMPONENT_SHIP, delta_time);
+}
+
+float game_ecs_max_step_travel(const GameEcsState* state) {
+    if (!state) return GAME_ECS_MAX_STEP_TRAVEL;
+    float min_radius = state->poi_world.min_radius;
+    if (min_radius <= 0.0f) return GAME_ECS_MAX_STEP_TRAVEL;
+    return math_min(min_radius * GAME_ECS_STEP_TRAVEL_RADIUS_SCALE, GAME_ECS_MAX_STEP_TRAVEL);
+}
+
+uint32_t game_ecs_adaptive_steps(const GameEcsState* state, float base_dt, uint32_t max_steps) {
+    if (max_steps <= 1 || !state || !state->ecs_world || base_dt <= 0.0f) return 1;
+    const ECSWorld* world = state->ecs_world;
+    const ShipComponents* ships = &state->ship_world.ships;
+    
+    // Over the longest span a ship can gain at most acceleration * span, and
+    // thrust stops at max speed (only a collision can push it faster)
+    float span = base_dt * (float)max_steps;
+    float fastest = 0.0f;
+    ComponentMask ship_mask = COMPONENT_TRANSFORM | COMPONENT_VELOCITY | COMPONENT_SHIP;
+    for (Entity e = 1; e < MAX_ENTITIES; e++) {
+        if ((world->entity_masks[e] & ship_mask) != ship_mask) continue;
+        float speed = math_abs(world->velocities.speed[e]);
+        float reachable = math_min(speed + ships->acceleration[e] * span, ships->max_speed[e]);
+        speed = math_max(speed, reachable);
+        if (speed > fastest) fastest = speed;
+    }
+    if (fastest <= 0.0f) return max_steps;
+    
+    float steps = game_ecs_max_step_travel(state) / (fastest * base_dt);
+    if (steps < 1.0f) return 1;
+    return steps >= (float)max_steps ? max_steps : (uint32_t)steps;
+}
+
+uint64_t game_hash_words(uint64_t hash, const void* data, size_t word_count) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < word_count; i++) {
+        uint32_t word;
+        memcpy(&word, bytes + i * sizeof(uint32_t), sizeof(uint32_t));
+        hash ^= word;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t game_ecs_hash(const GameEcsState* state) {
+    uint64_t hash = GAME_HASH_SEED;
+    if (!state || !state->ecs_world) return hash;
+    
+    const ECSWorld* world = state->ecs_world;
+    const ShipComponents* ships = &state->ship_world.ships;
+    const TourComponents* tours = &state->tour_world.tours;
+    for (Entity e = 0; e < MAX_ENTITIES; e++) {
+        if (world->entity_masks[e] == 0) continue;
+        
+        uint32_t words[16];
+        float floats[11] = {
+            world->transforms.pos_x[e], world->transforms.pos_y[e], world->transforms.rotation[e],
+            world->velocities.vel_x[e], world->velocities.vel_y[e],
+            world->velocities.angular_vel[e], world->velocities.speed[e],
+            ships->throttle[e], ships->target_throttle[e],
+            ships->rudder[e], ships->target_rudder[e],
+        };
+        words[0] = e;
+        words[1] = (uint32_t)world->entity_masks[e];
+        memcpy(&words[2], floats, sizeof(floats));
+        words[13] = (uint32_t)tours->score[e];
+        words[14] = tours->visited_count[e];
+        words[15] = tours->type_mask[e];
+        hash = game_hash_words(hash, words, 16);
+    }
+    return hash;
+}
+
 // =============================================================================
 // Compatibility Bridge
 // =============================================================================
@@ -302,10 +436,24 @@ bool game_ecs_load_pois(GameEcsState* state, const char* filepath) {
         return false;
     }
     
+    tour_ecs_rebuild_tables(&state->tour_world, &state->poi_world);
     printf("Game ECS: Loaded %u POIs\n", poi_ecs_get_count(&state->poi_world));
     return true;
 }
 
+bool game_ecs_load_coastline(GameEcsState* state, const char* filepath) {
+    if (!state) return false;
+    
+    if (!coastline_load_from_file(&state->coast, filepath)) {
+        printf("Game ECS: No coastline loaded from '%s', open water\n",
+               filepath ? filepath : "(default)");
+        return false;
+    }
+    
+    printf("Game ECS: Loaded %u islands\n", state->coast.island_count);
+    return true;
+}
+
 POIEcsWorld* game_ecs_get_poi_world(GameEcsState* state) {
     if (!state) return NULL;
     return &state->poi_world;
@@ -326,12 +474,12 @@ const FogOfWarState* game_ecs_get_fog_const(const GameEcsState* state) {
     return &state->fog;
 }
 
-TourSatisfaction* game_ecs_get_tour(GameEcsState* state) {
+TourEcsWorld* game_ecs_get_tour_world(GameEcsState* state) {
     if (!state) return NULL;
-    return &state->tour;
+    return &state->tour_world;
 }
 
-const TourSatisfaction* game_ecs_get_tour_const(const GameEcsState* state) {
+const TourEcsWorld* game_ecs_get_tour_world_const(const GameEcsState* state) {
     if (!state) return NULL;
-    return &state->tour;
+    return &state->tour_world;
 }
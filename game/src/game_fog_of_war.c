@@ -1,7 +1,9 @@
 #include "game_fog_of_war.h"
 #include "engine_math.h"
 #include <string.h>
+#include <stdlib.h>
 #include <math.h>
+#include <stdio.h>
 
 // =============================================================================
 // Lifecycle
@@ -21,25 +23,59 @@ void fog_init(FogOfWarState* fog) {
     // Initialize spatial hash for chunk lookups (capacity for max chunks * 2 for good load factor)
     spatial_hash_init(&fog->chunk_map, FOG_MAX_CHUNKS * 2);
     
-    // Start all POIs as hidden with full fog
-    for (int i = 0; i < MAX_POIS; i++) {
-        fog->poi_visibility[i] = VISIBILITY_HIDDEN;
-        fog->poi_fog_alpha[i] = 1.0f;
-    }
-    
     fog->initialized = true;
+    
+    // Start all POIs as hidden with full fog
+    fog_reserve_pois(fog, POI_INITIAL_CAPACITY);
 }
 
 void fog_shutdown(FogOfWarState* fog) {
     if (!fog) return;
     spatial_hash_shutdown(&fog->chunk_map);
+    free(fog->poi_fog_alpha);
+    fog->poi_fog_alpha = NULL;
+    fog->poi_visibility = NULL;
+    fog->poi_capacity = 0;
     fog->initialized = false;
 }
 
+bool fog_reserve_pois(FogOfWarState* fog, uint32_t capacity) {
+    if (!fog || !fog->initialized) return false;
+    if (capacity <= fog->poi_capacity) return true;
+    
+    // Grow geometrically; alpha and visibility share one block
+    uint32_t new_capacity = fog->poi_capacity ? fog->poi_capacity : POI_INITIAL_CAPACITY;
+    while (new_capacity < capacity) new_capacity *= 2;
+    
+    uint8_t* block = (uint8_t*)malloc(new_capacity * (sizeof(float) + sizeof(uint8_t)));
+    if (!block) {
+        printf("Fog: Failed to allocate visibility for %u POIs\n", new_capacity);
+        return false;
+    }
+    float* alpha = (float*)block;
+    uint8_t* visibility = block + new_capacity * sizeof(float);
+    
+    uint32_t old = fog->poi_capacity;
+    if (old > 0) {
+        memcpy(alpha, fog->poi_fog_alpha, old * sizeof(float));
+        memcpy(visibility, fog->poi_visibility, old * sizeof(uint8_t));
+    }
+    for (uint32_t i = old; i < new_capacity; i++) {
+        alpha[i] = 1.0f;
+        visibility[i] = VISIBILITY_HIDDEN;
+    }
+    
+    free(fog->poi_fog_alpha);
+    fog->poi_fog_alpha = alpha;
+    fog->poi_visibility = visibility;
+    fog->poi_capacity = new_capacity;
+    return true;
+}
+
 void fog_reset(FogOfWarState* fog) {
     if (!fog || !fog->initialized) return;
     
-    for (int i = 0; i < MAX_POIS; i++) {
+    for (uint32_t i = 0; i < fog->poi_capacity; i++) {
         fog->poi_visibility[i] = VISIBILITY_HIDDEN;
         fog->poi_fog_alpha[i] = 1.0f;
     }
@@ -139,23 +175,28 @@ void fog_set_prototype_mode(FogOfWarState* fog, bool enabled) {
     fog->prototype_mode = enabled;
 }
 
+void fog_set_occluders(FogOfWarState* fog, const SegmentBvh* occluders) {
+    if (!fog || !fog->initialized) return;
+    fog->occluders = occluders;
+}
+
 // =============================================================================
 // Visibility Queries
 // =============================================================================
 
 VisibilityState fog_get_poi_visibility(const FogOfWarState* fog, int poi_index) {
     if (!fog || !fog->initialized) return VISIBILITY_HIDDEN;
-    if (poi_index < 0 || poi_index >= MAX_POIS) return VISIBILITY_HIDDEN;
+    if (poi_index < 0 || (uint32_t)poi_index >= fog->poi_capacity) return VISIBILITY_HIDDEN;
     
     // In prototype mode, POIs are always at least "on the map" for navigation
     // but visibility state still tracks whether they've been approached
     // Return actual visibility state - the rendering code handles fogged icons
-    return fog->poi_visibility[poi_index];
+    return (VisibilityState)fog->poi_visibility[poi_index];
 }
 
 float fog_get_poi_alpha(const FogOfWarState* fog, int poi_index) {
     if (!fog || !fog->initialized) return 1.0f;
-    if (poi_index < 0 || poi_index >= MAX_POIS) return 1.0f;
+    if (poi_index < 0 || (uint32_t)poi_index >= fog->poi_capacity) return 1.0f;
     
     if (!fog->enabled) return 0.0f;  // No fog when disabled
     
@@ -223,6 +264,13 @@ void fog_reveal_area(FogOfWarState* fog, float x, float y, float radius) {
     world_to_chunk(max_x, max_y, &max_chunk_x, &max_chunk_y);
     
     float radius_sq = radius * radius;
+    bool occluded = fog->occluders && fog->occluders->segment_count > 0;
+    
+    // Cells of one chunk within radius, for one batched line-of-sight query
+    float target_x[FOG_CHUNK_SIZE * FOG_CHUNK_SIZE];
+    float target_y[FOG_CHUNK_SIZE * FOG_CHUNK_SIZE];
+    uint16_t target_cell[FOG_CHUNK_SIZE * FOG_CHUNK_SIZE];
+    uint8_t crossings[FOG_CHUNK_SIZE * FOG_CHUNK_SIZE];
     
     // Iterate over all affected chunks
     for (int cy = min_chunk_y; cy <= max_chunk_y; cy++) {
@@ -245,7 +293,8 @@ void fog_reveal_area(FogOfWarState* fog, float x, float y, float radius) {
             cell_max_x = math_clamp_int(cell_max_x, 0, FOG_CHUNK_SIZE - 1);
             cell_max_y = math_clamp_int(cell_max_y, 0, FOG_CHUNK_SIZE - 1);
             
-            // Mark cells within radius
+            // Gather cells within radius
+            uint32_t target_count = 0;
             for (int cell_y = cell_min_y; cell_y <= cell_max_y; cell_y++) {
                 for (int cell_x = cell_min_x; cell_x <= cell_max_x; cell_x++) {
                     // Cell center in world coords
@@ -254,17 +303,35 @@ void fog_reveal_area(FogOfWarState* fog, float x, float y, float radius) {
                     
                     float dist_sq = math_distance_sq(x, y, cell_world_x, cell_world_y);
                     if (dist_sq <= radius_sq) {
-                        chunk->cells[cell_y][cell_x] = 1;
+                        target_x[target_count] = cell_world_x;
+                        target_y[target_count] = cell_world_y;
+                        target_cell[target_count] = (uint16_t)(cell_y * FOG_CHUNK_SIZE + cell_x);
+                        target_count++;
                     }
                 }
             }
+            
+            // Sight lines crossing the shore twice went through an island;
+            // one crossing ends on its near shore, which stays visible
+            if (occluded) {
+                segment_bvh_fan_crossings(fog->occluders, x, y, target_x, target_y,
+                                          target_count, 2, crossings);
+            } else {
+                memset(crossings, 0, target_count);
+            }
+            
+            for (uint32_t i = 0; i < target_count; i++) {
+                if (crossings[i] < 2) {
+                    chunk->cells[target_cell[i] / FOG_CHUNK_SIZE][target_cell[i] % FOG_CHUNK_SIZE] = 1;
+                }
+            }
         }
     }
 }
 
 void fog_reveal_poi(FogOfWarState* fog, int poi_index) {
     if (!fog || !fog->initialized) return;
-    if (poi_index < 0 || poi_index >= MAX_POIS) return;
+    if (poi_index < 0 || !fog_reserve_pois(fog, (uint32_t)poi_index + 1)) return;
     
     fog->poi_visibility[poi_index] = VISIBILITY_VISIBLE;
     fog->poi_fog_alpha[poi_index] = 0.0f;
@@ -272,7 +339,7 @@ void fog_reveal_poi(FogOfWarState* fog, int poi_index) {
 
 void fog_discover_poi(FogOfWarState* fog, int poi_index) {
     if (!fog || !fog->initialized) return;
-    if (poi_index < 0 || poi_index >= MAX_POIS) return;
+    if (poi_index < 0 || !fog_reserve_pois(fog, (uint32_t)poi_index + 1)) return;
     
     // Only upgrade from hidden
     if (fog->poi_visibility[poi_index] == VISIBILITY_HIDDEN) {
@@ -284,6 +351,7 @@ void fog_reveal_all(FogOfWarState* fog, const POIEcsWorld* poi_world) {
     if (!fog || !fog->initialized || !poi_world) return;
     
     uint32_t count = poi_ecs_get_count(poi_world);
+    if (!fog_reserve_pois(fog, count)) return;
     for (uint32_t i = 0; i < count; i++) {
         fog->poi_visibility[i] = VISIBILITY_VISIBLE;
         fog->poi_fog_alpha[i] = 0.0f;
@@ -300,6 +368,9 @@ void fog_system_update(FogOfWarState* fog, const POIEcsWorld* poi_world,
     if (!fog || !fog->initialized || !poi_world || !ecs_world) return;
     if (!fog->enabled) return;
     
+    // Keep per-POI arrays sized with the POI world
+    if (!fog_reserve_pois(fog, poi_ecs_get_capacity(poi_world))) return;
+    
     float reveal_radius_sq = fog->reveal_radius * fog->reveal_radius;
     float discovery_radius_sq = fog->discovery_radius * fog->discovery_radius;
     
@@ -397,7 +468,7 @@ void fog_get_render_color(const FogOfWarState* fog, int poi_index,
     if (a) *a = 255;
     
     if (!fog || !fog->initialized) return;
-    if (poi_index < 0 || poi_index >= MAX_POIS) return;
+    if (poi_index < 0 || (uint32_t)poi_index >= fog->poi_capacity) return;
     
     float alpha = fog_get_poi_alpha(fog, poi_index);
     if (a) *a = (unsigned char)(alpha * 255.0f);
@@ -0,0 +1,172 @@
+#include "game_poi_cooked.h"
+#include "engine_file_map.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The file stores bool columns byte for byte
+_Static_assert(sizeof(bool) == 1, "cooked POI format assumes 1-byte bool");
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static uint64_t align_up(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Copy the first count entries of every column into a block laid out for capacity = count
+static void pack_columns(const POIComponents* src, uint8_t* block, uint32_t count) {
+    POIComponents dst;
+    poi_ecs_layout_columns(&dst, block, count);
+    if (count == 0) return;
+
+    memcpy(dst.pos_x, src->pos_x, count * sizeof(float));
+    memcpy(dst.pos_y, src->pos_y, count * sizeof(float));
+    memcpy(dst.radius, src->radius, count * sizeof(float));
+    memcpy(dst.type, src->type, count * sizeof(uint8_t));
+    memcpy(dst.tier, src->tier, count * sizeof(uint8_t));
+    memcpy(dst.satisfaction_bonus, src->satisfaction_bonus, count * sizeof(int32_t));
+    memcpy(dst.visited, src->visited, count * sizeof(bool));
+    memcpy(dst.discovered, src->discovered, count * sizeof(bool));
+    memcpy(dst.visit_count, src->visit_count, count * sizeof(uint32_t));
+    memcpy(dst.id_offset, src->id_offset, count * sizeof(uint32_t));
+    memcpy(dst.name_offset, src->name_offset, count * sizeof(uint32_t));
+    memcpy(dst.description_offset, src->description_offset, count * sizeof(uint32_t));
+}
+
+static bool header_is_valid(const POICookedHeader* header, size_t file_size) {
+    POIComponents sizing;
+    uint64_t columns_size = poi_ecs_layout_columns(&sizing, NULL, header->poi_count);
+
+    if (header->header_size != sizeof(POICookedHeader)) return false;
+    if (header->column_alignment != POI_COLUMN_ALIGNMENT) return false;
+    if (header->file_size != file_size) return false;
+    if (header->columns_size != columns_size) return false;
+    if (header->columns_offset % POI_COLUMN_ALIGNMENT != 0) return false;
+    if (header->columns_offset < sizeof(POICookedHeader)) return false;
+    if (header->strings_offset < header->columns_offset + header->columns_size) return false;
+    if (header->string_bytes == 0) return false;
+    if (header->strings_offset + header->string_bytes > file_size) return false;
+    return true;
+}
+
+// =============================================================================
+// Writing
+// =============================================================================
+
+bool poi_cooked_write(const POIEcsWorld* poi_world, const char* filepath) {
+    if (!poi_world || !poi_world->initialized || !filepath) return false;
+
+    uint32_t count = poi_world->poi_count;
+    POIComponents sizing;
+    size_t columns_size = poi_ecs_layout_columns(&sizing, NULL, count);
+
+    POICookedHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = POI_COOKED_MAGIC;
+    header.version = POI_COOKED_VERSION;
+    header.header_size = sizeof(POICookedHeader);
+    header.column_alignment = POI_COLUMN_ALIGNMENT;
+    header.poi_count = count;
+    header.string_bytes = string_arena_size(&poi_world->strings);
+    header.columns_offset = align_up(sizeof(POICookedHeader), POI_COLUMN_ALIGNMENT);
+    header.columns_size = columns_size;
+    header.strings_offset = header.columns_offset + columns_size;
+    header.file_size = header.strings_offset + header.string_bytes;
+
+    uint8_t* columns = (uint8_t*)calloc(1, columns_size ? columns_size : 1);
+    if (!columns) return false;
+    pack_columns(&poi_world->pois, columns, count);
+
+    FILE* file = fopen(filepath, "wb");
+    if (!file) {
+        free(columns);
+        printf("[POI Cooker] Failed to open %s for writing\n", filepath);
+        return false;
+    }
+
+    static const uint8_t padding[POI_COLUMN_ALIGNMENT] = {0};
+    size_t pad = (size_t)(header.columns_offset - sizeof(POICookedHeader));
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              (pad == 0 || fwrite(padding, 1, pad, file) == pad) &&
+              (columns_size == 0 || fwrite(columns, 1, columns_size, file) == columns_size) &&
+              fwrite(poi_world->strings.data, 1, header.string_bytes, file) == header.string_bytes;
+    ok = (fclose(file) == 0) && ok;
+    free(columns);
+
+    if (!ok) {
+        printf("[POI Cooker] Failed to write %s\n", filepath);
+        remove(filepath);
+    }
+    return ok;
+}
+
+// =============================================================================
+// Loading
+// =============================================================================
+
+POILoadResult poi_load_cooked(POIEcsWorld* poi_world, const char* filepath) {
+    if (!poi_world || !poi_world->initialized) {
+        return POI_LOAD_WORLD_NOT_INITIALIZED;
+    }
+
+    FileMap map;
+    if (!file_map_open(&map, filepath)) {
+        return POI_LOAD_FILE_NOT_FOUND;
+    }
+
+    const POICookedHeader* header = (const POICookedHeader*)map.data;
+    if (map.size < sizeof(POICookedHeader) || header->magic != POI_COOKED_MAGIC) {
+        file_map_close(&map);
+        return POI_LOAD_INVALID_SCHEMA;
+    }
+    if (header->version != POI_COOKED_VERSION) {
+        printf("[POI Loader] Cooked data version %u, expected %u: %s\n",
+               header->version, POI_COOKED_VERSION, filepath);
+        file_map_close(&map);
+        return POI_LOAD_VERSION_MISMATCH;
+    }
+    if (!header_is_valid(header, map.size)) {
+        file_map_close(&map);
+        return POI_LOAD_INVALID_SCHEMA;
+    }
+
+    uint8_t* base = (uint8_t*)map.data;
+    uint32_t count = header->poi_count;
+    if (!poi_ecs_adopt_storage(poi_world, &map, base + header->columns_offset, count,
+                               (char*)base + header->strings_offset, header->string_bytes)) {
+        file_map_close(&map);
+        return POI_LOAD_INVALID_SCHEMA;
+    }
+
+    printf("[POI Loader] Mapped %u cooked POIs from: %s\n", count, filepath);
+    return POI_LOAD_SUCCESS;
+}
+
+// =============================================================================
+// Paths
+// =============================================================================
+
+bool poi_cooked_path_for(const char* json_path, char* out_path, size_t out_size) {
+    if (!json_path || !out_path || out_size == 0) return false;
+
+    // Replace the extension of the last path component, if any
+    size_t len = strlen(json_path);
+    const char* dot = strrchr(json_path, '.');
+    const char* slash = strrchr(json_path, '/');
+    const char* backslash = strrchr(json_path, '\\');
+    if (backslash && (!slash || backslash > slash)) slash = backslash;
+    if (dot && (!slash || dot > slash)) len = (size_t)(dot - json_path);
+
+    int written = snprintf(out_path, out_size, "%.*s%s", (int)len, json_path, POI_COOKED_EXTENSION);
+    return written > 0 && (size_t)written < out_size;
+}
+
+bool poi_cooked_is_current(const char* cooked_path, const char* json_path) {
+    int64_t cooked_time = 0;
+    int64_t json_time = 0;
+    if (!file_get_modified_time(cooked_path, &cooked_time)) return false;
+    if (!json_path || !file_get_modified_time(json_path, &json_time)) return true;
+    return cooked_time >= json_time;
+}
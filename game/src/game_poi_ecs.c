@@ -2,36 +2,205 @@
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 // =============================================================================
 // POI ECS Lifecycle
 // =============================================================================
 
+// Generations come from one counter, so no two worlds share a value
+static uint32_t g_poi_generation;
+
+static void poi_ecs_touch(POIEcsWorld* poi_world) {
+    poi_world->generation = ++g_poi_generation;
+    if (poi_world->generation == 0) poi_world->generation = ++g_poi_generation;
+}
+
 void poi_ecs_init(POIEcsWorld* poi_world) {
     if (!poi_world) return;
     
     memset(poi_world, 0, sizeof(POIEcsWorld));
-    poi_world->initialized = true;
-    
-    // Set all POIs as undiscovered by default
-    for (int i = 0; i < MAX_POIS; i++) {
-        poi_world->pois.discovered[i] = false;
-        poi_world->pois.visited[i] = false;
+    spatial_grid_init(&poi_world->spatial_index);
+    if (!string_arena_init(&poi_world->strings, POI_STRING_ARENA_INITIAL_SIZE) ||
+        !string_index_init(&poi_world->name_index, POI_INITIAL_CAPACITY) ||
+        !string_index_init(&poi_world->id_index, POI_INITIAL_CAPACITY) ||
+        !event_ring_init(&poi_world->events, sizeof(POIEvent), POI_EVENT_CAPACITY)) {
+        printf("POI ECS: Failed to allocate string storage\n");
+        string_arena_shutdown(&poi_world->strings);
+        string_index_shutdown(&poi_world->name_index);
+        string_index_shutdown(&poi_world->id_index);
+        return;
     }
+    poi_world->initialized = true;
+    poi_ecs_touch(poi_world);
 }
 
 void poi_ecs_shutdown(POIEcsWorld* poi_world) {
     if (!poi_world) return;
     
+    spatial_grid_shutdown(&poi_world->spatial_index);
+    string_index_shutdown(&poi_world->name_index);
+    string_index_shutdown(&poi_world->id_index);
+    string_arena_shutdown(&poi_world->strings);
+    free(poi_world->storage);
+    file_map_close(&poi_world->mapped_file);
+    
+    for (uint32_t s = 0; s < poi_world->presence_capacity; s++) {
+        bitset_shutdown(&poi_world->presence[s].inside);
+    }
+    free(poi_world->presence);
+    poi_world->presence = NULL;
+    poi_world->presence_count = 0;
+    poi_world->presence_capacity = 0;
+    memset(poi_world->presence_slot, 0, sizeof(poi_world->presence_slot));
+    event_ring_shutdown(&poi_world->events);
+    memset(&poi_world->pois, 0, sizeof(POIComponents));
+    poi_world->storage = NULL;
+    poi_world->capacity = 0;
     poi_world->initialized = false;
     poi_world->poi_count = 0;
+    poi_world->max_radius = 0.0f;
+    poi_world->min_radius = 0.0f;
+    poi_world->index_dirty = false;
 }
 
 void poi_ecs_clear(POIEcsWorld* poi_world) {
     if (!poi_world || !poi_world->initialized) return;
     
-    memset(&poi_world->pois, 0, sizeof(POIComponents));
     poi_world->poi_count = 0;
+    poi_ecs_touch(poi_world);
+    string_index_clear(&poi_world->name_index);
+    string_index_clear(&poi_world->id_index);
+    string_arena_clear(&poi_world->strings);
+    spatial_grid_clear(&poi_world->spatial_index);
+    poi_world->max_radius = 0.0f;
+    poi_world->min_radius = 0.0f;
+    poi_world->index_dirty = false;
+    
+    // Indices are about to be reused; forget presence without exit events
+    for (uint32_t s = 0; s < poi_world->presence_count; s++) {
+        bitset_clear_all(&poi_world->presence[s].inside);
+        poi_world->presence[s].inside_count = 0;
+    }
+    
+    // Mapped columns go away with the file; the next create reallocates
+    if (file_map_is_open(&poi_world->mapped_file)) {
+        if (!poi_world->storage) {
+            memset(&poi_world->pois, 0, sizeof(POIComponents));
+            poi_world->capacity = 0;
+        }
+        file_map_close(&poi_world->mapped_file);
+    }
+}
+
+// =============================================================================
+// POI Storage
+// =============================================================================
+
+// Reserve an aligned column of `bytes` at *offset; base may be NULL to size only
+static void* carve_column(uint8_t* base, size_t* offset, size_t bytes) {
+    void* column = base ? base + *offset : NULL;
+    *offset = (*offset + bytes + POI_COLUMN_ALIGNMENT - 1) & ~(size_t)(POI_COLUMN_ALIGNMENT - 1);
+    return column;
+}
+
+size_t poi_ecs_layout_columns(POIComponents* pois, uint8_t* base, uint32_t capacity) {
+    size_t offset = 0;
+    pois->pos_x = (float*)carve_column(base, &offset, capacity * sizeof(float));
+    pois->pos_y = (float*)carve_column(base, &offset, capacity * sizeof(float));
+    pois->radius = (float*)carve_column(base, &offset, capacity * sizeof(float));
+    pois->type = (uint8_t*)carve_column(base, &offset, capacity * sizeof(uint8_t));
+    pois->tier = (uint8_t*)carve_column(base, &offset, capacity * sizeof(uint8_t));
+    pois->satisfaction_bonus = (int32_t*)carve_column(base, &offset, capacity * sizeof(int32_t));
+    pois->visited = (bool*)carve_column(base, &offset, capacity * sizeof(bool));
+    pois->discovered = (bool*)carve_column(base, &offset, capacity * sizeof(bool));
+    pois->visit_count = (uint32_t*)carve_column(base, &offset, capacity * sizeof(uint32_t));
+    pois->id_offset = (uint32_t*)carve_column(base, &offset, capacity * sizeof(uint32_t));
+    pois->name_offset = (uint32_t*)carve_column(base, &offset, capacity * sizeof(uint32_t));
+    pois->description_offset = (uint32_t*)carve_column(base, &offset, capacity * sizeof(uint32_t));
+    return offset;
+}
+
+bool poi_ecs_reserve(POIEcsWorld* poi_world, uint32_t capacity) {
+    if (!poi_world || !poi_world->initialized) return false;
+    if (capacity <= poi_world->capacity) return true;
+    
+    POIComponents columns;
+    size_t bytes = poi_ecs_layout_columns(&columns, NULL, capacity);
+    
+    // Over-allocate so the first column can start on an aligned address
+    uint8_t* block = (uint8_t*)malloc(bytes + POI_COLUMN_ALIGNMENT);
+    if (!block) {
+        printf("POI ECS: Failed to allocate storage for %u POIs\n", capacity);
+        return false;
+    }
+    uint8_t* base = (uint8_t*)(((uintptr_t)block + POI_COLUMN_ALIGNMENT - 1) &
+                               ~(uintptr_t)(POI_COLUMN_ALIGNMENT - 1));
+    poi_ecs_layout_columns(&columns, base, capacity);
+    
+    // Move live entries over
+    uint32_t n = poi_world->poi_count;
+    if (n > 0) {
+        const POIComponents* old = &poi_world->pois;
+        memcpy(columns.pos_x, old->pos_x, n * sizeof(float));
+        memcpy(columns.pos_y, old->pos_y, n * sizeof(float));
+        memcpy(columns.radius, old->radius, n * sizeof(float));
+        memcpy(columns.type, old->type, n * sizeof(uint8_t));
+        memcpy(columns.tier, old->tier, n * sizeof(uint8_t));
+        memcpy(columns.satisfaction_bonus, old->satisfaction_bonus, n * sizeof(int32_t));
+        memcpy(columns.visited, old->visited, n * sizeof(bool));
+        memcpy(columns.discovered, old->discovered, n * sizeof(bool));
+        memcpy(columns.visit_count, old->visit_count, n * sizeof(uint32_t));
+        memcpy(columns.id_offset, old->id_offset, n * sizeof(uint32_t));
+        memcpy(columns.name_offset, old->name_offset, n * sizeof(uint32_t));
+        memcpy(columns.description_offset, old->description_offset, n * sizeof(uint32_t));
+    }
+    
+    free(poi_world->storage);  // NULL when moving off mapped columns
+    poi_world->storage = block;
+    poi_world->pois = columns;
+    poi_world->capacity = capacity;
+    return true;
+}
+
+bool poi_ecs_adopt_storage(POIEcsWorld* poi_world, FileMap* map, uint8_t* columns,
+                           uint32_t count, char* strings, uint32_t string_bytes) {
+    if (!poi_world || !poi_world->initialized || !map || !columns || !strings) return false;
+    
+    poi_ecs_clear(poi_world);
+    
+    StringArena arena;
+    if (!string_arena_init_external(&arena, strings, string_bytes)) {
+        printf("POI ECS: Invalid string data in mapped storage\n");
+        return false;
+    }
+    string_arena_shutdown(&poi_world->strings);
+    poi_world->strings = arena;
+    
+    free(poi_world->storage);
+    poi_world->storage = NULL;
+    poi_ecs_layout_columns(&poi_world->pois, columns, count);
+    poi_world->capacity = count;
+    poi_world->poi_count = count;
+    poi_world->mapped_file = *map;
+    memset(map, 0, sizeof(FileMap));
+    
+    // Lookup tables are not stored; rebuild them from the columns
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t id_offset = poi_world->pois.id_offset[i];
+        if (id_offset != STRING_ARENA_EMPTY) {
+            string_index_insert(&poi_world->id_index, &poi_world->strings, id_offset, i);
+        }
+        string_index_insert(&poi_world->name_index, &poi_world->strings, poi_world->pois.name_offset[i], i);
+    }
+    poi_ecs_rebuild_index(poi_world);
+    poi_ecs_touch(poi_world);
+    return true;
+}
+
+uint32_t poi_ecs_get_capacity(const POIEcsWorld* poi_world) {
+    if (!poi_world || !poi_world->initialized) return 0;
+    return poi_world->capacity;
 }
 
 // =============================================================================
@@ -40,25 +209,46 @@ void poi_ecs_clear(POIEcsWorld* poi_world) {
 
 int poi_ecs_create(POIEcsWorld* poi_world, const POICreateParams* params) {
     if (!poi_world || !poi_world->initialized || !params) return -1;
-    if (poi_world->poi_count >= MAX_POIS) return -1;
+    if (poi_world->poi_count >= poi_world->capacity) {
+        uint32_t grown = poi_world->capacity ? poi_world->capacity * 2 : POI_INITIAL_CAPACITY;
+        if (!poi_ecs_reserve(poi_world, grown)) return -1;
+    }
     
     int idx = (int)poi_world->poi_count;
     
-    // Copy name
+    // Ids must be unique
+    if (params->id && params->id[0] &&
+        string_index_find(&poi_world->id_index, &poi_world->strings, params->id) != STRING_INDEX_NOT_FOUND) {
+        printf("POI ECS: Duplicate POI id '%s'\n", params->id);
+        return -1;
+    }
+    
+    // Intern id, name and description
+    uint32_t id_offset = string_arena_intern(&poi_world->strings, params->id);
+    uint32_t name_offset;
     if (params->name) {
-        strncpy(poi_world->pois.name[idx], params->name, POI_NAME_MAX_LENGTH - 1);
-        poi_world->pois.name[idx][POI_NAME_MAX_LENGTH - 1] = '\0';
+        name_offset = string_arena_intern(&poi_world->strings, params->name);
     } else {
-        snprintf(poi_world->pois.name[idx], POI_NAME_MAX_LENGTH, "POI_%d", idx);
+        char fallback[32];
+        snprintf(fallback, sizeof(fallback), "POI_%d", idx);
+        name_offset = string_arena_intern(&poi_world->strings, fallback);
+    }
+    uint32_t description_offset = string_arena_intern(&poi_world->strings, params->description);
+    if (id_offset == STRING_ARENA_INVALID || name_offset == STRING_ARENA_INVALID ||
+        description_offset == STRING_ARENA_INVALID) {
+        return -1;
     }
     
-    // Copy description
-    if (params->description) {
-        strncpy(poi_world->pois.description[idx], params->description, POI_DESCRIPTION_MAX_LENGTH - 1);
-        poi_world->pois.description[idx][POI_DESCRIPTION_MAX_LENGTH - 1] = '\0';
-    } else {
-        poi_world->pois.description[idx][0] = '\0';
+    // Index id and name. Duplicate names keep the first POI indexed.
+    if (id_offset != STRING_ARENA_EMPTY &&
+        !string_index_insert(&poi_world->id_index, &poi_world->strings, id_offset, (uint32_t)idx)) {
+        return -1;
     }
+    string_index_insert(&poi_world->name_index, &poi_world->strings, name_offset, (uint32_t)idx);
+    
+    poi_world->pois.id_offset[idx] = id_offset;
+    poi_world->pois.name_offset[idx] = name_offset;
+    poi_world->pois.description_offset[idx] = description_offset;
     
     // Set classification
     poi_world->pois.type[idx] = (uint8_t)params->type;
@@ -84,20 +274,74 @@ int poi_ecs_create(POIEcsWorld* poi_world, const POICreateParams* params) {
     poi_world->pois.discovered[idx] = true;  // All visible for prototype
     poi_world->pois.visit_count[idx] = 0;
     
+    if (poi_world->pois.radius[idx] > poi_world->max_radius) {
+        poi_world->max_radius = poi_world->pois.radius[idx];
+    }
+    if (poi_world->poi_count == 0 || poi_world->pois.radius[idx] < poi_world->min_radius) {
+        poi_world->min_radius = poi_world->pois.radius[idx];
+    }
+    
     poi_world->poi_count++;
+    poi_world->index_dirty = true;
+    poi_ecs_touch(poi_world);
     return idx;
 }
 
+// Case-insensitive name comparison
+static bool names_equal(const char* a, const char* b) {
+    #ifdef _WIN32
+    return _stricmp(a, b) == 0;
+    #else
+    return strcasecmp(a, b) == 0;
+    #endif
+}
+
 void poi_ecs_destroy(POIEcsWorld* poi_world, int poi_index) {
     if (!poi_world || !poi_world->initialized) return;
     if (poi_index < 0 || poi_index >= (int)poi_world->poi_count) return;
     
-    // Swap with last element if not already last
     int last = (int)poi_world->poi_count - 1;
+    const char* id = string_arena_get(&poi_world->strings, poi_world->pois.id_offset[poi_index]);
+    const char* name = string_arena_get(&poi_world->strings, poi_world->pois.name_offset[poi_index]);
+    
+    // Drop this POI from the lookup indices
+    if (id[0]) {
+        string_index_remove(&poi_world->id_index, &poi_world->strings, id);
+    }
+    if (string_index_find(&poi_world->name_index, &poi_world->strings, name) == (uint32_t)poi_index) {
+        string_index_remove(&poi_world->name_index, &poi_world->strings, name);
+        
+        // Re-point the name at another POI sharing it, if any (rare; O(N))
+        for (int i = 0; i < (int)poi_world->poi_count; i++) {
+            if (i == poi_index) continue;
+            uint32_t other = poi_world->pois.name_offset[i];
+            if (names_equal(string_arena_get(&poi_world->strings, other), name)) {
+                string_index_insert(&poi_world->name_index, &poi_world->strings, other, (uint32_t)i);
+                break;
+            }
+        }
+    }
+    
+    // Presence follows the swap below: drop this POI, move `last` into its slot
+    for (uint32_t s = 0; s < poi_world->presence_count; s++) {
+        POIShipPresence* presence = &poi_world->presence[s];
+        if (bitset_test(&presence->inside, (uint32_t)poi_index)) {
+            bitset_reset(&presence->inside, (uint32_t)poi_index);
+            presence->inside_count--;
+        }
+        if (poi_index != last && bitset_test(&presence->inside, (uint32_t)last)) {
+            bitset_reset(&presence->inside, (uint32_t)last);
+            bitset_set(&presence->inside, (uint32_t)poi_index);
+        }
+    }
+    
+    // Swap with last element if not already last. Interned strings stay in
+    // the arena until the next clear (they may be shared with other POIs).
     if (poi_index != last) {
         // Copy last element to this position
-        memcpy(poi_world->pois.name[poi_index], poi_world->pois.name[last], POI_NAME_MAX_LENGTH);
-        memcpy(poi_world->pois.description[poi_index], poi_world->pois.description[last], POI_DESCRIPTION_MAX_LENGTH);
+        poi_world->pois.id_offset[poi_index] = poi_world->pois.id_offset[last];
+        poi_world->pois.name_offset[poi_index] = poi_world->pois.name_offset[last];
+        poi_world->pois.description_offset[poi_index] = poi_world->pois.description_offset[last];
         poi_world->pois.type[poi_index] = poi_world->pois.type[last];
         poi_world->pois.tier[poi_index] = poi_world->pois.tier[last];
         poi_world->pois.pos_x[poi_index] = poi_world->pois.pos_x[last];
@@ -107,9 +351,53 @@ void poi_ecs_destroy(POIEcsWorld* poi_world, int poi_index) {
         poi_world->pois.visited[poi_index] = poi_world->pois.visited[last];
         poi_world->pois.discovered[poi_index] = poi_world->pois.discovered[last];
         poi_world->pois.visit_count[poi_index] = poi_world->pois.visit_count[last];
+        
+        // Moved POI keeps its entries under the new index
+        const char* moved_id = string_arena_get(&poi_world->strings, poi_world->pois.id_offset[poi_index]);
+        const char* moved_name = string_arena_get(&poi_world->strings, poi_world->pois.name_offset[poi_index]);
+        if (moved_id[0]) {
+            string_index_set(&poi_world->id_index, &poi_world->strings, moved_id, (uint32_t)poi_index);
+        }
+        if (string_index_find(&poi_world->name_index, &poi_world->strings, moved_name) == (uint32_t)last) {
+            string_index_set(&poi_world->name_index, &poi_world->strings, moved_name, (uint32_t)poi_index);
+        }
     }
     
     poi_world->poi_count--;
+    poi_world->index_dirty = true;
+    poi_ecs_touch(poi_world);
+    
+    POIEvent event = {
+        .poi_index = (uint32_t)poi_index,
+        .moved_from = (uint32_t)last,
+        .type = (uint8_t)POI_EVENT_DESTROY,
+        .first_visit = false
+    };
+    event_ring_push(&poi_world->events, &event);
+}
+
+void poi_ecs_rebuild_index(POIEcsWorld* poi_world) {
+    if (!poi_world || !poi_world->initialized) return;
+    
+    // The radius bounds only widen on create; recompute so destroys can narrow them
+    float max_radius = 0.0f;
+    float min_radius = poi_world->poi_count > 0 ? poi_world->pois.radius[0] : 0.0f;
+    for (uint32_t i = 0; i < poi_world->poi_count; i++) {
+        if (poi_world->pois.radius[i] > max_radius) max_radius = poi_world->pois.radius[i];
+        if (poi_world->pois.radius[i] < min_radius) min_radius = poi_world->pois.radius[i];
+    }
+    poi_world->max_radius = max_radius;
+    poi_world->min_radius = min_radius;
+    
+    float cell_size = max_radius * 2.0f;
+    if (cell_size < POI_INDEX_MIN_CELL_SIZE) cell_size = POI_INDEX_MIN_CELL_SIZE;
+    
+    if (spatial_grid_build(&poi_world->spatial_index, poi_world->pois.pos_x,
+                           poi_world->pois.pos_y, poi_world->poi_count, cell_size)) {
+        poi_world->index_dirty = false;
+    } else {
+        printf("POI ECS: Failed to build spatial index for %u POIs\n", poi_world->poi_count);
+    }
 }
 
 // =============================================================================
@@ -121,14 +409,29 @@ uint32_t poi_ecs_get_count(const POIEcsWorld* poi_world) {
     return poi_world->poi_count;
 }
 
+uint32_t poi_ecs_get_generation(const POIEcsWorld* poi_world) {
+    if (!poi_world || !poi_world->initialized) return 0;
+    return poi_world->generation;
+}
+
 bool poi_ecs_is_valid(const POIEcsWorld* poi_world, int poi_index) {
     if (!poi_world || !poi_world->initialized) return false;
     return poi_index >= 0 && poi_index < (int)poi_world->poi_count;
 }
 
+const char* poi_ecs_get_id(const POIEcsWorld* poi_world, int poi_index) {
+    if (!poi_ecs_is_valid(poi_world, poi_index)) return "";
+    return string_arena_get(&poi_world->strings, poi_world->pois.id_offset[poi_index]);
+}
+
 const char* poi_ecs_get_name(const POIEcsWorld* poi_world, int poi_index) {
     if (!poi_ecs_is_valid(poi_world, poi_index)) return "";
-    return poi_world->pois.name[poi_index];
+    return string_arena_get(&poi_world->strings, poi_world->pois.name_offset[poi_index]);
+}
+
+const char* poi_ecs_get_description(const POIEcsWorld* poi_world, int poi_index) {
+    if (!poi_ecs_is_valid(poi_world, poi_index)) return "";
+    return string_arena_get(&poi_world->strings, poi_world->pois.description_offset[poi_index]);
 }
 
 POIType poi_ecs_get_type(const POIEcsWorld* poi_world, int poi_index) {
@@ -203,14 +506,42 @@ static float distance_squared(float x1, float y1, float x2, float y2) {
 int poi_ecs_find_at_position(const POIEcsWorld* poi_world, float x, float y) {
     if (!poi_world || !poi_world->initialized) return -1;
     
-    for (uint32_t i = 0; i < poi_world->poi_count; i++) {
-        float radius = poi_world->pois.radius[i];
-        float dist_sq = distance_squared(x, y, poi_world->pois.pos_x[i], poi_world->pois.pos_y[i]);
-        if (dist_sq <= radius * radius) {
-            return (int)i;
+    if (poi_world->index_dirty) {
+        for (uint32_t i = 0; i < poi_world->poi_count; i++) {
+            float radius = poi_world->pois.radius[i];
+            float dist_sq = distance_squared(x, y, poi_world->pois.pos_x[i], poi_world->pois.pos_y[i]);
+            if (dist_sq <= radius * radius) {
+                return (int)i;
+            }
+        }
+        return -1;
+    }
+    
+    // Candidates are POIs whose centre lies within max_radius of the point;
+    // keep the lowest index so overlapping POIs resolve as a scan would
+    SpatialGridSpan span;
+    float pad = poi_world->max_radius;
+    if (!spatial_grid_get_span(&poi_world->spatial_index, x - pad, y - pad, x + pad, y + pad, &span)) {
+        return -1;
+    }
+    
+    int best = -1;
+    for (int32_t cy = span.min_cy; cy <= span.max_cy; cy++) {
+        for (int32_t cx = span.min_cx; cx <= span.max_cx; cx++) {
+            uint32_t n;
+            const uint32_t* items = spatial_grid_cell_items(&poi_world->spatial_index, cx, cy, &n);
+            for (uint32_t k = 0; k < n; k++) {
+                uint32_t i = items[k];
+                if (best >= 0 && (int)i >= best) continue;
+                float radius = poi_world->pois.radius[i];
+                float dist_sq = distance_squared(x, y, poi_world->pois.pos_x[i], poi_world->pois.pos_y[i]);
+                if (dist_sq <= radius * radius) {
+                    best = (int)i;
+                }
+            }
         }
     }
-    return -1;
+    return best;
 }
 
 int poi_ecs_find_in_range(const POIEcsWorld* poi_world, float x, float y, float range,
@@ -220,31 +551,88 @@ int poi_ecs_find_in_range(const POIEcsWorld* poi_world, float x, float y, float
     int count = 0;
     float range_sq = range * range;
     
-    for (uint32_t i = 0; i < poi_world->poi_count && count < max_results; i++) {
-        float dist_sq = distance_squared(x, y, poi_world->pois.pos_x[i], poi_world->pois.pos_y[i]);
-        if (dist_sq <= range_sq) {
-            out_indices[count++] = (int)i;
+    if (poi_world->index_dirty) {
+        for (uint32_t i = 0; i < poi_world->poi_count && count < max_results; i++) {
+            float dist_sq = distance_squared(x, y, poi_world->pois.pos_x[i], poi_world->pois.pos_y[i]);
+            if (dist_sq <= range_sq) {
+                out_indices[count++] = (int)i;
+            }
+        }
+        return count;
+    }
+    
+    SpatialGridSpan span;
+    if (!spatial_grid_get_span(&poi_world->spatial_index, x - range, y - range, x + range, y + range, &span)) {
+        return 0;
+    }
+    
+    for (int32_t cy = span.min_cy; cy <= span.max_cy; cy++) {
+        for (int32_t cx = span.min_cx; cx <= span.max_cx; cx++) {
+            uint32_t n;
+            const uint32_t* items = spatial_grid_cell_items(&poi_world->spatial_index, cx, cy, &n);
+            for (uint32_t k = 0; k < n; k++) {
+                uint32_t i = items[k];
+                float dist_sq = distance_squared(x, y, poi_world->pois.pos_x[i], poi_world->pois.pos_y[i]);
+                if (dist_sq <= range_sq) {
+                    out_indices[count++] = (int)i;
+                    if (count >= max_results) return count;
+                }
+            }
         }
     }
     return count;
 }
 
-int poi_ecs_find_by_name(const POIEcsWorld* poi_world, const char* name) {
-    if (!poi_world || !poi_world->initialized || !name) return -1;
+int poi_ecs_find_in_rect(const POIEcsWorld* poi_world, float min_x, float min_y, float max_x, float max_y,
+                         int* out_indices, int max_results) {
+    if (!poi_world || !poi_world->initialized || !out_indices || max_results <= 0) return 0;
     
-    for (uint32_t i = 0; i < poi_world->poi_count; i++) {
-        // Case-insensitive comparison
-        #ifdef _WIN32
-        if (_stricmp(poi_world->pois.name[i], name) == 0) {
-            return (int)i;
+    int count = 0;
+    const float* xs = poi_world->pois.pos_x;
+    const float* ys = poi_world->pois.pos_y;
+    
+    if (poi_world->index_dirty) {
+        for (uint32_t i = 0; i < poi_world->poi_count && count < max_results; i++) {
+            if (xs[i] >= min_x && xs[i] <= max_x && ys[i] >= min_y && ys[i] <= max_y) {
+                out_indices[count++] = (int)i;
+            }
         }
-        #else
-        if (strcasecmp(poi_world->pois.name[i], name) == 0) {
-            return (int)i;
+        return count;
+    }
+    
+    SpatialGridSpan span;
+    if (!spatial_grid_get_span(&poi_world->spatial_index, min_x, min_y, max_x, max_y, &span)) {
+        return 0;
+    }
+    
+    for (int32_t cy = span.min_cy; cy <= span.max_cy; cy++) {
+        for (int32_t cx = span.min_cx; cx <= span.max_cx; cx++) {
+            uint32_t n;
+            const uint32_t* items = spatial_grid_cell_items(&poi_world->spatial_index, cx, cy, &n);
+            for (uint32_t k = 0; k < n; k++) {
+                uint32_t i = items[k];
+                if (xs[i] >= min_x && xs[i] <= max_x && ys[i] >= min_y && ys[i] <= max_y) {
+                    out_indices[count++] = (int)i;
+                    if (count >= max_results) return count;
+                }
+            }
         }
-        #endif
     }
-    return -1;
+    return count;
+}
+
+int poi_ecs_find_by_name(const POIEcsWorld* poi_world, const char* name) {
+    if (!poi_world || !poi_world->initialized || !name) return -1;
+    
+    uint32_t idx = string_index_find(&poi_world->name_index, &poi_world->strings, name);
+    return idx == STRING_INDEX_NOT_FOUND ? -1 : (int)idx;
+}
+
+int poi_ecs_find_by_id(const POIEcsWorld* poi_world, const char* id) {
+    if (!poi_world || !poi_world->initialized || !id || !id[0]) return -1;
+    
+    uint32_t idx = string_index_find(&poi_world->id_index, &poi_world->strings, id);
+    return idx == STRING_INDEX_NOT_FOUND ? -1 : (int)idx;
 }
 
 bool poi_ecs_check_visit(const POIEcsWorld* poi_world, int poi_index, float x, float y) {
@@ -259,37 +647,183 @@ bool poi_ecs_check_visit(const POIEcsWorld* poi_world, int poi_index, float x, f
 // POI System Update
 // =============================================================================
 
+// Presence entry for a ship, creating one on first sight (NULL on failure)
+static POIShipPresence* acquire_presence(POIEcsWorld* poi_world, Entity ship) {
+    uint16_t slot = poi_world->presence_slot[ship];
+    if (slot) return &poi_world->presence[slot - 1];
+    
+    if (poi_world->presence_count >= poi_world->presence_capacity) {
+        uint32_t grown = poi_world->presence_capacity ? poi_world->presence_capacity * 2 : 8;
+        POIShipPresence* presence = (POIShipPresence*)realloc(poi_world->presence,
+                                                              grown * sizeof(POIShipPresence));
+        if (!presence) return NULL;
+        memset(presence + poi_world->presence_capacity, 0,
+               (grown - poi_world->presence_capacity) * sizeof(POIShipPresence));
+        poi_world->presence = presence;
+        poi_world->presence_capacity = grown;
+    }
+    
+    uint32_t index = poi_world->presence_count++;
+    POIShipPresence* presence = &poi_world->presence[index];
+    presence->ship = ship;
+    presence->inside_count = 0;
+    bitset_clear_all(&presence->inside);
+    poi_world->presence_slot[ship] = (uint16_t)(index + 1);
+    return presence;
+}
+
+// Swap-remove a ship's presence entry; the bitset memory stays with the array
+static void release_presence(POIEcsWorld* poi_world, Entity ship) {
+    uint32_t index = poi_world->presence_slot[ship] - 1u;
+    uint32_t last = poi_world->presence_count - 1;
+    if (index != last) {
+        POIShipPresence moved = poi_world->presence[last];
+        poi_world->presence[last] = poi_world->presence[index];
+        poi_world->presence[index] = moved;
+        poi_world->presence_slot[moved.ship] = (uint16_t)(index + 1);
+    }
+    poi_world->presence_slot[ship] = 0;
+    poi_world->presence_count--;
+}
+
+static void push_event(POIEcsWorld* poi_world, uint32_t poi_index, Entity ship,
+                       POIEventType type, bool first_visit) {
+    POIEvent event = {
+        .poi_index = poi_index,
+        .ship = ship,
+        .type = (uint8_t)type,
+        .first_visit = first_visit
+    };
+    event_ring_push(&poi_world->events, &event);
+}
+
+static void enter_poi(POIEcsWorld* poi_world, POIShipPresence* presence, uint32_t i) {
+    bool first_visit = !poi_world->pois.visited[i];
+    bitset_set(&presence->inside, i);
+    presence->inside_count++;
+    poi_world->pois.visited[i] = true;
+    poi_world->pois.visit_count[i]++;
+    push_event(poi_world, i, presence->ship, POI_EVENT_ENTER, first_visit);
+}
+
+static void exit_poi(POIEcsWorld* poi_world, POIShipPresence* presence, uint32_t i) {
+    bitset_reset(&presence->inside, i);
+    presence->inside_count--;
+    push_event(poi_world, i, presence->ship, POI_EVENT_EXIT, false);
+}
+
+static void exit_all(POIEcsWorld* poi_world, POIShipPresence* presence) {
+    for (uint32_t i = bitset_next(&presence->inside, 0); i != BITSET_NONE;
+         i = bitset_next(&presence->inside, i + 1)) {
+        exit_poi(poi_world, presence, i);
+    }
+}
+
+// Enter/exit transitions for one ship at (x, y) against nearby POIs
+static void update_presence(POIEcsWorld* poi_world, POIShipPresence* presence, float x, float y) {
+    const SpatialGrid* grid = &poi_world->spatial_index;
+    const float exit_scale_sq = POI_EXIT_RADIUS_SCALE * POI_EXIT_RADIUS_SCALE;
+    
+    // Every POI the ship could still be inside lies within the exit radius
+    float pad = poi_world->max_radius * POI_EXIT_RADIUS_SCALE;
+    uint32_t confirmed = 0;     // Inside after this pass, among the candidates
+    
+    SpatialGridSpan span;
+    if (spatial_grid_get_span(grid, x - pad, y - pad, x + pad, y + pad, &span)) {
+        for (int32_t cy = span.min_cy; cy <= span.max_cy; cy++) {
+            for (int32_t cx = span.min_cx; cx <= span.max_cx; cx++) {
+                uint32_t n;
+                const uint32_t* items = spatial_grid_cell_items(grid, cx, cy, &n);
+                for (uint32_t k = 0; k < n; k++) {
+                    uint32_t i = items[k];
+                    float radius_sq = poi_world->pois.radius[i] * poi_world->pois.radius[i];
+                    float dist_sq = distance_squared(x, y, poi_world->pois.pos_x[i], poi_world->pois.pos_y[i]);
+                    
+                    if (bitset_test(&presence->inside, i)) {
+                        if (dist_sq > radius_sq * exit_scale_sq) {
+                            exit_poi(poi_world, presence, i);
+                        } else {
+                            confirmed++;
+                        }
+                    } else if (dist_sq <= radius_sq) {
+                        enter_poi(poi_world, presence, i);
+                        confirmed++;
+                    }
+                }
+            }
+        }
+    }
+    
+    // POIs still flagged but not among the candidates are out of range (the
+    // ship jumped, e.g. a teleport); rare, so walk the set bits
+    if (presence->inside_count > confirmed) {
+        for (uint32_t i = bitset_next(&presence->inside, 0); i != BITSET_NONE;
+             i = bitset_next(&presence->inside, i + 1)) {
+            float radius_sq = poi_world->pois.radius[i] * poi_world->pois.radius[i];
+            float dist_sq = distance_squared(x, y, poi_world->pois.pos_x[i], poi_world->pois.pos_y[i]);
+            if (dist_sq > radius_sq * exit_scale_sq) {
+                exit_poi(poi_world, presence, i);
+            }
+        }
+    }
+}
+
 void poi_ecs_system_update(POIEcsWorld* poi_world, const ECSWorld* ecs_world,
-                           ComponentMask ship_mask, const POISystemContext* context) {
+                           ComponentMask ship_mask) {
     if (!poi_world || !poi_world->initialized || !ecs_world) return;
     
-    // Iterate all ships and check proximity to POIs
+    if (poi_world->index_dirty) {
+        poi_ecs_rebuild_index(poi_world);
+    }
+    
     for (Entity e = 1; e < MAX_ENTITIES; e++) {
         ComponentMask mask = ecs_get_mask(ecs_world, e);
-        if ((mask & ship_mask) != ship_mask) continue;
-        if (!(mask & COMPONENT_TRANSFORM)) continue;
+        bool is_ship = (mask & ship_mask) == ship_mask && (mask & COMPONENT_TRANSFORM);
         
-        float ship_x = ecs_world->transforms.pos_x[e];
-        float ship_y = ecs_world->transforms.pos_y[e];
-        
-        // Check each POI
-        for (uint32_t i = 0; i < poi_world->poi_count; i++) {
-            if (poi_ecs_check_visit(poi_world, (int)i, ship_x, ship_y)) {
-                // Mark as visited if not already
-                if (!poi_world->pois.visited[i]) {
-                    poi_world->pois.visited[i] = true;
-                    poi_world->pois.visit_count[i]++;
-                    
-                    // Fire callback
-                    if (context && context->on_visit) {
-                        context->on_visit((int)i, e, context->user_data);
-                    }
-                }
+        if (!is_ship) {
+            // Ship destroyed or no longer tracked: leave everything it was in
+            if (poi_world->presence_slot[e]) {
+                exit_all(poi_world, &poi_world->presence[poi_world->presence_slot[e] - 1]);
+                release_presence(poi_world, e);
             }
+            continue;
         }
+        if (poi_world->poi_count == 0 && !poi_world->presence_slot[e]) continue;
+        
+        POIShipPresence* presence = acquire_presence(poi_world, e);
+        if (!presence) continue;
+        if (presence->inside.bit_count < poi_world->poi_count &&
+            !bitset_resize(&presence->inside, poi_world->capacity)) {
+            continue;
+        }
+        
+        update_presence(poi_world, presence,
+                        ecs_world->transforms.pos_x[e], ecs_world->transforms.pos_y[e]);
     }
 }
 
+void poi_ecs_events_reader_init(const POIEcsWorld* poi_world, EventRingReader* reader) {
+    event_ring_reader_init(poi_world ? &poi_world->events : NULL, reader);
+}
+
+const POIEvent* poi_ecs_events_next(const POIEcsWorld* poi_world, EventRingReader* reader) {
+    if (!poi_world || !poi_world->initialized) return NULL;
+    return (const POIEvent*)event_ring_next(&poi_world->events, reader);
+}
+
+bool poi_ecs_ship_is_inside(const POIEcsWorld* poi_world, Entity ship, int poi_index) {
+    if (!poi_ecs_is_valid(poi_world, poi_index) || ship >= MAX_ENTITIES) return false;
+    uint16_t slot = poi_world->presence_slot[ship];
+    if (!slot) return false;
+    return bitset_test(&poi_world->presence[slot - 1].inside, (uint32_t)poi_index);
+}
+
+uint32_t poi_ecs_ship_inside_count(const POIEcsWorld* poi_world, Entity ship) {
+    if (!poi_world || !poi_world->initialized || ship >= MAX_ENTITIES) return 0;
+    uint16_t slot = poi_world->presence_slot[ship];
+    return slot ? poi_world->presence[slot - 1].inside_count : 0;
+}
+
 // =============================================================================
 // POI Statistics
 // =============================================================================
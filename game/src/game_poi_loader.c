@@ -1,5 +1,7 @@
 #include "game_poi_loader.h"
+#include "game_poi_cooked.h"
 #include <stdio.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -11,49 +13,47 @@
 // =============================================================================
 
 #define DEFAULT_POI_FILEPATH "assets/data/pois.json"
-#define MAX_FILE_SIZE (1024 * 1024)  // 1 MB max file size
+
+// Object fields the streaming loader understands
+typedef enum POIField {
+    POI_FIELD_NONE = 0,
+    POI_FIELD_ID,
+    POI_FIELD_NAME,
+    POI_FIELD_DESCRIPTION,
+    POI_FIELD_TYPE,
+    POI_FIELD_TIER,
+    POI_FIELD_POSITION,
+    POI_FIELD_RADIUS,
+    POI_FIELD_SATISFACTION_BONUS,
+    POI_FIELD_X,
+    POI_FIELD_Y
+} POIField;
+
+// Required fields (POIStreamLoader.fields_found bits)
+#define POI_FOUND_NAME  (1u << 0)
+#define POI_FOUND_TYPE  (1u << 1)
+#define POI_FOUND_TIER  (1u << 2)
+#define POI_FOUND_X     (1u << 3)
+#define POI_FOUND_Y     (1u << 4)
+#define POI_FOUND_REQUIRED (POI_FOUND_NAME | POI_FOUND_TYPE | POI_FOUND_TIER | POI_FOUND_X | POI_FOUND_Y)
+
+#define POI_STREAM_NO_STRING UINT32_MAX
 
 // =============================================================================
 // Helper Functions
 // =============================================================================
 
-static char* read_file_contents(const char* filepath, long* out_size) {
-    FILE* file = fopen(filepath, "rb");
-    if (!file) return NULL;
-    
-    fseek(file, 0, SEEK_END);
-    long size = ftell(file);
-    fseek(file, 0, SEEK_SET);
-    
-    if (size <= 0 || size > MAX_FILE_SIZE) {
-        fclose(file);
-        return NULL;
-    }
-    
-    char* buffer = (char*)malloc(size + 1);
-    if (!buffer) {
-        fclose(file);
-        return NULL;
-    }
-    
-    size_t read = fread(buffer, 1, size, file);
-    fclose(file);
-    
-    if (read != (size_t)size) {
-        free(buffer);
-        return NULL;
-    }
-    
-    buffer[size] = '\0';
-    if (out_size) *out_size = size;
-    return buffer;
-}
-
 static bool parse_poi_from_json(cJSON* poi_json, POICreateParams* params) {
     if (!poi_json || !params) return false;
     
     memset(params, 0, sizeof(POICreateParams));
     
+    // Optional: id (stable key for scripts and save files)
+    cJSON* id = cJSON_GetObjectItem(poi_json, "id");
+    if (cJSON_IsString(id)) {
+        params->id = id->valuestring;
+    }
+    
     // Required: name
     cJSON* name = cJSON_GetObjectItem(poi_json, "name");
     if (!cJSON_IsString(name)) return false;
@@ -101,6 +101,267 @@ static bool parse_poi_from_json(cJSON* poi_json, POICreateParams* params) {
     return true;
 }
 
+// =============================================================================
+// Streaming Loader
+// =============================================================================
+
+// ASCII case-insensitive, like cJSON_GetObjectItem; key must be lowercase
+static bool key_equals(const JsonToken* token, const char* key, uint32_t len) {
+    if (token->len != len) return false;
+    for (uint32_t i = 0; i < len; i++) {
+        char c = token->str[i];
+        if (c >= 'A' && c <= 'Z') c = (char)(c + ('a' - 'A'));
+        if (c != key[i]) return false;
+    }
+    return true;
+}
+
+// Map an object key to a field (length switch first, then one compare)
+static POIField field_from_key(const JsonToken* token) {
+    switch (token->len) {
+        case 2:  return key_equals(token, "id", 2) ? POI_FIELD_ID : POI_FIELD_NONE;
+        case 4:
+            if (key_equals(token, "name", 4)) return POI_FIELD_NAME;
+            if (key_equals(token, "type", 4)) return POI_FIELD_TYPE;
+            if (key_equals(token, "tier", 4)) return POI_FIELD_TIER;
+            return POI_FIELD_NONE;
+        case 6:  return key_equals(token, "radius", 6) ? POI_FIELD_RADIUS : POI_FIELD_NONE;
+        case 8:  return key_equals(token, "position", 8) ? POI_FIELD_POSITION : POI_FIELD_NONE;
+        case 11: return key_equals(token, "description", 11) ? POI_FIELD_DESCRIPTION : POI_FIELD_NONE;
+        case 18: return key_equals(token, "satisfaction_bonus", 18) ? POI_FIELD_SATISFACTION_BONUS : POI_FIELD_NONE;
+        default: return POI_FIELD_NONE;
+    }
+}
+
+// Keep a string of the current POI (buffer is reused across POIs)
+static bool store_string(POIStreamLoader* loader, uint32_t* out_at, const JsonToken* token) {
+    uint64_t needed = (uint64_t)loader->strings_size + token->len + 1;
+    if (needed > loader->strings_capacity) {
+        uint64_t capacity = loader->strings_capacity ? loader->strings_capacity : 256;
+        while (capacity < needed) capacity *= 2;
+        char* strings = capacity <= UINT32_MAX ? (char*)realloc(loader->strings, (size_t)capacity) : NULL;
+        if (!strings) {
+            loader->out_of_memory = true;
+            return false;
+        }
+        loader->strings = strings;
+        loader->strings_capacity = (uint32_t)capacity;
+    }
+    memcpy(loader->strings + loader->strings_size, token->str, token->len + 1);
+    *out_at = loader->strings_size;
+    loader->strings_size += token->len + 1;
+    return true;
+}
+
+static void begin_poi(POIStreamLoader* loader) {
+    memset(&loader->params, 0, sizeof(POICreateParams));
+    loader->strings_size = 0;
+    loader->id_at = POI_STREAM_NO_STRING;
+    loader->name_at = POI_STREAM_NO_STRING;
+    loader->description_at = POI_STREAM_NO_STRING;
+    loader->fields_found = 0;
+    loader->field = POI_FIELD_NONE;
+    loader->in_position = false;
+    loader->in_poi = true;
+}
+
+static void end_poi(POIStreamLoader* loader) {
+    loader->in_poi = false;
+    
+    // Entries missing required fields are skipped, as in the DOM loader
+    if ((loader->fields_found & POI_FOUND_REQUIRED) != POI_FOUND_REQUIRED) return;
+    if (!loader->poi_world) return;
+    
+    POICreateParams* params = &loader->params;
+    params->id = loader->id_at != POI_STREAM_NO_STRING ? loader->strings + loader->id_at : NULL;
+    params->name = loader->strings + loader->name_at;
+    params->description = loader->description_at != POI_STREAM_NO_STRING
+                              ? loader->strings + loader->description_at : NULL;
+    
+    if (poi_ecs_create(loader->poi_world, params) >= 0) {
+        loader->loaded++;
+    }
+}
+
+// Value directly inside a POI object
+static bool handle_poi_value(POIStreamLoader* loader, const JsonToken* token) {
+    switch (token->type) {
+        case JSON_TOKEN_STRING:
+            switch ((POIField)loader->field) {
+                case POI_FIELD_ID:          return store_string(loader, &loader->id_at, token);
+                case POI_FIELD_DESCRIPTION: return store_string(loader, &loader->description_at, token);
+                case POI_FIELD_NAME:
+                    if (!store_string(loader, &loader->name_at, token)) return false;
+                    loader->fields_found |= POI_FOUND_NAME;
+                    return true;
+                case POI_FIELD_TYPE:
+                    loader->params.type = poi_type_from_string(token->str);
+                    loader->fields_found |= POI_FOUND_TYPE;
+                    return true;
+                case POI_FIELD_TIER:
+                    loader->params.tier = poi_tier_from_string(token->str);
+                    loader->fields_found |= POI_FOUND_TIER;
+                    return true;
+                default:
+                    return true;
+            }
+        
+        case JSON_TOKEN_NUMBER:
+            if (loader->field == POI_FIELD_RADIUS) {
+                loader->params.radius = (float)token->number;
+            } else if (loader->field == POI_FIELD_SATISFACTION_BONUS) {
+                // Saturate like cJSON's valueint
+                if (token->number >= (double)INT_MAX) loader->params.satisfaction_bonus = INT_MAX;
+                else if (token->number <= (double)INT_MIN) loader->params.satisfaction_bonus = INT_MIN;
+                else loader->params.satisfaction_bonus = (int)token->number;
+            }
+            return true;
+        
+        case JSON_TOKEN_OBJECT_BEGIN:
+            loader->in_position = loader->field == POI_FIELD_POSITION;
+            return true;
+        
+        case JSON_TOKEN_OBJECT_END:
+            loader->in_position = false;
+            return true;
+        
+        default:
+            return true;
+    }
+}
+
+// Token at depth >= 2 inside the "pois" array
+static bool handle_poi_token(POIStreamLoader* loader, const JsonToken* token) {
+    if (token->depth == 2) {
+        if (token->type == JSON_TOKEN_OBJECT_BEGIN) begin_poi(loader);
+        else if (token->type == JSON_TOKEN_OBJECT_END) end_poi(loader);
+        return true;  // Non-object entries are skipped
+    }
+    if (!loader->in_poi) return true;
+    
+    if (token->depth == 3) {
+        if (token->type == JSON_TOKEN_KEY) {
+            loader->field = (uint8_t)field_from_key(token);
+            return true;
+        }
+        return handle_poi_value(loader, token);
+    }
+    
+    if (token->depth == 4 && loader->in_position) {
+        if (token->type == JSON_TOKEN_KEY) {
+            loader->field = key_equals(token, "x", 1) ? POI_FIELD_X
+                          : key_equals(token, "y", 1) ? POI_FIELD_Y : POI_FIELD_NONE;
+        } else if (token->type == JSON_TOKEN_NUMBER && loader->field == POI_FIELD_X) {
+            loader->params.x = (float)token->number;
+            loader->fields_found |= POI_FOUND_X;
+        } else if (token->type == JSON_TOKEN_NUMBER && loader->field == POI_FIELD_Y) {
+            loader->params.y = (float)token->number;
+            loader->fields_found |= POI_FOUND_Y;
+        }
+    }
+    return true;  // Deeper values and unknown fields are ignored
+}
+
+static bool on_json_token(const JsonToken* token, void* user_data) {
+    POIStreamLoader* loader = (POIStreamLoader*)user_data;
+    
+    switch (token->depth) {
+        case 0:
+            // Root must be an object
+            if (token->type == JSON_TOKEN_OBJECT_BEGIN || token->type == JSON_TOKEN_OBJECT_END) return true;
+            loader->schema_error = true;
+            return false;
+        
+        case 1:
+            if (token->type == JSON_TOKEN_KEY) {
+                // First "pois" wins (matches cJSON_GetObjectItem)
+                loader->root_key_is_pois = !loader->found_pois && key_equals(token, "pois", 4);
+                return true;
+            }
+            if (!loader->root_key_is_pois) return true;  // "version" etc.
+            if (token->type == JSON_TOKEN_ARRAY_BEGIN) {
+                loader->found_pois = true;
+                loader->in_pois = true;
+                if (loader->poi_world) poi_ecs_clear(loader->poi_world);
+                return true;
+            }
+            if (token->type == JSON_TOKEN_ARRAY_END) {
+                loader->in_pois = false;
+                loader->root_key_is_pois = false;
+                return true;
+            }
+            loader->schema_error = true;  // "pois" is not an array
+            return false;
+        
+        default:
+            return loader->in_pois ? handle_poi_token(loader, token) : true;
+    }
+}
+
+static POILoadResult stream_result(const POIStreamLoader* loader, JsonStreamResult result) {
+    switch (result) {
+        case JSON_STREAM_OK:            return POI_LOAD_SUCCESS;
+        case JSON_STREAM_OUT_OF_MEMORY: return POI_LOAD_OUT_OF_MEMORY;
+        case JSON_STREAM_ABORTED:
+            if (loader->out_of_memory) return POI_LOAD_OUT_OF_MEMORY;
+            return loader->schema_error ? POI_LOAD_INVALID_SCHEMA : POI_LOAD_PARSE_ERROR;
+        default:                        return POI_LOAD_PARSE_ERROR;
+    }
+}
+
+// poi_world may be NULL to only check the document
+static POILoadResult stream_begin(POIStreamLoader* loader, POIEcsWorld* poi_world) {
+    memset(loader, 0, sizeof(POIStreamLoader));
+    loader->poi_world = poi_world;
+    if (!json_stream_init(&loader->json, on_json_token, loader)) {
+        return POI_LOAD_OUT_OF_MEMORY;
+    }
+    return POI_LOAD_SUCCESS;
+}
+
+POILoadResult poi_stream_begin(POIStreamLoader* loader, POIEcsWorld* poi_world) {
+    if (!loader) return POI_LOAD_WORLD_NOT_INITIALIZED;
+    if (!poi_world || !poi_world->initialized) {
+        memset(loader, 0, sizeof(POIStreamLoader));
+        return POI_LOAD_WORLD_NOT_INITIALIZED;
+    }
+    return stream_begin(loader, poi_world);
+}
+
+POILoadResult poi_stream_feed(POIStreamLoader* loader, const char* data, size_t size) {
+    if (!loader || !loader->json.scratch) return POI_LOAD_WORLD_NOT_INITIALIZED;
+    return stream_result(loader, json_stream_feed(&loader->json, data, size));
+}
+
+POILoadResult poi_stream_finish(POIStreamLoader* loader) {
+    if (!loader || !loader->json.scratch) return POI_LOAD_WORLD_NOT_INITIALIZED;
+    
+    JsonStreamResult json_result = json_stream_finish(&loader->json);
+    POILoadResult result = stream_result(loader, json_result);
+    if (result == POI_LOAD_PARSE_ERROR) {
+        printf("[POI Loader] JSON error near line %u: %s\n",
+               loader->json.line, json_stream_result_to_string(json_result));
+    } else if (result == POI_LOAD_SUCCESS && !loader->found_pois) {
+        result = POI_LOAD_INVALID_SCHEMA;
+    }
+    
+    free(loader->strings);
+    loader->strings = NULL;
+    loader->strings_capacity = 0;
+    json_stream_shutdown(&loader->json);
+    
+    POIEcsWorld* poi_world = loader->poi_world;
+    if (poi_world) {
+        if (result == POI_LOAD_SUCCESS) {
+            poi_ecs_rebuild_index(poi_world);
+            printf("[POI Loader] Loaded %d POIs from JSON\n", loader->loaded);
+        } else if (loader->found_pois) {
+            poi_ecs_clear(poi_world);  // Drop a partial load
+        }
+    }
+    return result;
+}
+
 // =============================================================================
 // Error Messages
 // =============================================================================
@@ -113,6 +374,7 @@ const char* poi_load_result_to_string(POILoadResult result) {
         case POI_LOAD_INVALID_SCHEMA:       return "Invalid schema";
         case POI_LOAD_WORLD_NOT_INITIALIZED: return "POI world not initialized";
         case POI_LOAD_OUT_OF_MEMORY:        return "Out of memory";
+        case POI_LOAD_VERSION_MISMATCH:     return "Cooked data version mismatch";
         default:                            return "Unknown error";
     }
 }
@@ -121,6 +383,24 @@ const char* poi_load_result_to_string(POILoadResult result) {
 // Loading Functions
 // =============================================================================
 
+// Feed a whole file through a begun loader in POI_LOAD_CHUNK_SIZE chunks
+static POILoadResult stream_file(POIStreamLoader* loader, FILE* file) {
+    char* chunk = (char*)malloc(POI_LOAD_CHUNK_SIZE);
+    if (!chunk) return POI_LOAD_OUT_OF_MEMORY;
+    
+    POILoadResult result = POI_LOAD_SUCCESS;
+    size_t read;
+    while (result == POI_LOAD_SUCCESS && (read = fread(chunk, 1, POI_LOAD_CHUNK_SIZE, file)) > 0) {
+        result = poi_stream_feed(loader, chunk, read);
+    }
+    if (result == POI_LOAD_SUCCESS && ferror(file)) {
+        result = POI_LOAD_FILE_NOT_FOUND;
+    }
+    
+    free(chunk);
+    return result;
+}
+
 POILoadResult poi_load_from_string(POIEcsWorld* poi_world, const char* json_string) {
     if (!poi_world || !poi_world->initialized) {
         return POI_LOAD_WORLD_NOT_INITIALIZED;
@@ -130,6 +410,23 @@ POILoadResult poi_load_from_string(POIEcsWorld* poi_world, const char* json_stri
         return POI_LOAD_PARSE_ERROR;
     }
     
+    POIStreamLoader loader;
+    POILoadResult result = poi_stream_begin(&loader, poi_world);
+    if (result != POI_LOAD_SUCCESS) return result;
+    
+    poi_stream_feed(&loader, json_string, strlen(json_string));
+    return poi_stream_finish(&loader);
+}
+
+POILoadResult poi_load_from_string_dom(POIEcsWorld* poi_world, const char* json_string) {
+    if (!poi_world || !poi_world->initialized) {
+        return POI_LOAD_WORLD_NOT_INITIALIZED;
+    }
+    
+    if (!json_string) {
+        return POI_LOAD_PARSE_ERROR;
+    }
+    
     // Parse JSON
     cJSON* root = cJSON_Parse(json_string);
     if (!root) {
@@ -152,12 +449,18 @@ POILoadResult poi_load_from_string(POIEcsWorld* poi_world, const char* json_stri
     // Clear existing POIs
     poi_ecs_clear(poi_world);
     
-    // Load each POI
+    // Size storage from the dataset up front (one allocation)
     int poi_count = cJSON_GetArraySize(pois);
+    if (!poi_ecs_reserve(poi_world, (uint32_t)poi_count)) {
+        cJSON_Delete(root);
+        return POI_LOAD_OUT_OF_MEMORY;
+    }
+    
+    // Load each POI (walk the child list; indexed access is O(n) per item)
     int loaded = 0;
+    cJSON* poi_json = NULL;
     
-    for (int i = 0; i < poi_count; i++) {
-        cJSON* poi_json = cJSON_GetArrayItem(pois, i);
+    cJSON_ArrayForEach(poi_json, pois) {
         POICreateParams params;
         
         if (parse_poi_from_json(poi_json, &params)) {
@@ -170,6 +473,8 @@ POILoadResult poi_load_from_string(POIEcsWorld* poi_world, const char* json_stri
     
     cJSON_Delete(root);
     
+    poi_ecs_rebuild_index(poi_world);
+    
     // Log result
     printf("[POI Loader] Loaded %d POIs from JSON\n", loaded);
     
@@ -185,20 +490,48 @@ POILoadResult poi_load_from_file(POIEcsWorld* poi_world, const char* filepath) {
         filepath = DEFAULT_POI_FILEPATH;
     }
     
-    // Read file
-    long file_size = 0;
-    char* contents = read_file_contents(filepath, &file_size);
-    if (!contents) {
+    // Prefer cooked data; a stale or incompatible file falls through to JSON
+    char cooked_path[512];
+    if (poi_cooked_path_for(filepath, cooked_path, sizeof(cooked_path)) &&
+        poi_cooked_is_current(cooked_path, filepath)) {
+        POILoadResult result = poi_load_cooked(poi_world, cooked_path);
+        if (result == POI_LOAD_SUCCESS) {
+            return result;
+        }
+        printf("[POI Loader] Ignoring cooked data (%s): %s\n",
+               poi_load_result_to_string(result), cooked_path);
+    }
+    
+    return poi_load_from_json_file(poi_world, filepath);
+}
+
+POILoadResult poi_load_from_json_file(POIEcsWorld* poi_world, const char* filepath) {
+    if (!poi_world || !poi_world->initialized) {
+        return POI_LOAD_WORLD_NOT_INITIALIZED;
+    }
+    
+    if (!filepath) {
+        filepath = DEFAULT_POI_FILEPATH;
+    }
+    
+    FILE* file = fopen(filepath, "rb");
+    if (!file) {
         printf("[POI Loader] Failed to read file: %s\n", filepath);
         return POI_LOAD_FILE_NOT_FOUND;
     }
     
-    printf("[POI Loader] Loading POIs from: %s (%ld bytes)\n", filepath, file_size);
+    printf("[POI Loader] Loading POIs from: %s\n", filepath);
     
-    // Parse and load
-    POILoadResult result = poi_load_from_string(poi_world, contents);
+    // Parse and load chunk by chunk; the file is never held in memory
+    POIStreamLoader loader;
+    POILoadResult result = poi_stream_begin(&loader, poi_world);
+    if (result == POI_LOAD_SUCCESS) {
+        result = stream_file(&loader, file);
+        POILoadResult finished = poi_stream_finish(&loader);
+        if (result == POI_LOAD_SUCCESS) result = finished;
+    }
     
-    free(contents);
+    fclose(file);
     return result;
 }
 
@@ -209,24 +542,20 @@ POILoadResult poi_load_from_file(POIEcsWorld* poi_world, const char* filepath) {
 POILoadResult poi_validate_file(const char* filepath) {
     if (!filepath) return POI_LOAD_FILE_NOT_FOUND;
     
-    long file_size = 0;
-    char* contents = read_file_contents(filepath, &file_size);
-    if (!contents) return POI_LOAD_FILE_NOT_FOUND;
-    
-    cJSON* root = cJSON_Parse(contents);
-    free(contents);
-    
-    if (!root) return POI_LOAD_PARSE_ERROR;
-    
-    // Check for pois array
-    cJSON* pois = cJSON_GetObjectItem(root, "pois");
-    if (!cJSON_IsArray(pois)) {
-        cJSON_Delete(root);
-        return POI_LOAD_INVALID_SCHEMA;
+    FILE* file = fopen(filepath, "rb");
+    if (!file) return POI_LOAD_FILE_NOT_FOUND;
+    
+    // Same streaming pass as loading, without a world to fill
+    POIStreamLoader loader;
+    POILoadResult result = stream_begin(&loader, NULL);
+    if (result == POI_LOAD_SUCCESS) {
+        result = stream_file(&loader, file);
+        POILoadResult finished = poi_stream_finish(&loader);
+        if (result == POI_LOAD_SUCCESS) result = finished;
     }
     
-    cJSON_Delete(root);
-    return POI_LOAD_SUCCESS;
+    fclose(file);
+    return result;
 }
 
 // =============================================================================
@@ -241,6 +570,7 @@ void poi_load_defaults(POIEcsWorld* poi_world) {
     // Create some default POIs as fallback
     POICreateParams params[] = {
         {
+            .id = "poi_vinga",
             .name = "Vinga Lighthouse",
             .description = "Historic lighthouse marking the entrance to Gothenburg harbor",
             .type = POI_TYPE_HISTORICAL,
@@ -250,6 +580,7 @@ void poi_load_defaults(POIEcsWorld* poi_world) {
             .satisfaction_bonus = 20
         },
         {
+            .id = "poi_älvsborg",
             .name = "Älvsborg Fortress",
             .description = "Famous fortress guarding the entrance to Gothenburg",
             .type = POI_TYPE_MILITARY,
@@ -259,6 +590,7 @@ void poi_load_defaults(POIEcsWorld* poi_world) {
             .satisfaction_bonus = 22
         },
         {
+            .id = "poi_vrångö_nature",
             .name = "Vrångö Nature Reserve",
             .description = "Pristine nature reserve with rare bird species",
             .type = POI_TYPE_NATURE,
@@ -268,6 +600,7 @@ void poi_load_defaults(POIEcsWorld* poi_world) {
             .satisfaction_bonus = 18
         },
         {
+            .id = "poi_styrsö",
             .name = "Styrsö Village",
             .description = "Traditional fishing village with charming wooden houses",
             .type = POI_TYPE_HISTORICAL,
@@ -277,6 +610,7 @@ void poi_load_defaults(POIEcsWorld* poi_world) {
             .satisfaction_bonus = 8
         },
         {
+            .id = "poi_brännö_beach",
             .name = "Brännö Beach",
             .description = "Popular sandy beach with calm waters",
             .type = POI_TYPE_NATURE,
@@ -292,6 +626,8 @@ void poi_load_defaults(POIEcsWorld* poi_world) {
         poi_ecs_create(poi_world, &params[i]);
     }
     
+    poi_ecs_rebuild_index(poi_world);
+    
     printf("[POI Loader] Loaded %d default POIs\n", count);
 }
 
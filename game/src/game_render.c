@@ -1,173 +1,143 @@
 #include "game_render.h"
 #include "ship_render.h"
+#include "poi_render.h"
 #include "ship_ui.h"
 #include "game_constants.h"
 #include "game_poi_ecs.h"
+#include "game_ship_ecs.h"
 #include "game_fog_of_war.h"
 #include "game_satisfaction.h"
+#include "game_visibility.h"
 #include "engine_core.h"
 #include "engine_renderer.h"
+#include "engine_render_queue.h"
+#include "engine_layer_cache.h"
 #include "engine_camera.h"
 #include "engine_ui.h"
 #include <raylib.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 
 // =============================================================================
-// POI Rendering Helpers
+// World Render Queue
+//
+// The world pass under the camera is queued and drawn in one submit, sorted
+// by RENDER_LAYER_*. Each producer writes its own stream and draws only
+// what the frame's visibility set lists.
+//
+// The static layers (water, islands, POIs) are drawn into cached tiles by
+// their own queue, and only where they changed; the world queue then draws
+// the tiles. Without render textures they are queued directly instead.
 // =============================================================================
 
-static Color get_poi_color(POIType type, POITier tier, bool visited) {
-    Color base;
-    
-    switch (type) {
-        case POI_TYPE_NATURE:
-            base = (Color){34, 139, 34, 255};  // Forest green
-            break;
-        case POI_TYPE_HISTORICAL:
-            base = (Color){139, 69, 19, 255};  // Saddle brown
-            break;
-        case POI_TYPE_MILITARY:
-            base = (Color){105, 105, 105, 255}; // Dim gray
-            break;
-        default:
-            base = WHITE;
-            break;
-    }
-    
-    // Special tier is brighter
-    if (tier == POI_TIER_SPECIAL) {
-        base.r = (unsigned char)fminf(base.r * 1.3f, 255);
-        base.g = (unsigned char)fminf(base.g * 1.3f, 255);
-        base.b = (unsigned char)fminf(base.b * 1.3f, 255);
-    }
-    
-    // Visited POIs are slightly faded
-    if (visited) {
-        base.a = 180;
-    }
-    
-    return base;
-}
+enum {
+    WORLD_STREAM_COAST,
+    WORLD_STREAM_POIS,
+    WORLD_STREAM_FOG,
+    WORLD_STREAM_ROUTE,
+    WORLD_STREAM_SHIPS
+};
 
-static void draw_poi_icon(float x, float y, POIType type, POITier tier, 
-                          bool visited, float fog_alpha) {
-    float size = (tier == POI_TIER_SPECIAL) ? 16.0f : 12.0f;
-    Color color = get_poi_color(type, tier, visited);
-    
-    // Apply fog - ensure minimum visibility for navigation
-    // At full fog (1.0), show faint icon at FOG_POI_MIN_ALPHA
-    // At no fog (0.0), show full color
-    float alpha_mult = FOG_POI_MIN_ALPHA + (1.0f - FOG_POI_MIN_ALPHA) * (1.0f - fog_alpha);
-    color.a = (unsigned char)(color.a * alpha_mult);
-    
-    // Draw based on type
-    switch (type) {
-        case POI_TYPE_NATURE:
-            // Tree-like triangle
-            DrawTriangle(
-                (Vector2){x, y - size},
-                (Vector2){x - size * 0.7f, y + size * 0.5f},
-                (Vector2){x + size * 0.7f, y + size * 0.5f},
-                color
-            );
-            break;
-            
-        case POI_TYPE_HISTORICAL:
-            // Building-like rectangle with roof
-            DrawRectangle((int)(x - size * 0.5f), (int)(y - size * 0.3f), 
-                          (int)size, (int)(size * 0.8f), color);
-            DrawTriangle(
-                (Vector2){x, y - size},
-                (Vector2){x - size * 0.6f, y - size * 0.3f},
-                (Vector2){x + size * 0.6f, y - size * 0.3f},
-                color
-            );
-            break;
-            
-        case POI_TYPE_MILITARY:
-            // Star/fort shape
-            DrawPoly((Vector2){x, y}, 5, size, 0.0f, color);
-            break;
-            
-        default:
-            DrawCircle((int)x, (int)y, size, color);
-            break;
-    }
-    
-    // Draw ring for special tier (more visible when revealed)
-    if (tier == POI_TIER_SPECIAL) {
-        Color ring_color = GOLD;
-        ring_color.a = (unsigned char)(200 * alpha_mult);
-        DrawCircleLines((int)x, (int)y, size + 4, ring_color);
-    }
-    
-    // Draw check mark if visited
-    if (visited) {
-        Color check_color = GREEN;
-        check_color.a = (unsigned char)(255 * alpha_mult);
-        DrawCircle((int)(x + size), (int)(y - size), 5, check_color);
-    }
+static RenderQueue g_world_queue;
+static RectBatch g_fog_batch;       // Kept across frames with its GPU buffers
+static GameVisibility g_visibility; // What the camera shows this frame
+
+static LayerCache g_static_cache;   // Tiles of the static layers
+static RenderQueue g_static_queue;  // Draws one tile
+static GameVisibility g_tile_visibility;
+static bool g_static_cached;        // This frame's static layers come from tiles
+
+// How each POI looked when the tiles last drew it (see poi_drawn_key), and
+// which POI set and coastline they drew (generations; 0 = none yet)
+static uint16_t* g_poi_drawn;
+static uint32_t g_static_poi_generation;
+static uint32_t g_static_coast_generation;
+static bool g_static_prototype_mode;
+
+void game_render_shutdown(void) {
+    render_queue_shutdown(&g_world_queue);
+    renderer_rect_batch_shutdown(&g_fog_batch);
+    game_visibility_shutdown(&g_visibility);
+    
+    layer_cache_shutdown(&g_static_cache);
+    render_queue_shutdown(&g_static_queue);
+    game_visibility_shutdown(&g_tile_visibility);
+    free(g_poi_drawn);
+    g_poi_drawn = NULL;
+    g_static_poi_generation = 0;
+    g_static_coast_generation = 0;
 }
 
 void game_render_pois(const GameState* state) {
     if (!state) return;
     
+    // Already in the static tiles
+    if (g_static_cached) return;
+    
     const POIEcsWorld* poi_world = game_ecs_get_poi_world_const(&state->game_ecs);
     const FogOfWarState* fog = game_ecs_get_fog_const(&state->game_ecs);
-    
     if (!poi_world) return;
     
-    // Calculate visible bounds for culling
-    float cam_x = state->camera.target.x;
-    float cam_y = state->camera.target.y;
-    float zoom = state->camera.zoom;
-    int win_w = engine_get_window_width();
-    int win_h = engine_get_window_height();
-    float half_w = (win_w / 2.0f) / zoom;
-    float half_h = (win_h / 2.0f) / zoom;
-    float cull_margin = 100.0f;  // Extra margin for POI icons/labels
-    
-    uint32_t count = poi_ecs_get_count(poi_world);
+    // POIs near the view, gathered from the spatial index
+    poi_render_queue(render_queue_stream(&g_world_queue, WORLD_STREAM_POIS), RENDER_LAYER_POI_AREA,
+                     RENDER_LAYER_POIS, poi_world, fog, g_visibility.pois, g_visibility.poi_count);
+}
+
+// Suggested tour route (F8): legs from the start through each stop
+static void game_render_route(const GameState* state) {
+    const RoutePlan* route = &state->suggested_route;
+    if (!route->valid || route->stop_count == 0) return;
     
-    for (uint32_t i = 0; i < count; i++) {
-        float x, y;
-        poi_ecs_get_position(poi_world, (int)i, &x, &y);
-        
-        // Cull POIs outside camera bounds
-        if (x < cam_x - half_w - cull_margin || x > cam_x + half_w + cull_margin ||
-            y < cam_y - half_h - cull_margin || y > cam_y + half_h + cull_margin) {
-            continue;
-        }
-        
-        POIType type = poi_ecs_get_type(poi_world, (int)i);
-        POITier tier = poi_ecs_get_tier(poi_world, (int)i);
-        bool visited = poi_ecs_is_visited(poi_world, (int)i);
-        
-        // Get fog alpha for this POI
-        float fog_alpha = fog ? fog_get_poi_alpha(fog, (int)i) : 0.0f;
+    const POIEcsWorld* poi_world = game_ecs_get_poi_world_const(&state->game_ecs);
+    RenderStream* stream = render_queue_stream(&g_world_queue, WORLD_STREAM_ROUTE);
+    Color leg_color = {255, 215, 0, 160};
+    
+    Vector2 from = {route->start_x, route->start_y};
+    for (uint32_t i = 0; i < route->stop_count; i++) {
+        Vector2 to;
+        poi_ecs_get_position(poi_world, route->stops[i], &to.x, &to.y);
+        render_queue_line(stream, RENDER_LAYER_ROUTE, 0.0f, from, to, 2.0f, leg_color);
         
-        // In prototype mode, always render POIs (but fogged)
-        // In non-prototype mode, skip completely hidden POIs
-        if (fog && !fog->prototype_mode && fog_alpha > 0.95f) continue;
+        char order[8];
+        snprintf(order, sizeof(order), "%u", i + 1);
+        render_queue_text(stream, RENDER_LAYER_ROUTE, 0.0f, order, (float)((int)to.x + 12),
+                          (float)((int)to.y - 24), 14, GOLD);
+        from = to;
+    }
+    if (route->return_to_start) {
+        Vector2 harbour = {route->start_x, route->start_y};
+        render_queue_line(stream, RENDER_LAYER_ROUTE, 0.0f, from, harbour, 2.0f, leg_color);
+    }
+}
+
+// Queue a list of islands (fill and shoreline)
+static void queue_islands(RenderStream* stream, const CoastlineState* coast, const uint32_t* islands,
+                          uint32_t count) {
+    Color land_color = {LAND_COLOR_R, LAND_COLOR_G, LAND_COLOR_B, LAND_COLOR_A};
+    Color shore_color = {SHORE_COLOR_R, SHORE_COLOR_G, SHORE_COLOR_B, SHORE_COLOR_A};
+    
+    const float* px = coast->point_x;
+    const float* py = coast->point_y;
+    for (uint32_t v = 0; v < count; v++) {
+        uint32_t island = islands[v];
         
-        // Draw radius indicator (subtle, only when somewhat visible)
-        if (fog_alpha < 0.8f) {
-            float radius = poi_ecs_get_radius(poi_world, (int)i);
-            Color radius_color = {100, 100, 255, (unsigned char)(30 * (1.0f - fog_alpha))};
-            DrawCircle((int)x, (int)y, radius, radius_color);
+        // Fill (triangles are stored in the winding raylib draws)
+        for (uint32_t t = coast->triangle_start[island]; t < coast->triangle_start[island + 1]; t++) {
+            const uint32_t* tri = &coast->triangles[t * 3];
+            render_queue_triangle(stream, RENDER_LAYER_LAND, 0.0f,
+                                  (Vector2){px[tri[0]], py[tri[0]]},
+                                  (Vector2){px[tri[1]], py[tri[1]]},
+                                  (Vector2){px[tri[2]], py[tri[2]]}, land_color);
         }
         
-        // Draw POI icon
-        draw_poi_icon(x, y, type, tier, visited, fog_alpha);
-        
-        // Draw name label (only when fog is mostly cleared)
-        if (fog_alpha < 0.5f) {
-            const char* name = poi_ecs_get_name(poi_world, (int)i);
-            int text_width = MeasureText(name, 10);
-            Color text_color = WHITE;
-            text_color.a = (unsigned char)(200 * (1.0f - fog_alpha));
-            DrawText(name, (int)(x - text_width / 2), (int)(y + 20), 10, text_color);
+        // Shoreline
+        uint32_t start = coast->island_start[island];
+        uint32_t end = coast->island_start[island + 1];
+        for (uint32_t i = start; i < end; i++) {
+            uint32_t j = (i + 1 < end) ? i + 1 : start;
+            render_queue_line(stream, RENDER_LAYER_SHORE, 0.0f, (Vector2){px[i], py[i]},
+                              (Vector2){px[j], py[j]}, SHORE_LINE_WIDTH, shore_color);
         }
     }
 }
@@ -175,13 +145,108 @@ void game_render_pois(const GameState* state) {
 void game_render_world(const GameState* state) {
     if (!state) return;
     
-    // Clear to water color (entire world is ocean)
+    // Clear to water color, then draw the islands on top
     Color water_color = {WATER_COLOR_R, WATER_COLOR_G, WATER_COLOR_B, WATER_COLOR_A};
     renderer_clear(water_color);
+    
+    RenderStream* stream = render_queue_stream(&g_world_queue, WORLD_STREAM_COAST);
+    if (g_static_cached) {
+        layer_cache_queue(&g_static_cache, stream, RENDER_LAYER_STATIC);
+        return;
+    }
+    
+    // Islands in view only
+    queue_islands(stream, &state->game_ecs.coast, g_visibility.islands, g_visibility.island_count);
+}
+
+// =============================================================================
+// Static Layer Cache
+// =============================================================================
+
+// Draw the static layers of one cache tile (a LayerCache callback,
+// user_data = const GameState*)
+static void game_render_static_tile(Rectangle world_rect, void* user_data) {
+    const GameState* state = (const GameState*)user_data;
+    const POIEcsWorld* poi_world = game_ecs_get_poi_world_const(&state->game_ecs);
+    const FogOfWarState* fog = game_ecs_get_fog_const(&state->game_ecs);
+    
+    // What reaches into the tile, padded like the view
+    game_visibility_build(&g_tile_visibility, world_rect, poi_world, &state->game_ecs.coast, NULL, NULL);
+    
+    render_queue_begin(&g_static_queue);
+    queue_islands(render_queue_stream(&g_static_queue, WORLD_STREAM_COAST), &state->game_ecs.coast,
+                  g_tile_visibility.islands, g_tile_visibility.island_count);
+    if (poi_world) {
+        poi_render_queue(render_queue_stream(&g_static_queue, WORLD_STREAM_POIS), RENDER_LAYER_POI_AREA,
+                         RENDER_LAYER_POIS, poi_world, fog, g_tile_visibility.pois,
+                         g_tile_visibility.poi_count);
+    }
+    render_queue_submit(&g_static_queue);
+}
+
+// What a POI's drawing depends on: its fog alpha as drawn (a byte) and
+// whether it has been visited
+static uint16_t poi_drawn_key(const POIEcsWorld* poi_world, const FogOfWarState* fog, int poi) {
+    float fog_alpha = fog ? fog_get_poi_alpha(fog, poi) : 0.0f;
+    uint16_t key = (uint16_t)(fog_alpha * 255.0f + 0.5f);
+    if (poi_ecs_is_visited(poi_world, poi)) key |= 0x100;
+    return key;
 }
 
-// Draw fog overlay using chunk-based system with batched rendering
-static void game_render_fog_overlay(const GameState* state) {
+// Mark the tiles under whatever changed since they were drawn
+static void game_render_invalidate_static(const GameState* state) {
+    const POIEcsWorld* poi_world = game_ecs_get_poi_world_const(&state->game_ecs);
+    const FogOfWarState* fog = game_ecs_get_fog_const(&state->game_ecs);
+    uint32_t poi_count = poi_world ? poi_ecs_get_count(poi_world) : 0;
+    uint32_t poi_generation = poi_world ? poi_ecs_get_generation(poi_world) : 0;
+    uint32_t coast_generation = state->game_ecs.coast.generation;
+    bool prototype_mode = fog ? fog->prototype_mode : false;
+    
+    // POIs or islands were added, removed or reloaded: start over
+    bool all = false;
+    if (poi_generation != g_static_poi_generation || coast_generation != g_static_coast_generation ||
+        prototype_mode != g_static_prototype_mode) {
+        uint16_t* drawn = (uint16_t*)realloc(g_poi_drawn, (poi_count ? poi_count : 1) * sizeof(uint16_t));
+        if (!drawn) return;
+        g_poi_drawn = drawn;
+        g_static_poi_generation = poi_generation;
+        g_static_coast_generation = coast_generation;
+        g_static_prototype_mode = prototype_mode;
+        layer_cache_invalidate_all(&g_static_cache);
+        all = true;
+    }
+    
+    // POIs whose fog or visit changed redraw the tiles their drawing reaches
+    for (uint32_t i = 0; i < poi_count; i++) {
+        uint16_t key = poi_drawn_key(poi_world, fog, (int)i);
+        if (!all && key == g_poi_drawn[i]) continue;
+        g_poi_drawn[i] = key;
+        if (all) continue;
+        
+        float x, y;
+        poi_ecs_get_position(poi_world, (int)i, &x, &y);
+        float reach = fmaxf(VISIBILITY_POI_MARGIN, poi_ecs_get_radius(poi_world, (int)i));
+        layer_cache_invalidate_rect(&g_static_cache, x - reach, y - reach, x + reach, y + reach);
+    }
+}
+
+// Bring the static tiles in view up to date; false = queue the layers directly
+static bool game_render_update_static(const GameState* state) {
+    if (!g_static_cache.slots.entries) {
+        Color water_color = {WATER_COLOR_R, WATER_COLOR_G, WATER_COLOR_B, WATER_COLOR_A};
+        if (!layer_cache_init(&g_static_cache, water_color, game_render_static_tile, NULL)) return false;
+    }
+    if (g_static_cache.unavailable) return false;
+    
+    g_static_cache.user_data = (void*)state;
+    game_render_invalidate_static(state);
+    return layer_cache_update(&g_static_cache, g_visibility.view, state->camera.zoom);
+}
+
+// Draw fog overlay over the visible fog chunks with batched rendering
+// (a render queue callback, user_data = const GameState*)
+static void game_render_fog_overlay(void* user_data) {
+    const GameState* state = (const GameState*)user_data;
     if (!state) return;
     
     const FogOfWarState* fog = game_ecs_get_fog_const(&state->game_ecs);
@@ -190,70 +255,55 @@ static void game_render_fog_overlay(const GameState* state) {
     // Fog color from constants
     Color fog_color = {FOG_COLOR_R, FOG_COLOR_G, FOG_COLOR_B, FOG_COLOR_A};
     
-    // Initialize rectangle batch for efficient rendering
-    RectBatch batch;
-    renderer_rect_batch_init(&batch, fog_color);
-    
-    // Get camera info to determine visible area
-    float cam_x = state->camera.target.x;
-    float cam_y = state->camera.target.y;
-    float zoom = state->camera.zoom;
-    int win_w = engine_get_window_width();
-    int win_h = engine_get_window_height();
-    
-    // Calculate visible world bounds with padding
-    float half_w = (win_w / 2.0f) / zoom;
-    float half_h = (win_h / 2.0f) / zoom;
-    float world_left = cam_x - half_w - FOG_CELL_SIZE;
-    float world_right = cam_x + half_w + FOG_CELL_SIZE;
-    float world_top = cam_y - half_h - FOG_CELL_SIZE;
-    float world_bottom = cam_y + half_h + FOG_CELL_SIZE;
-    
-    // Find chunk range for visible area
-    int min_chunk_x = (int)floorf(world_left / FOG_CHUNK_WORLD_SIZE);
-    int max_chunk_x = (int)floorf(world_right / FOG_CHUNK_WORLD_SIZE);
-    int min_chunk_y = (int)floorf(world_top / FOG_CHUNK_WORLD_SIZE);
-    int max_chunk_y = (int)floorf(world_bottom / FOG_CHUNK_WORLD_SIZE);
-    
-    int cell_size = (int)FOG_CELL_SIZE;
+    // Rectangle batch is created on first use and reused every frame
+    RectBatch* batch = &g_fog_batch;
+    if (!batch->capacity && !renderer_rect_batch_init(batch, 0, fog_color)) return;
+    batch->color = fog_color;
+    
+    // Fog area of the view (a cell wider on each side)
+    float world_left = g_visibility.fog_min_x;
+    float world_right = g_visibility.fog_max_x;
+    float world_top = g_visibility.fog_min_y;
+    float world_bottom = g_visibility.fog_max_y;
+    
+    // Cells overlap by a pixel so no seams show between them
+    float cell_size = FOG_CELL_SIZE + 1.0f;
     
     // Iterate over visible chunks
-    for (int cy = min_chunk_y; cy <= max_chunk_y; cy++) {
-        for (int cx = min_chunk_x; cx <= max_chunk_x; cx++) {
-            float chunk_origin_x = cx * FOG_CHUNK_WORLD_SIZE;
-            float chunk_origin_y = cy * FOG_CHUNK_WORLD_SIZE;
-            
-            // Find chunk using spatial hash - O(1) lookup
-            uint16_t chunk_idx = spatial_hash_find(&fog->chunk_map, cx, cy);
-            const FogChunk* chunk = (chunk_idx != SPATIAL_HASH_NOT_FOUND) 
-                                    ? &fog->chunks[chunk_idx] : NULL;
-            
-            // Calculate cell range visible in this chunk
-            int cell_min_x = (int)((world_left - chunk_origin_x) / FOG_CELL_SIZE);
-            int cell_max_x = (int)((world_right - chunk_origin_x) / FOG_CELL_SIZE);
-            int cell_min_y = (int)((world_top - chunk_origin_y) / FOG_CELL_SIZE);
-            int cell_max_y = (int)((world_bottom - chunk_origin_y) / FOG_CELL_SIZE);
-            
-            if (cell_min_x < 0) cell_min_x = 0;
-            if (cell_min_y < 0) cell_min_y = 0;
-            if (cell_max_x >= FOG_CHUNK_SIZE) cell_max_x = FOG_CHUNK_SIZE - 1;
-            if (cell_max_y >= FOG_CHUNK_SIZE) cell_max_y = FOG_CHUNK_SIZE - 1;
-            
-            // Batch fog cells for this chunk
-            for (int cell_y = cell_min_y; cell_y <= cell_max_y; cell_y++) {
-                for (int cell_x = cell_min_x; cell_x <= cell_max_x; cell_x++) {
-                    // Cell is fogged if chunk doesn't exist OR cell not revealed
-                    bool is_revealed = chunk && chunk->cells[cell_y][cell_x];
+    for (uint32_t v = 0; v < g_visibility.chunk_count; v++) {
+        float chunk_origin_x = g_visibility.chunk_x[v] * FOG_CHUNK_WORLD_SIZE;
+        float chunk_origin_y = g_visibility.chunk_y[v] * FOG_CHUNK_WORLD_SIZE;
+        
+        // Chunk looked up in the visibility pass (never explored = all fog)
+        uint16_t chunk_idx = g_visibility.chunk_index[v];
+        const FogChunk* chunk = (chunk_idx != SPATIAL_HASH_NOT_FOUND) 
+                                ? &fog->chunks[chunk_idx] : NULL;
+        
+        // Calculate cell range visible in this chunk
+        int cell_min_x = (int)((world_left - chunk_origin_x) / FOG_CELL_SIZE);
+        int cell_max_x = (int)((world_right - chunk_origin_x) / FOG_CELL_SIZE);
+        int cell_min_y = (int)((world_top - chunk_origin_y) / FOG_CELL_SIZE);
+        int cell_max_y = (int)((world_bottom - chunk_origin_y) / FOG_CELL_SIZE);
+        
+        if (cell_min_x < 0) cell_min_x = 0;
+        if (cell_min_y < 0) cell_min_y = 0;
+        if (cell_max_x >= FOG_CHUNK_SIZE) cell_max_x = FOG_CHUNK_SIZE - 1;
+        if (cell_max_y >= FOG_CHUNK_SIZE) cell_max_y = FOG_CHUNK_SIZE - 1;
+        
+        // Batch fog cells for this chunk
+        for (int cell_y = cell_min_y; cell_y <= cell_max_y; cell_y++) {
+            for (int cell_x = cell_min_x; cell_x <= cell_max_x; cell_x++) {
+                // Cell is fogged if chunk doesn't exist OR cell not revealed
+                bool is_revealed = chunk && chunk->cells[cell_y][cell_x];
+                
+                if (!is_revealed) {
+                    float wx = chunk_origin_x + cell_x * FOG_CELL_SIZE;
+                    float wy = chunk_origin_y + cell_y * FOG_CELL_SIZE;
                     
-                    if (!is_revealed) {
-                        int wx = (int)(chunk_origin_x + cell_x * FOG_CELL_SIZE);
-                        int wy = (int)(chunk_origin_y + cell_y * FOG_CELL_SIZE);
-                        
-                        // Add to batch (auto-flushes when full)
-                        if (!renderer_rect_batch_add(&batch, wx, wy, cell_size + 1, cell_size + 1)) {
-                            renderer_rect_batch_flush(&batch);
-                            renderer_rect_batch_add(&batch, wx, wy, cell_size + 1, cell_size + 1);
-                        }
+                    // Add to batch (flushes when full)
+                    if (!renderer_rect_batch_add(batch, wx, wy, cell_size, cell_size)) {
+                        renderer_rect_batch_flush(batch);
+                        renderer_rect_batch_add(batch, wx, wy, cell_size, cell_size);
                     }
                 }
             }
@@ -261,20 +311,19 @@ static void game_render_fog_overlay(const GameState* state) {
     }
     
     // Flush any remaining rectangles
-    renderer_rect_batch_flush(&batch);
+    renderer_rect_batch_flush(batch);
 }
 
 void game_render_ships(const GameState* state) {
     if (!state) return;
     
-    // Get player ship style
-    ShipVisualStyle player_style = ship_render_get_player_style();
-    
-    // Draw wake first (behind ship)
-    ship_render_draw_wake(&state->player_ship, 1.0f);
-    
-    // Draw player ship
-    ship_render_draw(&state->player_ship, &player_style);
+    // Every ship entity in view, as gathered for this frame. In legacy mode
+    // the player is the ShipState, drawn after the queue, so its entity is
+    // left out.
+    Entity skip = state->use_ecs ? INVALID_ENTITY : state->player_entity;
+    if (!g_visibility.entities) return;
+    ship_render_queue_list(render_queue_stream(&g_world_queue, WORLD_STREAM_SHIPS), RENDER_LAYER_SHIPS,
+                           g_visibility.entities, &state->ecs_world, COMPONENT_SHIP, skip);
 }
 
 void game_render_ui(const GameState* state) {
@@ -288,7 +337,17 @@ void game_render_ui(const GameState* state) {
         renderer_draw_text("Controls: W/S=Telegraph Orders | A/D=Turn | F3=Help", margin, margin + 40, 20, LIGHTGRAY);
         
         // Ship UI (gauges and indicators) - uses engine_ui internally
-        ship_ui_render(&state->player_ship, &state->telegraph);
+        ship_ui_render(&state->render_ship, &state->telegraph);
+        
+        // POI arrival banner (top-center)
+        const POIEcsWorld* poi_world = game_ecs_get_poi_world_const(&state->game_ecs);
+        if (state->poi_banner_timer > 0.0f && poi_ecs_is_valid(poi_world, state->poi_banner_index)) {
+            char banner[160];
+            snprintf(banner, sizeof(banner), "Arrived: %s",
+                     poi_ecs_get_name(poi_world, state->poi_banner_index));
+            int banner_width = MeasureText(banner, 24);
+            renderer_draw_text(banner, (int)(ui_center_x() - banner_width / 2), margin + 80, 24, GOLD);
+        }
         
         // Frame info (bottom-left)
         char debug_text[256];
@@ -303,10 +362,10 @@ void game_render_debug(const GameState* state) {
     if (!state) return;
     
     // Debug visualization (velocity vectors, turn radius, etc.)
-    debug_tools_draw_visualization(&state->debug, &state->player_ship, &state->physics_config);
+    debug_tools_draw_visualization(&state->debug, &state->render_ship, &state->physics_config);
     
     // Debug panel (ship state values)
-    debug_tools_draw_panel(&state->debug, &state->player_ship, &state->physics_config);
+    debug_tools_draw_panel(&state->debug, &state->render_ship, &state->physics_config);
     
     // Help overlay (drawn last, on top of everything)
     debug_tools_draw_help(&state->debug);
@@ -315,14 +374,34 @@ void game_render_debug(const GameState* state) {
 void game_render(const GameState* state) {
     if (!state || !state->initialized) return;
     
+    // Work out what the camera shows once; every world layer draws from it
+    Rectangle view = camera_get_view_rect(&state->camera, engine_get_window_width(), engine_get_window_height());
+    game_visibility_build(&g_visibility, view, game_ecs_get_poi_world_const(&state->game_ecs),
+                          &state->game_ecs.coast, game_ecs_get_fog_const(&state->game_ecs),
+                          &state->render_list);
+    
+    // Static tiles draw under their own camera, so before the world's
+    g_static_cached = game_render_update_static(state);
+    
     // Begin camera mode for world rendering
     camera_begin(&state->camera);
     
-    // Render in layers (world space)
+    // Queue the world (world space); RENDER_LAYER_* sets the draw order
+    render_queue_begin(&g_world_queue);
     game_render_world(state);
     game_render_pois(state);
-    game_render_fog_overlay(state);  // Fog on top of POIs, reveals around ship
-    game_render_ships(state);        // Ship on top of fog
+    render_queue_callback(render_queue_stream(&g_world_queue, WORLD_STREAM_FOG), RENDER_LAYER_FOG,
+                          game_render_fog_overlay, (void*)state);
+    game_render_route(state);
+    game_render_ships(state);
+    render_queue_submit(&g_world_queue);
+    
+    // The legacy player ship is not an entity the queue draws
+    if (!state->use_ecs) {
+        ShipVisualStyle player_style = ship_render_get_player_style();
+        ship_render_draw_wake(&state->render_ship, 1.0f);
+        ship_render_draw(&state->render_ship, &player_style);
+    }
     
     // End camera mode
     camera_end();
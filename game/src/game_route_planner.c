@@ -0,0 +1,708 @@
+#include "game_route_planner.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// Search State
+// =============================================================================
+
+#define NODE_NONE 0xFFFFu
+#define MATRIX_ROWS_PER_JOB 32
+#define TWO_OPT_MAX_PASSES 8
+#define RESTART_AFTER_IDLE 200      // Rounds without improvement before returning to the best route
+#define DISTANCE_EPSILON 1.0f       // Keeps bonus/distance finite for stops on the way
+#define UNBOUNDED_SLOT_COST 1.0e6f  // Stop cost when only max_stops limits the route
+
+typedef enum DestroyOp {
+    DESTROY_RANDOM = 0,
+    DESTROY_SEGMENT,
+    DESTROY_WORST,
+    DESTROY_OP_COUNT
+} DestroyOp;
+
+typedef struct RouteState {
+    uint16_t nodes[ROUTE_MAX_STOPS];
+    uint32_t count;
+    float length;
+    int bonus_sum;                  // POI bonuses only
+    int value;                      // bonus_sum + variety bonus
+    uint32_t type_counts[POI_TYPE_COUNT];
+    uint32_t types_visited;
+} RouteState;
+
+struct RouteSearch {
+    RouteState best;
+    RouteState current;
+    RouteState trial;
+    uint8_t* in_route;              // Per node: 1 while in trial
+    float* insert_delta;            // Per node: cheapest extra distance to add it to trial
+    uint16_t* insert_pos;           // Per node: where that insertion goes
+    float weights[DESTROY_OP_COUNT];
+    float slot_cost;                // Distance a stop is worth (tuned while searching)
+    uint32_t rng;
+    uint32_t iterations;
+};
+
+// Read-only inputs shared by all searches of one plan
+typedef struct PlanContext {
+    RoutePlanner* planner;
+    const float* dist;
+    uint32_t stride;
+    float budget;
+    float slot_cost;                // Starting distance a stop is worth
+    bool return_to_start;
+    uint32_t max_stops;
+    double deadline;
+    uint32_t max_iterations;
+    uint32_t seed;
+} PlanContext;
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static inline float node_dist(const PlanContext* ctx, uint32_t a, uint32_t b) {
+    if (b == NODE_NONE) return 0.0f;
+    return ctx->dist[a * ctx->stride + b];
+}
+
+// Node after position pos (NODE_NONE for an open route's end)
+static inline uint32_t next_node(const PlanContext* ctx, const RouteState* state, uint32_t pos) {
+    if (pos + 1 < state->count) return state->nodes[pos + 1];
+    return ctx->return_to_start ? 0 : NODE_NONE;
+}
+
+static inline uint32_t prev_node(const RouteState* state, uint32_t pos) {
+    return pos == 0 ? 0 : state->nodes[pos - 1];
+}
+
+static inline uint32_t rng_next(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static inline float rng_float(uint32_t* state) {
+    return (float)(rng_next(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+static int variety_bonus(const SatisfactionConfig* config, uint32_t types_visited) {
+    if (types_visited >= VARIETY_BONUS_THRESHOLD) return config->variety_bonus_3_types;
+    if (types_visited >= 2) return config->variety_bonus_2_types;
+    return 0;
+}
+
+// Better bonus wins; equal bonus prefers the shorter route
+static bool route_better(const RouteState* a, const RouteState* b) {
+    if (a->value != b->value) return a->value > b->value;
+    return a->length < b->length - 1e-3f;
+}
+
+static int compare_ints(const void* a, const void* b) {
+    int ia = *(const int*)a;
+    int ib = *(const int*)b;
+    return (ia > ib) - (ia < ib);
+}
+
+// =============================================================================
+// Route Edits
+// =============================================================================
+
+static void route_clear(RouteState* state) {
+    memset(state, 0, sizeof(RouteState));
+}
+
+static void route_update_value(const PlanContext* ctx, RouteState* state) {
+    state->value = state->bonus_sum + variety_bonus(&ctx->planner->config, state->types_visited);
+}
+
+static float route_measure_length(const PlanContext* ctx, const RouteState* state) {
+    if (state->count == 0) return 0.0f;
+
+    float length = node_dist(ctx, 0, state->nodes[0]);
+    for (uint32_t i = 0; i + 1 < state->count; i++) {
+        length += node_dist(ctx, state->nodes[i], state->nodes[i + 1]);
+    }
+    if (ctx->return_to_start) {
+        length += node_dist(ctx, state->nodes[state->count - 1], 0);
+    }
+    return length;
+}
+
+static void route_insert(const PlanContext* ctx, RouteState* state, uint8_t* in_route,
+                         uint32_t node, uint32_t pos, float delta) {
+    const RoutePlanner* planner = ctx->planner;
+
+    memmove(&state->nodes[pos + 1], &state->nodes[pos], (state->count - pos) * sizeof(uint16_t));
+    state->nodes[pos] = (uint16_t)node;
+    state->count++;
+    state->length += delta;
+    state->bonus_sum += planner->bonus[node];
+    if (state->type_counts[planner->type[node]]++ == 0) state->types_visited++;
+    route_update_value(ctx, state);
+    in_route[node] = 1;
+}
+
+static void route_remove(const PlanContext* ctx, RouteState* state, uint8_t* in_route, uint32_t pos) {
+    const RoutePlanner* planner = ctx->planner;
+    uint32_t node = state->nodes[pos];
+    uint32_t prev = prev_node(state, pos);
+    uint32_t next = next_node(ctx, state, pos);
+
+    state->length -= node_dist(ctx, prev, node) + node_dist(ctx, node, next) - node_dist(ctx, prev, next);
+    memmove(&state->nodes[pos], &state->nodes[pos + 1], (state->count - pos - 1) * sizeof(uint16_t));
+    state->count--;
+    state->bonus_sum -= planner->bonus[node];
+    if (--state->type_counts[planner->type[node]] == 0) state->types_visited--;
+    route_update_value(ctx, state);
+    in_route[node] = 0;
+
+    // Keep float drift from accumulating over many edits
+    if (state->count == 0) state->length = 0.0f;
+}
+
+// Make the trial route (and in_route) a copy of another route
+static void route_restore(RouteSearch* search, const RouteState* from) {
+    for (uint32_t i = 0; i < search->trial.count; i++) search->in_route[search->trial.nodes[i]] = 0;
+    search->trial = *from;
+    for (uint32_t i = 0; i < search->trial.count; i++) search->in_route[search->trial.nodes[i]] = 1;
+}
+
+// =============================================================================
+// Repair: Greedy Insertion
+// =============================================================================
+
+// Extra distance to insert node at position pos (before nodes[pos])
+static inline float insertion_delta(const PlanContext* ctx, const RouteState* state,
+                                    const float* row, uint32_t pos) {
+    uint32_t prev = prev_node(state, pos);
+    uint32_t next = pos < state->count ? state->nodes[pos] : (ctx->return_to_start ? 0 : NODE_NONE);
+    float delta = row[prev];
+    if (next != NODE_NONE) delta += row[next] - node_dist(ctx, prev, next);
+    return delta;
+}
+
+static void find_cheapest_insertion(const PlanContext* ctx, RouteSearch* search, uint32_t node) {
+    const RouteState* state = &search->trial;
+    const float* row = &ctx->dist[node * ctx->stride];
+    float best = INFINITY;
+    uint32_t best_pos = 0;
+    for (uint32_t pos = 0; pos <= state->count; pos++) {
+        float delta = insertion_delta(ctx, state, row, pos);
+        if (delta < best) {
+            best = delta;
+            best_pos = pos;
+        }
+    }
+    search->insert_delta[node] = best;
+    search->insert_pos[node] = (uint16_t)best_pos;
+}
+
+// After inserting at pos, positions past it shift and two new edges appear.
+// Only nodes whose cheapest edge was the one just split need a full rescan.
+static void update_insertions(const PlanContext* ctx, RouteSearch* search, uint32_t pos) {
+    const RoutePlanner* planner = ctx->planner;
+    const RouteState* state = &search->trial;
+
+    for (uint32_t node = 1; node < planner->node_count; node++) {
+        if (search->in_route[node]) continue;
+        if (search->insert_pos[node] == pos) {
+            find_cheapest_insertion(ctx, search, node);
+            continue;
+        }
+        if (search->insert_pos[node] > pos) search->insert_pos[node]++;
+
+        const float* row = &ctx->dist[node * ctx->stride];
+        for (uint32_t p = pos; p <= pos + 1; p++) {
+            float delta = insertion_delta(ctx, state, row, p);
+            if (delta < search->insert_delta[node]) {
+                search->insert_delta[node] = delta;
+                search->insert_pos[node] = (uint16_t)p;
+            }
+        }
+    }
+}
+
+// Insert the stop with the best bonus per extra distance until nothing fits.
+// Each stop also costs slot_cost, so when max_stops binds the ranking leans
+// towards bonus over proximity. noise > 0 perturbs the ranking so each search
+// builds different routes.
+static void route_repair(const PlanContext* ctx, RouteSearch* search, float noise) {
+    const RoutePlanner* planner = ctx->planner;
+    RouteState* state = &search->trial;
+    if (state->count >= ctx->max_stops) return;
+
+    for (uint32_t node = 1; node < planner->node_count; node++) {
+        if (!search->in_route[node]) find_cheapest_insertion(ctx, search, node);
+    }
+
+    while (state->count < ctx->max_stops) {
+        int current_variety = variety_bonus(&planner->config, state->types_visited);
+        int variety_gain = variety_bonus(&planner->config, state->types_visited + 1) - current_variety;
+        uint32_t best_node = 0;
+        float best_score = 0.0f;
+
+        for (uint32_t node = 1; node < planner->node_count; node++) {
+            if (search->in_route[node]) continue;
+
+            int gain = planner->bonus[node];
+            if (state->type_counts[planner->type[node]] == 0) gain += variety_gain;
+            if (gain <= 0) continue;
+
+            float delta = search->insert_delta[node];
+            if (state->length + delta > ctx->budget) continue;
+
+            float score = (float)gain / (fmaxf(delta, 0.0f) + search->slot_cost);
+            if (noise > 0.0f) score *= 1.0f + noise * (2.0f * rng_float(&search->rng) - 1.0f);
+            if (score > best_score) {
+                best_score = score;
+                best_node = node;
+            }
+        }
+
+        if (best_node == 0) break;
+        uint32_t pos = search->insert_pos[best_node];
+        route_insert(ctx, state, search->in_route, best_node, pos, search->insert_delta[best_node]);
+        if (state->count < ctx->max_stops) update_insertions(ctx, search, pos);
+    }
+}
+
+// =============================================================================
+// Local Search: 2-opt
+// =============================================================================
+
+static void route_two_opt(const PlanContext* ctx, RouteState* state) {
+    if (state->count < 2) return;
+
+    for (int pass = 0; pass < TWO_OPT_MAX_PASSES; pass++) {
+        bool improved = false;
+        for (uint32_t i = 0; i + 1 < state->count; i++) {
+            uint32_t prev = prev_node(state, i);
+            uint32_t first = state->nodes[i];
+            for (uint32_t j = i + 1; j < state->count; j++) {
+                uint32_t last = state->nodes[j];
+                uint32_t next = next_node(ctx, state, j);
+                float delta = node_dist(ctx, prev, last) + node_dist(ctx, first, next)
+                            - node_dist(ctx, prev, first) - node_dist(ctx, last, next);
+                if (delta < -1e-3f) {
+                    // Reverse nodes[i..j]
+                    for (uint32_t a = i, b = j; a < b; a++, b--) {
+                        uint16_t tmp = state->nodes[a];
+                        state->nodes[a] = state->nodes[b];
+                        state->nodes[b] = tmp;
+                    }
+                    state->length += delta;
+                    first = state->nodes[i];
+                    improved = true;
+                }
+            }
+        }
+        if (!improved) break;
+    }
+
+    state->length = route_measure_length(ctx, state);
+}
+
+// =============================================================================
+// Destroy Operators
+// =============================================================================
+
+static void destroy_random(const PlanContext* ctx, RouteSearch* search, uint32_t k) {
+    for (uint32_t n = 0; n < k && search->trial.count > 0; n++) {
+        uint32_t pos = rng_next(&search->rng) % search->trial.count;
+        route_remove(ctx, &search->trial, search->in_route, pos);
+    }
+}
+
+static void destroy_segment(const PlanContext* ctx, RouteSearch* search, uint32_t k) {
+    if (search->trial.count == 0) return;
+    if (k > search->trial.count) k = search->trial.count;
+
+    uint32_t pos = rng_next(&search->rng) % (search->trial.count - k + 1);
+    for (uint32_t n = 0; n < k; n++) {
+        route_remove(ctx, &search->trial, search->in_route, pos);
+    }
+}
+
+// Remove the stops that earn the least per distance they cost
+static void destroy_worst(const PlanContext* ctx, RouteSearch* search, uint32_t k) {
+    const RoutePlanner* planner = ctx->planner;
+    RouteState* state = &search->trial;
+
+    for (uint32_t n = 0; n < k && state->count > 0; n++) {
+        uint32_t worst_pos = 0;
+        float worst_score = INFINITY;
+        for (uint32_t pos = 0; pos < state->count; pos++) {
+            uint32_t node = state->nodes[pos];
+            uint32_t prev = prev_node(state, pos);
+            uint32_t next = next_node(ctx, state, pos);
+            float saving = node_dist(ctx, prev, node) + node_dist(ctx, node, next) - node_dist(ctx, prev, next);
+            float score = (float)planner->bonus[node] / (fmaxf(saving, 0.0f) + search->slot_cost);
+            score *= 1.0f + 0.2f * rng_float(&search->rng);
+            if (score < worst_score) {
+                worst_score = score;
+                worst_pos = pos;
+            }
+        }
+        route_remove(ctx, state, search->in_route, worst_pos);
+    }
+}
+
+static DestroyOp pick_destroy_op(RouteSearch* search) {
+    float total = 0.0f;
+    for (int op = 0; op < DESTROY_OP_COUNT; op++) total += search->weights[op];
+
+    float pick = rng_float(&search->rng) * total;
+    for (int op = 0; op < DESTROY_OP_COUNT - 1; op++) {
+        if (pick < search->weights[op]) return (DestroyOp)op;
+        pick -= search->weights[op];
+    }
+    return (DestroyOp)(DESTROY_OP_COUNT - 1);
+}
+
+// =============================================================================
+// Search Job
+// =============================================================================
+
+// Stops full with budget to spare: value bonus more than proximity, and the
+// reverse when the budget runs out first
+static void tune_slot_cost(const PlanContext* ctx, RouteSearch* search) {
+    const RouteState* state = &search->trial;
+    if (state->count >= ctx->max_stops && state->length < ctx->budget * 0.95f) {
+        search->slot_cost = fminf(search->slot_cost * 1.25f, UNBOUNDED_SLOT_COST);
+    } else if (state->count < ctx->max_stops) {
+        search->slot_cost = fmaxf(search->slot_cost * 0.8f, DISTANCE_EPSILON);
+    }
+}
+
+static bool search_should_stop(const PlanContext* ctx, const RouteSearch* search) {
+    if (ctx->max_iterations > 0) return search->iterations >= ctx->max_iterations;
+    return jobs_time_seconds() >= ctx->deadline;
+}
+
+static void route_search_job(void* data, uint32_t index) {
+    const PlanContext* ctx = (const PlanContext*)data;
+    RouteSearch* search = &ctx->planner->searches[index];
+
+    search->rng = (ctx->seed ^ (index * 0x9E3779B9u)) * 2654435761u + 1u;
+    if (search->rng == 0) search->rng = 1;
+    search->iterations = 0;
+    for (int op = 0; op < DESTROY_OP_COUNT; op++) search->weights[op] = 1.0f;
+    search->slot_cost = ctx->slot_cost;
+    memset(search->in_route, 0, ctx->planner->node_count);
+    route_clear(&search->trial);
+
+    // Search 0 starts from the plain greedy route, the others from noisy ones
+    route_repair(ctx, search, index == 0 ? 0.0f : 0.3f);
+    route_two_opt(ctx, &search->trial);
+    route_repair(ctx, search, 0.0f);
+    search->current = search->trial;
+    search->best = search->trial;
+
+    uint32_t idle = 0;
+    while (search->best.count > 0 && !search_should_stop(ctx, search)) {
+        search->iterations++;
+
+        // Destroy 1 to ~1/3 of the stops, then rebuild
+        uint32_t k = 1 + rng_next(&search->rng) % (search->trial.count / 3 + 1);
+        DestroyOp op = pick_destroy_op(search);
+        switch (op) {
+            case DESTROY_RANDOM:  destroy_random(ctx, search, k); break;
+            case DESTROY_SEGMENT: destroy_segment(ctx, search, k); break;
+            case DESTROY_WORST:   destroy_worst(ctx, search, k); break;
+            default: break;
+        }
+        route_repair(ctx, search, 0.2f);
+        route_two_opt(ctx, &search->trial);
+        route_repair(ctx, search, 0.0f);
+        tune_slot_cost(ctx, search);
+
+        // Adaptive weights: reward operators that lead to improvements
+        float reward = 0.0f;
+        if (route_better(&search->trial, &search->best)) {
+            search->best = search->trial;
+            search->current = search->trial;
+            reward = 3.0f;
+            idle = 0;
+        } else if (!route_better(&search->current, &search->trial)) {
+            search->current = search->trial;
+            reward = 1.0f;
+            idle++;
+        } else {
+            route_restore(search, &search->current);
+            idle++;
+        }
+        search->weights[op] = fmaxf(0.8f * search->weights[op] + 0.2f * reward, 0.1f);
+
+        if (idle >= RESTART_AFTER_IDLE) {
+            search->current = search->best;
+            route_restore(search, &search->best);
+            idle = 0;
+        }
+    }
+}
+
+// =============================================================================
+// Distance Matrix
+// =============================================================================
+
+static void matrix_rows_job(void* data, uint32_t index) {
+    RoutePlanner* planner = (RoutePlanner*)data;
+    uint32_t n = planner->node_count;
+    uint32_t row_end = (index + 1) * MATRIX_ROWS_PER_JOB;
+    if (row_end > n) row_end = n;
+
+    for (uint32_t i = index * MATRIX_ROWS_PER_JOB; i < row_end; i++) {
+        float* row = &planner->dist[(size_t)i * n];
+        float xi = planner->node_x[i];
+        float yi = planner->node_y[i];
+        for (uint32_t j = 0; j < n; j++) {
+            float dx = planner->node_x[j] - xi;
+            float dy = planner->node_y[j] - yi;
+            row[j] = sqrtf(dx * dx + dy * dy);
+        }
+    }
+}
+
+static bool planner_reserve(RoutePlanner* planner, uint32_t node_count) {
+    if (node_count <= planner->node_capacity) return true;
+
+    // The matrix is capacity^2, so don't overshoot the candidate cap
+    uint32_t capacity = planner->node_capacity ? planner->node_capacity : 64;
+    while (capacity < node_count) capacity *= 2;
+    if (capacity > ROUTE_MAX_CANDIDATES + 1) capacity = ROUTE_MAX_CANDIDATES + 1;
+
+    int* candidates = (int*)realloc(planner->candidates, capacity * sizeof(int));
+    if (candidates) planner->candidates = candidates;
+    float* node_x = (float*)realloc(planner->node_x, capacity * sizeof(float));
+    if (node_x) planner->node_x = node_x;
+    float* node_y = (float*)realloc(planner->node_y, capacity * sizeof(float));
+    if (node_y) planner->node_y = node_y;
+    int32_t* bonus = (int32_t*)realloc(planner->bonus, capacity * sizeof(int32_t));
+    if (bonus) planner->bonus = bonus;
+    uint8_t* type = (uint8_t*)realloc(planner->type, capacity);
+    if (type) planner->type = type;
+    float* dist = (float*)realloc(planner->dist, (size_t)capacity * capacity * sizeof(float));
+    if (dist) planner->dist = dist;
+    if (!candidates || !node_x || !node_y || !bonus || !type || !dist) return false;
+
+    for (uint32_t s = 0; s < planner->search_count; s++) {
+        RouteSearch* search = &planner->searches[s];
+        uint8_t* in_route = (uint8_t*)realloc(search->in_route, capacity);
+        if (in_route) search->in_route = in_route;
+        float* insert_delta = (float*)realloc(search->insert_delta, capacity * sizeof(float));
+        if (insert_delta) search->insert_delta = insert_delta;
+        uint16_t* insert_pos = (uint16_t*)realloc(search->insert_pos, capacity * sizeof(uint16_t));
+        if (insert_pos) search->insert_pos = insert_pos;
+        if (!in_route || !insert_delta || !insert_pos) return false;
+    }
+
+    planner->node_capacity = capacity;
+    planner->dist_valid = false;
+    return true;
+}
+
+// Collect candidates in reach of the start (sorted, unique, valid)
+static uint32_t gather_candidates(const POIEcsWorld* poi_world, const RoutePlanRequest* request,
+                                  float budget, int* out) {
+    uint32_t count = 0;
+
+    if (request->candidates) {
+        for (uint32_t i = 0; i < request->candidate_count && count < ROUTE_MAX_CANDIDATES; i++) {
+            if (poi_ecs_is_valid(poi_world, request->candidates[i])) out[count++] = request->candidates[i];
+        }
+    } else if (isinf(budget)) {
+        uint32_t poi_count = poi_ecs_get_count(poi_world);
+        for (uint32_t i = 0; i < poi_count && count < ROUTE_MAX_CANDIDATES; i++) out[count++] = (int)i;
+    } else {
+        float reach = request->return_to_start ? budget * 0.5f : budget;
+        count = (uint32_t)poi_ecs_find_in_range(poi_world, request->start_x, request->start_y, reach,
+                                                out, ROUTE_MAX_CANDIDATES);
+    }
+
+    qsort(out, count, sizeof(int), compare_ints);
+    uint32_t unique = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (unique == 0 || out[unique - 1] != out[i]) out[unique++] = out[i];
+    }
+    return unique;
+}
+
+// Load candidates and distances, reusing the matrix if the candidate set is unchanged
+static bool planner_prepare(RoutePlanner* planner, const POIEcsWorld* poi_world,
+                            const RoutePlanRequest* request, float budget) {
+    int gathered[ROUTE_MAX_CANDIDATES];
+    uint32_t count = gather_candidates(poi_world, request, budget, gathered);
+    if (!planner_reserve(planner, count + 1)) return false;
+
+    bool same_set = planner->dist_valid && count == planner->candidate_count &&
+                    memcmp(gathered, planner->candidates, count * sizeof(int)) == 0;
+
+    planner->candidate_count = count;
+    planner->node_count = count + 1;
+    memcpy(planner->candidates, gathered, count * sizeof(int));
+
+    planner->node_x[0] = request->start_x;
+    planner->node_y[0] = request->start_y;
+    planner->bonus[0] = 0;
+    planner->type[0] = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        int poi = gathered[i];
+        planner->node_x[i + 1] = poi_world->pois.pos_x[poi];
+        planner->node_y[i + 1] = poi_world->pois.pos_y[poi];
+        planner->bonus[i + 1] = satisfaction_calculate_poi_bonus(poi_world, poi, &planner->config);
+        POIType type = poi_ecs_get_type(poi_world, poi);
+        planner->type[i + 1] = (uint8_t)(type < POI_TYPE_COUNT ? type : 0);
+    }
+
+    uint32_t n = planner->node_count;
+    if (same_set) {
+        // Only the start moved: refresh row and column 0
+        for (uint32_t j = 0; j < n; j++) {
+            float dx = planner->node_x[j] - request->start_x;
+            float dy = planner->node_y[j] - request->start_y;
+            float d = sqrtf(dx * dx + dy * dy);
+            planner->dist[j] = d;
+            planner->dist[(size_t)j * n] = d;
+        }
+    } else {
+        uint32_t jobs = (n + MATRIX_ROWS_PER_JOB - 1) / MATRIX_ROWS_PER_JOB;
+        jobs_parallel_for(planner->jobs, jobs, matrix_rows_job, planner);
+        planner->matrix_builds++;
+    }
+    planner->dist_valid = true;
+    return true;
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+RoutePlanRequest route_plan_request_default(float start_x, float start_y) {
+    RoutePlanRequest request;
+    memset(&request, 0, sizeof(RoutePlanRequest));
+    request.start_x = start_x;
+    request.start_y = start_y;
+    request.return_to_start = true;
+    request.max_stops = ROUTE_MAX_STOPS;
+    request.time_limit = ROUTE_DEFAULT_TIME_LIMIT;
+    request.seed = 1;
+    return request;
+}
+
+bool route_planner_init(RoutePlanner* planner, JobSystem* jobs, const SatisfactionConfig* config) {
+    if (!planner) return false;
+    memset(planner, 0, sizeof(RoutePlanner));
+
+    planner->jobs = jobs;
+    planner->config = config ? *config : satisfaction_get_default_config();
+    planner->search_count = jobs_thread_count(jobs);
+    planner->searches = (RouteSearch*)calloc(planner->search_count, sizeof(RouteSearch));
+    if (!planner->searches) return false;
+
+    planner->initialized = true;
+    return true;
+}
+
+void route_planner_shutdown(RoutePlanner* planner) {
+    if (!planner) return;
+
+    if (planner->searches) {
+        for (uint32_t s = 0; s < planner->search_count; s++) {
+            free(planner->searches[s].in_route);
+            free(planner->searches[s].insert_delta);
+            free(planner->searches[s].insert_pos);
+        }
+        free(planner->searches);
+    }
+    free(planner->candidates);
+    free(planner->node_x);
+    free(planner->node_y);
+    free(planner->bonus);
+    free(planner->type);
+    free(planner->dist);
+    memset(planner, 0, sizeof(RoutePlanner));
+}
+
+void route_planner_set_config(RoutePlanner* planner, const SatisfactionConfig* config) {
+    if (!planner || !config) return;
+    planner->config = *config;
+}
+
+void route_planner_invalidate(RoutePlanner* planner) {
+    if (!planner) return;
+    planner->dist_valid = false;
+}
+
+// =============================================================================
+// Planning
+// =============================================================================
+
+bool route_planner_plan(RoutePlanner* planner, const POIEcsWorld* poi_world,
+                        const RoutePlanRequest* request, RoutePlan* out_plan) {
+    if (!out_plan) return false;
+    memset(out_plan, 0, sizeof(RoutePlan));
+    if (!planner || !planner->initialized || !poi_world || !request) return false;
+
+    // Tightest of the distance and time budgets
+    float budget = INFINITY;
+    if (request->distance_budget > 0.0f) budget = request->distance_budget;
+    if (request->time_budget > 0.0f && request->cruise_speed > 0.0f) {
+        budget = fminf(budget, request->time_budget * request->cruise_speed);
+    }
+
+    if (!planner_prepare(planner, poi_world, request, budget)) {
+        printf("Route planner: Out of memory for the distance matrix\n");
+        return false;
+    }
+    out_plan->candidate_count = planner->candidate_count;
+    if (planner->candidate_count == 0) return false;
+
+    PlanContext ctx;
+    ctx.planner = planner;
+    ctx.dist = planner->dist;
+    ctx.stride = planner->node_count;
+    ctx.budget = budget;
+    ctx.return_to_start = request->return_to_start;
+    ctx.max_stops = (request->max_stops > 0 && request->max_stops < ROUTE_MAX_STOPS)
+                  ? request->max_stops : ROUTE_MAX_STOPS;
+    ctx.slot_cost = isinf(budget) ? UNBOUNDED_SLOT_COST
+                  : fmaxf(budget / (float)ctx.max_stops, DISTANCE_EPSILON);
+    float time_limit = request->time_limit > 0.0f ? request->time_limit : ROUTE_DEFAULT_TIME_LIMIT;
+    ctx.deadline = jobs_time_seconds() + time_limit;
+    ctx.max_iterations = request->max_iterations;
+    ctx.seed = request->seed;
+
+    jobs_parallel_for(planner->jobs, planner->search_count, route_search_job, &ctx);
+
+    // Best over all searches (ties go to the lowest index, so results are stable)
+    const RouteState* best = &planner->searches[0].best;
+    for (uint32_t s = 0; s < planner->search_count; s++) {
+        const RouteSearch* search = &planner->searches[s];
+        if (route_better(&search->best, best)) best = &search->best;
+        out_plan->iterations += search->iterations;
+    }
+    if (best->count == 0) return false;
+
+    for (uint32_t i = 0; i < best->count; i++) {
+        out_plan->stops[i] = planner->candidates[best->nodes[i] - 1];
+    }
+    out_plan->stop_count = best->count;
+    out_plan->start_x = request->start_x;
+    out_plan->start_y = request->start_y;
+    out_plan->return_to_start = request->return_to_start;
+    out_plan->length = route_measure_length(&ctx, best);
+    out_plan->bonus = best->value;
+
+    int score = planner->config.base_satisfaction + best->value;
+    if (score < 0) score = 0;
+    if (score > 100) score = 100;
+    out_plan->satisfaction = score;
+    out_plan->valid = true;
+    return true;
+}
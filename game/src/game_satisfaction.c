@@ -1,4 +1,5 @@
 #include "game_satisfaction.h"
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -6,10 +7,25 @@
 // Tour Lifecycle
 // =============================================================================
 
+void satisfaction_tour_init(TourSatisfaction* tour) {
+    if (!tour) return;
+    memset(tour, 0, sizeof(TourSatisfaction));
+}
+
+void satisfaction_tour_shutdown(TourSatisfaction* tour) {
+    if (!tour) return;
+    bitset_shutdown(&tour->visited);
+    memset(tour, 0, sizeof(TourSatisfaction));
+}
+
 void satisfaction_tour_start(TourSatisfaction* tour) {
     if (!tour) return;
     
+    // Reset everything but the visit bitset's memory
+    Bitset visited = tour->visited;
+    bitset_clear_all(&visited);
     memset(tour, 0, sizeof(TourSatisfaction));
+    tour->visited = visited;
     tour->active = true;
 }
 
@@ -35,36 +51,24 @@ int satisfaction_record_poi_visit(TourSatisfaction* tour, const POIEcsWorld* poi
                                   int poi_index) {
     if (!tour || !tour->active || !poi_world) return 0;
     if (!poi_ecs_is_valid(poi_world, poi_index)) return 0;
-    if (tour->visited_count >= MAX_TOUR_POIS) return 0;
     
     // Check if already visited this tour
     if (satisfaction_was_poi_visited(tour, poi_index)) return 0;
     
-    // Record the visit
-    tour->visited_poi_indices[tour->visited_count] = poi_index;
+    // Record the visit (the bitset follows the POI capacity)
+    if ((uint32_t)poi_index >= tour->visited.bit_count &&
+        !bitset_resize(&tour->visited, poi_ecs_get_capacity(poi_world))) {
+        return 0;
+    }
+    bitset_set(&tour->visited, (uint32_t)poi_index);
     tour->visited_count++;
     
-    // Get POI info
+    // Apply type and tier tracking
     POIType type = poi_ecs_get_type(poi_world, poi_index);
     POITier tier = poi_ecs_get_tier(poi_world, poi_index);
-    (void)tier;  // Used below in tracking
-    
-    // Apply type tracking
-    switch (type) {
-        case POI_TYPE_NATURE:
-            tour->has_nature = true;
-            break;
-        case POI_TYPE_HISTORICAL:
-            tour->has_historical = true;
-            break;
-        case POI_TYPE_MILITARY:
-            tour->has_military = true;
-            break;
-        default:
-            break;
+    if (type < POI_TYPE_COUNT && tour->type_counts[type]++ == 0) {
+        tour->types_visited++;
     }
-    
-    // Apply tier tracking
     if (tier == POI_TIER_SPECIAL) {
         tour->special_count++;
     } else {
@@ -78,14 +82,9 @@ int satisfaction_record_poi_visit(TourSatisfaction* tour, const POIEcsWorld* poi
     tour->poi_bonus_total += bonus;
     
     // Update variety bonus
-    int types_visited = 0;
-    if (tour->has_nature) types_visited++;
-    if (tour->has_historical) types_visited++;
-    if (tour->has_military) types_visited++;
-    
-    if (types_visited >= 3) {
+    if (tour->types_visited >= 3) {
         tour->variety_bonus = config.variety_bonus_3_types;
-    } else if (types_visited >= 2) {
+    } else if (tour->types_visited >= 2) {
         tour->variety_bonus = config.variety_bonus_2_types;
     }
     
@@ -93,14 +92,13 @@ int satisfaction_record_poi_visit(TourSatisfaction* tour, const POIEcsWorld* poi
 }
 
 bool satisfaction_was_poi_visited(const TourSatisfaction* tour, int poi_index) {
-    if (!tour) return false;
-    
-    for (uint32_t i = 0; i < tour->visited_count; i++) {
-        if (tour->visited_poi_indices[i] == poi_index) {
-            return true;
-        }
-    }
-    return false;
+    if (!tour || poi_index < 0) return false;
+    return bitset_test(&tour->visited, (uint32_t)poi_index);
+}
+
+uint32_t satisfaction_count_visited_in(const TourSatisfaction* tour, const Bitset* pois) {
+    if (!tour || !pois) return 0;
+    return bitset_count_and(&tour->visited, pois);
 }
 
 // =============================================================================
@@ -163,6 +161,22 @@ SatisfactionConfig satisfaction_get_default_config(void) {
     return config;
 }
 
+SatisfactionConfig satisfaction_get_config(const ConfigFile* config) {
+    SatisfactionConfig sc = satisfaction_get_default_config();
+    
+    if (!config || !config->loaded) return sc;
+    
+    sc.nature_multiplier = config_get_float(config, "Satisfaction", "nature_multiplier", sc.nature_multiplier);
+    sc.historical_multiplier = config_get_float(config, "Satisfaction", "historical_multiplier", sc.historical_multiplier);
+    sc.military_multiplier = config_get_float(config, "Satisfaction", "military_multiplier", sc.military_multiplier);
+    sc.special_tier_multiplier = config_get_float(config, "Satisfaction", "special_tier_multiplier", sc.special_tier_multiplier);
+    sc.variety_bonus_2_types = config_get_int(config, "Satisfaction", "variety_bonus_2_types", sc.variety_bonus_2_types);
+    sc.variety_bonus_3_types = config_get_int(config, "Satisfaction", "variety_bonus_3_types", sc.variety_bonus_3_types);
+    sc.base_satisfaction = config_get_int(config, "Satisfaction", "base_satisfaction", sc.base_satisfaction);
+    
+    return sc;
+}
+
 int satisfaction_calculate_poi_bonus(const POIEcsWorld* poi_world, int poi_index,
                                      const SatisfactionConfig* config) {
     if (!poi_world || !config) return 0;
@@ -213,17 +227,216 @@ TourStats satisfaction_get_tour_stats(const TourSatisfaction* tour) {
     stats.pois_visited = tour->visited_count;
     stats.general_visited = tour->general_count;
     stats.special_visited = tour->special_count;
+    stats.nature_visited = tour->type_counts[POI_TYPE_NATURE];
+    stats.historical_visited = tour->type_counts[POI_TYPE_HISTORICAL];
+    stats.military_visited = tour->type_counts[POI_TYPE_MILITARY];
     stats.poi_bonus = tour->poi_bonus_total;
     stats.variety_bonus = tour->variety_bonus;
     
-    // Count types (need to track separately if POI world not available)
-    if (tour->has_nature) stats.nature_visited++;
-    if (tour->has_historical) stats.historical_visited++;
-    if (tour->has_military) stats.military_visited++;
+    return stats;
+}
+
+// =============================================================================
+// Fleet Tours (ECS)
+// =============================================================================
+
+static inline bool tour_entity_valid(Entity ship) {
+    return ship != INVALID_ENTITY && ship < MAX_ENTITIES;
+}
+
+void tour_ecs_init(TourEcsWorld* tour_world, const SatisfactionConfig* config) {
+    if (!tour_world) return;
     
+    memset(tour_world, 0, sizeof(TourEcsWorld));
+    tour_world->config = config ? *config : satisfaction_get_default_config();
+    tour_world->table_dirty = true;
+    tour_world->initialized = true;
+}
+
+void tour_ecs_shutdown(TourEcsWorld* tour_world) {
+    if (!tour_world) return;
+    
+    for (uint32_t e = 0; e < MAX_ENTITIES; e++) {
+        bitset_shutdown(&tour_world->tours.visited[e]);
+    }
+    free(tour_world->poi_bonus);
+    free(tour_world->poi_type_bit);
+    free(tour_world->poi_special);
+    memset(tour_world, 0, sizeof(TourEcsWorld));
+}
+
+void tour_ecs_set_config(TourEcsWorld* tour_world, const SatisfactionConfig* config) {
+    if (!tour_world || !config) return;
+    tour_world->config = *config;
+    tour_world->table_dirty = true;
+}
+
+bool tour_ecs_rebuild_tables(TourEcsWorld* tour_world, const POIEcsWorld* poi_world) {
+    if (!tour_world || !tour_world->initialized || !poi_world) return false;
+    
+    uint32_t count = poi_ecs_get_count(poi_world);
+    if (count > tour_world->table_capacity) {
+        int32_t* bonus = (int32_t*)realloc(tour_world->poi_bonus, count * sizeof(int32_t));
+        if (bonus) tour_world->poi_bonus = bonus;
+        uint8_t* type_bit = (uint8_t*)realloc(tour_world->poi_type_bit, count);
+        if (type_bit) tour_world->poi_type_bit = type_bit;
+        uint8_t* special = (uint8_t*)realloc(tour_world->poi_special, count);
+        if (special) tour_world->poi_special = special;
+        if (!bonus || !type_bit || !special) {
+            printf("Satisfaction: Failed to allocate tables for %u POIs\n", count);
+            return false;
+        }
+        tour_world->table_capacity = count;
+    }
+    
+    for (uint32_t i = 0; i < count; i++) {
+        tour_world->poi_bonus[i] = satisfaction_calculate_poi_bonus(poi_world, (int)i, &tour_world->config);
+        tour_world->poi_type_bit[i] = (uint8_t)(1u << poi_world->pois.type[i]);
+        tour_world->poi_special[i] = poi_world->pois.tier[i] == POI_TIER_SPECIAL;
+    }
+    tour_world->table_count = count;
+    tour_world->table_dirty = false;
+    return true;
+}
+
+void tour_ecs_start(TourEcsWorld* tour_world, Entity ship) {
+    if (!tour_world || !tour_entity_valid(ship)) return;
+    
+    TourComponents* t = &tour_world->tours;
+    t->poi_bonus_total[ship] = 0;
+    t->score[ship] = tour_world->config.base_satisfaction;
+    t->visited_count[ship] = 0;
+    for (int type = 0; type < POI_TYPE_COUNT; type++) {
+        t->type_count[type][ship] = 0;
+    }
+    t->special_count[ship] = 0;
+    t->type_mask[ship] = 0;
+    t->active[ship] = 1;
+    bitset_clear_all(&t->visited[ship]);
+}
+
+void tour_ecs_end(TourEcsWorld* tour_world, Entity ship) {
+    if (!tour_world || !tour_entity_valid(ship)) return;
+    tour_world->tours.active[ship] = 0;
+}
+
+bool tour_ecs_is_active(const TourEcsWorld* tour_world, Entity ship) {
+    if (!tour_world || !tour_entity_valid(ship)) return false;
+    return tour_world->tours.active[ship] != 0;
+}
+
+int tour_ecs_get_score(const TourEcsWorld* tour_world, Entity ship) {
+    if (!tour_world || !tour_entity_valid(ship)) return 0;
+    return tour_world->tours.score[ship];
+}
+
+TourStats tour_ecs_get_stats(const TourEcsWorld* tour_world, Entity ship) {
+    TourStats stats = {0};
+    
+    if (!tour_world || !tour_entity_valid(ship)) return stats;
+    
+    const TourComponents* t = &tour_world->tours;
+    stats.total_satisfaction = t->score[ship];
+    stats.rating = satisfaction_get_rating(stats.total_satisfaction);
+    stats.pois_visited = t->visited_count[ship];
+    stats.nature_visited = t->type_count[POI_TYPE_NATURE][ship];
+    stats.historical_visited = t->type_count[POI_TYPE_HISTORICAL][ship];
+    stats.military_visited = t->type_count[POI_TYPE_MILITARY][ship];
+    stats.special_visited = t->special_count[ship];
+    stats.general_visited = t->visited_count[ship] - t->special_count[ship];
+    stats.poi_bonus = t->poi_bonus_total[ship];
+    
+    uint32_t mask = t->type_mask[ship];
+    uint32_t types = (mask & 1u) + ((mask >> 1) & 1u) + ((mask >> 2) & 1u);
+    stats.variety_bonus = types >= 3 ? tour_world->config.variety_bonus_3_types
+                        : types >= 2 ? tour_world->config.variety_bonus_2_types : 0;
     return stats;
 }
 
+// Visits follow poi_ecs_destroy's swap: the destroyed POI's bit is dropped
+// (a POI created in its place is a new POI) and the moved POI's bit moves
+// with it. Earned bonuses and counts stay. Rare, so every tour is scanned.
+static void tour_ecs_follow_poi_destroy(TourEcsWorld* tour_world, uint32_t poi, uint32_t moved_from) {
+    TourComponents* t = &tour_world->tours;
+    for (uint32_t e = 0; e < MAX_ENTITIES; e++) {
+        Bitset* visited = &t->visited[e];
+        if (visited->bit_count == 0) continue;
+        
+        bitset_reset(visited, poi);
+        if (moved_from != poi && bitset_test(visited, moved_from)) {
+            bitset_reset(visited, moved_from);
+            bitset_set(visited, poi);
+        }
+    }
+}
+
+uint32_t satisfaction_system_update(TourEcsWorld* tour_world, const ECSWorld* ecs_world,
+                                    const POIEcsWorld* poi_world, EventRingReader* reader) {
+    if (!tour_world || !tour_world->initialized || !ecs_world || !poi_world || !reader) return 0;
+    
+    if (tour_world->table_dirty || tour_world->table_count != poi_ecs_get_count(poi_world)) {
+        tour_ecs_rebuild_tables(tour_world, poi_world);
+    }
+    
+    TourComponents* t = &tour_world->tours;
+    uint32_t new_visits = 0;
+    
+    // 1. Apply this tick's enter events (a handful; each is a few table lookups)
+    const POIEvent* event;
+    while ((event = poi_ecs_events_next(poi_world, reader)) != NULL) {
+        if (event->type == POI_EVENT_DESTROY) {
+            // Tables follow too (a destroy + create keeps the count)
+            tour_ecs_follow_poi_destroy(tour_world, event->poi_index, event->moved_from);
+            tour_ecs_rebuild_tables(tour_world, poi_world);
+            continue;
+        }
+        if (event->type != POI_EVENT_ENTER) continue;
+        
+        Entity ship = event->ship;
+        uint32_t poi = event->poi_index;
+        if (!tour_entity_valid(ship) || !t->active[ship]) continue;
+        if (!ecs_has_component(ecs_world, ship, COMPONENT_TOUR)) continue;
+        if (poi >= tour_world->table_count) continue;
+        if (bitset_test(&t->visited[ship], poi)) continue;
+        
+        if (poi >= t->visited[ship].bit_count &&
+            !bitset_resize(&t->visited[ship], poi_ecs_get_capacity(poi_world))) {
+            continue;
+        }
+        bitset_set(&t->visited[ship], poi);
+        
+        uint8_t type_bit = tour_world->poi_type_bit[poi];
+        t->poi_bonus_total[ship] += tour_world->poi_bonus[poi];
+        t->visited_count[ship]++;
+        t->special_count[ship] += tour_world->poi_special[poi];
+        t->type_mask[ship] |= type_bit;
+        for (int type = 0; type < POI_TYPE_COUNT; type++) {
+            t->type_count[type][ship] += (type_bit >> type) & 1u;
+        }
+        new_visits++;
+    }
+    
+    // 2. Rescore every tour: straight-line SoA arithmetic with no branches
+    // or table lookups, so the compiler vectorizes it. Ended tours stop
+    // receiving visits above, so their score holds.
+    const int32_t base = tour_world->config.base_satisfaction;
+    const int32_t variety_2 = tour_world->config.variety_bonus_2_types;
+    const int32_t variety_3_extra = tour_world->config.variety_bonus_3_types - variety_2;
+    const int32_t* bonus_total = t->poi_bonus_total;
+    const uint8_t* type_mask = t->type_mask;
+    int32_t* score = t->score;
+    
+    for (uint32_t e = 0; e < MAX_ENTITIES; e++) {
+        int32_t mask = type_mask[e];
+        int32_t types = (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1);
+        int32_t value = base + bonus_total[e] + (types >= 2) * variety_2 + (types >= 3) * variety_3_extra;
+        value = value < 0 ? 0 : value;
+        score[e] = value > 100 ? 100 : value;
+    }
+    
+    return new_visits;
+}
+
 // =============================================================================
 // Debug
 // =============================================================================
@@ -240,10 +453,8 @@ void satisfaction_debug_print(const TourSatisfaction* tour) {
     printf("  Score: %d (%s)\n", stats.total_satisfaction, 
            satisfaction_rating_to_string(stats.rating));
     printf("  POIs Visited: %u\n", stats.pois_visited);
-    printf("    Nature: %s, Historical: %s, Military: %s\n",
-           tour->has_nature ? "Yes" : "No",
-           tour->has_historical ? "Yes" : "No",
-           tour->has_military ? "Yes" : "No");
+    printf("    Nature: %u, Historical: %u, Military: %u\n",
+           stats.nature_visited, stats.historical_visited, stats.military_visited);
     printf("    General: %u, Special: %u\n", stats.general_visited, stats.special_visited);
     printf("  Bonuses: POI=%d, Variety=%d\n", stats.poi_bonus, stats.variety_bonus);
 }
@@ -1,5 +1,6 @@
 #include "game_ship_ecs.h"
 #include "engine_math.h"
+#include "engine_simd_math.h"
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
@@ -83,28 +84,59 @@ float ship_ecs_get_rudder(const ShipEcsWorld* ship_world, Entity e) {
 }
 
 // =============================================================================
-// Ship Physics System
+// Scalar Kernel (reference)
 // =============================================================================
 
-void ship_ecs_system_physics(ECSWorld* ecs_world, ShipEcsWorld* ship_world, float delta_time) {
-    if (!ecs_world || !ship_world) return;
+static inline bool lane_active(const ShipPhysicsColumns* c, uint32_t i) {
+    return !c->masks || (c->masks[i] & c->required) == c->required;
+}
+
+ShipPhysicsColumns ship_physics_columns_from_ecs(ECSWorld* ecs_world, ShipEcsWorld* ship_world) {
+    ShipPhysicsColumns c;
+    ShipComponents* ships = &ship_world->ships;
     
-    ComponentMask required = COMPONENT_TRANSFORM | COMPONENT_VELOCITY | COMPONENT_SHIP;
+    c.throttle = ships->throttle;
+    c.target_throttle = ships->target_throttle;
+    c.rudder = ships->rudder;
+    c.target_rudder = ships->target_rudder;
+    c.max_speed = ships->max_speed;
+    c.acceleration = ships->acceleration;
+    c.turn_rate = ships->turn_rate;
+    c.throttle_response = ships->throttle_response;
+    c.steering_response = ships->steering_response;
+    c.coast_friction = ships->coast_friction;
+    c.drift_factor = ships->drift_factor;
+    c.reverse_speed_mult = ships->reverse_speed_mult;
+    c.reverse_accel_mult = ships->reverse_accel_mult;
+    c.speed_turn_factor = ships->speed_turn_factor;
+    c.rotation = ecs_world->transforms.rotation;
+    c.speed = ecs_world->velocities.speed;
+    c.angular_vel = ecs_world->velocities.angular_vel;
+    c.vel_x = ecs_world->velocities.vel_x;
+    c.vel_y = ecs_world->velocities.vel_y;
+    c.masks = ecs_world->entity_masks;
+    c.required = COMPONENT_TRANSFORM | COMPONENT_VELOCITY | COMPONENT_SHIP;
+    return c;
+}
+
+void ship_physics_kernel_scalar(const ShipPhysicsColumns* c, uint32_t begin, uint32_t end,
+                                float delta_time) {
+    if (!c) return;
     
-    for (Entity e = 1; e < MAX_ENTITIES; e++) {
-        if ((ecs_world->entity_masks[e] & required) != required) continue;
+    for (uint32_t e = begin; e < end; e++) {
+        if (!lane_active(c, e)) continue;
         
-        // Get per-entity config values from ship world
-        float throttle_response = ship_world->ships.throttle_response[e];
-        float steering_response = ship_world->ships.steering_response[e];
-        float max_speed = ship_world->ships.max_speed[e];
-        float accel = ship_world->ships.acceleration[e];
-        float turn_rate = ship_world->ships.turn_rate[e];
-        float speed_turn_factor = ship_world->ships.speed_turn_factor[e];
-        float reverse_speed_mult = ship_world->ships.reverse_speed_mult[e];
-        float reverse_accel_mult = ship_world->ships.reverse_accel_mult[e];
-        float coast_friction = ship_world->ships.coast_friction[e];
-        float drift_factor = ship_world->ships.drift_factor[e];
+        // Get per-entity config values
+        float throttle_response = c->throttle_response[e];
+        float steering_response = c->steering_response[e];
+        float max_speed = c->max_speed[e];
+        float accel = c->acceleration[e];
+        float turn_rate = c->turn_rate[e];
+        float speed_turn_factor = c->speed_turn_factor[e];
+        float reverse_speed_mult = c->reverse_speed_mult[e];
+        float reverse_accel_mult = c->reverse_accel_mult[e];
+        float coast_friction = c->coast_friction[e];
+        float drift_factor = c->drift_factor[e];
         
         // Smooth throttle/rudder inputs using config response times
         float throttle_rate = (throttle_response > 0.0f) 
@@ -117,15 +149,11 @@ void ship_ecs_system_physics(ECSWorld* ecs_world, ShipEcsWorld* ship_world, floa
         throttle_rate = math_clamp(throttle_rate, 0.0f, 1.0f);
         rudder_rate = math_clamp(rudder_rate, 0.0f, 1.0f);
         
-        ship_world->ships.throttle[e] = math_lerp(ship_world->ships.throttle[e], 
-                                                   ship_world->ships.target_throttle[e], 
-                                                   throttle_rate);
-        ship_world->ships.rudder[e] = math_lerp(ship_world->ships.rudder[e],
-                                                 ship_world->ships.target_rudder[e],
-                                                 rudder_rate);
+        c->throttle[e] = math_lerp(c->throttle[e], c->target_throttle[e], throttle_rate);
+        c->rudder[e] = math_lerp(c->rudder[e], c->target_rudder[e], rudder_rate);
         
-        float throttle = ship_world->ships.throttle[e];
-        float current_speed = ecs_world->velocities.speed[e];
+        float throttle = c->throttle[e];
+        float current_speed = c->speed[e];
         
         // Calculate target speed (handle reverse)
         float target_speed = throttle * max_speed;
@@ -156,7 +184,7 @@ void ship_ecs_system_physics(ECSWorld* ecs_world, ShipEcsWorld* ship_world, floa
                 }
             }
         }
-        ecs_world->velocities.speed[e] = current_speed;
+        c->speed[e] = current_speed;
         
         // Calculate turn effectiveness based on speed
         float speed_ratio = math_abs(current_speed) / max_speed;
@@ -164,46 +192,347 @@ void ship_ecs_system_physics(ECSWorld* ecs_world, ShipEcsWorld* ship_world, floa
                                    (1.0f - speed_turn_factor) * speed_ratio;
         
         // Calculate target angular velocity
-        float rudder = ship_world->ships.rudder[e];
+        float rudder = c->rudder[e];
         float target_angular = rudder * turn_rate * turn_effectiveness;
         
         // Smooth angular velocity
-        float angular_diff = target_angular - ecs_world->velocities.angular_vel[e];
+        float angular_diff = target_angular - c->angular_vel[e];
         float angular_accel = turn_rate * 2.0f * delta_time;
         
         if (math_abs(angular_diff) > 0.1f) {
             if (angular_diff > 0) {
-                ecs_world->velocities.angular_vel[e] = math_min(
-                    ecs_world->velocities.angular_vel[e] + angular_accel, target_angular);
+                c->angular_vel[e] = math_min(c->angular_vel[e] + angular_accel, target_angular);
             } else {
-                ecs_world->velocities.angular_vel[e] = math_max(
-                    ecs_world->velocities.angular_vel[e] - angular_accel, target_angular);
+                c->angular_vel[e] = math_max(c->angular_vel[e] - angular_accel, target_angular);
             }
         }
         
         // Decay angular velocity when not turning
         if (math_abs(rudder) < 0.01f) {
-            ecs_world->velocities.angular_vel[e] *= powf(0.9f, delta_time * 60.0f);
-            if (math_abs(ecs_world->velocities.angular_vel[e]) < 0.1f) {
-                ecs_world->velocities.angular_vel[e] = 0.0f;
+            c->angular_vel[e] *= powf(0.9f, delta_time * 60.0f);
+            if (math_abs(c->angular_vel[e]) < 0.1f) {
+                c->angular_vel[e] = 0.0f;
             }
         }
         
         // Calculate velocity from speed and heading
-        float heading_rad = math_deg_to_rad(ecs_world->transforms.rotation[e] - 90.0f);
-        ecs_world->velocities.vel_x[e] = cosf(heading_rad) * ecs_world->velocities.speed[e];
-        ecs_world->velocities.vel_y[e] = sinf(heading_rad) * ecs_world->velocities.speed[e];
+        float heading_rad = math_deg_to_rad(c->rotation[e] - 90.0f);
+        c->vel_x[e] = cosf(heading_rad) * c->speed[e];
+        c->vel_y[e] = sinf(heading_rad) * c->speed[e];
         
         // Apply drift during turns
-        float angular_vel = ecs_world->velocities.angular_vel[e];
+        float angular_vel = c->angular_vel[e];
         if (math_abs(angular_vel) > 0.1f && math_abs(current_speed) > 0.1f) {
-            float drift_angle = ecs_world->transforms.rotation[e] + (angular_vel > 0 ? 90.0f : -90.0f);
+            float drift_angle = c->rotation[e] + (angular_vel > 0 ? 90.0f : -90.0f);
             float drift_rad = math_deg_to_rad(drift_angle);
             float drift_magnitude = drift_factor * math_abs(angular_vel) * 
                                     math_abs(current_speed) * 0.01f * delta_time;
             
-            ecs_world->velocities.vel_x[e] += cosf(drift_rad) * drift_magnitude;
-            ecs_world->velocities.vel_y[e] += sinf(drift_rad) * drift_magnitude;
+            c->vel_x[e] += cosf(drift_rad) * drift_magnitude;
+            c->vel_y[e] += sinf(drift_rad) * drift_magnitude;
         }
     }
 }
+
+// =============================================================================
+// Wide Kernel
+// =============================================================================
+
+// Lanes whose entity has every required component
+static inline simd8f lane_active_mask(const ShipPhysicsColumns* c, uint32_t i) {
+    if (!c->masks) return simd8i_as_float(simd8i_set(-1));
+    simd8i required = simd8i_set((int32_t)c->required);
+    return simd8i_as_float(simd8i_eq(simd8i_and(simd8i_load(&c->masks[i]), required), required));
+}
+
+void ship_physics_kernel_wide(const ShipPhysicsColumns* c, uint32_t begin, uint32_t end,
+                              float delta_time) {
+    if (!c) return;
+    
+    const simd8f zero = simd8_set(0.0f);
+    const simd8f one = simd8_set(1.0f);
+    const simd8f dt = simd8_set(delta_time);
+    const simd8f frames = simd8_set(delta_time * 60.0f);
+    const simd8f angular_decay = simd8_set(powf(0.9f, delta_time * 60.0f));
+    
+    // Coast decay depends only on tuning, which ships mostly share: take it
+    // once for the first ship's friction, and only groups holding other
+    // values pay for the wide pow
+    uint32_t first = begin;
+    while (first < end && !lane_active(c, first)) first++;
+    float shared = first < end ? c->coast_friction[first] : 0.0f;
+    const simd8f shared_friction = simd8_set(shared);
+    const simd8f shared_decay = simd8_set(powf(1.0f - shared, delta_time * 60.0f));
+    
+    uint32_t i = begin;
+    for (; i + SHIP_PHYSICS_LANES <= end; i += SHIP_PHYSICS_LANES) {
+        // Whole groups of dead or non-ship slots cost one mask test
+        simd8f active = lane_active_mask(c, i);
+        int active_bits = simd8_mask_bits(active);
+        if (active_bits == 0) continue;
+        
+        // Smooth throttle/rudder toward targets (rate 1 when response is 0)
+        simd8f throttle_response = simd8_load(&c->throttle_response[i]);
+        simd8f steering_response = simd8_load(&c->steering_response[i]);
+        simd8f throttle_rate = simd8_select(simd8_gt(throttle_response, zero),
+                                            simd8_min(simd8_div(dt, throttle_response), one), one);
+        simd8f rudder_rate = simd8_select(simd8_gt(steering_response, zero),
+                                          simd8_min(simd8_div(dt, steering_response), one), one);
+        throttle_rate = simd8_max(throttle_rate, zero);
+        rudder_rate = simd8_max(rudder_rate, zero);
+        
+        simd8f throttle_old = simd8_load(&c->throttle[i]);
+        simd8f rudder_old = simd8_load(&c->rudder[i]);
+        simd8f throttle = simd8_add(throttle_old, simd8_mul(simd8_sub(simd8_load(&c->target_throttle[i]), throttle_old), throttle_rate));
+        simd8f rudder = simd8_add(rudder_old, simd8_mul(simd8_sub(simd8_load(&c->target_rudder[i]), rudder_old), rudder_rate));
+        
+        // Target speed and acceleration (reverse is slower)
+        simd8f max_speed = simd8_load(&c->max_speed[i]);
+        simd8f reverse = simd8_lt(throttle, zero);
+        simd8f target_speed = simd8_mul(simd8_mul(throttle, max_speed),
+                                        simd8_select(reverse, simd8_load(&c->reverse_speed_mult[i]), one));
+        simd8f accel = simd8_mul(simd8_load(&c->acceleration[i]),
+                                 simd8_select(reverse, simd8_load(&c->reverse_accel_mult[i]), one));
+        
+        // Coasting: speed * (1 - friction)^(dt * 60), snapped to 0 when slow
+        simd8f speed_old = simd8_load(&c->speed[i]);
+        simd8f coast_friction = simd8_load(&c->coast_friction[i]);
+        int shared_bits = simd8_mask_bits(simd8_eq(coast_friction, shared_friction));
+        simd8f coast_decay = shared_decay;
+        if ((shared_bits & active_bits) != active_bits) {
+            coast_decay = simd8_pow(simd8_sub(one, coast_friction), frames);
+        }
+        simd8f coast_speed = simd8_mul(speed_old, coast_decay);
+        coast_speed = simd8_select(simd8_lt(simd8_abs(coast_speed), simd8_set(0.5f)), zero, coast_speed);
+        
+        // Accelerating: step toward the target without overshooting
+        simd8f speed_diff = simd8_sub(target_speed, speed_old);
+        simd8f accel_amount = simd8_mul(accel, dt);
+        simd8f accel_speed = simd8_select(simd8_gt(speed_diff, zero),
+                                          simd8_min(simd8_add(speed_old, accel_amount), target_speed),
+                                          simd8_max(simd8_sub(speed_old, accel_amount), target_speed));
+        accel_speed = simd8_select(simd8_gt(simd8_abs(speed_diff), simd8_set(0.1f)), accel_speed, speed_old);
+        
+        simd8f coasting = simd8_lt(simd8_abs(throttle), simd8_set(0.01f));
+        simd8f speed = simd8_select(coasting, coast_speed, accel_speed);
+        
+        // Turn rate scales with speed
+        simd8f turn_rate = simd8_load(&c->turn_rate[i]);
+        simd8f speed_turn_factor = simd8_load(&c->speed_turn_factor[i]);
+        simd8f speed_ratio = simd8_div(simd8_abs(speed), max_speed);
+        simd8f turn_effectiveness = simd8_add(speed_turn_factor,
+                                              simd8_mul(simd8_sub(one, speed_turn_factor), speed_ratio));
+        simd8f target_angular = simd8_mul(simd8_mul(rudder, turn_rate), turn_effectiveness);
+        
+        simd8f angular_old = simd8_load(&c->angular_vel[i]);
+        simd8f angular_diff = simd8_sub(target_angular, angular_old);
+        simd8f angular_accel = simd8_mul(simd8_mul(turn_rate, simd8_set(2.0f)), dt);
+        simd8f angular = simd8_select(simd8_gt(angular_diff, zero),
+                                      simd8_min(simd8_add(angular_old, angular_accel), target_angular),
+                                      simd8_max(simd8_sub(angular_old, angular_accel), target_angular));
+        angular = simd8_select(simd8_gt(simd8_abs(angular_diff), simd8_set(0.1f)), angular, angular_old);
+        
+        // Decay angular velocity when the rudder is centred
+        simd8f decayed = simd8_mul(angular, angular_decay);
+        decayed = simd8_select(simd8_lt(simd8_abs(decayed), simd8_set(0.1f)), zero, decayed);
+        angular = simd8_select(simd8_lt(simd8_abs(rudder), simd8_set(0.01f)), decayed, angular);
+        
+        // Heading 0 = north, so forward is (sin r, -cos r)
+        simd8f sin_r, cos_r;
+        simd8_sincos_deg(simd8_load(&c->rotation[i]), &sin_r, &cos_r);
+        simd8f vel_x = simd8_mul(sin_r, speed);
+        simd8f vel_y = simd8_mul(simd8_sub(zero, cos_r), speed);
+        
+        // Drift along (-sin r, cos r), signed by the turn direction
+        simd8f abs_angular = simd8_abs(angular);
+        simd8f abs_speed = simd8_abs(speed);
+        simd8f drifting = simd8_and(simd8_gt(abs_angular, simd8_set(0.1f)), simd8_gt(abs_speed, simd8_set(0.1f)));
+        simd8f drift = simd8_mul(simd8_mul(simd8_mul(simd8_load(&c->drift_factor[i]), abs_angular),
+                                           simd8_mul(abs_speed, simd8_set(0.01f))), dt);
+        drift = simd8_and(drifting, simd8_select(simd8_gt(angular, zero), drift, simd8_sub(zero, drift)));
+        vel_x = simd8_sub(vel_x, simd8_mul(sin_r, drift));
+        vel_y = simd8_add(vel_y, simd8_mul(cos_r, drift));
+        
+        // Write back only lanes that are ships
+        simd8_store(&c->throttle[i], simd8_select(active, throttle, throttle_old));
+        simd8_store(&c->rudder[i], simd8_select(active, rudder, rudder_old));
+        simd8_store(&c->speed[i], simd8_select(active, speed, speed_old));
+        simd8_store(&c->angular_vel[i], simd8_select(active, angular, angular_old));
+        simd8_store(&c->vel_x[i], simd8_select(active, vel_x, simd8_load(&c->vel_x[i])));
+        simd8_store(&c->vel_y[i], simd8_select(active, vel_y, simd8_load(&c->vel_y[i])));
+    }
+    
+    ship_physics_kernel_scalar(c, i, end, delta_time);
+}
+
+// =============================================================================
+// Ship Physics System
+// =============================================================================
+
+void ship_ecs_system_physics(ECSWorld* ecs_world, ShipEcsWorld* ship_world, float delta_time) {
+    if (!ecs_world || !ship_world) return;
+    
+    ShipPhysicsColumns columns = ship_physics_columns_from_ecs(ecs_world, ship_world);
+    ship_physics_kernel_wide(&columns, 0, MAX_ENTITIES, delta_time);
+}
+
+void ship_ecs_system_physics_reference(ECSWorld* ecs_world, ShipEcsWorld* ship_world, float delta_time) {
+    if (!ecs_world || !ship_world) return;
+    
+    ShipPhysicsColumns columns = ship_physics_columns_from_ecs(ecs_world, ship_world);
+    ship_physics_kernel_scalar(&columns, 1, MAX_ENTITIES, delta_time);
+}
+
+// =============================================================================
+// Adaptive Sub-stepping
+// =============================================================================
+
+// Thresholds match the kernel's: below them it neither turns nor accelerates
+#define STEADY_RUDDER 0.01f
+#define STEADY_THROTTLE 0.0001f
+#define STEADY_SPEED 0.1f
+
+bool ship_ecs_is_steady(const ECSWorld* ecs_world, const ShipEcsWorld* ship_world, Entity e) {
+    if (!ecs_world || !ship_world || e == INVALID_ENTITY || e >= MAX_ENTITIES) return false;
+    const ShipComponents* s = &ship_world->ships;
+    
+    if (math_abs(s->rudder[e]) >= STEADY_RUDDER || math_abs(s->target_rudder[e]) >= STEADY_RUDDER) return false;
+    if (ecs_world->velocities.angular_vel[e] != 0.0f) return false;
+    if (math_abs(s->throttle[e] - s->target_throttle[e]) >= STEADY_THROTTLE) return false;
+    
+    float speed = ecs_world->velocities.speed[e];
+    float throttle = s->throttle[e];
+    if (math_abs(throttle) < 0.01f) {
+        // Coasting decays the speed every step; only a ship at rest is steady
+        return speed == 0.0f;
+    }
+    float target_speed = throttle * s->max_speed[e];
+    if (throttle < 0.0f) target_speed *= s->reverse_speed_mult[e];
+    return math_abs(target_speed - speed) <= STEADY_SPEED;
+}
+
+void ship_ecs_substep_begin(const ECSWorld* ecs_world, ShipEcsWorld* ship_world,
+                            const Entity* fine, uint32_t fine_count) {
+    if (!ecs_world || !ship_world) return;
+    const ShipComponents* s = &ship_world->ships;
+    ShipSubstepBatch* b = &ship_world->substeps;
+    
+    b->count = 0;
+    for (uint32_t i = 0; fine && i < fine_count && b->count < MAX_ENTITIES; i++) {
+        Entity e = fine[i];
+        if (e == INVALID_ENTITY || e >= MAX_ENTITIES) continue;
+        uint32_t j = b->count++;
+        
+        b->entity[j] = e;
+        b->throttle[j] = s->throttle[e];
+        b->target_throttle[j] = s->target_throttle[e];
+        b->rudder[j] = s->rudder[e];
+        b->target_rudder[j] = s->target_rudder[e];
+        b->max_speed[j] = s->max_speed[e];
+        b->acceleration[j] = s->acceleration[e];
+        b->turn_rate[j] = s->turn_rate[e];
+        b->throttle_response[j] = s->throttle_response[e];
+        b->steering_response[j] = s->steering_response[e];
+        b->coast_friction[j] = s->coast_friction[e];
+        b->drift_factor[j] = s->drift_factor[e];
+        b->reverse_speed_mult[j] = s->reverse_speed_mult[e];
+        b->reverse_accel_mult[j] = s->reverse_accel_mult[e];
+        b->speed_turn_factor[j] = s->speed_turn_factor[e];
+        
+        b->pos_x[j] = ecs_world->transforms.pos_x[e];
+        b->pos_y[j] = ecs_world->transforms.pos_y[e];
+        b->rotation[j] = ecs_world->transforms.rotation[e];
+        b->speed[j] = ecs_world->velocities.speed[e];
+        b->angular_vel[j] = ecs_world->velocities.angular_vel[e];
+        b->vel_x[j] = ecs_world->velocities.vel_x[e];
+        b->vel_y[j] = ecs_world->velocities.vel_y[e];
+    }
+}
+
+static ShipPhysicsColumns substep_columns(ShipSubstepBatch* b) {
+    ShipPhysicsColumns c;
+    c.throttle = b->throttle;
+    c.target_throttle = b->target_throttle;
+    c.rudder = b->rudder;
+    c.target_rudder = b->target_rudder;
+    c.max_speed = b->max_speed;
+    c.acceleration = b->acceleration;
+    c.turn_rate = b->turn_rate;
+    c.throttle_response = b->throttle_response;
+    c.steering_response = b->steering_response;
+    c.coast_friction = b->coast_friction;
+    c.drift_factor = b->drift_factor;
+    c.reverse_speed_mult = b->reverse_speed_mult;
+    c.reverse_accel_mult = b->reverse_accel_mult;
+    c.speed_turn_factor = b->speed_turn_factor;
+    c.rotation = b->rotation;
+    c.speed = b->speed;
+    c.angular_vel = b->angular_vel;
+    c.vel_x = b->vel_x;
+    c.vel_y = b->vel_y;
+    c.masks = NULL;
+    c.required = 0;
+    return c;
+}
+
+void ship_ecs_substep_end(ECSWorld* ecs_world, ShipEcsWorld* ship_world,
+                          float base_dt, uint32_t steps) {
+    if (!ecs_world || !ship_world) return;
+    ShipSubstepBatch* b = &ship_world->substeps;
+    if (b->count == 0) return;
+    
+    // Pad to whole lanes with copies of the last ship so every ship goes
+    // through the wide path, as it does on the ECS arrays
+    uint32_t count = b->count;
+    uint32_t padded = (count + SHIP_PHYSICS_LANES - 1) / SHIP_PHYSICS_LANES * SHIP_PHYSICS_LANES;
+    if (padded > MAX_ENTITIES) padded = MAX_ENTITIES;
+    for (uint32_t j = count; j < padded; j++) {
+        b->throttle[j] = b->throttle[count - 1];
+        b->target_throttle[j] = b->target_throttle[count - 1];
+        b->rudder[j] = b->rudder[count - 1];
+        b->target_rudder[j] = b->target_rudder[count - 1];
+        b->max_speed[j] = b->max_speed[count - 1];
+        b->acceleration[j] = b->acceleration[count - 1];
+        b->turn_rate[j] = b->turn_rate[count - 1];
+        b->throttle_response[j] = b->throttle_response[count - 1];
+        b->steering_response[j] = b->steering_response[count - 1];
+        b->coast_friction[j] = b->coast_friction[count - 1];
+        b->drift_factor[j] = b->drift_factor[count - 1];
+        b->reverse_speed_mult[j] = b->reverse_speed_mult[count - 1];
+        b->reverse_accel_mult[j] = b->reverse_accel_mult[count - 1];
+        b->speed_turn_factor[j] = b->speed_turn_factor[count - 1];
+        b->pos_x[j] = b->pos_x[count - 1];
+        b->pos_y[j] = b->pos_y[count - 1];
+        b->rotation[j] = b->rotation[count - 1];
+        b->speed[j] = b->speed[count - 1];
+        b->angular_vel[j] = b->angular_vel[count - 1];
+        b->vel_x[j] = b->vel_x[count - 1];
+        b->vel_y[j] = b->vel_y[count - 1];
+    }
+    
+    // Same physics then movement order as the per-step pipeline
+    ShipPhysicsColumns columns = substep_columns(b);
+    for (uint32_t step = 0; step < steps; step++) {
+        ship_physics_kernel_wide(&columns, 0, padded, base_dt);
+        for (uint32_t j = 0; j < padded; j++) {
+            b->pos_x[j] += b->vel_x[j] * base_dt;
+            b->pos_y[j] += b->vel_y[j] * base_dt;
+            b->rotation[j] = math_wrap_angle_360(b->rotation[j] + b->angular_vel[j] * base_dt);
+        }
+    }
+    
+    ShipComponents* s = &ship_world->ships;
+    for (uint32_t j = 0; j < count; j++) {
+        Entity e = b->entity[j];
+        s->throttle[e] = b->throttle[j];
+        s->rudder[e] = b->rudder[j];
+        ecs_world->transforms.pos_x[e] = b->pos_x[j];
+        ecs_world->transforms.pos_y[e] = b->pos_y[j];
+        ecs_world->transforms.rotation[e] = b->rotation[j];
+        ecs_world->velocities.speed[e] = b->speed[j];
+        ecs_world->velocities.angular_vel[e] = b->angular_vel[j];
+        ecs_world->velocities.vel_x[e] = b->vel_x[j];
+        ecs_world->velocities.vel_y[e] = b->vel_y[j];
+    }
+    b->count = 0;
+}
@@ -0,0 +1,297 @@
+#include "game_sim.h"
+#include "engine_jobs.h"
+#include "engine_math.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+// Ships this far outside the spawn circle are turned back toward its centre
+#define SIM_HOMEWARD_FACTOR 1.5f
+
+// Spawn points closer than this to land are redrawn, up to this many times
+#define SIM_SPAWN_SHORE_CLEARANCE 60.0f
+#define SIM_SPAWN_MAX_TRIES 32
+
+static inline uint32_t rng_next(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static inline float rng_float(uint32_t* state) {
+    return (float)(rng_next(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+static inline float rng_range(uint32_t* state, float min_val, float max_val) {
+    return min_val + (max_val - min_val) * rng_float(state);
+}
+
+// Copy a config string (getters hand back the default itself when a key is missing)
+static void copy_string(char* dst, const char* src) {
+    if (dst == src) return;
+    strncpy(dst, src, CONFIG_MAX_VALUE_LEN - 1);
+    dst[CONFIG_MAX_VALUE_LEN - 1] = '\0';
+}
+
+// Give a ship a new random order, or send it home if it strayed too far
+static void issue_helm_order(GameSim* sim, Entity ship) {
+    const SimScenario* sc = &sim->scenario;
+    float throttle = rng_range(&sim->rng, sc->throttle_min, sc->throttle_max);
+    float rudder = rng_range(&sim->rng, -sc->rudder_max, sc->rudder_max);
+
+    float x, y;
+    game_ecs_get_ship_position(&sim->game_ecs, ship, &x, &y);
+    float limit = sc->spawn_radius * SIM_HOMEWARD_FACTOR;
+    if (math_distance_sq(x, y, sc->spawn_x, sc->spawn_y) > limit * limit) {
+        // Heading 0 = north, so the bearing of (dx, dy) is atan2(dx, -dy)
+        float bearing = math_rad_to_deg(atan2f(sc->spawn_x - x, y - sc->spawn_y));
+        float heading = game_ecs_get_ship_heading(&sim->game_ecs, ship);
+        float turn = math_angle_diff(heading, bearing);
+        rudder = math_abs(turn) < 10.0f ? 0.0f : math_sign(turn) * math_max(sc->rudder_max, 0.25f);
+    }
+
+    game_ecs_set_throttle(&sim->game_ecs, ship, throttle);
+    game_ecs_set_steering(&sim->game_ecs, ship, rudder);
+}
+
+// =============================================================================
+// Scenario
+// =============================================================================
+
+SimScenario game_sim_default_scenario(void) {
+    SimScenario sc;
+    memset(&sc, 0, sizeof(SimScenario));
+
+    strncpy(sc.name, "Default fleet", CONFIG_MAX_VALUE_LEN - 1);
+    sc.ship_count = SIM_DEFAULT_SHIPS;
+    sc.ticks = SIM_DEFAULT_TICKS;
+    sc.seed = 1;
+    sc.tick_rate = config_get_default_simulation().tick_rate;
+
+    // Centre of the default archipelago
+    sc.spawn_x = 1000.0f;
+    sc.spawn_y = 400.0f;
+    sc.spawn_radius = 2000.0f;
+
+    sc.throttle_min = 0.25f;
+    sc.throttle_max = 1.0f;
+    sc.rudder_max = 0.5f;
+    sc.helm_interval = 20.0f;
+    sc.fog_enabled = true;
+    sc.max_substeps = 1;
+
+    sc.satisfaction = satisfaction_get_default_config();
+    return sc;
+}
+
+bool game_sim_load_scenario(const char* filepath, SimScenario* out_scenario) {
+    if (!out_scenario) return false;
+    *out_scenario = game_sim_default_scenario();
+    if (!filepath) return false;
+
+    ConfigFile config;
+    config_init(&config);
+    if (!config_load(&config, filepath)) {
+        printf("Sim: Failed to load scenario '%s'\n", filepath);
+        return false;
+    }
+
+    SimScenario* sc = out_scenario;
+    copy_string(sc->name, config_get_string(&config, "Scenario", "name", sc->name));
+    copy_string(sc->poi_file, config_get_string(&config, "Scenario", "poi_file", sc->poi_file));
+    copy_string(sc->coast_file, config_get_string(&config, "Scenario", "coast_file", sc->coast_file));
+
+    int ships = config_get_int(&config, "Scenario", "ships", (int)sc->ship_count);
+    sc->ship_count = (uint32_t)math_clamp_int(ships, 1, MAX_ENTITIES - 1);
+    int ticks = config_get_int(&config, "Scenario", "ticks", (int)sc->ticks);
+    sc->ticks = ticks > 0 ? (uint32_t)ticks : 0;
+    sc->seed = (uint32_t)config_get_int(&config, "Scenario", "seed", (int)sc->seed);
+    sc->tick_rate = config_get_simulation(&config).tick_rate;
+
+    sc->spawn_x = config_get_float(&config, "Scenario", "spawn_x", sc->spawn_x);
+    sc->spawn_y = config_get_float(&config, "Scenario", "spawn_y", sc->spawn_y);
+    sc->spawn_radius = math_max(config_get_float(&config, "Scenario", "spawn_radius", sc->spawn_radius), 0.0f);
+
+    sc->throttle_min = math_clamp(config_get_float(&config, "Scenario", "throttle_min", sc->throttle_min), -1.0f, 1.0f);
+    sc->throttle_max = math_clamp(config_get_float(&config, "Scenario", "throttle_max", sc->throttle_max), sc->throttle_min, 1.0f);
+    sc->rudder_max = math_clamp(config_get_float(&config, "Scenario", "rudder_max", sc->rudder_max), 0.0f, 1.0f);
+    sc->helm_interval = math_max(config_get_float(&config, "Scenario", "helm_interval", sc->helm_interval), 0.0f);
+    sc->fog_enabled = config_get_bool(&config, "Scenario", "fog", sc->fog_enabled);
+    int substeps = config_get_int(&config, "Scenario", "max_substeps", (int)sc->max_substeps);
+    sc->max_substeps = (uint32_t)math_clamp_int(substeps, 1, 1024);
+
+    sc->satisfaction = satisfaction_get_config(&config);
+    return true;
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+bool game_sim_init(GameSim* sim, const SimScenario* scenario) {
+    if (!sim) return false;
+    memset(sim, 0, sizeof(GameSim));
+    sim->scenario = scenario ? *scenario : game_sim_default_scenario();
+    if (sim->scenario.tick_rate <= 0) sim->scenario.tick_rate = config_get_default_simulation().tick_rate;
+    const SimScenario* sc = &sim->scenario;
+
+    game_ecs_init(&sim->game_ecs, &sim->ecs_world);
+    game_ecs_load_pois(&sim->game_ecs, sc->poi_file[0] ? sc->poi_file : NULL);
+    game_ecs_load_coastline(&sim->game_ecs, sc->coast_file[0] ? sc->coast_file : NULL);
+    tour_ecs_set_config(&sim->game_ecs.tour_world, &sc->satisfaction);
+    fog_set_enabled(&sim->game_ecs.fog, sc->fog_enabled);
+
+    sim->dt = 1.0f / (float)sc->tick_rate;
+    sim->helm_ticks = (uint32_t)(sc->helm_interval / sim->dt + 0.5f);
+    sim->rng = sc->seed ? sc->seed : 1;
+
+    // Spawn uniformly over the water in the circle with random headings; the
+    // first ship is the player's, the rest are ferries
+    uint32_t count = sc->ship_count < MAX_ENTITIES - 1 ? sc->ship_count : MAX_ENTITIES - 1;
+    for (uint32_t i = 0; i < count; i++) {
+        float x, y;
+        uint32_t tries = 0;
+        do {
+            float r = sc->spawn_radius * sqrtf(rng_float(&sim->rng));
+            float a = rng_float(&sim->rng) * 2.0f * PI;
+            x = sc->spawn_x + r * cosf(a);
+            y = sc->spawn_y + r * sinf(a);
+        } while (coastline_circle_touches_land(&sim->game_ecs.coast, x, y, SIM_SPAWN_SHORE_CLEARANCE) &&
+                 ++tries < SIM_SPAWN_MAX_TRIES);
+        float heading = rng_float(&sim->rng) * 360.0f;
+
+        Entity ship = i == 0
+            ? game_create_player_ship(&sim->game_ecs, x, y, heading)
+            : game_create_ai_ship(&sim->game_ecs, x, y, heading, 0);
+        if (ship == INVALID_ENTITY) break;
+
+        sim->ships[sim->ship_count++] = ship;
+        issue_helm_order(sim, ship);
+    }
+    ecs_store_previous_transforms(&sim->ecs_world);
+
+    sim->initialized = true;
+    printf("Sim: Scenario '%s' with %u ships at %d Hz\n", sc->name, sim->ship_count, sc->tick_rate);
+    return sim->ship_count == count;
+}
+
+void game_sim_shutdown(GameSim* sim) {
+    if (!sim || !sim->initialized) return;
+
+    game_ecs_shutdown(&sim->game_ecs);
+    sim->initialized = false;
+}
+
+// =============================================================================
+// Stepping
+// =============================================================================
+
+// Advance steps ticks in one update
+static void step_span(GameSim* sim, uint32_t steps) {
+    // Orders are staggered so a fraction of the fleet turns each tick; an
+    // order falling anywhere in the span is given at its start
+    if (sim->helm_ticks > 0) {
+        for (uint32_t i = 0; i < sim->ship_count; i++) {
+            uint64_t offset = (uint64_t)i * sim->helm_ticks / sim->ship_count;
+            uint64_t phase = (sim->tick + offset + 1) % sim->helm_ticks;
+            if (phase == 0 || sim->helm_ticks - phase < steps) {
+                issue_helm_order(sim, sim->ships[i]);
+            }
+        }
+    }
+
+    ecs_store_previous_transforms(&sim->ecs_world);
+    game_ecs_update_adaptive(&sim->game_ecs, sim->dt, steps);
+    sim->tick += steps;
+}
+
+static uint32_t update_steps(const GameSim* sim) {
+    return game_ecs_adaptive_steps(&sim->game_ecs, sim->dt, sim->scenario.max_substeps);
+}
+
+uint32_t game_sim_step(GameSim* sim) {
+    if (!sim || !sim->initialized) return 0;
+
+    uint32_t steps = update_steps(sim);
+    step_span(sim, steps);
+    return steps;
+}
+
+SimStats game_sim_run(GameSim* sim, uint32_t ticks) {
+    SimStats stats;
+    memset(&stats, 0, sizeof(SimStats));
+    if (!sim || !sim->initialized) return stats;
+
+    double start = jobs_time_seconds();
+    double worst = 0.0;
+    uint32_t done = 0;
+    while (done < ticks) {
+        uint32_t steps = update_steps(sim);
+        if (steps > ticks - done) steps = ticks - done;
+
+        double tick_start = jobs_time_seconds();
+        step_span(sim, steps);
+        stats.groundings += sim->game_ecs.coast.grounded_count;
+        double tick_time = jobs_time_seconds() - tick_start;
+        if (tick_time > worst) worst = tick_time;
+
+        done += steps;
+        stats.updates++;
+    }
+    double wall = jobs_time_seconds() - start;
+
+    stats.ticks = ticks;
+    stats.sim_seconds = (double)ticks / (double)sim->scenario.tick_rate;
+    stats.wall_seconds = wall;
+    stats.worst_tick_ms = worst * 1000.0;
+    if (wall > 0.0) {
+        stats.ticks_per_second = (double)ticks / wall;
+        stats.ship_ticks_per_second = stats.ticks_per_second * sim->ship_count;
+        stats.realtime_factor = stats.sim_seconds / wall;
+    }
+
+    // Fleet tour summary
+    const TourEcsWorld* tours = game_ecs_get_tour_world_const(&sim->game_ecs);
+    stats.ship_count = sim->ship_count;
+    stats.poi_count = poi_ecs_get_count(game_ecs_get_poi_world_const(&sim->game_ecs));
+    stats.min_satisfaction = sim->ship_count > 0 ? 100 : 0;
+    int64_t score_total = 0;
+    for (uint32_t i = 0; i < sim->ship_count; i++) {
+        Entity ship = sim->ships[i];
+        int score = tour_ecs_get_score(tours, ship);
+        score_total += score;
+        if (score < stats.min_satisfaction) stats.min_satisfaction = score;
+        if (score > stats.max_satisfaction) stats.max_satisfaction = score;
+        stats.poi_visits += tours->tours.visited_count[ship];
+    }
+    if (sim->ship_count > 0) {
+        stats.mean_satisfaction = (float)score_total / (float)sim->ship_count;
+    }
+    stats.world_hash = game_ecs_hash(&sim->game_ecs);
+    return stats;
+}
+
+void game_sim_print_stats(const GameSim* sim, const SimStats* stats) {
+    if (!sim || !stats) return;
+
+    printf("Sim: %llu ticks in %llu updates (%.1f s simulated) in %.3f s\n",
+           (unsigned long long)stats->ticks, (unsigned long long)stats->updates,
+           stats->sim_seconds, stats->wall_seconds);
+    printf("Sim:   %.0f ticks/s, %.0f ship-ticks/s, %.0fx real time, worst update %.3f ms\n",
+           stats->ticks_per_second, stats->ship_ticks_per_second,
+           stats->realtime_factor, stats->worst_tick_ms);
+    printf("Sim:   %u ships, %u POIs, %llu POI visits, satisfaction %.1f (min %d, max %d)\n",
+           stats->ship_count, stats->poi_count, (unsigned long long)stats->poi_visits,
+           stats->mean_satisfaction, stats->min_satisfaction, stats->max_satisfaction);
+    printf("Sim:   %llu groundings on %u islands\n",
+           (unsigned long long)stats->groundings, sim->game_ecs.coast.island_count);
+    printf("Sim:   world hash %016llx after tick %llu\n",
+           (unsigned long long)stats->world_hash, (unsigned long long)sim->tick);
+}
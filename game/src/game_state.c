@@ -24,7 +24,14 @@ bool game_state_init(GameState* state, const ConfigFile* config) {
     game_ecs_init(&state->game_ecs, &state->ecs_world);
     state->use_ecs = true;  // Default to ECS mode
     
+    // Audio and UI follow POI arrivals through their own event readers
+    poi_ecs_events_reader_init(&state->game_ecs.poi_world, &state->poi_audio_events);
+    poi_ecs_events_reader_init(&state->game_ecs.poi_world, &state->poi_ui_events);
+    state->poi_banner_index = -1;
+    
     // Create player ship entity in ECS
+    state->spawn_x = center_x;
+    state->spawn_y = center_y;
     state->player_entity = game_create_player_ship(&state->game_ecs, center_x, center_y, 0.0f);
     if (state->player_entity == INVALID_ENTITY) {
         fprintf(stderr, "Failed to create player ship entity!\n");
@@ -33,6 +40,7 @@ bool game_state_init(GameState* state, const ConfigFile* config) {
     
     // Initialize legacy ship (for compatibility/fallback)
     ship_physics_init(&state->player_ship, center_x, center_y, 0.0f);
+    game_state_snap_interpolation(state);
     
     // Initialize telegraph
     ship_telegraph_init(&state->telegraph);
@@ -93,8 +101,17 @@ bool game_state_init(GameState* state, const ConfigFile* config) {
         printf("Warning: Using default POIs\n");
     }
     
-    // Start a demo tour for satisfaction tracking
-    satisfaction_tour_start(&state->game_ecs.tour);
+    // Load islands (open water without them)
+    game_ecs_load_coastline(&state->game_ecs, NULL);
+    
+    // Satisfaction tuning from [Satisfaction]; the player's tour started with the ship
+    SatisfactionConfig satisfaction_config = satisfaction_get_config(config);
+    tour_ecs_set_config(&state->game_ecs.tour_world, &satisfaction_config);
+    
+    // Route suggestions search on every core
+    jobs_init(&state->jobs, 0);
+    state->game_ecs.jobs = &state->jobs;
+    route_planner_init(&state->route_planner, &state->jobs, &satisfaction_config);
     printf("Demo tour started - visit POIs to earn satisfaction!\n");
     
     state->initialized = true;
@@ -107,6 +124,14 @@ bool game_state_init(GameState* state, const ConfigFile* config) {
 void game_state_shutdown(GameState* state) {
     if (!state || !state->initialized) return;
     
+    if (state->record_path) {
+        input_log_save(&state->input_log, state->record_path);
+        state->record_path = NULL;
+    }
+    input_log_free(&state->input_log);
+    
+    route_planner_shutdown(&state->route_planner);
+    jobs_shutdown(&state->jobs);
     game_ecs_shutdown(&state->game_ecs);
     audio_shutdown(&state->audio);
     
@@ -117,11 +142,9 @@ void game_state_shutdown(GameState* state) {
 void game_state_reset(GameState* state) {
     if (!state) return;
     
-    // Get current window dimensions
-    int window_width = engine_get_window_width();
-    int window_height = engine_get_window_height();
-    float center_x = window_width / 2.0f;
-    float center_y = window_height / 2.0f;
+    // Back to where the ship started (the window centre at init)
+    float center_x = state->spawn_x;
+    float center_y = state->spawn_y;
     
     // Reset ECS ship
     if (state->player_entity != INVALID_ENTITY) {
@@ -140,6 +163,7 @@ void game_state_reset(GameState* state) {
     
     // Reset legacy ship
     ship_physics_init(&state->player_ship, center_x, center_y, 0.0f);
+    game_state_snap_interpolation(state);
     
     // Reset telegraph
     ship_telegraph_init(&state->telegraph);
@@ -147,6 +171,9 @@ void game_state_reset(GameState* state) {
     // Reset camera
     camera_set_position(&state->camera, center_x, center_y);
     
+    // Back to real time
+    game_state_set_time_warp(state, 0);
+    
     printf("Game state reset\n");
 }
 
@@ -167,6 +194,103 @@ void game_state_toggle_ecs(GameState* state) {
         // Copy ECS state to legacy
         game_ecs_to_ship_state(&state->game_ecs, state->player_entity, &state->player_ship);
     }
+    game_state_snap_interpolation(state);
     
     printf("ECS mode: %s\n", state->use_ecs ? "ON" : "OFF");
 }
+
+void game_state_snap_interpolation(GameState* state) {
+    if (!state) return;
+    
+    ecs_store_previous_transforms(&state->ecs_world);
+    state->previous_ship = state->player_ship;
+    state->render_ship = state->player_ship;
+}
+
+// =============================================================================
+// Recording and Replay
+// =============================================================================
+
+void game_state_start_recording(GameState* state, const char* filepath, uint32_t tick_rate) {
+    if (!state || !filepath) return;
+    
+    input_log_free(&state->input_log);
+    input_log_init(&state->input_log, tick_rate, state->spawn_x, state->spawn_y,
+                   INPUT_LOG_DEFAULT_HASH_INTERVAL);
+    state->record_path = filepath;
+    printf("Input Record: Recording to %s\n", filepath);
+}
+
+bool game_state_start_replay(GameState* state, const char* filepath) {
+    if (!state || !filepath) return false;
+    if (!input_log_load(&state->input_log, filepath)) return false;
+    
+    // Start where the recording did, whatever the window size is now
+    state->spawn_x = state->input_log.header.spawn_x;
+    state->spawn_y = state->input_log.header.spawn_y;
+    game_state_reset(state);
+    
+    state->record_path = NULL;
+    input_replay_start(&state->replay, &state->input_log);
+    return true;
+}
+
+uint64_t game_state_hash(const GameState* state) {
+    if (!state) return GAME_HASH_SEED;
+    
+    uint64_t hash = game_ecs_hash(&state->game_ecs);
+    
+    // The legacy ship (only moved in legacy mode) and the telegraph are
+    // simulated outside the ECS
+    const ShipState* ship = &state->player_ship;
+    float floats[10] = {
+        ship->pos_x, ship->pos_y, ship->heading, ship->velocity_x, ship->velocity_y,
+        ship->speed, ship->angular_velocity, ship->throttle, ship->rudder,
+        state->telegraph.order_time,
+    };
+    uint32_t flags[3] = { (uint32_t)state->telegraph.current_order, state->use_ecs ? 1u : 0u,
+                          state->time_warp };
+    hash = game_hash_words(hash, floats, 10);
+    return game_hash_words(hash, flags, 3);
+}
+
+// =============================================================================
+// Time Warp
+// =============================================================================
+
+static const float TIME_WARP_SCALES[TIME_WARP_LEVEL_COUNT] = {
+    1.0f, 2.0f, 5.0f, 10.0f, 50.0f, 100.0f, 500.0f, 1000.0f
+};
+
+float game_time_warp_scale(uint8_t level) {
+    if (level >= TIME_WARP_LEVEL_COUNT) level = TIME_WARP_LEVEL_COUNT - 1;
+    return TIME_WARP_SCALES[level];
+}
+
+void game_state_set_time_warp(GameState* state, uint8_t level) {
+    if (!state) return;
+    if (level >= TIME_WARP_LEVEL_COUNT) level = TIME_WARP_LEVEL_COUNT - 1;
+    bool changed = level != state->time_warp;
+    state->time_warp = level;
+    
+    float scale = game_time_warp_scale(level);
+    engine_set_time_scale(scale);
+    if (scale > 1.0f) {
+        // Simulate for most of each frame and draw at a steady, lower rate
+        engine_set_fixed_step_budget(TIME_WARP_STEP_BUDGET);
+        engine_set_target_fps(TIME_WARP_RENDER_FPS);
+    } else {
+        engine_set_fixed_step_budget(0.0);
+        engine_reset_target_fps();
+    }
+    if (changed) printf("Time warp: %.0fx\n", scale);
+}
+
+uint32_t game_state_steps_per_tick(const GameState* state, float fixed_dt) {
+    if (!state || game_time_warp_scale(state->time_warp) < TIME_WARP_ADAPTIVE_MIN) return 1;
+    
+    // The legacy path steps one ship; it just repeats the base step
+    uint32_t max_steps = TIME_WARP_MAX_SUBSTEPS;
+    if (!state->use_ecs) return max_steps;
+    return game_ecs_adaptive_steps(&state->game_ecs, fixed_dt, max_steps);
+}
@@ -1,11 +1,11 @@
 #include "game_update.h"
 #include "game_ecs.h"
 #include "input_actions.h"
+#include "game_constants.h"
 #include "config.h"
 #include "engine_math.h"
 #include "engine_ecs.h"
 #include "engine_core.h"
-#include "engine_ui.h"
 #include <raylib.h>
 #include <stdio.h>
 
@@ -14,30 +14,65 @@ void game_update_input(GameState* state) {
     
     input_actions_update();
     
-    // Telegraph controls (key presses, not holds)
+    // A replay supplies the ship's input
+    if (state->replay.active) return;
+    
+    // Telegraph controls (key presses, not holds), applied on the next step
     if (input_action_pressed(SHIP_ACTION_THROTTLE_UP)) {
-        ship_telegraph_ring_up(&state->telegraph);
-        if (state->sounds.telegraph_bell != INVALID_SOUND_HANDLE) {
-            audio_play(&state->audio, state->sounds.telegraph_bell);
-        }
+        state->pending_actions |= TICK_ACTION_RING_UP;
     }
     if (input_action_pressed(SHIP_ACTION_THROTTLE_DOWN)) {
-        ship_telegraph_ring_down(&state->telegraph);
+        state->pending_actions |= TICK_ACTION_RING_DOWN;
+    }
+    
+    // Time warp
+    if (IsKeyPressed(KEY_RIGHT_BRACKET)) state->pending_actions |= TICK_ACTION_WARP_UP;
+    if (IsKeyPressed(KEY_LEFT_BRACKET)) state->pending_actions |= TICK_ACTION_WARP_DOWN;
+}
+
+void game_update_apply_actions(GameState* state, uint8_t actions) {
+    if (!state) return;
+    
+    if (actions & (TICK_ACTION_RING_UP | TICK_ACTION_RING_DOWN)) {
+        if (actions & TICK_ACTION_RING_UP) ship_telegraph_ring_up(&state->telegraph);
+        if (actions & TICK_ACTION_RING_DOWN) ship_telegraph_ring_down(&state->telegraph);
         if (state->sounds.telegraph_bell != INVALID_SOUND_HANDLE) {
             audio_play(&state->audio, state->sounds.telegraph_bell);
         }
     }
+    if (actions & TICK_ACTION_TELEPORT) {
+        // Teleport ship to where it started
+        if (state->use_ecs) {
+            ecs_set_position(&state->ecs_world, state->player_entity, state->spawn_x, state->spawn_y);
+        } else {
+            debug_tools_teleport_ship(&state->player_ship, state->spawn_x, state->spawn_y);
+        }
+        game_state_snap_interpolation(state);
+        printf("Debug: Teleported ship to (%.1f, %.1f)\n", state->spawn_x, state->spawn_y);
+    }
+    if (actions & TICK_ACTION_RESET) {
+        game_state_reset(state);
+    }
+    if (actions & TICK_ACTION_TOGGLE_ECS) {
+        game_state_toggle_ecs(state);
+    }
+    if ((actions & TICK_ACTION_WARP_UP) && state->time_warp + 1 < TIME_WARP_LEVEL_COUNT) {
+        game_state_set_time_warp(state, state->time_warp + 1);
+    }
+    if ((actions & TICK_ACTION_WARP_DOWN) && state->time_warp > 0) {
+        game_state_set_time_warp(state, state->time_warp - 1);
+    }
 }
 
-void game_update_ship(GameState* state, float delta_time) {
+void game_update_ship(GameState* state, float delta_time, uint32_t steps, float steering_input) {
     if (!state) return;
+    if (steps == 0) steps = 1;
     
     // Update telegraph timer
-    ship_telegraph_update(&state->telegraph, delta_time);
+    ship_telegraph_update(&state->telegraph, delta_time * (float)steps);
     
-    // Get throttle from telegraph and steering from input
+    // Get throttle from telegraph
     float throttle_input = ship_telegraph_get_throttle(&state->telegraph);
-    float steering_input = input_action_get_steering_axis();
     
     if (state->use_ecs) {
         // ECS physics update
@@ -45,14 +80,13 @@ void game_update_ship(GameState* state, float delta_time) {
         game_ecs_set_steering(&state->game_ecs, state->player_entity, steering_input);
         
         // Run all game ECS systems (ship physics, AI, movement)
-        game_ecs_update(&state->game_ecs, delta_time);
-        
-        // Sync ECS state to legacy struct (for rendering/UI compatibility)
-        game_ecs_to_ship_state(&state->game_ecs, state->player_entity, &state->player_ship);
+        game_ecs_update_adaptive(&state->game_ecs, delta_time, steps);
     } else {
         // Legacy physics update
         ship_physics_process_actions(&state->player_ship, throttle_input, steering_input);
-        ship_physics_update(&state->player_ship, &state->physics_config, delta_time);
+        for (uint32_t i = 0; i < steps; i++) {
+            ship_physics_update(&state->player_ship, &state->physics_config, delta_time);
+        }
     }
 }
 
@@ -62,6 +96,16 @@ void game_update_audio(GameState* state) {
     // Update looping sounds
     audio_update(&state->audio);
     
+    // Ring the bell when the player arrives at a POI
+    const POIEcsWorld* poi_world = game_ecs_get_poi_world_const(&state->game_ecs);
+    const POIEvent* event;
+    while ((event = poi_ecs_events_next(poi_world, &state->poi_audio_events)) != NULL) {
+        if (event->type != POI_EVENT_ENTER || event->ship != state->player_entity) continue;
+        if (state->sounds.telegraph_bell != INVALID_SOUND_HANDLE) {
+            audio_play(&state->audio, state->sounds.telegraph_bell);
+        }
+    }
+    
     // Update engine sound pitch based on speed
     if (state->sounds.engine_loop != INVALID_SOUND_HANDLE) {
         float speed = state->use_ecs 
@@ -73,10 +117,26 @@ void game_update_audio(GameState* state) {
     }
 }
 
-void game_update_camera(GameState* state, float delta_time) {
+void game_update_ui(GameState* state, float delta_time) {
+    if (!state) return;
+    
+    if (state->poi_banner_timer > 0.0f) {
+        state->poi_banner_timer -= delta_time;
+    }
+    
+    // Show the latest POI the player entered
+    const POIEcsWorld* poi_world = game_ecs_get_poi_world_const(&state->game_ecs);
+    const POIEvent* event;
+    while ((event = poi_ecs_events_next(poi_world, &state->poi_ui_events)) != NULL) {
+        if (event->type != POI_EVENT_ENTER || event->ship != state->player_entity) continue;
+        state->poi_banner_index = (int)event->poi_index;
+        state->poi_banner_timer = POI_BANNER_DURATION;
+    }
+}
+
+void game_update_route_suggestion(GameState* state) {
     if (!state) return;
     
-    // Get ship position (from ECS or legacy)
     float ship_x, ship_y;
     if (state->use_ecs) {
         game_ecs_get_ship_position(&state->game_ecs, state->player_entity, &ship_x, &ship_y);
@@ -85,8 +145,33 @@ void game_update_camera(GameState* state, float delta_time) {
         ship_y = state->player_ship.pos_y;
     }
     
-    // Set camera target to follow ship
-    camera_set_target(&state->camera, ship_x, ship_y);
+    RoutePlanRequest request = route_plan_request_default(ship_x, ship_y);
+    request.time_budget = ROUTE_SUGGEST_TIME_BUDGET;
+    request.cruise_speed = state->physics_config.max_speed;
+    
+    double start = jobs_time_seconds();
+    const POIEcsWorld* poi_world = game_ecs_get_poi_world_const(&state->game_ecs);
+    if (!route_planner_plan(&state->route_planner, poi_world, &request, &state->suggested_route)) {
+        printf("Route: No POIs within %.0fs of the ship\n", ROUTE_SUGGEST_TIME_BUDGET);
+        return;
+    }
+    printf("Route: %u stops, %.0f units, satisfaction %d (%u candidates, %.1f ms, %u threads)\n",
+           state->suggested_route.stop_count, state->suggested_route.length,
+           state->suggested_route.satisfaction, state->suggested_route.candidate_count,
+           (jobs_time_seconds() - start) * 1000.0, jobs_thread_count(&state->jobs));
+}
+
+void game_update_camera(GameState* state, float delta_time) {
+    if (!state) return;
+    
+    // Follow the ship where it is drawn, not where the last step left it
+    camera_set_target(&state->camera, state->render_ship.pos_x, state->render_ship.pos_y);
+    
+    // A replay sets the zoom each step
+    if (state->replay.active) {
+        camera_update(&state->camera, &state->camera_config, delta_time);
+        return;
+    }
     
     // Handle zoom input
     float scroll = GetMouseWheelMove();
@@ -116,43 +201,134 @@ void game_update_debug(GameState* state) {
     // Update debug tools (handle F1-F3 keys)
     debug_tools_update(&state->debug);
     
-    // Debug commands
-    if (IsKeyPressed(KEY_F4)) {
-        // Teleport ship to center
-        float center_x = ui_center_x();
-        float center_y = ui_center_y();
-        
-        if (state->use_ecs) {
-            ecs_set_position(&state->ecs_world, state->player_entity, center_x, center_y);
-            game_ecs_to_ship_state(&state->game_ecs, state->player_entity, &state->player_ship);
+    // Debug commands that change the simulation run on the next step
+    if (!state->replay.active) {
+        if (IsKeyPressed(KEY_F4)) state->pending_actions |= TICK_ACTION_TELEPORT;
+        if (IsKeyPressed(KEY_F5)) state->pending_actions |= TICK_ACTION_RESET;
+        if (IsKeyPressed(KEY_F7)) state->pending_actions |= TICK_ACTION_TOGGLE_ECS;
+    }
+    if (IsKeyPressed(KEY_F6)) {
+        // Hot-reload config; a recording or replay keeps the config it
+        // started with, since the log holds no physics parameters
+        if (state->record_path || state->replay.active) {
+            printf("Config: Hot-reload is off while recording or replaying\n");
         } else {
-            debug_tools_teleport_ship(&state->player_ship, center_x, center_y);
+            config_reload_ship_physics(state->config_path, &state->physics_config);
+            // Apply new config to ECS ship
+            game_ecs_apply_physics_config(&state->game_ecs, state->player_entity, &state->physics_config);
         }
-        printf("Debug: Teleported ship to (%.1f, %.1f)\n", center_x, center_y);
-    }
-    if (IsKeyPressed(KEY_F5)) {
-        // Reset ship state
-        game_state_reset(state);
     }
-    if (IsKeyPressed(KEY_F6)) {
-        // Hot-reload config
-        config_reload_ship_physics(state->config_path, &state->physics_config);
-        // Apply new config to ECS ship
-        game_ecs_apply_physics_config(&state->game_ecs, state->player_entity, &state->physics_config);
+    if (IsKeyPressed(KEY_F8)) {
+        // Suggest a round trip from the ship's position
+        game_update_route_suggestion(state);
     }
-    if (IsKeyPressed(KEY_F7)) {
-        // Toggle ECS mode
-        game_state_toggle_ecs(state);
+}
+
+void game_update_interpolation(GameState* state, float alpha) {
+    if (!state) return;
+    
+    alpha = math_clamp(alpha, 0.0f, 1.0f);
+    
+    if (state->use_ecs) {
+        // Read once per frame from the ECS; the simulation keeps no copy
+        ShipState* ship = &state->render_ship;
+        game_ecs_to_ship_state(&state->game_ecs, state->player_entity, ship);
+        ecs_get_interpolated_transform(&state->ecs_world, state->player_entity, alpha,
+                                       &ship->pos_x, &ship->pos_y, &ship->heading);
+        return;
     }
+    
+    const ShipState* from = &state->previous_ship;
+    const ShipState* to = &state->player_ship;
+    
+    // Gauges show the latest step; only the pose is blended
+    state->render_ship = *to;
+    state->render_ship.pos_x = math_lerp(from->pos_x, to->pos_x, alpha);
+    state->render_ship.pos_y = math_lerp(from->pos_y, to->pos_y, alpha);
+    state->render_ship.heading = math_wrap_angle_360(
+        from->heading + math_angle_diff(from->heading, to->heading) * alpha);
 }
 
-void game_update(GameState* state, float delta_time) {
+void game_update_render_list(GameState* state, float alpha) {
+    if (!state) return;
+    
+    // The world rectangle the camera shows (the render's visibility pass
+    // uses the same one)
+    Rectangle view = camera_get_view_rect(&state->camera, engine_get_window_width(), engine_get_window_height());
+    
+    ecs_build_render_list(&state->ecs_world, alpha, view.x, view.y, view.x + view.width,
+                          view.y + view.height, SHIP_RENDER_REACH, &state->render_list);
+}
+
+void game_update_frame_begin(GameState* state) {
     if (!state || !state->initialized) return;
     if (state->paused) return;
     
     game_update_input(state);
     game_update_debug(state);
-    game_update_ship(state, delta_time);
+}
+
+void game_update_fixed(GameState* state, float fixed_dt) {
+    if (!state || !state->initialized) return;
+    if (state->paused) return;
+    
+    // Steps this tick covers, decided before its input changes the warp
+    // (the engine already took them from its accumulator)
+    uint32_t steps = game_state_steps_per_tick(state, fixed_dt);
+    
+    // This step's input: the next recorded tick, or what the player did
+    TickInput input;
+    if (state->replay.active) {
+        if (!input_replay_next(&state->replay, &input)) {
+            game_update_finish_replay(state);
+            return;
+        }
+        camera_set_zoom(&state->camera, &state->camera_config, tick_input_zoom(&input));
+    } else {
+        input = tick_input_make(state->pending_actions, input_action_get_steering_axis(),
+                                state->camera.zoom);
+        state->pending_actions = 0;
+    }
+    
+    game_update_apply_actions(state, input.actions);
+    ecs_store_previous_transforms(&state->ecs_world);
+    state->previous_ship = state->player_ship;
+    game_update_ship(state, fixed_dt, steps, tick_input_steering(&input));
+    state->tick++;
+    
+    if (state->record_path) {
+        input_log_record(&state->input_log, input, game_state_hash(state));
+    } else if (state->replay.active) {
+        input_replay_check(&state->replay, game_state_hash(state));
+    }
+}
+
+void game_update_finish_replay(GameState* state) {
+    if (!state || !state->replay.active) return;
+    
+    const InputReplay* replay = &state->replay;
+    if (replay->diverged) {
+        printf("Input Record: Replay of %u ticks diverged at tick %u\n", replay->tick, replay->diverged_tick);
+    } else {
+        printf("Input Record: Replay of %u ticks matched (%u hashes checked)\n",
+               replay->tick, replay->hashes_checked);
+    }
+    state->replay.active = false;
+}
+
+void game_update_frame_end(GameState* state, float frame_dt, float alpha) {
+    if (!state || !state->initialized) return;
+    if (state->paused) return;
+    
+    game_update_interpolation(state, alpha);
     game_update_audio(state);
-    game_update_camera(state, delta_time);
+    game_update_ui(state, frame_dt);
+    game_update_camera(state, frame_dt);
+    game_update_render_list(state, alpha);
+}
+
+void game_update(GameState* state, float delta_time) {
+    game_update_frame_begin(state);
+    game_update_fixed(state, delta_time);
+    game_update_frame_end(state, delta_time, 1.0f);
 }
@@ -0,0 +1,140 @@
+#include "game_visibility.h"
+#include "game_constants.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+void game_visibility_init(GameVisibility* vis) {
+    if (!vis) return;
+    memset(vis, 0, sizeof(GameVisibility));
+}
+
+void game_visibility_shutdown(GameVisibility* vis) {
+    if (!vis) return;
+    free(vis->pois);
+    free(vis->islands);
+    free(vis->chunk_x);
+    free(vis->chunk_y);
+    free(vis->chunk_index);
+    memset(vis, 0, sizeof(GameVisibility));
+}
+
+// =============================================================================
+// Gathering
+// =============================================================================
+
+static bool visibility_reserve_pois(GameVisibility* vis, uint32_t count) {
+    if (count <= vis->poi_capacity) return true;
+
+    int* pois = (int*)realloc(vis->pois, count * sizeof(int));
+    if (!pois) {
+        fprintf(stderr, "Visibility: Out of memory for %u POIs\n", count);
+        return false;
+    }
+    vis->pois = pois;
+    vis->poi_capacity = count;
+    return true;
+}
+
+static bool visibility_reserve_islands(GameVisibility* vis, uint32_t count) {
+    if (count <= vis->island_capacity) return true;
+
+    uint32_t* islands = (uint32_t*)realloc(vis->islands, count * sizeof(uint32_t));
+    if (!islands) {
+        fprintf(stderr, "Visibility: Out of memory for %u islands\n", count);
+        return false;
+    }
+    vis->islands = islands;
+    vis->island_capacity = count;
+    return true;
+}
+
+static bool visibility_reserve_chunks(GameVisibility* vis, uint32_t count) {
+    if (count <= vis->chunk_capacity) return true;
+
+    int32_t* xs = (int32_t*)realloc(vis->chunk_x, count * sizeof(int32_t));
+    if (xs) vis->chunk_x = xs;
+    int32_t* ys = (int32_t*)realloc(vis->chunk_y, count * sizeof(int32_t));
+    if (ys) vis->chunk_y = ys;
+    uint16_t* indices = (uint16_t*)realloc(vis->chunk_index, count * sizeof(uint16_t));
+    if (indices) vis->chunk_index = indices;
+    if (!xs || !ys || !indices) {
+        fprintf(stderr, "Visibility: Out of memory for %u fog chunks\n", count);
+        return false;
+    }
+    vis->chunk_capacity = count;
+    return true;
+}
+
+static void visibility_gather_pois(GameVisibility* vis, const POIEcsWorld* poi_world) {
+    if (!poi_world || !poi_world->initialized || poi_world->poi_count == 0) return;
+    if (!visibility_reserve_pois(vis, poi_world->poi_count)) return;
+
+    // The visit radius circle can reach further than the icon and label
+    float margin = fmaxf(VISIBILITY_POI_MARGIN, poi_world->max_radius);
+    Rectangle v = vis->view;
+    int found = poi_ecs_find_in_rect(poi_world, v.x - margin, v.y - margin, v.x + v.width + margin,
+                                     v.y + v.height + margin, vis->pois, (int)poi_world->poi_count);
+    vis->poi_count = (uint32_t)found;
+}
+
+static void visibility_gather_islands(GameVisibility* vis, const CoastlineState* coast) {
+    if (!coast || coast->island_count == 0) return;
+    if (!visibility_reserve_islands(vis, coast->island_count)) return;
+
+    float min_x = vis->view.x - SHORE_LINE_WIDTH;
+    float min_y = vis->view.y - SHORE_LINE_WIDTH;
+    float max_x = vis->view.x + vis->view.width + SHORE_LINE_WIDTH;
+    float max_y = vis->view.y + vis->view.height + SHORE_LINE_WIDTH;
+
+    for (uint32_t island = 0; island < coast->island_count; island++) {
+        const float* bounds = &coast->island_bounds[island * 4];
+        if (bounds[2] < min_x || bounds[0] > max_x || bounds[3] < min_y || bounds[1] > max_y) continue;
+        vis->islands[vis->island_count++] = island;
+    }
+}
+
+static void visibility_gather_fog(GameVisibility* vis, const FogOfWarState* fog) {
+    vis->fog_min_x = vis->view.x - FOG_CELL_SIZE;
+    vis->fog_min_y = vis->view.y - FOG_CELL_SIZE;
+    vis->fog_max_x = vis->view.x + vis->view.width + FOG_CELL_SIZE;
+    vis->fog_max_y = vis->view.y + vis->view.height + FOG_CELL_SIZE;
+    if (!fog || !fog->enabled) return;
+
+    int min_cx = (int)floorf(vis->fog_min_x / FOG_CHUNK_WORLD_SIZE);
+    int max_cx = (int)floorf(vis->fog_max_x / FOG_CHUNK_WORLD_SIZE);
+    int min_cy = (int)floorf(vis->fog_min_y / FOG_CHUNK_WORLD_SIZE);
+    int max_cy = (int)floorf(vis->fog_max_y / FOG_CHUNK_WORLD_SIZE);
+    if (!visibility_reserve_chunks(vis, (uint32_t)((max_cx - min_cx + 1) * (max_cy - min_cy + 1)))) return;
+
+    // Row by row, so the overlay draws top to bottom as before
+    for (int cy = min_cy; cy <= max_cy; cy++) {
+        for (int cx = min_cx; cx <= max_cx; cx++) {
+            uint32_t i = vis->chunk_count++;
+            vis->chunk_x[i] = cx;
+            vis->chunk_y[i] = cy;
+            vis->chunk_index[i] = spatial_hash_find(&fog->chunk_map, cx, cy);
+        }
+    }
+}
+
+void game_visibility_build(GameVisibility* vis, Rectangle view, const POIEcsWorld* poi_world,
+                           const CoastlineState* coast, const FogOfWarState* fog,
+                           const EcsRenderList* entities) {
+    if (!vis) return;
+
+    vis->view = view;
+    vis->poi_count = 0;
+    vis->island_count = 0;
+    vis->chunk_count = 0;
+    vis->entities = entities;
+
+    visibility_gather_pois(vis, poi_world);
+    visibility_gather_islands(vis, coast);
+    visibility_gather_fog(vis, fog);
+}
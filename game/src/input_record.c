@@ -0,0 +1,228 @@
+#include "input_record.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// Tick Input
+// =============================================================================
+
+TickInput tick_input_make(uint8_t actions, float steering, float zoom) {
+    TickInput input;
+    if (steering > 1.0f) steering = 1.0f;
+    if (steering < -1.0f) steering = -1.0f;
+    float zoom_milli = zoom * 1000.0f + 0.5f;
+    if (zoom_milli < 0.0f) zoom_milli = 0.0f;
+    if (zoom_milli > 65535.0f) zoom_milli = 65535.0f;
+
+    input.actions = actions;
+    input.steering = (int8_t)lrintf(steering * 127.0f);
+    input.zoom = (uint16_t)zoom_milli;
+    return input;
+}
+
+float tick_input_steering(const TickInput* input) {
+    if (!input) return 0.0f;
+    return (float)input->steering / 127.0f;
+}
+
+float tick_input_zoom(const TickInput* input) {
+    if (!input) return 1.0f;
+    return (float)input->zoom / 1000.0f;
+}
+
+static inline bool tick_input_equal(TickInput a, TickInput b) {
+    return a.actions == b.actions && a.steering == b.steering && a.zoom == b.zoom;
+}
+
+// =============================================================================
+// Recording
+// =============================================================================
+
+void input_log_init(InputLog* log, uint32_t tick_rate, float spawn_x, float spawn_y,
+                    uint32_t hash_interval) {
+    if (!log) return;
+    memset(log, 0, sizeof(InputLog));
+    log->header.magic = INPUT_LOG_MAGIC;
+    log->header.version = INPUT_LOG_VERSION;
+    log->header.header_size = sizeof(InputLogHeader);
+    log->header.tick_rate = tick_rate;
+    log->header.hash_interval = hash_interval;
+    log->header.spawn_x = spawn_x;
+    log->header.spawn_y = spawn_y;
+}
+
+void input_log_free(InputLog* log) {
+    if (!log) return;
+    free(log->runs);
+    free(log->hashes);
+    memset(log, 0, sizeof(InputLog));
+}
+
+static bool grow(void** data, uint32_t* capacity, uint32_t needed, size_t element_size) {
+    if (needed <= *capacity) return true;
+    uint32_t new_capacity = *capacity ? *capacity * 2 : 256;
+    while (new_capacity < needed) new_capacity *= 2;
+    void* grown = realloc(*data, (size_t)new_capacity * element_size);
+    if (!grown) return false;
+    *data = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+bool input_log_record(InputLog* log, TickInput input, uint64_t world_hash) {
+    if (!log) return false;
+    InputLogHeader* h = &log->header;
+
+    // Same input as the last tick extends its run
+    if (h->run_count > 0 && tick_input_equal(log->runs[h->run_count - 1].input, input)) {
+        log->runs[h->run_count - 1].ticks++;
+    } else {
+        if (!grow((void**)&log->runs, &log->run_capacity, h->run_count + 1, sizeof(InputRun))) {
+            return false;
+        }
+        log->runs[h->run_count].input = input;
+        log->runs[h->run_count].ticks = 1;
+        h->run_count++;
+    }
+    h->tick_count++;
+
+    if (h->hash_interval > 0 && h->tick_count % h->hash_interval == 0) {
+        if (!grow((void**)&log->hashes, &log->hash_capacity, h->hash_count + 1, sizeof(uint64_t))) {
+            return false;
+        }
+        log->hashes[h->hash_count++] = world_hash;
+    }
+    return true;
+}
+
+// =============================================================================
+// File I/O
+// =============================================================================
+
+bool input_log_save(const InputLog* log, const char* filepath) {
+    if (!log || !filepath) return false;
+    const InputLogHeader* h = &log->header;
+
+    FILE* file = fopen(filepath, "wb");
+    if (!file) {
+        printf("Input Record: Failed to open %s for writing\n", filepath);
+        return false;
+    }
+
+    bool ok = fwrite(h, sizeof(InputLogHeader), 1, file) == 1 &&
+              (h->run_count == 0 || fwrite(log->runs, sizeof(InputRun), h->run_count, file) == h->run_count) &&
+              (h->hash_count == 0 || fwrite(log->hashes, sizeof(uint64_t), h->hash_count, file) == h->hash_count);
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok) {
+        printf("Input Record: Failed to write %s\n", filepath);
+        remove(filepath);
+        return false;
+    }
+    printf("Input Record: Saved %u ticks (%u runs, %u hashes) to %s\n",
+           h->tick_count, h->run_count, h->hash_count, filepath);
+    return true;
+}
+
+bool input_log_load(InputLog* log, const char* filepath) {
+    if (!log || !filepath) return false;
+
+    FILE* file = fopen(filepath, "rb");
+    if (!file) {
+        printf("Input Record: Failed to open %s\n", filepath);
+        return false;
+    }
+
+    InputLogHeader header;
+    if (fread(&header, sizeof(InputLogHeader), 1, file) != 1 ||
+        header.magic != INPUT_LOG_MAGIC ||
+        header.version != INPUT_LOG_VERSION ||
+        header.header_size != sizeof(InputLogHeader) ||
+        header.tick_rate == 0) {
+        printf("Input Record: %s is not a version %u input log\n", filepath, INPUT_LOG_VERSION);
+        fclose(file);
+        return false;
+    }
+
+    InputRun* runs = (InputRun*)malloc((size_t)(header.run_count ? header.run_count : 1) * sizeof(InputRun));
+    uint64_t* hashes = (uint64_t*)malloc((size_t)(header.hash_count ? header.hash_count : 1) * sizeof(uint64_t));
+    bool ok = runs && hashes &&
+              fread(runs, sizeof(InputRun), header.run_count, file) == header.run_count &&
+              fread(hashes, sizeof(uint64_t), header.hash_count, file) == header.hash_count;
+    fclose(file);
+
+    // Runs must add up to the tick count
+    uint64_t ticks = 0;
+    for (uint32_t i = 0; ok && i < header.run_count; i++) ticks += runs[i].ticks;
+    if (!ok || ticks != header.tick_count) {
+        printf("Input Record: %s is truncated or corrupt\n", filepath);
+        free(runs);
+        free(hashes);
+        return false;
+    }
+
+    input_log_free(log);
+    log->header = header;
+    log->runs = runs;
+    log->run_capacity = header.run_count;
+    log->hashes = hashes;
+    log->hash_capacity = header.hash_count;
+    printf("Input Record: Loaded %u ticks at %u Hz from %s\n", header.tick_count, header.tick_rate, filepath);
+    return true;
+}
+
+// =============================================================================
+// Replay
+// =============================================================================
+
+void input_replay_start(InputReplay* replay, const InputLog* log) {
+    if (!replay) return;
+    memset(replay, 0, sizeof(InputReplay));
+    replay->log = log;
+    replay->active = log != NULL;
+}
+
+bool input_replay_next(InputReplay* replay, TickInput* out_input) {
+    if (!replay || !replay->active || !out_input) return false;
+    const InputLog* log = replay->log;
+
+    // Skip finished (and empty) runs
+    while (replay->run < log->header.run_count &&
+           replay->run_tick >= log->runs[replay->run].ticks) {
+        replay->run++;
+        replay->run_tick = 0;
+    }
+    if (replay->run >= log->header.run_count) return false;
+
+    *out_input = log->runs[replay->run].input;
+    replay->run_tick++;
+    replay->tick++;
+    return true;
+}
+
+bool input_replay_check(InputReplay* replay, uint64_t world_hash) {
+    if (!replay || !replay->active) return true;
+    const InputLogHeader* h = &replay->log->header;
+    if (h->hash_interval == 0 || replay->tick == 0 || replay->tick % h->hash_interval != 0) return true;
+
+    uint32_t index = replay->tick / h->hash_interval - 1;
+    if (index >= h->hash_count) return true;
+    replay->hashes_checked++;
+
+    if (replay->log->hashes[index] == world_hash) return true;
+    if (!replay->diverged) {
+        replay->diverged = true;
+        replay->diverged_tick = replay->tick;
+        printf("Input Record: Replay diverged at tick %u (hash %016llx, recorded %016llx)\n",
+               replay->tick, (unsigned long long)world_hash,
+               (unsigned long long)replay->log->hashes[index]);
+    }
+    return false;
+}
+
+bool input_replay_finished(const InputReplay* replay) {
+    if (!replay || !replay->log) return true;
+    return replay->tick >= replay->log->header.tick_count;
+}
@@ -6,16 +6,36 @@
 #include "game_render.h"
 #include "input_actions.h"
 #include "ship_ui.h"
+#include "ship_render.h"
+#include "poi_render.h"
 #include "game_constants.h"
 #include <raylib.h>
 #include <stdio.h>
+#include <string.h>
 
 // Global config file for hot-reload support
 static ConfigFile g_config;
 
-int main(void) {
+// Usage: MSTour [--record <session.msir>] [--replay <session.msir>]
+//   --record  saves every fixed step's input and world hash on exit
+//   --replay  plays a recording from the start, reports the first step whose
+//             world hash differs, and exits when it ends
+int main(int argc, char** argv) {
     printf("=== MS Tour - Gothenburg Archipelago Shipping Company ===\n");
 
+    const char* record_path = NULL;
+    const char* replay_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--record <session.msir>] [--replay <session.msir>]\n", argv[0]);
+            return 1;
+        }
+    }
+
     // Load configuration from file
     config_init(&g_config);
     if (!config_load(&g_config, "config.ini")) {
@@ -24,13 +44,15 @@ int main(void) {
 
     // Get window configuration (uses defaults if not loaded)
     WindowConfig window_cfg = config_get_window(&g_config);
+    SimulationConfig sim_cfg = config_get_simulation(&g_config);
     
     // Engine configuration from loaded config
     EngineConfig config = {
         .window_title = window_cfg.title,
         .window_width = window_cfg.width,
         .window_height = window_cfg.height,
-        .target_fps = window_cfg.target_fps
+        .target_fps = window_cfg.target_fps,
+        .vsync = window_cfg.vsync
     };
 
     // Initialize engine
@@ -40,6 +62,12 @@ int main(void) {
     }
 
     renderer_init();
+    
+    // Simulation steps at a fixed rate, independent of the frame rate
+    engine_set_fixed_timestep(1.0 / sim_cfg.tick_rate);
+    engine_set_max_fixed_steps((uint32_t)sim_cfg.max_steps_per_frame);
+    printf("Simulation: %d Hz fixed step (max %d per frame)\n",
+           sim_cfg.tick_rate, sim_cfg.max_steps_per_frame);
 
     // Initialize input action system
     input_actions_init();
@@ -53,6 +81,18 @@ int main(void) {
         return 1;
     }
 
+    // Recording and replay start from the freshly initialized world
+    if (replay_path) {
+        if (!game_state_start_replay(game, replay_path)) {
+            game_state_shutdown(game);
+            engine_shutdown();
+            return 1;
+        }
+        engine_set_fixed_timestep(1.0 / game->input_log.header.tick_rate);
+    } else if (record_path) {
+        game_state_start_recording(game, record_path, (uint32_t)sim_cfg.tick_rate);
+    }
+
     // Initialize ship UI
     ship_ui_init();
     printf("Ship UI system initialized\n");
@@ -63,14 +103,21 @@ int main(void) {
 
     // Main game loop
     while (!engine_should_close()) {
-        float delta_time = (float)engine_get_delta_time();
+        if (replay_path && !game->replay.active) break;
 
         engine_begin_frame();
-
-        // Update game systems
-        game_update(game, delta_time);
-
-        // Render game
+        float frame_time = (float)engine_get_delta_time();
+
+        // Input once per frame, then as many fixed simulation steps as the
+        // frame's time covers (time warp may take several at once)
+        game_update_frame_begin(game);
+        float fixed_dt = (float)engine_get_fixed_delta_time();
+        while (engine_should_update_fixed_steps(game_state_steps_per_tick(game, fixed_dt))) {
+            game_update_fixed(game, fixed_dt);
+        }
+        game_update_frame_end(game, frame_time, (float)engine_get_fixed_alpha());
+
+        // Render game (ship drawn between the last two steps)
         game_render(game);
 
         engine_end_frame();
@@ -78,6 +125,9 @@ int main(void) {
 
     // Cleanup
     ship_ui_cleanup();
+    ship_render_shutdown();
+    poi_render_shutdown();
+    game_render_shutdown();
     game_state_shutdown(game);
     renderer_shutdown();
     engine_shutdown();
@@ -0,0 +1,356 @@
+#include "poi_render.h"
+#include "game_constants.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// Meshes
+// =============================================================================
+
+// Vertices [first, first + count) of g_meshes, in local space
+typedef struct PoiMesh {
+    uint32_t first;
+    uint32_t count;
+} PoiMesh;
+
+static TriangleBatch g_meshes;
+static PoiMesh g_icon_mesh[POI_TYPE_COUNT][POI_TIER_COUNT];
+static PoiMesh g_check_mesh[POI_TIER_COUNT];
+static PoiMesh g_ring_mesh;                 // Special tier only
+static PoiMesh g_area_mesh;                 // Radius 1
+static Color g_icon_color[POI_TYPE_COUNT][POI_TIER_COUNT][2];   // [visited]
+static bool g_meshes_ready;
+
+static Color get_poi_color(POIType type, POITier tier, bool visited) {
+    Color base;
+
+    switch (type) {
+        case POI_TYPE_NATURE:
+            base = (Color){34, 139, 34, 255};  // Forest green
+            break;
+        case POI_TYPE_HISTORICAL:
+            base = (Color){139, 69, 19, 255};  // Saddle brown
+            break;
+        case POI_TYPE_MILITARY:
+            base = (Color){105, 105, 105, 255}; // Dim gray
+            break;
+        default:
+            base = WHITE;
+            break;
+    }
+
+    // Special tier is brighter
+    if (tier == POI_TIER_SPECIAL) {
+        base.r = (unsigned char)fminf(base.r * 1.3f, 255);
+        base.g = (unsigned char)fminf(base.g * 1.3f, 255);
+        base.b = (unsigned char)fminf(base.b * 1.3f, 255);
+    }
+
+    // Visited POIs are slightly faded
+    if (visited) {
+        base.a = 180;
+    }
+
+    return base;
+}
+
+static PoiMesh mesh_since(uint32_t first) {
+    PoiMesh mesh = {first, g_meshes.count - first};
+    return mesh;
+}
+
+static void poi_render_build_meshes(void) {
+    if (g_meshes_ready) return;
+    renderer_triangle_batch_clear(&g_meshes);
+
+    for (int type = 0; type < POI_TYPE_COUNT; type++) {
+        for (int tier = 0; tier < POI_TIER_COUNT; tier++) {
+            float size = (tier == POI_TIER_SPECIAL) ? 16.0f : 12.0f;
+            uint32_t first = g_meshes.count;
+
+            switch ((POIType)type) {
+                case POI_TYPE_NATURE:
+                    // Tree-like triangle
+                    renderer_triangle_batch_add(&g_meshes, (Vector2){0.0f, -size},
+                                                (Vector2){-size * 0.7f, size * 0.5f},
+                                                (Vector2){size * 0.7f, size * 0.5f}, WHITE);
+                    break;
+
+                case POI_TYPE_HISTORICAL: {
+                    // Building-like rectangle with roof
+                    Vector2 tl = {-size * 0.5f, -size * 0.3f};
+                    Vector2 br = {size * 0.5f, size * 0.5f};
+                    renderer_triangle_batch_add(&g_meshes, tl, (Vector2){tl.x, br.y}, br, WHITE);
+                    renderer_triangle_batch_add(&g_meshes, tl, br, (Vector2){br.x, tl.y}, WHITE);
+                    renderer_triangle_batch_add(&g_meshes, (Vector2){0.0f, -size},
+                                                (Vector2){-size * 0.6f, -size * 0.3f},
+                                                (Vector2){size * 0.6f, -size * 0.3f}, WHITE);
+                    break;
+                }
+
+                case POI_TYPE_MILITARY:
+                    // Star/fort shape
+                    renderer_triangle_batch_add_circle(&g_meshes, 0.0f, 0.0f, size, 5, WHITE);
+                    break;
+
+                default:
+                    renderer_triangle_batch_add_circle(&g_meshes, 0.0f, 0.0f, size,
+                                                       RENDER_SMALL_CIRCLE_SEGMENTS, WHITE);
+                    break;
+            }
+            g_icon_mesh[type][tier] = mesh_since(first);
+
+            g_icon_color[type][tier][0] = get_poi_color((POIType)type, (POITier)tier, false);
+            g_icon_color[type][tier][1] = get_poi_color((POIType)type, (POITier)tier, true);
+        }
+    }
+
+    // Check mark at the icon's top-right
+    for (int tier = 0; tier < POI_TIER_COUNT; tier++) {
+        float size = (tier == POI_TIER_SPECIAL) ? 16.0f : 12.0f;
+        uint32_t first = g_meshes.count;
+        renderer_triangle_batch_add_circle(&g_meshes, size, -size, 5.0f, RENDER_SMALL_CIRCLE_SEGMENTS, WHITE);
+        g_check_mesh[tier] = mesh_since(first);
+    }
+
+    uint32_t first = g_meshes.count;
+    renderer_triangle_batch_add_ring(&g_meshes, 0.0f, 0.0f, 16.0f + 4.0f, 1.0f, RENDER_CIRCLE_SEGMENTS, WHITE);
+    g_ring_mesh = mesh_since(first);
+
+    first = g_meshes.count;
+    renderer_triangle_batch_add_circle(&g_meshes, 0.0f, 0.0f, 1.0f, RENDER_CIRCLE_SEGMENTS, WHITE);
+    g_area_mesh = mesh_since(first);
+
+    g_meshes_ready = true;
+}
+
+// Append a mesh scaled about its origin and moved to (x, y)
+static void batch_copy_mesh(TriangleBatch* batch, PoiMesh mesh, float x, float y, float scale, Color color) {
+    if (!renderer_triangle_batch_reserve(batch, mesh.count)) return;
+
+    const float* mx = &g_meshes.x[mesh.first];
+    const float* my = &g_meshes.y[mesh.first];
+    float* bx = &batch->x[batch->count];
+    float* by = &batch->y[batch->count];
+    Color* bc = &batch->color[batch->count];
+    for (uint32_t i = 0; i < mesh.count; i++) {
+        bx[i] = x + mx[i] * scale;
+        by[i] = y + my[i] * scale;
+        bc[i] = color;
+    }
+    batch->count += mesh.count;
+}
+
+// Fog alpha of a POI (0 = clear), or -1 when the fog hides it completely
+static float poi_fog_alpha(const FogOfWarState* fog, int poi) {
+    if (!fog) return 0.0f;
+    float fog_alpha = fog_get_poi_alpha(fog, poi);
+
+    // In prototype mode, always render POIs (but fogged)
+    // In non-prototype mode, skip completely hidden POIs
+    if (!fog->prototype_mode && fog_alpha > 0.95f) return -1.0f;
+    return fog_alpha;
+}
+
+uint32_t poi_render_batch_markers(TriangleBatch* batch, const POIEcsWorld* poi_world,
+                                  const FogOfWarState* fog, const int* pois, uint32_t count) {
+    if (!batch) return 0;
+    if (!poi_world || !pois) return batch->count;
+    poi_render_build_meshes();
+
+    // Radius indicators under every icon (subtle, only when somewhat visible)
+    for (uint32_t v = 0; v < count; v++) {
+        int i = pois[v];
+        float fog_alpha = poi_fog_alpha(fog, i);
+        if (fog_alpha < 0.0f || fog_alpha >= 0.8f) continue;
+
+        float x, y;
+        poi_ecs_get_position(poi_world, i, &x, &y);
+        Color radius_color = {100, 100, 255, (unsigned char)(30 * (1.0f - fog_alpha))};
+        batch_copy_mesh(batch, g_area_mesh, x, y, poi_ecs_get_radius(poi_world, i), radius_color);
+    }
+
+    uint32_t icons_first = batch->count;
+    for (uint32_t v = 0; v < count; v++) {
+        int i = pois[v];
+        float fog_alpha = poi_fog_alpha(fog, i);
+        if (fog_alpha < 0.0f) continue;
+
+        POIType type = poi_ecs_get_type(poi_world, i);
+        POITier tier = poi_ecs_get_tier(poi_world, i);
+        if ((unsigned)type >= POI_TYPE_COUNT || (unsigned)tier >= POI_TIER_COUNT) continue;
+        bool visited = poi_ecs_is_visited(poi_world, i);
+
+        float x, y;
+        poi_ecs_get_position(poi_world, i, &x, &y);
+
+        // Apply fog - ensure minimum visibility for navigation
+        // At full fog (1.0), show faint icon at FOG_POI_MIN_ALPHA
+        // At no fog (0.0), show full color
+        float alpha_mult = FOG_POI_MIN_ALPHA + (1.0f - FOG_POI_MIN_ALPHA) * (1.0f - fog_alpha);
+        Color color = g_icon_color[type][tier][visited ? 1 : 0];
+        color.a = (unsigned char)(color.a * alpha_mult);
+        batch_copy_mesh(batch, g_icon_mesh[type][tier], x, y, 1.0f, color);
+
+        // Ring for special tier (more visible when revealed)
+        if (tier == POI_TIER_SPECIAL) {
+            Color ring_color = GOLD;
+            ring_color.a = (unsigned char)(200 * alpha_mult);
+            batch_copy_mesh(batch, g_ring_mesh, x, y, 1.0f, ring_color);
+        }
+
+        if (visited) {
+            Color check_color = GREEN;
+            check_color.a = (unsigned char)(255 * alpha_mult);
+            batch_copy_mesh(batch, g_check_mesh[tier], x, y, 1.0f, check_color);
+        }
+    }
+    return icons_first;
+}
+
+// =============================================================================
+// Labels
+// =============================================================================
+
+// Glyph quads of POI i are g_label_quads[g_label_start[i], g_label_start[i + 1])
+static GlyphQuad* g_label_quads;
+static uint32_t* g_label_start;
+static float* g_label_width;
+static uint32_t g_label_count;
+static uint32_t g_labels_generation;        // POI set the labels were laid out for (0 = none)
+static Texture2D g_label_atlas;
+
+bool poi_render_prepare_labels(const POIEcsWorld* poi_world, Font font) {
+    if (!poi_world) return false;
+
+    // DrawText's spacing for the default font
+    const float font_size = (float)POI_LABEL_FONT_SIZE;
+    const float spacing = font_size / 10.0f;
+    uint32_t count = poi_ecs_get_count(poi_world);
+
+    // Quads per label first, then each label laid out in place
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const char* name = poi_ecs_get_name(poi_world, (int)i);
+        total += renderer_text_layout(font, name ? name : "", font_size, spacing, NULL, 0, NULL);
+    }
+
+    uint32_t* start = (uint32_t*)realloc(g_label_start, (count + 1) * sizeof(uint32_t));
+    if (start) g_label_start = start;
+    float* width = (float*)realloc(g_label_width, (count ? count : 1) * sizeof(float));
+    if (width) g_label_width = width;
+    GlyphQuad* quads = (GlyphQuad*)realloc(g_label_quads, (total ? total : 1) * sizeof(GlyphQuad));
+    if (quads) g_label_quads = quads;
+    if (!start || !width || !quads) {
+        g_label_count = 0;
+        g_labels_generation = 0;
+        return false;
+    }
+
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const char* name = poi_ecs_get_name(poi_world, (int)i);
+        g_label_start[i] = offset;
+        offset += renderer_text_layout(font, name ? name : "", font_size, spacing,
+                                       &g_label_quads[offset], total - offset, &g_label_width[i]);
+    }
+    g_label_start[count] = offset;
+
+    g_label_count = count;
+    g_labels_generation = poi_ecs_get_generation(poi_world);
+    g_label_atlas = font.texture;
+    return true;
+}
+
+float poi_render_label_width(int poi_index) {
+    if (poi_index < 0 || (uint32_t)poi_index >= g_label_count) return 0.0f;
+    return g_label_width[poi_index];
+}
+
+uint32_t poi_render_batch_labels(GlyphBatch* batch, const POIEcsWorld* poi_world,
+                                 const FogOfWarState* fog, const int* pois, uint32_t count) {
+    if (!batch || !poi_world || !pois) return 0;
+
+    // Laid out again whenever POIs were added, removed or reloaded (the font
+    // is only there once the window is)
+    if (g_labels_generation != poi_ecs_get_generation(poi_world)) {
+        if (!poi_render_prepare_labels(poi_world, GetFontDefault())) return 0;
+    }
+    batch->atlas = g_label_atlas;
+
+    uint32_t added = 0;
+    for (uint32_t v = 0; v < count; v++) {
+        int i = pois[v];
+        if ((uint32_t)i >= g_label_count) continue;
+
+        // Only when fog is mostly cleared
+        float fog_alpha = poi_fog_alpha(fog, i);
+        if (fog_alpha < 0.0f || fog_alpha >= 0.5f) continue;
+
+        float x, y;
+        poi_ecs_get_position(poi_world, i, &x, &y);
+        Color text_color = WHITE;
+        text_color.a = (unsigned char)(200 * (1.0f - fog_alpha));
+
+        // Centred below the icon on whole pixels
+        int text_width = (int)g_label_width[i];
+        float label_x = (float)(int)(x - text_width / 2);
+        float label_y = (float)(int)(y + POI_LABEL_OFFSET_Y);
+        uint32_t first = g_label_start[i];
+        if (renderer_glyph_batch_add(batch, &g_label_quads[first], g_label_start[i + 1] - first,
+                                     label_x, label_y, text_color)) {
+            added++;
+        }
+    }
+    return added;
+}
+
+// =============================================================================
+// Queueing
+// =============================================================================
+
+static TriangleBatch g_marker_batch;
+static GlyphBatch g_label_batch;
+
+// Render queue callback drawing the queued labels
+static void poi_render_draw_labels(void* user_data) {
+    renderer_glyph_batch_flush((GlyphBatch*)user_data);
+}
+
+void poi_render_queue(RenderStream* stream, uint8_t area_layer, uint8_t layer, const POIEcsWorld* poi_world,
+                      const FogOfWarState* fog, const int* pois, uint32_t count) {
+    if (!stream || !poi_world) return;
+
+    renderer_triangle_batch_clear(&g_marker_batch);
+    renderer_glyph_batch_clear(&g_label_batch);
+
+    uint32_t icons_first = poi_render_batch_markers(&g_marker_batch, poi_world, fog, pois, count);
+    if (icons_first > 0) {
+        render_queue_triangles(stream, area_layer, 0.0f, &g_marker_batch, 0, icons_first);
+    }
+    if (g_marker_batch.count > icons_first) {
+        render_queue_triangles(stream, layer, 0.0f, &g_marker_batch, icons_first,
+                               g_marker_batch.count - icons_first);
+    }
+
+    // Labels after the icons of their layer
+    if (poi_render_batch_labels(&g_label_batch, poi_world, fog, pois, count) > 0) {
+        render_queue_callback(stream, layer, poi_render_draw_labels, &g_label_batch);
+    }
+}
+
+void poi_render_shutdown(void) {
+    renderer_triangle_batch_shutdown(&g_meshes);
+    renderer_triangle_batch_shutdown(&g_marker_batch);
+    renderer_glyph_batch_shutdown(&g_label_batch);
+    free(g_label_quads);
+    free(g_label_start);
+    free(g_label_width);
+    g_label_quads = NULL;
+    g_label_start = NULL;
+    g_label_width = NULL;
+    g_label_count = 0;
+    g_labels_generation = 0;
+    g_meshes_ready = false;
+}
@@ -1,6 +1,8 @@
 #include "ship_render.h"
 #include "game_constants.h"
 #include "engine_math.h"
+#include "engine_simd_math.h"
+#include "engine_renderer.h"
 #include <raylib.h>
 #include <raymath.h>
 #include <math.h>
@@ -32,8 +34,8 @@ ShipVisualStyle ship_render_get_ai_style(void) {
         .hull_color = BLUE,
         .outline_color = DARKBLUE,
         .center_color = WHITE,
-        .length = SHIP_LENGTH * 0.8f,  // AI ships slightly smaller
-        .width = SHIP_WIDTH * 0.8f
+        .length = SHIP_LENGTH * SHIP_AI_SCALE,  // AI ships slightly smaller
+        .width = SHIP_WIDTH * SHIP_AI_SCALE
     };
     return style;
 }
@@ -115,3 +117,138 @@ void ship_render_draw_wake(const ShipState* ship, float intensity) {
                    (Color){255, 255, 255, circle_alpha});
     }
 }
+
+// =============================================================================
+// Ship Entities
+// =============================================================================
+
+#define WAKE_CIRCLE_COUNT 3
+#define WAKE_SEGMENTS 8                 // Fan triangles per wake circle
+#define CENTER_SEGMENTS 6
+#define OUTLINE_THICKNESS 1.0f
+#define SHIP_BATCH_VERTICES (WAKE_CIRCLE_COUNT * WAKE_SEGMENTS * 3 + 3 + 3 * 6 + CENTER_SEGMENTS * 3)
+
+// Kept between frames so the stream is only allocated while the fleet grows,
+// and until the render queue it was queued on is submitted
+static TriangleBatch g_ship_batch;
+
+static Color ship_hull_color(const RenderableComponents* renderables, Entity e) {
+    return (Color){renderables->color_r[e], renderables->color_g[e],
+                   renderables->color_b[e], renderables->color_a[e]};
+}
+
+uint32_t ship_render_batch_layer(TriangleBatch* batch, const EcsRenderList* list, const ECSWorld* world,
+                                 ComponentMask ship_mask, Entity skip, uint32_t layer) {
+    if (!batch || !list || !world || layer >= ECS_RENDER_LAYER_COUNT) return 0;
+    
+    uint32_t first = list->layer_start[layer];
+    uint32_t last = list->layer_start[layer + 1];
+    if (first == last) return 0;
+    
+    const TransformComponents* transforms = &world->transforms;
+    const RenderableComponents* renderables = &world->renderables;
+    
+    // Headings of the layer at once; forward = (sin, -cos), starboard = (cos, sin)
+    float sin_h[MAX_ENTITIES];
+    float cos_h[MAX_ENTITIES];
+    simd_sincos_deg_batch(list->rotation + first, sin_h, cos_h, last - first);
+    
+    // Stern corners lie SHIP_STERN_ANGLE either side of the bow
+    float stern_rad = math_deg_to_rad(SHIP_STERN_ANGLE);
+    float stern_fwd = cosf(stern_rad) * SHIP_STERN_WIDTH_MULT;
+    float stern_side = sinf(stern_rad) * SHIP_STERN_WIDTH_MULT;
+    
+    // Ships of this layer and their hull corners
+    uint32_t run[MAX_ENTITIES];
+    Vector2 bow[MAX_ENTITIES];
+    Vector2 stern_left[MAX_ENTITIES];
+    Vector2 stern_right[MAX_ENTITIES];
+    uint32_t count = 0;
+    
+    for (uint32_t i = first; i < last; i++) {
+        Entity e = list->entity[i];
+        if (e == skip || (world->entity_masks[e] & ship_mask) != ship_mask) continue;
+        
+        uint32_t h = i - first;
+        float fx = sin_h[h], fy = -cos_h[h];
+        float sx = cos_h[h], sy = sin_h[h];
+        float length = SHIP_LENGTH * transforms->scale_x[e];
+        float width = SHIP_WIDTH * transforms->scale_y[e];
+        float x = list->x[i], y = list->y[i];
+        
+        bow[count] = (Vector2){x + fx * length * SHIP_BOW_LENGTH_MULT,
+                               y + fy * length * SHIP_BOW_LENGTH_MULT};
+        stern_left[count] = (Vector2){x + (fx * stern_fwd + sx * stern_side) * width,
+                                      y + (fy * stern_fwd + sy * stern_side) * width};
+        stern_right[count] = (Vector2){x + (fx * stern_fwd - sx * stern_side) * width,
+                                       y + (fy * stern_fwd - sy * stern_side) * width};
+        run[count++] = i;
+    }
+    if (count == 0) return 0;
+    if (!renderer_triangle_batch_reserve(batch, count * SHIP_BATCH_VERTICES)) return 0;
+    
+    // Wakes behind every hull
+    for (uint32_t k = 0; k < count; k++) {
+        uint32_t i = run[k];
+        Entity e = list->entity[i];
+        float speed = math_abs(world->velocities.speed[e]);
+        if (speed < 1.0f) continue;
+        
+        float scale = transforms->scale_x[e];
+        float alpha = 100.0f * math_clamp(speed / 100.0f, 0.0f, 1.0f);
+        float back_x = -sin_h[i - first];
+        float back_y = cos_h[i - first];
+        for (int c = 0; c < WAKE_CIRCLE_COUNT; c++) {
+            float behind = (SHIP_LENGTH * 0.5f + (float)c * 15.0f) * scale;
+            float radius = (8.0f + (float)c * 4.0f) * scale;
+            unsigned char circle_alpha = (unsigned char)(alpha * (1.0f - (float)c * 0.3f));
+            renderer_triangle_batch_add_circle(batch, list->x[i] + back_x * behind,
+                                               list->y[i] + back_y * behind, radius, WAKE_SEGMENTS,
+                                               (Color){255, 255, 255, circle_alpha});
+        }
+    }
+    
+    // Hulls, then outlines (darker) and centres (lighter) in the hull colour
+    for (uint32_t k = 0; k < count; k++) {
+        Color hull = ship_hull_color(renderables, list->entity[run[k]]);
+        renderer_triangle_batch_add(batch, stern_left[k], stern_right[k], bow[k], hull);
+    }
+    for (uint32_t k = 0; k < count; k++) {
+        Color hull = ship_hull_color(renderables, list->entity[run[k]]);
+        Color outline = {hull.r / 2, hull.g / 2, hull.b / 2, hull.a};
+        renderer_triangle_batch_add_line(batch, stern_left[k], stern_right[k], OUTLINE_THICKNESS, outline);
+        renderer_triangle_batch_add_line(batch, stern_right[k], bow[k], OUTLINE_THICKNESS, outline);
+        renderer_triangle_batch_add_line(batch, bow[k], stern_left[k], OUTLINE_THICKNESS, outline);
+    }
+    for (uint32_t k = 0; k < count; k++) {
+        uint32_t i = run[k];
+        Color hull = ship_hull_color(renderables, list->entity[i]);
+        Color center = {(unsigned char)(hull.r + (255 - hull.r) / 2),
+                        (unsigned char)(hull.g + (255 - hull.g) / 2),
+                        (unsigned char)(hull.b + (255 - hull.b) / 2), hull.a};
+        renderer_triangle_batch_add_circle(batch, list->x[i], list->y[i], SHIP_CENTER_RADIUS,
+                                           CENTER_SEGMENTS, center);
+    }
+    return count;
+}
+
+void ship_render_queue_list(RenderStream* stream, uint8_t base_layer, const EcsRenderList* list,
+                            const ECSWorld* world, ComponentMask ship_mask, Entity skip) {
+    if (!stream || !list || !world) return;
+    
+    // One range of the shared stream per entity layer, drawn at submit
+    renderer_triangle_batch_clear(&g_ship_batch);
+    for (uint32_t layer = 0; layer < ECS_RENDER_LAYER_COUNT; layer++) {
+        uint32_t first = g_ship_batch.count;
+        if (ship_render_batch_layer(&g_ship_batch, list, world, ship_mask, skip, layer) == 0) continue;
+        
+        uint32_t queue_layer = base_layer + layer;
+        if (queue_layer > UINT8_MAX) queue_layer = UINT8_MAX;
+        render_queue_triangles(stream, (uint8_t)queue_layer, 0.0f, &g_ship_batch,
+                               first, g_ship_batch.count - first);
+    }
+}
+
+void ship_render_shutdown(void) {
+    renderer_triangle_batch_shutdown(&g_ship_batch);
+}
@@ -0,0 +1,165 @@
+// =============================================================================
+// Coastline Tests
+// Tests for island loading, grounding, AI avoidance and fog occlusion
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+
+extern "C" {
+#include "engine_ecs.h"
+#include "game_coastline.h"
+#include "game_ecs.h"
+#include "game_fog_of_war.h"
+}
+
+// One square island, 200 units on a side, east of the origin
+static const char* COAST_TEST_JSON =
+    "{ \"version\": \"1.0\", \"islands\": ["
+    "  { \"name\": \"Square\", \"points\": [[200, -100], [400, -100], [400, 100], [200, 100]] }"
+    "] }";
+
+struct CoastWorld {
+    ECSWorld world;
+    GameEcsState game;
+};
+
+static void make_coast_world(CoastWorld* c) {
+    game_ecs_init(&c->game, &c->world);
+    ASSERT_TRUE(coastline_load_from_string(&c->game.coast, COAST_TEST_JSON));
+}
+
+TEST(CoastlineTest, LoadsAndTriangulatesIslands) {
+    // A concave L and a triangle, wound opposite ways
+    const char* json =
+        "{ \"islands\": ["
+        "  { \"name\": \"L\", \"points\": [[0, 0], [300, 0], [300, 100], [100, 100], [100, 300], [0, 300]] },"
+        "  { \"name\": \"T\", \"points\": [[1000, 0], [900, 200], [1100, 200]] }"
+        "] }";
+    CoastlineState coast;
+    coastline_init(&coast);
+    ASSERT_TRUE(coastline_load_from_string(&coast, json));
+    EXPECT_EQ(coast.island_count, 2u);
+    EXPECT_EQ(coast.bvh.segment_count, 9u);
+    EXPECT_EQ(coast.triangle_count, 4u + 1u);
+    
+    // Triangles cover each outline exactly and are wound the way raylib draws
+    double area[2] = { 0.0, 0.0 };
+    for (uint32_t island = 0; island < 2; island++) {
+        for (uint32_t t = coast.triangle_start[island]; t < coast.triangle_start[island + 1]; t++) {
+            const uint32_t* tri = &coast.triangles[t * 3];
+            float cross = (coast.point_x[tri[1]] - coast.point_x[tri[0]]) * (coast.point_y[tri[2]] - coast.point_y[tri[0]]) -
+                          (coast.point_y[tri[1]] - coast.point_y[tri[0]]) * (coast.point_x[tri[2]] - coast.point_x[tri[0]]);
+            EXPECT_LT(cross, 0.0f);
+            area[island] += -cross * 0.5;
+        }
+    }
+    EXPECT_NEAR(area[0], 300.0 * 100.0 + 100.0 * 200.0, 1e-3);
+    EXPECT_NEAR(area[1], 200.0 * 200.0 / 2.0, 1e-3);
+    EXPECT_FLOAT_EQ(coast.island_bounds[4], 900.0f);
+    
+    EXPECT_TRUE(coastline_is_land(&coast, 50.0f, 250.0f));
+    EXPECT_FALSE(coastline_is_land(&coast, 250.0f, 250.0f));  // In the L's notch
+    EXPECT_TRUE(coastline_circle_touches_land(&coast, 250.0f, 250.0f, 160.0f));
+    EXPECT_FALSE(coastline_circle_touches_land(&coast, 250.0f, 250.0f, 140.0f));
+    
+    // Bad data leaves open water
+    EXPECT_FALSE(coastline_load_from_string(&coast, "{ \"islands\": [ { \"points\": [[0, 0], [1, 1]] } ] }"));
+    EXPECT_EQ(coast.island_count, 0u);
+    EXPECT_FALSE(coastline_is_land(&coast, 50.0f, 250.0f));
+    EXPECT_FALSE(coastline_load_from_file(&coast, "no_such_coastline.json"));
+    coastline_shutdown(&coast);
+}
+
+TEST(CoastlineTest, GenerationChangesOnReload) {
+    CoastlineState coast;
+    coastline_init(&coast);
+    uint32_t empty = coast.generation;
+    ASSERT_TRUE(coastline_load_from_string(&coast, COAST_TEST_JSON));
+    uint32_t square = coast.generation;
+    EXPECT_NE(square, empty);
+    
+    // Queries leave it alone; the same data loaded again is a new coastline
+    coastline_is_land(&coast, 300.0f, 0.0f);
+    EXPECT_EQ(coast.generation, square);
+    ASSERT_TRUE(coastline_load_from_string(&coast, COAST_TEST_JSON));
+    EXPECT_EQ(coast.island_count, 1u);
+    EXPECT_NE(coast.generation, square);
+    
+    CoastlineState other;
+    coastline_init(&other);
+    EXPECT_NE(other.generation, coast.generation);
+    coastline_shutdown(&other);
+    coastline_shutdown(&coast);
+}
+
+TEST(CoastlineTest, ShipRunsAgroundAndBacksOff) {
+    std::unique_ptr<CoastWorld> c(new CoastWorld());
+    make_coast_world(c.get());
+    const float dt = 1.0f / 60.0f;
+    
+    // Full ahead due east at the island's west shore
+    Entity ship = game_create_player_ship(&c->game, 0.0f, 0.0f, 90.0f);
+    game_ecs_set_throttle(&c->game, ship, 1.0f);
+    uint32_t grounded_ticks = 0;
+    for (int t = 0; t < 600; t++) {
+        game_ecs_update(&c->game, dt);
+        grounded_ticks += c->game.coast.grounded_count;
+        ASSERT_LT(c->world.transforms.pos_x[ship] + c->world.colliders.hull_bow[ship], 200.0f) << "tick " << t;
+    }
+    EXPECT_GT(grounded_ticks, 0u);
+    EXPECT_GT(c->world.transforms.pos_x[ship], 140.0f);      // Made it to the shore
+    EXPECT_FLOAT_EQ(c->world.transforms.rotation[ship], 90.0f);
+    
+    // Astern pulls it off again
+    game_ecs_set_throttle(&c->game, ship, -1.0f);
+    for (int t = 0; t < 300; t++) game_ecs_update(&c->game, dt);
+    EXPECT_EQ(c->game.coast.grounded_count, 0u);
+    EXPECT_LT(c->world.transforms.pos_x[ship], 100.0f);
+    game_ecs_shutdown(&c->game);
+}
+
+TEST(CoastlineTest, AiLookaheadSteersClear) {
+    std::unique_ptr<CoastWorld> c(new CoastWorld());
+    make_coast_world(c.get());
+    const float dt = 1.0f / 60.0f;
+    
+    // Half ahead straight for the island from 700 units off
+    Entity ship = game_create_ai_ship(&c->game, -500.0f, 0.0f, 90.0f, 0);
+    game_ecs_set_throttle(&c->game, ship, 0.5f);
+    bool avoided = false;
+    uint32_t grounded_ticks = 0;
+    for (int t = 0; t < 1200; t++) {
+        game_ecs_update(&c->game, dt);
+        avoided |= c->game.ai_world.ai.avoiding[ship] != 0;
+        grounded_ticks += c->game.coast.grounded_count;
+    }
+    EXPECT_TRUE(avoided);
+    EXPECT_EQ(grounded_ticks, 0u);
+    EXPECT_GT(fabsf(c->world.transforms.rotation[ship] - 90.0f), 10.0f);
+    EXPECT_GT(c->world.transforms.pos_x[ship], 400.0f);          // Went round it
+    EXPECT_FALSE(coastline_circle_touches_land(&c->game.coast, c->world.transforms.pos_x[ship],
+                                               c->world.transforms.pos_y[ship], 20.0f));
+    EXPECT_GT(fabsf(c->world.velocities.speed[ship]), 10.0f);  // Still under way
+    game_ecs_shutdown(&c->game);
+}
+
+TEST(CoastlineTest, FogStaysBehindIslands) {
+    std::unique_ptr<CoastWorld> c(new CoastWorld());
+    make_coast_world(c.get());
+    FogOfWarState* fog = game_ecs_get_fog(&c->game);
+    
+    fog_reveal_area(fog, 0.0f, 0.0f, 700.0f);
+    EXPECT_TRUE(fog_is_position_revealed(fog, 100.0f, 10.0f));    // Open water
+    EXPECT_TRUE(fog_is_position_revealed(fog, 225.0f, 25.0f));    // Near shore
+    EXPECT_FALSE(fog_is_position_revealed(fog, 525.0f, 25.0f));   // Behind the island
+    EXPECT_TRUE(fog_is_position_revealed(fog, 525.0f, 325.0f));   // Sight line passes north of it
+    
+    // Without occluders the whole circle clears
+    fog_reset(fog);
+    fog_set_occluders(fog, NULL);
+    fog_reveal_area(fog, 0.0f, 0.0f, 700.0f);
+    EXPECT_TRUE(fog_is_position_revealed(fog, 525.0f, 25.0f));
+    game_ecs_shutdown(&c->game);
+}
@@ -3,13 +3,35 @@
 extern "C" {
     #include "engine_core.h"
     #include "engine_renderer.h"
+    #include "engine_render_queue.h"
+    #include "engine_layer_cache.h"
     #include "engine_math.h"
+    #include "engine_bitset.h"
+    #include "engine_collision.h"
     #include "engine_ecs.h"
+    #include "engine_event_ring.h"
+    #include "engine_jobs.h"
+    #include "engine_simd_math.h"
+    #include "engine_json_stream.h"
+    #include "engine_segment_bvh.h"
+    #include "engine_spatial_grid.h"
+    #include "engine_string_arena.h"
+    #include "engine_string_index.h"
     #include "game_ship_ecs.h"
     #include "game_ai_ecs.h"
 }
 
 #include <raylib.h>
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
 
 // Test engine state structure
 TEST(EngineTests, StateStructSize) {
@@ -33,6 +55,139 @@ TEST(RendererTests, RaylibColors) {
     EXPECT_EQ(RED.b, 55);
 }
 
+// Rectangles keep float coordinates far outside the int16 range and their own colour
+TEST(RendererTests, RectBatchFloatCoordinatesAndColors) {
+    RectBatch batch;
+    ASSERT_TRUE(renderer_rect_batch_init(&batch, 4, BLUE));
+    EXPECT_EQ(batch.capacity, 4u);
+
+    EXPECT_TRUE(renderer_rect_batch_add(&batch, 40000.25f, -50000.5f, 8.5f, 8.5f));
+    EXPECT_TRUE(renderer_rect_batch_add_colored(&batch, -1.5f, 2.75f, 0.5f, 1.0f, RED));
+    EXPECT_TRUE(renderer_rect_batch_add(&batch, 0.0f, 0.0f, 1.0f, 1.0f));
+    EXPECT_TRUE(renderer_rect_batch_add(&batch, 0.0f, 0.0f, 1.0f, 1.0f));
+    EXPECT_FALSE(renderer_rect_batch_add(&batch, 0.0f, 0.0f, 1.0f, 1.0f));
+    ASSERT_EQ(batch.count, 4u);
+
+    EXPECT_FLOAT_EQ(batch.x[0], 40000.25f);
+    EXPECT_FLOAT_EQ(batch.y[0], -50000.5f);
+    EXPECT_FLOAT_EQ(batch.w[0], 8.5f);
+    EXPECT_EQ(batch.colors[0].b, BLUE.b);
+    EXPECT_FLOAT_EQ(batch.x[1], -1.5f);
+    EXPECT_FLOAT_EQ(batch.y[1], 2.75f);
+    EXPECT_EQ(batch.colors[1].r, RED.r);
+    EXPECT_EQ(batch.colors[1].g, RED.g);
+
+    renderer_rect_batch_clear(&batch);
+    EXPECT_EQ(batch.count, 0u);
+    EXPECT_TRUE(renderer_rect_batch_add(&batch, 1.0f, 1.0f, 1.0f, 1.0f));
+
+    renderer_rect_batch_shutdown(&batch);
+    EXPECT_EQ(batch.x, nullptr);
+    EXPECT_EQ(batch.capacity, 0u);
+    EXPECT_FALSE(renderer_rect_batch_add(&batch, 0.0f, 0.0f, 1.0f, 1.0f));
+}
+
+// Triangles come out in the winding rlgl draws whichever way they went in
+TEST(RendererTests, TriangleBatchKeepsOneWinding) {
+    TriangleBatch batch;
+    renderer_triangle_batch_init(&batch);
+    EXPECT_EQ(batch.capacity, 0u);
+
+    renderer_triangle_batch_add(&batch, Vector2{0.0f, 0.0f}, Vector2{10.0f, 0.0f}, Vector2{0.0f, 10.0f}, RED);
+    renderer_triangle_batch_add(&batch, Vector2{0.0f, 0.0f}, Vector2{0.0f, 10.0f}, Vector2{10.0f, 0.0f}, BLUE);
+    renderer_triangle_batch_add_line(&batch, Vector2{0.0f, 0.0f}, Vector2{100.0f, 50.0f}, 4.0f, RED);
+    renderer_triangle_batch_add_line(&batch, Vector2{5.0f, 5.0f}, Vector2{5.0f, 5.0f}, 4.0f, RED);
+    renderer_triangle_batch_add_circle(&batch, 20.0f, 20.0f, 8.0f, 12, BLUE);
+    ASSERT_EQ(batch.count, 3u + 3u + 6u + 12u * 3u);   // The zero-length line adds nothing
+    EXPECT_EQ(batch.color[0].r, RED.r);
+    EXPECT_EQ(batch.color[3].b, BLUE.b);
+
+    for (uint32_t i = 0; i < batch.count; i += 3) {
+        float cross = (batch.x[i + 1] - batch.x[i]) * (batch.y[i + 2] - batch.y[i]) -
+                      (batch.y[i + 1] - batch.y[i]) * (batch.x[i + 2] - batch.x[i]);
+        EXPECT_LE(cross, 0.0f) << "triangle " << i / 3;
+    }
+
+    // Growing keeps what is there; clearing keeps the memory
+    float first_x = batch.x[4];
+    while (batch.count <= TRIANGLE_BATCH_MIN_CAPACITY) {
+        renderer_triangle_batch_add(&batch, Vector2{0.0f, 0.0f}, Vector2{1.0f, 0.0f}, Vector2{0.0f, 1.0f}, RED);
+    }
+    EXPECT_GT(batch.capacity, (uint32_t)TRIANGLE_BATCH_MIN_CAPACITY);
+    EXPECT_FLOAT_EQ(batch.x[4], first_x);
+    uint32_t capacity = batch.capacity;
+    renderer_triangle_batch_clear(&batch);
+    EXPECT_EQ(batch.count, 0u);
+    EXPECT_EQ(batch.capacity, capacity);
+
+    renderer_triangle_batch_shutdown(&batch);
+    EXPECT_EQ(batch.x, nullptr);
+    EXPECT_EQ(batch.capacity, 0u);
+}
+
+TEST(RendererTests, TextLayoutMatchesDrawTextAndBatches) {
+    // A two-glyph font in a 128x64 atlas
+    GlyphInfo glyphs[2] = {};
+    Rectangle recs[2] = {};
+    glyphs[0].value = 'A';
+    glyphs[0].offsetX = 1;
+    glyphs[0].offsetY = 2;
+    recs[0] = Rectangle{10.0f, 20.0f, 6.0f, 8.0f};
+    glyphs[1].value = ' ';
+    glyphs[1].advanceX = 4;
+
+    Font font = {};
+    font.baseSize = 10;
+    font.glyphCount = 2;
+    font.glyphs = glyphs;
+    font.recs = recs;
+    font.texture.id = 1;
+    font.texture.width = 128;
+    font.texture.height = 64;
+
+    // Blanks take no quad; scale 2 and spacing 2 as DrawTextEx
+    GlyphQuad quads[4];
+    float width = 0.0f;
+    ASSERT_EQ(renderer_text_layout(font, "A A", 20.0f, 2.0f, quads, 4, &width), 2u);
+    EXPECT_FLOAT_EQ(quads[0].x0, 2.0f);
+    EXPECT_FLOAT_EQ(quads[0].y0, 4.0f);
+    EXPECT_FLOAT_EQ(quads[0].x1, 14.0f);
+    EXPECT_FLOAT_EQ(quads[0].y1, 20.0f);
+    EXPECT_FLOAT_EQ(quads[0].u0, 10.0f / 128.0f);
+    EXPECT_FLOAT_EQ(quads[0].v0, 20.0f / 64.0f);
+    EXPECT_FLOAT_EQ(quads[0].u1, 16.0f / 128.0f);
+    EXPECT_FLOAT_EQ(quads[0].v1, 28.0f / 64.0f);
+    EXPECT_FLOAT_EQ(quads[1].x0, 26.0f);
+    EXPECT_FLOAT_EQ(width, 40.0f);
+
+    // Counting alone, and no atlas means no layout
+    EXPECT_EQ(renderer_text_layout(font, "AAA", 20.0f, 2.0f, nullptr, 0, nullptr), 3u);
+    Font headless = font;
+    headless.texture.id = 0;
+    EXPECT_EQ(renderer_text_layout(headless, "A A", 20.0f, 2.0f, quads, 4, &width), 0u);
+    EXPECT_FLOAT_EQ(width, 0.0f);
+
+    GlyphBatch batch;
+    renderer_glyph_batch_init(&batch, font.texture);
+    EXPECT_EQ(batch.count, 0u);
+    ASSERT_TRUE(renderer_glyph_batch_add(&batch, quads, 2, 100.0f, 50.0f, RED));
+    ASSERT_TRUE(renderer_glyph_batch_add(&batch, quads, 2, -10.0f, 0.0f, BLUE));
+    ASSERT_EQ(batch.count, 4u);
+    EXPECT_GE(batch.capacity, (uint32_t)GLYPH_BATCH_MIN_CAPACITY);
+    EXPECT_FLOAT_EQ(batch.quads[0].x0, 102.0f);
+    EXPECT_FLOAT_EQ(batch.quads[0].y1, 70.0f);
+    EXPECT_FLOAT_EQ(batch.quads[0].u0, quads[0].u0);
+    EXPECT_FLOAT_EQ(batch.quads[3].x0, 16.0f);
+    EXPECT_EQ(batch.colors[0].r, RED.r);
+    EXPECT_EQ(batch.colors[3].b, BLUE.b);
+
+    renderer_glyph_batch_clear(&batch);
+    EXPECT_EQ(batch.count, 0u);
+    renderer_glyph_batch_shutdown(&batch);
+    EXPECT_EQ(batch.quads, nullptr);
+    EXPECT_EQ(batch.capacity, 0u);
+}
+
 // Test engine config structure
 TEST(EngineTests, ConfigStruct) {
     EngineConfig config;
@@ -307,3 +462,1554 @@ TEST(ECSTests, WorldClear) {
     
     EXPECT_EQ(ecs_get_entity_count(&world), 0u);
 }
+
+TEST(ECSTests, InterpolatedTransformBlendsLastTwoSteps) {
+    ECSWorld world;
+    ecs_world_init(&world);
+    
+    Entity e = ecs_create_entity(&world);
+    ecs_add_component(&world, e, COMPONENT_TRANSFORM);
+    ecs_set_position(&world, e, 0.0f, 100.0f);
+    ecs_set_rotation(&world, e, 350.0f);
+    ecs_store_previous_transforms(&world);
+    
+    ecs_set_position(&world, e, 10.0f, 80.0f);
+    ecs_set_rotation(&world, e, 10.0f);
+    
+    float x, y, rotation;
+    ecs_get_interpolated_transform(&world, e, 0.25f, &x, &y, &rotation);
+    EXPECT_FLOAT_EQ(x, 2.5f);
+    EXPECT_FLOAT_EQ(y, 95.0f);
+    EXPECT_FLOAT_EQ(rotation, 355.0f);  // Through north, not back round
+    
+    ecs_get_interpolated_transform(&world, e, 1.0f, &x, &y, &rotation);
+    EXPECT_FLOAT_EQ(x, 10.0f);
+    EXPECT_FLOAT_EQ(rotation, 10.0f);
+    
+    // A teleport snaps instead of sliding
+    ecs_set_position(&world, e, 500.0f, 500.0f);
+    ecs_snap_previous_transform(&world, e);
+    ecs_get_interpolated_transform(&world, e, 0.0f, &x, &y, NULL);
+    EXPECT_FLOAT_EQ(x, 500.0f);
+    EXPECT_FLOAT_EQ(y, 500.0f);
+}
+
+static Entity make_renderable(ECSWorld* world, float x, float y, uint8_t layer, bool visible) {
+    Entity e = ecs_create_entity(world);
+    ecs_add_component(world, e, COMPONENT_TRANSFORM);
+    ecs_add_component(world, e, COMPONENT_RENDERABLE);
+    ecs_set_position(world, e, x, y);
+    world->renderables.layer[e] = layer;
+    world->renderables.visible[e] = visible;
+    return e;
+}
+
+TEST(ECSTests, RenderListSortsByLayerAndCulls) {
+    ECSWorld world;
+    ecs_world_init(&world);
+    
+    // Entities on layers 2, 0, 2, 1 inside the view; one far off; one hidden
+    const uint8_t layers[4] = {2, 0, 2, 1};
+    Entity in_view[4];
+    for (int i = 0; i < 4; i++) {
+        in_view[i] = make_renderable(&world, 100.0f * i, 50.0f, layers[i], true);
+    }
+    make_renderable(&world, 5000.0f, 50.0f, 0, true);
+    make_renderable(&world, 500.0f, 50.0f, 0, false);
+    
+    // Just past the right edge, within the margin once scaled up
+    Entity edge = make_renderable(&world, 1030.0f, 50.0f, 1, true);
+    
+    ecs_store_previous_transforms(&world);
+    EcsRenderList* list = new EcsRenderList;
+    ecs_build_render_list(&world, 1.0f, 0.0f, 0.0f, 1000.0f, 1000.0f, 20.0f, list);
+    
+    EXPECT_EQ(list->count, 4u);
+    EXPECT_EQ(list->culled, 2u);
+    EXPECT_EQ(list->entity[0], in_view[1]);   // Layer 0
+    EXPECT_EQ(list->entity[1], in_view[3]);   // Layer 1
+    EXPECT_EQ(list->entity[2], std::min(in_view[0], in_view[2]));   // Layer 2, entity order
+    EXPECT_EQ(list->entity[3], std::max(in_view[0], in_view[2]));
+    EXPECT_EQ(list->layer_start[1], 1u);
+    EXPECT_EQ(list->layer_start[2], 2u);
+    EXPECT_EQ(list->layer_start[3], 4u);
+    EXPECT_EQ(list->layer_start[ECS_RENDER_LAYER_COUNT], 4u);
+    EXPECT_FLOAT_EQ(list->x[3], list->entity[3] == in_view[0] ? 0.0f : 200.0f);
+    
+    world.transforms.scale_x[edge] = 2.0f;
+    ecs_build_render_list(&world, 1.0f, 0.0f, 0.0f, 1000.0f, 1000.0f, 20.0f, list);
+    EXPECT_EQ(list->count, 5u);
+    EXPECT_EQ(list->layer_start[2], 3u);
+    EXPECT_EQ(list->entity[1], std::min(in_view[3], edge));
+    EXPECT_EQ(list->entity[2], std::max(in_view[3], edge));
+    
+    // Poses are blended between steps
+    ecs_set_position(&world, in_view[1], 100.0f, 250.0f);
+    ecs_set_rotation(&world, in_view[1], 90.0f);
+    ecs_build_render_list(&world, 0.5f, 0.0f, 0.0f, 1000.0f, 1000.0f, 20.0f, list);
+    EXPECT_FLOAT_EQ(list->x[0], 100.0f);
+    EXPECT_FLOAT_EQ(list->y[0], 150.0f);
+    EXPECT_FLOAT_EQ(list->rotation[0], 45.0f);
+    delete list;
+}
+
+// =============================================================================
+// Fixed Timestep Tests
+// =============================================================================
+
+static TimingState make_timing(double fixed_dt, uint32_t max_steps) {
+    TimingState timing;
+    memset(&timing, 0, sizeof(timing));
+    timing.fixed_delta_time = fixed_dt;
+    timing.max_fixed_steps = max_steps;
+    return timing;
+}
+
+TEST(TimingTests, StepsCoverFrameTimeAndLeaveAlpha) {
+    TimingState timing = make_timing(1.0 / 64.0, 5);
+    
+    // 40 ms frame: two 15.625 ms steps, 8.75 ms left over
+    engine_timing_accumulate(&timing, 0.040);
+    uint32_t steps = 0;
+    while (engine_timing_step_fixed(&timing)) steps++;
+    EXPECT_EQ(steps, 2u);
+    EXPECT_NEAR(engine_timing_alpha(&timing), 0.56, 1e-9);
+    
+    // The remainder carries into the next frame
+    engine_timing_accumulate(&timing, 0.010);
+    steps = 0;
+    while (engine_timing_step_fixed(&timing)) steps++;
+    EXPECT_EQ(steps, 1u);
+    EXPECT_EQ(timing.fixed_step_count, 3u);
+    EXPECT_EQ(timing.dropped_time, 0.0);
+}
+
+TEST(TimingTests, StepCapDropsBacklog) {
+    TimingState timing = make_timing(1.0 / 64.0, 4);
+    
+    // A 1 s hitch runs 4 steps, not 64, and keeps only the fraction of a step
+    engine_timing_accumulate(&timing, 1.0 + 0.5 / 64.0);
+    uint32_t steps = 0;
+    while (engine_timing_step_fixed(&timing)) steps++;
+    EXPECT_EQ(steps, 4u);
+    EXPECT_NEAR(engine_timing_alpha(&timing), 0.5, 1e-9);
+    EXPECT_NEAR(timing.dropped_time, 60.0 / 64.0, 1e-9);
+    
+    // The next normal frame is back to one step
+    engine_timing_accumulate(&timing, 1.0 / 64.0);
+    steps = 0;
+    while (engine_timing_step_fixed(&timing)) steps++;
+    EXPECT_EQ(steps, 1u);
+}
+
+TEST(TimingTests, TimeScaleTakesCoarseSteps) {
+    TimingState timing = make_timing(1.0 / 64.0, 5);
+    timing.time_scale = 100.0;
+    
+    // A 1/64 s frame at 100x holds 100 steps; coarse steps of 16 take 96 of them
+    engine_timing_accumulate(&timing, 1.0 / 64.0);
+    uint32_t updates = 0;
+    while (engine_timing_take_steps(&timing, 16, 0.0)) updates++;
+    EXPECT_EQ(updates, 6u);
+    EXPECT_EQ(timing.fixed_step_count, 96u);
+    EXPECT_EQ(timing.dropped_time, 0.0);
+    
+    // Alpha is measured in coarse steps: 4 of 16 left
+    EXPECT_NEAR(engine_timing_alpha(&timing), 0.25, 1e-9);
+}
+
+TEST(TimingTests, StepBudgetDropsBacklog) {
+    TimingState timing = make_timing(1.0 / 64.0, 5);
+    timing.time_scale = 1000.0;
+    timing.step_budget = 0.040;
+    
+    // The first step always runs; once the frame has spent its budget the
+    // rest of the warp backlog is dropped, keeping the fraction of a step
+    engine_timing_accumulate(&timing, 1.0 / 64.0 + 0.5 / 64000.0);
+    EXPECT_TRUE(engine_timing_take_steps(&timing, 8, 0.050));
+    EXPECT_TRUE(engine_timing_take_steps(&timing, 8, 0.020));
+    EXPECT_FALSE(engine_timing_take_steps(&timing, 8, 0.041));
+    EXPECT_EQ(timing.fixed_steps, 16u);
+    EXPECT_LT(timing.fixed_accumulator, 8.0 / 64.0);
+    EXPECT_NEAR(timing.dropped_time + timing.fixed_accumulator, (1000.0 - 16.0) / 64.0 + 0.5 / 64.0, 1e-9);
+}
+
+// The same 3 seconds of input gives the same ship whatever the frame rate
+TEST(TimingTests, ShipPhysicsIsFrameRateIndependent) {
+    static ECSWorld worlds[2];
+    static ShipEcsWorld ships[2];
+    const double frame_times[2] = {1.0 / 128.0, 1.0 / 32.0};
+    Entity entities[2];
+    
+    for (int w = 0; w < 2; w++) {
+        ecs_world_init(&worlds[w]);
+        ship_ecs_init(&ships[w]);
+        Entity e = ecs_create_entity(&worlds[w]);
+        ecs_add_component(&worlds[w], e, COMPONENT_TRANSFORM);
+        ecs_add_component(&worlds[w], e, COMPONENT_VELOCITY);
+        ecs_add_component(&worlds[w], e, COMPONENT_SHIP);
+        ShipEcsConfig config = ship_ecs_get_default_config();
+        ship_ecs_set_config(&ships[w], e, &config);
+        ship_ecs_set_throttle(&ships[w], e, 1.0f);
+        ship_ecs_set_rudder(&ships[w], e, 0.5f);
+        entities[w] = e;
+        
+        TimingState timing = make_timing(1.0 / 64.0, 5);
+        for (double t = 0.0; t < 3.0; t += frame_times[w]) {
+            engine_timing_accumulate(&timing, frame_times[w]);
+            while (engine_timing_step_fixed(&timing)) {
+                ship_ecs_system_physics(&worlds[w], &ships[w], (float)timing.fixed_delta_time);
+                ecs_system_movement(&worlds[w], (float)timing.fixed_delta_time);
+            }
+        }
+        EXPECT_EQ(timing.fixed_step_count, 192u);
+    }
+    
+    Entity a = entities[0], b = entities[1];
+    EXPECT_EQ(worlds[0].transforms.pos_x[a], worlds[1].transforms.pos_x[b]);
+    EXPECT_EQ(worlds[0].transforms.pos_y[a], worlds[1].transforms.pos_y[b]);
+    EXPECT_EQ(worlds[0].transforms.rotation[a], worlds[1].transforms.rotation[b]);
+    EXPECT_GT(worlds[0].velocities.speed[a], 10.0f);
+}
+
+// =============================================================================
+// Spatial Grid Tests
+// =============================================================================
+
+// Deterministic point cloud for grid tests (LCG, no libc rand state)
+static void make_point_cloud(std::vector<float>& xs, std::vector<float>& ys,
+                             uint32_t count, float extent, uint32_t seed) {
+    xs.resize(count);
+    ys.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        xs[i] = (float)(seed >> 8) / 16777216.0f * extent;
+        seed = seed * 1664525u + 1013904223u;
+        ys[i] = (float)(seed >> 8) / 16777216.0f * extent;
+    }
+}
+
+TEST(SpatialGridTests, EmptyGrid) {
+    SpatialGrid grid;
+    spatial_grid_init(&grid);
+    
+    EXPECT_TRUE(spatial_grid_build(&grid, nullptr, nullptr, 0, 10.0f));
+    EXPECT_EQ(spatial_grid_count(&grid), 0u);
+    
+    uint32_t out[4];
+    EXPECT_EQ(spatial_grid_query_rect(&grid, -100.0f, -100.0f, 100.0f, 100.0f, out, 4), 0u);
+    
+    spatial_grid_shutdown(&grid);
+}
+
+TEST(SpatialGridTests, QueryMatchesBruteForce) {
+    std::vector<float> xs, ys;
+    make_point_cloud(xs, ys, 2000, 5000.0f, 1234u);
+    
+    SpatialGrid grid;
+    spatial_grid_init(&grid);
+    ASSERT_TRUE(spatial_grid_build(&grid, xs.data(), ys.data(), (uint32_t)xs.size(), 100.0f));
+    EXPECT_EQ(spatial_grid_count(&grid), 2000u);
+    
+    std::vector<uint32_t> candidates(xs.size());
+    for (int q = 0; q < 50; q++) {
+        float cx = (float)(q * 97 % 5000);
+        float cy = (float)(q * 61 % 5000);
+        float r = 150.0f;
+        
+        uint32_t n = spatial_grid_query_rect(&grid, cx - r, cy - r, cx + r, cy + r,
+                                             candidates.data(), (uint32_t)candidates.size());
+        std::vector<bool> is_candidate(xs.size(), false);
+        for (uint32_t i = 0; i < n; i++) is_candidate[candidates[i]] = true;
+        
+        // Every point inside the rectangle must be among the candidates
+        for (size_t i = 0; i < xs.size(); i++) {
+            bool inside = xs[i] >= cx - r && xs[i] <= cx + r && ys[i] >= cy - r && ys[i] <= cy + r;
+            if (inside) {
+                EXPECT_TRUE(is_candidate[i]) << "point " << i << " missed by query " << q;
+            }
+        }
+        // And the grid must prune most of the set
+        EXPECT_LT(n, 200u);
+    }
+    
+    spatial_grid_shutdown(&grid);
+}
+
+TEST(SpatialGridTests, SparseDataGrowsCellSize) {
+    // Two points very far apart must not allocate a huge cell array
+    float xs[2] = {0.0f, 1.0e7f};
+    float ys[2] = {0.0f, 1.0e7f};
+    
+    SpatialGrid grid;
+    spatial_grid_init(&grid);
+    ASSERT_TRUE(spatial_grid_build(&grid, xs, ys, 2, 1.0f));
+    EXPECT_LE(grid.cell_count, (uint32_t)SPATIAL_GRID_MIN_CELLS);
+    
+    uint32_t out[2];
+    EXPECT_EQ(spatial_grid_query_rect(&grid, 1.0e7f - 1.0f, 1.0e7f - 1.0f, 1.0e7f + 1.0f, 1.0e7f + 1.0f, out, 2), 1u);
+    EXPECT_EQ(out[0], 1u);
+    
+    spatial_grid_shutdown(&grid);
+}
+
+// Benchmark: proximity checks for M ships against N = 10,000 POI-like points.
+// Prints timings; asserts only that both paths agree.
+TEST(SpatialGridTests, DISABLED_Benchmark10kPoints) {
+    const uint32_t point_count = 10000;
+    const uint32_t ship_count = 256;
+    const float radius = 50.0f;
+    
+    std::vector<float> xs, ys, ship_x, ship_y;
+    make_point_cloud(xs, ys, point_count, 40000.0f, 42u);
+    make_point_cloud(ship_x, ship_y, ship_count, 40000.0f, 7u);
+    
+    SpatialGrid grid;
+    spatial_grid_init(&grid);
+    
+    auto t0 = std::chrono::high_resolution_clock::now();
+    ASSERT_TRUE(spatial_grid_build(&grid, xs.data(), ys.data(), point_count, radius * 2.0f));
+    auto t1 = std::chrono::high_resolution_clock::now();
+    
+    // Brute force O(M x N)
+    uint32_t brute_hits = 0;
+    for (uint32_t s = 0; s < ship_count; s++) {
+        for (uint32_t i = 0; i < point_count; i++) {
+            float dx = xs[i] - ship_x[s];
+            float dy = ys[i] - ship_y[s];
+            if (dx * dx + dy * dy <= radius * radius) brute_hits++;
+        }
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    
+    // Grid O(M x k)
+    uint32_t grid_hits = 0;
+    for (uint32_t s = 0; s < ship_count; s++) {
+        SpatialGridSpan span;
+        if (!spatial_grid_get_span(&grid, ship_x[s] - radius, ship_y[s] - radius,
+                                   ship_x[s] + radius, ship_y[s] + radius, &span)) continue;
+        for (int32_t cy = span.min_cy; cy <= span.max_cy; cy++) {
+            for (int32_t cx = span.min_cx; cx <= span.max_cx; cx++) {
+                uint32_t n;
+                const uint32_t* items = spatial_grid_cell_items(&grid, cx, cy, &n);
+                for (uint32_t k = 0; k < n; k++) {
+                    float dx = xs[items[k]] - ship_x[s];
+                    float dy = ys[items[k]] - ship_y[s];
+                    if (dx * dx + dy * dy <= radius * radius) grid_hits++;
+                }
+            }
+        }
+    }
+    auto t3 = std::chrono::high_resolution_clock::now();
+    
+    EXPECT_EQ(grid_hits, brute_hits);
+    
+    auto us = [](auto a, auto b) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(b - a).count();
+    };
+    std::cout << "Grid build (" << point_count << " points): " << us(t0, t1) << " us" << std::endl;
+    std::cout << "Brute force (" << ship_count << " ships): " << us(t1, t2) << " us" << std::endl;
+    std::cout << "Grid query  (" << ship_count << " ships): " << us(t2, t3) << " us" << std::endl;
+    EXPECT_LT(us(t2, t3) * 10, us(t1, t2));
+    
+    spatial_grid_shutdown(&grid);
+}
+
+// =============================================================================
+// Collision Tests
+// =============================================================================
+
+// Bodies with the player ship's hull (bow 48, stern 20.8, half beam 12)
+struct TestBodies {
+    std::vector<float> x, y, rotation, vx, vy, speed, bow, stern, beam, inv_mass;
+    std::vector<uint8_t> layer, mask;
+    
+    uint32_t add(float px, float py, float heading, float body_speed) {
+        float rad = heading * DEG2RAD;
+        x.push_back(px);
+        y.push_back(py);
+        rotation.push_back(heading);
+        vx.push_back(sinf(rad) * body_speed);
+        vy.push_back(-cosf(rad) * body_speed);
+        speed.push_back(body_speed);
+        bow.push_back(48.0f);
+        stern.push_back(20.78f);
+        beam.push_back(12.0f);
+        inv_mass.push_back(1.0f);
+        layer.push_back(1);
+        mask.push_back(1);
+        return (uint32_t)x.size() - 1;
+    }
+    
+    CollisionBodies view() {
+        CollisionBodies b;
+        b.pos_x = x.data(); b.pos_y = y.data(); b.rotation = rotation.data();
+        b.vel_x = vx.data(); b.vel_y = vy.data(); b.speed = speed.data();
+        b.hull_bow = bow.data(); b.hull_stern = stern.data();
+        b.hull_half_beam = beam.data(); b.inv_mass = inv_mass.data();
+        b.layer = layer.data(); b.mask = mask.data();
+        b.masks = NULL; b.required = 0;
+        b.count = (uint32_t)x.size();
+        return b;
+    }
+};
+
+TEST(CollisionTests, SideSwipingShipsBounceApart) {
+    CollisionWorld world;
+    ASSERT_TRUE(collision_world_init(&world, 16));
+    EventRingReader reader;
+    event_ring_reader_init(&world.events, &reader);
+    
+    // Both heading north 20 apart (hulls 24 wide), sliding into each other
+    // at 30 units/s each
+    TestBodies t;
+    t.add(0.0f, 0.0f, 0.0f, 0.0f);
+    t.add(20.0f, 0.0f, 0.0f, 0.0f);
+    t.vx[0] = 30.0f;
+    t.vx[1] = -30.0f;
+    CollisionBodies bodies = t.view();
+    
+    // The normal is a side's: it leans atan(12 / 68.78) off abeam
+    ASSERT_EQ(collision_detect(&world, &bodies, NULL), 1u);
+    const CollisionContact& c = world.contacts[0];
+    EXPECT_EQ(c.a, 0u);
+    EXPECT_EQ(c.b, 1u);
+    EXPECT_NEAR(c.normal_x, 0.985f, 0.005f);
+    EXPECT_GT(c.depth, 0.0f);
+    
+    collision_resolve(&world, &bodies);
+    EXPECT_LT(t.x[0], 0.0f);
+    EXPECT_GT(t.x[1], 20.0f);
+    EXPECT_LT(t.vx[0], 0.0f);               // Now drifting apart
+    EXPECT_GT(t.vx[1], 0.0f);
+    EXPECT_NEAR(t.speed[0], -t.vy[0], 1e-3f);  // Speed follows velocity along the heading
+    EXPECT_NEAR(world.contacts[0].impulse, 1.2f * 60.0f * c.normal_x / 2.0f, 0.01f);
+    
+    const CollisionContact* event = (const CollisionContact*)event_ring_next(&world.events, &reader);
+    ASSERT_NE(event, nullptr);
+    EXPECT_EQ(event->b, 1u);
+    collision_world_shutdown(&world);
+}
+
+TEST(CollisionTests, UsesHullNotBoundingCircle) {
+    CollisionWorld world;
+    ASSERT_TRUE(collision_world_init(&world, 16));
+    TestBodies t;
+    
+    // Abreast 30 apart: the circles overlap, the 24-wide hulls do not
+    t.add(0.0f, 0.0f, 0.0f, 0.0f);
+    t.add(30.0f, 0.0f, 0.0f, 0.0f);
+    CollisionBodies bodies = t.view();
+    EXPECT_EQ(collision_detect(&world, &bodies, NULL), 0u);
+    EXPECT_EQ(world.pairs_tested, 1u);
+    
+    // Closer, they touch; other layers never do
+    t.x[1] = 20.0f;
+    bodies = t.view();
+    EXPECT_EQ(collision_detect(&world, &bodies, NULL), 1u);
+    EXPECT_NEAR(std::fabs(world.contacts[0].normal_x), 0.985f, 0.005f);
+    t.mask[1] = 2;
+    bodies = t.view();
+    EXPECT_EQ(collision_detect(&world, &bodies, NULL), 0u);
+    collision_world_shutdown(&world);
+}
+
+// Crowded harbour: ships on a jittered 60-unit lattice with random headings
+static void make_harbour(TestBodies& t, uint32_t count, uint32_t seed) {
+    uint32_t side = (uint32_t)std::ceil(std::sqrt((double)count));
+    for (uint32_t i = 0; i < count; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        float jx = (float)(seed >> 8) / 16777216.0f * 20.0f;
+        seed = seed * 1664525u + 1013904223u;
+        float jy = (float)(seed >> 8) / 16777216.0f * 20.0f;
+        seed = seed * 1664525u + 1013904223u;
+        float heading = (float)(seed >> 8) / 16777216.0f * 360.0f;
+        t.add((float)(i % side) * 60.0f + jx, (float)(i / side) * 60.0f + jy, heading, 10.0f);
+    }
+}
+
+TEST(CollisionTests, ContactsDoNotDependOnThreads) {
+    TestBodies t;
+    make_harbour(t, 3000, 11);
+    CollisionBodies bodies = t.view();
+    
+    CollisionWorld inline_world, jobs_world;
+    ASSERT_TRUE(collision_world_init(&inline_world, 16));
+    ASSERT_TRUE(collision_world_init(&jobs_world, 16));
+    JobSystem jobs;
+    jobs_init(&jobs, 3);
+    
+    uint32_t n = collision_detect(&inline_world, &bodies, NULL);
+    ASSERT_EQ(collision_detect(&jobs_world, &bodies, &jobs), n);
+    EXPECT_GT(n, 100u);
+    for (uint32_t i = 0; i < n; i++) {
+        ASSERT_EQ(inline_world.contacts[i].a, jobs_world.contacts[i].a) << i;
+        ASSERT_EQ(inline_world.contacts[i].b, jobs_world.contacts[i].b) << i;
+        ASSERT_EQ(inline_world.contacts[i].depth, jobs_world.contacts[i].depth) << i;
+    }
+    
+    // Every touching pair is found: compare with all pairs through the
+    // same test on two-body batches
+    uint32_t brute = 0;
+    CollisionWorld pair_world;
+    ASSERT_TRUE(collision_world_init(&pair_world, 16));
+    for (uint32_t i = 0; i < 400; i++) {
+        for (uint32_t j = i + 1; j < 400; j++) {
+            TestBodies pair;
+            pair.add(t.x[i], t.y[i], t.rotation[i], 0.0f);
+            pair.add(t.x[j], t.y[j], t.rotation[j], 0.0f);
+            CollisionBodies pb = pair.view();
+            brute += collision_detect(&pair_world, &pb, NULL);
+        }
+    }
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (inline_world.contacts[i].b < 400) found++;
+    }
+    EXPECT_EQ(found, brute);
+    
+    jobs_shutdown(&jobs);
+    collision_world_shutdown(&pair_world);
+    collision_world_shutdown(&inline_world);
+    collision_world_shutdown(&jobs_world);
+}
+
+TEST(CollisionTests, DISABLED_Benchmark5000ShipHarbour) {
+    TestBodies t;
+    make_harbour(t, 5000, 3);
+    CollisionWorld world;
+    ASSERT_TRUE(collision_world_init(&world, 1024));
+    
+    // Warm up (first update sizes the arrays), then time detect + resolve
+    CollisionBodies bodies = t.view();
+    collision_detect(&world, &bodies, NULL);
+    const int iterations = 50;
+    uint64_t contacts = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        bodies = t.view();
+        contacts += collision_detect(&world, &bodies, NULL);
+        collision_resolve(&world, &bodies);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    
+    std::cout << "[Benchmark] collision, 5000 ships: " << us << " us/step, "
+              << contacts / iterations << " contacts, " << world.pairs_tested << " pairs tested"
+              << std::endl;
+    EXPECT_GT(contacts, 0u);
+    EXPECT_LT(world.pairs_tested, 5000u * 4999u / 2u / 100u);   // The grid skips 99% of pairs
+    EXPECT_LT(us, 50000.0);
+    collision_world_shutdown(&world);
+}
+
+// =============================================================================
+// Segment BVH Tests
+// =============================================================================
+
+// Random segments and rings for BVH tests
+struct TestSegments {
+    std::vector<float> x0, y0, x1, y1;
+    
+    void add(float ax, float ay, float bx, float by) {
+        x0.push_back(ax); y0.push_back(ay);
+        x1.push_back(bx); y1.push_back(by);
+    }
+    
+    // Closed ring of n points round (cx, cy)
+    void add_ring(float cx, float cy, float r, int n) {
+        for (int k = 0; k < n; k++) {
+            float a0 = 2.0f * PI * k / n, a1 = 2.0f * PI * (k + 1) / n;
+            add(cx + r * cosf(a0), cy + r * sinf(a0), cx + r * cosf(a1), cy + r * sinf(a1));
+        }
+    }
+    
+    bool build(SegmentBvh* bvh) {
+        return segment_bvh_build(bvh, x0.data(), y0.data(), x1.data(), y1.data(), NULL,
+                                 (uint32_t)x0.size());
+    }
+};
+
+static float test_random(uint32_t& seed) {
+    seed = seed * 1664525u + 1013904223u;
+    return (float)(seed >> 8) / 16777216.0f;
+}
+
+// Nearest t in [0, 1] where o + t * d meets any segment (2 = none)
+static float brute_raycast(const TestSegments& s, float ox, float oy, float dx, float dy) {
+    float best = 2.0f;
+    for (size_t i = 0; i < s.x0.size(); i++) {
+        float ex = s.x1[i] - s.x0[i], ey = s.y1[i] - s.y0[i];
+        float denom = dx * ey - dy * ex;
+        if (denom == 0.0f) continue;
+        float wx = s.x0[i] - ox, wy = s.y0[i] - oy;
+        float t = (wx * ey - wy * ex) / denom;
+        float u = (wx * dy - wy * dx) / denom;
+        if (t >= 0.0f && t <= 1.0f && u >= 0.0f && u <= 1.0f && t < best) best = t;
+    }
+    return best;
+}
+
+TEST(SegmentBvhTests, RaycastMatchesBruteForce) {
+    TestSegments s;
+    uint32_t seed = 5;
+    for (int i = 0; i < 2000; i++) {
+        float x = test_random(seed) * 4000.0f, y = test_random(seed) * 4000.0f;
+        s.add(x, y, x + (test_random(seed) - 0.5f) * 200.0f, y + (test_random(seed) - 0.5f) * 200.0f);
+    }
+    SegmentBvh bvh;
+    segment_bvh_init(&bvh);
+    ASSERT_TRUE(s.build(&bvh));
+    EXPECT_EQ(bvh.segment_count, 2000u);
+    EXPECT_LE(bvh.depth, 10u);  // Median splits: log2(2000 / 4) levels
+    
+    int hits = 0;
+    for (int i = 0; i < 500; i++) {
+        float ox = test_random(seed) * 4000.0f, oy = test_random(seed) * 4000.0f;
+        float dx = (test_random(seed) - 0.5f) * 1500.0f, dy = (test_random(seed) - 0.5f) * 1500.0f;
+        SegmentBvhHit hit;
+        bool found = segment_bvh_raycast(&bvh, ox, oy, dx, dy, 1.0f, &hit);
+        float expected = brute_raycast(s, ox, oy, dx, dy);
+        ASSERT_EQ(found, expected <= 1.0f) << "ray " << i;
+        if (!found) continue;
+        hits++;
+        EXPECT_NEAR(hit.t, expected, 1e-5f) << "ray " << i;
+        EXPECT_LE(hit.normal_x * dx + hit.normal_y * dy, 0.0f);  // Faces the ray origin
+    }
+    EXPECT_GT(hits, 100);
+    segment_bvh_shutdown(&bvh);
+}
+
+TEST(SegmentBvhTests, SquareQueries) {
+    TestSegments s;
+    s.add(0.0f, 0.0f, 100.0f, 0.0f);
+    s.add(100.0f, 0.0f, 100.0f, 100.0f);
+    s.add(100.0f, 100.0f, 0.0f, 100.0f);
+    s.add(0.0f, 100.0f, 0.0f, 0.0f);
+    SegmentBvh bvh;
+    segment_bvh_init(&bvh);
+    ASSERT_TRUE(s.build(&bvh));
+    
+    EXPECT_TRUE(segment_bvh_point_inside(&bvh, 50.0f, 50.0f));
+    EXPECT_TRUE(segment_bvh_point_inside(&bvh, 50.0f, 0.0f));   // Vertex row is counted once
+    EXPECT_FALSE(segment_bvh_point_inside(&bvh, 150.0f, 50.0f));
+    EXPECT_FALSE(segment_bvh_point_inside(&bvh, -50.0f, 0.0f));
+    
+    SegmentBvhHit hit;
+    ASSERT_TRUE(segment_bvh_circle(&bvh, 110.0f, 40.0f, 15.0f, &hit));
+    EXPECT_NEAR(hit.t, 10.0f, 1e-4f);
+    EXPECT_NEAR(hit.x, 100.0f, 1e-4f);
+    EXPECT_NEAR(hit.y, 40.0f, 1e-4f);
+    EXPECT_NEAR(hit.normal_x, 1.0f, 1e-5f);                   // Towards the centre
+    EXPECT_EQ(bvh.tag[hit.segment], 1u);
+    EXPECT_FALSE(segment_bvh_circle(&bvh, 110.0f, 40.0f, 9.0f, &hit));
+    EXPECT_EQ(hit.segment, SEGMENT_BVH_NO_HIT);
+    
+    EXPECT_EQ(segment_bvh_crossings(&bvh, -10.0f, 50.0f, 110.0f, 50.0f, 8), 2u);
+    EXPECT_EQ(segment_bvh_crossings(&bvh, -10.0f, 50.0f, 110.0f, 50.0f, 1), 1u);
+    EXPECT_EQ(segment_bvh_crossings(&bvh, 20.0f, 20.0f, 80.0f, 80.0f, 8), 0u);
+    
+    // An empty BVH answers every query with a miss
+    SegmentBvh empty;
+    segment_bvh_init(&empty);
+    EXPECT_FALSE(segment_bvh_raycast(&empty, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, &hit));
+    EXPECT_FALSE(segment_bvh_point_inside(&empty, 0.0f, 0.0f));
+    EXPECT_EQ(segment_bvh_crossings(&empty, 0.0f, 0.0f, 1.0f, 0.0f, 8), 0u);
+    segment_bvh_shutdown(&bvh);
+}
+
+TEST(SegmentBvhTests, BatchAndFanMatchSingleQueries) {
+    // Dense rings so the fan overflows its shared segment list in places
+    TestSegments s;
+    uint32_t seed = 9;
+    for (int i = 0; i < 60; i++) {
+        s.add_ring(test_random(seed) * 3000.0f, test_random(seed) * 3000.0f,
+                   20.0f + test_random(seed) * 80.0f, 24);
+    }
+    SegmentBvh bvh;
+    segment_bvh_init(&bvh);
+    ASSERT_TRUE(s.build(&bvh));
+    
+    const uint32_t count = 600;
+    std::vector<float> x(count), y(count), dx(count), dy(count), radius(count);
+    for (uint32_t i = 0; i < count; i++) {
+        x[i] = test_random(seed) * 3000.0f;
+        y[i] = test_random(seed) * 3000.0f;
+        dx[i] = (test_random(seed) - 0.5f) * 600.0f;
+        dy[i] = (test_random(seed) - 0.5f) * 600.0f;
+        radius[i] = 10.0f + test_random(seed) * 60.0f;
+    }
+    
+    std::vector<SegmentBvhHit> hits(count);
+    segment_bvh_raycast_batch(&bvh, x.data(), y.data(), dx.data(), dy.data(), 1.0f, count, hits.data());
+    for (uint32_t i = 0; i < count; i++) {
+        SegmentBvhHit single;
+        segment_bvh_raycast(&bvh, x[i], y[i], dx[i], dy[i], 1.0f, &single);
+        ASSERT_EQ(hits[i].segment, single.segment) << "ray " << i;
+    }
+    segment_bvh_circle_batch(&bvh, x.data(), y.data(), radius.data(), count, hits.data());
+    for (uint32_t i = 0; i < count; i++) {
+        SegmentBvhHit single;
+        segment_bvh_circle(&bvh, x[i], y[i], radius[i], &single);
+        ASSERT_EQ(hits[i].segment, single.segment) << "circle " << i;
+    }
+    
+    // Fans from a sparse corner and from the middle of the field
+    const float eyes[2][2] = { { -200.0f, -200.0f }, { 1500.0f, 1500.0f } };
+    std::vector<uint8_t> fan(count);
+    for (const auto& eye : eyes) {
+        segment_bvh_fan_crossings(&bvh, eye[0], eye[1], x.data(), y.data(), count, 2, fan.data());
+        for (uint32_t i = 0; i < count; i++) {
+            ASSERT_EQ(fan[i], segment_bvh_crossings(&bvh, eye[0], eye[1], x[i], y[i], 2)) << "target " << i;
+        }
+    }
+    segment_bvh_shutdown(&bvh);
+}
+
+TEST(SegmentBvhTests, DISABLED_BenchmarkFleetQueries) {
+    // An archipelago of 40 islands, 64 edges each
+    TestSegments s;
+    uint32_t seed = 21;
+    for (int i = 0; i < 40; i++) {
+        s.add_ring(test_random(seed) * 8000.0f, test_random(seed) * 8000.0f,
+                   60.0f + test_random(seed) * 140.0f, 64);
+    }
+    SegmentBvh bvh;
+    segment_bvh_init(&bvh);
+    ASSERT_TRUE(s.build(&bvh));
+    
+    // A full fleet: lookahead rays, hull circles and point tests per tick
+    const uint32_t count = MAX_ENTITIES;
+    std::vector<float> x(count), y(count), dx(count), dy(count), radius(count, 37.0f);
+    for (uint32_t i = 0; i < count; i++) {
+        x[i] = test_random(seed) * 8000.0f;
+        y[i] = test_random(seed) * 8000.0f;
+        float heading = test_random(seed) * 2.0f * PI;
+        dx[i] = sinf(heading) * 1300.0f;
+        dy[i] = -cosf(heading) * 1300.0f;
+    }
+    std::vector<SegmentBvhHit> hits(count);
+    
+    const int iterations = 50;
+    uint32_t ray_hits = 0, circle_hits = 0, inside = 0;
+    uint64_t brute_ray_hits = 0;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        ray_hits = segment_bvh_raycast_batch(&bvh, x.data(), y.data(), dx.data(), dy.data(), 1.0f, count, hits.data());
+        circle_hits = segment_bvh_circle_batch(&bvh, x.data(), y.data(), radius.data(), count, hits.data());
+        inside = 0;
+        for (uint32_t i = 0; i < count; i++) inside += segment_bvh_point_inside(&bvh, x[i], y[i]);
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < count; i++) {
+        brute_ray_hits += brute_raycast(s, x[i], y[i], dx[i], dy[i]) <= 1.0f;
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    
+    EXPECT_EQ(ray_hits, brute_ray_hits);
+    EXPECT_GT(circle_hits, 0u);
+    double bvh_us = std::chrono::duration<double, std::micro>(t1 - t0).count() / iterations;
+    double brute_us = std::chrono::duration<double, std::micro>(t2 - t1).count();
+    std::cout << "[Benchmark] segment BVH, " << bvh.segment_count << " edges, " << count
+              << " ships: " << bvh_us << " us/tick (rays + circles + points), brute-force rays "
+              << brute_us << " us; " << ray_hits << " ray hits, " << circle_hits
+              << " circle hits, " << inside << " inland" << std::endl;
+    EXPECT_LT(bvh_us * 5.0, brute_us);
+    segment_bvh_shutdown(&bvh);
+}
+
+// =============================================================================
+// Render Queue Tests
+// =============================================================================
+
+// Command i of stream s tagged with its submission position
+static Color tag_color(uint32_t stream, uint32_t i) {
+    return (Color){(unsigned char)stream, (unsigned char)(i & 0xFF), (unsigned char)(i >> 8), 255};
+}
+
+TEST(RenderQueueTests, SortsByLayerMaterialAndDepth) {
+    RenderQueue* queue = new RenderQueue;
+    render_queue_init(queue);
+    render_queue_begin(queue);
+    RenderStream* a = render_queue_stream(queue, 0);
+    RenderStream* b = render_queue_stream(queue, 1);
+    EXPECT_EQ(render_queue_stream(queue, RENDER_QUEUE_MAX_STREAMS), nullptr);
+    
+    render_queue_text(a, 5, 0.0f, "label", 0.0f, 0.0f, 10, WHITE);        // 0: layer 5, text
+    render_queue_quad(a, 5, 2.0f, 0.0f, 0.0f, 1.0f, 1.0f, WHITE);         // 1: layer 5, shapes, depth 2
+    render_queue_quad(a, 1, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, WHITE);         // 2: layer 1
+    render_queue_circle(b, 5, -1.0f, 0.0f, 0.0f, 1.0f, 8, WHITE);         // b0: layer 5, depth -1
+    render_queue_quad(a, 5, 2.0f, 0.0f, 0.0f, 1.0f, 1.0f, WHITE);         // 3: ties with 1
+    render_queue_quad(b, 5, 2.0f, 0.0f, 0.0f, 1.0f, 1.0f, WHITE);         // b1: ties, later stream
+    
+    const uint32_t* order;
+    ASSERT_EQ(render_queue_sort(queue, &order), 6u);
+    const uint32_t expected[6] = {
+        2u, (1u << 24) | 0u, 1u, 3u, (1u << 24) | 1u, 0u
+    };
+    for (int i = 0; i < 6; i++) EXPECT_EQ(order[i], expected[i]) << "position " << i;
+    
+    // Depth sorts as a float, negatives included
+    EXPECT_LT(render_key_make(0, 0, -5.0f), render_key_make(0, 0, -1.0f));
+    EXPECT_LT(render_key_make(0, 0, -1.0f), render_key_make(0, 0, 0.5f));
+    EXPECT_LT(render_key_make(0, 0xFFFF, 1e9f), render_key_make(1, 0, -1e9f));
+    
+    // Three runs: layer 1 shapes, layer 5 shapes, layer 5 text
+    render_queue_submit(queue);
+    EXPECT_EQ(queue->stats.commands, 6u);
+    EXPECT_EQ(queue->stats.runs, 3u);
+    
+    render_queue_shutdown(queue);
+    delete queue;
+}
+
+struct QueueFillJob {
+    RenderQueue* queue;
+    uint32_t per_stream;
+};
+
+// Stream index writes its own commands with pseudo-random layers and depths
+static void fill_stream_job(void* data, uint32_t index) {
+    QueueFillJob* job = (QueueFillJob*)data;
+    RenderStream* stream = render_queue_stream(job->queue, index);
+    uint32_t seed = 12345u + index * 7919u;
+    for (uint32_t i = 0; i < job->per_stream; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        uint8_t layer = (uint8_t)((seed >> 24) % 6);
+        float depth = (float)((seed >> 8) % 100) - 50.0f;
+        render_queue_quad(stream, layer, depth, 0.0f, 0.0f, 1.0f, 1.0f, tag_color(index, i));
+    }
+}
+
+TEST(RenderQueueTests, ParallelStreamsSortLikeStableSort) {
+    RenderQueue* queue = new RenderQueue;
+    render_queue_init(queue);
+    JobSystem jobs;
+    ASSERT_TRUE(jobs_init(&jobs, 3));
+    
+    const uint32_t streams = 8;
+    QueueFillJob job = {queue, 5000};
+    for (int frame = 0; frame < 2; frame++) {
+        render_queue_begin(queue);
+        jobs_parallel_for(&jobs, streams, fill_stream_job, &job);
+        
+        // Reference: every key in stream order, stable-sorted
+        std::vector<std::pair<uint64_t, uint32_t>> reference;
+        for (uint32_t s = 0; s < streams; s++) {
+            const RenderStream* stream = render_queue_stream(queue, s);
+            for (uint32_t i = 0; i < stream->count; i++) reference.push_back({stream->keys[i], (s << 24) | i});
+        }
+        std::stable_sort(reference.begin(), reference.end(),
+                         [](const std::pair<uint64_t, uint32_t>& x, const std::pair<uint64_t, uint32_t>& y) {
+                             return x.first < y.first;
+                         });
+        
+        const uint32_t* order;
+        ASSERT_EQ(render_queue_sort(queue, &order), streams * job.per_stream);
+        for (size_t i = 0; i < reference.size(); i++) {
+            ASSERT_EQ(order[i], reference[i].second) << "position " << i;
+        }
+    }
+    
+    jobs_shutdown(&jobs);
+    render_queue_shutdown(queue);
+    delete queue;
+}
+
+TEST(RenderQueueTests, DISABLED_BenchmarkSortAndBatch) {
+    RenderQueue* queue = new RenderQueue;
+    render_queue_init(queue);
+    QueueFillJob job = {queue, 25000};
+    
+    const int frames = 20;
+    double sort_ms = 0.0, total_ms = 0.0;
+    for (int frame = 0; frame < frames; frame++) {
+        render_queue_begin(queue);
+        for (uint32_t s = 0; s < 4; s++) fill_stream_job(&job, s);
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        render_queue_sort(queue, NULL);
+        auto sorted = std::chrono::high_resolution_clock::now();
+        render_queue_submit(queue);
+        auto done = std::chrono::high_resolution_clock::now();
+        sort_ms += std::chrono::duration<double, std::milli>(sorted - start).count();
+        total_ms += std::chrono::duration<double, std::milli>(done - start).count();
+    }
+    
+    std::cout << "[Benchmark] render queue, " << queue->stats.commands << " quads: sort "
+              << sort_ms / frames << " ms, sort + batch " << total_ms / frames << " ms, "
+              << queue->stats.runs << " runs, " << queue->stats.sort_passes << " radix passes" << std::endl;
+    EXPECT_EQ(queue->stats.runs, 6u);    // One per layer
+    EXPECT_LT(total_ms / frames, 200.0);
+    
+    render_queue_shutdown(queue);
+    delete queue;
+}
+
+// =============================================================================
+// Layer Cache
+// =============================================================================
+
+static uint32_t layer_cache_dirty_in_view(const LayerCache* cache) {
+    uint32_t dirty = 0;
+    for (int32_t ty = cache->view_min_y; ty <= cache->view_max_y; ty++) {
+        for (int32_t tx = cache->view_min_x; tx <= cache->view_max_x; tx++) {
+            uint16_t slot = spatial_hash_find(&cache->slots, tx, ty);
+            EXPECT_NE(slot, SPATIAL_HASH_NOT_FOUND);
+            if (slot != SPATIAL_HASH_NOT_FOUND && cache->tiles[slot].dirty) dirty++;
+        }
+    }
+    return dirty;
+}
+
+// As layer_cache_update does once the tiles are drawn
+static void layer_cache_mark_drawn(LayerCache* cache) {
+    for (uint32_t i = 0; i < LAYER_CACHE_MAX_TILES; i++) cache->tiles[i].dirty = false;
+}
+
+TEST(LayerCacheTests, RedrawsOnlyExposedAndInvalidatedTiles) {
+    LayerCache* cache = new LayerCache();
+    ASSERT_TRUE(layer_cache_init(cache, BLUE, nullptr, nullptr));
+    const float tile = (float)LAYER_CACHE_TILE_PIXELS;
+
+    // A view just under two tiles square needs four
+    ASSERT_TRUE(layer_cache_plan(cache, Rectangle{0.0f, 0.0f, tile * 1.9f, tile * 1.4f}, 1.0f));
+    EXPECT_EQ(layer_cache_dirty_in_view(cache), 4u);
+    layer_cache_mark_drawn(cache);
+    ASSERT_TRUE(layer_cache_plan(cache, Rectangle{0.0f, 0.0f, tile * 1.9f, tile * 1.4f}, 1.0f));
+    EXPECT_EQ(layer_cache_dirty_in_view(cache), 0u);
+
+    // Panning right exposes one column
+    ASSERT_TRUE(layer_cache_plan(cache, Rectangle{tile * 0.5f, 0.0f, tile * 1.9f, tile * 1.4f}, 1.0f));
+    EXPECT_EQ(cache->view_max_x, 2);
+    EXPECT_EQ(layer_cache_dirty_in_view(cache), 2u);
+    layer_cache_mark_drawn(cache);
+
+    // A change inside one tile redraws just that tile
+    layer_cache_invalidate_rect(cache, tile * 1.2f, tile * 0.2f, tile * 1.3f, tile * 0.3f);
+    ASSERT_TRUE(layer_cache_plan(cache, Rectangle{tile * 0.5f, 0.0f, tile * 1.9f, tile * 1.4f}, 1.0f));
+    EXPECT_EQ(layer_cache_dirty_in_view(cache), 1u);
+    EXPECT_TRUE(cache->tiles[spatial_hash_find(&cache->slots, 1, 0)].dirty);
+    layer_cache_mark_drawn(cache);
+
+    // Far away, old tiles give up their slots once every slot is taken
+    for (int step = 0; step < 40; step++) {
+        ASSERT_TRUE(layer_cache_plan(cache, Rectangle{tile * (100.0f + step * 3.0f), 0.0f, tile * 1.9f, tile * 1.4f}, 1.0f));
+    }
+    EXPECT_FALSE(spatial_hash_contains(&cache->slots, 0, 0));
+    EXPECT_TRUE(spatial_hash_contains(&cache->slots, 217, 0));
+
+    // Zooming into the next level redraws everything at the new scale
+    layer_cache_mark_drawn(cache);
+    ASSERT_TRUE(layer_cache_plan(cache, Rectangle{0.0f, 0.0f, tile * 1.9f, tile * 1.4f}, 2.0f));
+    EXPECT_FLOAT_EQ(cache->tile_world_size, tile * 0.5f);
+    EXPECT_EQ(layer_cache_dirty_in_view(cache), 4u * 3u);
+
+    // Views needing more tiles than the cache holds are drawn directly
+    EXPECT_FALSE(layer_cache_plan(cache, Rectangle{0.0f, 0.0f, tile * 20.0f, tile * 20.0f}, 1.0f));
+
+    // No window, no render textures
+    EXPECT_FALSE(layer_cache_update(cache, Rectangle{0.0f, 0.0f, tile, tile}, 1.0f));
+
+    layer_cache_shutdown(cache);
+    delete cache;
+}
+
+TEST(LayerCacheTests, ZoomWithinALevelKeepsTiles) {
+    EXPECT_FLOAT_EQ(layer_cache_level(1.0f), 1.0f);
+    EXPECT_FLOAT_EQ(layer_cache_level(1.3f), 1.0f);
+    EXPECT_FLOAT_EQ(layer_cache_level(0.75f), 1.0f);
+    EXPECT_FLOAT_EQ(layer_cache_level(1.5f), 2.0f);
+    EXPECT_FLOAT_EQ(layer_cache_level(0.3f), 0.25f);
+
+    LayerCache* cache = new LayerCache();
+    ASSERT_TRUE(layer_cache_init(cache, BLUE, nullptr, nullptr));
+    const float tile = (float)LAYER_CACHE_TILE_PIXELS;
+
+    // An 800x600 window round the origin at the given zoom, as the camera sees it
+    auto view_at = [](float zoom) {
+        return Rectangle{-400.0f / zoom, -300.0f / zoom, 800.0f / zoom, 600.0f / zoom};
+    };
+    ASSERT_TRUE(layer_cache_plan(cache, view_at(1.0f), 1.0f));
+    EXPECT_GT(layer_cache_dirty_in_view(cache), 0u);
+    layer_cache_mark_drawn(cache);
+
+    // Keyboard zoom nudges the camera a little every frame: the tiles
+    // stretch and nothing is redrawn
+    for (float zoom = 1.0f; zoom < 1.4f; zoom += 0.02f) {
+        ASSERT_TRUE(layer_cache_plan(cache, view_at(zoom), zoom));
+        EXPECT_FLOAT_EQ(cache->scale, 1.0f);
+        EXPECT_EQ(layer_cache_dirty_in_view(cache), 0u) << "zoom " << zoom;
+    }
+
+    // Zooming out within the level only exposes tiles at the edges
+    ASSERT_TRUE(layer_cache_plan(cache, view_at(0.72f), 0.72f));
+    EXPECT_FLOAT_EQ(cache->tile_world_size, tile);
+    EXPECT_EQ(cache->view_min_x, -2);
+    EXPECT_EQ(cache->view_max_x, 1);
+    EXPECT_EQ(layer_cache_dirty_in_view(cache), 4u);    // Two new columns of two
+
+    layer_cache_shutdown(cache);
+    delete cache;
+}
+
+// =============================================================================
+// String Arena Tests
+// =============================================================================
+
+TEST(StringArenaTests, InternDeduplicates) {
+    StringArena arena;
+    ASSERT_TRUE(string_arena_init(&arena, 0));
+    
+    uint32_t a = string_arena_intern(&arena, "Vinga Lighthouse");
+    uint32_t b = string_arena_intern(&arena, "Nya Älvsborg");
+    uint32_t c = string_arena_intern(&arena, "Vinga Lighthouse");
+    
+    EXPECT_NE(a, STRING_ARENA_INVALID);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(a, c);
+    EXPECT_STREQ(string_arena_get(&arena, a), "Vinga Lighthouse");
+    EXPECT_STREQ(string_arena_get(&arena, b), "Nya Älvsborg");
+    EXPECT_EQ(arena.string_count, 2u);
+    
+    string_arena_shutdown(&arena);
+}
+
+TEST(StringArenaTests, EmptyAndNullMapToOffsetZero) {
+    StringArena arena;
+    ASSERT_TRUE(string_arena_init(&arena, 0));
+    
+    EXPECT_EQ(string_arena_intern(&arena, nullptr), STRING_ARENA_EMPTY);
+    EXPECT_EQ(string_arena_intern(&arena, ""), STRING_ARENA_EMPTY);
+    EXPECT_STREQ(string_arena_get(&arena, STRING_ARENA_EMPTY), "");
+    EXPECT_STREQ(string_arena_get(&arena, 1000000u), "");
+    
+    string_arena_shutdown(&arena);
+}
+
+TEST(StringArenaTests, OffsetsSurviveGrowth) {
+    StringArena arena;
+    ASSERT_TRUE(string_arena_init(&arena, 0));
+    
+    std::vector<uint32_t> offsets;
+    char buffer[32];
+    for (int i = 0; i < 2000; i++) {
+        snprintf(buffer, sizeof(buffer), "skerry_%d", i);
+        offsets.push_back(string_arena_intern(&arena, buffer));
+    }
+    for (int i = 0; i < 2000; i++) {
+        snprintf(buffer, sizeof(buffer), "skerry_%d", i);
+        EXPECT_STREQ(string_arena_get(&arena, offsets[i]), buffer);
+        EXPECT_EQ(string_arena_intern(&arena, buffer), offsets[i]);
+    }
+    
+    string_arena_clear(&arena);
+    EXPECT_EQ(string_arena_size(&arena), 1u);
+    EXPECT_EQ(arena.string_count, 0u);
+    
+    string_arena_shutdown(&arena);
+}
+
+// =============================================================================
+// String Index Tests
+// =============================================================================
+
+TEST(StringIndexTests, CaseInsensitiveLookup) {
+    StringArena arena;
+    StringIndex index;
+    ASSERT_TRUE(string_arena_init(&arena, 0));
+    ASSERT_TRUE(string_index_init(&index, 4));
+    
+    uint32_t key = string_arena_intern(&arena, "Vinga Lighthouse");
+    EXPECT_TRUE(string_index_insert(&index, &arena, key, 7u));
+    
+    EXPECT_EQ(string_index_find(&index, &arena, "vinga lighthouse"), 7u);
+    EXPECT_EQ(string_index_find(&index, &arena, "VINGA LIGHTHOUSE"), 7u);
+    EXPECT_EQ(string_index_find(&index, &arena, "Vinga"), STRING_INDEX_NOT_FOUND);
+    
+    // Equal keys (after folding) are rejected
+    uint32_t upper = string_arena_intern(&arena, "VINGA LIGHTHOUSE");
+    EXPECT_FALSE(string_index_insert(&index, &arena, upper, 8u));
+    EXPECT_EQ(string_index_count(&index), 1u);
+    
+    string_index_shutdown(&index);
+    string_arena_shutdown(&arena);
+}
+
+TEST(StringIndexTests, RemoveKeepsProbeChainsIntact) {
+    StringArena arena;
+    StringIndex index;
+    ASSERT_TRUE(string_arena_init(&arena, 0));
+    ASSERT_TRUE(string_index_init(&index, 8));
+    
+    std::map<std::string, uint32_t> reference;
+    char buffer[32];
+    for (uint32_t i = 0; i < 1000; i++) {
+        snprintf(buffer, sizeof(buffer), "poi_%u", i);
+        ASSERT_TRUE(string_index_insert(&index, &arena, string_arena_intern(&arena, buffer), i));
+        reference[buffer] = i;
+    }
+    
+    // Remove every third key, then verify everything else still resolves
+    for (uint32_t i = 0; i < 1000; i += 3) {
+        snprintf(buffer, sizeof(buffer), "poi_%u", i);
+        EXPECT_TRUE(string_index_remove(&index, &arena, buffer));
+        reference.erase(buffer);
+    }
+    EXPECT_EQ(string_index_count(&index), (uint32_t)reference.size());
+    
+    for (uint32_t i = 0; i < 1000; i++) {
+        snprintf(buffer, sizeof(buffer), "POI_%u", i);
+        auto it = reference.find(std::string("poi_") + std::to_string(i));
+        uint32_t expected = it == reference.end() ? STRING_INDEX_NOT_FOUND : it->second;
+        EXPECT_EQ(string_index_find(&index, &arena, buffer), expected);
+    }
+    
+    string_index_shutdown(&index);
+    string_arena_shutdown(&arena);
+}
+
+// =============================================================================
+// JSON Stream Tests
+// =============================================================================
+
+// Flatten tokens to strings such as "2:key:name" for easy comparison
+static bool collect_json_token(const JsonToken* token, void* user_data) {
+    auto* out = static_cast<std::vector<std::string>*>(user_data);
+    static const char* names[] = {"{", "}", "[", "]", "key", "str", "num", "true", "false", "null"};
+    std::string entry = std::to_string(token->depth) + ":" + names[token->type];
+    if (token->type == JSON_TOKEN_KEY || token->type == JSON_TOKEN_STRING) {
+        EXPECT_EQ(strlen(token->str), token->len);
+        entry += ":" + std::string(token->str, token->len);
+    } else if (token->type == JSON_TOKEN_NUMBER) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), ":%g", token->number);
+        entry += buffer;
+    }
+    out->push_back(entry);
+    return true;
+}
+
+// Parse text fed in chunks of chunk_size bytes
+static JsonStreamResult parse_json_chunked(const std::string& text, size_t chunk_size,
+                                           std::vector<std::string>* tokens) {
+    JsonStream stream;
+    EXPECT_TRUE(json_stream_init(&stream, collect_json_token, tokens));
+    for (size_t i = 0; i < text.size(); i += chunk_size) {
+        json_stream_feed(&stream, text.data() + i, std::min(chunk_size, text.size() - i));
+    }
+    JsonStreamResult result = json_stream_finish(&stream);
+    json_stream_shutdown(&stream);
+    return result;
+}
+
+TEST(JsonStreamTests, TokenSequence) {
+    std::vector<std::string> tokens;
+    const std::string text = R"({"name": "Vinga", "pos": {"x": -1.5e2, "y": 3}, "tags": [true, false, null]})";
+    ASSERT_EQ(parse_json_chunked(text, text.size(), &tokens), JSON_STREAM_OK);
+    
+    std::vector<std::string> expected = {
+        "0:{", "1:key:name", "1:str:Vinga",
+        "1:key:pos", "1:{", "2:key:x", "2:num:-150", "2:key:y", "2:num:3", "1:}",
+        "1:key:tags", "1:[", "2:true", "2:false", "2:null", "1:]",
+        "0:}"
+    };
+    EXPECT_EQ(tokens, expected);
+}
+
+TEST(JsonStreamTests, ChunkBoundariesDoNotMatter) {
+    const std::string text = "\xEF\xBB\xBF"
+        R"({"esc": "a\"b\\c\/d\n\u00e5\ud83d\ude00", "n": [0, -12.75, 1E3, 42], "deep": [[[{}]]], "t": true})";
+    std::vector<std::string> reference;
+    ASSERT_EQ(parse_json_chunked(text, text.size(), &reference), JSON_STREAM_OK);
+    EXPECT_EQ(reference[2], "1:str:a\"b\\c/d\n\xC3\xA5\xF0\x9F\x98\x80");
+    
+    for (size_t chunk : {1u, 2u, 3u, 7u, 16u}) {
+        std::vector<std::string> tokens;
+        EXPECT_EQ(parse_json_chunked(text, chunk, &tokens), JSON_STREAM_OK) << "chunk " << chunk;
+        EXPECT_EQ(tokens, reference) << "chunk " << chunk;
+    }
+}
+
+TEST(JsonStreamTests, RejectsMalformedInput) {
+    const char* syntax_errors[] = {
+        "{\"a\" 1}", "{\"a\": 1,}", "[1 2]", "{\"a\": tru}", "[\"\\x\"]", "{]", "[1]]",
+        "[\"\\ud800x\"]", "[\"\\udc00\"]", "[-]", "{1: 2}", "[1] [2]", "[\"a\nb\"]"
+    };
+    for (const char* text : syntax_errors) {
+        std::vector<std::string> tokens;
+        EXPECT_EQ(parse_json_chunked(text, 4, &tokens), JSON_STREAM_SYNTAX_ERROR) << text;
+    }
+    
+    std::vector<std::string> tokens;
+    EXPECT_EQ(parse_json_chunked("{\"a\": [1, 2", 4, &tokens), JSON_STREAM_INCOMPLETE);
+    EXPECT_EQ(parse_json_chunked("", 4, &tokens), JSON_STREAM_INCOMPLETE);
+    EXPECT_EQ(parse_json_chunked(std::string(JSON_STREAM_MAX_DEPTH + 1, '['), 8, &tokens),
+              JSON_STREAM_TOO_DEEP);
+}
+
+TEST(JsonStreamTests, CallbackCanAbort) {
+    JsonStream stream;
+    int seen = 0;
+    ASSERT_TRUE(json_stream_init(&stream, [](const JsonToken*, void* user_data) {
+        return ++*static_cast<int*>(user_data) < 3;
+    }, &seen));
+    
+    const char text[] = "[1, 2, 3, 4]";
+    EXPECT_EQ(json_stream_feed(&stream, text, sizeof(text) - 1), JSON_STREAM_ABORTED);
+    EXPECT_EQ(json_stream_finish(&stream), JSON_STREAM_ABORTED);
+    EXPECT_EQ(seen, 3);
+    json_stream_shutdown(&stream);
+}
+
+// =============================================================================
+// Bitset Tests
+// =============================================================================
+
+TEST(BitsetTests, SetTestAndIterate) {
+    Bitset set;
+    ASSERT_TRUE(bitset_init(&set, 200));
+    
+    const uint32_t bits[] = {0, 63, 64, 130, 199};
+    for (uint32_t bit : bits) bitset_set(&set, bit);
+    bitset_set(&set, 200);  // Out of range: ignored
+    
+    EXPECT_EQ(bitset_count(&set), 5u);
+    EXPECT_TRUE(bitset_test(&set, 64));
+    EXPECT_FALSE(bitset_test(&set, 65));
+    EXPECT_FALSE(bitset_test(&set, 200));
+    
+    std::vector<uint32_t> seen;
+    for (uint32_t i = bitset_next(&set, 0); i != BITSET_NONE; i = bitset_next(&set, i + 1)) {
+        seen.push_back(i);
+    }
+    EXPECT_EQ(seen, std::vector<uint32_t>(std::begin(bits), std::end(bits)));
+    
+    bitset_reset(&set, 63);
+    EXPECT_EQ(bitset_next(&set, 1), 64u);
+    bitset_clear_all(&set);
+    EXPECT_EQ(bitset_next(&set, 0), BITSET_NONE);
+    bitset_shutdown(&set);
+}
+
+TEST(BitsetTests, ResizeKeepsBitsAndClearsTail) {
+    Bitset set;
+    ASSERT_TRUE(bitset_init(&set, 10));
+    bitset_set(&set, 3);
+    bitset_set(&set, 9);
+    
+    ASSERT_TRUE(bitset_resize(&set, 1000));
+    EXPECT_TRUE(bitset_test(&set, 3));
+    EXPECT_TRUE(bitset_test(&set, 9));
+    EXPECT_EQ(bitset_count(&set), 2u);
+    
+    // Shrinking drops bits past the end; growing again does not revive them
+    ASSERT_TRUE(bitset_resize(&set, 5));
+    ASSERT_TRUE(bitset_resize(&set, 1000));
+    EXPECT_TRUE(bitset_test(&set, 3));
+    EXPECT_FALSE(bitset_test(&set, 9));
+    bitset_shutdown(&set);
+}
+
+// =============================================================================
+// Event Ring Tests
+// =============================================================================
+
+TEST(EventRingTests, ReadersAreIndependent) {
+    EventRing ring;
+    ASSERT_TRUE(event_ring_init(&ring, sizeof(int), 5));
+    EXPECT_EQ(ring.capacity, 8u);
+    
+    EventRingReader early;
+    event_ring_reader_init(&ring, &early);
+    int first = 1;
+    event_ring_push(&ring, &first);
+    
+    // A reader started later only sees newer events
+    EventRingReader late;
+    event_ring_reader_init(&ring, &late);
+    for (int v = 2; v <= 3; v++) event_ring_push(&ring, &v);
+    
+    EXPECT_EQ(event_ring_pending(&ring, &early), 3u);
+    EXPECT_EQ(event_ring_pending(&ring, &late), 2u);
+    
+    const int* e;
+    int sum = 0;
+    while ((e = (const int*)event_ring_next(&ring, &early)) != NULL) sum += *e;
+    EXPECT_EQ(sum, 6);
+    EXPECT_EQ(*(const int*)event_ring_next(&ring, &late), 2);
+    EXPECT_EQ(event_ring_pending(&ring, &late), 1u);
+    event_ring_shutdown(&ring);
+}
+
+TEST(EventRingTests, LaggingReaderSkipsOverwrittenEvents) {
+    EventRing ring;
+    ASSERT_TRUE(event_ring_init(&ring, sizeof(int), 4));
+    EventRingReader reader;
+    event_ring_reader_init(&ring, &reader);
+    
+    for (int v = 0; v < 10; v++) event_ring_push(&ring, &v);
+    EXPECT_EQ(event_ring_pending(&ring, &reader), 4u);
+    
+    // Oldest surviving event is 6; 0..5 were overwritten
+    std::vector<int> seen;
+    const int* e;
+    while ((e = (const int*)event_ring_next(&ring, &reader)) != NULL) seen.push_back(*e);
+    EXPECT_EQ(seen, (std::vector<int>{6, 7, 8, 9}));
+    EXPECT_EQ(reader.dropped, 6u);
+    event_ring_shutdown(&ring);
+}
+
+// =============================================================================
+// Job System Tests
+// =============================================================================
+
+static void count_index_job(void* data, uint32_t index) {
+    uint32_t* hits = (uint32_t*)data;
+    hits[index]++;  // Each index runs exactly once, so no two threads share a slot
+}
+
+TEST(JobsTests, ParallelForRunsEveryIndexOnce) {
+    JobSystem jobs;
+    ASSERT_TRUE(jobs_init(&jobs, 4));
+    EXPECT_EQ(jobs_thread_count(&jobs), 5u);
+    
+    // Repeated batches reuse the same workers
+    for (uint32_t count : {1u, 7u, 1000u, 3u}) {
+        std::vector<uint32_t> hits(count, 0);
+        jobs_parallel_for(&jobs, count, count_index_job, hits.data());
+        EXPECT_EQ(std::count(hits.begin(), hits.end(), 1u), (long)count) << count << " jobs";
+    }
+    jobs_shutdown(&jobs);
+    EXPECT_EQ(jobs.impl, nullptr);
+}
+
+TEST(JobsTests, NullSystemRunsInline) {
+    std::vector<uint32_t> hits(10, 0);
+    jobs_parallel_for(NULL, 10, count_index_job, hits.data());
+    EXPECT_EQ(std::count(hits.begin(), hits.end(), 1u), 10);
+    EXPECT_EQ(jobs_thread_count(NULL), 1u);
+}
+
+// =============================================================================
+// SIMD Math Tests
+// =============================================================================
+
+// Error of a float result in units of the last place of the exact result
+static double ulp_error(float got, double exact) {
+    if (std::isnan(exact)) return std::isnan(got) ? 0.0 : 1e30;
+    if (std::isinf(exact)) return (double)got == exact ? 0.0 : 1e30;
+    float rounded = (float)exact;
+    int exponent = 0;
+    std::frexp((double)rounded, &exponent);
+    double ulp = std::ldexp(1.0, std::max(exponent - 24, -149));
+    return std::fabs((double)got - exact) / ulp;
+}
+
+static std::vector<float> sweep(float lo, float hi, uint32_t count) {
+    std::vector<float> v(count);
+    for (uint32_t i = 0; i < count; i++) v[i] = lo + (hi - lo) * (float)i / (float)(count - 1);
+    return v;
+}
+
+TEST(SimdMathTests, SinCosWithinDocumentedError) {
+    std::vector<float> x = sweep(-8192.0f, 8192.0f, 200003);
+    std::vector<float> s(x.size()), c(x.size());
+    simd_sincos_batch(x.data(), s.data(), c.data(), (uint32_t)x.size());
+    
+    // 2 ULP, or 1e-7 absolute where the result crosses zero
+    double worst = 0.0;
+    for (size_t i = 0; i < x.size(); i++) {
+        double exact_s = std::sin((double)x[i]);
+        double exact_c = std::cos((double)x[i]);
+        if (std::fabs(s[i] - exact_s) > 1e-7) worst = std::max(worst, ulp_error(s[i], exact_s));
+        if (std::fabs(c[i] - exact_c) > 1e-7) worst = std::max(worst, ulp_error(c[i], exact_c));
+    }
+    EXPECT_LE(worst, 2.0);
+    
+    // Degrees, including exact quarter turns
+    std::vector<float> deg = sweep(-1.0e6f, 1.0e6f, 200003);
+    deg.insert(deg.end(), {0.0f, 90.0f, 180.0f, -270.0f, 360.0f, 45.0f});
+    s.resize(deg.size());
+    c.resize(deg.size());
+    simd_sincos_deg_batch(deg.data(), s.data(), c.data(), (uint32_t)deg.size());
+    worst = 0.0;
+    for (size_t i = 0; i < deg.size(); i++) {
+        double radians = std::fmod((double)deg[i], 360.0) * 3.14159265358979323846 / 180.0;
+        double exact_s = std::sin(radians);
+        double exact_c = std::cos(radians);
+        if (std::fabs(s[i] - exact_s) > 1e-7) worst = std::max(worst, ulp_error(s[i], exact_s));
+        if (std::fabs(c[i] - exact_c) > 1e-7) worst = std::max(worst, ulp_error(c[i], exact_c));
+    }
+    EXPECT_LE(worst, 2.0);
+    size_t n = deg.size();
+    EXPECT_EQ(s[n - 5], 1.0f);    // sin 90
+    EXPECT_EQ(c[n - 4], -1.0f);   // cos 180
+    EXPECT_EQ(s[n - 3], 1.0f);    // sin -270
+}
+
+TEST(SimdMathTests, Exp2AndLog2WithinDocumentedError) {
+    std::vector<float> x = sweep(-126.0f, 127.0f, 200003);
+    std::vector<float> out(x.size());
+    simd_exp2_batch(x.data(), out.data(), (uint32_t)x.size());
+    double worst = 0.0;
+    for (size_t i = 0; i < x.size(); i++) worst = std::max(worst, ulp_error(out[i], std::exp2((double)x[i])));
+    EXPECT_LE(worst, 1.5);
+    
+    // log2 over every binade, subnormals included
+    for (size_t i = 0; i < x.size(); i++) {
+        uint32_t bits = 1u + (uint32_t)((double)i / (double)(x.size() - 1) * (double)(0x7F7FFFFFu - 1u));
+        std::memcpy(&x[i], &bits, sizeof(bits));
+    }
+    simd_log2_batch(x.data(), out.data(), (uint32_t)x.size());
+    worst = 0.0;
+    for (size_t i = 0; i < x.size(); i++) worst = std::max(worst, ulp_error(out[i], std::log2((double)x[i])));
+    EXPECT_LE(worst, 1.5);
+    
+    float edge[6] = {-200.0f, 200.0f, 0.0f, -1.0f, INFINITY, NAN};
+    float result[6];
+    simd_exp2_batch(edge, result, 2);
+    EXPECT_EQ(result[0], 0.0f);
+    EXPECT_EQ(result[1], INFINITY);
+    simd_log2_batch(edge + 2, result + 2, 4);
+    EXPECT_EQ(result[2], -INFINITY);
+    EXPECT_TRUE(std::isnan(result[3]));
+    EXPECT_EQ(result[4], INFINITY);
+    EXPECT_TRUE(std::isnan(result[5]));
+}
+
+TEST(SimdMathTests, PowErrorScalesWithExponent) {
+    const uint32_t count = 200003;
+    std::vector<float> x(count), y(count), out(count);
+    for (uint32_t i = 0; i < count; i++) {
+        x[i] = 0.001f + 1000.0f * (float)((i * 7919u) % count) / (float)count;
+        y[i] = -4.0f + 8.0f * (float)i / (float)count;
+    }
+    simd_pow_batch(x.data(), y.data(), out.data(), count);
+    
+    for (uint32_t i = 0; i < count; i++) {
+        double exact = std::pow((double)x[i], (double)y[i]);
+        if (exact > FLT_MAX || exact < FLT_MIN) continue;
+        double bound = 1.0 + 1.5 * std::fabs(y[i] * std::log2((double)x[i]));
+        ASSERT_LE(ulp_error(out[i], exact), bound) << x[i] << "^" << y[i];
+    }
+    
+    // Per-frame decay factors as ship physics uses them
+    float base = 0.988f, frames = 1.0f, decay;
+    simd_pow_batch(&base, &frames, &decay, 1);
+    EXPECT_FLOAT_EQ(decay, 0.988f);
+}
+
+TEST(SimdMathTests, Atan2WithinDocumentedError) {
+    const uint32_t count = 200003;
+    std::vector<float> y(count), x(count), out(count);
+    for (uint32_t i = 0; i < count; i++) {
+        x[i] = -100.0f + 200.0f * (float)((i * 7919u) % count) / (float)count;
+        y[i] = -100.0f + 200.0f * (float)i / (float)count;
+    }
+    simd_atan2_batch(y.data(), x.data(), out.data(), count);
+    double worst = 0.0;
+    for (uint32_t i = 0; i < count; i++) worst = std::max(worst, ulp_error(out[i], std::atan2((double)y[i], (double)x[i])));
+    EXPECT_LE(worst, 3.5);
+    
+    // Axes and the origin
+    float ey[5] = {0.0f, 0.0f, 1.0f, -1.0f, 0.0f};
+    float ex[5] = {1.0f, -1.0f, 0.0f, 0.0f, 0.0f};
+    float r[5];
+    simd_atan2_batch(ey, ex, r, 5);
+    EXPECT_FLOAT_EQ(r[0], 0.0f);
+    EXPECT_FLOAT_EQ(r[1], PI);
+    EXPECT_FLOAT_EQ(r[2], PI / 2.0f);
+    EXPECT_FLOAT_EQ(r[3], -PI / 2.0f);
+    EXPECT_EQ(r[4], 0.0f);
+}
+
+TEST(SimdMathTests, SqrtRsqrtAndDistance) {
+    std::vector<float> x(200003);
+    for (size_t i = 0; i < x.size(); i++) {
+        uint32_t bits = 0x00800000u + (uint32_t)((double)i / (double)(x.size() - 1) * (double)(0x7F7FFFFFu - 0x00800000u));
+        std::memcpy(&x[i], &bits, sizeof(bits));
+    }
+    std::vector<float> root(x.size()), inverse(x.size());
+    simd_sqrt_batch(x.data(), root.data(), (uint32_t)x.size());
+    simd_rsqrt_batch(x.data(), inverse.data(), (uint32_t)x.size());
+    double worst_sqrt = 0.0, worst_rsqrt = 0.0;
+    for (size_t i = 0; i < x.size(); i++) {
+        worst_sqrt = std::max(worst_sqrt, ulp_error(root[i], std::sqrt((double)x[i])));
+        worst_rsqrt = std::max(worst_rsqrt, ulp_error(inverse[i], 1.0 / std::sqrt((double)x[i])));
+    }
+    EXPECT_LE(worst_sqrt, 0.5);
+    EXPECT_LE(worst_rsqrt, 4.0);
+    
+    float zero = 0.0f, inv_zero;
+    simd_rsqrt_batch(&zero, &inv_zero, 1);
+    EXPECT_EQ(inv_zero, INFINITY);
+    
+    std::vector<float> xs = sweep(-5000.0f, 5000.0f, 1001), ys = sweep(3000.0f, -3000.0f, 1001);
+    std::vector<float> d2(xs.size());
+    simd_distance_sq_batch(xs.data(), ys.data(), 12.5f, -7.25f, d2.data(), (uint32_t)xs.size());
+    double worst = 0.0;
+    for (size_t i = 0; i < xs.size(); i++) {
+        double dx = (double)xs[i] - 12.5, dy = (double)ys[i] + 7.25;
+        worst = std::max(worst, ulp_error(d2[i], dx * dx + dy * dy));
+    }
+    EXPECT_LE(worst, 2.0);
+}
+
+// Tails shorter than a full block give the same values and write nothing past count
+TEST(SimdMathTests, BatchTailsMatchFullBlocks) {
+    std::vector<float> angles = sweep(-10.0f, 10.0f, 24);
+    std::vector<float> full_s(24), full_c(24);
+    simd_sincos_batch(angles.data(), full_s.data(), full_c.data(), 24);
+    
+    for (uint32_t count : {1u, 7u, 9u, 13u}) {
+        std::vector<float> s(count + 1, -99.0f), c(count + 1, -99.0f);
+        simd_sincos_batch(angles.data(), s.data(), c.data(), count);
+        for (uint32_t i = 0; i < count; i++) {
+            EXPECT_EQ(s[i], full_s[i]);
+            EXPECT_EQ(c[i], full_c[i]);
+        }
+        EXPECT_EQ(s[count], -99.0f);
+        EXPECT_EQ(c[count], -99.0f);
+    }
+    
+    // In place
+    std::vector<float> v = sweep(0.5f, 8.0f, 11), expected(11);
+    simd_log2_batch(v.data(), expected.data(), 11);
+    simd_log2_batch(v.data(), v.data(), 11);
+    EXPECT_EQ(v, expected);
+}
+
+// Benchmark: batch sincos/pow against libm over 100k values.
+// Prints timings; accuracy is covered by the tests above.
+TEST(SimdMathTests, DISABLED_BenchmarkAgainstLibm) {
+    const uint32_t count = 100000;
+    std::vector<float> x = sweep(-360.0f, 360.0f, count), y = sweep(0.5f, 2.0f, count);
+    std::vector<float> s(count), c(count), p(count), exponent(count, 0.75f);
+    
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < count; i++) {
+        float r = math_deg_to_rad(x[i]);
+        s[i] = sinf(r);
+        c[i] = cosf(r);
+        p[i] = powf(y[i], 0.75f);
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    float libm_check = s[count / 3] + c[count / 3] + p[count / 3];
+    
+    simd_sincos_deg_batch(x.data(), s.data(), c.data(), count);
+    simd_pow_batch(y.data(), exponent.data(), p.data(), count);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    
+    EXPECT_NEAR(s[count / 3] + c[count / 3] + p[count / 3], libm_check, 1e-5f);
+    
+    auto us = [](auto a, auto b) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(b - a).count();
+    };
+    std::cout << "libm sincos+pow (" << count << "): " << us(t0, t1) << " us" << std::endl;
+    std::cout << "SIMD sincos+pow (" << count << "): " << us(t1, t2) << " us" << std::endl;
+#ifdef NDEBUG
+    // Unoptimized intrinsics are slower than libm; only a release build says anything
+    EXPECT_LT(us(t1, t2), us(t0, t1));
+#endif
+}
@@ -0,0 +1,267 @@
+// =============================================================================
+// Game Simulation Tests
+// Tests for the headless simulation, time warp and adaptive sub-stepping
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+extern "C" {
+#include "engine_ecs.h"
+#include "engine_math.h"
+#include "game_ecs.h"
+#include "game_ship_ecs.h"
+#include "game_sim.h"
+}
+
+static SimScenario small_scenario() {
+    SimScenario scenario = game_sim_default_scenario();
+    scenario.poi_file[0] = '\0';
+    scenario.ship_count = 48;
+    scenario.seed = 7;
+    scenario.spawn_radius = 1500.0f;
+    scenario.helm_interval = 2.0f;
+    return scenario;
+}
+
+TEST(GameSimTest, SameScenarioGivesSameWorld) {
+    SimScenario scenario = small_scenario();
+    std::unique_ptr<GameSim> a(new GameSim());
+    std::unique_ptr<GameSim> b(new GameSim());
+    ASSERT_TRUE(game_sim_init(a.get(), &scenario));
+    ASSERT_TRUE(game_sim_init(b.get(), &scenario));
+    ASSERT_EQ(a->ship_count, 48u);
+    
+    float start_x = a->ecs_world.transforms.pos_x[a->ships[5]];
+    float start_y = a->ecs_world.transforms.pos_y[a->ships[5]];
+    
+    SimStats stats_a = game_sim_run(a.get(), 1200);
+    // Stepping one tick at a time is the same as one long run
+    for (int t = 0; t < 1200; t++) game_sim_step(b.get());
+    SimStats stats_b = game_sim_run(b.get(), 0);
+    
+    EXPECT_EQ(stats_a.ticks, 1200u);
+    EXPECT_NEAR(stats_a.sim_seconds, 20.0, 1e-6);
+    EXPECT_EQ(stats_a.poi_visits, stats_b.poi_visits);
+    EXPECT_EQ(stats_a.mean_satisfaction, stats_b.mean_satisfaction);
+    for (uint32_t i = 0; i < a->ship_count; i++) {
+        Entity e = a->ships[i];
+        ASSERT_EQ(a->ecs_world.transforms.pos_x[e], b->ecs_world.transforms.pos_x[e]) << "ship " << i;
+        ASSERT_EQ(a->ecs_world.transforms.pos_y[e], b->ecs_world.transforms.pos_y[e]) << "ship " << i;
+        ASSERT_EQ(a->ecs_world.transforms.rotation[e], b->ecs_world.transforms.rotation[e]) << "ship " << i;
+    }
+    
+    // The helm got the fleet moving
+    float moved = math_distance(start_x, start_y,
+                                a->ecs_world.transforms.pos_x[a->ships[5]],
+                                a->ecs_world.transforms.pos_y[a->ships[5]]);
+    EXPECT_GT(moved, 100.0f);
+    
+    game_sim_shutdown(a.get());
+    game_sim_shutdown(b.get());
+}
+
+TEST(GameSimTest, SeedChangesTheWorld) {
+    SimScenario scenario = small_scenario();
+    std::unique_ptr<GameSim> a(new GameSim());
+    std::unique_ptr<GameSim> b(new GameSim());
+    ASSERT_TRUE(game_sim_init(a.get(), &scenario));
+    scenario.seed = 8;
+    ASSERT_TRUE(game_sim_init(b.get(), &scenario));
+    
+    game_sim_run(a.get(), 60);
+    game_sim_run(b.get(), 60);
+    EXPECT_NE(a->ecs_world.transforms.pos_x[a->ships[0]], b->ecs_world.transforms.pos_x[b->ships[0]]);
+    
+    game_sim_shutdown(a.get());
+    game_sim_shutdown(b.get());
+}
+
+TEST(GameSimTest, LoadsScenarioFile) {
+    const char* path = "sim_scenario_test.ini";
+    FILE* file = fopen(path, "w");
+    ASSERT_NE(file, nullptr);
+    fputs("[Scenario]\nname = Test fleet\nships = 5000\nticks = 90\nseed = 3\n"
+          "throttle_max = 0.5\nfog = false\n[Simulation]\ntick_rate = 30\n", file);
+    fclose(file);
+    
+    SimScenario scenario;
+    ASSERT_TRUE(game_sim_load_scenario(path, &scenario));
+    remove(path);
+    EXPECT_STREQ(scenario.name, "Test fleet");
+    EXPECT_EQ(scenario.ship_count, (uint32_t)(MAX_ENTITIES - 1));   // Clamped to the world
+    EXPECT_EQ(scenario.ticks, 90u);
+    EXPECT_EQ(scenario.seed, 3u);
+    EXPECT_EQ(scenario.tick_rate, 30);
+    EXPECT_FLOAT_EQ(scenario.throttle_max, 0.5f);
+    EXPECT_FALSE(scenario.fog_enabled);
+    
+    // Missing files leave the defaults
+    EXPECT_FALSE(game_sim_load_scenario("no_such_scenario.ini", &scenario));
+    EXPECT_EQ(scenario.ship_count, (uint32_t)SIM_DEFAULT_SHIPS);
+}
+
+TEST(GameSimTest, DISABLED_BenchmarkFullFleet) {
+    SimScenario scenario = small_scenario();
+    scenario.ship_count = MAX_ENTITIES - 1;
+    scenario.spawn_radius = 3000.0f;
+    std::unique_ptr<GameSim> sim(new GameSim());
+    ASSERT_TRUE(game_sim_init(sim.get(), &scenario));
+    
+    SimStats stats = game_sim_run(sim.get(), 600);
+    std::cout << "[Benchmark] headless sim, " << stats.ship_count << " ships: "
+              << stats.ticks_per_second << " ticks/s, " << stats.realtime_factor
+              << "x real time, worst tick " << stats.worst_tick_ms << " ms" << std::endl;
+    EXPECT_EQ(stats.ticks, 600u);
+    EXPECT_GT(stats.realtime_factor, 1.0);
+    
+    game_sim_shutdown(sim.get());
+}
+
+// Fleet that mostly holds course, as on a long route: no random rudder, and
+// throttle changes once a minute
+static SimScenario cruising_scenario() {
+    SimScenario scenario = small_scenario();
+    scenario.ship_count = 1000;
+    scenario.spawn_radius = 3000.0f;
+    scenario.rudder_max = 0.0f;
+    scenario.helm_interval = 60.0f;
+    return scenario;
+}
+
+TEST(GameSimTest, DISABLED_BenchmarkTimeWarp) {
+    SimScenario scenario = cruising_scenario();
+    const uint32_t ticks = 3600;
+    double every_tick = 0.0, warped = 0.0;
+    
+    for (uint32_t substeps : {1u, 8u, 32u}) {
+        scenario.max_substeps = substeps;
+        std::unique_ptr<GameSim> sim(new GameSim());
+        ASSERT_TRUE(game_sim_init(sim.get(), &scenario));
+        
+        SimStats stats = game_sim_run(sim.get(), ticks);
+        std::cout << "[Benchmark] time warp, " << stats.ship_count << " ships, up to " << substeps
+                  << " ticks per update: " << stats.realtime_factor << " sim-s per wall-s ("
+                  << stats.updates << " updates, worst " << stats.worst_tick_ms << " ms)" << std::endl;
+        EXPECT_EQ(stats.ticks, ticks);
+        EXPECT_LE(stats.updates, (uint64_t)ticks);
+        if (substeps == 1) every_tick = stats.realtime_factor;
+        warped = stats.realtime_factor;
+        
+        game_sim_shutdown(sim.get());
+    }
+    EXPECT_GT(warped, every_tick * 2.0);
+}
+
+// =============================================================================
+// Adaptive Sub-stepping
+// =============================================================================
+
+struct AdaptiveFleet {
+    ECSWorld world;
+    GameEcsState game;
+    Entity cruisers[8];
+    Entity turners[8];
+};
+
+// Eight ships cruising east at 60% and eight turning, settled for ten
+// seconds; far enough apart that no hulls touch
+static void make_adaptive_fleet(AdaptiveFleet* f) {
+    game_ecs_init(&f->game, &f->world);
+    for (int i = 0; i < 8; i++) {
+        f->cruisers[i] = game_create_player_ship(&f->game, 0.0f, 300.0f * i, 90.0f);
+        game_ecs_set_throttle(&f->game, f->cruisers[i], 0.6f);
+        f->turners[i] = game_create_player_ship(&f->game, 2000.0f * i, 5000.0f, 45.0f * i);
+        game_ecs_set_throttle(&f->game, f->turners[i], 0.2f + 0.05f * i);
+        game_ecs_set_steering(&f->game, f->turners[i], i % 2 ? 0.5f : -0.8f);
+    }
+    for (int t = 0; t < 600; t++) game_ecs_update(&f->game, 1.0f / 60.0f);
+}
+
+TEST(AdaptiveStepTest, MatchesBaseSteps) {
+    std::unique_ptr<AdaptiveFleet> base(new AdaptiveFleet());
+    std::unique_ptr<AdaptiveFleet> warped(new AdaptiveFleet());
+    make_adaptive_fleet(base.get());
+    make_adaptive_fleet(warped.get());
+    const float dt = 1.0f / 60.0f;
+    
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(ship_ecs_is_steady(&warped->world, &warped->game.ship_world, warped->cruisers[i]));
+        EXPECT_FALSE(ship_ecs_is_steady(&warped->world, &warped->game.ship_world, warped->turners[i]));
+    }
+    
+    // Sized by the fastest speed any ship can reach in 64 steps, which is
+    // below the 150 units/s max speed; no POIs, so the default travel limit
+    const ShipComponents* ships = &warped->game.ship_world.ships;
+    float fastest = 0.0f;
+    for (int i = 0; i < 8; i++) {
+        for (Entity e : {warped->cruisers[i], warped->turners[i]}) {
+            float reach = std::fabs(warped->world.velocities.speed[e]) + ships->acceleration[e] * 64.0f * dt;
+            fastest = std::fmax(fastest, std::fmin(reach, ships->max_speed[e]));
+        }
+    }
+    EXPECT_LT(fastest, 150.0f);
+    EXPECT_FLOAT_EQ(game_ecs_max_step_travel(&warped->game), GAME_ECS_MAX_STEP_TRAVEL);
+    uint32_t steps = game_ecs_adaptive_steps(&warped->game, dt, 64);
+    EXPECT_EQ(steps, (uint32_t)(GAME_ECS_MAX_STEP_TRAVEL / (fastest * dt)));
+    EXPECT_GT(steps, 16u);
+    EXPECT_EQ(game_ecs_adaptive_steps(&warped->game, dt, 4), 4u);
+    
+    // 20 seconds either way
+    for (uint32_t u = 0; u < 1200 / steps; u++) {
+        for (uint32_t s = 0; s < steps; s++) game_ecs_update(&base->game, dt);
+        game_ecs_update_adaptive(&warped->game, dt, steps);
+    }
+    
+    for (int i = 0; i < 8; i++) {
+        // Cruisers took one step per update; a straight line is exact up to rounding
+        Entity c = base->cruisers[i];
+        EXPECT_NEAR(warped->world.transforms.pos_x[c], base->world.transforms.pos_x[c], 0.05f) << "cruiser " << i;
+        EXPECT_NEAR(warped->world.transforms.pos_y[c], base->world.transforms.pos_y[c], 0.05f) << "cruiser " << i;
+        EXPECT_FLOAT_EQ(warped->world.transforms.rotation[c], base->world.transforms.rotation[c]);
+        
+        // Turning ships took every base step
+        Entity t = base->turners[i];
+        EXPECT_FLOAT_EQ(warped->world.transforms.pos_x[t], base->world.transforms.pos_x[t]) << "turner " << i;
+        EXPECT_FLOAT_EQ(warped->world.transforms.pos_y[t], base->world.transforms.pos_y[t]) << "turner " << i;
+        EXPECT_FLOAT_EQ(warped->world.transforms.rotation[t], base->world.transforms.rotation[t]) << "turner " << i;
+        EXPECT_FLOAT_EQ(warped->world.velocities.angular_vel[t], base->world.velocities.angular_vel[t]);
+    }
+    
+    game_ecs_shutdown(&base->game);
+    game_ecs_shutdown(&warped->game);
+}
+
+TEST(AdaptiveStepTest, TravelLimitFollowsSmallestPOI) {
+    std::unique_ptr<AdaptiveFleet> f(new AdaptiveFleet());
+    make_adaptive_fleet(f.get());
+    const float dt = 1.0f / 60.0f;
+    uint32_t open_water = game_ecs_adaptive_steps(&f->game, dt, 64);
+    
+    // A small POI halves into the travel limit and shortens the span
+    POIEcsWorld* pois = game_ecs_get_poi_world(&f->game);
+    POICreateParams params;
+    memset(&params, 0, sizeof(params));
+    params.name = "Buoy";
+    params.x = 9000.0f;
+    params.radius = 30.0f;
+    ASSERT_EQ(poi_ecs_create(pois, &params), 0);
+    params.name = "Harbour";
+    params.radius = 200.0f;
+    ASSERT_EQ(poi_ecs_create(pois, &params), 1);
+    EXPECT_FLOAT_EQ(game_ecs_max_step_travel(&f->game), 15.0f);
+    uint32_t near_buoy = game_ecs_adaptive_steps(&f->game, dt, 64);
+    EXPECT_LT(near_buoy, open_water);
+    EXPECT_NEAR((float)near_buoy, open_water * 15.0f / GAME_ECS_MAX_STEP_TRAVEL, 1.0f);
+    
+    // Large POIs never raise the limit past the default
+    poi_ecs_destroy(pois, 0);
+    poi_ecs_rebuild_index(pois);
+    EXPECT_FLOAT_EQ(game_ecs_max_step_travel(&f->game), GAME_ECS_MAX_STEP_TRAVEL);
+    EXPECT_EQ(game_ecs_adaptive_steps(&f->game, dt, 64), open_water);
+    game_ecs_shutdown(&f->game);
+}
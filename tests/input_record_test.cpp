@@ -0,0 +1,148 @@
+// =============================================================================
+// Input Recording Tests
+// Tests for the tick input log, its file format and deterministic replay
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+extern "C" {
+#include "game_ecs.h"
+#include "game_sim.h"
+#include "input_record.h"
+}
+
+static SimScenario small_scenario() {
+    SimScenario scenario = game_sim_default_scenario();
+    scenario.poi_file[0] = '\0';
+    scenario.ship_count = 48;
+    scenario.seed = 7;
+    scenario.spawn_radius = 1500.0f;
+    scenario.helm_interval = 2.0f;
+    return scenario;
+}
+
+// Scripted player input: a few held keys and telegraph presses
+static TickInput scripted_input(uint32_t tick) {
+    uint8_t actions = 0;
+    if (tick == 10 || tick == 200) actions |= TICK_ACTION_RING_UP;
+    if (tick == 400) actions |= TICK_ACTION_RING_DOWN;
+    float steering = (tick / 90) % 3 == 1 ? -1.0f : ((tick / 90) % 3 == 2 ? 0.5f : 0.0f);
+    return tick_input_make(actions, steering, 1.0f);
+}
+
+// Drive the sim's first ship from a TickInput (telegraph presses step the throttle)
+static void step_with_input(GameSim* sim, const TickInput& input) {
+    Entity player = sim->ships[0];
+    float throttle = sim->game_ecs.ship_world.ships.target_throttle[player];
+    if (input.actions & TICK_ACTION_RING_UP) throttle = std::fmin(throttle + 0.5f, 1.0f);
+    if (input.actions & TICK_ACTION_RING_DOWN) throttle = std::fmax(throttle - 0.5f, -1.0f);
+    game_ecs_set_throttle(&sim->game_ecs, player, throttle);
+    game_ecs_set_steering(&sim->game_ecs, player, tick_input_steering(&input));
+    game_sim_step(sim);
+}
+
+TEST(InputRecordTest, TickInputPacking) {
+    TickInput input = tick_input_make(TICK_ACTION_RESET, -0.5f, 1.25f);
+    EXPECT_EQ(input.actions, TICK_ACTION_RESET);
+    EXPECT_NEAR(tick_input_steering(&input), -0.5f, 1.0f / 127.0f);
+    EXPECT_FLOAT_EQ(tick_input_zoom(&input), 1.25f);
+    
+    // Out of range values are clamped
+    input = tick_input_make(0, 3.0f, -1.0f);
+    EXPECT_FLOAT_EQ(tick_input_steering(&input), 1.0f);
+    EXPECT_FLOAT_EQ(tick_input_zoom(&input), 0.0f);
+}
+
+TEST(InputRecordTest, HeldInputIsOneRun) {
+    InputLog log;
+    input_log_init(&log, 60, 0.0f, 0.0f, 4);
+    TickInput idle = tick_input_make(0, 0.0f, 1.0f);
+    TickInput left = tick_input_make(0, -1.0f, 1.0f);
+    for (int t = 0; t < 100; t++) input_log_record(&log, idle, (uint64_t)t);
+    for (int t = 0; t < 50; t++) input_log_record(&log, left, (uint64_t)t);
+    input_log_record(&log, idle, 0);
+    
+    EXPECT_EQ(log.header.tick_count, 151u);
+    EXPECT_EQ(log.header.run_count, 3u);
+    EXPECT_EQ(log.runs[0].ticks, 100u);
+    EXPECT_EQ(log.runs[1].ticks, 50u);
+    EXPECT_EQ(log.header.hash_count, 151u / 4u);   // Every 4th tick
+    input_log_free(&log);
+}
+
+TEST(InputRecordTest, ReplayReproducesTheWorld) {
+    SimScenario scenario = small_scenario();
+    const uint32_t ticks = 600;
+    const char* path = "input_record_test.msir";
+    
+    // Record a session
+    std::unique_ptr<GameSim> recorded(new GameSim());
+    ASSERT_TRUE(game_sim_init(recorded.get(), &scenario));
+    InputLog log;
+    input_log_init(&log, (uint32_t)scenario.tick_rate, 0.0f, 0.0f, INPUT_LOG_DEFAULT_HASH_INTERVAL);
+    for (uint32_t t = 0; t < ticks; t++) {
+        TickInput input = scripted_input(t);
+        step_with_input(recorded.get(), input);
+        ASSERT_TRUE(input_log_record(&log, input, game_ecs_hash(&recorded->game_ecs)));
+    }
+    EXPECT_LT(log.header.run_count, 16u);
+    ASSERT_TRUE(input_log_save(&log, path));
+    input_log_free(&log);
+    
+    // Replay it from the file into a fresh world
+    InputLog loaded;
+    memset(&loaded, 0, sizeof(loaded));
+    ASSERT_TRUE(input_log_load(&loaded, path));
+    remove(path);
+    EXPECT_EQ(loaded.header.tick_count, ticks);
+    EXPECT_EQ(loaded.header.hash_count, ticks);
+    
+    std::unique_ptr<GameSim> replayed(new GameSim());
+    ASSERT_TRUE(game_sim_init(replayed.get(), &scenario));
+    InputReplay replay;
+    input_replay_start(&replay, &loaded);
+    TickInput input;
+    while (input_replay_next(&replay, &input)) {
+        step_with_input(replayed.get(), input);
+        input_replay_check(&replay, game_ecs_hash(&replayed->game_ecs));
+    }
+    EXPECT_TRUE(input_replay_finished(&replay));
+    EXPECT_FALSE(replay.diverged);
+    EXPECT_EQ(replay.hashes_checked, ticks);
+    EXPECT_EQ(game_ecs_hash(&replayed->game_ecs), game_ecs_hash(&recorded->game_ecs));
+    
+    // A different input on one tick is caught on that tick
+    std::unique_ptr<GameSim> perturbed(new GameSim());
+    ASSERT_TRUE(game_sim_init(perturbed.get(), &scenario));
+    input_replay_start(&replay, &loaded);
+    while (input_replay_next(&replay, &input)) {
+        if (replay.tick == 321) input.steering = (int8_t)(input.steering + 40);
+        step_with_input(perturbed.get(), input);
+        input_replay_check(&replay, game_ecs_hash(&perturbed->game_ecs));
+    }
+    EXPECT_TRUE(replay.diverged);
+    EXPECT_EQ(replay.diverged_tick, 321u);
+    
+    input_log_free(&loaded);
+    game_sim_shutdown(recorded.get());
+    game_sim_shutdown(replayed.get());
+    game_sim_shutdown(perturbed.get());
+}
+
+TEST(InputRecordTest, RejectsForeignFiles) {
+    const char* path = "input_record_bad.msir";
+    FILE* file = fopen(path, "wb");
+    ASSERT_NE(file, nullptr);
+    fputs("not an input log, just some text long enough for a header", file);
+    fclose(file);
+    
+    InputLog log;
+    memset(&log, 0, sizeof(log));
+    EXPECT_FALSE(input_log_load(&log, path));
+    EXPECT_FALSE(input_log_load(&log, "no_such_log.msir"));
+    remove(path);
+}
@@ -4,13 +4,24 @@
 // =============================================================================
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
 
 extern "C" {
+#include "engine_ecs.h"
 #include "game_poi_ecs.h"
 #include "game_poi_loader.h"
+#include "game_poi_cooked.h"
 #include "game_fog_of_war.h"
 #include "game_satisfaction.h"
+#include "game_route_planner.h"
+#include "poi_render.h"
 }
 
 // Helper to create POI params (C++17 compatible)
@@ -70,6 +81,33 @@ TEST_F(POIEcsTest, CreatePOI) {
     EXPECT_EQ(poi_ecs_get_satisfaction_bonus(&poi_world, idx), 15);
 }
 
+TEST_F(POIEcsTest, LongStringsAreNotTruncated) {
+    std::string long_name(200, 'N');
+    std::string long_description(1000, 'd');
+    POICreateParams params = make_poi_params(
+        long_name.c_str(), POI_TYPE_NATURE, POI_TIER_GENERAL,
+        0.0f, 0.0f, 0.0f, 0, long_description.c_str()
+    );
+    
+    int idx = poi_ecs_create(&poi_world, &params);
+    ASSERT_GE(idx, 0);
+    
+    EXPECT_EQ(std::string(poi_ecs_get_name(&poi_world, idx)), long_name);
+    EXPECT_EQ(std::string(poi_ecs_get_description(&poi_world, idx)), long_description);
+}
+
+TEST_F(POIEcsTest, StringsSurviveDestroySwap) {
+    POICreateParams a = make_poi_params("First", POI_TYPE_NATURE, POI_TIER_GENERAL, 0.0f, 0.0f, 0.0f, 0, "first desc");
+    POICreateParams b = make_poi_params("Second", POI_TYPE_NATURE, POI_TIER_GENERAL, 0.0f, 0.0f, 0.0f, 0, "second desc");
+    poi_ecs_create(&poi_world, &a);
+    poi_ecs_create(&poi_world, &b);
+    
+    poi_ecs_destroy(&poi_world, 0);
+    
+    EXPECT_STREQ(poi_ecs_get_name(&poi_world, 0), "Second");
+    EXPECT_STREQ(poi_ecs_get_description(&poi_world, 0), "second desc");
+}
+
 TEST_F(POIEcsTest, DefaultRadius) {
     POICreateParams params = make_poi_params(
         "Default Radius POI", POI_TYPE_NATURE, POI_TIER_GENERAL,
@@ -110,6 +148,370 @@ TEST_F(POIEcsTest, FindAtPosition) {
     EXPECT_EQ(found, -1);
 }
 
+TEST_F(POIEcsTest, SpatialIndexMatchesLinearScan) {
+    // Grid of overlapping POIs with varied radii
+    for (int i = 0; i < 200; i++) {
+        POICreateParams params = make_poi_params(
+            "Grid POI", POI_TYPE_NATURE, POI_TIER_GENERAL,
+            (float)(i % 20) * 60.0f, (float)(i / 20) * 60.0f, 20.0f + (float)(i % 7) * 10.0f
+        );
+        ASSERT_GE(poi_ecs_create(&poi_world, &params), 0);
+    }
+    
+    // Dirty index answers with the linear scan
+    EXPECT_TRUE(poi_world.index_dirty);
+    int scan_results[64];
+    int query_count = 0;
+    int scan_answers[100];
+    for (int q = 0; q < 100; q++) {
+        float x = (float)(q * 37 % 1200);
+        float y = (float)(q * 53 % 600);
+        scan_answers[q] = poi_ecs_find_at_position(&poi_world, x, y);
+    }
+    query_count = poi_ecs_find_in_range(&poi_world, 300.0f, 300.0f, 130.0f, scan_results, 64);
+    int scan_rect[200];
+    int rect_count = poi_ecs_find_in_rect(&poi_world, 100.0f, 60.0f, 400.0f, 250.0f, scan_rect, 200);
+    EXPECT_EQ(rect_count, 5 * 4);   // Columns 2-6, rows 1-4 (edges included)
+    
+    poi_ecs_rebuild_index(&poi_world);
+    EXPECT_FALSE(poi_world.index_dirty);
+    
+    for (int q = 0; q < 100; q++) {
+        float x = (float)(q * 37 % 1200);
+        float y = (float)(q * 53 % 600);
+        EXPECT_EQ(poi_ecs_find_at_position(&poi_world, x, y), scan_answers[q]);
+    }
+    
+    int grid_results[64];
+    int grid_count = poi_ecs_find_in_range(&poi_world, 300.0f, 300.0f, 130.0f, grid_results, 64);
+    ASSERT_EQ(grid_count, query_count);
+    std::sort(scan_results, scan_results + query_count);
+    std::sort(grid_results, grid_results + grid_count);
+    for (int i = 0; i < grid_count; i++) {
+        EXPECT_EQ(grid_results[i], scan_results[i]);
+    }
+    
+    int grid_rect[200];
+    ASSERT_EQ(poi_ecs_find_in_rect(&poi_world, 100.0f, 60.0f, 400.0f, 250.0f, grid_rect, 200), rect_count);
+    std::sort(scan_rect, scan_rect + rect_count);
+    std::sort(grid_rect, grid_rect + rect_count);
+    for (int i = 0; i < rect_count; i++) {
+        EXPECT_EQ(grid_rect[i], scan_rect[i]);
+    }
+    EXPECT_EQ(poi_ecs_find_in_rect(&poi_world, 100.0f, 60.0f, 400.0f, 250.0f, grid_rect, 4), 4);
+}
+
+TEST_F(POIEcsTest, DestroyMarksIndexDirty) {
+    POICreateParams a = make_poi_params("A", POI_TYPE_NATURE, POI_TIER_GENERAL, 0.0f, 0.0f, 50.0f);
+    POICreateParams b = make_poi_params("B", POI_TYPE_NATURE, POI_TIER_GENERAL, 500.0f, 0.0f, 50.0f);
+    poi_ecs_create(&poi_world, &a);
+    poi_ecs_create(&poi_world, &b);
+    poi_ecs_rebuild_index(&poi_world);
+    
+    poi_ecs_destroy(&poi_world, 0);
+    EXPECT_TRUE(poi_world.index_dirty);
+    
+    // "B" moved into slot 0
+    poi_ecs_rebuild_index(&poi_world);
+    EXPECT_EQ(poi_ecs_find_at_position(&poi_world, 500.0f, 0.0f), 0);
+    EXPECT_EQ(poi_ecs_find_at_position(&poi_world, 0.0f, 0.0f), -1);
+}
+
+TEST_F(POIEcsTest, GenerationChangesWithTheSet) {
+    uint32_t empty = poi_ecs_get_generation(&poi_world);
+    EXPECT_NE(empty, 0u);
+    
+    POICreateParams a = make_poi_params("A", POI_TYPE_NATURE, POI_TIER_GENERAL, 0.0f, 0.0f);
+    POICreateParams b = make_poi_params("B", POI_TYPE_NATURE, POI_TIER_GENERAL, 500.0f, 0.0f);
+    poi_ecs_create(&poi_world, &a);
+    uint32_t one = poi_ecs_get_generation(&poi_world);
+    EXPECT_NE(one, empty);
+    
+    // Visits and index rebuilds leave the set as it was
+    poi_ecs_set_visited(&poi_world, 0, true);
+    poi_ecs_rebuild_index(&poi_world);
+    EXPECT_EQ(poi_ecs_get_generation(&poi_world), one);
+    
+    // Destroy then create keeps the count but not the generation
+    poi_ecs_destroy(&poi_world, 0);
+    EXPECT_NE(poi_ecs_get_generation(&poi_world), one);
+    poi_ecs_create(&poi_world, &b);
+    EXPECT_EQ(poi_ecs_get_count(&poi_world), 1u);
+    EXPECT_NE(poi_ecs_get_generation(&poi_world), one);
+    
+    // A reload, or another world, never repeats a generation
+    uint32_t before_clear = poi_ecs_get_generation(&poi_world);
+    poi_ecs_clear(&poi_world);
+    EXPECT_NE(poi_ecs_get_generation(&poi_world), before_clear);
+    POIEcsWorld other;
+    poi_ecs_init(&other);
+    EXPECT_NE(poi_ecs_get_generation(&other), poi_ecs_get_generation(&poi_world));
+    poi_ecs_shutdown(&other);
+    EXPECT_EQ(poi_ecs_get_generation(&other), 0u);
+}
+
+TEST_F(POIEcsTest, SystemUpdateVisitsNearbyPOIs) {
+    ECSWorld* ecs_world = new ECSWorld;
+    ecs_world_init(ecs_world);
+    
+    POICreateParams near_poi = make_poi_params("Near", POI_TYPE_NATURE, POI_TIER_GENERAL, 100.0f, 100.0f, 50.0f);
+    POICreateParams far_poi = make_poi_params("Far", POI_TYPE_NATURE, POI_TIER_GENERAL, 5000.0f, 5000.0f, 50.0f);
+    int near_idx = poi_ecs_create(&poi_world, &near_poi);
+    int far_idx = poi_ecs_create(&poi_world, &far_poi);
+    
+    Entity ship = ecs_create_entity(ecs_world);
+    ecs_add_component(ecs_world, ship, COMPONENT_TRANSFORM);
+    ecs_add_component(ecs_world, ship, COMPONENT_GAME_0);
+    ecs_set_position(ecs_world, ship, 110.0f, 90.0f);
+    
+    // Dirty index is rebuilt lazily by the system
+    poi_ecs_system_update(&poi_world, ecs_world, COMPONENT_GAME_0);
+    
+    EXPECT_FALSE(poi_world.index_dirty);
+    EXPECT_TRUE(poi_ecs_is_visited(&poi_world, near_idx));
+    EXPECT_FALSE(poi_ecs_is_visited(&poi_world, far_idx));
+    
+    delete ecs_world;
+}
+
+// Drain a reader into "enter:<poi>:<ship>" / "exit:<poi>:<ship>" strings
+// ("destroy:<poi>:<moved_from>" for removals)
+static std::vector<std::string> drain_poi_events(const POIEcsWorld* poi_world, EventRingReader* reader) {
+    std::vector<std::string> out;
+    const POIEvent* event;
+    while ((event = poi_ecs_events_next(poi_world, reader)) != nullptr) {
+        const char* type = event->type == POI_EVENT_ENTER ? "enter:"
+                         : event->type == POI_EVENT_EXIT ? "exit:" : "destroy:";
+        out.push_back(std::string(type) + std::to_string(event->poi_index) + ":" + std::to_string(event->ship));
+    }
+    return out;
+}
+
+class POIEventTest : public POIEcsTest {
+protected:
+    void SetUp() override {
+        POIEcsTest::SetUp();
+        ecs_world = new ECSWorld;
+        ecs_world_init(ecs_world);
+        poi_ecs_events_reader_init(&poi_world, &reader);
+    }
+    
+    void TearDown() override {
+        delete ecs_world;
+        POIEcsTest::TearDown();
+    }
+    
+    Entity add_ship(float x, float y) {
+        Entity ship = ecs_create_entity(ecs_world);
+        ecs_add_component(ecs_world, ship, COMPONENT_TRANSFORM);
+        ecs_add_component(ecs_world, ship, COMPONENT_GAME_0);
+        ecs_set_position(ecs_world, ship, x, y);
+        return ship;
+    }
+    
+    std::vector<std::string> step() {
+        poi_ecs_system_update(&poi_world, ecs_world, COMPONENT_GAME_0);
+        return drain_poi_events(&poi_world, &reader);
+    }
+    
+    ECSWorld* ecs_world = nullptr;
+    EventRingReader reader;
+};
+
+TEST_F(POIEventTest, EnterAndExitWithHysteresis) {
+    POICreateParams p = make_poi_params("Buoy", POI_TYPE_NATURE, POI_TIER_GENERAL, 0.0f, 0.0f, 50.0f);
+    int idx = poi_ecs_create(&poi_world, &p);
+    Entity ship = add_ship(200.0f, 0.0f);
+    std::string s = std::to_string(ship);
+    
+    EXPECT_TRUE(step().empty());
+    
+    ecs_set_position(ecs_world, ship, 49.0f, 0.0f);
+    poi_ecs_system_update(&poi_world, ecs_world, COMPONENT_GAME_0);
+    const POIEvent* first = poi_ecs_events_next(&poi_world, &reader);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->type, POI_EVENT_ENTER);
+    EXPECT_TRUE(first->first_visit);
+    EXPECT_EQ(first->ship, ship);
+    EXPECT_TRUE(poi_ecs_ship_is_inside(&poi_world, ship, idx));
+    
+    // Staying inside or drifting into the hysteresis band fires nothing
+    EXPECT_TRUE(step().empty());
+    ecs_set_position(ecs_world, ship, 55.0f, 0.0f);
+    EXPECT_TRUE(step().empty());
+    EXPECT_TRUE(poi_ecs_ship_is_inside(&poi_world, ship, idx));
+    
+    // Past radius * POI_EXIT_RADIUS_SCALE (60)
+    ecs_set_position(ecs_world, ship, 61.0f, 0.0f);
+    EXPECT_EQ(step(), std::vector<std::string>{"exit:0:" + s});
+    EXPECT_FALSE(poi_ecs_ship_is_inside(&poi_world, ship, idx));
+    
+    // Re-entering counts another visit but is no longer the first
+    ecs_set_position(ecs_world, ship, 55.0f, 0.0f);
+    EXPECT_TRUE(step().empty());
+    ecs_set_position(ecs_world, ship, 0.0f, 0.0f);
+    poi_ecs_system_update(&poi_world, ecs_world, COMPONENT_GAME_0);
+    const POIEvent* event = poi_ecs_events_next(&poi_world, &reader);
+    ASSERT_NE(event, nullptr);
+    EXPECT_EQ(event->type, POI_EVENT_ENTER);
+    EXPECT_FALSE(event->first_visit);
+    EXPECT_EQ(poi_world.pois.visit_count[idx], 2u);
+}
+
+TEST_F(POIEventTest, ShipsAreTrackedIndependently) {
+    POICreateParams a = make_poi_params("A", POI_TYPE_NATURE, POI_TIER_GENERAL, 0.0f, 0.0f, 50.0f);
+    POICreateParams b = make_poi_params("B", POI_TYPE_NATURE, POI_TIER_GENERAL, 30.0f, 0.0f, 50.0f);
+    poi_ecs_create(&poi_world, &a);
+    poi_ecs_create(&poi_world, &b);
+    
+    Entity one = add_ship(0.0f, 0.0f);      // Inside both
+    Entity two = add_ship(1000.0f, 0.0f);   // Inside neither
+    std::vector<std::string> events = step();
+    std::sort(events.begin(), events.end());
+    EXPECT_EQ(events, (std::vector<std::string>{"enter:0:" + std::to_string(one),
+                                                "enter:1:" + std::to_string(one)}));
+    EXPECT_EQ(poi_ecs_ship_inside_count(&poi_world, one), 2u);
+    EXPECT_EQ(poi_ecs_ship_inside_count(&poi_world, two), 0u);
+    
+    ecs_set_position(ecs_world, two, 75.0f, 0.0f);
+    EXPECT_EQ(step(), std::vector<std::string>{"enter:1:" + std::to_string(two)});
+    EXPECT_EQ(poi_ecs_ship_inside_count(&poi_world, one), 2u);
+}
+
+TEST_F(POIEventTest, JumpAndRemovalExitEverything) {
+    POICreateParams p = make_poi_params("Harbour", POI_TYPE_HISTORICAL, POI_TIER_GENERAL, 0.0f, 0.0f, 50.0f);
+    poi_ecs_create(&poi_world, &p);
+    Entity ship = add_ship(0.0f, 0.0f);
+    Entity other = add_ship(10.0f, 0.0f);
+    step();
+    
+    // Teleport far away: the POI is no longer a spatial candidate but must exit
+    ecs_set_position(ecs_world, ship, 100000.0f, 100000.0f);
+    EXPECT_EQ(step(), std::vector<std::string>{"exit:0:" + std::to_string(ship)});
+    
+    // A destroyed ship leaves everything it was inside
+    ecs_destroy_entity(ecs_world, other);
+    EXPECT_EQ(step(), std::vector<std::string>{"exit:0:" + std::to_string(other)});
+    EXPECT_EQ(poi_world.presence_count, 1u);
+}
+
+TEST_F(POIEventTest, PresenceFollowsPOIDestroy) {
+    POICreateParams a = make_poi_params("A", POI_TYPE_NATURE, POI_TIER_GENERAL, 0.0f, 0.0f, 50.0f);
+    POICreateParams b = make_poi_params("B", POI_TYPE_NATURE, POI_TIER_GENERAL, 5000.0f, 0.0f, 50.0f);
+    poi_ecs_create(&poi_world, &a);
+    poi_ecs_create(&poi_world, &b);
+    Entity ship = add_ship(5000.0f, 0.0f);
+    step();
+    ASSERT_TRUE(poi_ecs_ship_is_inside(&poi_world, ship, 1));
+    
+    // "B" moves into slot 0 and the ship stays inside it without enter/exit
+    // events; readers are told of the move
+    poi_ecs_destroy(&poi_world, 0);
+    EXPECT_TRUE(poi_ecs_ship_is_inside(&poi_world, ship, 0));
+    EXPECT_EQ(drain_poi_events(&poi_world, &reader), std::vector<std::string>{"destroy:0:1"});
+    EXPECT_TRUE(step().empty());
+    EXPECT_EQ(poi_ecs_ship_inside_count(&poi_world, ship), 1u);
+}
+
+TEST_F(POIEcsTest, FindByNameAndId) {
+    POICreateParams a = make_poi_params("Vinga Lighthouse", POI_TYPE_HISTORICAL, POI_TIER_SPECIAL, 0.0f, 0.0f);
+    POICreateParams b = make_poi_params("Brännö Beach", POI_TYPE_NATURE, POI_TIER_GENERAL, 10.0f, 0.0f);
+    a.id = "poi_vinga";
+    b.id = "poi_brannö_beach";
+    int ia = poi_ecs_create(&poi_world, &a);
+    int ib = poi_ecs_create(&poi_world, &b);
+    
+    EXPECT_EQ(poi_ecs_find_by_name(&poi_world, "vinga lighthouse"), ia);
+    // Folding is ASCII-only; non-ASCII bytes must match exactly
+    EXPECT_EQ(poi_ecs_find_by_name(&poi_world, "BRäNNö BEACH"), ib);
+    EXPECT_EQ(poi_ecs_find_by_name(&poi_world, "Nowhere"), -1);
+    
+    EXPECT_EQ(poi_ecs_find_by_id(&poi_world, "poi_vinga"), ia);
+    EXPECT_EQ(poi_ecs_find_by_id(&poi_world, "POI_VINGA"), ia);
+    EXPECT_STREQ(poi_ecs_get_id(&poi_world, ib), "poi_brannö_beach");
+    EXPECT_EQ(poi_ecs_find_by_id(&poi_world, ""), -1);
+}
+
+TEST_F(POIEcsTest, DuplicateIdRejected) {
+    POICreateParams a = make_poi_params("First", POI_TYPE_NATURE, POI_TIER_GENERAL, 0.0f, 0.0f);
+    POICreateParams b = make_poi_params("Second", POI_TYPE_NATURE, POI_TIER_GENERAL, 0.0f, 0.0f);
+    a.id = "poi_same";
+    b.id = "poi_same";
+    
+    EXPECT_GE(poi_ecs_create(&poi_world, &a), 0);
+    EXPECT_EQ(poi_ecs_create(&poi_world, &b), -1);
+    EXPECT_EQ(poi_ecs_get_count(&poi_world), 1u);
+}
+
+TEST_F(POIEcsTest, LookupIndicesFollowDestroy) {
+    POICreateParams a = make_poi_params("Alpha", POI_TYPE_NATURE, POI_TIER_GENERAL, 0.0f, 0.0f);
+    POICreateParams b = make_poi_params("Beta", POI_TYPE_NATURE, POI_TIER_GENERAL, 0.0f, 0.0f);
+    POICreateParams c = make_poi_params("Alpha", POI_TYPE_NATURE, POI_TIER_GENERAL, 0.0f, 0.0f);
+    a.id = "poi_a";
+    b.id = "poi_b";
+    c.id = "poi_c";
+    poi_ecs_create(&poi_world, &a);
+    poi_ecs_create(&poi_world, &b);
+    poi_ecs_create(&poi_world, &c);
+    
+    // Destroy index 0: "poi_c" (duplicate name "Alpha") is swapped into slot 0
+    poi_ecs_destroy(&poi_world, 0);
+    
+    EXPECT_EQ(poi_ecs_find_by_id(&poi_world, "poi_a"), -1);
+    EXPECT_EQ(poi_ecs_find_by_id(&poi_world, "poi_b"), 1);
+    EXPECT_EQ(poi_ecs_find_by_id(&poi_world, "poi_c"), 0);
+    EXPECT_EQ(poi_ecs_find_by_name(&poi_world, "alpha"), 0);
+    EXPECT_EQ(poi_ecs_find_by_name(&poi_world, "beta"), 1);
+    
+    poi_ecs_destroy(&poi_world, 0);
+    EXPECT_EQ(poi_ecs_find_by_name(&poi_world, "alpha"), -1);
+    EXPECT_EQ(poi_ecs_find_by_id(&poi_world, "poi_b"), 0);
+}
+
+TEST_F(POIEcsTest, GrowsBeyondInitialCapacity) {
+    // Regional dataset far beyond the old fixed 256 cap
+    const int count = 50000;
+    char id[32];
+    for (int i = 0; i < count; i++) {
+        snprintf(id, sizeof(id), "skerry_%d", i);
+        POICreateParams params = make_poi_params(
+            "Skerry", POI_TYPE_NATURE, POI_TIER_GENERAL,
+            (float)(i % 250) * 40.0f, (float)(i / 250) * 40.0f, 15.0f
+        );
+        params.id = id;
+        ASSERT_EQ(poi_ecs_create(&poi_world, &params), i);
+    }
+    poi_ecs_rebuild_index(&poi_world);
+    
+    EXPECT_EQ(poi_ecs_get_count(&poi_world), (uint32_t)count);
+    EXPECT_GE(poi_ecs_get_capacity(&poi_world), (uint32_t)count);
+    
+    // Data survived every reallocation
+    EXPECT_EQ(poi_ecs_find_by_id(&poi_world, "skerry_49999"), 49999);
+    float x, y;
+    poi_ecs_get_position(&poi_world, 12345, &x, &y);
+    EXPECT_FLOAT_EQ(x, (float)(12345 % 250) * 40.0f);
+    EXPECT_FLOAT_EQ(y, (float)(12345 / 250) * 40.0f);
+    EXPECT_EQ(poi_ecs_find_at_position(&poi_world, x + 5.0f, y), 12345);
+    
+    // Shared ("Skerry") name is stored once
+    EXPECT_LT(string_arena_size(&poi_world.strings), (uint32_t)count * 16u);
+}
+
+TEST_F(POIEcsTest, ReserveKeepsExistingPOIs) {
+    POICreateParams params = make_poi_params("Keep", POI_TYPE_MILITARY, POI_TIER_SPECIAL, 3.0f, 4.0f, 25.0f, 12);
+    int idx = poi_ecs_create(&poi_world, &params);
+    poi_ecs_set_visited(&poi_world, idx, true);
+    
+    ASSERT_TRUE(poi_ecs_reserve(&poi_world, 10000));
+    
+    EXPECT_STREQ(poi_ecs_get_name(&poi_world, idx), "Keep");
+    EXPECT_EQ(poi_ecs_get_type(&poi_world, idx), POI_TYPE_MILITARY);
+    EXPECT_EQ(poi_ecs_get_satisfaction_bonus(&poi_world, idx), 12);
+    EXPECT_FLOAT_EQ(poi_ecs_get_radius(&poi_world, idx), 25.0f);
+    EXPECT_TRUE(poi_ecs_is_visited(&poi_world, idx));
+}
+
 TEST_F(POIEcsTest, VisitState) {
     POICreateParams params = make_poi_params(
         "Visitable POI", POI_TYPE_HISTORICAL, POI_TIER_GENERAL,
@@ -158,6 +560,97 @@ TEST_F(POIEcsTest, TypeStringConversion) {
     EXPECT_EQ(poi_type_from_string("Military"), POI_TYPE_MILITARY);
 }
 
+TEST_F(POIEcsTest, RenderMarkersCopyPretessellatedMeshes) {
+    POICreateParams nature = make_poi_params("Nature", POI_TYPE_NATURE, POI_TIER_GENERAL, 100.0f, 200.0f, 50.0f);
+    POICreateParams fort = make_poi_params("Fort", POI_TYPE_MILITARY, POI_TIER_SPECIAL, -300.0f, 0.0f, 80.0f);
+    POICreateParams ruin = make_poi_params("Ruin", POI_TYPE_HISTORICAL, POI_TIER_GENERAL, 0.0f, 0.0f, 60.0f);
+    ASSERT_GE(poi_ecs_create(&poi_world, &nature), 0);
+    ASSERT_GE(poi_ecs_create(&poi_world, &fort), 0);
+    int ruin_index = poi_ecs_create(&poi_world, &ruin);
+    ASSERT_GE(ruin_index, 0);
+    poi_ecs_set_visited(&poi_world, ruin_index, true);
+
+    TriangleBatch batch;
+    renderer_triangle_batch_init(&batch);
+    int pois[] = {0, 1, 2};
+    uint32_t icons_first = poi_render_batch_markers(&batch, &poi_world, nullptr, pois, 3);
+
+    // Areas are 36-segment fans; icons 1, 5 and 3 triangles, the special
+    // ring 72 and the visited check 12
+    EXPECT_EQ(icons_first, 3u * 108u);
+    EXPECT_EQ(batch.count - icons_first, 3u + (15u + 216u) + (9u + 36u));
+
+    // First area is the unit circle scaled to the radius, around the POI
+    float max_dx = 0.0f;
+    for (uint32_t v = 0; v < 108; v++) {
+        max_dx = std::max(max_dx, std::fabs(batch.x[v] - 100.0f));
+    }
+    EXPECT_NEAR(max_dx, 50.0f, 0.01f);
+
+    // Nature icon: its apex 12 above the POI
+    EXPECT_FLOAT_EQ(batch.x[icons_first], 100.0f);
+    EXPECT_FLOAT_EQ(batch.y[icons_first], 188.0f);
+
+    // Same POIs give the same vertices
+    std::vector<float> first_x(batch.x, batch.x + batch.count);
+    renderer_triangle_batch_clear(&batch);
+    poi_render_batch_markers(&batch, &poi_world, nullptr, pois, 3);
+    ASSERT_EQ(batch.count, (uint32_t)first_x.size());
+    EXPECT_TRUE(std::equal(first_x.begin(), first_x.end(), batch.x));
+
+    // Without a window there is no font atlas, so no labels
+    GlyphBatch labels;
+    renderer_glyph_batch_init(&labels, Texture2D{});
+    EXPECT_EQ(poi_render_batch_labels(&labels, &poi_world, nullptr, pois, 3), 0u);
+    EXPECT_FLOAT_EQ(poi_render_label_width(0), 0.0f);
+
+    renderer_glyph_batch_shutdown(&labels);
+    renderer_triangle_batch_shutdown(&batch);
+    poi_render_shutdown();
+}
+
+TEST_F(POIEcsTest, RenderLabelsFollowThePOISet) {
+    // A one-glyph font, so labels lay out without a window
+    GlyphInfo glyph = {};
+    Rectangle rec = Rectangle{0.0f, 0.0f, 6.0f, 8.0f};
+    glyph.value = 'A';
+    Font font = {};
+    font.baseSize = 10;
+    font.glyphCount = 1;
+    font.glyphs = &glyph;
+    font.recs = &rec;
+    font.texture.id = 1;
+    font.texture.width = 64;
+    font.texture.height = 64;
+    
+    POICreateParams a = make_poi_params("A", POI_TYPE_NATURE, POI_TIER_GENERAL, 0.0f, 0.0f);
+    POICreateParams b = make_poi_params("AAA", POI_TYPE_NATURE, POI_TIER_GENERAL, 500.0f, 0.0f);
+    ASSERT_EQ(poi_ecs_create(&poi_world, &a), 0);
+    ASSERT_TRUE(poi_render_prepare_labels(&poi_world, font));
+    float one_glyph = poi_render_label_width(0);
+    EXPECT_GT(one_glyph, 0.0f);
+    
+    // Same set: the layout is reused rather than redone in the (headless) default font
+    GlyphBatch labels;
+    renderer_glyph_batch_init(&labels, Texture2D{});
+    int pois[] = {0};
+    EXPECT_EQ(poi_render_batch_labels(&labels, &poi_world, nullptr, pois, 1), 1u);
+    EXPECT_FLOAT_EQ(poi_render_label_width(0), one_glyph);
+    
+    // Swapping one POI for another keeps the count but not the layout
+    poi_ecs_destroy(&poi_world, 0);
+    ASSERT_EQ(poi_ecs_create(&poi_world, &b), 0);
+    ASSERT_TRUE(poi_render_prepare_labels(&poi_world, font));
+    EXPECT_GT(poi_render_label_width(0), one_glyph);
+    poi_ecs_destroy(&poi_world, 0);
+    ASSERT_EQ(poi_ecs_create(&poi_world, &a), 0);
+    poi_render_batch_labels(&labels, &poi_world, nullptr, pois, 1);
+    EXPECT_FLOAT_EQ(poi_render_label_width(0), 0.0f);   // Laid out again, headless
+    
+    renderer_glyph_batch_shutdown(&labels);
+    poi_render_shutdown();
+}
+
 // =============================================================================
 // Fog of War Tests
 // =============================================================================
@@ -202,6 +695,15 @@ TEST_F(FogOfWarTest, FogAlphaWithPrototypeMode) {
     EXPECT_FLOAT_EQ(alpha, 1.0f);  // Full fog for hidden POIs
 }
 
+TEST_F(FogOfWarTest, GrowsWithPOIIndices) {
+    // Indices beyond the initial capacity grow the arrays, new entries hidden
+    fog_reveal_poi(&fog, 5000);
+    EXPECT_GE(fog.poi_capacity, 5001u);
+    EXPECT_EQ(fog_get_poi_visibility(&fog, 5000), VISIBILITY_VISIBLE);
+    EXPECT_EQ(fog_get_poi_visibility(&fog, 4999), VISIBILITY_HIDDEN);
+    EXPECT_FLOAT_EQ(fog_get_poi_alpha(&fog, 4999), 1.0f);
+}
+
 TEST_F(FogOfWarTest, DisabledFog) {
     fog_set_enabled(&fog, false);
     
@@ -220,10 +722,12 @@ protected:
     
     void SetUp() override {
         poi_ecs_init(&poi_world);
+        satisfaction_tour_init(&tour);
         satisfaction_tour_start(&tour);
     }
     
     void TearDown() override {
+        satisfaction_tour_shutdown(&tour);
         poi_ecs_shutdown(&poi_world);
     }
 };
@@ -245,7 +749,8 @@ TEST_F(SatisfactionTest, RecordPOIVisit) {
     
     EXPECT_GT(bonus, 0);
     EXPECT_EQ(tour.visited_count, 1u);
-    EXPECT_TRUE(tour.has_nature);
+    EXPECT_EQ(tour.type_counts[POI_TYPE_NATURE], 1u);
+    EXPECT_TRUE(satisfaction_was_poi_visited(&tour, idx));
 }
 
 TEST_F(SatisfactionTest, NoDuplicateVisits) {
@@ -285,6 +790,40 @@ TEST_F(SatisfactionTest, VarietyBonus) {
     EXPECT_EQ(tour.variety_bonus, config.variety_bonus_3_types);
 }
 
+TEST_F(SatisfactionTest, LongToursHaveNoVisitCap) {
+    for (int i = 0; i < 500; i++) {
+        std::string name = "POI " + std::to_string(i);
+        POIType type = (POIType)(i % POI_TYPE_COUNT);
+        POITier tier = (i % 10 == 0) ? POI_TIER_SPECIAL : POI_TIER_GENERAL;
+        POICreateParams params = make_poi_params(name.c_str(), type, tier, (float)i * 10.0f, 0.0f);
+        ASSERT_EQ(poi_ecs_create(&poi_world, &params), i);
+    }
+    for (int i = 0; i < 500; i += 2) {
+        EXPECT_GT(satisfaction_record_poi_visit(&tour, &poi_world, i), 0);
+    }
+    
+    TourStats stats = satisfaction_get_tour_stats(&tour);
+    EXPECT_EQ(stats.pois_visited, 250u);
+    EXPECT_EQ(stats.nature_visited + stats.historical_visited + stats.military_visited, 250u);
+    EXPECT_EQ(stats.nature_visited, 84u);   // Even i with i % 3 == 0
+    EXPECT_EQ(stats.special_visited, 50u);
+    EXPECT_TRUE(satisfaction_was_poi_visited(&tour, 498));
+    EXPECT_FALSE(satisfaction_was_poi_visited(&tour, 499));
+    
+    // Popcount over a POI set: 0..99 holds 50 visited (even) POIs
+    Bitset first_hundred;
+    ASSERT_TRUE(bitset_init(&first_hundred, 100));
+    for (uint32_t i = 0; i < 100; i++) bitset_set(&first_hundred, i);
+    EXPECT_EQ(satisfaction_count_visited_in(&tour, &first_hundred), 50u);
+    bitset_shutdown(&first_hundred);
+    
+    // Restarting keeps the memory but forgets the visits
+    satisfaction_tour_start(&tour);
+    EXPECT_EQ(tour.visited_count, 0u);
+    EXPECT_FALSE(satisfaction_was_poi_visited(&tour, 0));
+    EXPECT_GT(satisfaction_record_poi_visit(&tour, &poi_world, 0), 0);
+}
+
 TEST_F(SatisfactionTest, ScoreCalculation) {
     POICreateParams params = make_poi_params(
         "Test POI", POI_TYPE_NATURE, POI_TIER_GENERAL,
@@ -319,6 +858,406 @@ TEST_F(SatisfactionTest, TourEnd) {
     EXPECT_GT(tour.total_satisfaction, 0);
 }
 
+// =============================================================================
+// Fleet Satisfaction Tests
+// =============================================================================
+
+class FleetSatisfactionTest : public ::testing::Test {
+protected:
+    POIEcsWorld poi_world;
+    ECSWorld* ecs_world = nullptr;
+    TourEcsWorld* tour_world = nullptr;
+    EventRingReader reader;
+    
+    void SetUp() override {
+        poi_ecs_init(&poi_world);
+        ecs_world = new ECSWorld;
+        ecs_world_init(ecs_world);
+        tour_world = new TourEcsWorld;
+        tour_ecs_init(tour_world, nullptr);
+        poi_ecs_events_reader_init(&poi_world, &reader);
+    }
+    
+    void TearDown() override {
+        tour_ecs_shutdown(tour_world);
+        delete tour_world;
+        delete ecs_world;
+        poi_ecs_shutdown(&poi_world);
+    }
+    
+    void create_pois(int count) {
+        for (int i = 0; i < count; i++) {
+            std::string name = "POI " + std::to_string(i);
+            POIType type = (POIType)((i * 7) % POI_TYPE_COUNT);
+            POITier tier = (i % 5 == 0) ? POI_TIER_SPECIAL : POI_TIER_GENERAL;
+            POICreateParams params = make_poi_params(name.c_str(), type, tier, (float)i * 100.0f, 0.0f,
+                                                     0.0f, 1 + i % 4);
+            ASSERT_EQ(poi_ecs_create(&poi_world, &params), i);
+        }
+    }
+    
+    Entity add_passenger_ship() {
+        Entity ship = ecs_create_entity(ecs_world);
+        ecs_add_component(ecs_world, ship, COMPONENT_TOUR);
+        tour_ecs_start(tour_world, ship);
+        return ship;
+    }
+    
+    // Stand-in for poi_ecs_system_update: push an enter event directly
+    void push_enter(Entity ship, int poi_index) {
+        POIEvent event = {};
+        event.poi_index = (uint32_t)poi_index;
+        event.ship = ship;
+        event.type = POI_EVENT_ENTER;
+        event_ring_push(&poi_world.events, &event);
+    }
+};
+
+TEST_F(FleetSatisfactionTest, MatchesSingleTourScoring) {
+    create_pois(40);
+    
+    const int ship_count = 20;
+    std::vector<Entity> ships;
+    std::vector<TourSatisfaction> reference(ship_count);
+    for (int s = 0; s < ship_count; s++) {
+        ships.push_back(add_passenger_ship());
+        satisfaction_tour_init(&reference[s]);
+        satisfaction_tour_start(&reference[s]);
+    }
+    
+    // Several ticks of visits, with repeats that must not count twice
+    for (int tick = 0; tick < 4; tick++) {
+        for (int s = 0; s < ship_count; s++) {
+            for (int k = 0; k < 3; k++) {
+                int poi = (s * 3 + tick * 5 + k * 11) % 40;
+                push_enter(ships[s], poi);
+                satisfaction_record_poi_visit(&reference[s], &poi_world, poi);
+            }
+        }
+        satisfaction_system_update(tour_world, ecs_world, &poi_world, &reader);
+    }
+    
+    for (int s = 0; s < ship_count; s++) {
+        TourStats fleet = tour_ecs_get_stats(tour_world, ships[s]);
+        TourStats single = satisfaction_get_tour_stats(&reference[s]);
+        EXPECT_EQ(fleet.total_satisfaction, single.total_satisfaction) << "ship " << s;
+        EXPECT_EQ(fleet.pois_visited, single.pois_visited);
+        EXPECT_EQ(fleet.poi_bonus, single.poi_bonus);
+        EXPECT_EQ(fleet.variety_bonus, single.variety_bonus);
+        EXPECT_EQ(fleet.nature_visited, single.nature_visited);
+        EXPECT_EQ(fleet.special_visited, single.special_visited);
+        satisfaction_tour_shutdown(&reference[s]);
+    }
+}
+
+TEST_F(FleetSatisfactionTest, IgnoresShipsWithoutTours) {
+    create_pois(3);
+    Entity passenger = add_passenger_ship();
+    Entity cargo = ecs_create_entity(ecs_world);     // No COMPONENT_TOUR
+    Entity ended = add_passenger_ship();
+    tour_ecs_end(tour_world, ended);
+    
+    push_enter(passenger, 0);
+    push_enter(cargo, 0);
+    push_enter(ended, 0);
+    push_enter(passenger, 1);
+    
+    EXPECT_EQ(satisfaction_system_update(tour_world, ecs_world, &poi_world, &reader), 2u);
+    EXPECT_EQ(tour_ecs_get_stats(tour_world, passenger).pois_visited, 2u);
+    EXPECT_EQ(tour_ecs_get_stats(tour_world, cargo).pois_visited, 0u);
+    EXPECT_EQ(tour_ecs_get_stats(tour_world, ended).pois_visited, 0u);
+    EXPECT_GT(tour_ecs_get_score(tour_world, passenger), BASE_SATISFACTION);
+}
+
+TEST_F(FleetSatisfactionTest, VisitsFollowPOIDestroy) {
+    create_pois(3);
+    Entity ship = add_passenger_ship();
+    push_enter(ship, 0);
+    push_enter(ship, 2);
+    EXPECT_EQ(satisfaction_system_update(tour_world, ecs_world, &poi_world, &reader), 2u);
+    
+    // "POI 2" moves into slot 0 and keeps its visit; slot 2 is free again
+    poi_ecs_destroy(&poi_world, 0);
+    EXPECT_EQ(satisfaction_system_update(tour_world, ecs_world, &poi_world, &reader), 0u);
+    const Bitset* visited = &tour_world->tours.visited[ship];
+    EXPECT_TRUE(bitset_test(visited, 0));
+    EXPECT_FALSE(bitset_test(visited, 1));
+    EXPECT_FALSE(bitset_test(visited, 2));
+    
+    push_enter(ship, 0);
+    EXPECT_EQ(satisfaction_system_update(tour_world, ecs_world, &poi_world, &reader), 0u);
+    
+    // A POI created in the freed slot is a new visit, scored from its own data
+    POICreateParams params = make_poi_params("New", POI_TYPE_MILITARY, POI_TIER_GENERAL, 0.0f, 0.0f, 0.0f, 7);
+    ASSERT_EQ(poi_ecs_create(&poi_world, &params), 2);
+    int bonus_before = tour_ecs_get_stats(tour_world, ship).poi_bonus;
+    push_enter(ship, 2);
+    EXPECT_EQ(satisfaction_system_update(tour_world, ecs_world, &poi_world, &reader), 1u);
+    TourStats stats = tour_ecs_get_stats(tour_world, ship);
+    EXPECT_EQ(stats.pois_visited, 3u);
+    EXPECT_EQ(stats.poi_bonus - bonus_before,
+              satisfaction_calculate_poi_bonus(&poi_world, 2, &tour_world->config));
+}
+
+TEST_F(FleetSatisfactionTest, ConfigChangeRebuildsTables) {
+    create_pois(1);     // POI 0: special nature, bonus 1
+    Entity ship = add_passenger_ship();
+    
+    SatisfactionConfig config = satisfaction_get_default_config();
+    config.special_tier_multiplier = 10.0f;
+    config.base_satisfaction = 20;
+    tour_ecs_set_config(tour_world, &config);
+    
+    push_enter(ship, 0);
+    satisfaction_system_update(tour_world, ecs_world, &poi_world, &reader);
+    EXPECT_EQ(tour_ecs_get_score(tour_world, ship), 20 + 10);
+}
+
+TEST_F(FleetSatisfactionTest, DISABLED_Benchmark1000Ferries) {
+    create_pois(2000);
+    
+    // Fill the ECS with ferries (entity 0 is reserved)
+    std::vector<Entity> ships;
+    for (int s = 0; s < MAX_ENTITIES - 1; s++) {
+        ships.push_back(add_passenger_ship());
+    }
+    
+    const int ticks = 1000;
+    auto start = std::chrono::high_resolution_clock::now();
+    uint32_t visits = 0;
+    for (int tick = 0; tick < ticks; tick++) {
+        // A few ferries reach a POI each tick
+        for (int k = 0; k < 8; k++) {
+            push_enter(ships[(tick * 8 + k) % ships.size()], (tick * 13 + k * 101) % 2000);
+        }
+        visits += satisfaction_system_update(tour_world, ecs_world, &poi_world, &reader);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count();
+    
+    std::cout << "[Benchmark] satisfaction_system_update, " << ships.size() << " ferries: "
+              << us / ticks << " us/tick (" << visits << " visits)" << std::endl;
+    EXPECT_EQ(visits, (uint32_t)ticks * 8);
+    EXPECT_LT(us / ticks, 1000.0);
+}
+
+// =============================================================================
+// Route Planner Tests
+// =============================================================================
+
+class RoutePlannerTest : public ::testing::Test {
+protected:
+    POIEcsWorld poi_world;
+    JobSystem jobs;
+    RoutePlanner planner;
+    
+    void SetUp() override {
+        poi_ecs_init(&poi_world);
+        jobs_init(&jobs, 0);
+        route_planner_init(&planner, &jobs, nullptr);
+    }
+    
+    void TearDown() override {
+        route_planner_shutdown(&planner);
+        jobs_shutdown(&jobs);
+        poi_ecs_shutdown(&poi_world);
+    }
+    
+    // Scatter POIs over a size x size area with a fixed LCG
+    void scatter_pois(int count, float size) {
+        uint32_t rng = 12345u;
+        auto next = [&rng]() { rng = rng * 1664525u + 1013904223u; return (rng >> 8) / 16777216.0f; };
+        for (int i = 0; i < count; i++) {
+            std::string name = "Site " + std::to_string(i);
+            POIType type = (POIType)(i % POI_TYPE_COUNT);
+            POITier tier = (i % 9 == 0) ? POI_TIER_SPECIAL : POI_TIER_GENERAL;
+            POICreateParams params = make_poi_params(name.c_str(), type, tier, next() * size, next() * size,
+                                                     0.0f, 1 + (int)(next() * 10.0f));
+            ASSERT_EQ(poi_ecs_create(&poi_world, &params), i);
+        }
+        poi_ecs_rebuild_index(&poi_world);
+    }
+    
+    float route_length(const RoutePlan& plan) {
+        float x = plan.start_x, y = plan.start_y, length = 0.0f;
+        for (uint32_t i = 0; i < plan.stop_count; i++) {
+            float px, py;
+            poi_ecs_get_position(&poi_world, plan.stops[i], &px, &py);
+            length += std::sqrt((px - x) * (px - x) + (py - y) * (py - y));
+            x = px;
+            y = py;
+        }
+        if (plan.return_to_start) {
+            length += std::sqrt((plan.start_x - x) * (plan.start_x - x) + (plan.start_y - y) * (plan.start_y - y));
+        }
+        return length;
+    }
+    
+    // Recompute the bonus a tour along the plan would earn
+    int route_bonus(const RoutePlan& plan) {
+        TourSatisfaction tour;
+        satisfaction_tour_init(&tour);
+        satisfaction_tour_start(&tour);
+        for (uint32_t i = 0; i < plan.stop_count; i++) {
+            satisfaction_record_poi_visit(&tour, &poi_world, plan.stops[i]);
+        }
+        int bonus = tour.poi_bonus_total + tour.variety_bonus;
+        satisfaction_tour_shutdown(&tour);
+        return bonus;
+    }
+    
+    // Baseline: always sail to the best bonus per distance that still fits
+    int nearest_greedy_bonus(const RoutePlanRequest& request, float budget) {
+        SatisfactionConfig config = satisfaction_get_default_config();
+        uint32_t count = poi_ecs_get_count(&poi_world);
+        std::vector<bool> used(count, false);
+        RoutePlan plan = {};
+        plan.start_x = request.start_x;
+        plan.start_y = request.start_y;
+        float x = request.start_x, y = request.start_y, length = 0.0f;
+        for (;;) {
+            int best = -1;
+            float best_score = 0.0f, best_leg = 0.0f;
+            for (uint32_t i = 0; i < count; i++) {
+                if (used[i]) continue;
+                float px, py;
+                poi_ecs_get_position(&poi_world, (int)i, &px, &py);
+                float leg = std::sqrt((px - x) * (px - x) + (py - y) * (py - y));
+                float back = std::sqrt((px - request.start_x) * (px - request.start_x) +
+                                       (py - request.start_y) * (py - request.start_y));
+                if (length + leg + back > budget) continue;
+                float score = satisfaction_calculate_poi_bonus(&poi_world, (int)i, &config) / (leg + 1.0f);
+                if (score > best_score) {
+                    best = (int)i;
+                    best_score = score;
+                    best_leg = leg;
+                }
+            }
+            if (best < 0 || plan.stop_count == ROUTE_MAX_STOPS) break;
+            used[best] = true;
+            length += best_leg;
+            poi_ecs_get_position(&poi_world, best, &x, &y);
+            plan.stops[plan.stop_count++] = best;
+        }
+        return route_bonus(plan);
+    }
+};
+
+TEST_F(RoutePlannerTest, StaysWithinBudget) {
+    scatter_pois(200, 4000.0f);
+    
+    RoutePlanRequest request = route_plan_request_default(2000.0f, 2000.0f);
+    request.time_budget = 40.0f;
+    request.cruise_speed = 150.0f;      // 6000 units round trip
+    request.max_iterations = 200;
+    
+    RoutePlan plan;
+    ASSERT_TRUE(route_planner_plan(&planner, &poi_world, &request, &plan));
+    EXPECT_GT(plan.stop_count, 2u);
+    EXPECT_LE(plan.length, 6000.0f + 0.5f);
+    EXPECT_NEAR(plan.length, route_length(plan), 1.0f);
+    EXPECT_EQ(plan.bonus, route_bonus(plan));
+    
+    // Every stop is distinct
+    std::vector<int> stops(plan.stops, plan.stops + plan.stop_count);
+    std::sort(stops.begin(), stops.end());
+    EXPECT_EQ(std::unique(stops.begin(), stops.end()), stops.end());
+}
+
+TEST_F(RoutePlannerTest, PicksValuableDetourOverCloseFiller) {
+    // Two cheap POIs nearby, one special POI a little further that fits only alone
+    POICreateParams near_a = make_poi_params("Near A", POI_TYPE_NATURE, POI_TIER_GENERAL, 100.0f, 0.0f, 0.0f, 1);
+    POICreateParams near_b = make_poi_params("Near B", POI_TYPE_NATURE, POI_TIER_GENERAL, -100.0f, 0.0f, 0.0f, 1);
+    POICreateParams far = make_poi_params("Fort", POI_TYPE_MILITARY, POI_TIER_SPECIAL, 0.0f, 450.0f, 0.0f, 20);
+    poi_ecs_create(&poi_world, &near_a);
+    poi_ecs_create(&poi_world, &near_b);
+    int fort = poi_ecs_create(&poi_world, &far);
+    poi_ecs_rebuild_index(&poi_world);
+    
+    RoutePlanRequest request = route_plan_request_default(0.0f, 0.0f);
+    request.distance_budget = 950.0f;
+    request.max_iterations = 50;
+    
+    RoutePlan plan;
+    ASSERT_TRUE(route_planner_plan(&planner, &poi_world, &request, &plan));
+    ASSERT_EQ(plan.stop_count, 1u);
+    EXPECT_EQ(plan.stops[0], fort);
+    EXPECT_EQ(plan.satisfaction, BASE_SATISFACTION + plan.bonus);
+}
+
+TEST_F(RoutePlannerTest, UnreachablePOIsGiveNoRoute) {
+    scatter_pois(10, 1000.0f);
+    
+    RoutePlanRequest request = route_plan_request_default(50000.0f, 50000.0f);
+    request.distance_budget = 500.0f;
+    
+    RoutePlan plan;
+    EXPECT_FALSE(route_planner_plan(&planner, &poi_world, &request, &plan));
+    EXPECT_FALSE(plan.valid);
+    EXPECT_EQ(plan.stop_count, 0u);
+}
+
+TEST_F(RoutePlannerTest, ReusesDistanceMatrixForSameCandidates) {
+    scatter_pois(50, 1000.0f);
+    std::vector<int> candidates(50);
+    for (int i = 0; i < 50; i++) candidates[i] = i;
+    
+    RoutePlanRequest request = route_plan_request_default(500.0f, 500.0f);
+    request.distance_budget = 3000.0f;
+    request.candidates = candidates.data();
+    request.candidate_count = 50;
+    request.max_iterations = 20;
+    
+    RoutePlan first, moved;
+    ASSERT_TRUE(route_planner_plan(&planner, &poi_world, &request, &first));
+    request.start_x = 100.0f;
+    ASSERT_TRUE(route_planner_plan(&planner, &poi_world, &request, &moved));
+    EXPECT_EQ(planner.matrix_builds, 1u);
+    EXPECT_NEAR(moved.length, route_length(moved), 1.0f);
+    
+    route_planner_invalidate(&planner);
+    ASSERT_TRUE(route_planner_plan(&planner, &poi_world, &request, &moved));
+    EXPECT_EQ(planner.matrix_builds, 2u);
+}
+
+TEST_F(RoutePlannerTest, BeatsNearestGreedy) {
+    scatter_pois(500, 10000.0f);
+    
+    // Fixed round count, so the result does not depend on machine speed
+    RoutePlanRequest request = route_plan_request_default(5000.0f, 5000.0f);
+    request.distance_budget = 30000.0f;
+    request.max_iterations = 300;
+    
+    RoutePlan plan;
+    ASSERT_TRUE(route_planner_plan(&planner, &poi_world, &request, &plan));
+    EXPECT_GT(plan.bonus, nearest_greedy_bonus(request, 30000.0f));
+    EXPECT_LE(plan.length, 30000.0f + 0.5f);
+}
+
+TEST_F(RoutePlannerTest, DISABLED_Benchmark500Candidates) {
+    scatter_pois(500, 10000.0f);
+    
+    RoutePlanRequest request = route_plan_request_default(5000.0f, 5000.0f);
+    request.time_budget = 200.0f;
+    request.cruise_speed = 150.0f;      // 30000 units round trip
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    RoutePlan plan;
+    ASSERT_TRUE(route_planner_plan(&planner, &poi_world, &request, &plan));
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    
+    int greedy = nearest_greedy_bonus(request, 30000.0f);
+    std::cout << "[Benchmark] route_planner_plan, " << plan.candidate_count << " candidates, "
+              << jobs_thread_count(&jobs) << " threads: " << ms << " ms, " << plan.stop_count
+              << " stops, bonus " << plan.bonus << " (nearest-greedy " << greedy << "), "
+              << plan.iterations << " rounds" << std::endl;
+    EXPECT_EQ(plan.candidate_count, 500u);
+    EXPECT_LE(plan.length, 30000.0f + 0.5f);
+    EXPECT_EQ(plan.bonus, route_bonus(plan));
+    EXPECT_LT(ms, 2000.0);
+}
+
 // =============================================================================
 // POI Loader Tests (using string parsing)
 // =============================================================================
@@ -362,6 +1301,24 @@ TEST_F(POILoaderTest, LoadFromValidJSON) {
     EXPECT_EQ(poi_ecs_get_tier(&poi_world, 0), POI_TIER_SPECIAL);
 }
 
+TEST_F(POILoaderTest, LoadParsesIds) {
+    const char* json = R"({
+        "version": "1.0",
+        "pois": [
+            {"id": "poi_one", "name": "POI 1", "type": "nature", "tier": "general", "position": {"x": 0, "y": 0}},
+            {"id": "poi_two", "name": "POI 2", "type": "nature", "tier": "general", "position": {"x": 50, "y": 0}},
+            {"id": "poi_one", "name": "Duplicate", "type": "nature", "tier": "general", "position": {"x": 90, "y": 0}}
+        ]
+    })";
+    
+    POILoadResult result = poi_load_from_string(&poi_world, json);
+    
+    EXPECT_EQ(result, POI_LOAD_SUCCESS);
+    EXPECT_EQ(poi_ecs_get_count(&poi_world), 2u);
+    EXPECT_STREQ(poi_ecs_get_name(&poi_world, poi_ecs_find_by_id(&poi_world, "poi_two")), "POI 2");
+    EXPECT_EQ(poi_ecs_find_by_name(&poi_world, "Duplicate"), -1);
+}
+
 TEST_F(POILoaderTest, LoadMultiplePOIs) {
     const char* json = R"({
         "version": "1.0",
@@ -400,3 +1357,286 @@ TEST_F(POILoaderTest, LoadDefaults) {
     // Should have at least a few default POIs
     EXPECT_GE(poi_ecs_get_count(&poi_world), 3u);
 }
+
+// Generated dataset exercising optional, unknown and nested fields
+static std::string make_loader_json(int count) {
+    std::string json = "{\"version\": \"1.0\", \"meta\": {\"pois\": 1}, \"pois\": [";
+    char entry[512];
+    for (int i = 0; i < count; i++) {
+        snprintf(entry, sizeof(entry),
+                 "%s{\"id\": \"poi_%d\", \"name\": \"POI \\\"%d\\\" \\u00e5\", \"type\": \"%s\", "
+                 "\"tier\": \"%s\", \"position\": {\"x\": %d.25, \"y\": -%d, \"z\": [1, {\"x\": 9}]}, "
+                 "\"radius\": %d, \"satisfaction_bonus\": %d, \"tags\": [\"a\", {\"name\": \"nested\"}], "
+                 "\"description\": \"Generated POI number %d\"}",
+                 i ? ", " : "", i, i, (i % 3) == 0 ? "nature" : ((i % 3) == 1 ? "historical" : "military"),
+                 (i % 5) ? "general" : "special", (i * 37) % 20000, (i * 91) % 20000,
+                 30 + i % 40, i % 7, i);
+        json += entry;
+    }
+    json += ", 42, {\"name\": \"Missing fields\"}]}";
+    return json;
+}
+
+static void expect_same_pois(const POIEcsWorld* a, const POIEcsWorld* b) {
+    ASSERT_EQ(poi_ecs_get_count(a), poi_ecs_get_count(b));
+    for (int i = 0; i < (int)poi_ecs_get_count(a); i++) {
+        EXPECT_STREQ(poi_ecs_get_id(a, i), poi_ecs_get_id(b, i));
+        EXPECT_STREQ(poi_ecs_get_name(a, i), poi_ecs_get_name(b, i));
+        EXPECT_STREQ(poi_ecs_get_description(a, i), poi_ecs_get_description(b, i));
+        EXPECT_EQ(poi_ecs_get_type(a, i), poi_ecs_get_type(b, i));
+        EXPECT_EQ(poi_ecs_get_tier(a, i), poi_ecs_get_tier(b, i));
+        EXPECT_EQ(poi_ecs_get_radius(a, i), poi_ecs_get_radius(b, i));
+        EXPECT_EQ(poi_ecs_get_satisfaction_bonus(a, i), poi_ecs_get_satisfaction_bonus(b, i));
+        float ax, ay, bx, by;
+        poi_ecs_get_position(a, i, &ax, &ay);
+        poi_ecs_get_position(b, i, &bx, &by);
+        EXPECT_EQ(ax, bx);
+        EXPECT_EQ(ay, by);
+    }
+}
+
+TEST_F(POILoaderTest, StreamingMatchesDOMLoader) {
+    const std::string json = make_loader_json(200);
+    POIEcsWorld dom;
+    poi_ecs_init(&dom);
+    ASSERT_EQ(poi_load_from_string_dom(&dom, json.c_str()), POI_LOAD_SUCCESS);
+    ASSERT_EQ(poi_load_from_string(&poi_world, json.c_str()), POI_LOAD_SUCCESS);
+    
+    EXPECT_EQ(poi_ecs_get_count(&poi_world), 200u);
+    EXPECT_STREQ(poi_ecs_get_name(&poi_world, 3), "POI \"3\" \xC3\xA5");
+    expect_same_pois(&dom, &poi_world);
+    
+    // Chunk boundaries anywhere give the same result
+    for (size_t chunk : {1u, 13u, 4096u}) {
+        POIStreamLoader loader;
+        ASSERT_EQ(poi_stream_begin(&loader, &poi_world), POI_LOAD_SUCCESS);
+        for (size_t i = 0; i < json.size(); i += chunk) {
+            poi_stream_feed(&loader, json.data() + i, std::min(chunk, json.size() - i));
+        }
+        ASSERT_EQ(poi_stream_finish(&loader), POI_LOAD_SUCCESS) << "chunk " << chunk;
+        expect_same_pois(&dom, &poi_world);
+    }
+    
+    poi_ecs_shutdown(&dom);
+}
+
+TEST_F(POILoaderTest, TruncatedJSONLeavesWorldEmpty) {
+    std::string json = make_loader_json(10);
+    json.resize(json.size() / 2);
+    
+    poi_load_defaults(&poi_world);
+    EXPECT_EQ(poi_load_from_string(&poi_world, json.c_str()), POI_LOAD_PARSE_ERROR);
+    EXPECT_EQ(poi_ecs_get_count(&poi_world), 0u);
+    
+    // Schema errors are detected before anything is cleared
+    poi_load_defaults(&poi_world);
+    uint32_t defaults = poi_ecs_get_count(&poi_world);
+    EXPECT_EQ(poi_load_from_string(&poi_world, R"({"pois": {"name": "x"}})"), POI_LOAD_INVALID_SCHEMA);
+    EXPECT_EQ(poi_load_from_string(&poi_world, R"([{"pois": []}])"), POI_LOAD_INVALID_SCHEMA);
+    EXPECT_EQ(poi_ecs_get_count(&poi_world), defaults);
+}
+
+TEST_F(POILoaderTest, DISABLED_BenchmarkStreamsLargeFile) {
+    const int poi_count = 50000;
+    const char* path = "test_pois_large.json";
+    const std::string json = make_loader_json(poi_count);
+    ASSERT_GT(json.size(), 1024u * 1024u);  // Beyond the old 1 MB limit
+    
+    FILE* file = fopen(path, "wb");
+    ASSERT_NE(file, nullptr);
+    fwrite(json.data(), 1, json.size(), file);
+    fclose(file);
+    
+    POIEcsWorld dom;
+    poi_ecs_init(&dom);
+    
+    auto t0 = std::chrono::high_resolution_clock::now();
+    ASSERT_EQ(poi_load_from_string_dom(&dom, json.c_str()), POI_LOAD_SUCCESS);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    ASSERT_EQ(poi_load_from_string(&poi_world, json.c_str()), POI_LOAD_SUCCESS);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    ASSERT_EQ(poi_load_from_json_file(&poi_world, path), POI_LOAD_SUCCESS);
+    auto t3 = std::chrono::high_resolution_clock::now();
+    
+    EXPECT_EQ(poi_ecs_get_count(&poi_world), (uint32_t)poi_count);
+    EXPECT_EQ(poi_validate_file(path), POI_LOAD_SUCCESS);
+    expect_same_pois(&dom, &poi_world);
+    
+    auto us = [](auto a, auto b) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(b - a).count();
+    };
+    std::cout << "JSON size: " << json.size() / 1024 << " KB, " << poi_count << " POIs" << std::endl;
+    std::cout << "DOM load (string):       " << us(t0, t1) << " us" << std::endl;
+    std::cout << "Streaming load (string): " << us(t1, t2) << " us" << std::endl;
+    std::cout << "Streaming load (file):   " << us(t2, t3) << " us" << std::endl;
+    EXPECT_LT(us(t1, t2), us(t0, t1));
+    
+    poi_ecs_shutdown(&dom);
+    std::remove(path);
+}
+
+// =============================================================================
+// Cooked POI Data Tests
+// =============================================================================
+
+class POICookedTest : public ::testing::Test {
+protected:
+    POIEcsWorld source;
+    POIEcsWorld loaded;
+    const char* json_path = "test_pois_cooked.json";
+    const char* cooked_path = "test_pois_cooked.bin";
+    
+    void SetUp() override {
+        poi_ecs_init(&source);
+        poi_ecs_init(&loaded);
+    }
+    
+    void TearDown() override {
+        poi_ecs_shutdown(&source);
+        poi_ecs_shutdown(&loaded);
+        std::remove(json_path);
+        std::remove(cooked_path);
+    }
+    
+    static void write_text(const char* path, const std::string& text) {
+        FILE* file = fopen(path, "wb");
+        ASSERT_NE(file, nullptr);
+        fwrite(text.data(), 1, text.size(), file);
+        fclose(file);
+    }
+    
+    static std::string make_json(int count) {
+        std::string json = "{\"version\": \"1.0\", \"pois\": [";
+        char entry[256];
+        for (int i = 0; i < count; i++) {
+            snprintf(entry, sizeof(entry),
+                     "%s{\"id\": \"poi_%d\", \"name\": \"POI %d\", \"type\": \"%s\", "
+                     "\"tier\": \"general\", \"position\": {\"x\": %d, \"y\": %d}, "
+                     "\"description\": \"Generated POI number %d\"}",
+                     i ? "," : "", i, i, (i % 2) ? "nature" : "military",
+                     (i * 37) % 20000, (i * 91) % 20000, i);
+            json += entry;
+        }
+        json += "]}";
+        return json;
+    }
+};
+
+TEST_F(POICookedTest, RoundTripMatchesSource) {
+    poi_load_defaults(&source);
+    poi_ecs_set_visited(&source, 1, true);
+    ASSERT_TRUE(poi_cooked_write(&source, cooked_path));
+    
+    ASSERT_EQ(poi_load_cooked(&loaded, cooked_path), POI_LOAD_SUCCESS);
+    ASSERT_EQ(poi_ecs_get_count(&loaded), poi_ecs_get_count(&source));
+    
+    for (int i = 0; i < (int)poi_ecs_get_count(&source); i++) {
+        EXPECT_STREQ(poi_ecs_get_id(&loaded, i), poi_ecs_get_id(&source, i));
+        EXPECT_STREQ(poi_ecs_get_name(&loaded, i), poi_ecs_get_name(&source, i));
+        EXPECT_STREQ(poi_ecs_get_description(&loaded, i), poi_ecs_get_description(&source, i));
+        EXPECT_EQ(poi_ecs_get_type(&loaded, i), poi_ecs_get_type(&source, i));
+        EXPECT_EQ(poi_ecs_get_tier(&loaded, i), poi_ecs_get_tier(&source, i));
+        EXPECT_FLOAT_EQ(poi_ecs_get_radius(&loaded, i), poi_ecs_get_radius(&source, i));
+        EXPECT_EQ(poi_ecs_get_satisfaction_bonus(&loaded, i), poi_ecs_get_satisfaction_bonus(&source, i));
+        EXPECT_EQ(poi_ecs_is_visited(&loaded, i), poi_ecs_is_visited(&source, i));
+    }
+    
+    // Lookups and spatial queries are rebuilt on load
+    EXPECT_EQ(poi_ecs_find_by_id(&loaded, "poi_vinga"), poi_ecs_find_by_id(&source, "poi_vinga"));
+    EXPECT_EQ(poi_ecs_find_by_name(&loaded, "brännö beach"), poi_ecs_find_by_name(&source, "brännö beach"));
+    EXPECT_EQ(poi_ecs_find_at_position(&loaded, 800.0f, 200.0f), poi_ecs_find_at_position(&source, 800.0f, 200.0f));
+    EXPECT_FALSE(loaded.index_dirty);
+}
+
+TEST_F(POICookedTest, MappedWorldStaysMutable) {
+    poi_load_defaults(&source);
+    ASSERT_TRUE(poi_cooked_write(&source, cooked_path));
+    ASSERT_EQ(poi_load_cooked(&loaded, cooked_path), POI_LOAD_SUCCESS);
+    uint32_t count = poi_ecs_get_count(&loaded);
+    
+    // State writes land in private pages, creates move storage to the heap
+    poi_ecs_set_visited(&loaded, 0, true);
+    POICreateParams params = make_poi_params("New Pier", POI_TYPE_NATURE, POI_TIER_GENERAL, 5.0f, 5.0f);
+    int idx = poi_ecs_create(&loaded, &params);
+    ASSERT_EQ(idx, (int)count);
+    EXPECT_TRUE(poi_ecs_is_visited(&loaded, 0));
+    EXPECT_STREQ(poi_ecs_get_name(&loaded, 0), "Vinga Lighthouse");
+    EXPECT_EQ(poi_ecs_find_by_name(&loaded, "new pier"), idx);
+    
+    poi_ecs_destroy(&loaded, 0);
+    EXPECT_EQ(poi_ecs_get_count(&loaded), count);
+    
+    // Clearing releases the mapping; the file itself is untouched
+    poi_ecs_clear(&loaded);
+    ASSERT_EQ(poi_load_cooked(&loaded, cooked_path), POI_LOAD_SUCCESS);
+    EXPECT_FALSE(poi_ecs_is_visited(&loaded, 0));
+    EXPECT_EQ(poi_ecs_get_count(&loaded), count);
+}
+
+TEST_F(POICookedTest, RejectsBadFiles) {
+    EXPECT_EQ(poi_load_cooked(&loaded, "does_not_exist.bin"), POI_LOAD_FILE_NOT_FOUND);
+    
+    write_text(cooked_path, "definitely not a cooked file, just some text padding it out");
+    EXPECT_EQ(poi_load_cooked(&loaded, cooked_path), POI_LOAD_INVALID_SCHEMA);
+    
+    // Wrong version
+    poi_load_defaults(&source);
+    ASSERT_TRUE(poi_cooked_write(&source, cooked_path));
+    FILE* file = fopen(cooked_path, "r+b");
+    ASSERT_NE(file, nullptr);
+    uint32_t bad_version = POI_COOKED_VERSION + 1;
+    fseek(file, offsetof(POICookedHeader, version), SEEK_SET);
+    fwrite(&bad_version, sizeof(bad_version), 1, file);
+    fclose(file);
+    EXPECT_EQ(poi_load_cooked(&loaded, cooked_path), POI_LOAD_VERSION_MISMATCH);
+    EXPECT_EQ(poi_ecs_get_count(&loaded), 0u);
+}
+
+TEST_F(POICookedTest, LoadFromFilePrefersCurrentCookedData) {
+    char derived[64];
+    ASSERT_TRUE(poi_cooked_path_for(json_path, derived, sizeof(derived)));
+    EXPECT_STREQ(derived, cooked_path);
+    
+    // JSON only: fallback path
+    write_text(json_path, make_json(3));
+    ASSERT_EQ(poi_load_from_file(&loaded, json_path), POI_LOAD_SUCCESS);
+    EXPECT_EQ(poi_ecs_get_count(&loaded), 3u);
+    EXPECT_FALSE(file_map_is_open(&loaded.mapped_file));
+    
+    // Cooked data (different content, so the source is observable) wins
+    poi_load_defaults(&source);
+    ASSERT_TRUE(poi_cooked_write(&source, cooked_path));
+    ASSERT_EQ(poi_load_from_file(&loaded, json_path), POI_LOAD_SUCCESS);
+    EXPECT_EQ(poi_ecs_get_count(&loaded), poi_ecs_get_count(&source));
+    EXPECT_TRUE(file_map_is_open(&loaded.mapped_file));
+    
+    // A corrupt cooked file falls back to JSON
+    write_text(cooked_path, "garbage garbage garbage garbage garbage garbage garbage garbage");
+    ASSERT_EQ(poi_load_from_file(&loaded, json_path), POI_LOAD_SUCCESS);
+    EXPECT_EQ(poi_ecs_get_count(&loaded), 3u);
+}
+
+TEST_F(POICookedTest, DISABLED_Benchmark50kLoad) {
+    const int poi_count = 50000;
+    write_text(json_path, make_json(poi_count));
+    
+    auto t0 = std::chrono::high_resolution_clock::now();
+    ASSERT_EQ(poi_load_from_json_file(&source, json_path), POI_LOAD_SUCCESS);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    ASSERT_TRUE(poi_cooked_write(&source, cooked_path));
+    auto t2 = std::chrono::high_resolution_clock::now();
+    ASSERT_EQ(poi_load_cooked(&loaded, cooked_path), POI_LOAD_SUCCESS);
+    auto t3 = std::chrono::high_resolution_clock::now();
+    
+    ASSERT_EQ(poi_ecs_get_count(&loaded), (uint32_t)poi_count);
+    EXPECT_EQ(poi_ecs_find_by_id(&loaded, "poi_49999"), poi_ecs_find_by_id(&source, "poi_49999"));
+    EXPECT_STREQ(poi_ecs_get_description(&loaded, 1234), "Generated POI number 1234");
+    
+    auto us = [](auto a, auto b) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(b - a).count();
+    };
+    std::cout << "JSON load   (" << poi_count << " POIs): " << us(t0, t1) << " us" << std::endl;
+    std::cout << "Cook write  (" << poi_count << " POIs): " << us(t1, t2) << " us" << std::endl;
+    std::cout << "Cooked load (" << poi_count << " POIs): " << us(t2, t3) << " us" << std::endl;
+    EXPECT_LT(us(t2, t3) * 4, us(t0, t1));
+}
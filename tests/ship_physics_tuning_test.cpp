@@ -18,11 +18,17 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <iostream>
+#include <vector>
 
 extern "C" {
     #include "ship_physics.h"
     #include "config.h"
+    #include "engine_ecs.h"
+    #include "game_ship_ecs.h"
 }
 
 // Test fixture for ship physics tuning
@@ -374,3 +380,258 @@ TEST_F(ShipPhysicsTuningTest, ReverseBrake_Effectiveness) {
     }
 }
 
+// =============================================================================
+// Wide Kernel Parity
+//
+// The same scenarios as above (full-speed stop, steer while coasting, U-turn,
+// crawl, reverse brake) driven through the ECS with the wide kernel and the
+// scalar reference side by side. Ships run different scenarios in adjacent
+// lanes, so every select mask is exercised with mixed outcomes.
+// =============================================================================
+
+struct ScenarioPhase {
+    int frames;
+    float throttle;
+    float rudder;
+};
+
+static const std::vector<std::vector<ScenarioPhase>>& parity_scenarios() {
+    static const std::vector<std::vector<ScenarioPhase>> scenarios = {
+        {{420, 1.0f, 0.0f}, {900, 0.0f, 0.0f}},                     // A: full-speed stop
+        {{420, 1.0f, 0.0f}, {60, 0.0f, 1.0f}, {300, 0.0f, 0.0f}},   // A: steer while coasting
+        {{420, 1.0f, 0.0f}, {600, 1.0f, 1.0f}},                     // B: U-turn
+        {{120, 0.15f, 0.0f}, {60, 0.15f, 1.0f}, {300, 0.0f, 0.0f}}, // C: precision crawl
+        {{90, 1.0f, 0.0f}, {400, -1.0f, 0.0f}},                     // Reverse brake
+        {{200, 0.6f, -0.5f}, {200, -0.4f, 0.8f}, {300, 0.0f, -1.0f}} // Mixed
+    };
+    return scenarios;
+}
+
+class ShipPhysicsKernelTest : public ::testing::Test {
+protected:
+    ECSWorld* wide_world = nullptr;
+    ECSWorld* reference_world = nullptr;
+    ShipEcsWorld* wide_ships = nullptr;
+    ShipEcsWorld* reference_ships = nullptr;
+    ShipEcsConfig ship_config;
+    
+    void SetUp() override {
+        ShipPhysicsConfig physics;
+        if (!config_load_ship_physics("config.ini", &physics) &&
+            !config_load_ship_physics("../../../config.ini", &physics)) {
+            physics = ship_physics_get_default_config();
+        }
+        ship_config = ship_ecs_get_default_config();
+        ship_config.max_speed = physics.max_speed;
+        ship_config.acceleration = physics.acceleration;
+        ship_config.turn_rate = physics.max_turn_rate;
+        ship_config.throttle_response = physics.throttle_response_time;
+        ship_config.steering_response = physics.steering_response_time;
+        ship_config.coast_friction = physics.coast_friction;
+        ship_config.drift_factor = physics.drift_factor;
+        ship_config.reverse_speed_mult = physics.reverse_speed_multiplier;
+        ship_config.reverse_accel_mult = physics.reverse_accel_multiplier;
+        ship_config.speed_turn_factor = physics.speed_turn_factor;
+        
+        wide_world = new ECSWorld;
+        reference_world = new ECSWorld;
+        wide_ships = new ShipEcsWorld;
+        reference_ships = new ShipEcsWorld;
+        ecs_world_init(wide_world);
+        ecs_world_init(reference_world);
+        ship_ecs_init(wide_ships);
+        ship_ecs_init(reference_ships);
+    }
+    
+    void TearDown() override {
+        delete reference_ships;
+        delete wide_ships;
+        delete reference_world;
+        delete wide_world;
+    }
+    
+    Entity add_ship(ECSWorld* world, ShipEcsWorld* ships, float heading, bool is_ship) {
+        Entity e = ecs_create_entity(world);
+        ecs_add_component(world, e, COMPONENT_TRANSFORM);
+        ecs_add_component(world, e, COMPONENT_VELOCITY);
+        if (is_ship) ecs_add_component(world, e, COMPONENT_SHIP);
+        ecs_set_position(world, e, 400.0f, 300.0f);
+        ecs_set_rotation(world, e, heading);
+        ship_ecs_set_config(ships, e, &ship_config);
+        return e;
+    }
+};
+
+TEST_F(ShipPhysicsKernelTest, WideMatchesScalarReference) {
+    const float delta_time = 1.0f / 60.0f;
+    const auto& scenarios = parity_scenarios();
+    
+    // Each scenario at several headings; every fourth entity is not a ship
+    std::vector<Entity> ships;
+    std::vector<size_t> scenario_of;
+    std::vector<Entity> bystanders;
+    for (int copy = 0; copy < 4; copy++) {
+        for (size_t s = 0; s < scenarios.size(); s++) {
+            float heading = 37.0f * (float)(copy * scenarios.size() + s);
+            Entity e = add_ship(wide_world, wide_ships, heading, true);
+            ASSERT_EQ(add_ship(reference_world, reference_ships, heading, true), e);
+            ships.push_back(e);
+            scenario_of.push_back(s);
+            
+            // Some ships coast on other friction, so groups both share the
+            // first ship's coast decay and compute their own
+            if (copy == 3) {
+                wide_ships->ships.coast_friction[e] = ship_config.coast_friction * 3.0f;
+                reference_ships->ships.coast_friction[e] = ship_config.coast_friction * 3.0f;
+            }
+            
+            if ((ships.size() % 3) == 0) {
+                Entity b = add_ship(wide_world, wide_ships, heading, false);
+                add_ship(reference_world, reference_ships, heading, false);
+                wide_world->velocities.speed[b] = 12.0f;
+                reference_world->velocities.speed[b] = 12.0f;
+                bystanders.push_back(b);
+            }
+        }
+    }
+    
+    int longest = 0;
+    for (const auto& phases : scenarios) {
+        int total = 0;
+        for (const auto& phase : phases) total += phase.frames;
+        longest = std::max(longest, total);
+    }
+    
+    float max_speed_error = 0.0f, max_vel_error = 0.0f, max_angular_error = 0.0f;
+    for (int frame = 0; frame < longest; frame++) {
+        for (size_t k = 0; k < ships.size(); k++) {
+            // Current phase of this ship's scenario (idle once finished)
+            float throttle = 0.0f, rudder = 0.0f;
+            int t = frame;
+            for (const auto& phase : scenarios[scenario_of[k]]) {
+                if (t < phase.frames) {
+                    throttle = phase.throttle;
+                    rudder = phase.rudder;
+                    break;
+                }
+                t -= phase.frames;
+            }
+            ship_ecs_set_throttle(wide_ships, ships[k], throttle);
+            ship_ecs_set_rudder(wide_ships, ships[k], rudder);
+            ship_ecs_set_throttle(reference_ships, ships[k], throttle);
+            ship_ecs_set_rudder(reference_ships, ships[k], rudder);
+        }
+        
+        ship_ecs_system_physics(wide_world, wide_ships, delta_time);
+        ship_ecs_system_physics_reference(reference_world, reference_ships, delta_time);
+        
+        for (Entity e : ships) {
+            const VelocityComponents& w = wide_world->velocities;
+            const VelocityComponents& r = reference_world->velocities;
+            max_speed_error = std::max(max_speed_error, std::fabs(w.speed[e] - r.speed[e]));
+            max_angular_error = std::max(max_angular_error, std::fabs(w.angular_vel[e] - r.angular_vel[e]));
+            max_vel_error = std::max(max_vel_error, std::fabs(w.vel_x[e] - r.vel_x[e]));
+            max_vel_error = std::max(max_vel_error, std::fabs(w.vel_y[e] - r.vel_y[e]));
+            ASSERT_NEAR(wide_ships->ships.throttle[e], reference_ships->ships.throttle[e], 1e-6f);
+            ASSERT_NEAR(wide_ships->ships.rudder[e], reference_ships->ships.rudder[e], 1e-6f);
+        }
+        
+        // Move the reference ships with the reference velocities; positions
+        // then drift only by the accumulated velocity differences
+        ecs_system_movement(wide_world, delta_time);
+        ecs_system_movement(reference_world, delta_time);
+    }
+    
+    std::cout << "Wide vs scalar max error: speed " << max_speed_error << ", angular "
+              << max_angular_error << ", velocity " << max_vel_error << std::endl;
+    EXPECT_LT(max_speed_error, 1e-3f);
+    EXPECT_LT(max_angular_error, 1e-3f);
+    EXPECT_LT(max_vel_error, 1e-3f);
+    for (Entity e : ships) {
+        EXPECT_NEAR(wide_world->transforms.pos_x[e], reference_world->transforms.pos_x[e], 0.05f) << "ship " << e;
+        EXPECT_NEAR(wide_world->transforms.pos_y[e], reference_world->transforms.pos_y[e], 0.05f) << "ship " << e;
+    }
+    
+    // Entities without COMPONENT_SHIP are left alone
+    for (Entity b : bystanders) {
+        EXPECT_EQ(wide_world->velocities.speed[b], 12.0f);
+        EXPECT_EQ(wide_ships->ships.throttle[b], 0.0f);
+    }
+}
+
+TEST_F(ShipPhysicsKernelTest, DISABLED_Benchmark10kShips) {
+    const uint32_t count = 10000;
+    const int steps = 600;
+    const float delta_time = 1.0f / 60.0f;
+    
+    // One column set per kernel, with varied controls so both paths of every select run
+    struct Columns {
+        std::vector<float> data[19];
+        ShipPhysicsColumns view;
+    };
+    auto make = [&](Columns& c) {
+        for (auto& column : c.data) column.assign(count, 0.0f);
+        for (uint32_t i = 0; i < count; i++) {
+            c.data[1][i] = (float)((int)(i % 7) - 3) / 3.0f;      // target_throttle
+            c.data[3][i] = (float)((int)(i % 5) - 2) / 2.0f;      // target_rudder
+            c.data[4][i] = ship_config.max_speed;
+            c.data[5][i] = ship_config.acceleration;
+            c.data[6][i] = ship_config.turn_rate;
+            c.data[7][i] = ship_config.throttle_response;
+            c.data[8][i] = ship_config.steering_response;
+            c.data[9][i] = ship_config.coast_friction;
+            c.data[10][i] = ship_config.drift_factor;
+            c.data[11][i] = ship_config.reverse_speed_mult;
+            c.data[12][i] = ship_config.reverse_accel_mult;
+            c.data[13][i] = ship_config.speed_turn_factor;
+            c.data[14][i] = (float)(i % 360);                     // rotation
+        }
+        ShipPhysicsColumns& v = c.view;
+        v.throttle = c.data[0].data();          v.target_throttle = c.data[1].data();
+        v.rudder = c.data[2].data();            v.target_rudder = c.data[3].data();
+        v.max_speed = c.data[4].data();         v.acceleration = c.data[5].data();
+        v.turn_rate = c.data[6].data();         v.throttle_response = c.data[7].data();
+        v.steering_response = c.data[8].data(); v.coast_friction = c.data[9].data();
+        v.drift_factor = c.data[10].data();     v.reverse_speed_mult = c.data[11].data();
+        v.reverse_accel_mult = c.data[12].data(); v.speed_turn_factor = c.data[13].data();
+        v.rotation = c.data[14].data();         v.speed = c.data[15].data();
+        v.angular_vel = c.data[16].data();      v.vel_x = c.data[17].data();
+        v.vel_y = c.data[18].data();
+        v.masks = nullptr;
+        v.required = 0;
+    };
+    Columns scalar_cols, wide_cols;
+    make(scalar_cols);
+    make(wide_cols);
+    
+    auto time_kernel = [&](void (*kernel)(const ShipPhysicsColumns*, uint32_t, uint32_t, float),
+                           Columns& c) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int step = 0; step < steps; step++) {
+            // Flip the controls halfway so ships coast, reverse and turn both ways
+            if (step == steps / 2) {
+                for (uint32_t i = 0; i < count; i++) {
+                    c.data[1][i] = -c.data[1][i];
+                    c.data[3][i] = -c.data[3][i];
+                }
+            }
+            kernel(&c.view, 0, count, delta_time);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / steps;
+    };
+    double scalar_us = time_kernel(ship_physics_kernel_scalar, scalar_cols);
+    double wide_us = time_kernel(ship_physics_kernel_wide, wide_cols);
+    
+    std::cout << "[Benchmark] ship physics, " << count << " ships: scalar " << scalar_us
+              << " us/step, wide " << wide_us << " us/step (" << scalar_us / wide_us << "x)" << std::endl;
+#ifdef NDEBUG
+    // Unoptimized intrinsics are slower than scalar code; only a release build says anything
+    EXPECT_LT(wide_us, scalar_us);
+#endif
+    
+    for (uint32_t i = 0; i < count; i++) {
+        ASSERT_NEAR(wide_cols.data[15][i], scalar_cols.data[15][i], 1e-3f) << "ship " << i;
+        ASSERT_NEAR(wide_cols.data[17][i], scalar_cols.data[17][i], 1e-3f) << "ship " << i;
+    }
+}
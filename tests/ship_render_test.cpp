@@ -0,0 +1,108 @@
+// =============================================================================
+// Ship Rendering Tests
+// Tests for building the fleet's triangle batch from the render list
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+extern "C" {
+#include "engine_ecs.h"
+#include "engine_renderer.h"
+#include "game_constants.h"
+#include "game_ecs.h"
+#include "ship_render.h"
+}
+
+struct ShipWorld {
+    ECSWorld world;
+    GameEcsState game;
+};
+
+static bool batch_has_vertex(const TriangleBatch* batch, uint32_t first, uint32_t count,
+                             float x, float y) {
+    for (uint32_t i = first; i < first + count; i++) {
+        if (fabsf(batch->x[i] - x) < 1e-3f && fabsf(batch->y[i] - y) < 1e-3f) return true;
+    }
+    return false;
+}
+
+TEST(ShipRenderTest, BatchMatchesHullGeometry) {
+    std::unique_ptr<ShipWorld> c(new ShipWorld());
+    game_ecs_init(&c->game, &c->world);
+    Entity player = game_create_player_ship(&c->game, 0.0f, 0.0f, 90.0f);
+    Entity ai = game_create_ai_ship(&c->game, 500.0f, 0.0f, 0.0f, 0);
+    c->world.velocities.speed[ai] = 50.0f;
+    
+    std::unique_ptr<EcsRenderList> list(new EcsRenderList());
+    ecs_store_previous_transforms(&c->world);
+    ecs_build_render_list(&c->world, 1.0f, -1000.0f, -1000.0f, 1000.0f, 1000.0f,
+                          SHIP_RENDER_REACH, list.get());
+    
+    TriangleBatch batch;
+    renderer_triangle_batch_init(&batch);
+    ASSERT_EQ(ship_render_batch_layer(&batch, list.get(), &c->world, COMPONENT_SHIP,
+                                      INVALID_ENTITY, SHIP_RENDER_LAYER), 2u);
+    
+    // Wake fans for the moving ship only, then per ship a hull, three
+    // outline quads and a centre fan
+    const uint32_t wake = 3 * 8 * 3;
+    const uint32_t per_ship = 3 + 3 * 6 + 6 * 3;
+    ASSERT_EQ(batch.count, wake + 2 * per_ship);
+    EXPECT_EQ(batch.count % 3, 0u);
+    
+    // Hulls where ship_render_draw_at puts them: player east, AI north at 0.8
+    uint32_t player_hull = wake + (player < ai ? 0 : 3);
+    uint32_t ai_hull = wake + (player < ai ? 3 : 0);
+    EXPECT_TRUE(batch_has_vertex(&batch, player_hull, 3, SHIP_LENGTH * SHIP_BOW_LENGTH_MULT, 0.0f));
+    EXPECT_TRUE(batch_has_vertex(&batch, ai_hull, 3, 500.0f,
+                                 -SHIP_LENGTH * SHIP_AI_SCALE * SHIP_BOW_LENGTH_MULT));
+    EXPECT_EQ(batch.color[player_hull].r, SHIP_PLAYER_COLOR_R);
+    EXPECT_EQ(batch.color[ai_hull].b, SHIP_AI_COLOR_B);
+    
+    // Leaving the player out leaves just the AI ship
+    renderer_triangle_batch_clear(&batch);
+    EXPECT_EQ(ship_render_batch_layer(&batch, list.get(), &c->world, COMPONENT_SHIP,
+                                      player, SHIP_RENDER_LAYER), 1u);
+    EXPECT_EQ(batch.count, wake + per_ship);
+    
+    renderer_triangle_batch_shutdown(&batch);
+    game_ecs_shutdown(&c->game);
+}
+
+TEST(ShipRenderTest, DISABLED_BenchmarkFullFleetBatch) {
+    std::unique_ptr<ShipWorld> c(new ShipWorld());
+    game_ecs_init(&c->game, &c->world);
+    for (uint32_t i = 0; i < MAX_ENTITIES - 1; i++) {
+        Entity e = game_create_ai_ship(&c->game, 100.0f * (i % 32), 100.0f * (i / 32), 11.0f * i, 0);
+        c->world.velocities.speed[e] = 40.0f;
+    }
+    
+    std::unique_ptr<EcsRenderList> list(new EcsRenderList());
+    ecs_store_previous_transforms(&c->world);
+    TriangleBatch batch;
+    renderer_triangle_batch_init(&batch);
+    
+    const int frames = 200;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++) {
+        ecs_build_render_list(&c->world, 0.5f, -100.0f, -100.0f, 3300.0f, 3300.0f,
+                              SHIP_RENDER_REACH, list.get());
+        renderer_triangle_batch_clear(&batch);
+        ship_render_batch_layer(&batch, list.get(), &c->world, COMPONENT_SHIP,
+                                INVALID_ENTITY, SHIP_RENDER_LAYER);
+    }
+    double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count() / frames;
+    
+    std::cout << "[Benchmark] ship batch, " << list->count << " ships: " << batch.count
+              << " vertices in " << ms << " ms per frame" << std::endl;
+    EXPECT_EQ(list->count, (uint32_t)(MAX_ENTITIES - 1));
+    EXPECT_LT(ms, 16.0);    // Well inside a 60 Hz frame
+    
+    renderer_triangle_batch_shutdown(&batch);
+    game_ecs_shutdown(&c->game);
+}
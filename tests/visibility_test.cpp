@@ -0,0 +1,94 @@
+// =============================================================================
+// Visibility Tests
+// Tests for the per-frame visibility set gathered from the camera
+// =============================================================================
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+extern "C" {
+#include "engine_camera.h"
+#include "engine_ecs.h"
+#include "engine_spatial_hash.h"
+#include "game_ecs.h"
+#include "game_visibility.h"
+}
+
+// One square island, 200 units on a side, east of the origin
+static const char* VIS_TEST_JSON =
+    "{ \"version\": \"1.0\", \"islands\": ["
+    "  { \"name\": \"Square\", \"points\": [[200, -100], [400, -100], [400, 100], [200, 100]] }"
+    "] }";
+
+struct VisWorld {
+    ECSWorld world;
+    GameEcsState game;
+};
+
+TEST(VisibilityTest, GathersWhatTheCameraShows) {
+    std::unique_ptr<VisWorld> c(new VisWorld());
+    game_ecs_init(&c->game, &c->world);
+    ASSERT_TRUE(coastline_load_from_string(&c->game.coast, VIS_TEST_JSON));
+    POIEcsWorld* pois = game_ecs_get_poi_world(&c->game);
+    const float poi_spots[3][2] = { {0.0f, 0.0f}, {450.0f, 0.0f}, {3000.0f, 3000.0f} };
+    for (int i = 0; i < 3; i++) {
+        POICreateParams params;
+        memset(&params, 0, sizeof(params));
+        params.name = "Spot";
+        params.x = poi_spots[i][0];
+        params.y = poi_spots[i][1];
+        params.radius = 50.0f;
+        ASSERT_EQ(poi_ecs_create(pois, &params), i);
+    }
+    poi_ecs_rebuild_index(pois);
+    FogOfWarState* fog = game_ecs_get_fog(&c->game);
+    fog_reveal_area(fog, 0.0f, 0.0f, 300.0f);
+    
+    // 800x600 view round the origin
+    CameraState camera;
+    camera_init(&camera, 0.0f, 0.0f);
+    Rectangle view = camera_get_view_rect(&camera, 800, 600);
+    EXPECT_FLOAT_EQ(view.x, -400.0f);
+    EXPECT_FLOAT_EQ(view.height, 600.0f);
+    
+    std::unique_ptr<EcsRenderList> entities(new EcsRenderList());
+    GameVisibility vis;
+    game_visibility_init(&vis);
+    game_visibility_build(&vis, view, pois, &c->game.coast, fog, entities.get());
+    EXPECT_EQ(vis.island_count, 1u);
+    ASSERT_EQ(vis.poi_count, 2u);   // The one just off the edge still shows its icon
+    EXPECT_EQ(std::min(vis.pois[0], vis.pois[1]), 0);
+    EXPECT_EQ(std::max(vis.pois[0], vis.pois[1]), 1);
+    EXPECT_EQ(vis.entities, entities.get());
+    
+    // The view touches four fog chunks round the origin, all explored
+    ASSERT_EQ(vis.chunk_count, 4u);
+    for (uint32_t i = 0; i < vis.chunk_count; i++) {
+        EXPECT_TRUE(vis.chunk_x[i] == -1 || vis.chunk_x[i] == 0);
+        EXPECT_NE(vis.chunk_index[i], SPATIAL_HASH_NOT_FOUND);
+    }
+    
+    // Far out at sea: nothing but unexplored fog
+    camera_set_position(&camera, 5000.0f, -5000.0f);
+    game_visibility_build(&vis, camera_get_view_rect(&camera, 800, 600), pois, &c->game.coast, fog, NULL);
+    EXPECT_EQ(vis.island_count, 0u);
+    EXPECT_EQ(vis.poi_count, 0u);
+    EXPECT_GT(vis.chunk_count, 0u);
+    for (uint32_t i = 0; i < vis.chunk_count; i++) {
+        EXPECT_EQ(vis.chunk_index[i], SPATIAL_HASH_NOT_FOUND);
+    }
+    
+    // A quarter turn swaps the view's extents
+    camera_set_rotation(&camera, 90.0f);
+    Rectangle turned = camera_get_view_rect(&camera, 800, 600);
+    EXPECT_NEAR(turned.width, 600.0f, 1e-2f);
+    EXPECT_NEAR(turned.height, 800.0f, 1e-2f);
+    
+    fog_set_enabled(fog, false);
+    game_visibility_build(&vis, view, pois, &c->game.coast, fog, NULL);
+    EXPECT_EQ(vis.chunk_count, 0u);
+    game_visibility_shutdown(&vis);
+    game_ecs_shutdown(&c->game);
+}
@@ -0,0 +1,51 @@
+#include "game_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// =============================================================================
+// MSTour Headless Simulator
+//
+// Runs a scenario through the game's ECS systems with no window, renderer or
+// audio and prints throughput statistics (see game_sim.h).
+//
+// Usage: MSTour_sim [scenario.ini] [ticks]
+//        (ticks defaults to the scenario's, the scenario to built-in defaults)
+// =============================================================================
+
+// The world is large, so it lives outside the stack
+static GameSim g_sim;
+
+int main(int argc, char** argv) {
+    if (argc > 3) {
+        fprintf(stderr, "Usage: %s [scenario.ini] [ticks]\n", argv[0]);
+        return 1;
+    }
+
+    SimScenario scenario = game_sim_default_scenario();
+    if (argc >= 2 && !game_sim_load_scenario(argv[1], &scenario)) {
+        return 1;
+    }
+
+    uint32_t ticks = scenario.ticks;
+    if (argc == 3) {
+        char* end = NULL;
+        long value = strtol(argv[2], &end, 10);
+        if (!end || *end != '\0' || value < 0) {
+            fprintf(stderr, "[MSTour Sim] Invalid tick count: %s\n", argv[2]);
+            return 1;
+        }
+        ticks = (uint32_t)value;
+    }
+
+    if (!game_sim_init(&g_sim, &scenario)) {
+        fprintf(stderr, "[MSTour Sim] Could not spawn the full fleet\n");
+        game_sim_shutdown(&g_sim);
+        return 1;
+    }
+
+    SimStats stats = game_sim_run(&g_sim, ticks);
+    game_sim_print_stats(&g_sim, &stats);
+
+    game_sim_shutdown(&g_sim);
+    return 0;
+}
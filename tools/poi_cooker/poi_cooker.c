@@ -0,0 +1,48 @@
+#include "game_poi_ecs.h"
+#include "game_poi_loader.h"
+#include "game_poi_cooked.h"
+#include <stdio.h>
+
+// =============================================================================
+// POI Cooker
+//
+// Offline tool: parses POI JSON once and writes the cooked binary that the
+// game maps in place (see game_poi_cooked.h).
+//
+// Usage: poi_cooker <input.json> [output.bin]
+//        (output defaults to the input path with a .bin extension)
+// =============================================================================
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "Usage: %s <input.json> [output.bin]\n", argv[0]);
+        return 1;
+    }
+
+    const char* input = argv[1];
+    char output[512];
+    if (argc == 3) {
+        snprintf(output, sizeof(output), "%s", argv[2]);
+    } else if (!poi_cooked_path_for(input, output, sizeof(output))) {
+        fprintf(stderr, "[POI Cooker] Output path too long for: %s\n", input);
+        return 1;
+    }
+
+    POIEcsWorld world;
+    poi_ecs_init(&world);
+
+    POILoadResult result = poi_load_from_json_file(&world, input);
+    if (result != POI_LOAD_SUCCESS) {
+        fprintf(stderr, "[POI Cooker] %s: %s\n", poi_load_result_to_string(result), input);
+        poi_ecs_shutdown(&world);
+        return 1;
+    }
+
+    bool ok = poi_cooked_write(&world, output);
+    if (ok) {
+        printf("[POI Cooker] Wrote %u POIs to %s\n", poi_ecs_get_count(&world), output);
+    }
+
+    poi_ecs_shutdown(&world);
+    return ok ? 0 : 1;
+}